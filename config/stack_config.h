@@ -184,6 +184,21 @@
 /* Maximum number of open file per MMS connection (for MMS file read service) */
 #define CONFIG_MMS_MAX_NUMBER_OF_OPEN_FILES_PER_CONNECTION 5
 
+/* Use memory-mapped files for the MMS file read service (the files must not be truncated while they are open) */
+#define CONFIG_MMS_SERVER_FILE_READ_MMAP 0
+
+/* Number of directory listings cached by the MMS file directory service (0 = no cache) */
+#define CONFIG_MMS_SERVER_FILE_DIRECTORY_CACHE_SIZE 4
+
+/* Maximum age in ms of a cached directory listing (changes of file sizes are only detected after this time) */
+#define CONFIG_MMS_SERVER_FILE_DIRECTORY_CACHE_MAX_AGE 10000
+
+/* Maximum number of journal read cursors per MMS connection (to continue ReadJournal requests with moreFollows) */
+#define CONFIG_MMS_MAX_NUMBER_OF_JOURNAL_CURSORS_PER_CONNECTION 2
+
+/* Time in ms after which an unused journal read cursor is closed */
+#define CONFIG_MMS_JOURNAL_CURSOR_TIMEOUT 30000
+
 /* Maximum number of the domain specific data sets - this also includes the static (pre-configured) and dynamic data sets */
 #define CONFIG_MMS_MAX_NUMBER_OF_DOMAIN_SPECIFIC_DATA_SETS 10
 
@@ -199,6 +214,9 @@
 /* maximum number of contemporary file upload tasks (obtainFile) per server instance */
 #define CONFIG_MMS_SERVER_MAX_GET_FILE_TASKS 5
 
+/* maximum number of outstanding requests accepted from a client (negotiated maxServOutstandingCalling) */
+#define CONFIG_MMS_SERVER_MAX_SERV_OUTSTANDING_CALLING 5
+
 /* Definition of supported services */
 #define MMS_DEFAULT_PROFILE 1
 
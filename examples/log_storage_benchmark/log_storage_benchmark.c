@@ -0,0 +1,212 @@
+/*
+ * log_storage_benchmark.c
+ *
+ * Compares the log storage drivers (memory-mapped ring and sqlite) for write rate
+ * and query latency.
+ *
+ * For each driver the benchmark writes the given number of log entries (one entry data
+ * with an encoded float value each, like LogInstance_logSingleData) and then measures
+ * the latency of the queries used by the log service:
+ *
+ * - status: LogStorage_getOldestAndNewestEntries (update of the LCB status)
+ * - range: LogStorage_getEntries for 100 entries in the middle of the log (QueryLogByTime)
+ * - after: LogStorage_getEntriesAfter that stops after 100 entries (QueryLogAfter with full PDU)
+ *
+ * The sqlite driver is only included when the benchmark is compiled with LOG_BENCHMARK_WITH_SQLITE.
+ *
+ * usage: log_storage_benchmark [number-of-entries]
+ */
+
+#include "logging_api.h"
+#include "log_storage_mmap.h"
+#include "hal_time.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef LOG_BENCHMARK_WITH_SQLITE
+LogStorage
+SqliteLogStorage_createInstance(const char* filename);
+#endif
+
+#define BENCHMARK_FILE_NAME "log_storage_benchmark.db"
+
+#define QUERY_ENTRIES 100
+#define QUERY_REPETITIONS 20
+
+typedef struct {
+    int entries;
+    int maxEntries;
+} QueryState;
+
+static bool
+entryCallback(void* parameter, uint64_t timestamp, uint64_t entryID, bool moreFollow)
+{
+    QueryState* state = (QueryState*) parameter;
+
+    if (moreFollow) {
+        if (state->entries == state->maxEntries)
+            return false;
+
+        state->entries++;
+    }
+
+    return true;
+}
+
+static bool
+entryDataCallback(void* parameter, const char* dataRef, uint8_t* data, int dataSize, uint8_t reasonCode, bool moreFollow)
+{
+    return true;
+}
+
+static double
+getElapsedUs(uint64_t startTimeInNs)
+{
+    return (double) (Hal_getTimeInNs() - startTimeInNs) / 1000.0;
+}
+
+static void
+runBenchmark(const char* name, LogStorage storage, bool isAsync, int numberOfEntries)
+{
+    uint8_t data[7];
+    MmsValue* value = MmsValue_newFloat(0.0f);
+
+    uint64_t baseTime = 1000000;
+
+    uint64_t startTime = Hal_getTimeInNs();
+
+    int i;
+
+    for (i = 0; i < numberOfEntries; i++) {
+        MmsValue_setFloat(value, (float) i);
+
+        int dataSize = MmsValue_encodeMmsData(value, data, 0, true);
+
+        uint64_t entryID = LogStorage_addEntry(storage, baseTime + (i * 10));
+
+        LogStorage_addEntryData(storage, entryID, "simpleIOGenericIO/GGIO1$MX$AnIn1$mag$f", data, dataSize, 4);
+    }
+
+    double writeTime = getElapsedUs(startTime);
+
+    /* don't measure the queued entries with the first query */
+    if (isAsync)
+        AsyncLogStorage_flush(storage);
+
+    uint64_t newEntry, newEntryTime, oldEntry, oldEntryTime;
+
+    /* status query */
+    startTime = Hal_getTimeInNs();
+
+    for (i = 0; i < QUERY_REPETITIONS; i++)
+        LogStorage_getOldestAndNewestEntries(storage, &newEntry, &newEntryTime, &oldEntry, &oldEntryTime);
+
+    double statusTime = getElapsedUs(startTime) / QUERY_REPETITIONS;
+
+    /* range query for entries in the middle of the log */
+    uint64_t rangeStart = baseTime + ((numberOfEntries / 2) * 10);
+    uint64_t rangeEnd = rangeStart + ((QUERY_ENTRIES - 1) * 10);
+
+    QueryState state;
+
+    startTime = Hal_getTimeInNs();
+
+    for (i = 0; i < QUERY_REPETITIONS; i++) {
+        state.entries = 0;
+        state.maxEntries = QUERY_ENTRIES * 2;
+
+        LogStorage_getEntries(storage, rangeStart, rangeEnd, entryCallback, entryDataCallback, &state);
+    }
+
+    double rangeTime = getElapsedUs(startTime) / QUERY_REPETITIONS;
+    int rangeEntries = state.entries;
+
+    /* query after an entry in the middle of the log, stop after QUERY_ENTRIES entries */
+    uint64_t afterEntryID = oldEntry + ((newEntry - oldEntry) / 2);
+
+    startTime = Hal_getTimeInNs();
+
+    for (i = 0; i < QUERY_REPETITIONS; i++) {
+        state.entries = 0;
+        state.maxEntries = QUERY_ENTRIES;
+
+        LogStorage_getEntriesAfter(storage, rangeStart, afterEntryID, entryCallback, entryDataCallback, &state);
+    }
+
+    double afterTime = getElapsedUs(startTime) / QUERY_REPETITIONS;
+    int afterEntries = state.entries;
+
+    printf("%-14s %8i entries %10.0f entries/s | status %9.1f us | range %9.1f us (%i) | after %9.1f us (%i)\n",
+            name, numberOfEntries, numberOfEntries / (writeTime / 1000000.0),
+            statusTime, rangeTime, rangeEntries, afterTime, afterEntries);
+
+    MmsValue_delete(value);
+}
+
+int
+main(int argc, char** argv)
+{
+    int numberOfEntries = 100000;
+
+    if (argc > 1)
+        numberOfEntries = atoi(argv[1]);
+
+    /* about 160 bytes per entry in the ring */
+    int ringSize = numberOfEntries * 256;
+
+    remove(BENCHMARK_FILE_NAME);
+
+    LogStorage storage = MmapLogStorage_createInstance(BENCHMARK_FILE_NAME, ringSize);
+
+    if (storage) {
+        runBenchmark("mmap", storage, false, numberOfEntries);
+        LogStorage_destroy(storage);
+    }
+    else
+        printf("Failed to create mmap log storage\n");
+
+    remove(BENCHMARK_FILE_NAME);
+
+    storage = MmapLogStorage_createInstance(BENCHMARK_FILE_NAME, ringSize);
+
+    if (storage) {
+        MmapLogStorage_setSyncOnCommit(storage, true);
+
+        runBenchmark("mmap (sync)", storage, false, numberOfEntries / 100);
+        LogStorage_destroy(storage);
+    }
+
+    remove(BENCHMARK_FILE_NAME);
+
+#ifdef LOG_BENCHMARK_WITH_SQLITE
+    storage = SqliteLogStorage_createInstance(BENCHMARK_FILE_NAME);
+
+    if (storage) {
+        runBenchmark("sqlite", storage, false, numberOfEntries / 100);
+        LogStorage_destroy(storage);
+    }
+    else
+        printf("Failed to create sqlite log storage\n");
+
+    remove(BENCHMARK_FILE_NAME);
+
+    storage = SqliteLogStorage_createInstance(BENCHMARK_FILE_NAME);
+
+    if (storage) {
+        LogStorage asyncStorage = AsyncLogStorage_create(storage, 10000, ASYNC_LOG_STORAGE_BLOCK);
+
+        if (asyncStorage) {
+            runBenchmark("sqlite (async)", asyncStorage, true, numberOfEntries);
+            LogStorage_destroy(asyncStorage);
+        }
+        else
+            LogStorage_destroy(storage);
+    }
+
+    remove(BENCHMARK_FILE_NAME);
+#endif /* LOG_BENCHMARK_WITH_SQLITE */
+
+    return 0;
+}
@@ -0,0 +1,277 @@
+/*
+ * mms_file_service_benchmark.c
+ *
+ * Measures the latency of the MMS file directory service for a large directory and the
+ * throughput of the MMS file read service.
+ *
+ * The benchmark creates a directory with the given number of files in the virtual file store,
+ * starts a local server and lists the directory with a small MMS PDU size, so the client has
+ * to request the listing in many parts (FileDirectory requests with continue-after):
+ *
+ * - first: the first listing of the directory (the server has to scan the directory)
+ * - repeated: the following listings (served from the directory listing cache of the server,
+ *   see CONFIG_MMS_SERVER_FILE_DIRECTORY_CACHE_SIZE)
+ * - page: a single FileDirectory request that continues after a file in the middle of the directory
+ *
+ * Finally a file is downloaded with IedConnection_getFile (see CONFIG_MMS_SERVER_FILE_READ_MMAP).
+ *
+ * usage: mms_file_service_benchmark [number-of-files]
+ */
+
+#include "iec61850_server.h"
+#include "iec61850_client.h"
+#include "hal_time.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#define SERVER_PORT 10102
+
+#define BENCHMARK_DIRECTORY "mms_file_service_benchmark.d"
+#define BENCHMARK_FILE_NAME "mms_file_service_benchmark.dat"
+#define BENCHMARK_FILE_SIZE (4 * 1024 * 1024)
+
+#define MMS_PDU_SIZE 1000
+
+#define REPETITIONS 5
+
+static bool
+createFile(const char* fileName, int size)
+{
+    FILE* file = fopen(fileName, "wb");
+
+    if (file == NULL)
+        return false;
+
+    int i;
+
+    for (i = 0; i < size; i++)
+        fputc(i & 0xff, file);
+
+    fclose(file);
+
+    return true;
+}
+
+static void
+getFileName(char* buffer, int index)
+{
+    sprintf(buffer, BENCHMARK_DIRECTORY "/file_%06i.dat", index);
+}
+
+static bool
+createBenchmarkFiles(int numberOfFiles)
+{
+    mkdir(BENCHMARK_DIRECTORY, 0755);
+
+    int i;
+
+    for (i = 0; i < numberOfFiles; i++) {
+        char fileName[128];
+
+        getFileName(fileName, i);
+
+        if (createFile(fileName, 100) == false)
+            return false;
+    }
+
+    return createFile(BENCHMARK_FILE_NAME, BENCHMARK_FILE_SIZE);
+}
+
+static void
+deleteBenchmarkFiles(int numberOfFiles)
+{
+    int i;
+
+    for (i = 0; i < numberOfFiles; i++) {
+        char fileName[128];
+
+        getFileName(fileName, i);
+
+        remove(fileName);
+    }
+
+    rmdir(BENCHMARK_DIRECTORY);
+    remove(BENCHMARK_FILE_NAME);
+}
+
+/* list the complete directory - returns the number of entries or -1 on error */
+static int
+listDirectory(IedConnection con, int* numberOfRequests)
+{
+    char continueAfter[256] = "";
+
+    int numberOfEntries = 0;
+    bool moreFollows = true;
+
+    *numberOfRequests = 0;
+
+    while (moreFollows) {
+        IedClientError error;
+
+        LinkedList entries = IedConnection_getFileDirectoryEx(con, &error, BENCHMARK_DIRECTORY,
+                continueAfter[0] ? continueAfter : NULL, &moreFollows);
+
+        if (error != IED_ERROR_OK)
+            return -1;
+
+        (*numberOfRequests)++;
+
+        LinkedList entry = LinkedList_getNext(entries);
+
+        while (entry) {
+            FileDirectoryEntry dirEntry = (FileDirectoryEntry) LinkedList_getData(entry);
+
+            strncpy(continueAfter, FileDirectoryEntry_getFileName(dirEntry), sizeof(continueAfter) - 1);
+
+            numberOfEntries++;
+
+            entry = LinkedList_getNext(entry);
+        }
+
+        LinkedList_destroyDeep(entries, (LinkedListValueDeleteFunction) FileDirectoryEntry_destroy);
+    }
+
+    return numberOfEntries;
+}
+
+static double
+getElapsedMs(uint64_t startTimeInNs)
+{
+    return (double) (Hal_getTimeInNs() - startTimeInNs) / 1000000.0;
+}
+
+static bool
+getFileHandler(void* parameter, uint8_t* buffer, uint32_t bytesRead)
+{
+    return true;
+}
+
+static void
+runBenchmark(IedConnection con, int numberOfFiles)
+{
+    int numberOfRequests;
+
+    uint64_t startTime = Hal_getTimeInNs();
+
+    int numberOfEntries = listDirectory(con, &numberOfRequests);
+
+    double firstTime = getElapsedMs(startTime);
+
+    if (numberOfEntries != numberOfFiles) {
+        printf("Directory listing failed (%i of %i entries)\n", numberOfEntries, numberOfFiles);
+        return;
+    }
+
+    startTime = Hal_getTimeInNs();
+
+    int i;
+
+    for (i = 0; i < REPETITIONS; i++)
+        listDirectory(con, &numberOfRequests);
+
+    double repeatedTime = getElapsedMs(startTime) / REPETITIONS;
+
+    char continueAfter[128];
+
+    getFileName(continueAfter, numberOfFiles / 2);
+
+    startTime = Hal_getTimeInNs();
+
+    for (i = 0; i < REPETITIONS; i++) {
+        IedClientError error;
+
+        LinkedList entries = IedConnection_getFileDirectoryEx(con, &error, BENCHMARK_DIRECTORY, continueAfter, NULL);
+
+        if (entries)
+            LinkedList_destroyDeep(entries, (LinkedListValueDeleteFunction) FileDirectoryEntry_destroy);
+    }
+
+    double pageTime = getElapsedMs(startTime) / REPETITIONS;
+
+    printf("directory: %i files %i requests | first %9.1f ms | repeated %9.1f ms | page %7.2f ms\n",
+            numberOfEntries, numberOfRequests, firstTime, repeatedTime, pageTime);
+
+    IedClientError error;
+
+    startTime = Hal_getTimeInNs();
+
+    uint32_t bytesReceived = IedConnection_getFile(con, &error, BENCHMARK_FILE_NAME, getFileHandler, NULL);
+
+    double readTime = getElapsedMs(startTime);
+
+    if (error == IED_ERROR_OK)
+        printf("file read: %u bytes %9.1f ms (%.1f MB/s)\n", bytesReceived, readTime,
+                (bytesReceived / (1024.0 * 1024.0)) / (readTime / 1000.0));
+    else
+        printf("File download failed (error %i)\n", error);
+}
+
+int
+main(int argc, char** argv)
+{
+    int numberOfFiles = 10000;
+
+    if (argc > 1)
+        numberOfFiles = atoi(argv[1]);
+
+    if (createBenchmarkFiles(numberOfFiles) == false) {
+        printf("Failed to create benchmark files\n");
+        deleteBenchmarkFiles(numberOfFiles);
+        return -1;
+    }
+
+    /* directories modified within the last second are not cached */
+    sleep(1);
+
+    IedModel* model = IedModel_create("bench");
+
+    LogicalDevice* lDevice = LogicalDevice_create("BENCH", model);
+    LogicalNode* lln0 = LogicalNode_create("LLN0", lDevice);
+    CDC_ENS_create("Mod", (ModelNode*) lln0, 0);
+    CDC_ENS_create("Health", (ModelNode*) lln0, 0);
+
+    IedServer iedServer = IedServer_create(model);
+
+    IedServer_setFilestoreBasepath(iedServer, "./");
+
+    IedServer_start(iedServer, SERVER_PORT);
+
+    if (!IedServer_isRunning(iedServer)) {
+        printf("Starting server failed!\n");
+        IedServer_destroy(iedServer);
+        IedModel_destroy(model);
+        deleteBenchmarkFiles(numberOfFiles);
+        exit(-1);
+    }
+
+    IedClientError error;
+
+    IedConnection con = IedConnection_create();
+
+    MmsConnection_setLocalDetail(IedConnection_getMmsConnection(con), MMS_PDU_SIZE);
+
+    IedConnection_connect(con, &error, "127.0.0.1", SERVER_PORT);
+
+    if (error == IED_ERROR_OK) {
+        runBenchmark(con, numberOfFiles);
+
+        IedConnection_close(con);
+    }
+    else
+        printf("Failed to connect (error %i)\n", error);
+
+    IedConnection_destroy(con);
+
+    IedServer_stop(iedServer);
+    IedServer_destroy(iedServer);
+    IedModel_destroy(model);
+
+    deleteBenchmarkFiles(numberOfFiles);
+
+    return 0;
+}
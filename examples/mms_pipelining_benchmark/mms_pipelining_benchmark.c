@@ -0,0 +1,369 @@
+/*
+ * mms_pipelining_benchmark.c
+ *
+ * Measures the read throughput of a client connection for different numbers of
+ * outstanding requests (request window, see IedConnection_setMaxOutstandingCalls)
+ * over a link with high latency. Also measures the file download throughput for
+ * different numbers of outstanding FileRead requests (see IedConnection_getFileWindowed).
+ *
+ * The benchmark starts a local server and a TCP proxy that delays all data by the
+ * given one-way delay. The client connects to the proxy and keeps the request window
+ * filled with asynchronous read requests.
+ *
+ * NOTE: The server limits the negotiated number of outstanding requests to
+ * CONFIG_MMS_SERVER_MAX_SERV_OUTSTANDING_CALLING (stack_config.h). Larger windows are
+ * reduced to this value.
+ *
+ * usage: mms_pipelining_benchmark [one-way-delay-ms] [seconds-per-run]
+ */
+
+#include "iec61850_server.h"
+#include "iec61850_client.h"
+#include "hal_socket.h"
+#include "hal_thread.h"
+#include "hal_time.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SERVER_PORT 10102
+#define PROXY_PORT 10103
+
+#define BENCHMARK_FILE_NAME "mms_pipelining_benchmark.dat"
+#define BENCHMARK_FILE_SIZE (1024 * 1024)
+
+#define PROXY_QUEUE_SIZE 256
+#define PROXY_CHUNK_SIZE 8192
+
+typedef struct {
+    uint64_t deliveryTime;
+    int size;
+    uint8_t data[PROXY_CHUNK_SIZE];
+} ProxyChunk;
+
+typedef struct {
+    Socket source;
+    Socket destination;
+    int head;
+    int tail;
+    ProxyChunk* chunks;
+} ProxyChannel;
+
+static int delayMs = 20;
+static volatile bool proxyRunning = false;
+
+static volatile uint32_t completedRequests = 0;
+
+/* returns false when the connection is closed */
+static bool
+proxyChannel_receive(ProxyChannel* self)
+{
+    int nextTail = (self->tail + 1) % PROXY_QUEUE_SIZE;
+
+    if (nextTail == self->head)
+        return true; /* queue is full */
+
+    ProxyChunk* chunk = &(self->chunks[self->tail]);
+
+    int size = Socket_read(self->source, chunk->data, PROXY_CHUNK_SIZE);
+
+    if (size < 0)
+        return false;
+
+    if (size > 0) {
+        chunk->size = size;
+        chunk->deliveryTime = Hal_getTimeInMs() + delayMs;
+        self->tail = nextTail;
+    }
+
+    return true;
+}
+
+static bool
+proxyChannel_deliver(ProxyChannel* self)
+{
+    uint64_t now = Hal_getTimeInMs();
+
+    while ((self->head != self->tail) && (self->chunks[self->head].deliveryTime <= now)) {
+        ProxyChunk* chunk = &(self->chunks[self->head]);
+
+        int sent = 0;
+
+        while (sent < chunk->size) {
+            int result = Socket_write(self->destination, chunk->data + sent, chunk->size - sent);
+
+            if (result < 0)
+                return false;
+
+            sent += result;
+        }
+
+        self->head = (self->head + 1) % PROXY_QUEUE_SIZE;
+    }
+
+    return true;
+}
+
+static void*
+proxyThread(void* parameter)
+{
+    ServerSocket serverSocket = (ServerSocket) parameter;
+
+    while (proxyRunning) {
+        Socket clientSocket = ServerSocket_accept(serverSocket);
+
+        if (clientSocket == NULL) {
+            Thread_sleep(1);
+            continue;
+        }
+
+        Socket serverConnection = TcpSocket_create();
+
+        if (Socket_connect(serverConnection, "127.0.0.1", SERVER_PORT) == false) {
+            printf("Proxy: failed to connect to server\n");
+            Socket_destroy(serverConnection);
+            Socket_destroy(clientSocket);
+            continue;
+        }
+
+        ProxyChannel upstream = { clientSocket, serverConnection, 0, 0, NULL };
+        ProxyChannel downstream = { serverConnection, clientSocket, 0, 0, NULL };
+
+        upstream.chunks = (ProxyChunk*) malloc(PROXY_QUEUE_SIZE * sizeof(ProxyChunk));
+        downstream.chunks = (ProxyChunk*) malloc(PROXY_QUEUE_SIZE * sizeof(ProxyChunk));
+
+        HandleSet handleSet = Handleset_new();
+        Handleset_addSocket(handleSet, clientSocket);
+        Handleset_addSocket(handleSet, serverConnection);
+
+        while (proxyRunning) {
+            Handleset_waitReady(handleSet, 1);
+
+            if (proxyChannel_receive(&upstream) == false)
+                break;
+
+            if (proxyChannel_receive(&downstream) == false)
+                break;
+
+            if (proxyChannel_deliver(&upstream) == false)
+                break;
+
+            if (proxyChannel_deliver(&downstream) == false)
+                break;
+        }
+
+        Handleset_destroy(handleSet);
+
+        Socket_destroy(serverConnection);
+        Socket_destroy(clientSocket);
+
+        free(upstream.chunks);
+        free(downstream.chunks);
+    }
+
+    return NULL;
+}
+
+static void
+readObjectHandler(uint32_t invokeId, void* parameter, IedClientError err, MmsValue* value)
+{
+    if (value)
+        MmsValue_delete(value);
+
+    completedRequests++;
+}
+
+static void
+runBenchmark(int window, int seconds)
+{
+    IedClientError error;
+
+    IedConnection con = IedConnection_create();
+
+    if (IedConnection_setMaxOutstandingCalls(con, window) == false) {
+        printf("Failed to set request window %i\n", window);
+        IedConnection_destroy(con);
+        return;
+    }
+
+    IedConnection_connect(con, &error, "127.0.0.1", PROXY_PORT);
+
+    if (error != IED_ERROR_OK) {
+        printf("Failed to connect (error %i)\n", error);
+        IedConnection_destroy(con);
+        return;
+    }
+
+    int effectiveWindow = MmsConnection_getMaxOutstandingCalls(IedConnection_getMmsConnection(con));
+
+    uint32_t issuedRequests = 0;
+    completedRequests = 0;
+
+    uint64_t startTime = Hal_getTimeInMs();
+    uint64_t endTime = startTime + (seconds * 1000);
+
+    while (Hal_getTimeInMs() < endTime) {
+        if ((issuedRequests - completedRequests) < (uint32_t) effectiveWindow) {
+            IedConnection_readObjectAsync(con, &error, "BENCH/GGIO1.AnIn1.mag.f", IEC61850_FC_MX,
+                    readObjectHandler, NULL);
+
+            if (error == IED_ERROR_OK)
+                issuedRequests++;
+            else if (error != IED_ERROR_OUTSTANDING_CALL_LIMIT_REACHED) {
+                printf("Read request failed (error %i)\n", error);
+                break;
+            }
+            else
+                Thread_sleep(1);
+        }
+        else
+            Thread_sleep(1);
+    }
+
+    uint64_t duration = Hal_getTimeInMs() - startTime;
+
+    printf("window: %3i (effective %3i)  requests: %6u  throughput: %8.1f requests/s\n",
+            window, effectiveWindow, completedRequests, (completedRequests * 1000.0) / duration);
+
+    /* wait for pending responses */
+    Thread_sleep(4 * delayMs + 100);
+
+    IedConnection_close(con);
+    IedConnection_destroy(con);
+}
+
+static bool
+getFileHandler(void* parameter, uint8_t* buffer, uint32_t bytesRead)
+{
+    return true;
+}
+
+static void
+runFileBenchmark(int window)
+{
+    IedClientError error;
+
+    IedConnection con = IedConnection_create();
+
+    IedConnection_setMaxOutstandingCalls(con, window);
+
+    IedConnection_connect(con, &error, "127.0.0.1", PROXY_PORT);
+
+    if (error != IED_ERROR_OK) {
+        printf("Failed to connect (error %i)\n", error);
+        IedConnection_destroy(con);
+        return;
+    }
+
+    uint32_t bytesPerSecond;
+
+    uint32_t bytesReceived = IedConnection_getFileWindowed(con, &error, BENCHMARK_FILE_NAME, window,
+            getFileHandler, NULL, &bytesPerSecond);
+
+    if (error == IED_ERROR_OK)
+        printf("file window: %3i  bytes: %8u  throughput: %10u bytes/s\n", window, bytesReceived, bytesPerSecond);
+    else
+        printf("File download failed (error %i)\n", error);
+
+    IedConnection_close(con);
+    IedConnection_destroy(con);
+}
+
+static bool
+createBenchmarkFile(void)
+{
+    FILE* file = fopen(BENCHMARK_FILE_NAME, "wb");
+
+    if (file == NULL)
+        return false;
+
+    int i;
+
+    for (i = 0; i < BENCHMARK_FILE_SIZE; i++)
+        fputc(i & 0xff, file);
+
+    fclose(file);
+
+    return true;
+}
+
+int
+main(int argc, char** argv)
+{
+    int seconds = 2;
+
+    if (argc > 1)
+        delayMs = atoi(argv[1]);
+
+    if (argc > 2)
+        seconds = atoi(argv[2]);
+
+    IedModel* model = IedModel_create("bench");
+
+    LogicalDevice* lDevice = LogicalDevice_create("BENCH", model);
+    LogicalNode* lln0 = LogicalNode_create("LLN0", lDevice);
+    CDC_ENS_create("Mod", (ModelNode*) lln0, 0);
+    CDC_ENS_create("Health", (ModelNode*) lln0, 0);
+
+    LogicalNode* ggio1 = LogicalNode_create("GGIO1", lDevice);
+    CDC_MV_create("AnIn1", (ModelNode*) ggio1, 0, false);
+
+    IedServer iedServer = IedServer_create(model);
+
+    IedServer_setFilestoreBasepath(iedServer, "./");
+
+    IedServer_start(iedServer, SERVER_PORT);
+
+    if (!IedServer_isRunning(iedServer)) {
+        printf("Starting server failed!\n");
+        IedServer_destroy(iedServer);
+        IedModel_destroy(model);
+        exit(-1);
+    }
+
+    ServerSocket proxySocket = TcpServerSocket_create("127.0.0.1", PROXY_PORT);
+
+    if (proxySocket == NULL) {
+        printf("Starting proxy failed!\n");
+        IedServer_stop(iedServer);
+        IedServer_destroy(iedServer);
+        IedModel_destroy(model);
+        exit(-1);
+    }
+
+    ServerSocket_listen(proxySocket);
+
+    proxyRunning = true;
+
+    Thread proxy = Thread_create(proxyThread, proxySocket, false);
+    Thread_start(proxy);
+
+    printf("one-way delay: %i ms (RTT %i ms)\n", delayMs, 2 * delayMs);
+
+    int windows[] = { 1, 2, 4, 8, 16, 32 };
+    int i;
+
+    for (i = 0; i < (int) (sizeof(windows) / sizeof(int)); i++)
+        runBenchmark(windows[i], seconds);
+
+    if (createBenchmarkFile()) {
+        for (i = 0; i < (int) (sizeof(windows) / sizeof(int)); i++)
+            runFileBenchmark(windows[i]);
+
+        remove(BENCHMARK_FILE_NAME);
+    }
+    else
+        printf("Failed to create benchmark file\n");
+
+    proxyRunning = false;
+    Thread_destroy(proxy);
+
+    ServerSocket_destroy(proxySocket);
+
+    IedServer_stop(iedServer);
+    IedServer_destroy(iedServer);
+    IedModel_destroy(model);
+
+    return 0;
+}
@@ -0,0 +1,72 @@
+/*
+ * model_image_tool.c
+ *
+ * Converts a data model configuration file (.cfg - created by genconfig.jar) into a binary
+ * model image that can be loaded with IedModelImage_load.
+ *
+ * The image can only be loaded by the same library version on the same platform that
+ * created it. It should be created on the target system (or by a build of the tool for
+ * the target system).
+ *
+ * usage: model_image_tool <config-file> <image-file>
+ */
+
+#include "iec61850_server.h"
+#include "iec61850_config_file_parser.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static int
+countNodes(ModelNode* node)
+{
+    int count = 0;
+
+    while (node) {
+        count += 1 + countNodes(node->firstChild);
+        node = node->sibling;
+    }
+
+    return count;
+}
+
+int
+main(int argc, char** argv)
+{
+    if (argc < 3) {
+        printf("usage: model_image_tool <config-file> <image-file>\n");
+        return 1;
+    }
+
+    IedModel* model = ConfigFileParser_createModelFromConfigFileEx(argv[1]);
+
+    if (model == NULL) {
+        printf("Error parsing config file %s\n", argv[1]);
+        return 1;
+    }
+
+    if (IedModelImage_writeFile(model, argv[2]) == false) {
+        printf("Failed to write model image %s\n", argv[2]);
+        IedModel_destroy(model);
+        return 1;
+    }
+
+    IedModel_destroy(model);
+
+    /* check that the image can be loaded */
+    IedModelImage image = IedModelImage_load(argv[2]);
+
+    if (image == NULL) {
+        printf("Failed to load model image %s\n", argv[2]);
+        return 1;
+    }
+
+    model = IedModelImage_getModel(image);
+
+    printf("Created model image %s (IED %s, %i model nodes)\n", argv[2], model->name,
+            countNodes((ModelNode*) model->firstChild));
+
+    IedModelImage_destroy(image);
+
+    return 0;
+}
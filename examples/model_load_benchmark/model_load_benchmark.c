@@ -0,0 +1,398 @@
+/*
+ * model_load_benchmark.c
+ *
+ * Compares the time required to load a large data model from a configuration file (.cfg)
+ * with the time required to load the same model from a binary model image (IedModelImage).
+ *
+ * The benchmark generates a configuration file with the given number of logical devices.
+ * Every logical device contains 50 GGIO logical nodes with 8 analog inputs, 8 controllable
+ * single point outputs, a data set, and an unbuffered report control block (about 3500 data
+ * attributes per logical device).
+ *
+ * - parse: ConfigFileParser_createModelFromConfigFileEx
+ * - write image: IedModelImage_writeFile
+ * - load image: IedModelImage_load
+ * - server create: IedServer_create/IedServer_destroy with the loaded model
+ * - lazy server create: IedServer_createWithConfig with IEC61850_VALUE_CACHE_ON_ACCESS (the MMS
+ *   value cache of a logical device is populated on first access)
+ * - lookup: IedModel_getModelNodeByObjectReference for all data attributes
+ *
+ * For the model created from the configuration file the memory used by the model is
+ * reported (IedModel_getMemoryUsage and - with glibc - the growth of the heap). With glibc
+ * also the heap growth caused by IedServer_create (mainly the MMS type specifications and
+ * the MMS value cache) is reported. All GGIO logical nodes have the same structure and share
+ * their MMS type specifications.
+ *
+ * usage: model_load_benchmark [number-of-logical-devices]
+ */
+
+#include "iec61850_server.h"
+#include "iec61850_config_file_parser.h"
+#include "hal_time.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#define CONFIG_FILE_NAME "model_load_benchmark.cfg"
+#define IMAGE_FILE_NAME "model_load_benchmark.img"
+
+#define LOGICAL_NODES_PER_LD 50
+#define DATA_OBJECTS_PER_TYPE 8
+
+#define REPETITIONS 5
+
+static void
+writeAnalogInput(FILE* file, int index)
+{
+    fprintf(file, "DO(AnIn%i 0){\n", index);
+    fprintf(file, "DA(mag 0 27 1 1 0){\n");
+    fprintf(file, "DA(f 0 10 1 1 0);\n");
+    fprintf(file, "}\n");
+    fprintf(file, "DA(q 0 23 1 2 0);\n");
+    fprintf(file, "DA(t 0 22 1 0 0);\n");
+    fprintf(file, "DA(d 0 20 5 0 0)=\"analog input %i\";\n", index);
+    fprintf(file, "}\n");
+}
+
+static void
+writeSinglePointOutput(FILE* file, int index)
+{
+    fprintf(file, "DO(SPCSO%i 0){\n", index);
+    fprintf(file, "DA(stVal 0 0 0 1 0);\n");
+    fprintf(file, "DA(q 0 23 0 2 0);\n");
+    fprintf(file, "DA(Oper 0 27 12 0 0){\n");
+    fprintf(file, "DA(ctlVal 0 0 12 0 0);\n");
+    fprintf(file, "DA(ctlNum 0 6 12 0 0);\n");
+    fprintf(file, "DA(T 0 22 12 0 0);\n");
+    fprintf(file, "DA(Test 0 0 12 0 0);\n");
+    fprintf(file, "DA(Check 0 24 12 0 0);\n");
+    fprintf(file, "}\n");
+    fprintf(file, "DA(t 0 22 0 0 0);\n");
+    fprintf(file, "DA(ctlModel 0 12 4 0 0)=1;\n");
+    fprintf(file, "}\n");
+}
+
+static void
+writeCommonDataObjects(FILE* file)
+{
+    fprintf(file, "DO(Mod 0){\n");
+    fprintf(file, "DA(stVal 0 12 0 1 0)=1;\n");
+    fprintf(file, "DA(q 0 23 0 2 0);\n");
+    fprintf(file, "DA(t 0 22 0 0 0);\n");
+    fprintf(file, "DA(ctlModel 0 12 4 0 0)=0;\n");
+    fprintf(file, "}\n");
+    fprintf(file, "DO(Beh 0){\n");
+    fprintf(file, "DA(stVal 0 12 0 1 0)=1;\n");
+    fprintf(file, "DA(q 0 23 0 2 0);\n");
+    fprintf(file, "DA(t 0 22 0 0 0);\n");
+    fprintf(file, "}\n");
+    fprintf(file, "DO(NamPlt 0){\n");
+    fprintf(file, "DA(vendor 0 20 5 0 0)=\"MZ Automation\";\n");
+    fprintf(file, "DA(swRev 0 20 5 0 0)=\"1.0\";\n");
+    fprintf(file, "DA(d 0 20 5 0 0);\n");
+    fprintf(file, "}\n");
+}
+
+static bool
+createConfigFile(int numberOfLogicalDevices)
+{
+    FILE* file = fopen(CONFIG_FILE_NAME, "w");
+
+    if (file == NULL)
+        return false;
+
+    fprintf(file, "MODEL(bench){\n");
+
+    int ld;
+
+    for (ld = 0; ld < numberOfLogicalDevices; ld++) {
+        fprintf(file, "LD(LD%i){\n", ld);
+
+        fprintf(file, "LN(LLN0){\n");
+        writeCommonDataObjects(file);
+        fprintf(file, "DS(Events){\n");
+
+        int i;
+
+        for (i = 1; i <= LOGICAL_NODES_PER_LD; i++)
+            fprintf(file, "DE(GGIO%i$ST$SPCSO1$stVal);\n", i);
+
+        fprintf(file, "}\n");
+        fprintf(file, "RC(EventsRCB01 Events 0 Events 1 24 175 50 1000);\n");
+        fprintf(file, "}\n");
+
+        int ln;
+
+        for (ln = 1; ln <= LOGICAL_NODES_PER_LD; ln++) {
+            fprintf(file, "LN(GGIO%i){\n", ln);
+
+            writeCommonDataObjects(file);
+
+            for (i = 1; i <= DATA_OBJECTS_PER_TYPE; i++)
+                writeAnalogInput(file, i);
+
+            for (i = 1; i <= DATA_OBJECTS_PER_TYPE; i++)
+                writeSinglePointOutput(file, i);
+
+            fprintf(file, "DS(AnalogValues){\n");
+
+            for (i = 1; i <= DATA_OBJECTS_PER_TYPE; i++)
+                fprintf(file, "DE(GGIO%i$MX$AnIn%i);\n", ln, i);
+
+            fprintf(file, "}\n");
+            fprintf(file, "RC(AnalogValuesRCB01 AnalogValues 0 AnalogValues 1 24 175 50 1000);\n");
+            fprintf(file, "}\n");
+        }
+
+        fprintf(file, "}\n");
+    }
+
+    fprintf(file, "}\n");
+
+    fclose(file);
+
+    return true;
+}
+
+static int
+countDataAttributes(ModelNode* node)
+{
+    int count = 0;
+
+    while (node) {
+        if (node->modelType == DataAttributeModelType)
+            count++;
+
+        count += countDataAttributes(node->firstChild);
+
+        node = node->sibling;
+    }
+
+    return count;
+}
+
+static char**
+createObjectReferences(ModelNode* node, char** references, int* count)
+{
+    while (node) {
+        if (node->modelType == DataAttributeModelType)
+            references[(*count)++] = ModelNode_getObjectReference(node, NULL);
+
+        createObjectReferences(node->firstChild, references, count);
+
+        node = node->sibling;
+    }
+
+    return references;
+}
+
+static long
+getHeapSize()
+{
+#if defined(__GLIBC__) && ((__GLIBC__ > 2) || (__GLIBC_MINOR__ >= 33))
+    struct mallinfo2 info = mallinfo2();
+
+    return (long) info.uordblks;
+#else
+    return 0;
+#endif
+}
+
+static double
+getElapsedMs(uint64_t startTimeInNs)
+{
+    return (double) (Hal_getTimeInNs() - startTimeInNs) / 1000000.0;
+}
+
+static double
+measureLookup(IedModel* model, char** references, int numberOfReferences)
+{
+    uint64_t startTime = Hal_getTimeInNs();
+
+    int i;
+
+    for (i = 0; i < numberOfReferences; i++) {
+        if (IedModel_getModelNodeByObjectReference(model, references[i]) == NULL) {
+            printf("Lookup of %s failed\n", references[i]);
+            break;
+        }
+    }
+
+    return getElapsedMs(startTime);
+}
+
+static double
+measureServerCreate(IedModel* model, uint8_t valueCacheMode, long* heapUsage, IedServerStartupProfile* profile)
+{
+    IedServerConfig config = IedServerConfig_create();
+
+    IedServerConfig_setValueCacheMode(config, valueCacheMode);
+
+    long heapSize = getHeapSize();
+
+    uint64_t startTime = Hal_getTimeInNs();
+
+    IedServer server = IedServer_createWithConfig(model, NULL, config);
+
+    double elapsed = getElapsedMs(startTime);
+
+    if (heapUsage)
+        *heapUsage = getHeapSize() - heapSize;
+
+    if (profile)
+        IedServer_getStartupProfile(server, profile);
+
+    IedServer_destroy(server);
+    IedServerConfig_destroy(config);
+
+    return elapsed;
+}
+
+static long
+getFileSize(const char* fileName)
+{
+    FILE* file = fopen(fileName, "rb");
+
+    if (file == NULL)
+        return -1;
+
+    fseek(file, 0, SEEK_END);
+
+    long size = ftell(file);
+
+    fclose(file);
+
+    return size;
+}
+
+int
+main(int argc, char** argv)
+{
+    int numberOfLogicalDevices = 40;
+
+    if (argc > 1)
+        numberOfLogicalDevices = atoi(argv[1]);
+
+    if (createConfigFile(numberOfLogicalDevices) == false) {
+        printf("Failed to create config file\n");
+        return -1;
+    }
+
+    /* config file */
+    double parseTime = 0;
+    double writeTime = 0;
+    int numberOfDataAttributes = 0;
+    int memoryUsage = 0;
+    long heapUsage = 0;
+
+    int i;
+
+    for (i = 0; i < REPETITIONS; i++) {
+        long heapSize = getHeapSize();
+
+        uint64_t startTime = Hal_getTimeInNs();
+
+        IedModel* model = ConfigFileParser_createModelFromConfigFileEx(CONFIG_FILE_NAME);
+
+        parseTime += getElapsedMs(startTime);
+
+        heapUsage = getHeapSize() - heapSize;
+
+        if (model == NULL) {
+            printf("Failed to parse config file\n");
+            remove(CONFIG_FILE_NAME);
+            return -1;
+        }
+
+        if (i == 0) {
+            numberOfDataAttributes = countDataAttributes((ModelNode*) model->firstChild);
+            memoryUsage = IedModel_getMemoryUsage(model);
+
+            startTime = Hal_getTimeInNs();
+
+            if (IedModelImage_writeFile(model, IMAGE_FILE_NAME) == false) {
+                printf("Failed to write model image\n");
+                IedModel_destroy(model);
+                remove(CONFIG_FILE_NAME);
+                return -1;
+            }
+
+            writeTime = getElapsedMs(startTime);
+        }
+
+        IedModel_destroy(model);
+    }
+
+    /* model image */
+    double loadTime = 0;
+
+    for (i = 0; i < REPETITIONS; i++) {
+        uint64_t startTime = Hal_getTimeInNs();
+
+        IedModelImage image = IedModelImage_load(IMAGE_FILE_NAME);
+
+        loadTime += getElapsedMs(startTime);
+
+        if (image == NULL) {
+            printf("Failed to load model image\n");
+            remove(CONFIG_FILE_NAME);
+            remove(IMAGE_FILE_NAME);
+            return -1;
+        }
+
+        IedModelImage_destroy(image);
+    }
+
+    /* model lookup and server creation */
+    int numberOfReferences = 0;
+
+    IedModel* model = ConfigFileParser_createModelFromConfigFileEx(CONFIG_FILE_NAME);
+
+    char** references = (char**) malloc(numberOfDataAttributes * sizeof(char*));
+    createObjectReferences((ModelNode*) model->firstChild, references, &numberOfReferences);
+
+    double lookupTimeConfig = measureLookup(model, references, numberOfReferences);
+    long serverHeapUsage = 0;
+    IedServerStartupProfile profile;
+    double serverCreateTimeConfig = measureServerCreate(model, IEC61850_VALUE_CACHE_EAGER, &serverHeapUsage, &profile);
+    IedModel_destroy(model);
+
+    /* the value cache of a server keeps references to the model - use a new model instance */
+    model = ConfigFileParser_createModelFromConfigFileEx(CONFIG_FILE_NAME);
+    IedServerStartupProfile lazyProfile;
+    double lazyServerCreateTime = measureServerCreate(model, IEC61850_VALUE_CACHE_ON_ACCESS, NULL, &lazyProfile);
+    IedModel_destroy(model);
+
+    IedModelImage image = IedModelImage_load(IMAGE_FILE_NAME);
+    double lookupTimeImage = measureLookup(IedModelImage_getModel(image), references, numberOfReferences);
+    double serverCreateTimeImage = measureServerCreate(IedModelImage_getModel(image), IEC61850_VALUE_CACHE_EAGER, NULL, NULL);
+    IedModelImage_destroy(image);
+
+    for (i = 0; i < numberOfReferences; i++)
+        free(references[i]);
+
+    free(references);
+
+    printf("model: %i logical devices, %i data attributes\n", numberOfLogicalDevices, numberOfDataAttributes);
+    printf("model memory: %i bytes (heap: %li bytes)\n", memoryUsage, heapUsage);
+    printf("server memory: %li bytes (heap growth by IedServer_create)\n", serverHeapUsage);
+    printf("config file: %8li bytes | parse      %9.2f ms | lookup %7.2f ms | server create %9.2f ms\n",
+            getFileSize(CONFIG_FILE_NAME), parseTime / REPETITIONS, lookupTimeConfig, serverCreateTimeConfig);
+    printf("model image: %8li bytes | load       %9.2f ms | lookup %7.2f ms | server create %9.2f ms\n",
+            getFileSize(IMAGE_FILE_NAME), loadTime / REPETITIONS, lookupTimeImage, serverCreateTimeImage);
+    printf("                           | write      %9.2f ms\n", writeTime);
+    printf("server create (eager): MMS mapping %.2f ms | MMS server %.2f ms | value cache %.2f ms | data sets %.2f ms | control blocks %.2f ms\n",
+            profile.mmsMappingTimeInUs / 1000.0, profile.mmsServerTimeInUs / 1000.0, profile.valueCacheTimeInUs / 1000.0,
+            profile.dataSetTimeInUs / 1000.0, profile.controlBlockTimeInUs / 1000.0);
+    printf("server create (on access): %.2f ms | %i of %i logical devices populated (%.2f ms)\n", lazyServerCreateTime,
+            lazyProfile.numberOfPopulatedDomains, lazyProfile.numberOfDomains, lazyProfile.lazyPopulationTimeInUs / 1000.0);
+
+    remove(CONFIG_FILE_NAME);
+    remove(IMAGE_FILE_NAME);
+
+    return 0;
+}
@@ -0,0 +1,320 @@
+/*
+ * scl_load_benchmark.c
+ *
+ * Measures the time required to create a data model directly from large SCL files
+ * (SclFileParser_createModelFromSclFile).
+ *
+ * The SCL files are derived from the ICD/SCD files of the model generator (tools/model_generator).
+ * For every file two variants with (at least) the given target size are created:
+ *
+ * - SCD: the IED section is replicated with different IED names. The first and the last IED of
+ *   the file are loaded. Loading the last IED requires to skip all other IED sections.
+ * - large IED: the logical devices of the IED are replicated with different instance names. The
+ *   data model of the IED contains all logical devices of the file.
+ *
+ * usage: scl_load_benchmark [corpus-directory] [target-size-in-MB]
+ *
+ * The default corpus directory is "tools/model_generator" (relative to the source root).
+ */
+
+#include "iec61850_server.h"
+#include "iec61850_config_file_parser.h"
+#include "hal_time.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SCL_FILE_NAME "scl_load_benchmark.scd"
+
+#define REPETITIONS 3
+
+static const char* corpusFiles[] = {
+    "complexModel.icd",
+    "genericIO.icd",
+    "inverter3ph.icd",
+    "inverter_with_report.icd",
+    "sampleModel.icd",
+    "sampleModel_with_dataset.icd",
+    "simpleIO_direct_control_goose.scd",
+    NULL
+};
+
+static char*
+readFile(const char* fileName, long* size)
+{
+    FILE* file = fopen(fileName, "rb");
+
+    if (file == NULL)
+        return NULL;
+
+    fseek(file, 0, SEEK_END);
+    *size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    char* content = (char*) malloc(*size + 1);
+
+    if (content) {
+        if (fread(content, 1, *size, file) != (size_t) *size) {
+            free(content);
+            content = NULL;
+        }
+        else
+            content[*size] = 0;
+    }
+
+    fclose(file);
+
+    return content;
+}
+
+/* position after the opening quote of the attribute value in the tag starting at tag */
+static char*
+findAttributeValue(char* tag, const char* attributeName)
+{
+    char* tagEnd = strchr(tag, '>');
+    char* value = strstr(tag, attributeName);
+
+    if ((tagEnd == NULL) || (value == NULL) || (value > tagEnd))
+        return NULL;
+
+    return strchr(value, '"') + 1;
+}
+
+/* write the text between start and end. The value of the attribute at valuePos gets the suffix _<index> */
+static void
+writeWithSuffix(FILE* file, char* start, char* end, char* valuePos, int index)
+{
+    char* valueEnd = strchr(valuePos, '"');
+
+    fwrite(start, 1, valueEnd - start, file);
+    fprintf(file, "_%i", index);
+    fwrite(valueEnd, 1, end - valueEnd, file);
+}
+
+static int
+createScdFile(char* content, long size, long targetSize, char* firstIed, char* lastIed)
+{
+    char* iedStart = strstr(content, "<IED ");
+    char* iedEnd = iedStart ? strstr(iedStart, "</IED>") : NULL;
+
+    if (iedEnd == NULL)
+        return 0;
+
+    iedEnd += strlen("</IED>");
+
+    char* namePos = findAttributeValue(iedStart, " name=");
+
+    if (namePos == NULL)
+        return 0;
+
+    long iedSize = (long) (iedEnd - iedStart);
+    int numberOfIeds = (int) ((targetSize - (size - iedSize)) / iedSize) + 1;
+
+    if (numberOfIeds < 1)
+        numberOfIeds = 1;
+
+    FILE* file = fopen(SCL_FILE_NAME, "wb");
+
+    if (file == NULL)
+        return 0;
+
+    fwrite(content, 1, iedStart - content, file);
+
+    /* the first IED keeps the original name (referenced by the communication section) */
+    fwrite(iedStart, 1, iedSize, file);
+
+    int i;
+
+    for (i = 1; i < numberOfIeds; i++)
+        writeWithSuffix(file, iedStart, iedEnd, namePos, i);
+
+    fwrite(iedEnd, 1, size - (iedEnd - content), file);
+
+    fclose(file);
+
+    int nameLength = (int) (strchr(namePos, '"') - namePos);
+
+    sprintf(firstIed, "%.*s", nameLength, namePos);
+
+    if (numberOfIeds > 1)
+        sprintf(lastIed, "%.*s_%i", nameLength, namePos, numberOfIeds - 1);
+    else
+        strcpy(lastIed, firstIed);
+
+    return numberOfIeds;
+}
+
+static int
+createLargeIedFile(char* content, long size, long targetSize)
+{
+    char* ldStart = strstr(content, "<LDevice ");
+    char* serverEnd = ldStart ? strstr(ldStart, "</Server>") : NULL;
+
+    if (serverEnd == NULL)
+        return 0;
+
+    long ldSize = (long) (serverEnd - ldStart);
+    int copies = (int) ((targetSize - size) / ldSize) + 1;
+
+    if (copies < 1)
+        copies = 1;
+
+    FILE* file = fopen(SCL_FILE_NAME, "wb");
+
+    if (file == NULL)
+        return 0;
+
+    fwrite(content, 1, serverEnd - content, file);
+
+    int i;
+
+    for (i = 1; i < copies; i++) {
+        char* pos = ldStart;
+        char* ld;
+
+        while (((ld = strstr(pos, "<LDevice ")) != NULL) && (ld < serverEnd)) {
+            char* instPos = findAttributeValue(ld, " inst=");
+
+            if (instPos == NULL)
+                break;
+
+            fwrite(pos, 1, instPos - pos, file);
+            writeWithSuffix(file, instPos, strchr(instPos, '"'), instPos, i);
+
+            pos = strchr(instPos, '"');
+        }
+
+        fwrite(pos, 1, serverEnd - pos, file);
+    }
+
+    fwrite(serverEnd, 1, size - (serverEnd - content), file);
+
+    fclose(file);
+
+    return copies;
+}
+
+static int
+countDataAttributes(ModelNode* node)
+{
+    int count = 0;
+
+    while (node) {
+        if (node->modelType == DataAttributeModelType)
+            count++;
+
+        count += countDataAttributes(node->firstChild);
+
+        node = node->sibling;
+    }
+
+    return count;
+}
+
+static double
+measureLoad(const char* iedName, int* numberOfDataAttributes)
+{
+    double elapsed = 0;
+
+    int i;
+
+    for (i = 0; i < REPETITIONS; i++) {
+        uint64_t startTime = Hal_getTimeInNs();
+
+        IedModel* model = SclFileParser_createModelFromSclFile(SCL_FILE_NAME, iedName, NULL);
+
+        elapsed += (double) (Hal_getTimeInNs() - startTime) / 1000000.0;
+
+        if (model == NULL)
+            return -1;
+
+        if (numberOfDataAttributes)
+            *numberOfDataAttributes = countDataAttributes((ModelNode*) model->firstChild);
+
+        IedModel_destroy(model);
+    }
+
+    return elapsed / REPETITIONS;
+}
+
+static double
+getFileSizeInMB(const char* fileName)
+{
+    FILE* file = fopen(fileName, "rb");
+
+    if (file == NULL)
+        return 0;
+
+    fseek(file, 0, SEEK_END);
+
+    long size = ftell(file);
+
+    fclose(file);
+
+    return (double) size / (1024.0 * 1024.0);
+}
+
+int
+main(int argc, char** argv)
+{
+    const char* corpusDirectory = "tools/model_generator";
+    long targetSize = 50;
+
+    if (argc > 1)
+        corpusDirectory = argv[1];
+
+    if (argc > 2)
+        targetSize = atol(argv[2]);
+
+    targetSize = targetSize * 1024 * 1024;
+
+    printf("%-34s | %-48s | %s\n", "file", "SCD (first IED / last IED)", "large IED");
+
+    int i;
+
+    for (i = 0; corpusFiles[i] != NULL; i++) {
+        char fileName[512];
+
+        snprintf(fileName, sizeof(fileName), "%s/%s", corpusDirectory, corpusFiles[i]);
+
+        long size;
+        char* content = readFile(fileName, &size);
+
+        if (content == NULL) {
+            printf("Failed to read %s\n", fileName);
+            return -1;
+        }
+
+        char firstIed[256];
+        char lastIed[256];
+
+        int numberOfIeds = createScdFile(content, size, targetSize, firstIed, lastIed);
+        double scdSize = getFileSizeInMB(SCL_FILE_NAME);
+
+        int dataAttributesPerIed = 0;
+        double firstIedTime = measureLoad(firstIed, &dataAttributesPerIed);
+        double lastIedTime = measureLoad(lastIed, NULL);
+
+        int copies = createLargeIedFile(content, size, targetSize);
+        double largeIedSize = getFileSizeInMB(SCL_FILE_NAME);
+
+        int numberOfDataAttributes = 0;
+        double largeIedTime = measureLoad(NULL, &numberOfDataAttributes);
+
+        free(content);
+
+        if ((numberOfIeds == 0) || (copies == 0) || (firstIedTime < 0) || (lastIedTime < 0) || (largeIedTime < 0)) {
+            printf("%-34s | failed to load\n", corpusFiles[i]);
+            continue;
+        }
+
+        printf("%-34s | %5.1f MB %5i IEDs %5i DAs %7.2f / %7.2f ms | %5.1f MB %7i DAs %8.2f ms\n",
+                corpusFiles[i], scdSize, numberOfIeds, dataAttributesPerIed, firstIedTime, lastIedTime,
+                largeIedSize, numberOfDataAttributes, largeIedTime);
+    }
+
+    remove(SCL_FILE_NAME);
+
+    return 0;
+}
@@ -0,0 +1,202 @@
+/*
+ * sv_decode_benchmark.c
+ *
+ * Compares the per-element SV ASDU data getters with the bulk getters
+ * for an IEC 61850-9-2 LE data set (8 pairs of INT32 value and quality).
+ *
+ * The SV messages are fed directly into the receiver with SVReceiver_handleMessage
+ * so no network interface is required.
+ *
+ */
+
+#include "hal_time.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sv_subscriber.h"
+
+#define NUMBER_OF_PAIRS 8
+
+static int32_t values[NUMBER_OF_PAIRS];
+static Quality qualities[NUMBER_OF_PAIRS];
+static int64_t checksum = 0;
+
+static void
+perElementListener(SVSubscriber subscriber, void* parameter, SVSubscriber_ASDU asdu)
+{
+    int i;
+
+    for (i = 0; i < NUMBER_OF_PAIRS; i++) {
+        if (SVSubscriber_ASDU_getDataSize(asdu) >= (i * 8) + 8) {
+            values[i] = SVSubscriber_ASDU_getINT32(asdu, i * 8);
+            qualities[i] = SVSubscriber_ASDU_getQuality(asdu, (i * 8) + 4);
+        }
+    }
+
+    checksum += values[NUMBER_OF_PAIRS - 1] + qualities[NUMBER_OF_PAIRS - 1];
+}
+
+static void
+bulkListener(SVSubscriber subscriber, void* parameter, SVSubscriber_ASDU asdu)
+{
+    SVSubscriber_ASDU_getINT32WithQualityValues(asdu, 0, values, qualities, NUMBER_OF_PAIRS);
+
+    checksum += values[NUMBER_OF_PAIRS - 1] + qualities[NUMBER_OF_PAIRS - 1];
+}
+
+/* Create a 9-2 LE like SV message with a single ASDU */
+static int
+createMessage(uint8_t* buffer)
+{
+    int pos = 0;
+    int i;
+
+    uint8_t dstAddr[] = {0x01, 0x0c, 0xcd, 0x04, 0x00, 0x01};
+    uint8_t srcAddr[] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05};
+
+    memcpy(buffer + pos, dstAddr, 6); pos += 6;
+    memcpy(buffer + pos, srcAddr, 6); pos += 6;
+
+    buffer[pos++] = 0x88;
+    buffer[pos++] = 0xba;
+
+    /* APPID */
+    buffer[pos++] = 0x40;
+    buffer[pos++] = 0x00;
+
+    int lengthPos = pos;
+    pos += 2;
+
+    /* reserved 1 + reserved 2 */
+    buffer[pos++] = 0; buffer[pos++] = 0; buffer[pos++] = 0; buffer[pos++] = 0;
+
+    int apduStart = pos;
+
+    const char* svId = "svpub1";
+    int svIdLen = strlen(svId);
+
+    int asduLength = (2 + svIdLen) + 4 + 6 + 3 + (2 + NUMBER_OF_PAIRS * 8);
+    int seqOfAsduLength = 2 + asduLength;
+    int savPduLength = 3 + 2 + seqOfAsduLength;
+
+    buffer[pos++] = 0x60;
+    buffer[pos++] = savPduLength;
+
+    /* noASDU */
+    buffer[pos++] = 0x80; buffer[pos++] = 1; buffer[pos++] = 1;
+
+    buffer[pos++] = 0xa2;
+    buffer[pos++] = seqOfAsduLength;
+
+    buffer[pos++] = 0x30;
+    buffer[pos++] = asduLength;
+
+    buffer[pos++] = 0x80;
+    buffer[pos++] = svIdLen;
+    memcpy(buffer + pos, svId, svIdLen); pos += svIdLen;
+
+    /* smpCnt */
+    buffer[pos++] = 0x82; buffer[pos++] = 2; buffer[pos++] = 0x12; buffer[pos++] = 0x34;
+
+    /* confRev */
+    buffer[pos++] = 0x83; buffer[pos++] = 4;
+    buffer[pos++] = 0; buffer[pos++] = 0; buffer[pos++] = 0; buffer[pos++] = 1;
+
+    /* smpSynch */
+    buffer[pos++] = 0x85; buffer[pos++] = 1; buffer[pos++] = 2;
+
+    buffer[pos++] = 0x87;
+    buffer[pos++] = NUMBER_OF_PAIRS * 8;
+
+    for (i = 0; i < NUMBER_OF_PAIRS; i++) {
+        int32_t value = (i + 1) * -1000;
+
+        buffer[pos++] = (uint8_t) ((uint32_t) value >> 24);
+        buffer[pos++] = (uint8_t) ((uint32_t) value >> 16);
+        buffer[pos++] = (uint8_t) ((uint32_t) value >> 8);
+        buffer[pos++] = (uint8_t) value;
+
+        buffer[pos++] = 0;
+        buffer[pos++] = 0;
+        buffer[pos++] = 0x20;
+        buffer[pos++] = (uint8_t) i;
+    }
+
+    int length = (pos - apduStart) + 8;
+
+    buffer[lengthPos] = (uint8_t) (length >> 8);
+    buffer[lengthPos + 1] = (uint8_t) length;
+
+    return pos;
+}
+
+static uint64_t
+runBenchmark(SVReceiver receiver, uint8_t* message, int messageSize, uint8_t* buffer, int iterations)
+{
+    int i;
+
+    uint64_t start = Hal_getTimeInNs();
+
+    for (i = 0; i < iterations; i++) {
+        /* the receiver modifies the buffer (string termination) -> restore message */
+        memcpy(buffer, message, messageSize);
+        SVReceiver_handleMessage(receiver, buffer, messageSize);
+    }
+
+    return Hal_getTimeInNs() - start;
+}
+
+int
+main(int argc, char** argv)
+{
+    int iterations = 1000000;
+    int i;
+
+    if (argc > 1)
+        iterations = atoi(argv[1]);
+
+    uint8_t message[1518];
+    uint8_t buffer[1518];
+
+    int messageSize = createMessage(message);
+
+    SVReceiver receiver = SVReceiver_create();
+
+    SVSubscriber subscriber = SVSubscriber_create(NULL, 0x4000);
+
+    SVReceiver_addSubscriber(receiver, subscriber);
+
+    /* check that both variants decode the same values */
+    int32_t perElementValues[NUMBER_OF_PAIRS];
+    Quality perElementQualities[NUMBER_OF_PAIRS];
+
+    SVSubscriber_setListener(subscriber, perElementListener, NULL);
+    runBenchmark(receiver, message, messageSize, buffer, 1);
+    memcpy(perElementValues, values, sizeof(values));
+    memcpy(perElementQualities, qualities, sizeof(qualities));
+
+    SVSubscriber_setListener(subscriber, bulkListener, NULL);
+    runBenchmark(receiver, message, messageSize, buffer, 1);
+
+    for (i = 0; i < NUMBER_OF_PAIRS; i++) {
+        if ((values[i] != perElementValues[i]) || (qualities[i] != perElementQualities[i])) {
+            printf("ERROR: value mismatch at index %i\n", i);
+            SVReceiver_destroy(receiver);
+            return 1;
+        }
+    }
+
+    SVSubscriber_setListener(subscriber, perElementListener, NULL);
+    uint64_t perElementTime = runBenchmark(receiver, message, messageSize, buffer, iterations);
+
+    SVSubscriber_setListener(subscriber, bulkListener, NULL);
+    uint64_t bulkTime = runBenchmark(receiver, message, messageSize, buffer, iterations);
+
+    printf("%i ASDUs with %i INT32/quality pairs (checksum %lli)\n", iterations, NUMBER_OF_PAIRS, (long long) checksum);
+    printf("  per element getters: %8.2f ns/ASDU\n", (double) perElementTime / iterations);
+    printf("  bulk getter:          %8.2f ns/ASDU\n", (double) bulkTime / iterations);
+
+    SVReceiver_destroy(receiver);
+
+    return 0;
+}
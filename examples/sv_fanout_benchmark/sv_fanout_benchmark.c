@@ -0,0 +1,287 @@
+/*
+ * sv_fanout_benchmark.c
+ *
+ * Measures the SV receive throughput with a single receive thread and with
+ * multiple receive threads (socket fanout, see SVReceiver_enableFanout).
+ *
+ * A sender thread publishes SV messages with different APPIDs as fast as possible
+ * on the given interface (default "lo"). Each received ASDU is charged with a
+ * configurable amount of simulated application work.
+ *
+ * After each run the distribution of the streams over the receive threads is
+ * checked: every stream has to be handled by a single thread and, with fanout
+ * enabled, the streams have to be spread over all receive threads.
+ *
+ * Requires permission to open raw sockets (e.g. run as root).
+ *
+ * usage: sv_fanout_benchmark [interface] [threads] [work-ns] [seconds]
+ */
+
+#include "hal_thread.h"
+#include "hal_time.h"
+#include "platform_atomic.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sv_publisher.h"
+#include "sv_subscriber.h"
+
+#define NUMBER_OF_STREAMS 16
+#define MAX_RECEIVE_THREADS 64
+
+#if defined(_MSC_VER)
+#define THREAD_LOCAL __declspec(thread)
+#else
+#define THREAD_LOCAL __thread
+#endif
+
+static const char* interface = "lo";
+static int workNs = 2000;
+
+static volatile bool sending = false;
+static volatile uint32_t sentMessages = 0;
+static volatile uint32_t receivedASDUs[NUMBER_OF_STREAMS];
+
+/* ASDUs received per receive thread and stream */
+static volatile uint32_t threadASDUs[MAX_RECEIVE_THREADS][NUMBER_OF_STREAMS];
+static volatile int32_t numberOfReceiveThreads = 0;
+static volatile int32_t runNumber = 0;
+
+static THREAD_LOCAL int threadIndex = -1;
+static THREAD_LOCAL int threadRunNumber = -1;
+
+static int
+getReceiveThreadIndex(void)
+{
+    int run = Atomic_load32(&runNumber);
+
+    if (threadRunNumber != run) {
+        threadIndex = Atomic_fetchAdd32(&numberOfReceiveThreads, 1);
+        threadRunNumber = run;
+    }
+
+    return threadIndex;
+}
+
+static void
+svUpdateListener(SVSubscriber subscriber, void* parameter, SVSubscriber_ASDU asdu)
+{
+    int stream = (int) (intptr_t) parameter;
+
+    /* simulated application work */
+    nsSinceEpoch end = Hal_getTimeInNs() + workNs;
+
+    while (Hal_getTimeInNs() < end);
+
+    receivedASDUs[stream]++;
+
+    int thread = getReceiveThreadIndex();
+
+    if (thread < MAX_RECEIVE_THREADS)
+        threadASDUs[thread][stream]++;
+}
+
+static void*
+senderThread(void* parameter)
+{
+    SVPublisher publishers[NUMBER_OF_STREAMS];
+    SVPublisher_ASDU asdus[NUMBER_OF_STREAMS];
+    int i;
+
+    for (i = 0; i < NUMBER_OF_STREAMS; i++) {
+        CommParameters parameters;
+
+        parameters.vlanPriority = 4;
+        parameters.vlanId = 0;
+        parameters.appId = 0x4000 + i;
+        parameters.dstAddress[0] = 0x01;
+        parameters.dstAddress[1] = 0x0c;
+        parameters.dstAddress[2] = 0xcd;
+        parameters.dstAddress[3] = 0x04;
+        parameters.dstAddress[4] = 0x00;
+        parameters.dstAddress[5] = (uint8_t) i;
+
+        publishers[i] = SVPublisher_create(&parameters, interface);
+
+        if (publishers[i] == NULL) {
+            printf("Failed to create SV publisher\n");
+            sending = false;
+            return NULL;
+        }
+
+        asdus[i] = SVPublisher_addASDU(publishers[i], "svpub", NULL, 1);
+
+        int j;
+
+        for (j = 0; j < 8; j++) {
+            SVPublisher_ASDU_addINT32(asdus[i]);
+            SVPublisher_ASDU_addQuality(asdus[i]);
+        }
+
+        SVPublisher_setupComplete(publishers[i]);
+    }
+
+    while (sending) {
+        for (i = 0; i < NUMBER_OF_STREAMS; i++) {
+            SVPublisher_ASDU_increaseSmpCnt(asdus[i]);
+            SVPublisher_publish(publishers[i]);
+            sentMessages++;
+        }
+    }
+
+    for (i = 0; i < NUMBER_OF_STREAMS; i++)
+        SVPublisher_destroy(publishers[i]);
+
+    return NULL;
+}
+
+static bool
+checkDistribution(int fanoutSize)
+{
+    int receiveThreads = Atomic_load32(&numberOfReceiveThreads);
+    int expectedThreads = (fanoutSize < NUMBER_OF_STREAMS) ? fanoutSize : NUMBER_OF_STREAMS;
+    bool ok = true;
+    int threadsWithStreams = 0;
+    int thread;
+    int i;
+
+    if (receiveThreads > MAX_RECEIVE_THREADS)
+        receiveThreads = MAX_RECEIVE_THREADS;
+
+    for (thread = 0; thread < receiveThreads; thread++) {
+        int streams = 0;
+        uint64_t received = 0;
+
+        for (i = 0; i < NUMBER_OF_STREAMS; i++) {
+            if (threadASDUs[thread][i] > 0) {
+                streams++;
+                received += threadASDUs[thread][i];
+            }
+        }
+
+        if (streams > 0)
+            threadsWithStreams++;
+
+        printf("  receive thread %i: streams: %i  received: %llu\n", thread, streams, (unsigned long long) received);
+    }
+
+    for (i = 0; i < NUMBER_OF_STREAMS; i++) {
+        int threads = 0;
+
+        for (thread = 0; thread < receiveThreads; thread++) {
+            if (threadASDUs[thread][i] > 0)
+                threads++;
+        }
+
+        if (threads > 1) {
+            printf("  stream %i was handled by %i receive threads\n", i, threads);
+            ok = false;
+        }
+    }
+
+    if (threadsWithStreams < expectedThreads) {
+        printf("  streams are spread over %i of %i receive threads\n", threadsWithStreams, expectedThreads);
+        ok = false;
+    }
+
+    printf("distribution: %s\n", ok ? "OK" : "FAILED");
+
+    return ok;
+}
+
+static bool
+runBenchmark(int numberOfThreads, int seconds)
+{
+    SVReceiver receiver = SVReceiver_create();
+
+    SVReceiver_setInterfaceId(receiver, interface);
+    SVReceiver_enableFanout(receiver, numberOfThreads);
+
+    int i;
+
+    memset((void*) threadASDUs, 0, sizeof(threadASDUs));
+    Atomic_store32(&numberOfReceiveThreads, 0);
+    Atomic_fetchAdd32(&runNumber, 1);
+
+    for (i = 0; i < NUMBER_OF_STREAMS; i++) {
+        SVSubscriber subscriber = SVSubscriber_create(NULL, 0x4000 + i);
+
+        SVSubscriber_setListener(subscriber, svUpdateListener, (void*) (intptr_t) i);
+        SVReceiver_addSubscriber(receiver, subscriber);
+
+        receivedASDUs[i] = 0;
+    }
+
+    SVReceiver_start(receiver);
+
+    if (SVReceiver_isRunning(receiver) == false) {
+        printf("Failed to start SV receiver (root permission required?)\n");
+        SVReceiver_destroy(receiver);
+        exit(-1);
+    }
+
+    sentMessages = 0;
+    sending = true;
+
+    Thread sender = Thread_create(senderThread, NULL, false);
+    Thread_start(sender);
+
+    Thread_sleep(seconds * 1000);
+
+    sending = false;
+    Thread_destroy(sender);
+
+    /* let the receive threads process the pending messages */
+    Thread_sleep(200);
+
+    int fanoutSize = SVReceiver_getFanoutSize(receiver);
+
+    SVReceiver_stop(receiver);
+
+    uint64_t received = 0;
+
+    for (i = 0; i < NUMBER_OF_STREAMS; i++)
+        received += receivedASDUs[i];
+
+    printf("threads: %i (requested %i)  sent: %u  received: %llu  rate: %.0f ASDUs/s  loss: %.1f %%\n",
+            fanoutSize, numberOfThreads, sentMessages, (unsigned long long) received,
+            (double) received / seconds,
+            (sentMessages > 0) ? (100.0 * (double) (sentMessages - received) / sentMessages) : 0.0);
+
+    bool distributionOk = checkDistribution(fanoutSize);
+
+    SVReceiver_destroy(receiver);
+
+    return distributionOk;
+}
+
+int
+main(int argc, char** argv)
+{
+    int numberOfThreads = 4;
+    int seconds = 3;
+
+    if (argc > 1)
+        interface = argv[1];
+
+    if (argc > 2)
+        numberOfThreads = atoi(argv[2]);
+
+    if (argc > 3)
+        workNs = atoi(argv[3]);
+
+    if (argc > 4)
+        seconds = atoi(argv[4]);
+
+    printf("interface: %s  streams: %i  work per ASDU: %i ns\n", interface, NUMBER_OF_STREAMS, workNs);
+
+    bool ok = true;
+
+    if (runBenchmark(1, seconds) == false)
+        ok = false;
+
+    if (runBenchmark(numberOfThreads, seconds) == false)
+        ok = false;
+
+    return ok ? 0 : 1;
+}
@@ -442,6 +442,12 @@ Ethernet_destroySocket(EthernetSocket self)
     GLOBAL_FREEMEM(self);
 }
 
+int
+Ethernet_joinFanoutGroup(EthernetSocket ethSocket, int groupId)
+{
+    return -1;
+}
+
 bool
 Ethernet_isSupported()
 {
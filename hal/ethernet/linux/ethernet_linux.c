@@ -314,17 +314,100 @@ Ethernet_setProtocolFilter(EthernetSocket ethSocket, uint16_t etherType)
 }
 
 
-/* non-blocking receive */
-int
-Ethernet_receivePacket(EthernetSocket self, uint8_t* buffer, int bufferSize)
+#ifndef PACKET_FANOUT
+#define PACKET_FANOUT 18
+#endif
+
+#ifndef PACKET_FANOUT_DATA
+#define PACKET_FANOUT_DATA 22
+#endif
+
+#ifndef PACKET_FANOUT_HASH
+#define PACKET_FANOUT_HASH 0
+#endif
+
+#ifndef PACKET_FANOUT_CBPF
+#define PACKET_FANOUT_CBPF 6
+#endif
+
+#ifndef PACKET_FANOUT_FLAG_UNIQUEID
+#define PACKET_FANOUT_FLAG_UNIQUEID 0x2000
+#endif
+
+static bool
+bindSocket(EthernetSocket self)
 {
     if (self->isBind == false) {
         if (bind(self->rawSocket, (struct sockaddr*) &self->socketAddress, sizeof(self->socketAddress)) == 0)
             self->isBind = true;
-        else
-            return 0;
     }
 
+    return self->isBind;
+}
+
+int
+Ethernet_joinFanoutGroup(EthernetSocket ethSocket, int groupId)
+{
+    /* the socket has to be bound to join a fanout group */
+    if (bindSocket(ethSocket) == false)
+        return -1;
+
+    int fanoutArg;
+
+    if (groupId == -1)
+        fanoutArg = (PACKET_FANOUT_CBPF | PACKET_FANOUT_FLAG_UNIQUEID) << 16;
+    else
+        fanoutArg = (groupId & 0xffff) | (PACKET_FANOUT_CBPF << 16);
+
+    if (setsockopt(ethSocket->rawSocket, SOL_PACKET, PACKET_FANOUT, &fanoutArg, sizeof(fanoutArg)) == -1) {
+        if (DEBUG_SOCKET)
+            printf("ETHERNET_LINUX: Joining fanout group failed\n");
+
+        return -1;
+    }
+
+    /*
+     * select the socket by APPID - the kernel takes the result modulo the number of sockets in the group.
+     *
+     * The fanout program runs on the packet starting at the network header and a VLAN tag
+     * has already been removed by the kernel, so the APPID is always at offset 0.
+     */
+    struct sock_filter filter[] = {
+        { 0x28, 0, 0, 0x00000000 }, /* ldh [0] (APPID) */
+        { 0x16, 0, 0, 0x00000000 }  /* ret a */
+    };
+
+    struct sock_fprog fprog;
+
+    fprog.len = sizeof(filter) / sizeof(*filter);
+    fprog.filter = filter;
+
+    if (setsockopt(ethSocket->rawSocket, SOL_PACKET, PACKET_FANOUT_DATA, &fprog, sizeof(fprog)) == -1) {
+        if (DEBUG_SOCKET)
+            printf("ETHERNET_LINUX: Setting fanout filter failed\n");
+
+        return -1;
+    }
+
+    if (groupId == -1) {
+        socklen_t len = sizeof(fanoutArg);
+
+        if (getsockopt(ethSocket->rawSocket, SOL_PACKET, PACKET_FANOUT, &fanoutArg, &len) == -1)
+            return -1;
+
+        groupId = fanoutArg & 0xffff;
+    }
+
+    return groupId;
+}
+
+/* non-blocking receive */
+int
+Ethernet_receivePacket(EthernetSocket self, uint8_t* buffer, int bufferSize)
+{
+    if (bindSocket(self) == false)
+        return 0;
+
     return recvfrom(self->rawSocket, buffer, bufferSize, MSG_DONTWAIT, 0, 0);
 }
 
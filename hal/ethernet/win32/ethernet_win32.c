@@ -433,6 +433,12 @@ Ethernet_receivePacket(EthernetSocket self, uint8_t* buffer, int bufferSize)
     }
 }
 
+int
+Ethernet_joinFanoutGroup(EthernetSocket ethSocket, int groupId)
+{
+    return -1;
+}
+
 bool
 Ethernet_isSupported()
 {
@@ -441,6 +447,12 @@ Ethernet_isSupported()
 
 #else
 
+int
+Ethernet_joinFanoutGroup(EthernetSocket ethSocket, int groupId)
+{
+    return -1;
+}
+
 bool
 Ethernet_isSupported()
 {
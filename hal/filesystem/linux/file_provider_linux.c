@@ -28,6 +28,7 @@
 #include <stdio.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
 #include <unistd.h>
 
 #include "hal_filesystem.h"
@@ -68,6 +69,43 @@ FileSystem_closeFile(FileHandle handle)
     fclose((FILE*) handle);
 }
 
+uint8_t*
+FileSystem_mapFile(FileHandle handle, uint32_t size)
+{
+    if (size == 0)
+        return NULL;
+
+    void* mapping = mmap(NULL, size, PROT_READ, MAP_SHARED, fileno((FILE*) handle), 0);
+
+    if (mapping == MAP_FAILED)
+        return NULL;
+
+    /* files are read from the beginning to the end */
+    madvise(mapping, size, MADV_SEQUENTIAL);
+
+    return (uint8_t*) mapping;
+}
+
+uint8_t*
+FileSystem_mapFileCopyOnWrite(FileHandle handle, uint32_t size)
+{
+    if (size == 0)
+        return NULL;
+
+    void* mapping = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileno((FILE*) handle), 0);
+
+    if (mapping == MAP_FAILED)
+        return NULL;
+
+    return (uint8_t*) mapping;
+}
+
+void
+FileSystem_unmapFile(uint8_t* mapping, uint32_t size)
+{
+    munmap(mapping, size);
+}
+
 bool
 FileSystem_deleteFile(char* filename)
 {
@@ -35,6 +35,7 @@
 #include "lib_memory.h"
 
 #include <malloc.h>
+#include <io.h>
 
 #include <windows.h>
 
@@ -77,6 +78,61 @@ FileSystem_closeFile(FileHandle handle)
     fclose((FILE*) handle);
 }
 
+uint8_t*
+FileSystem_mapFile(FileHandle handle, uint32_t size)
+{
+    if (size == 0)
+        return NULL;
+
+    HANDLE fileHandle = (HANDLE) _get_osfhandle(_fileno((FILE*) handle));
+
+    if (fileHandle == INVALID_HANDLE_VALUE)
+        return NULL;
+
+    HANDLE mappingHandle = CreateFileMapping(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+
+    if (mappingHandle == NULL)
+        return NULL;
+
+    void* mapping = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, size);
+
+    /* the view keeps a reference to the mapping object */
+    CloseHandle(mappingHandle);
+
+    return (uint8_t*) mapping;
+}
+
+uint8_t*
+FileSystem_mapFileCopyOnWrite(FileHandle handle, uint32_t size)
+{
+    if (size == 0)
+        return NULL;
+
+    HANDLE fileHandle = (HANDLE) _get_osfhandle(_fileno((FILE*) handle));
+
+    if (fileHandle == INVALID_HANDLE_VALUE)
+        return NULL;
+
+    HANDLE mappingHandle = CreateFileMapping(fileHandle, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+
+    if (mappingHandle == NULL)
+        return NULL;
+
+    void* mapping = MapViewOfFile(mappingHandle, FILE_MAP_COPY, 0, 0, size);
+
+    CloseHandle(mappingHandle);
+
+    return (uint8_t*) mapping;
+}
+
+void
+FileSystem_unmapFile(uint8_t* mapping, uint32_t size)
+{
+    (void)size;
+
+    UnmapViewOfFile(mapping);
+}
+
 bool
 FileSystem_getFileInfo(char* filename, uint32_t* fileSize, uint64_t* lastModificationTimestamp)
 {
@@ -171,6 +171,23 @@ Ethernet_setProtocolFilter(EthernetSocket ethSocket, uint16_t etherType);
 PAL_API int
 Ethernet_receivePacket(EthernetSocket ethSocket, uint8_t* buffer, int bufferSize);
 
+/**
+ * \brief Add the Ethernet socket to a fanout group to distribute received messages over multiple sockets
+ *
+ * Received messages are distributed by the APPID of the GOOSE/SV message (the 16 bit value following
+ * the Ethertype, VLAN tags are skipped) so that all messages of the same APPID are received by the same
+ * socket. The protocol filter has to be set before calling this function.
+ *
+ * NOTE: Implementation is optional (currently only supported on Linux)
+ *
+ * \param ethSocket the ethernet socket handle
+ * \param groupId the ID of the fanout group to join, or -1 to create a new group
+ *
+ * \return the ID of the fanout group, or -1 if the socket cannot be added to a fanout group
+ */
+PAL_API int
+Ethernet_joinFanoutGroup(EthernetSocket ethSocket, int groupId);
+
 /**
  * \brief Indicates if runtime provides support for direct Ethernet access
  *
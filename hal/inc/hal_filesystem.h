@@ -83,6 +83,45 @@ FileSystem_writeFile(FileHandle handle, uint8_t* buffer, int size);
 PAL_API void
 FileSystem_closeFile(FileHandle handle);
 
+/**
+ * \brief map the content of an open file into memory (read only)
+ *
+ * This function is optional. Platforms without support for memory-mapped files return NULL
+ * and the caller has to use \ref FileSystem_readFile instead. The file must not be truncated
+ * while it is mapped.
+ *
+ * \param handle the file handle to identify the file
+ * \param size the number of bytes to map (the file size)
+ *
+ * \return pointer to the mapped file content or NULL if the file cannot be mapped
+ */
+PAL_API uint8_t*
+FileSystem_mapFile(FileHandle handle, uint32_t size);
+
+/**
+ * \brief map the content of an open file into memory with copy-on-write semantics
+ *
+ * Other than \ref FileSystem_mapFile the mapped content can be modified. The changes
+ * are private to the caller and are not written to the file. This function is optional.
+ * Platforms without support for memory-mapped files return NULL.
+ *
+ * \param handle the file handle to identify the file
+ * \param size the number of bytes to map (the file size)
+ *
+ * \return pointer to the mapped file content or NULL if the file cannot be mapped
+ */
+PAL_API uint8_t*
+FileSystem_mapFileCopyOnWrite(FileHandle handle, uint32_t size);
+
+/**
+ * \brief release a mapping created by \ref FileSystem_mapFile or \ref FileSystem_mapFileCopyOnWrite
+ *
+ * \param mapping the pointer returned by FileSystem_mapFile
+ * \param size the size used for FileSystem_mapFile
+ */
+PAL_API void
+FileSystem_unmapFile(uint8_t* mapping, uint32_t size);
+
 /**
  * \brief return attributes of the given file
  *
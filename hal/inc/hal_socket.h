@@ -107,6 +107,19 @@ Handleset_removeSocket(HandleSet self, const Socket sock);
 PAL_API int
 Handleset_waitReady(HandleSet self, unsigned int timeoutMs);
 
+/**
+ * \brief check if a socket was ready at the last call of Handleset_waitReady
+ *
+ * The check is fast when the sockets are checked in the order they were added to the handle set.
+ *
+ * \param self the HandleSet instance
+ * \param sock the socket to check
+ *
+ * \return true when data is pending on the socket (or the socket is in an error state), false otherwise
+ */
+PAL_API bool
+Handleset_isReady(HandleSet self, const Socket sock);
+
 /**
  * \brief destroy the HandleSet instance
  *
@@ -87,6 +87,16 @@ Semaphore_create(int initialValue);
 PAL_API void
 Semaphore_wait(Semaphore self);
 
+/**
+ * \brief Wait until the semaphore value is greater than zero or the timeout is reached
+ *
+ * \param timeoutInMs maximum time to wait in milliseconds
+ *
+ * \return true when the semaphore value has been decreased, false when the timeout has been reached
+ */
+PAL_API bool
+Semaphore_waitTimeout(Semaphore self, uint32_t timeoutInMs);
+
 PAL_API void
 Semaphore_post(Semaphore self);
 
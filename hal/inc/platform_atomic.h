@@ -0,0 +1,235 @@
+/*
+ *  platform_atomic.h
+ *
+ *  Atomic operations abstraction layer
+ *
+ *  This file is part of Platform Abstraction Layer (libpal)
+ *  for libiec61850, libmms, and lib60870.
+ */
+
+#ifndef PLATFORM_ATOMIC_H_
+#define PLATFORM_ATOMIC_H_
+
+#include "hal_base.h"
+
+/*
+ * Minimal set of atomic operations used for lock-free data paths.
+ *
+ * All read-modify-write operations are sequentially consistent. Loads have
+ * acquire semantics and stores have release semantics.
+ *
+ * When no atomic builtins are available PLATFORM_HAS_ATOMICS is 0 and the
+ * operations are plain memory accesses (only suitable for single threaded use).
+ */
+
+#if defined(__GNUC__) || defined(__clang__)
+
+#define PLATFORM_HAS_ATOMICS 1
+
+static inline int32_t
+Atomic_load32(volatile int32_t* ptr)
+{
+    return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+}
+
+static inline void
+Atomic_store32(volatile int32_t* ptr, int32_t value)
+{
+    __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+}
+
+static inline int32_t
+Atomic_fetchAdd32(volatile int32_t* ptr, int32_t value)
+{
+    return __atomic_fetch_add(ptr, value, __ATOMIC_SEQ_CST);
+}
+
+static inline bool
+Atomic_compareExchange32(volatile int32_t* ptr, int32_t expected, int32_t desired)
+{
+    return __atomic_compare_exchange_n(ptr, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+
+static inline uint64_t
+Atomic_load64(volatile uint64_t* ptr)
+{
+    return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+}
+
+static inline void
+Atomic_store64(volatile uint64_t* ptr, uint64_t value)
+{
+    __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+}
+
+static inline uint64_t
+Atomic_fetchAdd64(volatile uint64_t* ptr, uint64_t value)
+{
+    return __atomic_fetch_add(ptr, value, __ATOMIC_SEQ_CST);
+}
+
+static inline void*
+Atomic_loadPointer(void* volatile* ptr)
+{
+    return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+}
+
+static inline void
+Atomic_storePointer(void* volatile* ptr, void* value)
+{
+    __atomic_store_n(ptr, value, __ATOMIC_SEQ_CST);
+}
+
+static inline void
+Atomic_fence(void)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+#elif defined(_MSC_VER)
+
+#include <windows.h>
+#include <intrin.h>
+
+#define PLATFORM_HAS_ATOMICS 1
+
+static __inline int32_t
+Atomic_load32(volatile int32_t* ptr)
+{
+    int32_t value = *ptr;
+    _ReadWriteBarrier();
+    return value;
+}
+
+static __inline void
+Atomic_store32(volatile int32_t* ptr, int32_t value)
+{
+    _ReadWriteBarrier();
+    *ptr = value;
+}
+
+static __inline int32_t
+Atomic_fetchAdd32(volatile int32_t* ptr, int32_t value)
+{
+    return (int32_t) InterlockedExchangeAdd((volatile LONG*) ptr, (LONG) value);
+}
+
+static __inline bool
+Atomic_compareExchange32(volatile int32_t* ptr, int32_t expected, int32_t desired)
+{
+    return (InterlockedCompareExchange((volatile LONG*) ptr, (LONG) desired, (LONG) expected) == (LONG) expected);
+}
+
+static __inline uint64_t
+Atomic_load64(volatile uint64_t* ptr)
+{
+    return (uint64_t) InterlockedCompareExchange64((volatile LONG64*) ptr, 0, 0);
+}
+
+static __inline void
+Atomic_store64(volatile uint64_t* ptr, uint64_t value)
+{
+    InterlockedExchange64((volatile LONG64*) ptr, (LONG64) value);
+}
+
+static __inline uint64_t
+Atomic_fetchAdd64(volatile uint64_t* ptr, uint64_t value)
+{
+    return (uint64_t) InterlockedExchangeAdd64((volatile LONG64*) ptr, (LONG64) value);
+}
+
+static __inline void*
+Atomic_loadPointer(void* volatile* ptr)
+{
+    void* value = *ptr;
+    _ReadWriteBarrier();
+    return value;
+}
+
+static __inline void
+Atomic_storePointer(void* volatile* ptr, void* value)
+{
+    InterlockedExchangePointer(ptr, value);
+}
+
+static __inline void
+Atomic_fence(void)
+{
+    MemoryBarrier();
+}
+
+#else
+
+#define PLATFORM_HAS_ATOMICS 0
+
+static inline int32_t
+Atomic_load32(volatile int32_t* ptr)
+{
+    return *ptr;
+}
+
+static inline void
+Atomic_store32(volatile int32_t* ptr, int32_t value)
+{
+    *ptr = value;
+}
+
+static inline int32_t
+Atomic_fetchAdd32(volatile int32_t* ptr, int32_t value)
+{
+    int32_t oldValue = *ptr;
+    *ptr = oldValue + value;
+    return oldValue;
+}
+
+static inline bool
+Atomic_compareExchange32(volatile int32_t* ptr, int32_t expected, int32_t desired)
+{
+    if (*ptr == expected) {
+        *ptr = desired;
+        return true;
+    }
+
+    return false;
+}
+
+static inline uint64_t
+Atomic_load64(volatile uint64_t* ptr)
+{
+    return *ptr;
+}
+
+static inline void
+Atomic_store64(volatile uint64_t* ptr, uint64_t value)
+{
+    *ptr = value;
+}
+
+static inline uint64_t
+Atomic_fetchAdd64(volatile uint64_t* ptr, uint64_t value)
+{
+    uint64_t oldValue = *ptr;
+    *ptr = oldValue + value;
+    return oldValue;
+}
+
+static inline void*
+Atomic_loadPointer(void* volatile* ptr)
+{
+    return *ptr;
+}
+
+static inline void
+Atomic_storePointer(void* volatile* ptr, void* value)
+{
+    *ptr = value;
+}
+
+static inline void
+Atomic_fence(void)
+{
+}
+
+#endif
+
+#endif /* PLATFORM_ATOMIC_H_ */
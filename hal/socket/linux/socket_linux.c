@@ -54,6 +54,7 @@ struct sHandleSet {
     bool pollfdIsUpdated;
     struct pollfd* fds;
     int nfds;
+    int nextIndex; /* start index for Handleset_isReady */
 };
 
 HandleSet
@@ -66,6 +67,7 @@ Handleset_new(void)
        self->pollfdIsUpdated = false;
        self->fds = NULL;
        self->nfds = 0;
+       self->nextIndex = 0;
    }
 
    return self;
@@ -154,6 +156,28 @@ Handleset_waitReady(HandleSet self, unsigned int timeoutMs)
     }
 }
 
+bool
+Handleset_isReady(HandleSet self, const Socket sock)
+{
+    if ((self == NULL) || (sock == NULL) || (self->fds == NULL) || (self->pollfdIsUpdated == false))
+        return false;
+
+    int i;
+
+    /* sockets are usually checked in the order they were added -> start after the last match */
+    for (i = 0; i < self->nfds; i++) {
+        int index = (self->nextIndex + i) % self->nfds;
+
+        if (self->fds[index].fd == sock->fd) {
+            self->nextIndex = index + 1;
+
+            return (self->fds[index].revents != 0);
+        }
+    }
+
+    return false;
+}
+
 void
 Handleset_destroy(HandleSet self)
 {
@@ -43,6 +43,7 @@ struct sServerSocket {
 
 struct sHandleSet {
    fd_set handles;
+   fd_set readyHandles; /* result of the last Handleset_waitReady call */
    SOCKET maxHandle;
 };
 
@@ -57,6 +58,7 @@ Handleset_new(void)
 
     if (result != NULL) {
         FD_ZERO(&result->handles);
+        FD_ZERO(&result->readyHandles);
         result->maxHandle = INVALID_SOCKET;
     }
 
@@ -67,6 +69,7 @@ void
 Handleset_reset(HandleSet self)
 {
     FD_ZERO(&self->handles);
+    FD_ZERO(&self->readyHandles);
     self->maxHandle = INVALID_SOCKET;
 }
 
@@ -101,11 +104,12 @@ Handleset_waitReady(HandleSet self, unsigned int timeoutMs)
         timeout.tv_sec = timeoutMs / 1000;
         timeout.tv_usec = (timeoutMs % 1000) * 1000;
 
-        fd_set handles;
+        memcpy((void*)&(self->readyHandles), &(self->handles), sizeof(fd_set));
 
-        memcpy((void*)&handles, &(self->handles), sizeof(fd_set));
+        result = select(self->maxHandle + 1, &(self->readyHandles), NULL, NULL, &timeout);
 
-        result = select(self->maxHandle + 1, &handles, NULL, NULL, &timeout);
+        if (result < 1)
+            FD_ZERO(&self->readyHandles);
     } else {
         result = -1;
     }
@@ -113,6 +117,15 @@ Handleset_waitReady(HandleSet self, unsigned int timeoutMs)
     return result;
 }
 
+bool
+Handleset_isReady(HandleSet self, const Socket sock)
+{
+    if ((self != NULL) && (sock != NULL) && (sock->fd != INVALID_SOCKET))
+        return (FD_ISSET(sock->fd, &self->readyHandles) != 0);
+    else
+        return false;
+}
+
 void
 Handleset_destroy(HandleSet self)
 {
@@ -10,6 +10,8 @@
 #include <pthread.h>
 #include <semaphore.h>
 #include <unistd.h>
+#include <errno.h>
+#include <time.h>
 #include "hal_thread.h"
 #include "lib_memory.h"
 
@@ -38,6 +40,29 @@ Semaphore_wait(Semaphore self)
     sem_wait((sem_t*) self);
 }
 
+bool
+Semaphore_waitTimeout(Semaphore self, uint32_t timeoutInMs)
+{
+    struct timespec timeout;
+
+    clock_gettime(CLOCK_REALTIME, &timeout);
+
+    timeout.tv_sec += timeoutInMs / 1000;
+    timeout.tv_nsec += (long) (timeoutInMs % 1000) * 1000000L;
+
+    if (timeout.tv_nsec >= 1000000000L) {
+        timeout.tv_sec++;
+        timeout.tv_nsec -= 1000000000L;
+    }
+
+    while (sem_timedwait((sem_t*) self, &timeout) != 0) {
+        if (errno != EINTR)
+            return false;
+    }
+
+    return true;
+}
+
 void
 Semaphore_post(Semaphore self)
 {
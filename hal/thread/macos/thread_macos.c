@@ -66,6 +66,25 @@ Semaphore_wait(Semaphore self)
     }
 }
 
+/* try to lock the mutex until the timeout (pthread_mutex_timedlock is not available) */
+bool
+Semaphore_waitTimeout(Semaphore self, uint32_t timeoutInMs)
+{
+    mSemaphore mSelf = (mSemaphore) self;
+
+    uint32_t elapsedTime = 0;
+
+    while (pthread_mutex_trylock(&(mSelf->mutex)) != 0) {
+        if (elapsedTime >= timeoutInMs)
+            return false;
+
+        usleep(1000);
+        elapsedTime++;
+    }
+
+    return true;
+}
+
 /* unlock mutex */
 void
 Semaphore_post(Semaphore self)
@@ -99,6 +99,12 @@ Semaphore_wait(Semaphore self)
     WaitForSingleObject((HANDLE) self, INFINITE);
 }
 
+bool
+Semaphore_waitTimeout(Semaphore self, uint32_t timeoutInMs)
+{
+    return (WaitForSingleObject((HANDLE) self, timeoutInMs) == WAIT_OBJECT_0);
+}
+
 void
 Semaphore_post(Semaphore self)
 {
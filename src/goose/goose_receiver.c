@@ -45,6 +45,15 @@
 
 #define ETH_P_GOOSE 0x88b8
 
+#if (CONFIG_MMS_THREADLESS_STACK == 0)
+typedef struct {
+    GooseReceiver receiver;
+    EthernetSocket ethSocket;
+    uint8_t* buffer;
+    Thread thread;
+} GooseReceiverFanoutShard;
+#endif
+
 struct sGooseReceiver
 {
     bool running;
@@ -55,6 +64,13 @@ struct sGooseReceiver
     LinkedList subscriberList;
 #if (CONFIG_MMS_THREADLESS_STACK == 0)
     Thread thread;
+
+    /* option: number of sockets/threads used to receive messages */
+    int fanoutSize;
+
+    /* additional sockets of the fanout group (the first socket is ethSocket) */
+    int numberOfFanoutShards;
+    GooseReceiverFanoutShard* fanoutShards;
 #endif
 };
 
@@ -72,6 +88,9 @@ GooseReceiver_createEx(uint8_t* buffer)
         self->subscriberList = LinkedList_create();
 #if (CONFIG_MMS_THREADLESS_STACK == 0)
         self->thread = NULL;
+        self->fanoutSize = 1;
+        self->numberOfFanoutShards = 0;
+        self->fanoutShards = NULL;
 #endif
     }
 
@@ -93,13 +112,16 @@ GooseReceiver_create()
 void
 GooseReceiver_addSubscriber(GooseReceiver self, GooseSubscriber subscriber)
 {
+    subscriber->receiver = self;
+
     LinkedList_add(self->subscriberList, (void*) subscriber);
 }
 
 void
 GooseReceiver_removeSubscriber(GooseReceiver self, GooseSubscriber subscriber)
 {
-    LinkedList_remove(self->subscriberList, (void*) subscriber);
+    if (LinkedList_remove(self->subscriberList, (void*) subscriber))
+        subscriber->receiver = NULL;
 }
 
 void
@@ -409,6 +431,116 @@ parseAllData(uint8_t* buffer, int allDataLength, MmsValue* dataSetValues)
     return pe;
 }
 
+/*
+ * Decode allData with the compiled decoder program. Returns false when the message doesn't
+ * match the expected encoding.
+ */
+static bool
+parseAllDataCompiled(GooseDecoderProgram* program, uint8_t* buffer, int allDataLength)
+{
+    int bufPos = 0;
+    int i;
+
+    int containerEnds[GOOSE_DECODER_MAX_NESTING_DEPTH + 1];
+    int depth = 0;
+
+    for (i = 0; i < program->numberOfInstructions; i++) {
+        GooseDecoderInstruction* instruction = &(program->instructions[i]);
+
+        if (instruction->opCode == GOOSE_DECODER_OP_END_CONTAINER) {
+            if ((depth == 0) || (bufPos != containerEnds[--depth]))
+                return false;
+
+            continue;
+        }
+
+        int maxBufPos = (depth > 0) ? containerEnds[depth - 1] : allDataLength;
+
+        if ((bufPos >= maxBufPos) || (buffer[bufPos] != instruction->tag))
+            return false;
+
+        int elementLength;
+
+        bufPos = BerDecoder_decodeLength(buffer, &elementLength, bufPos + 1, maxBufPos);
+
+        if (bufPos < 0)
+            return false;
+
+        if ((instruction->length != -1) && (elementLength != instruction->length))
+            return false;
+
+        MmsValue* value = instruction->value;
+
+        switch (instruction->opCode) {
+
+        case GOOSE_DECODER_OP_BEGIN_CONTAINER:
+            if (depth >= GOOSE_DECODER_MAX_NESTING_DEPTH)
+                return false;
+
+            containerEnds[depth++] = bufPos + elementLength;
+            continue; /* elements follow directly */
+
+        case GOOSE_DECODER_OP_BOOLEAN:
+            value->value.boolean = (buffer[bufPos] != 0);
+            break;
+
+        case GOOSE_DECODER_OP_BIT_STRING:
+            if (buffer[bufPos] != ((8 * (elementLength - 1)) - value->value.bitString.size))
+                return false;
+
+            memcpy(value->value.bitString.buf, buffer + bufPos + 1, elementLength - 1);
+            break;
+
+        case GOOSE_DECODER_OP_INTEGER:
+            if ((elementLength == 0) || (elementLength > value->value.integer->maxSize))
+                return false;
+
+            value->value.integer->size = elementLength;
+            memcpy(value->value.integer->octets, buffer + bufPos, elementLength);
+            break;
+
+        case GOOSE_DECODER_OP_FLOAT32:
+            MmsValue_setFloat(value, BerDecoder_decodeFloat(buffer, bufPos));
+            break;
+
+        case GOOSE_DECODER_OP_FLOAT64:
+            MmsValue_setDouble(value, BerDecoder_decodeDouble(buffer, bufPos));
+            break;
+
+        case GOOSE_DECODER_OP_OCTET_STRING:
+            if (elementLength > abs(value->value.octetString.maxSize))
+                return false;
+
+            value->value.octetString.size = elementLength;
+            memcpy(value->value.octetString.buf, buffer + bufPos, elementLength);
+            break;
+
+        case GOOSE_DECODER_OP_VISIBLE_STRING:
+            if ((value->value.visibleString.buf == NULL) || (value->value.visibleString.size < elementLength))
+                return false;
+
+            memcpy(value->value.visibleString.buf, buffer + bufPos, elementLength);
+            value->value.visibleString.buf[elementLength] = 0;
+            break;
+
+        case GOOSE_DECODER_OP_BINARY_TIME:
+            memcpy(value->value.binaryTime.buf, buffer + bufPos, elementLength);
+            break;
+
+        case GOOSE_DECODER_OP_UTC_TIME:
+            MmsValue_setUtcTimeByBuffer(value, buffer + bufPos);
+            break;
+
+        default:
+            return false;
+        }
+
+        bufPos += elementLength;
+    }
+
+    return (bufPos == allDataLength);
+}
+
 static MmsValue*
 parseAllDataUnknownValue(GooseSubscriber self, uint8_t* buffer, int allDataLength, bool isStructure)
 {
@@ -867,7 +999,16 @@ parseGoosePayload(GooseReceiver self, uint8_t* buffer, int apduLength)
             if (matchingSubscriber->dataSetValues == NULL)
                 matchingSubscriber->dataSetValues = parseAllDataUnknownValue(matchingSubscriber, dataSetBufferAddress, dataSetBufferLength, false);
             else {
-                GooseParseError parseError = parseAllData(dataSetBufferAddress, dataSetBufferLength, matchingSubscriber->dataSetValues);
+                GooseParseError parseError = GOOSE_PARSE_ERROR_NO_ERROR;
+
+                GooseDecoderProgram* program = matchingSubscriber->decoderProgram;
+
+                /* use the compiled decoder when possible - fall back to the generic decoder on mismatch */
+                if ((program == NULL) || (program->dataSetValues != matchingSubscriber->dataSetValues) ||
+                        (parseAllDataCompiled(program, dataSetBufferAddress, dataSetBufferLength) == false))
+                {
+                    parseError = parseAllData(dataSetBufferAddress, dataSetBufferLength, matchingSubscriber->dataSetValues);
+                }
 
                 if (parseError != GOOSE_PARSE_ERROR_NO_ERROR) {
                     isValid = false;
@@ -1006,6 +1147,9 @@ parseGooseMessage(GooseReceiver self, uint8_t* buffer, int numbytes)
     }
 }
 
+static EthernetSocket
+createReceiverSocket(GooseReceiver self);
+
 #if (CONFIG_MMS_THREADLESS_STACK == 0)
 static void*
 gooseReceiverLoop(void *threadParameter)
@@ -1039,7 +1183,172 @@ gooseReceiverLoop(void *threadParameter)
 
     return NULL;
 }
+
+static void*
+gooseReceiverFanoutLoop(void *threadParameter)
+{
+    GooseReceiverFanoutShard* shard = (GooseReceiverFanoutShard*) threadParameter;
+    GooseReceiver self = shard->receiver;
+
+    EthernetHandleSet handleSet = EthernetHandleSet_new();
+    EthernetHandleSet_addSocket(handleSet, shard->ethSocket);
+
+    while (self->running) {
+        switch (EthernetHandleSet_waitReady(handleSet, 100))
+        {
+        case -1:
+            if (DEBUG_GOOSE_SUBSCRIBER)
+                printf("GOOSE_SUBSCRIBER: EhtnernetHandleSet_waitReady() failure\n");
+            break;
+        case 0:
+            break;
+        default:
+            {
+                int packetSize = Ethernet_receivePacket(shard->ethSocket, shard->buffer, ETH_BUFFER_LENGTH);
+
+                if (packetSize > 0)
+                    parseGooseMessage(self, shard->buffer, packetSize);
+            }
+        }
+        if (self->stop)
+            break;
+    }
+
+    EthernetHandleSet_destroy(handleSet);
+
+    return NULL;
+}
+
+static bool
+hasObserver(GooseReceiver self)
+{
+    LinkedList element = LinkedList_getNext(self->subscriberList);
+
+    while (element != NULL) {
+        GooseSubscriber subscriber = (GooseSubscriber) LinkedList_getData(element);
+
+        if (subscriber->isObserver)
+            return true;
+
+        element = LinkedList_getNext(element);
+    }
+
+    return false;
+}
+
+static bool
+startFanoutShard(GooseReceiver self, GooseReceiverFanoutShard* shard, int groupId)
+{
+    shard->receiver = self;
+    shard->ethSocket = createReceiverSocket(self);
+
+    if (shard->ethSocket == NULL)
+        return false;
+
+    if (Ethernet_joinFanoutGroup(shard->ethSocket, groupId) == -1)
+        goto exit_with_error;
+
+    shard->buffer = (uint8_t*) GLOBAL_MALLOC(ETH_BUFFER_LENGTH);
+
+    if (shard->buffer == NULL)
+        goto exit_with_error;
+
+    shard->thread = Thread_create((ThreadExecutionFunction) gooseReceiverFanoutLoop, (void*) shard, false);
+
+    if (shard->thread == NULL) {
+        GLOBAL_FREEMEM(shard->buffer);
+        goto exit_with_error;
+    }
+
+    return true;
+
+exit_with_error:
+    Ethernet_destroySocket(shard->ethSocket);
+    shard->ethSocket = NULL;
+
+    return false;
+}
+
+static void
+startFanoutShards(GooseReceiver self)
+{
+    /* observer subscribers are updated by the receiving thread and cannot be shared */
+    if (hasObserver(self)) {
+        if (DEBUG_GOOSE_SUBSCRIBER)
+            printf("GOOSE_SUBSCRIBER: Socket fanout not possible with observer -> use single socket\n");
+
+        return;
+    }
+
+    int groupId = Ethernet_joinFanoutGroup(self->ethSocket, -1);
+
+    if (groupId == -1) {
+        if (DEBUG_GOOSE_SUBSCRIBER)
+            printf("GOOSE_SUBSCRIBER: Socket fanout not supported -> use single socket\n");
+
+        return;
+    }
+
+    self->fanoutShards = (GooseReceiverFanoutShard*) GLOBAL_CALLOC(self->fanoutSize - 1, sizeof(GooseReceiverFanoutShard));
+
+    if (self->fanoutShards == NULL)
+        return;
+
+    while (self->numberOfFanoutShards < self->fanoutSize - 1) {
+        if (startFanoutShard(self, &(self->fanoutShards[self->numberOfFanoutShards]), groupId) == false) {
+            if (DEBUG_GOOSE_SUBSCRIBER)
+                printf("GOOSE_SUBSCRIBER: Failed to create fanout socket -> use %i sockets\n", self->numberOfFanoutShards + 1);
+
+            break;
+        }
+
+        self->numberOfFanoutShards++;
+    }
+}
+
+static void
+stopFanoutShards(GooseReceiver self)
+{
+    int i;
+
+    for (i = 0; i < self->numberOfFanoutShards; i++) {
+        GooseReceiverFanoutShard* shard = &(self->fanoutShards[i]);
+
+        Thread_destroy(shard->thread);
+
+        Ethernet_destroySocket(shard->ethSocket);
+        GLOBAL_FREEMEM(shard->buffer);
+    }
+
+    if (self->fanoutShards) {
+        GLOBAL_FREEMEM(self->fanoutShards);
+        self->fanoutShards = NULL;
+    }
+
+    self->numberOfFanoutShards = 0;
+}
+#endif
+
+void
+GooseReceiver_enableFanout(GooseReceiver self, int numberOfSockets)
+{
+#if (CONFIG_MMS_THREADLESS_STACK == 0)
+    if (numberOfSockets < 1)
+        numberOfSockets = 1;
+
+    self->fanoutSize = numberOfSockets;
+#endif
+}
+
+int
+GooseReceiver_getFanoutSize(GooseReceiver self)
+{
+#if (CONFIG_MMS_THREADLESS_STACK == 0)
+    return self->numberOfFanoutShards + 1;
+#else
+    return 1;
 #endif
+}
 
 /* start GOOSE receiver in a separate thread */
 void
@@ -1053,6 +1362,15 @@ GooseReceiver_start(GooseReceiver self)
             if (DEBUG_GOOSE_SUBSCRIBER)
                 printf("GOOSE_SUBSCRIBER: GOOSE receiver started for interface %s\n", self->interfaceId);
 
+            if (self->fanoutSize > 1) {
+                int i;
+
+                startFanoutShards(self);
+
+                for (i = 0; i < self->numberOfFanoutShards; i++)
+                    Thread_start(self->fanoutShards[i].thread);
+            }
+
             Thread_start(self->thread);
         }
         else {
@@ -1079,6 +1397,8 @@ GooseReceiver_stop(GooseReceiver self)
     if (self->thread)
         Thread_destroy(self->thread);
 
+    stopFanoutShards(self);
+
     self->stop = false;
 #endif
 }
@@ -1106,19 +1426,21 @@ GooseReceiver_destroy(GooseReceiver self)
 /***************************************
  * Functions for non-threaded operation
  ***************************************/
-EthernetSocket
-GooseReceiver_startThreadless(GooseReceiver self)
+static EthernetSocket
+createReceiverSocket(GooseReceiver self)
 {
+    EthernetSocket ethSocket;
+
     if (self->interfaceId == NULL)
-        self->ethSocket = Ethernet_createSocket(CONFIG_ETHERNET_INTERFACE_ID, NULL);
+        ethSocket = Ethernet_createSocket(CONFIG_ETHERNET_INTERFACE_ID, NULL);
     else
-        self->ethSocket = Ethernet_createSocket(self->interfaceId, NULL);
+        ethSocket = Ethernet_createSocket(self->interfaceId, NULL);
 
-    if (self->ethSocket != NULL) {
-        Ethernet_setProtocolFilter(self->ethSocket, ETH_P_GOOSE);
+    if (ethSocket != NULL) {
+        Ethernet_setProtocolFilter(ethSocket, ETH_P_GOOSE);
 
         /* set multicast addresses for subscribers */
-        Ethernet_setMode(self->ethSocket, ETHERNET_SOCKET_MODE_MULTICAST);
+        Ethernet_setMode(ethSocket, ETHERNET_SOCKET_MODE_MULTICAST);
 
         LinkedList element = LinkedList_getNext(self->subscriberList);
 
@@ -1127,17 +1449,26 @@ GooseReceiver_startThreadless(GooseReceiver self)
 
             if (subscriber->dstMacSet == false) {
                 /* no destination MAC address defined -> we have to switch to all multicast mode */
-                Ethernet_setMode(self->ethSocket, ETHERNET_SOCKET_MODE_ALL_MULTICAST);
+                Ethernet_setMode(ethSocket, ETHERNET_SOCKET_MODE_ALL_MULTICAST);
             }
             else {
-                Ethernet_addMulticastAddress(self->ethSocket, subscriber->dstMac);
+                Ethernet_addMulticastAddress(ethSocket, subscriber->dstMac);
             }
 
             element = LinkedList_getNext(element);
         }
+    }
+
+    return ethSocket;
+}
 
+EthernetSocket
+GooseReceiver_startThreadless(GooseReceiver self)
+{
+    self->ethSocket = createReceiverSocket(self);
+
+    if (self->ethSocket != NULL)
         self->running = true;
-    }
     else
         self->running = false;
 
@@ -107,6 +107,35 @@ GooseReceiver_addSubscriber(GooseReceiver self, GooseSubscriber subscriber);
 LIB61850_API void
 GooseReceiver_removeSubscriber(GooseReceiver self, GooseSubscriber subscriber);
 
+/**
+ * \brief Distribute the reception of GOOSE messages over multiple sockets and threads
+ *
+ * When enabled \ref GooseReceiver_start opens the given number of sockets on the interface and
+ * joins them to a fanout group. Each socket is served by its own thread. Messages are distributed
+ * by APPID so all messages with the same APPID are handled by the same thread. Listeners of
+ * subscribers with different APPIDs can be called in parallel.
+ *
+ * When the platform doesn't support socket fanout, or an observer subscriber is added to the
+ * receiver, only a single socket is used.
+ *
+ * NOTE: This function has to be called before calling GooseReceiver_start.
+ *
+ * \param self the GooseReceiver instance
+ * \param numberOfSockets the number of sockets/receive threads (1 disables fanout)
+ */
+LIB61850_API void
+GooseReceiver_enableFanout(GooseReceiver self, int numberOfSockets);
+
+/**
+ * \brief Get the number of sockets/threads actually used by a running receiver
+ *
+ * \param self the GooseReceiver instance
+ *
+ * \return the number of receive sockets (1 when fanout is disabled or not supported)
+ */
+LIB61850_API int
+GooseReceiver_getFanoutSize(GooseReceiver self);
+
 /**
  * \brief start the GOOSE receiver in a separate thread
  *
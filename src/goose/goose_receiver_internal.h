@@ -34,6 +34,42 @@
 #endif
 
 
+/*
+ * Decoder program compiled from the data set template of a subscriber. Each
+ * instruction expects a single BER element of the allData field in encoding order.
+ */
+typedef enum {
+    GOOSE_DECODER_OP_BEGIN_CONTAINER, /* array or structure - followed by the instructions for the elements */
+    GOOSE_DECODER_OP_END_CONTAINER,
+    GOOSE_DECODER_OP_BOOLEAN,
+    GOOSE_DECODER_OP_BIT_STRING,
+    GOOSE_DECODER_OP_INTEGER, /* signed and unsigned integers */
+    GOOSE_DECODER_OP_FLOAT32,
+    GOOSE_DECODER_OP_FLOAT64,
+    GOOSE_DECODER_OP_OCTET_STRING,
+    GOOSE_DECODER_OP_VISIBLE_STRING,
+    GOOSE_DECODER_OP_BINARY_TIME,
+    GOOSE_DECODER_OP_UTC_TIME
+} GooseDecoderOpCode;
+
+#define GOOSE_DECODER_MAX_NESTING_DEPTH 16
+
+typedef struct {
+    uint8_t opCode;
+    uint8_t tag; /* expected BER tag */
+    int16_t length; /* expected element length or -1 when the length is variable */
+    MmsValue* value; /* target value (NULL for container instructions) */
+} GooseDecoderInstruction;
+
+typedef struct {
+    MmsValue* dataSetValues; /* template the program has been compiled for */
+    int numberOfInstructions;
+    GooseDecoderInstruction instructions[1];
+} GooseDecoderProgram;
+
+LIB61850_INTERNAL GooseDecoderProgram*
+GooseDecoderProgram_create(MmsValue* dataSetValues);
+
 struct sGooseSubscriber {
     char goCBRef[130];
     char datSet[130];
@@ -65,6 +101,10 @@ struct sGooseSubscriber {
 
     GooseListener listener;
     void* listenerParameter;
+
+    GooseDecoderProgram* decoderProgram; /* optional compiled allData decoder */
+
+    GooseReceiver receiver; /* receiver the subscriber is added to or NULL */
 };
 
 
@@ -25,6 +25,7 @@
 
 #include "stack_config.h"
 #include "goose_subscriber.h"
+#include "goose_receiver.h"
 #include "hal_ethernet.h"
 #include "hal_thread.h"
 
@@ -63,6 +64,175 @@ GooseSubscriber_create(char* goCbRef, MmsValue* dataSetValues)
     return self;
 }
 
+static int
+countDecoderInstructions(MmsValue* value, int depth)
+{
+    if (depth > GOOSE_DECODER_MAX_NESTING_DEPTH)
+        return -1;
+
+    switch (MmsValue_getType(value)) {
+    case MMS_ARRAY:
+    case MMS_STRUCTURE:
+        {
+            int count = 2;
+            int i;
+            int size = MmsValue_getArraySize(value);
+
+            for (i = 0; i < size; i++) {
+                MmsValue* element = MmsValue_getElement(value, i);
+
+                if (element == NULL)
+                    return -1;
+
+                int elementCount = countDecoderInstructions(element, depth + 1);
+
+                if (elementCount < 0)
+                    return -1;
+
+                count += elementCount;
+            }
+
+            return count;
+        }
+
+    case MMS_BOOLEAN:
+    case MMS_BIT_STRING:
+    case MMS_INTEGER:
+    case MMS_UNSIGNED:
+    case MMS_FLOAT:
+    case MMS_OCTET_STRING:
+    case MMS_VISIBLE_STRING:
+    case MMS_BINARY_TIME:
+    case MMS_UTC_TIME:
+        return 1;
+
+    default:
+        return -1;
+    }
+}
+
+static void
+addDecoderInstruction(GooseDecoderProgram* program, GooseDecoderOpCode opCode, uint8_t tag, int length, MmsValue* value)
+{
+    GooseDecoderInstruction* instruction = &(program->instructions[program->numberOfInstructions++]);
+
+    instruction->opCode = (uint8_t) opCode;
+    instruction->tag = tag;
+    instruction->length = (int16_t) length;
+    instruction->value = value;
+}
+
+static void
+compileValue(GooseDecoderProgram* program, MmsValue* value, bool topLevel)
+{
+    switch (MmsValue_getType(value)) {
+    case MMS_ARRAY:
+    case MMS_STRUCTURE:
+        {
+            int i;
+            int size = MmsValue_getArraySize(value);
+
+            /* the top level data set values are not enclosed by a container element */
+            if (topLevel == false)
+                addDecoderInstruction(program, GOOSE_DECODER_OP_BEGIN_CONTAINER,
+                        (MmsValue_getType(value) == MMS_ARRAY) ? 0xa1 : 0xa2, -1, NULL);
+
+            for (i = 0; i < size; i++)
+                compileValue(program, MmsValue_getElement(value, i), false);
+
+            if (topLevel == false)
+                addDecoderInstruction(program, GOOSE_DECODER_OP_END_CONTAINER, 0, -1, NULL);
+        }
+        break;
+
+    case MMS_BOOLEAN:
+        addDecoderInstruction(program, GOOSE_DECODER_OP_BOOLEAN, 0x83, 1, value);
+        break;
+
+    case MMS_BIT_STRING:
+        addDecoderInstruction(program, GOOSE_DECODER_OP_BIT_STRING, 0x84,
+                1 + ((value->value.bitString.size + 7) / 8), value);
+        break;
+
+    case MMS_INTEGER:
+        addDecoderInstruction(program, GOOSE_DECODER_OP_INTEGER, 0x85, -1, value);
+        break;
+
+    case MMS_UNSIGNED:
+        addDecoderInstruction(program, GOOSE_DECODER_OP_INTEGER, 0x86, -1, value);
+        break;
+
+    case MMS_FLOAT:
+        if (value->value.floatingPoint.formatWidth == 64)
+            addDecoderInstruction(program, GOOSE_DECODER_OP_FLOAT64, 0x87, 9, value);
+        else
+            addDecoderInstruction(program, GOOSE_DECODER_OP_FLOAT32, 0x87, 5, value);
+        break;
+
+    case MMS_OCTET_STRING:
+        addDecoderInstruction(program, GOOSE_DECODER_OP_OCTET_STRING, 0x89, -1, value);
+        break;
+
+    case MMS_VISIBLE_STRING:
+        addDecoderInstruction(program, GOOSE_DECODER_OP_VISIBLE_STRING, 0x8a, -1, value);
+        break;
+
+    case MMS_BINARY_TIME:
+        addDecoderInstruction(program, GOOSE_DECODER_OP_BINARY_TIME, 0x8c, value->value.binaryTime.size, value);
+        break;
+
+    case MMS_UTC_TIME:
+        addDecoderInstruction(program, GOOSE_DECODER_OP_UTC_TIME, 0x91, 8, value);
+        break;
+
+    default:
+        break;
+    }
+}
+
+GooseDecoderProgram*
+GooseDecoderProgram_create(MmsValue* dataSetValues)
+{
+    if ((dataSetValues == NULL) || (MmsValue_getType(dataSetValues) != MMS_ARRAY))
+        return NULL;
+
+    int numberOfInstructions = countDecoderInstructions(dataSetValues, 0);
+
+    if (numberOfInstructions < 0)
+        return NULL;
+
+    GooseDecoderProgram* program = (GooseDecoderProgram*) GLOBAL_CALLOC(1,
+            sizeof(GooseDecoderProgram) + (numberOfInstructions * sizeof(GooseDecoderInstruction)));
+
+    if (program) {
+        program->dataSetValues = dataSetValues;
+
+        compileValue(program, dataSetValues, true);
+    }
+
+    return program;
+}
+
+bool
+GooseSubscriber_compileDecoder(GooseSubscriber self)
+{
+    /* the receiver thread uses the program without synchronization */
+    if (self->receiver && GooseReceiver_isRunning(self->receiver))
+        return false;
+
+    if (self->decoderProgram) {
+        GLOBAL_FREEMEM(self->decoderProgram);
+        self->decoderProgram = NULL;
+    }
+
+    if (self->isObserver)
+        return false;
+
+    self->decoderProgram = GooseDecoderProgram_create(self->dataSetValues);
+
+    return (self->decoderProgram != NULL);
+}
+
 bool
 GooseSubscriber_isValid(GooseSubscriber self)
 {
@@ -103,6 +273,9 @@ GooseSubscriber_destroy(GooseSubscriber self)
         if (self->dataSetValuesSelfAllocated)
             MmsValue_delete(self->dataSetValues);
 
+        if (self->decoderProgram)
+            GLOBAL_FREEMEM(self->decoderProgram);
+
         GLOBAL_FREEMEM(self);
     }
 }
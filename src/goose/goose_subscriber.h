@@ -308,6 +308,26 @@ GooseSubscriber_getVlanPrio(GooseSubscriber self);
  */
 LIB61850_API void
 GooseSubscriber_setObserver(GooseSubscriber self);
+
+/**
+ * \brief Create a compiled decoder for the data set values of the subscriber
+ *
+ * The decoder is created from the data set template (the MmsValue given to \ref GooseSubscriber_create).
+ * Received messages are checked against the expected encoding (tags, number of elements and fixed element
+ * lengths) in a single pass and the values are written directly into the data set values without
+ * generic tag dispatching. When a message does not match the template the generic decoder is used.
+ *
+ * NOTE: Call this function again when the data set values have been replaced. The decoder can only be
+ * compiled while the GooseReceiver the subscriber is added to is stopped.
+ *
+ * \param self GooseSubscriber instance to operate on.
+ *
+ * \return true if the decoder has been created, false if the data set template is not supported or the
+ *         receiver is running
+ */
+LIB61850_API bool
+GooseSubscriber_compileDecoder(GooseSubscriber self);
+
 #ifdef __cplusplus
 }
 #endif
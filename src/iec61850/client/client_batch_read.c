@@ -0,0 +1,470 @@
+/*
+ *  client_batch_read.c
+ *
+ *  Reading of multiple FCDs/FCDAs with pipelined multi-variable MMS read requests
+ *
+ *  This file is part of libIEC61850.
+ *
+ *  libIEC61850 is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  libIEC61850 is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with libIEC61850.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+#include "stack_config.h"
+#include "libiec61850_platform_includes.h"
+
+#include "iec61850_client.h"
+
+#include "mms_client_connection.h"
+
+#include "ied_connection_private.h"
+#include "mms_value_internal.h"
+
+/* encoding overhead of the read request PDU and of a single variable specification */
+#define READ_REQUEST_OVERHEAD 32
+#define VARIABLE_SPEC_OVERHEAD 12
+
+typedef struct sBatchRead* BatchRead;
+
+typedef struct {
+    BatchRead batch;
+    const char* domainId;
+    int first; /* first position in the request order */
+    int count;
+} BatchReadRequest;
+
+struct sBatchRead {
+    IedConnection connection;
+
+    Semaphore lock;
+
+    int numberOfObjects;
+    MmsValue** values;
+    IedClientError error;
+
+    char** domainIds;
+    char** itemIds;
+    int* requestOrder; /* object indices grouped by domain */
+
+    /* pool of requests - splitting can create at most 2 * numberOfObjects requests */
+    BatchReadRequest* requests;
+    int numberOfRequests;
+
+    /* queue of requests waiting to be sent */
+    BatchReadRequest** queue;
+    int queueSize;
+    int queueHead;
+    int queueLength;
+
+    int pending; /* requests in flight + active callers */
+    bool finished;
+
+    IedConnection_ReadObjectsHandler handler;
+    void* handlerParameter;
+
+    Semaphore done; /* used by synchronous read */
+};
+
+static void
+BatchRead_destroy(BatchRead self)
+{
+    int i;
+
+    for (i = 0; i < self->numberOfObjects; i++) {
+        if (self->domainIds[i])
+            GLOBAL_FREEMEM(self->domainIds[i]);
+
+        if (self->itemIds[i])
+            GLOBAL_FREEMEM(self->itemIds[i]);
+    }
+
+    GLOBAL_FREEMEM(self->domainIds);
+    GLOBAL_FREEMEM(self->itemIds);
+    GLOBAL_FREEMEM(self->requestOrder);
+    GLOBAL_FREEMEM(self->requests);
+    GLOBAL_FREEMEM(self->queue);
+
+    Semaphore_destroy(self->lock);
+
+    if (self->done)
+        Semaphore_destroy(self->done);
+
+    GLOBAL_FREEMEM(self);
+}
+
+static void
+setError(BatchRead self, IedClientError error)
+{
+    if (self->error == IED_ERROR_OK)
+        self->error = error;
+}
+
+/* has to be called with lock */
+static void
+enqueueRequest(BatchRead self, BatchReadRequest* request, bool atFront)
+{
+    if (atFront) {
+        self->queueHead = (self->queueHead + self->queueSize - 1) % self->queueSize;
+        self->queue[self->queueHead] = request;
+    }
+    else {
+        self->queue[(self->queueHead + self->queueLength) % self->queueSize] = request;
+    }
+
+    self->queueLength++;
+}
+
+/* has to be called with lock */
+static BatchReadRequest*
+dequeueRequest(BatchRead self)
+{
+    if (self->queueLength == 0)
+        return NULL;
+
+    BatchReadRequest* request = self->queue[self->queueHead];
+
+    self->queueHead = (self->queueHead + 1) % self->queueSize;
+    self->queueLength--;
+
+    return request;
+}
+
+/* has to be called with lock */
+static BatchReadRequest*
+addRequest(BatchRead self, const char* domainId, int first, int count)
+{
+    BatchReadRequest* request = &(self->requests[self->numberOfRequests++]);
+
+    request->batch = self;
+    request->domainId = domainId;
+    request->first = first;
+    request->count = count;
+
+    enqueueRequest(self, request, false);
+
+    return request;
+}
+
+static void
+finishBatchRead(BatchRead self)
+{
+    if (self->handler) {
+        self->handler(self->handlerParameter, self->error, self->values, self->numberOfObjects);
+
+        GLOBAL_FREEMEM(self->values);
+        BatchRead_destroy(self);
+    }
+    else {
+        /* unblock the waiting user thread */
+        Semaphore_post(self->done);
+    }
+}
+
+static void
+readMultipleVariablesHandler(uint32_t invokeId, void* parameter, MmsError mmsError, MmsValue* value);
+
+static bool
+sendRequest(BatchRead self, BatchReadRequest* request, MmsError* mmsError)
+{
+    LinkedList items = LinkedList_create();
+
+    int i;
+
+    for (i = 0; i < request->count; i++)
+        LinkedList_add(items, self->itemIds[self->requestOrder[request->first + i]]);
+
+    MmsConnection_readMultipleVariablesAsync(self->connection->connection, NULL, mmsError, request->domainId,
+            items, readMultipleVariablesHandler, request);
+
+    LinkedList_destroyStatic(items);
+
+    return (*mmsError == MMS_ERROR_NONE);
+}
+
+/*
+ * Send queued requests until the queue is empty or the request window is exhausted.
+ *
+ * The caller holds one reference (pending) that is released here. The batch read is finished by
+ * the caller that releases the last reference - no other thread accesses the instance afterwards.
+ */
+static void
+sendQueuedRequests(BatchRead self)
+{
+    bool finished = false;
+
+    Semaphore_wait(self->lock);
+
+    self->pending--;
+
+    while (true) {
+        BatchReadRequest* request = dequeueRequest(self);
+
+        if (request == NULL)
+            break;
+
+        self->pending++;
+
+        Semaphore_post(self->lock);
+
+        MmsError mmsError = MMS_ERROR_NONE;
+
+        bool sent = sendRequest(self, request, &mmsError);
+
+        Semaphore_wait(self->lock);
+
+        if (sent == false) {
+            self->pending--;
+
+            if ((mmsError == MMS_ERROR_OUTSTANDING_CALL_LIMIT) && (self->pending > 0)) {
+                /* retry when the next response has been received */
+                enqueueRequest(self, request, true);
+                break;
+            }
+
+            setError(self, iedConnection_mapMmsErrorToIedError(mmsError));
+        }
+    }
+
+    if ((self->pending == 0) && (self->queueLength == 0) && (self->finished == false)) {
+        self->finished = true;
+        finished = true;
+    }
+
+    Semaphore_post(self->lock);
+
+    if (finished)
+        finishBatchRead(self);
+}
+
+static void
+readMultipleVariablesHandler(uint32_t invokeId, void* parameter, MmsError mmsError, MmsValue* value)
+{
+    (void)invokeId;
+
+    BatchReadRequest* request = (BatchReadRequest*) parameter;
+    BatchRead self = request->batch;
+
+    Semaphore_wait(self->lock);
+
+    if ((mmsError == MMS_ERROR_NONE) && value) {
+
+        if ((MmsValue_getType(value) == MMS_ARRAY) && (MmsValue_getArraySize(value) == (uint32_t) request->count)) {
+            int i;
+
+            for (i = 0; i < request->count; i++) {
+                self->values[self->requestOrder[request->first + i]] = MmsValue_getElement(value, i);
+                MmsValue_setElement(value, i, NULL);
+            }
+        }
+        else
+            setError(self, IED_ERROR_MALFORMED_MESSAGE);
+    }
+    else {
+        if ((request->count > 1) && (mmsError != MMS_ERROR_SERVICE_TIMEOUT) && (mmsError != MMS_ERROR_CONNECTION_LOST)) {
+            /* the response probably doesn't fit in a single PDU -> split the request */
+            int firstHalf = request->count / 2;
+
+            addRequest(self, request->domainId, request->first + firstHalf, request->count - firstHalf);
+
+            request->count = firstHalf;
+            enqueueRequest(self, request, false);
+        }
+        else
+            setError(self, iedConnection_mapMmsErrorToIedError(mmsError));
+    }
+
+    Semaphore_post(self->lock);
+
+    if (value)
+        MmsValue_delete(value);
+
+    sendQueuedRequests(self);
+}
+
+static BatchRead
+BatchRead_create(IedConnection connection, IedClientError* error, int numberOfObjects, const char** objectReferences,
+        const FunctionalConstraint* fcs, MmsValue** values)
+{
+    BatchRead self = (BatchRead) GLOBAL_CALLOC(1, sizeof(struct sBatchRead));
+
+    if (self == NULL) {
+        *error = IED_ERROR_UNKNOWN;
+        return NULL;
+    }
+
+    self->connection = connection;
+    self->numberOfObjects = numberOfObjects;
+    self->values = values;
+    self->error = IED_ERROR_OK;
+    self->lock = Semaphore_create(1);
+
+    self->domainIds = (char**) GLOBAL_CALLOC(numberOfObjects, sizeof(char*));
+    self->itemIds = (char**) GLOBAL_CALLOC(numberOfObjects, sizeof(char*));
+    self->requestOrder = (int*) GLOBAL_CALLOC(numberOfObjects, sizeof(int));
+    self->requests = (BatchReadRequest*) GLOBAL_CALLOC(2 * numberOfObjects, sizeof(BatchReadRequest));
+    self->queueSize = 2 * numberOfObjects;
+    self->queue = (BatchReadRequest**) GLOBAL_CALLOC(self->queueSize, sizeof(BatchReadRequest*));
+
+    if ((self->domainIds == NULL) || (self->itemIds == NULL) || (self->requestOrder == NULL) ||
+            (self->requests == NULL) || (self->queue == NULL))
+    {
+        *error = IED_ERROR_UNKNOWN;
+        BatchRead_destroy(self);
+        return NULL;
+    }
+
+    int i;
+
+    for (i = 0; i < numberOfObjects; i++) {
+        char domainIdBuffer[65];
+        char itemIdBuffer[65];
+
+        values[i] = NULL;
+
+        char* domainId = MmsMapping_getMmsDomainFromObjectReference(objectReferences[i], domainIdBuffer);
+        char* itemId = MmsMapping_createMmsVariableNameFromObjectReference(objectReferences[i], fcs[i], itemIdBuffer);
+
+        /* array element access is not supported by multi-variable read requests */
+        if ((domainId == NULL) || (itemId == NULL) || strchr(itemId, '(')) {
+            *error = IED_ERROR_OBJECT_REFERENCE_INVALID;
+            BatchRead_destroy(self);
+            return NULL;
+        }
+
+        self->domainIds[i] = StringUtils_copyString(domainId);
+        self->itemIds[i] = StringUtils_copyString(itemId);
+    }
+
+    /* group the objects by domain (preserving the order) and split in requests that fit into the PDU size */
+    int maxRequestSize = MmsConnection_getMmsConnectionParameters(connection->connection).maxPduSize - READ_REQUEST_OVERHEAD;
+
+    bool* assigned = (bool*) GLOBAL_CALLOC(numberOfObjects, sizeof(bool));
+
+    if (assigned == NULL) {
+        *error = IED_ERROR_UNKNOWN;
+        BatchRead_destroy(self);
+        return NULL;
+    }
+
+    int position = 0;
+
+    for (i = 0; i < numberOfObjects; i++) {
+        if (assigned[i])
+            continue;
+
+        const char* domainId = self->domainIds[i];
+
+        int requestStart = position;
+        int requestSize = 0;
+
+        int j;
+
+        for (j = i; j < numberOfObjects; j++) {
+            if (assigned[j] || strcmp(self->domainIds[j], domainId))
+                continue;
+
+            int itemSize = VARIABLE_SPEC_OVERHEAD + strlen(domainId) + strlen(self->itemIds[j]);
+
+            if ((position > requestStart) && (requestSize + itemSize > maxRequestSize)) {
+                addRequest(self, domainId, requestStart, position - requestStart);
+
+                requestStart = position;
+                requestSize = 0;
+            }
+
+            self->requestOrder[position++] = j;
+            requestSize += itemSize;
+            assigned[j] = true;
+        }
+
+        addRequest(self, domainId, requestStart, position - requestStart);
+    }
+
+    GLOBAL_FREEMEM(assigned);
+
+    *error = IED_ERROR_OK;
+
+    return self;
+}
+
+void
+IedConnection_readObjects(IedConnection self, IedClientError* error, int numberOfObjects,
+        const char** objectReferences, const FunctionalConstraint* fcs, MmsValue** values)
+{
+    if (numberOfObjects < 1) {
+        *error = IED_ERROR_USER_PROVIDED_INVALID_ARGUMENT;
+        return;
+    }
+
+    if (IedConnection_getState(self) != IED_STATE_CONNECTED) {
+        *error = IED_ERROR_NOT_CONNECTED;
+        return;
+    }
+
+    BatchRead batch = BatchRead_create(self, error, numberOfObjects, objectReferences, fcs, values);
+
+    if (batch == NULL)
+        return;
+
+    batch->done = Semaphore_create(1);
+    Semaphore_wait(batch->done);
+
+    batch->pending = 1;
+
+    sendQueuedRequests(batch);
+
+    Semaphore_wait(batch->done);
+
+    *error = batch->error;
+
+    BatchRead_destroy(batch);
+}
+
+void
+IedConnection_readObjectsAsync(IedConnection self, IedClientError* error, int numberOfObjects,
+        const char** objectReferences, const FunctionalConstraint* fcs,
+        IedConnection_ReadObjectsHandler handler, void* parameter)
+{
+    if ((numberOfObjects < 1) || (handler == NULL)) {
+        *error = IED_ERROR_USER_PROVIDED_INVALID_ARGUMENT;
+        return;
+    }
+
+    if (IedConnection_getState(self) != IED_STATE_CONNECTED) {
+        *error = IED_ERROR_NOT_CONNECTED;
+        return;
+    }
+
+    MmsValue** values = (MmsValue**) GLOBAL_CALLOC(numberOfObjects, sizeof(MmsValue*));
+
+    if (values == NULL) {
+        *error = IED_ERROR_UNKNOWN;
+        return;
+    }
+
+    BatchRead batch = BatchRead_create(self, error, numberOfObjects, objectReferences, fcs, values);
+
+    if (batch == NULL) {
+        GLOBAL_FREEMEM(values);
+        return;
+    }
+
+    batch->handler = handler;
+    batch->handlerParameter = parameter;
+
+    /* hold a reference while sending so that the batch cannot be finished by the receiving thread */
+    batch->pending = 1;
+
+    sendQueuedRequests(batch);
+}
@@ -28,6 +28,7 @@
 #include "iec61850_client.h"
 #include "mms_client_connection.h"
 #include "ied_connection_private.h"
+#include "hal_time.h"
 
 #if _MSC_VER
 #define snprintf _snprintf
@@ -37,6 +38,9 @@
 #define DEBUG_IED_CLIENT 0
 #endif
 
+/* maximum number of Oper requests combined in a single write request */
+#define CONTROL_BATCH_MAX_ITEMS_PER_WRITE 100
+
 struct sControlObjectClient
 {
     ControlModel ctlModel;
@@ -56,6 +60,7 @@ struct sControlObjectClient
     uint64_t constantT; /* timestamp of select/operate to be used when constant T option is selected */
 
     LastApplError lastApplError;
+    bool lastApplErrorReceived; /* LastApplError received since the last command */
     MmsError lastMmsError;
     MmsDataAccessError lastAccessError; /* last error of read or write command */
 
@@ -68,8 +73,19 @@ struct sControlObjectClient
     uint8_t ctlNum;
     char* orIdent;
     int orCat;
+
+    /* batch the control object is part of (protected by the clientControlsLock of the connection) */
+    ControlObjectClientBatch batch;
+    int batchIndex;
 };
 
+static void
+controlObjectClientBatch_removeControl(ControlObjectClientBatch self, int index);
+
+static void
+controlObjectClientBatch_handleCommandTermination(ControlObjectClientBatch self, int index, LastApplError lastApplError,
+        bool lastApplErrorReceived);
+
 static void
 convertToMmsAndInsertFC(char* newItemId, const char* originalObjectName, const char* fc)
 {
@@ -109,6 +125,7 @@ resetLastApplError(ControlObjectClient self)
     self->lastApplError.error = CONTROL_ERROR_NO_ERROR;
     self->lastApplError.addCause = ADD_CAUSE_UNKNOWN;
     self->lastApplError.ctlNum = 0;
+    self->lastApplErrorReceived = false;
 }
 
 ControlObjectClient
@@ -258,6 +275,9 @@ ControlObjectClient_destroy(ControlObjectClient self)
 
         iedConnection_removeControlClient(self->connection, self);
 
+        if (self->batch)
+            controlObjectClientBatch_removeControl(self->batch, self->batchIndex);
+
         if (self->ctlVal != NULL)
             MmsValue_delete(self->ctlVal);
 
@@ -1289,6 +1309,7 @@ void
 ControlObjectClient_setLastApplError(ControlObjectClient self, LastApplError lastApplError)
 {
     self->lastApplError = lastApplError;
+    self->lastApplErrorReceived = true;
 }
 
 LastApplError
@@ -1306,6 +1327,770 @@ ControlObjectClient_setCtlNum(ControlObjectClient self, uint8_t ctlNum)
 void
 controlObjectClient_invokeCommandTerminationHandler(ControlObjectClient self)
 {
+    if (self->batch)
+        controlObjectClientBatch_handleCommandTermination(self->batch, self->batchIndex, self->lastApplError,
+                self->lastApplErrorReceived);
+
     if (self->commandTerminationHandler != NULL)
         self->commandTerminationHandler(self->commandTerminaionHandlerParameter, self);
 }
+
+/*************************************
+ * Batch operation of control objects
+ *************************************/
+
+typedef enum
+{
+    BATCH_ENTRY_PENDING,
+    BATCH_ENTRY_SENT,
+    BATCH_ENTRY_DONE
+} BatchEntryState;
+
+typedef struct
+{
+    ControlObjectClientBatch batch;
+    ControlObjectClient control;
+    MmsValue* ctlVal;
+    uint64_t operTime;
+
+    char domainId[65];
+    char itemId[65];
+
+    BatchEntryState state;
+    uint64_t sendTimeInNs;
+
+    ControlObjectClientBatchResult result;
+} ControlBatchEntry;
+
+/* parameter of a write request with multiple variables */
+typedef struct
+{
+    ControlObjectClientBatch batch;
+    int numberOfEntries;
+    int entries[CONTROL_BATCH_MAX_ITEMS_PER_WRITE];
+} ControlBatchWriteRequest;
+
+struct sControlObjectClientBatch
+{
+    IedConnection connection;
+    bool useMultipleWrite;
+
+    ControlBatchEntry* entries;
+    int numberOfEntries;
+    int maxEntries;
+
+    Semaphore lock; /* protects the entries and the fields below */
+    Semaphore progress; /* signaled by a response or the last CommandTermination when the user thread waits */
+    bool userWaits;
+
+    int outstanding;
+    int pendingTerminations;
+    bool multipleWriteRejected;
+    bool resendRejected; /* entries of a rejected request have to be sent again */
+    MmsError err;
+
+    int numberOfRequests;
+    uint32_t operateTimeInUs;
+    uint32_t totalTimeInUs;
+};
+
+ControlObjectClientBatch
+ControlObjectClientBatch_create(IedConnection connection)
+{
+    ControlObjectClientBatch self = (ControlObjectClientBatch) GLOBAL_CALLOC(1, sizeof(struct sControlObjectClientBatch));
+
+    if (self) {
+        self->connection = connection;
+        self->useMultipleWrite = false;
+        self->lock = Semaphore_create(1);
+        self->progress = Semaphore_create(1);
+    }
+
+    return self;
+}
+
+void
+ControlObjectClientBatch_clear(ControlObjectClientBatch self)
+{
+    int i;
+
+    /* detach the control objects - no more command terminations are passed to the batch */
+    Semaphore_wait(self->connection->clientControlsLock);
+
+    for (i = 0; i < self->numberOfEntries; i++) {
+        ControlObjectClient control = self->entries[i].control;
+
+        if (control)
+            control->batch = NULL;
+    }
+
+    Semaphore_post(self->connection->clientControlsLock);
+
+    Semaphore_wait(self->lock);
+
+    for (i = 0; i < self->numberOfEntries; i++)
+        MmsValue_delete(self->entries[i].ctlVal);
+
+    self->numberOfEntries = 0;
+    self->pendingTerminations = 0;
+
+    Semaphore_post(self->lock);
+}
+
+void
+ControlObjectClientBatch_destroy(ControlObjectClientBatch self)
+{
+    if (self) {
+        ControlObjectClientBatch_clear(self);
+
+        if (self->entries)
+            GLOBAL_FREEMEM(self->entries);
+
+        Semaphore_destroy(self->progress);
+        Semaphore_destroy(self->lock);
+
+        GLOBAL_FREEMEM(self);
+    }
+}
+
+int
+ControlObjectClientBatch_add(ControlObjectClientBatch self, ControlObjectClient control, MmsValue* ctlVal, uint64_t operTime)
+{
+    if ((control == NULL) || (ctlVal == NULL) || (control->connection != self->connection) || control->batch)
+        return -1;
+
+    MmsValue* ctlValCopy = MmsValue_clone(ctlVal);
+
+    if (ctlValCopy == NULL)
+        return -1;
+
+    /* late command terminations of the last batch operation can access the entries */
+    Semaphore_wait(self->lock);
+
+    if (self->numberOfEntries >= self->maxEntries) {
+        int newSize = (self->maxEntries == 0) ? 16 : (2 * self->maxEntries);
+
+        ControlBatchEntry* newEntries = (ControlBatchEntry*) GLOBAL_REALLOC(self->entries, newSize * sizeof(ControlBatchEntry));
+
+        if (newEntries == NULL) {
+            Semaphore_post(self->lock);
+            MmsValue_delete(ctlValCopy);
+            return -1;
+        }
+
+        self->entries = newEntries;
+        self->maxEntries = newSize;
+    }
+
+    int index = self->numberOfEntries;
+
+    ControlBatchEntry* entry = &(self->entries[index]);
+
+    memset(entry, 0, sizeof(ControlBatchEntry));
+
+    entry->ctlVal = ctlValCopy;
+    entry->batch = self;
+    entry->control = control;
+    entry->operTime = operTime;
+    entry->result.control = control;
+
+    MmsMapping_getMmsDomainFromObjectReference(control->objectReference, entry->domainId);
+
+    convertToMmsAndInsertFC(entry->itemId, control->objectReference + strlen(entry->domainId) + 1, "CO");
+
+    StringUtils_appendString(entry->itemId, 65, "$Oper");
+
+    self->numberOfEntries++;
+
+    Semaphore_post(self->lock);
+
+    Semaphore_wait(self->connection->clientControlsLock);
+
+    control->batch = self;
+    control->batchIndex = index;
+
+    Semaphore_post(self->connection->clientControlsLock);
+
+    return index;
+}
+
+int
+ControlObjectClientBatch_getNumberOfControls(ControlObjectClientBatch self)
+{
+    return self->numberOfEntries;
+}
+
+void
+ControlObjectClientBatch_setUseMultipleWrite(ControlObjectClientBatch self, bool useMultipleWrite)
+{
+    self->useMultipleWrite = useMultipleWrite;
+}
+
+/* called by ControlObjectClient_destroy */
+/* has to be called with the batch lock - releases the lock */
+static void
+controlBatch_signalProgress(ControlObjectClientBatch self)
+{
+    bool unblockUserThread = self->userWaits;
+
+    self->userWaits = false;
+
+    Semaphore_post(self->lock);
+
+    if (unblockUserThread)
+        Semaphore_post(self->progress);
+}
+
+/* has to be called with the batch lock */
+static void
+controlBatch_terminationDone(ControlObjectClientBatch self)
+{
+    self->pendingTerminations--;
+
+    if (self->pendingTerminations == 0)
+        controlBatch_signalProgress(self);
+    else
+        Semaphore_post(self->lock);
+}
+
+static void
+controlObjectClientBatch_removeControl(ControlObjectClientBatch self, int index)
+{
+    Semaphore_wait(self->lock);
+
+    if (index < self->numberOfEntries) {
+        ControlBatchEntry* entry = &(self->entries[index]);
+
+        entry->control = NULL;
+        entry->result.control = NULL;
+
+        if (entry->result.terminationExpected && (entry->result.terminationReceived == false)) {
+            entry->result.terminationExpected = false;
+            controlBatch_terminationDone(self);
+            return;
+        }
+    }
+
+    Semaphore_post(self->lock);
+}
+
+/* called by the connection thread with the clientControlsLock of the connection */
+static void
+controlObjectClientBatch_handleCommandTermination(ControlObjectClientBatch self, int index, LastApplError lastApplError,
+        bool lastApplErrorReceived)
+{
+    uint64_t receiveTime = Hal_getTimeInNs();
+
+    Semaphore_wait(self->lock);
+
+    if (index < self->numberOfEntries) {
+        ControlBatchEntry* entry = &(self->entries[index]);
+
+        if (entry->result.terminationExpected && (entry->result.terminationReceived == false)) {
+            entry->result.terminationReceived = true;
+            /* the LastApplError of a CommandTermination- is received before the termination */
+            entry->result.terminationPositive = (lastApplErrorReceived == false) &&
+                    (lastApplError.addCause == ADD_CAUSE_UNKNOWN) && (lastApplError.error == CONTROL_ERROR_NO_ERROR);
+            entry->result.lastApplError = lastApplError;
+            entry->result.terminationTimeInUs = (uint32_t) ((receiveTime - entry->sendTimeInNs) / 1000);
+
+            controlBatch_terminationDone(self);
+            return;
+        }
+    }
+
+    Semaphore_post(self->lock);
+}
+
+/* has to be called with the batch lock */
+static void
+controlBatch_handleOperateResult(ControlObjectClientBatch self, ControlBatchEntry* entry, MmsError err,
+        MmsDataAccessError accessError, uint64_t receiveTime)
+{
+    ControlObjectClient control = entry->control;
+
+    entry->state = BATCH_ENTRY_DONE;
+    entry->result.responseTimeInUs = (uint32_t) ((receiveTime - entry->sendTimeInNs) / 1000);
+
+    IedClientError iedError = iedConnection_mapMmsErrorToIedError(err);
+
+    if (iedError == IED_ERROR_OK)
+        iedError = iedConnection_mapDataAccessErrorToIedError(accessError);
+
+    entry->result.error = iedError;
+
+    if (control) {
+        control->lastMmsError = err;
+        control->lastAccessError = accessError;
+
+        /* the LastApplError of a failed command is received before the write response */
+        entry->result.lastApplError = control->lastApplError;
+
+        if (iedError == IED_ERROR_OK) {
+            MmsValue_update(control->ctlVal, entry->ctlVal);
+            control->opertime = entry->operTime;
+
+            if ((control->ctlModel == CONTROL_MODEL_DIRECT_ENHANCED) || (control->ctlModel == CONTROL_MODEL_SBO_ENHANCED)) {
+                entry->result.terminationExpected = true;
+                self->pendingTerminations++;
+            }
+        }
+    }
+
+    if ((err != MMS_ERROR_NONE) && (self->err == MMS_ERROR_NONE))
+        self->err = err;
+}
+
+static void
+controlBatchWriteHandler(uint32_t invokeId, void* parameter, MmsError err, MmsDataAccessError accessError)
+{
+    (void)invokeId;
+
+    uint64_t receiveTime = Hal_getTimeInNs();
+
+    ControlBatchEntry* entry = (ControlBatchEntry*) parameter;
+    ControlObjectClientBatch self = entry->batch;
+
+    Semaphore_wait(self->lock);
+
+    self->outstanding--;
+
+    controlBatch_handleOperateResult(self, entry, err, accessError, receiveTime);
+
+    controlBatch_signalProgress(self);
+}
+
+static void
+controlBatchWriteMultipleHandler(uint32_t invokeId, void* parameter, MmsError err, LinkedList accessResults)
+{
+    (void)invokeId;
+
+    uint64_t receiveTime = Hal_getTimeInNs();
+
+    ControlBatchWriteRequest* request = (ControlBatchWriteRequest*) parameter;
+    ControlObjectClientBatch self = request->batch;
+
+    Semaphore_wait(self->lock);
+
+    self->outstanding--;
+
+    if ((err >= MMS_ERROR_VMDSTATE_OTHER) && (accessResults == NULL)) {
+        /* server doesn't accept the request -> send single write requests */
+        int i;
+
+        for (i = 0; i < request->numberOfEntries; i++)
+            self->entries[request->entries[i]].state = BATCH_ENTRY_PENDING;
+
+        self->multipleWriteRejected = true;
+        self->resendRejected = true;
+    }
+    else {
+        /* some servers answer each Oper individually -> don't combine the remaining requests */
+        if (accessResults && (LinkedList_size(accessResults) != request->numberOfEntries))
+            self->multipleWriteRejected = true;
+
+        LinkedList accessResult = LinkedList_getNext(accessResults);
+
+        int i;
+
+        for (i = 0; i < request->numberOfEntries; i++) {
+            MmsDataAccessError accessError = DATA_ACCESS_ERROR_SUCCESS;
+            MmsError itemErr = err;
+
+            if (accessResult) {
+                accessError = MmsValue_getDataAccessError((MmsValue*) accessResult->data);
+                accessResult = LinkedList_getNext(accessResult);
+            }
+            else if (itemErr == MMS_ERROR_NONE) {
+                itemErr = MMS_ERROR_PARSING_RESPONSE; /* missing access result */
+            }
+
+            controlBatch_handleOperateResult(self, &(self->entries[request->entries[i]]), itemErr, accessError, receiveTime);
+        }
+    }
+
+    controlBatch_signalProgress(self);
+
+    if (accessResults)
+        LinkedList_destroyDeep(accessResults, (LinkedListValueDeleteFunction) MmsValue_delete);
+
+    GLOBAL_FREEMEM(request);
+}
+
+static void
+controlBatch_releaseOperParameters(ControlObjectClient control, MmsValue* operParameters)
+{
+    MmsValue_setElement(operParameters, 0, NULL);
+    MmsValue_delete(operParameters);
+
+    if (control->analogValue)
+        MmsValue_setElement(control->analogValue, 0, NULL);
+}
+
+/* estimated encoded size of an Oper write item (only the ctlVal and originator size are variable) */
+static int
+controlBatch_estimateItemSize(ControlBatchEntry* entry)
+{
+    int size = 80 + strlen(entry->domainId) + strlen(entry->itemId);
+
+    size += MmsValue_encodeMmsData(entry->ctlVal, NULL, 0, false);
+
+    if (entry->control->orIdent)
+        size += strlen(entry->control->orIdent);
+
+    return size;
+}
+
+/* has to be called with the batch lock - returns the error of the request */
+static MmsError
+controlBatch_sendSingleRequest(ControlObjectClientBatch self, ControlBatchEntry* entry)
+{
+    MmsError mmsError = MMS_ERROR_NONE;
+
+    ControlObjectClient control = entry->control;
+
+    entry->state = BATCH_ENTRY_SENT;
+    self->outstanding++;
+
+    Semaphore_post(self->lock);
+
+    MmsValue* operParameters = prepareOperParameters(control, entry->ctlVal, entry->operTime);
+
+    entry->sendTimeInNs = Hal_getTimeInNs();
+
+    MmsConnection_writeVariableAsync(self->connection->connection, NULL, &mmsError, entry->domainId, entry->itemId,
+            operParameters, controlBatchWriteHandler, entry);
+
+    controlBatch_releaseOperParameters(control, operParameters);
+
+    Semaphore_wait(self->lock);
+
+    if (mmsError != MMS_ERROR_NONE) {
+        entry->state = BATCH_ENTRY_PENDING;
+        self->outstanding--;
+    }
+    else
+        self->numberOfRequests++;
+
+    return mmsError;
+}
+
+/* has to be called with the batch lock - returns the error of the request */
+static MmsError
+controlBatch_sendMultipleRequest(ControlObjectClientBatch self, int firstEntry)
+{
+    MmsError mmsError = MMS_ERROR_NONE;
+
+    ControlBatchWriteRequest* request = (ControlBatchWriteRequest*) GLOBAL_MALLOC(sizeof(ControlBatchWriteRequest));
+
+    if (request == NULL)
+        return MMS_ERROR_RESOURCE_OTHER;
+
+    request->batch = self;
+    request->numberOfEntries = 0;
+
+    const char* domainId = self->entries[firstEntry].domainId;
+
+    int maxRequestSize = MmsConnection_getMmsConnectionParameters(self->connection->connection).maxPduSize - 64;
+    int requestSize = 0;
+
+    int i;
+
+    /* combine the pending control objects of the same domain */
+    for (i = firstEntry; (i < self->numberOfEntries) && (request->numberOfEntries < CONTROL_BATCH_MAX_ITEMS_PER_WRITE); i++) {
+        ControlBatchEntry* entry = &(self->entries[i]);
+
+        if ((entry->state != BATCH_ENTRY_PENDING) || (entry->control == NULL) || strcmp(entry->domainId, domainId))
+            continue;
+
+        int itemSize = controlBatch_estimateItemSize(entry);
+
+        if ((request->numberOfEntries > 0) && (requestSize + itemSize > maxRequestSize))
+            break;
+
+        requestSize += itemSize;
+
+        entry->state = BATCH_ENTRY_SENT;
+        request->entries[request->numberOfEntries++] = i;
+    }
+
+    self->outstanding++;
+
+    Semaphore_post(self->lock);
+
+    LinkedList items = LinkedList_create();
+    LinkedList values = LinkedList_create();
+
+    for (i = 0; i < request->numberOfEntries; i++) {
+        ControlBatchEntry* entry = &(self->entries[request->entries[i]]);
+
+        LinkedList_add(items, entry->itemId);
+        LinkedList_add(values, prepareOperParameters(entry->control, entry->ctlVal, entry->operTime));
+    }
+
+    uint64_t sendTime = Hal_getTimeInNs();
+
+    for (i = 0; i < request->numberOfEntries; i++)
+        self->entries[request->entries[i]].sendTimeInNs = sendTime;
+
+    int numberOfEntries = request->numberOfEntries;
+
+    MmsConnection_writeMultipleVariablesAsync(self->connection->connection, NULL, &mmsError, domainId, items, values,
+            controlBatchWriteMultipleHandler, request);
+
+    LinkedList value = LinkedList_getNext(values);
+
+    for (i = 0; i < numberOfEntries; i++) {
+        controlBatch_releaseOperParameters(self->entries[request->entries[i]].control, (MmsValue*) value->data);
+        value = LinkedList_getNext(value);
+    }
+
+    LinkedList_destroyStatic(items);
+    LinkedList_destroyStatic(values);
+
+    Semaphore_wait(self->lock);
+
+    if (mmsError != MMS_ERROR_NONE) {
+        for (i = 0; i < request->numberOfEntries; i++)
+            self->entries[request->entries[i]].state = BATCH_ENTRY_PENDING;
+
+        self->outstanding--;
+
+        GLOBAL_FREEMEM(request);
+    }
+    else
+        self->numberOfRequests++;
+
+    return mmsError;
+}
+
+bool
+ControlObjectClientBatch_operate(ControlObjectClientBatch self, IedClientError* error, uint32_t terminationTimeoutInMs)
+{
+    *error = IED_ERROR_OK;
+
+    uint64_t startTime = Hal_getTimeInNs();
+
+    int i;
+
+    Semaphore_wait(self->lock);
+
+    for (i = 0; i < self->numberOfEntries; i++) {
+        ControlBatchEntry* entry = &(self->entries[i]);
+
+        memset(&(entry->result), 0, sizeof(ControlObjectClientBatchResult));
+
+        entry->sendTimeInNs = 0;
+
+        entry->result.control = entry->control;
+        entry->state = (entry->control) ? BATCH_ENTRY_PENDING : BATCH_ENTRY_DONE;
+
+        if (entry->control == NULL)
+            entry->result.error = IED_ERROR_USER_PROVIDED_INVALID_ARGUMENT;
+    }
+
+    self->outstanding = 0;
+    self->pendingTerminations = 0;
+    self->multipleWriteRejected = false;
+    self->resendRejected = false;
+    self->err = MMS_ERROR_NONE;
+    self->numberOfRequests = 0;
+    self->userWaits = false;
+
+    Semaphore_post(self->lock);
+
+    /* progress semaphore is only posted when the user thread waits */
+    Semaphore_wait(self->progress);
+
+    int nextEntry = 0;
+
+    Semaphore_wait(self->lock);
+
+    while (true) {
+
+        /* entries of rejected write requests with multiple variables are sent by single write requests */
+        if (self->resendRejected) {
+            self->resendRejected = false;
+            nextEntry = 0;
+        }
+
+        while ((self->err == MMS_ERROR_NONE) && (nextEntry < self->numberOfEntries)) {
+            ControlBatchEntry* entry = &(self->entries[nextEntry]);
+
+            if (entry->state != BATCH_ENTRY_PENDING) {
+                nextEntry++;
+                continue;
+            }
+
+            MmsError mmsError;
+
+            if (self->useMultipleWrite && (self->multipleWriteRejected == false))
+                mmsError = controlBatch_sendMultipleRequest(self, nextEntry);
+            else
+                mmsError = controlBatch_sendSingleRequest(self, entry);
+
+            /* request window is occupied -> retry when a response is received */
+            if ((mmsError == MMS_ERROR_OUTSTANDING_CALL_LIMIT) && (self->outstanding > 0))
+                break;
+
+            if (mmsError != MMS_ERROR_NONE) {
+                self->err = mmsError;
+                break;
+            }
+        }
+
+        if (self->outstanding == 0) {
+            if ((self->err != MMS_ERROR_NONE) || (self->resendRejected == false))
+                break;
+
+            continue;
+        }
+
+        self->userWaits = true;
+
+        Semaphore_post(self->lock);
+
+        Semaphore_wait(self->progress);
+
+        Semaphore_wait(self->lock);
+    }
+
+    /* entries that have not been sent because of an error */
+    for (i = 0; i < self->numberOfEntries; i++) {
+        ControlBatchEntry* entry = &(self->entries[i]);
+
+        if (entry->state == BATCH_ENTRY_PENDING) {
+            entry->state = BATCH_ENTRY_DONE;
+            entry->result.error = iedConnection_mapMmsErrorToIedError(self->err);
+        }
+    }
+
+    self->operateTimeInUs = (uint32_t) ((Hal_getTimeInNs() - startTime) / 1000);
+
+    /* wait for the command terminations - the last CommandTermination posts the progress semaphore */
+    if ((terminationTimeoutInMs > 0) && (self->pendingTerminations > 0) &&
+            (IedConnection_getState(self->connection) == IED_STATE_CONNECTED))
+    {
+        self->userWaits = true;
+
+        Semaphore_post(self->lock);
+
+        bool signaled = Semaphore_waitTimeout(self->progress, terminationTimeoutInMs);
+
+        Semaphore_wait(self->lock);
+
+        if (signaled == false) {
+            /* when the flag has been reset a CommandTermination handler is about to post the semaphore */
+            if (self->userWaits) {
+                self->userWaits = false;
+                Semaphore_post(self->progress);
+            }
+        }
+        else
+            Semaphore_post(self->progress);
+    }
+    else
+        Semaphore_post(self->progress);
+
+    self->totalTimeInUs = (uint32_t) ((Hal_getTimeInNs() - startTime) / 1000);
+
+    bool success = true;
+
+    for (i = 0; i < self->numberOfEntries; i++) {
+        ControlObjectClientBatchResult* result = &(self->entries[i].result);
+
+        if ((result->error != IED_ERROR_OK) || (result->terminationReceived && (result->terminationPositive == false))) {
+            success = false;
+
+            if ((*error == IED_ERROR_OK) && (result->error != IED_ERROR_OK))
+                *error = result->error;
+        }
+    }
+
+    Semaphore_post(self->lock);
+
+    return success;
+}
+
+bool
+ControlObjectClientBatch_getResult(ControlObjectClientBatch self, int index, ControlObjectClientBatchResult* result)
+{
+    if ((index < 0) || (index >= self->numberOfEntries))
+        return false;
+
+    Semaphore_wait(self->lock);
+
+    *result = self->entries[index].result;
+
+    Semaphore_post(self->lock);
+
+    return true;
+}
+
+void
+ControlObjectClientBatch_getStatistics(ControlObjectClientBatch self, ControlObjectClientBatchStatistics* statistics)
+{
+    memset(statistics, 0, sizeof(ControlObjectClientBatchStatistics));
+
+    uint64_t sumOfResponseTimes = 0;
+    uint64_t sumOfTerminationTimes = 0;
+    int numberOfResponses = 0;
+
+    Semaphore_wait(self->lock);
+
+    statistics->numberOfControls = self->numberOfEntries;
+    statistics->numberOfRequests = self->numberOfRequests;
+    statistics->operateTimeInUs = self->operateTimeInUs;
+    statistics->totalTimeInUs = self->totalTimeInUs;
+
+    int i;
+
+    for (i = 0; i < self->numberOfEntries; i++) {
+        ControlBatchEntry* entry = &(self->entries[i]);
+        ControlObjectClientBatchResult* result = &(entry->result);
+
+        if (entry->state != BATCH_ENTRY_DONE)
+            continue;
+
+        if (result->error == IED_ERROR_OK)
+            statistics->numberOfAcceptedOperations++;
+        else
+            statistics->numberOfFailedOperations++;
+
+        if (entry->sendTimeInNs != 0) {
+            if ((numberOfResponses == 0) || (result->responseTimeInUs < statistics->minResponseTimeInUs))
+                statistics->minResponseTimeInUs = result->responseTimeInUs;
+
+            if (result->responseTimeInUs > statistics->maxResponseTimeInUs)
+                statistics->maxResponseTimeInUs = result->responseTimeInUs;
+
+            sumOfResponseTimes += result->responseTimeInUs;
+            numberOfResponses++;
+        }
+
+        if (result->terminationReceived) {
+            if (result->terminationPositive)
+                statistics->numberOfPositiveTerminations++;
+            else
+                statistics->numberOfNegativeTerminations++;
+
+            if (result->terminationTimeInUs > statistics->maxTerminationTimeInUs)
+                statistics->maxTerminationTimeInUs = result->terminationTimeInUs;
+
+            sumOfTerminationTimes += result->terminationTimeInUs;
+        }
+        else if (result->terminationExpected) {
+            statistics->numberOfMissingTerminations++;
+        }
+    }
+
+    Semaphore_post(self->lock);
+
+    if (numberOfResponses > 0)
+        statistics->averageResponseTimeInUs = (uint32_t) (sumOfResponseTimes / numberOfResponses);
+
+    int numberOfTerminations = statistics->numberOfPositiveTerminations + statistics->numberOfNegativeTerminations;
+
+    if (numberOfTerminations > 0)
+        statistics->averageTerminationTimeInUs = (uint32_t) (sumOfTerminationTimes / numberOfTerminations);
+}
@@ -0,0 +1,872 @@
+/*
+ *  client_model_discovery.c
+ *
+ *  Pipelined device model discovery and client side device model cache
+ *
+ *  This file is part of libIEC61850.
+ *
+ *  libIEC61850 is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  libIEC61850 is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with libIEC61850.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+#include "stack_config.h"
+#include "libiec61850_platform_includes.h"
+
+#include "iec61850_client.h"
+
+#include "mms_client_connection.h"
+#include "hal_filesystem.h"
+
+#include "ied_connection_private.h"
+
+#define MODEL_CACHE_VERSION 1
+
+/* "magic" (4 byte) + version (1 byte) + number of logical devices (2 byte) */
+#define MODEL_CACHE_HEADER_SIZE 7
+
+/* FNV-1a hash over the file content (4 byte) */
+#define MODEL_CACHE_TRAILER_SIZE 4
+
+static const uint8_t modelCacheMagic[] = { 'L', 'I', 'M', 'C' };
+
+typedef struct sModelDiscovery* ModelDiscovery;
+
+typedef struct {
+    ModelDiscovery discovery;
+    char* name;
+    LinkedList variables; /* variable names received so far */
+} DiscoveryDevice;
+
+struct sModelDiscovery {
+    IedConnection connection;
+
+    Semaphore lock;
+
+    int numberOfDevices;
+    DiscoveryDevice* devices;
+
+    /* queue of devices waiting for the next GetNameList request (at most one request per device) */
+    DiscoveryDevice** queue;
+    int queueHead;
+    int queueLength;
+
+    int pending; /* requests in flight + active callers */
+    bool finished;
+
+    MmsError error;
+
+    Semaphore done;
+};
+
+static void
+ModelDiscovery_destroy(ModelDiscovery self)
+{
+    int i;
+
+    for (i = 0; i < self->numberOfDevices; i++) {
+        if (self->devices[i].variables)
+            LinkedList_destroy(self->devices[i].variables);
+    }
+
+    GLOBAL_FREEMEM(self->devices);
+    GLOBAL_FREEMEM(self->queue);
+
+    Semaphore_destroy(self->lock);
+    Semaphore_destroy(self->done);
+
+    GLOBAL_FREEMEM(self);
+}
+
+/* has to be called with lock */
+static void
+enqueueDevice(ModelDiscovery self, DiscoveryDevice* device, bool atFront)
+{
+    if (atFront) {
+        self->queueHead = (self->queueHead + self->numberOfDevices - 1) % self->numberOfDevices;
+        self->queue[self->queueHead] = device;
+    }
+    else {
+        self->queue[(self->queueHead + self->queueLength) % self->numberOfDevices] = device;
+    }
+
+    self->queueLength++;
+}
+
+/* has to be called with lock */
+static DiscoveryDevice*
+dequeueDevice(ModelDiscovery self)
+{
+    if (self->queueLength == 0)
+        return NULL;
+
+    DiscoveryDevice* device = self->queue[self->queueHead];
+
+    self->queueHead = (self->queueHead + 1) % self->numberOfDevices;
+    self->queueLength--;
+
+    return device;
+}
+
+static void
+getNameListHandler(uint32_t invokeId, void* parameter, MmsError mmsError, LinkedList nameList, bool moreFollows);
+
+static bool
+sendRequest(ModelDiscovery self, DiscoveryDevice* device, MmsError* mmsError)
+{
+    const char* continueAfter = NULL;
+
+    /* the continuation request appends the names to the list of the previous responses */
+    if (device->variables) {
+        LinkedList lastElement = LinkedList_getLastElement(device->variables);
+
+        if (lastElement != device->variables)
+            continueAfter = (const char*) lastElement->data;
+    }
+
+    MmsConnection_getDomainVariableNamesAsync(self->connection->connection, NULL, mmsError, device->name,
+            continueAfter, device->variables, getNameListHandler, device);
+
+    return (*mmsError == MMS_ERROR_NONE);
+}
+
+/*
+ * Send the queued GetNameList requests until the queue is empty or the request window is exhausted.
+ *
+ * The caller holds one reference (pending) that is released here. The waiting user thread is released by
+ * the caller that releases the last reference.
+ */
+static void
+sendQueuedRequests(ModelDiscovery self)
+{
+    bool finished = false;
+
+    Semaphore_wait(self->lock);
+
+    self->pending--;
+
+    while (self->error == MMS_ERROR_NONE) {
+        DiscoveryDevice* device = dequeueDevice(self);
+
+        if (device == NULL)
+            break;
+
+        self->pending++;
+
+        Semaphore_post(self->lock);
+
+        MmsError mmsError = MMS_ERROR_NONE;
+
+        bool sent = sendRequest(self, device, &mmsError);
+
+        Semaphore_wait(self->lock);
+
+        if (sent == false) {
+            self->pending--;
+
+            if ((mmsError == MMS_ERROR_OUTSTANDING_CALL_LIMIT) && (self->pending > 0)) {
+                /* retry when the next response has been received */
+                enqueueDevice(self, device, true);
+                break;
+            }
+
+            if (self->error == MMS_ERROR_NONE)
+                self->error = mmsError;
+        }
+    }
+
+    if ((self->pending == 0) && ((self->queueLength == 0) || (self->error != MMS_ERROR_NONE)) && (self->finished == false)) {
+        self->finished = true;
+        finished = true;
+    }
+
+    Semaphore_post(self->lock);
+
+    if (finished)
+        Semaphore_post(self->done);
+}
+
+static void
+getNameListHandler(uint32_t invokeId, void* parameter, MmsError mmsError, LinkedList nameList, bool moreFollows)
+{
+    (void)invokeId;
+
+    DiscoveryDevice* device = (DiscoveryDevice*) parameter;
+    ModelDiscovery self = device->discovery;
+
+    Semaphore_wait(self->lock);
+
+    if (mmsError == MMS_ERROR_NONE) {
+        device->variables = nameList;
+
+        if (moreFollows)
+            enqueueDevice(self, device, false);
+    }
+    else {
+        /* the list of the previous responses is released by the response parser in case of a parsing error */
+        if (mmsError == MMS_ERROR_PARSING_RESPONSE)
+            device->variables = NULL;
+
+        if (self->error == MMS_ERROR_NONE)
+            self->error = mmsError;
+    }
+
+    Semaphore_post(self->lock);
+
+    sendQueuedRequests(self);
+}
+
+static void
+setLogicalDevices(IedConnection self, LinkedList logicalDevices)
+{
+    if (self->logicalDevices != NULL)
+        LinkedList_destroyDeep(self->logicalDevices, (LinkedListValueDeleteFunction) ICLogicalDevice_destroy);
+
+    self->logicalDevices = logicalDevices;
+}
+
+void
+IedConnection_getDeviceModelFromServer(IedConnection self, IedClientError* error)
+{
+    MmsError mmsError = MMS_ERROR_NONE;
+
+    if (error)
+        *error = IED_ERROR_OK;
+
+    LinkedList logicalDeviceNames = MmsConnection_getDomainNames(self->connection, &mmsError);
+
+    if (logicalDeviceNames == NULL) {
+        if (error)
+            *error = iedConnection_mapMmsErrorToIedError(mmsError);
+
+        return;
+    }
+
+    int numberOfDevices = LinkedList_size(logicalDeviceNames);
+
+    if (numberOfDevices == 0) {
+        setLogicalDevices(self, LinkedList_create());
+        LinkedList_destroy(logicalDeviceNames);
+        return;
+    }
+
+    ModelDiscovery discovery = (ModelDiscovery) GLOBAL_CALLOC(1, sizeof(struct sModelDiscovery));
+
+    if (discovery == NULL) {
+        if (error)
+            *error = IED_ERROR_UNKNOWN;
+
+        LinkedList_destroy(logicalDeviceNames);
+        return;
+    }
+
+    discovery->connection = self;
+    discovery->numberOfDevices = numberOfDevices;
+    discovery->lock = Semaphore_create(1);
+    discovery->done = Semaphore_create(1);
+    discovery->devices = (DiscoveryDevice*) GLOBAL_CALLOC(numberOfDevices, sizeof(DiscoveryDevice));
+    discovery->queue = (DiscoveryDevice**) GLOBAL_CALLOC(numberOfDevices, sizeof(DiscoveryDevice*));
+
+    if ((discovery->devices == NULL) || (discovery->queue == NULL)) {
+        if (error)
+            *error = IED_ERROR_UNKNOWN;
+
+        ModelDiscovery_destroy(discovery);
+        LinkedList_destroy(logicalDeviceNames);
+        return;
+    }
+
+    int i = 0;
+
+    LinkedList logicalDeviceName = LinkedList_getNext(logicalDeviceNames);
+
+    while (logicalDeviceName) {
+        DiscoveryDevice* device = &(discovery->devices[i++]);
+
+        device->discovery = discovery;
+        device->name = (char*) logicalDeviceName->data;
+
+        enqueueDevice(discovery, device, false);
+
+        logicalDeviceName = LinkedList_getNext(logicalDeviceName);
+    }
+
+    /* request the variable names of all logical devices at once - the continuation requests are sent by the handler */
+    Semaphore_wait(discovery->done);
+
+    discovery->pending = 1;
+
+    sendQueuedRequests(discovery);
+
+    Semaphore_wait(discovery->done);
+
+    if (discovery->error == MMS_ERROR_NONE) {
+        LinkedList logicalDevices = LinkedList_create();
+
+        for (i = 0; i < numberOfDevices; i++) {
+            DiscoveryDevice* device = &(discovery->devices[i]);
+
+            ICLogicalDevice* icLogicalDevice = ICLogicalDevice_create(device->name);
+
+            ICLogicalDevice_setVariableList(icLogicalDevice, device->variables);
+            device->variables = NULL;
+
+            LinkedList_add(logicalDevices, icLogicalDevice);
+        }
+
+        setLogicalDevices(self, logicalDevices);
+    }
+    else {
+        if (error)
+            *error = iedConnection_mapMmsErrorToIedError(discovery->error);
+    }
+
+    ModelDiscovery_destroy(discovery);
+
+    LinkedList_destroy(logicalDeviceNames);
+}
+
+/*************************************
+ * Device model cache
+ ************************************/
+
+static uint32_t
+calculateHash(uint8_t* buffer, int size)
+{
+    uint32_t hash = 2166136261u;
+
+    int i;
+
+    for (i = 0; i < size; i++) {
+        hash ^= buffer[i];
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+/*
+ * Read LLN0.NamPlt.configRev of all logical devices.
+ *
+ * configRevs[i] is set to NULL when the value of the logical device is not available.
+ */
+static void
+readConfigRevs(IedConnection self, IedClientError* error, int numberOfDevices, char** names, char** configRevs)
+{
+    char** references = (char**) GLOBAL_CALLOC(numberOfDevices, sizeof(char*));
+    FunctionalConstraint* fcs = (FunctionalConstraint*) GLOBAL_CALLOC(numberOfDevices, sizeof(FunctionalConstraint));
+    MmsValue** values = (MmsValue**) GLOBAL_CALLOC(numberOfDevices, sizeof(MmsValue*));
+
+    int i;
+
+    for (i = 0; i < numberOfDevices; i++)
+        configRevs[i] = NULL;
+
+    if ((references == NULL) || (fcs == NULL) || (values == NULL)) {
+        *error = IED_ERROR_UNKNOWN;
+        goto exit_function;
+    }
+
+    for (i = 0; i < numberOfDevices; i++) {
+        references[i] = StringUtils_createString(2, names[i], "/LLN0.NamPlt.configRev");
+        fcs[i] = IEC61850_FC_DC;
+    }
+
+    IedConnection_readObjects(self, error, numberOfDevices, (const char**) references, fcs, values);
+
+    if (*error == IED_ERROR_OK) {
+        for (i = 0; i < numberOfDevices; i++) {
+            if (values[i] && (MmsValue_getType(values[i]) == MMS_VISIBLE_STRING))
+                configRevs[i] = StringUtils_copyString(MmsValue_toString(values[i]));
+        }
+    }
+
+    for (i = 0; i < numberOfDevices; i++) {
+        if (references[i])
+            GLOBAL_FREEMEM(references[i]);
+
+        if (values[i])
+            MmsValue_delete(values[i]);
+    }
+
+exit_function:
+    GLOBAL_FREEMEM(references);
+    GLOBAL_FREEMEM(fcs);
+    GLOBAL_FREEMEM(values);
+}
+
+static void
+releaseStrings(int numberOfStrings, char** strings)
+{
+    int i;
+
+    for (i = 0; i < numberOfStrings; i++) {
+        if (strings[i])
+            GLOBAL_FREEMEM(strings[i]);
+    }
+
+    GLOBAL_FREEMEM(strings);
+}
+
+static int
+encodeString(uint8_t* buffer, int bufPos, const char* string)
+{
+    int length = strlen(string);
+
+    if (buffer) {
+        buffer[bufPos] = (uint8_t) (length / 0x100);
+        buffer[bufPos + 1] = (uint8_t) (length % 0x100);
+        memcpy(buffer + bufPos + 2, string, length);
+    }
+
+    return bufPos + 2 + length;
+}
+
+static int
+encodeUint32(uint8_t* buffer, int bufPos, uint32_t value)
+{
+    if (buffer) {
+        buffer[bufPos] = (uint8_t) (value >> 24);
+        buffer[bufPos + 1] = (uint8_t) (value >> 16);
+        buffer[bufPos + 2] = (uint8_t) (value >> 8);
+        buffer[bufPos + 3] = (uint8_t) value;
+    }
+
+    return bufPos + 4;
+}
+
+/* returns the size of the encoded model - when buffer is NULL only the size is calculated */
+static int
+encodeModelCache(uint8_t* buffer, LinkedList logicalDevices, char** configRevs)
+{
+    int bufPos = 0;
+
+    if (buffer) {
+        memcpy(buffer, modelCacheMagic, 4);
+        buffer[4] = MODEL_CACHE_VERSION;
+        buffer[5] = (uint8_t) (LinkedList_size(logicalDevices) / 0x100);
+        buffer[6] = (uint8_t) (LinkedList_size(logicalDevices) % 0x100);
+    }
+
+    bufPos += MODEL_CACHE_HEADER_SIZE;
+
+    int i = 0;
+
+    LinkedList element = LinkedList_getNext(logicalDevices);
+
+    while (element) {
+        ICLogicalDevice* device = (ICLogicalDevice*) element->data;
+
+        bufPos = encodeString(buffer, bufPos, device->name);
+        bufPos = encodeString(buffer, bufPos, configRevs[i++]);
+        bufPos = encodeUint32(buffer, bufPos, LinkedList_size(device->variables));
+
+        LinkedList variable = LinkedList_getNext(device->variables);
+
+        while (variable) {
+            bufPos = encodeString(buffer, bufPos, (char*) variable->data);
+
+            variable = LinkedList_getNext(variable);
+        }
+
+        element = LinkedList_getNext(element);
+    }
+
+    if (buffer)
+        encodeUint32(buffer, bufPos, calculateHash(buffer, bufPos));
+
+    return bufPos + MODEL_CACHE_TRAILER_SIZE;
+}
+
+void
+IedConnection_saveDeviceModel(IedConnection self, IedClientError* error, const char* filename)
+{
+    if (self->logicalDevices == NULL) {
+        IedConnection_getDeviceModelFromServer(self, error);
+
+        if (*error != IED_ERROR_OK)
+            return;
+    }
+
+    int numberOfDevices = LinkedList_size(self->logicalDevices);
+
+    char** names = (char**) GLOBAL_CALLOC(numberOfDevices + 1, sizeof(char*));
+    char** configRevs = (char**) GLOBAL_CALLOC(numberOfDevices + 1, sizeof(char*));
+
+    uint8_t* buffer = NULL;
+
+    if ((names == NULL) || (configRevs == NULL)) {
+        *error = IED_ERROR_UNKNOWN;
+        goto exit_function;
+    }
+
+    int i = 0;
+
+    LinkedList element = LinkedList_getNext(self->logicalDevices);
+
+    while (element) {
+        names[i++] = StringUtils_copyString(((ICLogicalDevice*) element->data)->name);
+        element = LinkedList_getNext(element);
+    }
+
+    *error = IED_ERROR_OK;
+
+    if (numberOfDevices > 0) {
+        readConfigRevs(self, error, numberOfDevices, names, configRevs);
+
+        if (*error != IED_ERROR_OK)
+            goto exit_function;
+    }
+
+    for (i = 0; i < numberOfDevices; i++) {
+        /* without configRev the cached model of the logical device can never be validated */
+        if (configRevs[i] == NULL)
+            configRevs[i] = StringUtils_copyString("");
+    }
+
+    int size = encodeModelCache(NULL, self->logicalDevices, configRevs);
+
+    buffer = (uint8_t*) GLOBAL_MALLOC(size);
+
+    if (buffer == NULL) {
+        *error = IED_ERROR_UNKNOWN;
+        goto exit_function;
+    }
+
+    encodeModelCache(buffer, self->logicalDevices, configRevs);
+
+    FileHandle file = FileSystem_openFile((char*) filename, true);
+
+    if (file == NULL) {
+        *error = IED_ERROR_UNKNOWN;
+        goto exit_function;
+    }
+
+    if (FileSystem_writeFile(file, buffer, size) != size)
+        *error = IED_ERROR_UNKNOWN;
+
+    FileSystem_closeFile(file);
+
+exit_function:
+    if (names)
+        releaseStrings(numberOfDevices, names);
+
+    if (configRevs)
+        releaseStrings(numberOfDevices, configRevs);
+
+    if (buffer)
+        GLOBAL_FREEMEM(buffer);
+}
+
+typedef struct {
+    uint8_t* buffer;
+    int size;
+    int bufPos;
+} CacheDecoder;
+
+static char*
+decodeString(CacheDecoder* decoder)
+{
+    if (decoder->bufPos + 2 > decoder->size)
+        return NULL;
+
+    int length = (decoder->buffer[decoder->bufPos] * 0x100) + decoder->buffer[decoder->bufPos + 1];
+
+    decoder->bufPos += 2;
+
+    if (decoder->bufPos + length > decoder->size)
+        return NULL;
+
+    char* string = StringUtils_createStringFromBuffer(decoder->buffer + decoder->bufPos, length);
+
+    decoder->bufPos += length;
+
+    return string;
+}
+
+static bool
+decodeUint32(CacheDecoder* decoder, uint32_t* value)
+{
+    if (decoder->bufPos + 4 > decoder->size)
+        return false;
+
+    uint8_t* buffer = decoder->buffer + decoder->bufPos;
+
+    *value = ((uint32_t) buffer[0] << 24) + ((uint32_t) buffer[1] << 16) + ((uint32_t) buffer[2] << 8) + buffer[3];
+
+    decoder->bufPos += 4;
+
+    return true;
+}
+
+static uint8_t*
+readCacheFile(const char* filename, int* size)
+{
+    uint32_t fileSize;
+
+    if (FileSystem_getFileInfo((char*) filename, &fileSize, NULL) == false)
+        return NULL;
+
+    if (fileSize < MODEL_CACHE_HEADER_SIZE + MODEL_CACHE_TRAILER_SIZE)
+        return NULL;
+
+    FileHandle file = FileSystem_openFile((char*) filename, false);
+
+    if (file == NULL)
+        return NULL;
+
+    uint8_t* buffer = (uint8_t*) GLOBAL_MALLOC(fileSize);
+
+    if (buffer) {
+        int bytesRead = 0;
+
+        while (bytesRead < (int) fileSize) {
+            int result = FileSystem_readFile(file, buffer + bytesRead, fileSize - bytesRead);
+
+            if (result <= 0)
+                break;
+
+            bytesRead += result;
+        }
+
+        if (bytesRead != (int) fileSize) {
+            GLOBAL_FREEMEM(buffer);
+            buffer = NULL;
+        }
+    }
+
+    FileSystem_closeFile(file);
+
+    *size = (int) fileSize;
+
+    return buffer;
+}
+
+/* returns the list of logical devices (ICLogicalDevice) or NULL when the cache file content is invalid */
+static LinkedList
+decodeModelCache(uint8_t* buffer, int size, LinkedList configRevs)
+{
+    CacheDecoder decoder;
+
+    decoder.buffer = buffer;
+    decoder.size = size - MODEL_CACHE_TRAILER_SIZE;
+    decoder.bufPos = MODEL_CACHE_HEADER_SIZE;
+
+    if (memcmp(buffer, modelCacheMagic, 4) || (buffer[4] != MODEL_CACHE_VERSION))
+        return NULL;
+
+    uint8_t* trailer = buffer + decoder.size;
+
+    uint32_t hash = ((uint32_t) trailer[0] << 24) + ((uint32_t) trailer[1] << 16) + ((uint32_t) trailer[2] << 8) + trailer[3];
+
+    if (hash != calculateHash(buffer, decoder.size))
+        return NULL;
+
+    int numberOfDevices = (buffer[5] * 0x100) + buffer[6];
+
+    LinkedList logicalDevices = LinkedList_create();
+
+    int i;
+
+    for (i = 0; i < numberOfDevices; i++) {
+        char* name = decodeString(&decoder);
+
+        if (name == NULL)
+            goto exit_error;
+
+        ICLogicalDevice* device = ICLogicalDevice_create(name);
+
+        GLOBAL_FREEMEM(name);
+
+        LinkedList_add(logicalDevices, device);
+
+        char* configRev = decodeString(&decoder);
+
+        if (configRev == NULL)
+            goto exit_error;
+
+        LinkedList_add(configRevs, configRev);
+
+        uint32_t numberOfVariables;
+
+        if (decodeUint32(&decoder, &numberOfVariables) == false)
+            goto exit_error;
+
+        /* each variable name is encoded with at least three bytes */
+        if (numberOfVariables > (uint32_t) (decoder.size - decoder.bufPos) / 3)
+            goto exit_error;
+
+        ICLogicalDevice_setVariableList(device, LinkedList_create());
+
+        LinkedList lastVariable = device->variables;
+
+        uint32_t j;
+
+        for (j = 0; j < numberOfVariables; j++) {
+            char* variableName = decodeString(&decoder);
+
+            if (variableName == NULL)
+                goto exit_error;
+
+            lastVariable = LinkedList_insertAfter(lastVariable, variableName);
+        }
+    }
+
+    if (decoder.bufPos != decoder.size)
+        goto exit_error;
+
+    return logicalDevices;
+
+exit_error:
+    LinkedList_destroyDeep(logicalDevices, (LinkedListValueDeleteFunction) ICLogicalDevice_destroy);
+
+    return NULL;
+}
+
+/* check if the logical devices and the configuration revisions of the server match the cached model */
+static bool
+isModelCacheValid(IedConnection self, IedClientError* error, LinkedList logicalDevices, LinkedList cachedConfigRevs)
+{
+    bool isValid = false;
+
+    MmsError mmsError;
+
+    LinkedList logicalDeviceNames = MmsConnection_getDomainNames(self->connection, &mmsError);
+
+    if (logicalDeviceNames == NULL) {
+        *error = iedConnection_mapMmsErrorToIedError(mmsError);
+        return false;
+    }
+
+    int numberOfDevices = LinkedList_size(logicalDeviceNames);
+
+    if (numberOfDevices != LinkedList_size(logicalDevices))
+        goto exit_function;
+
+    if (numberOfDevices == 0) {
+        isValid = true;
+        goto exit_function;
+    }
+
+    char** names = (char**) GLOBAL_CALLOC(numberOfDevices, sizeof(char*));
+    char** configRevs = (char**) GLOBAL_CALLOC(numberOfDevices, sizeof(char*));
+
+    if ((names == NULL) || (configRevs == NULL)) {
+        *error = IED_ERROR_UNKNOWN;
+
+        GLOBAL_FREEMEM(names);
+        GLOBAL_FREEMEM(configRevs);
+
+        goto exit_function;
+    }
+
+    int i = 0;
+
+    LinkedList name = LinkedList_getNext(logicalDeviceNames);
+
+    while (name) {
+        names[i++] = (char*) name->data;
+        name = LinkedList_getNext(name);
+    }
+
+    readConfigRevs(self, error, numberOfDevices, names, configRevs);
+
+    if (*error == IED_ERROR_OK) {
+        LinkedList device = LinkedList_getNext(logicalDevices);
+        LinkedList configRev = LinkedList_getNext(cachedConfigRevs);
+
+        isValid = true;
+
+        for (i = 0; i < numberOfDevices; i++) {
+            char* cachedConfigRev = (char*) configRev->data;
+
+            if (strcmp(names[i], ((ICLogicalDevice*) device->data)->name) || (configRevs[i] == NULL) ||
+                    (cachedConfigRev[0] == 0) || strcmp(configRevs[i], cachedConfigRev))
+            {
+                isValid = false;
+                break;
+            }
+
+            device = LinkedList_getNext(device);
+            configRev = LinkedList_getNext(configRev);
+        }
+    }
+
+    GLOBAL_FREEMEM(names);
+    releaseStrings(numberOfDevices, configRevs);
+
+exit_function:
+    LinkedList_destroy(logicalDeviceNames);
+
+    return isValid;
+}
+
+bool
+IedConnection_loadDeviceModel(IedConnection self, IedClientError* error, const char* filename)
+{
+    *error = IED_ERROR_OK;
+
+    int size;
+
+    uint8_t* buffer = readCacheFile(filename, &size);
+
+    if (buffer == NULL)
+        return false;
+
+    bool isValid = false;
+
+    LinkedList configRevs = LinkedList_create();
+
+    LinkedList logicalDevices = decodeModelCache(buffer, size, configRevs);
+
+    GLOBAL_FREEMEM(buffer);
+
+    if (logicalDevices) {
+        isValid = isModelCacheValid(self, error, logicalDevices, configRevs);
+
+        if (isValid)
+            setLogicalDevices(self, logicalDevices);
+        else
+            LinkedList_destroyDeep(logicalDevices, (LinkedListValueDeleteFunction) ICLogicalDevice_destroy);
+    }
+
+    LinkedList_destroy(configRevs);
+
+    return isValid;
+}
+
+void
+IedConnection_getDeviceModelFromServerCached(IedConnection self, IedClientError* error, const char* filename)
+{
+    if (IedConnection_loadDeviceModel(self, error, filename))
+        return;
+
+    if (*error != IED_ERROR_OK)
+        return;
+
+    IedConnection_getDeviceModelFromServer(self, error);
+
+    if (*error != IED_ERROR_OK)
+        return;
+
+    /* the discovered model is still usable when the cache file cannot be written */
+    IedClientError cacheError;
+
+    IedConnection_saveDeviceModel(self, &cacheError, filename);
+
+    if (DEBUG_IED_CLIENT) {
+        if (cacheError != IED_ERROR_OK)
+            printf("IED_CLIENT: failed to write model cache file %s (error %i)\n", filename, cacheError);
+    }
+}
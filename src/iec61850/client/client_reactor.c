@@ -0,0 +1,489 @@
+/*
+ *  client_reactor.c
+ *
+ *  Handling of many client connections in non-thread mode by a small number of worker threads
+ *
+ *  This file is part of libIEC61850.
+ *
+ *  libIEC61850 is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  libIEC61850 is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with libIEC61850.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+#include "stack_config.h"
+#include "libiec61850_platform_includes.h"
+
+#include "iec61850_client.h"
+
+#include "ied_connection_private.h"
+#include "mms_client_internal.h"
+#include "iso_client_connection.h"
+
+#include "hal_socket.h"
+#include "hal_thread.h"
+#include "hal_time.h"
+
+#if (CONFIG_MMS_THREADLESS_STACK == 0)
+
+/* interval to check the timers of all connections (request timeouts, read timeouts, close requests) */
+#define REACTOR_DEFAULT_TICK_INTERVAL 100
+
+/* interval to check the connections without socket (e.g. progress of TCP connects) */
+#define REACTOR_CONNECT_POLL_INTERVAL 10
+
+/* maximum number of consecutive ticks of a busy connection before the other connections are handled */
+#define REACTOR_MAX_TICKS_PER_CYCLE 8
+
+typedef struct
+{
+    IedConnection connection;
+    IsoClientConnection isoClient;
+    Socket socket; /* socket in the handle set of the worker or NULL */
+    bool busy; /* last tick indicated that more data is available */
+} ReactorConnection;
+
+typedef struct sReactorWorker* ReactorWorker;
+
+struct sReactorWorker
+{
+    IedClientReactor reactor;
+    Thread thread;
+
+    Semaphore lock; /* protects the connections (held while the connections are handled) */
+    ReactorConnection* connections;
+    int numberOfConnections;
+    int maxConnections;
+
+    HandleSet handleSet;
+    int numberOfSockets;
+    bool updateHandleSet;
+};
+
+struct sIedClientReactor
+{
+    struct sReactorWorker* workers;
+    int numberOfWorkers;
+
+    volatile bool running;
+    volatile int tickInterval;
+};
+
+static void
+updateHandleSet(ReactorWorker self)
+{
+    Handleset_reset(self->handleSet);
+
+    self->numberOfSockets = 0;
+
+    int i;
+
+    for (i = 0; i < self->numberOfConnections; i++) {
+        if (self->connections[i].socket) {
+            Handleset_addSocket(self->handleSet, self->connections[i].socket);
+            self->numberOfSockets++;
+        }
+    }
+
+    /* let the handle set read the socket handles while the sockets are known to be valid
+     * (a removed connection can be destroyed while the worker is waiting) */
+    if (self->numberOfSockets > 0)
+        Handleset_waitReady(self->handleSet, 0);
+
+    self->updateHandleSet = false;
+}
+
+static void
+handleConnection(ReactorWorker self, ReactorConnection* con)
+{
+    int ticks = 0;
+    bool waits;
+
+    do {
+        waits = IsoClientConnection_handleConnection(con->isoClient);
+        ticks++;
+    } while ((waits == false) && (ticks < REACTOR_MAX_TICKS_PER_CYCLE));
+
+    con->busy = !waits;
+
+    /* the socket is only released by IsoClientConnection_handleConnection (deferred close) */
+    Socket socket = IsoClientConnection_getSocket(con->isoClient);
+
+    if (socket != con->socket) {
+        con->socket = socket;
+        self->updateHandleSet = true;
+    }
+}
+
+static void
+checkTimers(ReactorWorker self, ReactorConnection* con)
+{
+    if (IsoClientConnection_checkTimeouts(con->isoClient))
+        handleConnection(self, con);
+}
+
+static void*
+reactorWorkerThread(void* parameter)
+{
+    ReactorWorker self = (ReactorWorker) parameter;
+    IedClientReactor reactor = self->reactor;
+
+    uint64_t nextTimerCheck = 0;
+    bool busy = false;
+    bool pending = false;
+
+    while (reactor->running) {
+
+        Semaphore_wait(self->lock);
+
+        if (self->updateHandleSet)
+            updateHandleSet(self);
+
+        Semaphore_post(self->lock);
+
+        uint64_t currentTime = Hal_getTimeInMs();
+
+        int waitTime = 0;
+
+        if ((busy == false) && (currentTime < nextTimerCheck)) {
+            waitTime = (int) (nextTimerCheck - currentTime);
+
+            if (pending && (waitTime > REACTOR_CONNECT_POLL_INTERVAL))
+                waitTime = REACTOR_CONNECT_POLL_INTERVAL;
+        }
+
+        int ready = 0;
+
+        if (self->numberOfSockets > 0) {
+            ready = Handleset_waitReady(self->handleSet, waitTime);
+
+            if (ready < 0) {
+                /* avoid busy loop in case of socket errors */
+                Thread_sleep(1);
+                ready = 0;
+            }
+        }
+        else if (waitTime > 0)
+            Thread_sleep(waitTime);
+
+        currentTime = Hal_getTimeInMs();
+
+        bool checkAllTimers = false;
+
+        if (currentTime >= nextTimerCheck) {
+            checkAllTimers = true;
+            nextTimerCheck = currentTime + reactor->tickInterval;
+        }
+
+        busy = false;
+        pending = false;
+
+        Semaphore_wait(self->lock);
+
+        int i;
+
+        for (i = 0; i < self->numberOfConnections; i++) {
+            ReactorConnection* con = &(self->connections[i]);
+
+            /* only the connections with socket events are handled, the timers of the other connections are checked
+             * without accessing the socket. Connections without socket (e.g. TCP connect in progress) are checked
+             * every REACTOR_CONNECT_POLL_INTERVAL. */
+            if (con->busy || ((ready > 0) && con->socket && Handleset_isReady(self->handleSet, con->socket)))
+                handleConnection(self, con);
+            else if (checkAllTimers || (con->socket == NULL))
+                checkTimers(self, con);
+
+            if (con->busy)
+                busy = true;
+
+            if (con->socket == NULL)
+                pending = true;
+        }
+
+        Semaphore_post(self->lock);
+    }
+
+    return NULL;
+}
+
+IedClientReactor
+IedClientReactor_create(int numberOfThreads)
+{
+    if (numberOfThreads < 1)
+        numberOfThreads = 1;
+
+    IedClientReactor self = (IedClientReactor) GLOBAL_CALLOC(1, sizeof(struct sIedClientReactor));
+
+    if (self) {
+        self->workers = (struct sReactorWorker*) GLOBAL_CALLOC(numberOfThreads, sizeof(struct sReactorWorker));
+
+        if (self->workers == NULL) {
+            GLOBAL_FREEMEM(self);
+            return NULL;
+        }
+
+        self->numberOfWorkers = numberOfThreads;
+        self->tickInterval = REACTOR_DEFAULT_TICK_INTERVAL;
+        self->running = false;
+
+        int i;
+
+        for (i = 0; i < numberOfThreads; i++) {
+            ReactorWorker worker = &(self->workers[i]);
+
+            worker->reactor = self;
+            worker->lock = Semaphore_create(1);
+            worker->handleSet = Handleset_new();
+        }
+    }
+
+    return self;
+}
+
+void
+IedClientReactor_setTickInterval(IedClientReactor self, int intervalInMs)
+{
+    if (intervalInMs > 0)
+        self->tickInterval = intervalInMs;
+}
+
+bool
+IedClientReactor_addConnection(IedClientReactor self, IedConnection connection)
+{
+    MmsConnection mmsConnection = connection->connection;
+
+    if (mmsConnection->createThread) {
+        if (DEBUG_IED_CLIENT)
+            printf("IED_CLIENT: reactor requires connection in non-thread mode\n");
+
+        return false;
+    }
+
+    /* assign the connection to the worker with the least connections */
+    ReactorWorker worker = NULL;
+
+    int i;
+
+    for (i = 0; i < self->numberOfWorkers; i++) {
+        ReactorWorker candidate = &(self->workers[i]);
+
+        Semaphore_wait(candidate->lock);
+
+        int j;
+
+        for (j = 0; j < candidate->numberOfConnections; j++) {
+            if (candidate->connections[j].connection == connection) {
+                Semaphore_post(candidate->lock);
+                return false;
+            }
+        }
+
+        if ((worker == NULL) || (candidate->numberOfConnections < worker->numberOfConnections))
+            worker = candidate;
+
+        Semaphore_post(candidate->lock);
+    }
+
+    bool success = false;
+
+    Semaphore_wait(worker->lock);
+
+    if (worker->numberOfConnections >= worker->maxConnections) {
+        int newSize = (worker->maxConnections == 0) ? 16 : (2 * worker->maxConnections);
+
+        ReactorConnection* newConnections = (ReactorConnection*)
+                GLOBAL_REALLOC(worker->connections, newSize * sizeof(ReactorConnection));
+
+        if (newConnections == NULL)
+            goto exit_function;
+
+        worker->connections = newConnections;
+        worker->maxConnections = newSize;
+    }
+
+    ReactorConnection* con = &(worker->connections[worker->numberOfConnections]);
+
+    con->connection = connection;
+    con->isoClient = mmsConnection->isoClient;
+    con->socket = NULL;
+    con->busy = true; /* handle immediately */
+
+    IsoClientConnection_setExternallyHandled(con->isoClient, true);
+
+    worker->numberOfConnections++;
+
+    success = true;
+
+exit_function:
+    Semaphore_post(worker->lock);
+
+    return success;
+}
+
+void
+IedClientReactor_removeConnection(IedClientReactor self, IedConnection connection)
+{
+    int i;
+
+    for (i = 0; i < self->numberOfWorkers; i++) {
+        ReactorWorker worker = &(self->workers[i]);
+
+        Semaphore_wait(worker->lock);
+
+        int j;
+
+        for (j = 0; j < worker->numberOfConnections; j++) {
+            ReactorConnection* con = &(worker->connections[j]);
+
+            if (con->connection == connection) {
+
+                IsoClientConnection_setExternallyHandled(con->isoClient, false);
+
+                if (con->socket)
+                    worker->updateHandleSet = true;
+
+                /* keep the order of the connections (order of the handle set) */
+                memmove(con, con + 1, (worker->numberOfConnections - j - 1) * sizeof(ReactorConnection));
+
+                worker->numberOfConnections--;
+
+                Semaphore_post(worker->lock);
+
+                return;
+            }
+        }
+
+        Semaphore_post(worker->lock);
+    }
+}
+
+void
+IedClientReactor_start(IedClientReactor self)
+{
+    if (self->running)
+        return;
+
+    self->running = true;
+
+    int i;
+
+    for (i = 0; i < self->numberOfWorkers; i++) {
+        ReactorWorker worker = &(self->workers[i]);
+
+        worker->thread = Thread_create(reactorWorkerThread, worker, false);
+
+        if (worker->thread)
+            Thread_start(worker->thread);
+    }
+}
+
+void
+IedClientReactor_stop(IedClientReactor self)
+{
+    if (self->running == false)
+        return;
+
+    self->running = false;
+
+    int i;
+
+    for (i = 0; i < self->numberOfWorkers; i++) {
+        ReactorWorker worker = &(self->workers[i]);
+
+        if (worker->thread) {
+            Thread_destroy(worker->thread);
+            worker->thread = NULL;
+        }
+    }
+}
+
+void
+IedClientReactor_destroy(IedClientReactor self)
+{
+    if (self) {
+        IedClientReactor_stop(self);
+
+        int i;
+
+        for (i = 0; i < self->numberOfWorkers; i++) {
+            ReactorWorker worker = &(self->workers[i]);
+
+            int j;
+
+            for (j = 0; j < worker->numberOfConnections; j++)
+                IsoClientConnection_setExternallyHandled(worker->connections[j].isoClient, false);
+
+            if (worker->connections)
+                GLOBAL_FREEMEM(worker->connections);
+
+            Handleset_destroy(worker->handleSet);
+            Semaphore_destroy(worker->lock);
+        }
+
+        GLOBAL_FREEMEM(self->workers);
+        GLOBAL_FREEMEM(self);
+    }
+}
+
+#else /* (CONFIG_MMS_THREADLESS_STACK == 0) */
+
+IedClientReactor
+IedClientReactor_create(int numberOfThreads)
+{
+    (void)numberOfThreads;
+
+    return NULL;
+}
+
+void
+IedClientReactor_setTickInterval(IedClientReactor self, int intervalInMs)
+{
+    (void)self;
+    (void)intervalInMs;
+}
+
+bool
+IedClientReactor_addConnection(IedClientReactor self, IedConnection connection)
+{
+    (void)self;
+    (void)connection;
+
+    return false;
+}
+
+void
+IedClientReactor_removeConnection(IedClientReactor self, IedConnection connection)
+{
+    (void)self;
+    (void)connection;
+}
+
+void
+IedClientReactor_start(IedClientReactor self)
+{
+    (void)self;
+}
+
+void
+IedClientReactor_stop(IedClientReactor self)
+{
+    (void)self;
+}
+
+void
+IedClientReactor_destroy(IedClientReactor self)
+{
+    (void)self;
+}
+
+#endif /* (CONFIG_MMS_THREADLESS_STACK == 0) */
@@ -28,9 +28,14 @@
 #include "stack_config.h"
 
 #include "ied_connection_private.h"
+#include "mms_value_internal.h"
+#include "ber_decode.h"
 
 #include "libiec61850_platform_includes.h"
 
+/* initial size of the RptID index (has to be a power of two) */
+#define REPORT_INDEX_INITIAL_SIZE 16
+
 struct sClientReport
 {
     ReportCallbackFunction callback;
@@ -38,6 +43,12 @@ struct sClientReport
     char* rcbReference;
     char* rptId;
 
+    /* RptID used to dispatch received reports (configured RptID or default RptID derived from rcbReference) */
+    char* dispatchRptId;
+    int dispatchRptIdSize;
+    uint32_t dispatchRptIdHash;
+    ClientReport nextInIndex; /* next report in the same bucket of the RptID index */
+
     char* dataSetName;
     int dataSetNameSize; /* size of the dataSetName buffer */
 
@@ -109,6 +120,9 @@ ClientReport_destroy(ClientReport self)
     if (self->rptId != NULL)
         GLOBAL_FREEMEM(self->rptId);
 
+    if (self->dispatchRptId != NULL)
+        GLOBAL_FREEMEM(self->dispatchRptId);
+
     if (self->dataSetValues != NULL)
         MmsValue_delete(self->dataSetValues);
 
@@ -283,6 +297,117 @@ lookupReportHandler(IedConnection self, const char* rcbReference)
     return NULL;
 }
 
+static uint32_t
+calculateRptIdHash(const uint8_t* rptId, int size)
+{
+    uint32_t hash = 2166136261u;
+
+    int i;
+
+    for (i = 0; i < size; i++) {
+        hash ^= rptId[i];
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+/* has to be called with reportHandlerMutex */
+static ClientReport
+lookupReportByRptId(IedConnection self, const uint8_t* rptId, int size)
+{
+    if (self->reportIndex == NULL)
+        return NULL;
+
+    uint32_t hash = calculateRptIdHash(rptId, size);
+
+    ClientReport report = self->reportIndex[hash & (self->reportIndexSize - 1)];
+
+    while (report) {
+        if ((report->dispatchRptIdHash == hash) && (report->dispatchRptIdSize == size) &&
+                (memcmp(report->dispatchRptId, rptId, size) == 0))
+            return report;
+
+        report = report->nextInIndex;
+    }
+
+    return NULL;
+}
+
+/* append to the bucket to keep the installation order for reports with the same RptID */
+static void
+insertIntoReportIndex(ClientReport* index, int indexSize, ClientReport report)
+{
+    ClientReport* position = &(index[report->dispatchRptIdHash & (indexSize - 1)]);
+
+    while (*position)
+        position = &((*position)->nextInIndex);
+
+    report->nextInIndex = NULL;
+    *position = report;
+}
+
+/* has to be called with reportHandlerMutex */
+static bool
+addToReportIndex(IedConnection self, ClientReport report)
+{
+    if ((self->reportIndex == NULL) || (self->numberOfIndexedReports >= self->reportIndexSize)) {
+        int newSize = (self->reportIndex == NULL) ? REPORT_INDEX_INITIAL_SIZE : (2 * self->reportIndexSize);
+
+        ClientReport* newIndex = (ClientReport*) GLOBAL_CALLOC(newSize, sizeof(ClientReport));
+
+        if (newIndex) {
+            int i;
+
+            for (i = 0; i < self->reportIndexSize; i++) {
+                ClientReport element = self->reportIndex[i];
+
+                while (element) {
+                    ClientReport next = element->nextInIndex;
+
+                    insertIntoReportIndex(newIndex, newSize, element);
+
+                    element = next;
+                }
+            }
+
+            if (self->reportIndex)
+                GLOBAL_FREEMEM(self->reportIndex);
+
+            self->reportIndex = newIndex;
+            self->reportIndexSize = newSize;
+        }
+        else if (self->reportIndex == NULL)
+            return false;
+    }
+
+    insertIntoReportIndex(self->reportIndex, self->reportIndexSize, report);
+
+    self->numberOfIndexedReports++;
+
+    return true;
+}
+
+/* has to be called with reportHandlerMutex */
+static void
+removeFromReportIndex(IedConnection self, ClientReport report)
+{
+    if (self->reportIndex == NULL)
+        return;
+
+    ClientReport* position = &(self->reportIndex[report->dispatchRptIdHash & (self->reportIndexSize - 1)]);
+
+    while (*position) {
+        if (*position == report) {
+            *position = report->nextInIndex;
+            self->numberOfIndexedReports--;
+            break;
+        }
+
+        position = &((*position)->nextInIndex);
+    }
+}
+
 void
 IedConnection_installReportHandler(IedConnection self, const char* rcbReference, const char* rptId, ReportCallbackFunction handler,
         void* handlerParameter)
@@ -306,8 +431,24 @@ IedConnection_installReportHandler(IedConnection self, const char* rcbReference,
     else
         report->rptId = NULL;
 
+    if ((rptId == NULL) || (strlen(rptId) == 0)) {
+        /* default RptID is the RCB reference in MMS notation */
+        report->dispatchRptId = StringUtils_copyString(rcbReference);
+        StringUtils_replace(report->dispatchRptId, '.', '$');
+    }
+    else
+        report->dispatchRptId = StringUtils_copyString(rptId);
+
+    report->dispatchRptIdSize = strlen(report->dispatchRptId);
+    report->dispatchRptIdHash = calculateRptIdHash((uint8_t*) report->dispatchRptId, report->dispatchRptIdSize);
+
     Semaphore_wait(self->reportHandlerMutex);
-    LinkedList_add(self->enabledReports, report);
+
+    if (addToReportIndex(self, report))
+        LinkedList_add(self->enabledReports, report);
+    else
+        ClientReport_destroy(report);
+
     Semaphore_post(self->reportHandlerMutex);
 
     if (DEBUG_IED_CLIENT)
@@ -322,6 +463,7 @@ IedConnection_uninstallReportHandler(IedConnection self, const char* rcbReferenc
     ClientReport report = lookupReportHandler(self, rcbReference);
 
     if (report != NULL) {
+        removeFromReportIndex(self, report);
         LinkedList_remove(self->enabledReports, report);
         ClientReport_destroy(report);
     }
@@ -364,55 +506,136 @@ IedConnection_triggerGIReport(IedConnection self, IedClientError* error, const c
     }
 }
 
-void
-iedConnection_handleReport(IedConnection self, MmsValue* value)
+static void
+resetReportElements(ClientReport self)
 {
-    MmsValue* rptIdValue = MmsValue_getElement(value, 0);
+    self->hasSequenceNumber = false;
+    self->hasTimestamp = false;
+    self->hasReasonForInclusion = false;
+    self->hasDataReference = false;
+    self->hasConfRev = false;
+    self->hasDataSetName = false;
+    self->hasBufOverflow = false;
+    self->hasSubSequenceNumber = false;
+}
 
-    if ((rptIdValue == NULL) || (MmsValue_getType(rptIdValue) != MMS_VISIBLE_STRING)) {
+static bool
+setDataSetName(ClientReport self, const uint8_t* dataSetName, int dataSetNameSize)
+{
+    /* limit to prevent large memory allocation */
+    if (dataSetNameSize >= 130) {
         if (DEBUG_IED_CLIENT)
-            printf("IED_CLIENT: received malformed report (RptId)\n");
+            printf("IED_CLIENT: report DatSet name too large (%i)\n", dataSetNameSize);
 
-        goto exit_function;
+        return false;
     }
 
-    LinkedList element = LinkedList_getNext(self->enabledReports);
-    ClientReport matchingReport = NULL;
+    if ((self->dataSetName == NULL) || (self->dataSetNameSize < dataSetNameSize + 1)) {
+        if (self->dataSetName)
+            GLOBAL_FREEMEM((void*) self->dataSetName);
 
-    while (element != NULL) {
-        ClientReport report = (ClientReport) element->data;
-        char defaultRptId[130];
-        char* rptId = report->rptId;
+        self->dataSetName = (char*) GLOBAL_MALLOC(dataSetNameSize + 1);
 
-        if ((rptId == NULL) || (strlen(rptId) == 0)) {
-            StringUtils_concatString(defaultRptId, 130, report->rcbReference, "");
-            StringUtils_replace(defaultRptId, '.', '$');
+        if (self->dataSetName == NULL) {
+            self->dataSetNameSize =  0;
 
-            rptId = defaultRptId;
+            if (DEBUG_IED_CLIENT)
+                printf("IED_CLIENT: failed to allocate memory\n");
+
+            return false;
         }
 
-        if (strcmp(MmsValue_toString(rptIdValue), rptId) == 0) {
-            matchingReport = report;
-            break;
+        self->dataSetNameSize = dataSetNameSize + 1;
+    }
+
+    memcpy(self->dataSetName, dataSetName, dataSetNameSize);
+    self->dataSetName[dataSetNameSize] = 0;
+
+    return true;
+}
+
+static void
+setEntryId(ClientReport self, const uint8_t* entryId, int entryIdSize)
+{
+    if ((self->entryId != NULL) && (MmsValue_getOctetStringMaxSize(self->entryId) < entryIdSize)) {
+        MmsValue_delete(self->entryId);
+        self->entryId = NULL;
+    }
+
+    if (self->entryId == NULL)
+        self->entryId = MmsValue_newOctetString(entryIdSize, entryIdSize);
+
+    if (self->entryId)
+        MmsValue_setOctetString(self->entryId, entryId, entryIdSize);
+}
+
+/* returns false when the memory cannot be allocated (a later report can try again) */
+static bool
+allocateDataSetValues(ClientReport self, int dataSetSize)
+{
+    if (self->dataSetValues == NULL)
+        self->dataSetValues = MmsValue_createEmptyArray(dataSetSize);
+
+    if (self->reasonForInclusion == NULL) {
+        self->reasonForInclusion = (ReasonForInclusion*)
+                GLOBAL_MALLOC(sizeof(ReasonForInclusion) * dataSetSize);
+
+        if (self->reasonForInclusion) {
+            int elementIndex;
+
+            for (elementIndex = 0; elementIndex < dataSetSize; elementIndex++)
+                self->reasonForInclusion[elementIndex] = IEC61850_REASON_NOT_INCLUDED;
         }
+    }
 
-        element = LinkedList_getNext(element);
+    return ((self->dataSetValues != NULL) && (self->reasonForInclusion != NULL));
+}
+
+/* reasonBits is the first octet of the ReasonCode bit string */
+static ReasonForInclusion
+decodeReasonForInclusion(uint8_t reasonBits)
+{
+    ReasonForInclusion reasonForInclusion = IEC61850_REASON_NOT_INCLUDED;
+
+    if (reasonBits & 0x40)
+        reasonForInclusion |= (ReasonForInclusion) IEC61850_REASON_DATA_CHANGE;
+    if (reasonBits & 0x20)
+        reasonForInclusion |= IEC61850_REASON_QUALITY_CHANGE;
+    if (reasonBits & 0x10)
+        reasonForInclusion |= IEC61850_REASON_DATA_UPDATE;
+    if (reasonBits & 0x08)
+        reasonForInclusion |= IEC61850_REASON_INTEGRITY;
+    if (reasonBits & 0x04)
+        reasonForInclusion |= IEC61850_REASON_GI;
+
+    return reasonForInclusion;
+}
+
+void
+iedConnection_handleReport(IedConnection self, MmsValue* value)
+{
+    MmsValue* rptIdValue = MmsValue_getElement(value, 0);
+
+    if ((rptIdValue == NULL) || (MmsValue_getType(rptIdValue) != MMS_VISIBLE_STRING)) {
+        if (DEBUG_IED_CLIENT)
+            printf("IED_CLIENT: received malformed report (RptId)\n");
+
+        return;
     }
 
+    Semaphore_wait(self->reportHandlerMutex);
+
+    const char* rptId = MmsValue_toString(rptIdValue);
+
+    ClientReport matchingReport = lookupReportByRptId(self, (uint8_t*) rptId, strlen(rptId));
+
     if (matchingReport == NULL)
         goto exit_function;
 
-    matchingReport->hasSequenceNumber = false;
-    matchingReport->hasTimestamp = false;
-    matchingReport->hasReasonForInclusion = false;
-    matchingReport->hasDataReference = false;
-    matchingReport->hasConfRev = false;
-    matchingReport->hasDataSetName = false;
-    matchingReport->hasBufOverflow = false;
-    matchingReport->hasSubSequenceNumber = false;
+    resetReportElements(matchingReport);
 
    if (DEBUG_IED_CLIENT)
-        printf("IED_CLIENT: received report with ID %s\n", MmsValue_toString(rptIdValue));
+        printf("IED_CLIENT: received report with ID %s\n", rptId);
 
     MmsValue* optFlds = MmsValue_getElement(value, 1);
 
@@ -477,53 +700,10 @@ iedConnection_handleReport(IedConnection self, MmsValue* value)
             goto exit_function;
         }
 
-        int dataSetNameSize = MmsValue_getStringSize(dataSetName);
-
-        /* limit to prevent large memory allocation */
-        if (dataSetNameSize < 130) {
-            const char* dataSetNameStr = MmsValue_toString(dataSetName);
-
-            if (matchingReport->dataSetName == NULL) {
-                matchingReport->dataSetName = (char*) GLOBAL_MALLOC(dataSetNameSize + 1);
-
-                if (matchingReport->dataSetName == NULL) {
-                    matchingReport->dataSetNameSize =  0;
-
-                    if (DEBUG_IED_CLIENT)
-                        printf("IED_CLIENT: failed to allocate memory\n");
-
-                    goto exit_function;
-                }
-
-                matchingReport->dataSetNameSize = dataSetNameSize + 1;
-            }
-            else {
-                if (matchingReport->dataSetNameSize < MmsValue_getStringSize(dataSetName) + 1) {
-                    GLOBAL_FREEMEM((void*) matchingReport->dataSetName);
-
-                    matchingReport->dataSetName = (char*) GLOBAL_MALLOC(dataSetNameSize + 1);
-
-                    if (matchingReport->dataSetName == NULL) {
-                        matchingReport->dataSetNameSize =  0;
-
-                        if (DEBUG_IED_CLIENT)
-                            printf("IED_CLIENT: failed to allocate memory\n");
-
-                        goto exit_function;
-                    }
-
-                    matchingReport->dataSetNameSize = dataSetNameSize + 1;
-                }
-            }
-
-            StringUtils_copyStringMax(matchingReport->dataSetName, dataSetNameSize + 1, dataSetNameStr);
-        }
-        else {
-            if (DEBUG_IED_CLIENT)
-                printf("IED_CLIENT: report DatSet name too large (%i)\n", dataSetNameSize);
+        const char* dataSetNameStr = MmsValue_toString(dataSetName);
 
+        if (setDataSetName(matchingReport, (uint8_t*) dataSetNameStr, strlen(dataSetNameStr)) == false)
             goto exit_function;
-        }
 
         inclusionIndex++;
     }
@@ -559,16 +739,7 @@ iedConnection_handleReport(IedConnection self, MmsValue* value)
             goto exit_function;
         }
 
-        if (matchingReport->entryId != NULL) {
-
-            if (!MmsValue_update(matchingReport->entryId, entryId)) {
-                MmsValue_delete(matchingReport->entryId);
-                matchingReport->entryId = MmsValue_clone(entryId);
-            }
-        }
-        else {
-            matchingReport->entryId = MmsValue_clone(entryId);
-        }
+        setEntryId(matchingReport, MmsValue_getOctetStringBuffer(entryId), MmsValue_getOctetStringSize(entryId));
 
         inclusionIndex++;
     }
@@ -665,6 +836,9 @@ iedConnection_handleReport(IedConnection self, MmsValue* value)
         if (matchingReport->dataReferences == NULL)
             matchingReport->dataReferences = MmsValue_createEmptyArray(dataSetSize);
 
+        if (matchingReport->dataReferences == NULL)
+            goto exit_function;
+
         matchingReport->hasDataReference = true;
 
         int elementIndex;
@@ -695,17 +869,8 @@ iedConnection_handleReport(IedConnection self, MmsValue* value)
 
     int i;
 
-    if (matchingReport->dataSetValues == NULL) {
-        matchingReport->dataSetValues = MmsValue_createEmptyArray(dataSetSize);
-        matchingReport->reasonForInclusion = (ReasonForInclusion*)
-                GLOBAL_MALLOC(sizeof(ReasonForInclusion) * dataSetSize);
-
-        int elementIndex;
-
-        for (elementIndex = 0; elementIndex < dataSetSize; elementIndex++)
-            matchingReport->reasonForInclusion[elementIndex] = IEC61850_REASON_NOT_INCLUDED;
-
-    }
+    if (allocateDataSetValues(matchingReport, dataSetSize) == false)
+        goto exit_function;
 
     MmsValue* dataSetValues = matchingReport->dataSetValues;
 
@@ -746,18 +911,10 @@ iedConnection_handleReport(IedConnection self, MmsValue* value)
                     goto exit_function;
                 }
 
-                matchingReport->reasonForInclusion[i] = IEC61850_REASON_NOT_INCLUDED;
-
-                if (MmsValue_getBitStringBit(reasonForInclusion, 1) == true)
-                    matchingReport->reasonForInclusion[i] |= (ReasonForInclusion) IEC61850_REASON_DATA_CHANGE;
-                if (MmsValue_getBitStringBit(reasonForInclusion, 2) == true)
-                    matchingReport->reasonForInclusion[i] |= IEC61850_REASON_QUALITY_CHANGE;
-                if (MmsValue_getBitStringBit(reasonForInclusion, 3) == true)
-                    matchingReport->reasonForInclusion[i] |= IEC61850_REASON_DATA_UPDATE;
-                if (MmsValue_getBitStringBit(reasonForInclusion, 4) == true)
-                    matchingReport->reasonForInclusion[i] |= IEC61850_REASON_INTEGRITY;
-                if (MmsValue_getBitStringBit(reasonForInclusion, 5) == true)
-                    matchingReport->reasonForInclusion[i] |= IEC61850_REASON_GI;
+                if (MmsValue_getBitStringSize(reasonForInclusion) > 0)
+                    matchingReport->reasonForInclusion[i] = decodeReasonForInclusion(reasonForInclusion->value.bitString.buf[0]);
+                else
+                    matchingReport->reasonForInclusion[i] = IEC61850_REASON_NOT_INCLUDED;
             }
             else {
                 matchingReport->reasonForInclusion[i] = IEC61850_REASON_UNKNOWN;
@@ -770,14 +927,368 @@ iedConnection_handleReport(IedConnection self, MmsValue* value)
         }
     }
 
-    Semaphore_wait(self->reportHandlerMutex);
-    
     if (matchingReport->callback != NULL)
         matchingReport->callback(matchingReport->callbackParameter, matchingReport);
 
+exit_function:
     Semaphore_post(self->reportHandlerMutex);
+}
 
-exit_function:
-    return;
+/* returns the position of the element content or -1 when the element has not the expected tag */
+static int
+decodeReportElement(uint8_t* buffer, int bufPos, int maxBufPos, uint8_t tag, int* length)
+{
+    if ((bufPos >= maxBufPos) || (buffer[bufPos] != tag))
+        return -1;
+
+    return BerDecoder_decodeLength(buffer, length, bufPos + 1, maxBufPos);
 }
 
+/* bitString points to the content of the BER encoded bit string (starting with the padding octet) */
+static bool
+isBitSet(uint8_t* bitString, int length, int bitPos)
+{
+    if (bitPos >= (8 * (length - 1)) - bitString[0])
+        return false;
+
+    return ((bitString[1 + (bitPos / 8)] & (0x80 >> (bitPos % 8))) != 0);
+}
+
+bool
+iedConnection_handleReportMessage(IedConnection self, uint8_t* buffer, int maxBufPos)
+{
+    int length;
+    int bufPos;
+
+    /* unconfirmed-PDU with information report */
+    bufPos = decodeReportElement(buffer, 0, maxBufPos, 0xa3, &length);
+
+    if (bufPos < 0)
+        return false;
+
+    maxBufPos = bufPos + length;
+
+    bufPos = decodeReportElement(buffer, bufPos, maxBufPos, 0xa0, &length);
+
+    if (bufPos < 0)
+        return false;
+
+    maxBufPos = bufPos + length;
+
+    /* variableListName has to be the vmd-specific name "RPT" */
+    bufPos = decodeReportElement(buffer, bufPos, maxBufPos, 0xa1, &length);
+
+    if (bufPos < 0)
+        return false;
+
+    bufPos = decodeReportElement(buffer, bufPos, maxBufPos, 0x80, &length);
+
+    if ((bufPos < 0) || (length != 3) || memcmp(buffer + bufPos, "RPT", 3))
+        return false;
+
+    bufPos += length;
+
+    /* listOfAccessResult */
+    bufPos = decodeReportElement(buffer, bufPos, maxBufPos, 0xa0, &length);
+
+    if (bufPos < 0)
+        return false;
+
+    maxBufPos = bufPos + length;
+
+    bufPos = decodeReportElement(buffer, bufPos, maxBufPos, 0x8a, &length);
+
+    if (bufPos < 0)
+        return false;
+
+    /* when decoding fails the report is passed to the generic decoder that also handles unusual encodings */
+    const char* malformedElement = NULL;
+
+    Semaphore_wait(self->reportHandlerMutex);
+
+    ClientReport matchingReport = lookupReportByRptId(self, buffer + bufPos, length);
+
+    if (matchingReport == NULL)
+        goto exit_function;
+
+    bufPos += length;
+
+    resetReportElements(matchingReport);
+
+    bufPos = decodeReportElement(buffer, bufPos, maxBufPos, 0x84, &length);
+
+    if ((bufPos < 0) || (length < 1)) {
+        malformedElement = "OptFlds";
+        goto exit_function;
+    }
+
+    uint8_t* optFlds = buffer + bufPos;
+    int optFldsLength = length;
+
+    bufPos += length;
+
+    /* has sequence-number */
+    if (isBitSet(optFlds, optFldsLength, 1)) {
+        bufPos = decodeReportElement(buffer, bufPos, maxBufPos, 0x86, &length);
+
+        if ((bufPos < 0) || (length > 5)) {
+            malformedElement = "seqNum";
+            goto exit_function;
+        }
+
+        matchingReport->seqNum = (uint16_t) BerDecoder_decodeUint32(buffer, length, bufPos);
+        matchingReport->hasSequenceNumber = true;
+
+        bufPos += length;
+    }
+
+    /* has report-timestamp */
+    if (isBitSet(optFlds, optFldsLength, 2)) {
+        bufPos = decodeReportElement(buffer, bufPos, maxBufPos, 0x8c, &length);
+
+        if ((bufPos < 0) || ((length != 4) && (length != 6))) {
+            malformedElement = "timeStamp";
+            goto exit_function;
+        }
+
+        MmsValue timeStamp;
+
+        timeStamp.type = MMS_BINARY_TIME;
+        timeStamp.value.binaryTime.size = (uint8_t) length;
+        memcpy(timeStamp.value.binaryTime.buf, buffer + bufPos, length);
+
+        matchingReport->hasTimestamp = true;
+        matchingReport->timestamp = MmsValue_getBinaryTimeAsUtcMs(&timeStamp);
+
+        bufPos += length;
+    }
+
+    /* check if data set name is present */
+    if (isBitSet(optFlds, optFldsLength, 4)) {
+        matchingReport->hasDataSetName = true;
+
+        bufPos = decodeReportElement(buffer, bufPos, maxBufPos, 0x8a, &length);
+
+        if (bufPos < 0) {
+            malformedElement = "DatSet";
+            goto exit_function;
+        }
+
+        if (setDataSetName(matchingReport, buffer + bufPos, length) == false) {
+            malformedElement = "DatSet";
+            goto exit_function;
+        }
+
+        bufPos += length;
+    }
+
+    /* check bufOvfl */
+    if (isBitSet(optFlds, optFldsLength, 6)) {
+        bufPos = decodeReportElement(buffer, bufPos, maxBufPos, 0x83, &length);
+
+        if ((bufPos < 0) || (length != 1)) {
+            malformedElement = "BufOvfl";
+            goto exit_function;
+        }
+
+        matchingReport->hasBufOverflow = true;
+        matchingReport->bufOverflow = BerDecoder_decodeBoolean(buffer, bufPos);
+
+        bufPos += length;
+    }
+
+    /* check for entryId */
+    if (isBitSet(optFlds, optFldsLength, 7)) {
+        bufPos = decodeReportElement(buffer, bufPos, maxBufPos, 0x89, &length);
+
+        if (bufPos < 0) {
+            malformedElement = "entryID";
+            goto exit_function;
+        }
+
+        setEntryId(matchingReport, buffer + bufPos, length);
+
+        bufPos += length;
+    }
+
+    /* check for confRev */
+    if (isBitSet(optFlds, optFldsLength, 8)) {
+        bufPos = decodeReportElement(buffer, bufPos, maxBufPos, 0x86, &length);
+
+        if ((bufPos < 0) || (length > 5)) {
+            malformedElement = "confRev";
+            goto exit_function;
+        }
+
+        matchingReport->confRev = BerDecoder_decodeUint32(buffer, length, bufPos);
+        matchingReport->hasConfRev = true;
+
+        bufPos += length;
+    }
+
+    /* handle segmentation fields (check ReportedOptFlds.segmentation) */
+    if (isBitSet(optFlds, optFldsLength, 9)) {
+        bufPos = decodeReportElement(buffer, bufPos, maxBufPos, 0x86, &length);
+
+        if ((bufPos < 0) || (length > 5)) {
+            malformedElement = "SubSeqNum";
+            goto exit_function;
+        }
+
+        matchingReport->subSeqNum = (uint16_t) BerDecoder_decodeUint32(buffer, length, bufPos);
+
+        bufPos += length;
+
+        bufPos = decodeReportElement(buffer, bufPos, maxBufPos, 0x83, &length);
+
+        if ((bufPos < 0) || (length != 1)) {
+            malformedElement = "MoreSegmentsFollow";
+            goto exit_function;
+        }
+
+        matchingReport->moreSegementsFollow = BerDecoder_decodeBoolean(buffer, bufPos);
+
+        bufPos += length;
+
+        matchingReport->hasSequenceNumber = true;
+    }
+    else {
+        matchingReport->subSeqNum = 0;
+        matchingReport->moreSegementsFollow = false;
+    }
+
+    bufPos = decodeReportElement(buffer, bufPos, maxBufPos, 0x84, &length);
+
+    if ((bufPos < 0) || (length < 1) || (buffer[bufPos] > 7)) {
+        malformedElement = "inclusion";
+        goto exit_function;
+    }
+
+    uint8_t* inclusion = buffer + bufPos;
+    int inclusionLength = length;
+
+    bufPos += length;
+
+    int dataSetSize = (8 * (inclusionLength - 1)) - inclusion[0];
+
+    if (matchingReport->dataSetSize == -1) {
+        matchingReport->dataSetSize = dataSetSize;
+    }
+    else {
+        if (dataSetSize != matchingReport->dataSetSize) {
+            malformedElement = "inclusion has no plausible size";
+            goto exit_function;
+        }
+    }
+
+    int i;
+
+    /* parse data-references if required */
+    if (isBitSet(optFlds, optFldsLength, 5)) {
+
+        if (matchingReport->dataReferences == NULL)
+            matchingReport->dataReferences = MmsValue_createEmptyArray(dataSetSize);
+
+        if (matchingReport->dataReferences == NULL) {
+            malformedElement = "data references (out of memory)";
+            goto exit_function;
+        }
+
+        matchingReport->hasDataReference = true;
+
+        for (i = 0; i < dataSetSize; i++) {
+            if (isBitSet(inclusion, inclusionLength, i)) {
+                bufPos = decodeReportElement(buffer, bufPos, maxBufPos, 0x8a, &length);
+
+                if (bufPos < 0) {
+                    malformedElement = "data reference";
+                    goto exit_function;
+                }
+
+                if (MmsValue_getElement(matchingReport->dataReferences, i) == NULL)
+                    MmsValue_setElement(matchingReport->dataReferences, i,
+                            MmsValue_newVisibleStringFromByteArray(buffer + bufPos, length));
+
+                bufPos += length;
+            }
+        }
+    }
+
+    if (allocateDataSetValues(matchingReport, dataSetSize) == false) {
+        malformedElement = "data set values (out of memory)";
+        goto exit_function;
+    }
+
+    MmsValue* dataSetValues = matchingReport->dataSetValues;
+
+    bool hasReasonForInclusion = isBitSet(optFlds, optFldsLength, 3);
+
+    /* decode the values into the existing data set values - only new or changed types require a new value */
+    for (i = 0; i < dataSetSize; i++) {
+        if (isBitSet(inclusion, inclusionLength, i)) {
+            MmsValue* dataSetElement = MmsValue_getElement(dataSetValues, i);
+
+            int endBufPos;
+
+            if ((dataSetElement == NULL) ||
+                    (MmsValue_updateFromMmsData(dataSetElement, buffer, bufPos, maxBufPos, &endBufPos) == false))
+            {
+                MmsValue* newElementValue = MmsValue_decodeMmsData(buffer, bufPos, maxBufPos, &endBufPos);
+
+                if (newElementValue == NULL) {
+                    malformedElement = "data set value";
+                    goto exit_function;
+                }
+
+                if (dataSetElement)
+                    MmsValue_delete(dataSetElement);
+
+                MmsValue_setElement(dataSetValues, i, newElementValue);
+            }
+
+            bufPos = endBufPos;
+
+            matchingReport->reasonForInclusion[i] = IEC61850_REASON_UNKNOWN;
+        }
+        else {
+            matchingReport->reasonForInclusion[i] = IEC61850_REASON_NOT_INCLUDED;
+        }
+    }
+
+    if (hasReasonForInclusion) {
+        matchingReport->hasReasonForInclusion = true;
+
+        for (i = 0; i < dataSetSize; i++) {
+            if (isBitSet(inclusion, inclusionLength, i)) {
+                bufPos = decodeReportElement(buffer, bufPos, maxBufPos, 0x84, &length);
+
+                if (bufPos < 0) {
+                    malformedElement = "reason-for-inclusion";
+                    goto exit_function;
+                }
+
+                if (length > 1)
+                    matchingReport->reasonForInclusion[i] = decodeReasonForInclusion(buffer[bufPos + 1]);
+                else
+                    matchingReport->reasonForInclusion[i] = IEC61850_REASON_NOT_INCLUDED;
+
+                bufPos += length;
+            }
+        }
+    }
+
+    if (matchingReport->callback != NULL)
+        matchingReport->callback(matchingReport->callbackParameter, matchingReport);
+
+exit_function:
+    Semaphore_post(self->reportHandlerMutex);
+
+    if (malformedElement) {
+        if (DEBUG_IED_CLIENT)
+            printf("IED_CLIENT: failed to decode report (%s) -> use generic decoder\n", malformedElement);
+
+        return false;
+    }
+
+    return true;
+}
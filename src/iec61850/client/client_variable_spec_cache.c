@@ -0,0 +1,412 @@
+/*
+ *  client_variable_spec_cache.c
+ *
+ *  Cache of MMS variable specifications of a client connection
+ *
+ *  This file is part of libIEC61850.
+ *
+ *  libIEC61850 is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  libIEC61850 is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with libIEC61850.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+#include "libiec61850_platform_includes.h"
+
+#include "iec61850_client.h"
+
+#include "ied_connection_private.h"
+
+#define VAR_SPEC_CACHE_INITIAL_SIZE 64
+#define VAR_SPEC_CACHE_VALUE_POOL_SIZE 8
+
+typedef struct sICVariableSpecCacheEntry* ICVariableSpecCacheEntry;
+
+struct sICVariableSpecCacheEntry
+{
+    uint32_t hash;
+    char* domainId;
+    char* itemId;
+    int itemIdLength;
+    MmsVariableSpecification* typeSpec;
+    ICVariableSpecCacheEntry next;
+};
+
+struct sICPooledValue
+{
+    MmsVariableSpecification* typeSpec;
+    MmsValue* value;
+};
+
+struct sICVariableSpecCache
+{
+    ICVariableSpecCacheEntry* buckets; /* number of buckets is a power of two */
+    int size;
+    int numberOfEntries;
+
+    /* changed when cached specifications are replaced or removed */
+    uint32_t generation;
+
+    /* values for decoding read responses - reused by the typed read functions */
+    struct sICPooledValue valuePool[VAR_SPEC_CACHE_VALUE_POOL_SIZE];
+    int nextPoolSlot;
+};
+
+static uint32_t
+calculateHash(const char* domainId, const char* itemId, int itemIdLength)
+{
+    uint32_t hash = 2166136261u;
+
+    if (domainId) {
+        while (*domainId) {
+            hash ^= (uint8_t) *domainId++;
+            hash *= 16777619u;
+        }
+    }
+
+    hash ^= (uint8_t) '/';
+    hash *= 16777619u;
+
+    int i;
+
+    for (i = 0; i < itemIdLength; i++) {
+        hash ^= (uint8_t) itemId[i];
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+static bool
+isMatchingDomain(const char* entryDomainId, const char* domainId)
+{
+    if ((entryDomainId == NULL) || (domainId == NULL))
+        return (entryDomainId == domainId);
+
+    return (strcmp(entryDomainId, domainId) == 0);
+}
+
+static ICVariableSpecCacheEntry*
+findEntry(ICVariableSpecCache self, uint32_t hash, const char* domainId, const char* itemId, int itemIdLength)
+{
+    ICVariableSpecCacheEntry* position = &(self->buckets[hash & (self->size - 1)]);
+
+    while (*position) {
+        ICVariableSpecCacheEntry entry = *position;
+
+        if ((entry->hash == hash) && (entry->itemIdLength == itemIdLength) &&
+                (memcmp(entry->itemId, itemId, itemIdLength) == 0) && isMatchingDomain(entry->domainId, domainId))
+            return position;
+
+        position = &(entry->next);
+    }
+
+    return NULL;
+}
+
+static void
+destroyEntry(ICVariableSpecCacheEntry entry)
+{
+    if (entry->domainId)
+        GLOBAL_FREEMEM(entry->domainId);
+
+    GLOBAL_FREEMEM(entry->itemId);
+    MmsVariableSpecification_destroy(entry->typeSpec);
+    GLOBAL_FREEMEM(entry);
+}
+
+/* pooled values can refer to removed specifications */
+static void
+invalidateValuePool(ICVariableSpecCache self)
+{
+    int i;
+
+    for (i = 0; i < VAR_SPEC_CACHE_VALUE_POOL_SIZE; i++) {
+        if (self->valuePool[i].value) {
+            MmsValue_delete(self->valuePool[i].value);
+            self->valuePool[i].value = NULL;
+        }
+
+        self->valuePool[i].typeSpec = NULL;
+    }
+
+    self->generation++;
+}
+
+static bool
+resize(ICVariableSpecCache self, int newSize)
+{
+    ICVariableSpecCacheEntry* newBuckets = (ICVariableSpecCacheEntry*) GLOBAL_CALLOC(newSize, sizeof(ICVariableSpecCacheEntry));
+
+    if (newBuckets == NULL)
+        return false;
+
+    int i;
+
+    for (i = 0; i < self->size; i++) {
+        ICVariableSpecCacheEntry entry = self->buckets[i];
+
+        while (entry) {
+            ICVariableSpecCacheEntry next = entry->next;
+
+            entry->next = newBuckets[entry->hash & (newSize - 1)];
+            newBuckets[entry->hash & (newSize - 1)] = entry;
+
+            entry = next;
+        }
+    }
+
+    GLOBAL_FREEMEM(self->buckets);
+
+    self->buckets = newBuckets;
+    self->size = newSize;
+
+    return true;
+}
+
+ICVariableSpecCache
+ICVariableSpecCache_create()
+{
+    ICVariableSpecCache self = (ICVariableSpecCache) GLOBAL_CALLOC(1, sizeof(struct sICVariableSpecCache));
+
+    if (self) {
+        self->buckets = (ICVariableSpecCacheEntry*) GLOBAL_CALLOC(VAR_SPEC_CACHE_INITIAL_SIZE, sizeof(ICVariableSpecCacheEntry));
+
+        if (self->buckets == NULL) {
+            GLOBAL_FREEMEM(self);
+            return NULL;
+        }
+
+        self->size = VAR_SPEC_CACHE_INITIAL_SIZE;
+    }
+
+    return self;
+}
+
+void
+ICVariableSpecCache_clear(ICVariableSpecCache self)
+{
+    int i;
+
+    for (i = 0; i < self->size; i++) {
+        ICVariableSpecCacheEntry entry = self->buckets[i];
+
+        while (entry) {
+            ICVariableSpecCacheEntry next = entry->next;
+
+            destroyEntry(entry);
+
+            entry = next;
+        }
+
+        self->buckets[i] = NULL;
+    }
+
+    self->numberOfEntries = 0;
+
+    invalidateValuePool(self);
+}
+
+void
+ICVariableSpecCache_destroy(ICVariableSpecCache self)
+{
+    if (self) {
+        ICVariableSpecCache_clear(self);
+
+        GLOBAL_FREEMEM(self->buckets);
+        GLOBAL_FREEMEM(self);
+    }
+}
+
+bool
+ICVariableSpecCache_add(ICVariableSpecCache self, const char* domainId, const char* itemId, MmsVariableSpecification* typeSpec)
+{
+    int itemIdLength = strlen(itemId);
+
+    uint32_t hash = calculateHash(domainId, itemId, itemIdLength);
+
+    ICVariableSpecCacheEntry* position = findEntry(self, hash, domainId, itemId, itemIdLength);
+
+    if (position) {
+        /* replace the existing specification */
+        invalidateValuePool(self);
+
+        MmsVariableSpecification_destroy((*position)->typeSpec);
+        (*position)->typeSpec = typeSpec;
+
+        return true;
+    }
+
+    if (self->numberOfEntries >= self->size)
+        resize(self, 2 * self->size);
+
+    ICVariableSpecCacheEntry entry = (ICVariableSpecCacheEntry) GLOBAL_CALLOC(1, sizeof(struct sICVariableSpecCacheEntry));
+
+    if (entry == NULL)
+        goto exit_error;
+
+    entry->itemId = StringUtils_copyString(itemId);
+
+    if (entry->itemId == NULL)
+        goto exit_error;
+
+    if (domainId) {
+        entry->domainId = StringUtils_copyString(domainId);
+
+        if (entry->domainId == NULL)
+            goto exit_error;
+    }
+
+    entry->hash = hash;
+    entry->itemIdLength = itemIdLength;
+    entry->typeSpec = typeSpec;
+
+    entry->next = self->buckets[hash & (self->size - 1)];
+    self->buckets[hash & (self->size - 1)] = entry;
+
+    self->numberOfEntries++;
+
+    return true;
+
+exit_error:
+    if (entry) {
+        if (entry->itemId)
+            GLOBAL_FREEMEM(entry->itemId);
+
+        GLOBAL_FREEMEM(entry);
+    }
+
+    MmsVariableSpecification_destroy(typeSpec);
+
+    return false;
+}
+
+/* find the entry of the variable or of the closest parent variable (e.g. "GGIO1$MX$AnIn1" or "GGIO1$MX" or
+ * "GGIO1" for "GGIO1$MX$AnIn1$mag") */
+static ICVariableSpecCacheEntry*
+findEntryForVariable(ICVariableSpecCache self, const char* domainId, const char* itemId, int* matchingLength)
+{
+    int itemIdLength = strlen(itemId);
+
+    while (itemIdLength > 0) {
+        ICVariableSpecCacheEntry* position = findEntry(self, calculateHash(domainId, itemId, itemIdLength),
+                domainId, itemId, itemIdLength);
+
+        if (position) {
+            *matchingLength = itemIdLength;
+            return position;
+        }
+
+        do {
+            itemIdLength--;
+        } while ((itemIdLength > 0) && (itemId[itemIdLength] != '$'));
+    }
+
+    return NULL;
+}
+
+void
+ICVariableSpecCache_remove(ICVariableSpecCache self, const char* domainId, const char* itemId)
+{
+    int matchingLength;
+
+    ICVariableSpecCacheEntry* position = findEntryForVariable(self, domainId, itemId, &matchingLength);
+
+    if (position) {
+        ICVariableSpecCacheEntry entry = *position;
+
+        *position = entry->next;
+
+        invalidateValuePool(self);
+
+        destroyEntry(entry);
+
+        self->numberOfEntries--;
+    }
+}
+
+MmsVariableSpecification*
+ICVariableSpecCache_lookup(ICVariableSpecCache self, const char* domainId, const char* itemId)
+{
+    int matchingLength;
+
+    ICVariableSpecCacheEntry* position = findEntryForVariable(self, domainId, itemId, &matchingLength);
+
+    if (position == NULL)
+        return NULL;
+
+    MmsVariableSpecification* typeSpec = (*position)->typeSpec;
+
+    if (itemId[matchingLength] == 0)
+        return typeSpec;
+    else if (typeSpec->type == MMS_STRUCTURE)
+        return MmsVariableSpecification_getNamedVariableRecursive(typeSpec, itemId + matchingLength + 1);
+    else
+        return NULL;
+}
+
+MmsValue*
+ICVariableSpecCache_getValue(ICVariableSpecCache self, const char* domainId, const char* itemId, ICCachedValueKey* key)
+{
+    MmsVariableSpecification* typeSpec = ICVariableSpecCache_lookup(self, domainId, itemId);
+
+    if (typeSpec == NULL)
+        return NULL;
+
+    key->typeSpec = typeSpec;
+    key->generation = self->generation;
+
+    int i;
+
+    for (i = 0; i < VAR_SPEC_CACHE_VALUE_POOL_SIZE; i++) {
+        if ((self->valuePool[i].typeSpec == typeSpec) && self->valuePool[i].value) {
+            MmsValue* value = self->valuePool[i].value;
+
+            self->valuePool[i].value = NULL;
+
+            return value;
+        }
+    }
+
+    return MmsValue_newDefaultValue(typeSpec);
+}
+
+void
+ICVariableSpecCache_releaseValue(ICVariableSpecCache self, ICCachedValueKey* key, MmsValue* value)
+{
+    if (key->generation != self->generation) {
+        MmsValue_delete(value);
+        return;
+    }
+
+    int i;
+
+    for (i = 0; i < VAR_SPEC_CACHE_VALUE_POOL_SIZE; i++) {
+        if (self->valuePool[i].value == NULL) {
+            self->valuePool[i].typeSpec = key->typeSpec;
+            self->valuePool[i].value = value;
+
+            return;
+        }
+    }
+
+    /* replace the values in round-robin order when the pool is full */
+    struct sICPooledValue* slot = &(self->valuePool[self->nextPoolSlot]);
+
+    MmsValue_delete(slot->value);
+
+    slot->typeSpec = key->typeSpec;
+    slot->value = value;
+
+    self->nextPoolSlot = (self->nextPoolSlot + 1) % VAR_SPEC_CACHE_VALUE_POOL_SIZE;
+}
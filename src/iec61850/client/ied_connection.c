@@ -27,6 +27,7 @@
 #include "iec61850_client.h"
 
 #include "mms_client_connection.h"
+#include "mms_client_internal.h"
 
 #include "ied_connection_private.h"
 #include "mms_value_internal.h"
@@ -35,11 +36,8 @@
 #define DATA_SET_MAX_NAME_LENGTH 64 /* is 32 according to standard! */
 #define OUTSTANDING_CALLS 12
 
-typedef struct sICLogicalDevice
-{
-    char* name;
-    LinkedList variables;
-} ICLogicalDevice;
+/* additional call slots for internal requests besides the MMS request window */
+#define ADDITIONAL_OUTSTANDING_CALLS 2
 
 struct sClientDataSet
 {
@@ -174,7 +172,7 @@ iedConnection_allocateOutstandingCall(IedConnection self)
 
     int i = 0;
 
-    for (i = 0; i < OUTSTANDING_CALLS; i++) {
+    for (i = 0; i < self->numberOfOutstandingCalls; i++) {
         if (self->outstandingCalls[i].used == false) {
             self->outstandingCalls[i].used = true;
             call = &(self->outstandingCalls[i]);
@@ -206,7 +204,7 @@ iedConnection_lookupOutstandingCall(IedConnection self, uint32_t invokeId)
 
     int i = 0;
 
-    for (i = 0; i < OUTSTANDING_CALLS; i++) {
+    for (i = 0; i < self->numberOfOutstandingCalls; i++) {
         if ((self->outstandingCalls[i].used) && (self->outstandingCalls[i].invokeId == invokeId)) {
             call = &(self->outstandingCalls[i]);
             break;
@@ -218,8 +216,8 @@ iedConnection_lookupOutstandingCall(IedConnection self, uint32_t invokeId)
     return call;
 }
 
-static ICLogicalDevice*
-ICLogicalDevice_create(char* name)
+ICLogicalDevice*
+ICLogicalDevice_create(const char* name)
 {
     ICLogicalDevice* self = (ICLogicalDevice*) GLOBAL_CALLOC(1, sizeof(struct sICLogicalDevice));
 
@@ -228,13 +226,13 @@ ICLogicalDevice_create(char* name)
     return self;
 }
 
-static void
+void
 ICLogicalDevice_setVariableList(ICLogicalDevice* self, LinkedList variables)
 {
     self->variables = variables;
 }
 
-static void
+void
 ICLogicalDevice_destroy(ICLogicalDevice* self)
 {
     GLOBAL_FREEMEM(self->name);
@@ -496,6 +494,14 @@ handleLastApplErrorMessage(IedConnection self, MmsValue* lastApplError)
     Semaphore_post(self->clientControlsLock);
 }
 
+static bool
+rawInformationReportHandler(void* parameter, uint8_t* buffer, int size)
+{
+    IedConnection self = (IedConnection) parameter;
+
+    return iedConnection_handleReportMessage(self, buffer, size);
+}
+
 static void
 informationReportHandler(void* parameter, char* domainName,
         char* variableListName, MmsValue* value, bool isVariableListName)
@@ -573,6 +579,15 @@ mmsConnectionStateChangedHandler(MmsConnection connection, void* parameter, MmsC
     IedConnection self = (IedConnection) parameter;
 
     if (newState == MMS_CONNECTION_STATE_CONNECTED) {
+
+        /* the variable types can be different after the new association */
+        Semaphore_wait(self->varSpecCacheLock);
+
+        if (self->varSpecCache)
+            ICVariableSpecCache_clear(self->varSpecCache);
+
+        Semaphore_post(self->varSpecCacheLock);
+
         IedConnection_setState(self, IED_STATE_CONNECTED);
     }
     else if (newState == MMS_CONNECTION_STATE_CLOSED) {
@@ -602,7 +617,7 @@ createNewConnectionObject(TLSConfiguration tlsConfig, bool useThreads)
         self->logicalDevices = NULL;
         self->clientControlsLock = Semaphore_create(1);
         self->clientControls = LinkedList_create();
-
+        self->varSpecCacheLock = Semaphore_create(1);
 
         if (useThreads)
             self->connection = MmsConnection_createSecure(tlsConfig);
@@ -615,11 +630,13 @@ createNewConnectionObject(TLSConfiguration tlsConfig, bool useThreads)
         self->reportHandlerMutex = Semaphore_create(1);
 
         self->outstandingCallsLock = Semaphore_create(1);
+        self->numberOfOutstandingCalls = OUTSTANDING_CALLS;
         self->outstandingCalls = (IedConnectionOutstandingCall) GLOBAL_CALLOC(OUTSTANDING_CALLS, sizeof(struct sIedConnectionOutstandingCall));
 
         self->connectionTimeout = DEFAULT_CONNECTION_TIMEOUT;
 
         MmsConnection_setInformationReportHandler(self->connection, informationReportHandler, self);
+        mmsClient_setRawInformationReportHandler(self->connection, rawInformationReportHandler, self);
 
         MmsConnection_setConnectionStateChangedHandler(self->connection, mmsConnectionStateChangedHandler, self);
     }
@@ -684,6 +701,46 @@ IedConnection_getRequestTimeout(IedConnection self)
         return 0;
 }
 
+bool
+IedConnection_setMaxOutstandingCalls(IedConnection self, int maxOutstandingCalls)
+{
+    bool success = false;
+
+    Semaphore_wait(self->outstandingCallsLock);
+
+    int i;
+
+    for (i = 0; i < self->numberOfOutstandingCalls; i++) {
+        if (self->outstandingCalls[i].used)
+            goto exit_function;
+    }
+
+    if (MmsConnection_setMaxOutstandingCalls(self->connection, maxOutstandingCalls)) {
+
+        int numberOfOutstandingCalls = maxOutstandingCalls + ADDITIONAL_OUTSTANDING_CALLS;
+
+        if (numberOfOutstandingCalls != self->numberOfOutstandingCalls) {
+            IedConnectionOutstandingCall outstandingCalls = (IedConnectionOutstandingCall)
+                    GLOBAL_CALLOC(numberOfOutstandingCalls, sizeof(struct sIedConnectionOutstandingCall));
+
+            if (outstandingCalls == NULL)
+                goto exit_function;
+
+            GLOBAL_FREEMEM(self->outstandingCalls);
+
+            self->outstandingCalls = outstandingCalls;
+            self->numberOfOutstandingCalls = numberOfOutstandingCalls;
+        }
+
+        success = true;
+    }
+
+exit_function:
+    Semaphore_post(self->outstandingCallsLock);
+
+    return success;
+}
+
 void
 IedConnection_setTimeQuality(IedConnection self, bool leapSecondKnown, bool clockFailure, bool clockNotSynchronized, int subsecondPrecision)
 {
@@ -850,11 +907,18 @@ IedConnection_destroy(IedConnection self)
     if (self->enabledReports != NULL)
         LinkedList_destroyDeep(self->enabledReports, (LinkedListValueDeleteFunction) ClientReport_destroy);
 
+    if (self->reportIndex != NULL)
+        GLOBAL_FREEMEM(self->reportIndex);
+
+    if (self->varSpecCache != NULL)
+        ICVariableSpecCache_destroy(self->varSpecCache);
+
     GLOBAL_FREEMEM(self->outstandingCalls);
 
     LinkedList_destroyStatic(self->clientControls);
 
     Semaphore_destroy(self->clientControlsLock);
+    Semaphore_destroy(self->varSpecCacheLock);
     Semaphore_destroy(self->outstandingCallsLock);
     Semaphore_destroy(self->stateMutex);
     Semaphore_destroy(self->reportHandlerMutex);
@@ -907,11 +971,45 @@ IedConnection_getVariableSpecification(IedConnection self, IedClientError* error
         goto cleanup_and_exit;
     }
 
+    if (self->varSpecCache) {
+        Semaphore_wait(self->varSpecCacheLock);
+
+        if (self->varSpecCache) {
+            MmsVariableSpecification* cachedSpec = ICVariableSpecCache_lookup(self->varSpecCache, domainId, itemId);
+
+            if (cachedSpec)
+                varSpec = MmsVariableSpecification_clone(cachedSpec);
+        }
+
+        Semaphore_post(self->varSpecCacheLock);
+
+        if (varSpec) {
+            *error = IED_ERROR_OK;
+            goto cleanup_and_exit;
+        }
+    }
+
     varSpec =
             MmsConnection_getVariableAccessAttributes(self->connection, &mmsError, domainId, itemId);
 
-    if (varSpec != NULL)
+    if (varSpec != NULL) {
         *error = IED_ERROR_OK;
+
+        if (self->varSpecCache) {
+            MmsVariableSpecification* cachedSpec = MmsVariableSpecification_clone(varSpec);
+
+            if (cachedSpec) {
+                Semaphore_wait(self->varSpecCacheLock);
+
+                if (self->varSpecCache)
+                    ICVariableSpecCache_add(self->varSpecCache, domainId, itemId, cachedSpec);
+                else
+                    MmsVariableSpecification_destroy(cachedSpec);
+
+                Semaphore_post(self->varSpecCacheLock);
+            }
+        }
+    }
     else
         *error = iedConnection_mapMmsErrorToIedError(mmsError);
 
@@ -920,6 +1018,90 @@ cleanup_and_exit:
     return varSpec;
 }
 
+void
+IedConnection_enableVariableSpecificationCache(IedConnection self, bool enable)
+{
+    Semaphore_wait(self->varSpecCacheLock);
+
+    if (enable) {
+        if (self->varSpecCache == NULL)
+            self->varSpecCache = ICVariableSpecCache_create();
+    }
+    else {
+        if (self->varSpecCache) {
+            ICVariableSpecCache_destroy(self->varSpecCache);
+            self->varSpecCache = NULL;
+        }
+    }
+
+    Semaphore_post(self->varSpecCacheLock);
+}
+
+void
+IedConnection_clearVariableSpecificationCache(IedConnection self)
+{
+    Semaphore_wait(self->varSpecCacheLock);
+
+    if (self->varSpecCache)
+        ICVariableSpecCache_clear(self->varSpecCache);
+
+    Semaphore_post(self->varSpecCacheLock);
+}
+
+int
+IedConnection_cacheVariableSpecifications(IedConnection self, IedClientError* error, const char* ldName)
+{
+    int numberOfCachedNodes = 0;
+
+    IedConnection_enableVariableSpecificationCache(self, true);
+
+    MmsError mmsError = MMS_ERROR_NONE;
+
+    LinkedList variables = MmsConnection_getDomainVariableNames(self->connection, &mmsError, ldName);
+
+    if (variables == NULL) {
+        *error = iedConnection_mapMmsErrorToIedError(mmsError);
+        return 0;
+    }
+
+    *error = IED_ERROR_OK;
+
+    LinkedList element = LinkedList_getNext(variables);
+
+    while (element) {
+        char* variableName = (char*) element->data;
+
+        /* logical nodes only - the specifications of the components are part of the logical node specification */
+        if (strchr(variableName, '$') == NULL) {
+
+            MmsVariableSpecification* varSpec =
+                    MmsConnection_getVariableAccessAttributes(self->connection, &mmsError, ldName, variableName);
+
+            if (varSpec == NULL) {
+                *error = iedConnection_mapMmsErrorToIedError(mmsError);
+                break;
+            }
+
+            Semaphore_wait(self->varSpecCacheLock);
+
+            if (self->varSpecCache) {
+                if (ICVariableSpecCache_add(self->varSpecCache, ldName, variableName, varSpec))
+                    numberOfCachedNodes++;
+            }
+            else
+                MmsVariableSpecification_destroy(varSpec);
+
+            Semaphore_post(self->varSpecCacheLock);
+        }
+
+        element = LinkedList_getNext(element);
+    }
+
+    LinkedList_destroy(variables);
+
+    return numberOfCachedNodes;
+}
+
 static void
 getAccessAttrHandler(uint32_t invokeId, void* parameter, MmsError err, MmsVariableSpecification* typeSpec)
 {
@@ -1200,9 +1382,102 @@ IedConnection_readObjectAsync(IedConnection self, IedClientError* error, const c
 }
 
 
-MmsValue*
-IedConnection_readObject(IedConnection self, IedClientError* error, const char* objectReference,
-        FunctionalConstraint fc)
+static void
+releaseCachedValue(IedConnection self, ICCachedValueKey* key, MmsValue* value)
+{
+    Semaphore_wait(self->varSpecCacheLock);
+
+    if (self->varSpecCache)
+        ICVariableSpecCache_releaseValue(self->varSpecCache, key, value);
+    else
+        MmsValue_delete(value);
+
+    Semaphore_post(self->varSpecCacheLock);
+}
+
+/*
+ * read a variable with a cached type - returns NULL and no error when the generic read has to be used.
+ *
+ * When key is not NULL the caller gives the value back with releaseReadValue. Otherwise the value is
+ * owned by the caller.
+ */
+static MmsValue*
+readCachedType(IedConnection self, MmsError* mmsError, const char* domainId, const char* itemId, ICCachedValueKey* key)
+{
+    MmsClientReadIntoTarget target;
+    ICCachedValueKey valueKey;
+
+    target.value = NULL;
+
+    Semaphore_wait(self->varSpecCacheLock);
+
+    if (self->varSpecCache)
+        target.value = ICVariableSpecCache_getValue(self->varSpecCache, domainId, itemId, &valueKey);
+
+    Semaphore_post(self->varSpecCacheLock);
+
+    if (target.value == NULL)
+        return NULL;
+
+    /* the response is decoded by the typed decoder directly into the value */
+    mmsClient_readVariableIntoTarget(self->connection, mmsError, domainId, itemId, &target);
+
+    if (*mmsError == MMS_ERROR_NONE) {
+        if (key)
+            *key = valueKey;
+
+        return target.value;
+    }
+
+    if (target.dataAccessError != -1) {
+        /* return the access error as MMS_DATA_ACCESS_ERROR value like the generic read */
+        MmsDataAccessError dataAccessError = DATA_ACCESS_ERROR_UNKNOWN;
+
+        if (target.dataAccessError < 12)
+            dataAccessError = (MmsDataAccessError) target.dataAccessError;
+
+        releaseCachedValue(self, &valueKey, target.value);
+
+        *mmsError = MMS_ERROR_NONE;
+
+        return MmsValue_newDataAccessError(dataAccessError);
+    }
+
+    if (*mmsError == MMS_ERROR_DEFINITION_TYPE_INCONSISTENT) {
+        /* the response doesn't match the cached type -> the cached type is outdated */
+        MmsValue_delete(target.value);
+
+        Semaphore_wait(self->varSpecCacheLock);
+
+        if (self->varSpecCache)
+            ICVariableSpecCache_remove(self->varSpecCache, domainId, itemId);
+
+        Semaphore_post(self->varSpecCacheLock);
+
+        /* use the generic read */
+        *mmsError = MMS_ERROR_NONE;
+
+        return NULL;
+    }
+
+    releaseCachedValue(self, &valueKey, target.value);
+
+    return NULL;
+}
+
+/* give a value from readObjectInternal back - values of a cached type are reused by later reads */
+static void
+releaseReadValue(IedConnection self, ICCachedValueKey* key, MmsValue* value)
+{
+    if (key->typeSpec)
+        releaseCachedValue(self, key, value);
+    else
+        MmsValue_delete(value);
+}
+
+static MmsValue*
+readObjectInternal(IedConnection self, IedClientError* error, const char* objectReference,
+        FunctionalConstraint fc, ICCachedValueKey* key)
 {
     char domainIdBuffer[65];
     char itemIdBuffer[65];
@@ -1211,6 +1486,9 @@ IedConnection_readObject(IedConnection self, IedClientError* error, const char*
     char* domainId;
     char* itemId;
 
+    if (key)
+        key->typeSpec = NULL;
+
     domainId = MmsMapping_getMmsDomainFromObjectReference(objectReference, domainIdBuffer);
     itemId = MmsMapping_createMmsVariableNameFromObjectReference(objectReference, fc, itemIdBuffer);
 
@@ -1248,8 +1526,13 @@ IedConnection_readObject(IedConnection self, IedClientError* error, const char*
         else
             *error = IED_ERROR_USER_PROVIDED_INVALID_ARGUMENT;
     }
-    else
-        value = MmsConnection_readVariable(self->connection, &mmsError, domainId, itemId);
+    else {
+        if (self->varSpecCache)
+            value = readCachedType(self, &mmsError, domainId, itemId, key);
+
+        if ((value == NULL) && (mmsError == MMS_ERROR_NONE))
+            value = MmsConnection_readVariable(self->connection, &mmsError, domainId, itemId);
+    }
 
     if (value != NULL)
         *error = IED_ERROR_OK;
@@ -1259,10 +1542,125 @@ IedConnection_readObject(IedConnection self, IedClientError* error, const char*
     return value;
 }
 
+MmsValue*
+IedConnection_readObject(IedConnection self, IedClientError* error, const char* objectReference,
+        FunctionalConstraint fc)
+{
+    return readObjectInternal(self, error, objectReference, fc, NULL);
+}
+
+static void
+readObjectIntoHandlerInternal(uint32_t invokeId, void* parameter, MmsError err, bool success)
+{
+    (void)success;
+
+    IedConnection self = (IedConnection) parameter;
+
+    IedConnectionOutstandingCall call = iedConnection_lookupOutstandingCall(self, invokeId);
+
+    if (call) {
+
+        IedConnection_GenericServiceHandler handler =  (IedConnection_GenericServiceHandler) call->callback;
+
+        handler(invokeId, call->callbackParameter, iedConnection_mapMmsErrorToIedError(err));
+
+        iedConnection_releaseOutstandingCall(self, call);
+    }
+    else {
+        if (DEBUG_IED_CLIENT)
+            printf("IED_CLIENT: internal error - no matching outstanding call!\n");
+    }
+}
+
+uint32_t
+IedConnection_readObjectIntoAsync(IedConnection self, IedClientError* error, const char* objectReference,
+        FunctionalConstraint fc, MmsValue* value, IedConnection_GenericServiceHandler handler, void* parameter)
+{
+    *error = IED_ERROR_OK;
+
+    char domainIdBuffer[65];
+    char itemIdBuffer[65];
+
+    char* domainId;
+    char* itemId;
+
+    domainId = MmsMapping_getMmsDomainFromObjectReference(objectReference, domainIdBuffer);
+    itemId = MmsMapping_createMmsVariableNameFromObjectReference(objectReference, fc, itemIdBuffer);
+
+    if ((domainId == NULL) || (itemId == NULL)) {
+        *error = IED_ERROR_OBJECT_REFERENCE_INVALID;
+        return 0;
+    }
+
+    /* array elements are not supported */
+    if ((value == NULL) || strchr(itemId, '(')) {
+        *error = IED_ERROR_USER_PROVIDED_INVALID_ARGUMENT;
+        return 0;
+    }
+
+    IedConnectionOutstandingCall call = iedConnection_allocateOutstandingCall(self);
+
+    if (call == NULL) {
+        *error = IED_ERROR_OUTSTANDING_CALL_LIMIT_REACHED;
+        return 0;
+    }
+
+    call->callback = handler;
+    call->callbackParameter = parameter;
+
+    MmsError err = MMS_ERROR_NONE;
+
+    MmsConnection_readVariableIntoAsync(self->connection, &(call->invokeId), &err, domainId, itemId, value,
+            readObjectIntoHandlerInternal, self);
+
+    if (err != MMS_ERROR_NONE) {
+        *error = iedConnection_mapMmsErrorToIedError(err);
+
+        iedConnection_releaseOutstandingCall(self, call);
+
+        return 0;
+    }
+
+    return call->invokeId;
+}
+
+void
+IedConnection_readObjectInto(IedConnection self, IedClientError* error, const char* objectReference,
+        FunctionalConstraint fc, MmsValue* value)
+{
+    char domainIdBuffer[65];
+    char itemIdBuffer[65];
+
+    char* domainId;
+    char* itemId;
+
+    domainId = MmsMapping_getMmsDomainFromObjectReference(objectReference, domainIdBuffer);
+    itemId = MmsMapping_createMmsVariableNameFromObjectReference(objectReference, fc, itemIdBuffer);
+
+    if ((domainId == NULL) || (itemId == NULL)) {
+        *error = IED_ERROR_OBJECT_REFERENCE_INVALID;
+        return;
+    }
+
+    /* array elements are not supported */
+    if ((value == NULL) || strchr(itemId, '(')) {
+        *error = IED_ERROR_USER_PROVIDED_INVALID_ARGUMENT;
+        return;
+    }
+
+    MmsError mmsError = MMS_ERROR_NONE;
+
+    MmsConnection_readVariableInto(self->connection, &mmsError, domainId, itemId, value);
+
+    *error = iedConnection_mapMmsErrorToIedError(mmsError);
+}
+
 bool
 IedConnection_readBooleanValue(IedConnection self, IedClientError* error, const char* objectReference, FunctionalConstraint fc)
 {
-    MmsValue* value = IedConnection_readObject(self, error, objectReference, fc);
+    ICCachedValueKey key;
+
+    MmsValue* value = readObjectInternal(self, error, objectReference, fc, &key);
 
     bool retVal = false;
 
@@ -1276,7 +1674,7 @@ IedConnection_readBooleanValue(IedConnection self, IedClientError* error, const
                 *error = IED_ERROR_UNEXPECTED_VALUE_RECEIVED;
         }
 
-        MmsValue_delete(value);
+        releaseReadValue(self, &key, value);
     }
 
     return retVal;
@@ -1285,7 +1683,9 @@ IedConnection_readBooleanValue(IedConnection self, IedClientError* error, const
 float
 IedConnection_readFloatValue(IedConnection self, IedClientError* error, const char* objectReference, FunctionalConstraint fc)
 {
-    MmsValue* value = IedConnection_readObject(self, error, objectReference, fc);
+    ICCachedValueKey key;
+
+    MmsValue* value = readObjectInternal(self, error, objectReference, fc, &key);
 
     float retVal = 0.f;
 
@@ -1299,7 +1699,7 @@ IedConnection_readFloatValue(IedConnection self, IedClientError* error, const ch
                 *error = IED_ERROR_UNEXPECTED_VALUE_RECEIVED;
         }
 
-        MmsValue_delete(value);
+        releaseReadValue(self, &key, value);
     }
 
     return retVal;
@@ -1308,7 +1708,9 @@ IedConnection_readFloatValue(IedConnection self, IedClientError* error, const ch
 char*
 IedConnection_readStringValue(IedConnection self, IedClientError* error, const char* objectReference, FunctionalConstraint fc)
 {
-    MmsValue* value = IedConnection_readObject(self, error, objectReference, fc);
+    ICCachedValueKey key;
+
+    MmsValue* value = readObjectInternal(self, error, objectReference, fc, &key);
 
     char* retVal = NULL;
 
@@ -1322,7 +1724,7 @@ IedConnection_readStringValue(IedConnection self, IedClientError* error, const c
                 *error = IED_ERROR_UNEXPECTED_VALUE_RECEIVED;
         }
 
-        MmsValue_delete(value);
+        releaseReadValue(self, &key, value);
     }
 
     return retVal;
@@ -1331,7 +1733,9 @@ IedConnection_readStringValue(IedConnection self, IedClientError* error, const c
 int32_t
 IedConnection_readInt32Value(IedConnection self, IedClientError* error, const char* objectReference, FunctionalConstraint fc)
 {
-    MmsValue* value = IedConnection_readObject(self, error, objectReference, fc);
+    ICCachedValueKey key;
+
+    MmsValue* value = readObjectInternal(self, error, objectReference, fc, &key);
 
     int32_t retVal = 0;
 
@@ -1345,7 +1749,7 @@ IedConnection_readInt32Value(IedConnection self, IedClientError* error, const ch
                 *error = IED_ERROR_UNEXPECTED_VALUE_RECEIVED;
         }
 
-        MmsValue_delete(value);
+        releaseReadValue(self, &key, value);
     }
 
     return retVal;
@@ -1354,7 +1758,9 @@ IedConnection_readInt32Value(IedConnection self, IedClientError* error, const ch
 uint32_t
 IedConnection_readUnsigned32Value(IedConnection self, IedClientError* error, const char* objectReference, FunctionalConstraint fc)
 {
-    MmsValue* value = IedConnection_readObject(self, error, objectReference, fc);
+    ICCachedValueKey key;
+
+    MmsValue* value = readObjectInternal(self, error, objectReference, fc, &key);
 
     uint32_t retVal = 0;
 
@@ -1368,7 +1774,7 @@ IedConnection_readUnsigned32Value(IedConnection self, IedClientError* error, con
                 *error = IED_ERROR_UNEXPECTED_VALUE_RECEIVED;
         }
 
-        MmsValue_delete(value);
+        releaseReadValue(self, &key, value);
     }
 
     return retVal;
@@ -1377,7 +1783,9 @@ IedConnection_readUnsigned32Value(IedConnection self, IedClientError* error, con
 int64_t
 IedConnection_readInt64Value(IedConnection self, IedClientError* error, const char* objectReference, FunctionalConstraint fc)
 {
-    MmsValue* value = IedConnection_readObject(self, error, objectReference, fc);
+    ICCachedValueKey key;
+
+    MmsValue* value = readObjectInternal(self, error, objectReference, fc, &key);
 
     int64_t retVal = 0;
 
@@ -1391,7 +1799,7 @@ IedConnection_readInt64Value(IedConnection self, IedClientError* error, const ch
                 *error = IED_ERROR_UNEXPECTED_VALUE_RECEIVED;
         }
 
-        MmsValue_delete(value);
+        releaseReadValue(self, &key, value);
     }
 
     return retVal;
@@ -1401,7 +1809,9 @@ Timestamp*
 IedConnection_readTimestampValue(IedConnection self, IedClientError* error, const char* objectReference, FunctionalConstraint fc,
         Timestamp* timeStamp)
 {
-    MmsValue* value = IedConnection_readObject(self, error, objectReference, fc);
+    ICCachedValueKey key;
+
+    MmsValue* value = readObjectInternal(self, error, objectReference, fc, &key);
 
     Timestamp* retVal = timeStamp;
 
@@ -1420,7 +1830,7 @@ IedConnection_readTimestampValue(IedConnection self, IedClientError* error, cons
                 *error = IED_ERROR_UNEXPECTED_VALUE_RECEIVED;
         }
 
-        MmsValue_delete(value);
+        releaseReadValue(self, &key, value);
 
     }
 
@@ -1430,7 +1840,9 @@ IedConnection_readTimestampValue(IedConnection self, IedClientError* error, cons
 Quality
 IedConnection_readQualityValue(IedConnection self, IedClientError* error, const char* objectReference, FunctionalConstraint fc)
 {
-    MmsValue* value = IedConnection_readObject(self, error, objectReference, fc);
+    ICCachedValueKey key;
+
+    MmsValue* value = readObjectInternal(self, error, objectReference, fc, &key);
 
     Quality quality = QUALITY_VALIDITY_GOOD;
 
@@ -1446,7 +1858,7 @@ IedConnection_readQualityValue(IedConnection self, IedClientError* error, const
                 *error = IED_ERROR_UNEXPECTED_VALUE_RECEIVED;
         }
 
-        MmsValue_delete(value);
+        releaseReadValue(self, &key, value);
 
     }
 
@@ -1704,62 +2116,6 @@ IedConnection_writeVisibleStringValue(IedConnection self, IedClientError* error,
     IedConnection_writeObject(self, error, objectReference, fc, &mmsValue);
 }
 
-void
-IedConnection_getDeviceModelFromServer(IedConnection self, IedClientError* error)
-{
-    MmsError mmsError = MMS_ERROR_NONE;
-
-    if (error)
-        *error = IED_ERROR_OK;
-
-    LinkedList logicalDeviceNames = MmsConnection_getDomainNames(self->connection, &mmsError);
-
-    if (logicalDeviceNames != NULL) {
-
-        if (self->logicalDevices != NULL) {
-            LinkedList_destroyDeep(self->logicalDevices, (LinkedListValueDeleteFunction) ICLogicalDevice_destroy);
-            self->logicalDevices = NULL;
-        }
-
-        LinkedList logicalDevice = LinkedList_getNext(logicalDeviceNames);
-
-        LinkedList logicalDevices = LinkedList_create();
-
-        while (logicalDevice != NULL) {
-            char* name = (char*) logicalDevice->data;
-
-            LinkedList variables = MmsConnection_getDomainVariableNames(self->connection,
-                    &mmsError, name);
-
-            if (variables != NULL) {
-                ICLogicalDevice* icLogicalDevice = ICLogicalDevice_create(name);
-
-                ICLogicalDevice_setVariableList(icLogicalDevice, variables);
-
-                LinkedList_add(logicalDevices, icLogicalDevice);
-            }
-            else {
-                if (error)
-                    *error = iedConnection_mapMmsErrorToIedError(mmsError);
-                break;
-            }
-
-            logicalDevice = LinkedList_getNext(logicalDevice);
-        }
-
-        if (mmsError != MMS_ERROR_NONE) {
-            LinkedList_destroyDeep(logicalDevices, (LinkedListValueDeleteFunction) ICLogicalDevice_destroy);
-        }
-        else {
-            self->logicalDevices = logicalDevices;
-        }
-
-        LinkedList_destroy(logicalDeviceNames);
-    }
-    else
-        *error = iedConnection_mapMmsErrorToIedError(mmsError);
-}
-
 LinkedList /*<char*>*/
 IedConnection_getLogicalDeviceList(IedConnection self, IedClientError* error)
 {
@@ -1994,6 +2350,256 @@ IedConnection_getFile(IedConnection self, IedClientError* error, const char* fil
     return clientFileReadHandler.byteReceived;
 }
 
+typedef struct sFileReadWindow* FileReadWindow;
+
+typedef struct
+{
+    FileReadWindow window;
+    uint32_t sequence; /* index of the file block requested by this slot */
+    bool received; /* block received out of order and stored in data */
+    uint8_t* data;
+    uint32_t size;
+} FileReadSlot;
+
+struct sFileReadWindow
+{
+    Semaphore lock; /* protects the fields below */
+    Semaphore progress; /* signaled by a response when the user thread waits */
+    bool userWaits;
+
+    IedClientGetFileHandler handler;
+    void* handlerParameter;
+
+    FileReadSlot* slots;
+    int windowSize;
+
+    uint32_t nextSequence; /* next block to request */
+    uint32_t nextDelivery; /* next block to pass to the user handler */
+    uint32_t endSequence; /* number of blocks of the file (UINT32_MAX when unknown) */
+    int outstanding;
+
+    MmsError err;
+    bool cancel; /* stopped by the user handler */
+    uint32_t bytesReceived;
+};
+
+static void
+fileReadWindow_deliver(FileReadWindow self, uint8_t* buffer, uint32_t size)
+{
+    if (self->cancel == false) {
+        if (self->handler(self->handlerParameter, buffer, size) == false)
+            self->cancel = true;
+
+        self->bytesReceived += size;
+    }
+
+    self->nextDelivery++;
+}
+
+static void
+fileReadWindowHandler(uint32_t invokeId, void* parameter, MmsError mmsError, int32_t frsmId, uint8_t* buffer,
+        uint32_t byteReceived, bool moreFollows)
+{
+    (void)invokeId;
+    (void)frsmId;
+
+    FileReadSlot* slot = (FileReadSlot*) parameter;
+    FileReadWindow self = slot->window;
+
+    Semaphore_wait(self->lock);
+
+    self->outstanding--;
+
+    /* responses for requests behind the end of file are ignored (some servers answer with an error) */
+    if (slot->sequence < self->endSequence) {
+
+        if (mmsError != MMS_ERROR_NONE) {
+            if (self->err == MMS_ERROR_NONE)
+                self->err = mmsError;
+        }
+        else {
+            if (moreFollows == false)
+                self->endSequence = slot->sequence + 1;
+
+            if (slot->sequence == self->nextDelivery) {
+                fileReadWindow_deliver(self, buffer, byteReceived);
+
+                /* deliver blocks that have been received out of order */
+                while (self->nextDelivery < self->endSequence) {
+                    FileReadSlot* next = &(self->slots[self->nextDelivery % self->windowSize]);
+
+                    if ((next->sequence != self->nextDelivery) || (next->received == false))
+                        break;
+
+                    fileReadWindow_deliver(self, next->data, next->size);
+
+                    next->received = false;
+                    GLOBAL_FREEMEM(next->data);
+                    next->data = NULL;
+                }
+            }
+            else {
+                slot->data = (uint8_t*) GLOBAL_MALLOC(byteReceived > 0 ? byteReceived : 1);
+
+                if (slot->data) {
+                    memcpy(slot->data, buffer, byteReceived);
+                    slot->size = byteReceived;
+                    slot->received = true;
+                }
+                else if (self->err == MMS_ERROR_NONE) {
+                    self->err = MMS_ERROR_RESOURCE_OTHER;
+                }
+            }
+        }
+    }
+
+    bool unblockUserThread = self->userWaits;
+
+    self->userWaits = false;
+
+    Semaphore_post(self->lock);
+
+    if (unblockUserThread)
+        Semaphore_post(self->progress);
+}
+
+uint32_t
+IedConnection_getFileWindowed(IedConnection self, IedClientError* error, const char* fileName, int window,
+        IedClientGetFileHandler handler, void* handlerParameter, uint32_t* bytesPerSecond)
+{
+    *error = IED_ERROR_OK;
+
+    if (bytesPerSecond)
+        *bytesPerSecond = 0;
+
+    int maxOutstandingCalls = MmsConnection_getMaxOutstandingCalls(self->connection);
+
+    if (window > maxOutstandingCalls)
+        window = maxOutstandingCalls;
+
+    if (window < 1)
+        window = 1;
+
+    MmsError mmsError;
+
+    uint32_t fileSize;
+
+    uint64_t startTime = Hal_getTimeInMs();
+
+    int32_t frsmId =
+            MmsConnection_fileOpen(self->connection, &mmsError, fileName, 0, &fileSize, NULL);
+
+    if (mmsError != MMS_ERROR_NONE) {
+        *error = iedConnection_mapMmsErrorToIedError(mmsError);
+        return 0;
+    }
+
+    struct sFileReadWindow readWindow;
+
+    readWindow.lock = Semaphore_create(1);
+    readWindow.progress = Semaphore_create(1);
+    readWindow.userWaits = false;
+    readWindow.handler = handler;
+    readWindow.handlerParameter = handlerParameter;
+    readWindow.slots = (FileReadSlot*) GLOBAL_CALLOC(window, sizeof(FileReadSlot));
+    readWindow.windowSize = window;
+    readWindow.nextSequence = 0;
+    readWindow.nextDelivery = 0;
+    readWindow.endSequence = UINT32_MAX;
+    readWindow.outstanding = 0;
+    readWindow.err = MMS_ERROR_NONE;
+    readWindow.cancel = false;
+    readWindow.bytesReceived = 0;
+
+    if (readWindow.slots == NULL)
+        readWindow.err = MMS_ERROR_RESOURCE_OTHER;
+
+    Semaphore_wait(readWindow.progress);
+
+    Semaphore_wait(readWindow.lock);
+
+    while (true) {
+
+        /* keep the window filled until the end of file is known */
+        while ((readWindow.err == MMS_ERROR_NONE) && (readWindow.cancel == false) &&
+                (readWindow.endSequence == UINT32_MAX) &&
+                ((readWindow.nextSequence - readWindow.nextDelivery) < (uint32_t) window))
+        {
+            FileReadSlot* slot = &(readWindow.slots[readWindow.nextSequence % window]);
+
+            slot->window = &readWindow;
+            slot->sequence = readWindow.nextSequence;
+            slot->received = false;
+
+            readWindow.nextSequence++;
+            readWindow.outstanding++;
+
+            Semaphore_post(readWindow.lock);
+
+            MmsConnection_fileReadAsync(self->connection, NULL, &mmsError, frsmId, fileReadWindowHandler, slot);
+
+            Semaphore_wait(readWindow.lock);
+
+            if (mmsError != MMS_ERROR_NONE) {
+                readWindow.nextSequence--;
+                readWindow.outstanding--;
+
+                /* request window is occupied by other requests -> retry when a response is received */
+                if ((mmsError == MMS_ERROR_OUTSTANDING_CALL_LIMIT) && (readWindow.outstanding > 0))
+                    break;
+
+                readWindow.err = mmsError;
+            }
+        }
+
+        if (readWindow.outstanding == 0)
+            break;
+
+        readWindow.userWaits = true;
+
+        Semaphore_post(readWindow.lock);
+
+        Semaphore_wait(readWindow.progress);
+
+        Semaphore_wait(readWindow.lock);
+    }
+
+    Semaphore_post(readWindow.lock);
+
+    if (readWindow.slots) {
+        int i;
+
+        for (i = 0; i < window; i++) {
+            if (readWindow.slots[i].data)
+                GLOBAL_FREEMEM(readWindow.slots[i].data);
+        }
+
+        GLOBAL_FREEMEM(readWindow.slots);
+    }
+
+    Semaphore_destroy(readWindow.progress);
+    Semaphore_destroy(readWindow.lock);
+
+    if (readWindow.err != MMS_ERROR_NONE)
+        *error = iedConnection_mapMmsErrorToIedError(readWindow.err);
+    else if (readWindow.cancel)
+        *error = IED_ERROR_UNKNOWN;
+
+    /* the file is also closed after an error to release the FRSM of the server */
+    MmsConnection_fileClose(self->connection, &mmsError, frsmId);
+
+    if (*error == IED_ERROR_OK) {
+        *error = iedConnection_mapMmsErrorToIedError(mmsError);
+
+        uint64_t duration = Hal_getTimeInMs() - startTime;
+
+        if (bytesPerSecond)
+            *bytesPerSecond = (uint32_t) ((readWindow.bytesReceived * 1000ULL) / (duration > 0 ? duration : 1));
+    }
+
+    return readWindow.bytesReceived;
+}
+
 static void
 mmsConnectionFileCloseHandler (uint32_t invokeId, void* parameter, MmsError mmsError, bool success)
 {
@@ -2163,6 +2769,13 @@ IedConnection_getFileAsync(IedConnection self, IedClientError* error, const char
     return call->invokeId;
 }
 
+void
+IedConnection_setCallbackExecutor(IedConnection self, MmsClientCallbackExecutor executor)
+{
+    /* simply pass the call to MMS client API */
+    MmsConnection_setCallbackExecutor(self->connection, executor);
+}
+
 void
 IedConnection_setFilestoreBasepath(IedConnection self, const char* basepath)
 {
@@ -277,6 +277,25 @@ IedConnection_setRequestTimeout(IedConnection self, uint32_t timeoutInMs);
 LIB61850_API uint32_t
 IedConnection_getRequestTimeout(IedConnection self);
 
+/**
+ * \brief Set the maximum number of outstanding (pipelined) requests for this connection
+ *
+ * Asynchronous service calls can be pipelined up to this limit. Further calls fail with
+ * IED_ERROR_OUTSTANDING_CALL_LIMIT_REACHED. When the value negotiated with the server at
+ * connection setup is lower the negotiated value is used as limit. Without calling this function
+ * the negotiated value is not applied (see \ref MmsConnection_setMaxOutstandingCalls).
+ *
+ * NOTE: This function has to be called when there are no outstanding requests (e.g. before
+ * connecting).
+ *
+ * \param self the connection object
+ * \param maxOutstandingCalls the maximum number of outstanding requests (default is 10)
+ *
+ * \return true when the value has been set, false otherwise
+ */
+LIB61850_API bool
+IedConnection_setMaxOutstandingCalls(IedConnection self, int maxOutstandingCalls);
+
 /**
  * \brief Set the time quality for all timestamps generated by this IedConnection instance
  *
@@ -304,6 +323,95 @@ IedConnection_setTimeQuality(IedConnection self, bool leapSecondKnown, bool cloc
 LIB61850_API bool
 IedConnection_tick(IedConnection self);
 
+/** an opaque handle to the instance data of a IedClientReactor object */
+typedef struct sIedClientReactor* IedClientReactor;
+
+/**
+ * \brief Create a new IedClientReactor instance
+ *
+ * A reactor handles many connections in non-thread mode with a small number of threads (instead of one
+ * thread per connection). Each connection is assigned to one of the worker threads. A worker thread waits
+ * for incoming data on the sockets of its connections and only handles the connections that received data.
+ * The timers of all connections (e.g. request timeouts) are checked periodically without accessing the sockets.
+ *
+ * The callback handlers of the connections are called by the worker threads. The synchronous (blocking)
+ * API functions can be used by application threads but not inside of the callback handlers.
+ *
+ * \param numberOfThreads the number of worker threads
+ *
+ * \return the new reactor instance, or NULL when threads are not supported
+ */
+LIB61850_API IedClientReactor
+IedClientReactor_create(int numberOfThreads);
+
+/**
+ * \brief Set the interval in which the timers of all connections are checked (default: 100 ms)
+ *
+ * The interval defines the accuracy of the request timeouts and the delay to detect connection
+ * closes requested by the application. Connections without an open socket (e.g. TCP connect in
+ * progress) are checked every 10 ms.
+ *
+ * \param self the reactor instance
+ * \param intervalInMs interval in milliseconds
+ */
+LIB61850_API void
+IedClientReactor_setTickInterval(IedClientReactor self, int intervalInMs);
+
+/**
+ * \brief Add a connection to the reactor
+ *
+ * The connection has to be created in non-thread mode (see \ref IedConnection_createEx). The
+ * connection can be added before or after it is connected. The \ref IedConnection_tick function
+ * must not be called for the connection while it is handled by the reactor.
+ *
+ * \param self the reactor instance
+ * \param connection the connection to add
+ *
+ * \return true when the connection has been added, false otherwise (e.g. connection in thread mode)
+ */
+LIB61850_API bool
+IedClientReactor_addConnection(IedClientReactor self, IedConnection connection);
+
+/**
+ * \brief Remove a connection from the reactor
+ *
+ * When the function returns the connection is no longer handled by the worker threads and can be destroyed.
+ * The connection has to be removed from the reactor before it is destroyed.
+ *
+ * NOTE: Must not be called inside of a callback handler of a connection of the reactor.
+ *
+ * \param self the reactor instance
+ * \param connection the connection to remove
+ */
+LIB61850_API void
+IedClientReactor_removeConnection(IedClientReactor self, IedConnection connection);
+
+/**
+ * \brief Start the worker threads of the reactor
+ *
+ * \param self the reactor instance
+ */
+LIB61850_API void
+IedClientReactor_start(IedClientReactor self);
+
+/**
+ * \brief Stop the worker threads of the reactor
+ *
+ * \param self the reactor instance
+ */
+LIB61850_API void
+IedClientReactor_stop(IedClientReactor self);
+
+/**
+ * \brief Destroy the reactor instance
+ *
+ * Stops the worker threads. The connections are not destroyed.
+ *
+ * \param self the reactor instance
+ */
+LIB61850_API void
+IedClientReactor_destroy(IedClientReactor self);
+
 /**
  * \brief Generic serivce callback handler
  *
@@ -873,6 +981,106 @@ LIB61850_API uint32_t
 IedConnection_readObjectAsync(IedConnection self, IedClientError* error, const char* objRef, FunctionalConstraint fc,
         IedConnection_ReadObjectHandler handler, void* parameter);
 
+/**
+ * \brief read a functional constrained data attribute (FCDA) or functional constrained data (FCD) into an existing value
+ *
+ * The response is decoded directly into the provided MmsValue instance without memory allocation.
+ * This is intended for cyclic polling: the value returned by the first \ref IedConnection_readObject call
+ * can be reused for all following reads of the same object.
+ *
+ * When the received value doesn't match the type of the provided value the error is IED_ERROR_TYPE_INCONSISTENT.
+ * When the server reports an access error the error code is set accordingly. In both cases the value is not changed.
+ *
+ * NOTE: References to array elements are not supported.
+ *
+ * \param self  the connection object to operate on
+ * \param error the error code if an error occurs
+ * \param objectReference reference of the object/attribute to read
+ * \param fc the functional constraint of the data attribute or data object to read
+ * \param value the type matching value to store the result
+ */
+LIB61850_API void
+IedConnection_readObjectInto(IedConnection self, IedClientError* error, const char* objectReference,
+        FunctionalConstraint fc, MmsValue* value);
+
+/**
+ * \brief read a functional constrained data attribute (FCDA) or functional constrained data (FCD) into an existing value - async version
+ *
+ * See \ref IedConnection_readObjectInto. The value must not be accessed before the handler is called. The value is
+ * updated when the handler is called with IED_ERROR_OK.
+ *
+ * \param self  the connection object to operate on
+ * \param error the error code if an error occurs
+ * \param objectReference reference of the object/attribute to read
+ * \param fc the functional constraint of the data attribute or data object to read
+ * \param value the type matching value to store the result
+ * \param handler the user provided callback handler
+ * \param parameter user provided parameter that is passed to the callback handler
+ *
+ * \return the invoke ID of the request
+ */
+LIB61850_API uint32_t
+IedConnection_readObjectIntoAsync(IedConnection self, IedClientError* error, const char* objectReference,
+        FunctionalConstraint fc, MmsValue* value, IedConnection_GenericServiceHandler handler, void* parameter);
+
+/**
+ * \brief read multiple functional constrained data attributes (FCDAs) or functional constrained data (FCDs)
+ *
+ * The objects are combined into multi-variable MMS read requests. The objects of a request have
+ * to belong to the same logical device, so the objects are grouped by logical device and split into
+ * requests that fit into the negotiated MMS PDU size. When the server rejects a request (e.g. because
+ * the response would exceed the PDU size) the request is split and sent again. The requests are
+ * pipelined up to the limit of outstanding calls (see \ref IedConnection_setMaxOutstandingCalls).
+ *
+ * The values are returned in the order of the object references. When an object cannot be read the
+ * value is either an MmsValue of type MMS_DATA_ACCESS_ERROR (error reported by the server) or NULL
+ * (the request failed). The caller is responsible to release the returned values.
+ *
+ * NOTE: References to array elements are not supported.
+ *
+ * \param self  the connection object to operate on
+ * \param error the error code if an error occurs (the first error when multiple requests failed)
+ * \param numberOfObjects the number of objects to read
+ * \param objectReferences array of object references of the objects/attributes to read
+ * \param fcs array of functional constraints of the objects/attributes to read
+ * \param values user provided array for the results (has to have numberOfObjects elements)
+ */
+LIB61850_API void
+IedConnection_readObjects(IedConnection self, IedClientError* error, int numberOfObjects,
+        const char** objectReferences, const FunctionalConstraint* fcs, MmsValue** values);
+
+/**
+ * \brief Callback handler for \ref IedConnection_readObjectsAsync
+ *
+ * The handler is responsible to release the values (but not the array).
+ *
+ * \param parameter user provided parameter
+ * \param err the error code (the first error when multiple requests failed)
+ * \param values the values in the order of the object references (NULL when the object could not be read)
+ * \param numberOfValues the number of values
+ */
+typedef void
+(*IedConnection_ReadObjectsHandler) (void* parameter, IedClientError err, MmsValue** values, int numberOfValues);
+
+/**
+ * \brief read multiple functional constrained data attributes (FCDAs) or functional constrained data (FCDs) - async version
+ *
+ * See \ref IedConnection_readObjects for details. The handler is called once when all responses
+ * have been received.
+ *
+ * \param self  the connection object to operate on
+ * \param error the error code if the requests cannot be sent
+ * \param numberOfObjects the number of objects to read
+ * \param objectReferences array of object references of the objects/attributes to read
+ * \param fcs array of functional constraints of the objects/attributes to read
+ * \param handler the user provided callback handler
+ * \param parameter user provided parameter that is passed to the callback handler
+ */
+LIB61850_API void
+IedConnection_readObjectsAsync(IedConnection self, IedClientError* error, int numberOfObjects,
+        const char** objectReferences, const FunctionalConstraint* fcs,
+        IedConnection_ReadObjectsHandler handler, void* parameter);
+
 /**
  * \brief write a functional constrained data attribute (FCDA) or functional constrained data (FCD).
  *
@@ -1279,6 +1487,22 @@ IedConnection_installReportHandler(IedConnection self, const char* rcbReference,
 LIB61850_API void
 IedConnection_uninstallReportHandler(IedConnection self, const char* rcbReference);
 
+/**
+ * \brief Call the report handlers of the connection by a callback executor thread
+ *
+ * By default the report handlers are called by the thread that receives the messages of the connection.
+ * With a callback executor (see \ref MmsClientCallbackExecutor_create) the received reports are queued
+ * and the report handlers are called by the executor thread. A slow report handler then no longer delays
+ * the handling of responses. The same executor can be used by multiple connections.
+ *
+ * NOTE: The ClientReport passed to the report handler is only valid during the call of the handler.
+ *
+ * \param self the connection object
+ * \param executor the callback executor or NULL to call the report handlers by the receiving thread
+ */
+LIB61850_API void
+IedConnection_setCallbackExecutor(IedConnection self, MmsClientCallbackExecutor executor);
+
 /**
  * \brief trigger a general interrogation (GI) report for the specified report control block (RCB)
  *
@@ -2389,6 +2613,177 @@ LIB61850_API void
 ControlObjectClient_setCommandTerminationHandler(ControlObjectClient self, CommandTerminationHandler handler,
         void* handlerParameter);
 
+/**
+ * \brief Operate many control objects of the same connection at once (e.g. for load shedding)
+ *
+ * The Oper requests of all control objects in the batch are sent pipelined (as many requests in parallel
+ * as permitted by the MMS connection) or, when enabled by \ref ControlObjectClientBatch_setUseMultipleWrite,
+ * combined into MMS write requests with multiple variables. The operate result, the command termination and the
+ * last application error are collected per control object together with the response times.
+ *
+ * Control objects with SBO control model have to be selected before the batch is operated.
+ */
+typedef struct sControlObjectClientBatch* ControlObjectClientBatch;
+
+typedef struct
+{
+    ControlObjectClient control;
+
+    /** result of the operate request (IED_ERROR_OK when the server accepted the command) */
+    IedClientError error;
+
+    /** true when a command termination is expected (enhanced security control model and operate accepted) */
+    bool terminationExpected;
+
+    /** true when the command termination has been received */
+    bool terminationReceived;
+
+    /** true for CommandTermination+ and false for CommandTermination- */
+    bool terminationPositive;
+
+    /** last application error received for the control object (operate failure or CommandTermination-) */
+    LastApplError lastApplError;
+
+    /** time between sending the operate request and receiving the response */
+    uint32_t responseTimeInUs;
+
+    /** time between sending the operate request and receiving the command termination */
+    uint32_t terminationTimeInUs;
+} ControlObjectClientBatchResult;
+
+typedef struct
+{
+    int numberOfControls;
+    int numberOfRequests; /**< number of MMS write requests sent */
+
+    int numberOfAcceptedOperations;
+    int numberOfFailedOperations;
+
+    int numberOfPositiveTerminations;
+    int numberOfNegativeTerminations;
+    int numberOfMissingTerminations; /**< expected command terminations not received before the timeout */
+
+    uint32_t minResponseTimeInUs;
+    uint32_t maxResponseTimeInUs;
+    uint32_t averageResponseTimeInUs;
+
+    uint32_t maxTerminationTimeInUs;
+    uint32_t averageTerminationTimeInUs;
+
+    uint32_t operateTimeInUs; /**< time until the responses of all operate requests have been received */
+    uint32_t totalTimeInUs; /**< time until all command terminations have been received or the timeout elapsed */
+} ControlObjectClientBatchStatistics;
+
+/**
+ * \brief Create a new batch for control objects of the given connection
+ *
+ * \param connection the connection that is used by all control objects of the batch
+ *
+ * \return the new batch instance
+ */
+LIB61850_API ControlObjectClientBatch
+ControlObjectClientBatch_create(IedConnection connection);
+
+/**
+ * \brief Release all resources of the batch
+ *
+ * \param self the batch instance
+ */
+LIB61850_API void
+ControlObjectClientBatch_destroy(ControlObjectClientBatch self);
+
+/**
+ * \brief Add a control object with the control value to the batch
+ *
+ * A control object can only be added once to a batch and can only be part of one batch at a time.
+ *
+ * \param self the batch instance
+ * \param control the control object (has to use the connection of the batch)
+ * \param ctlVal the control value (the batch uses a copy)
+ * \param operTime the time when the operate command is to be executed (for time activated control), 0 otherwise
+ *
+ * \return the index of the control object in the batch or -1 in case of an error
+ */
+LIB61850_API int
+ControlObjectClientBatch_add(ControlObjectClientBatch self, ControlObjectClient control, MmsValue* ctlVal, uint64_t operTime);
+
+/**
+ * \brief Remove all control objects from the batch
+ *
+ * \param self the batch instance
+ */
+LIB61850_API void
+ControlObjectClientBatch_clear(ControlObjectClientBatch self);
+
+/**
+ * \brief Get the number of control objects in the batch
+ */
+LIB61850_API int
+ControlObjectClientBatch_getNumberOfControls(ControlObjectClientBatch self);
+
+/**
+ * \brief Combine the Oper requests of control objects of the same logical device into MMS write requests with
+ * multiple variables
+ *
+ * The requests are limited by the negotiated MMS PDU size. When the server rejects a write request with multiple
+ * variables the control objects are operated by single write requests.
+ *
+ * NOTE: The server has to answer the write request with one access result per control object. Servers that
+ * answer each Oper individually (like the libiec61850 server) execute the commands but only the result of the
+ * first command is received. In this case the other commands of the request are reported with
+ * IED_ERROR_MALFORMED_MESSAGE and the remaining requests of the batch are sent as single write requests.
+ * A command that is delayed by the server (e.g. by a synchro check) delays the response for all commands
+ * of the request.
+ *
+ * \param self the batch instance
+ * \param useMultipleWrite true to use write requests with multiple variables, false to send one write request
+ *        per control object (default)
+ */
+LIB61850_API void
+ControlObjectClientBatch_setUseMultipleWrite(ControlObjectClientBatch self, bool useMultipleWrite);
+
+/**
+ * \brief Operate all control objects of the batch
+ *
+ * Blocks until the responses of all operate requests have been received. When terminationTimeoutInMs is not 0
+ * the function also waits for the command terminations of the enhanced security control objects (at most the given
+ * time after the last operate response has been received).
+ *
+ * The command termination handlers of the control objects are called as usual.
+ *
+ * \param self the batch instance
+ * \param error the error code of the first failed request or IED_ERROR_OK
+ * \param terminationTimeoutInMs maximum time to wait for the command terminations or 0 to not wait
+ *
+ * \return true when all operate requests have been accepted and no CommandTermination- has been received,
+ *         false otherwise
+ */
+LIB61850_API bool
+ControlObjectClientBatch_operate(ControlObjectClientBatch self, IedClientError* error, uint32_t terminationTimeoutInMs);
+
+/**
+ * \brief Get the result of a control object of the last batch operation
+ *
+ * NOTE: Command terminations received after \ref ControlObjectClientBatch_operate returned are also recorded.
+ *
+ * \param self the batch instance
+ * \param index the index of the control object (as returned by \ref ControlObjectClientBatch_add)
+ * \param result user provided variable to store the result
+ *
+ * \return true when the index is valid, false otherwise
+ */
+LIB61850_API bool
+ControlObjectClientBatch_getResult(ControlObjectClientBatch self, int index, ControlObjectClientBatchResult* result);
+
+/**
+ * \brief Get the statistics of the last batch operation
+ *
+ * \param self the batch instance
+ * \param statistics user provided variable to store the statistics
+ */
+LIB61850_API void
+ControlObjectClientBatch_getStatistics(ControlObjectClientBatch self, ControlObjectClientBatchStatistics* statistics);
+
 /** @} */
 
 /*************************************
@@ -2407,6 +2802,9 @@ ControlObjectClient_setCommandTerminationHandler(ControlObjectClient self, Comma
  * This function retrieves the complete device model from the server. The model is buffered an can be browsed
  * by subsequent API calls. This API call is mapped to multiple ACSI services.
  *
+ * The variable names of all logical devices are requested in parallel. The number of requests
+ * in flight is limited by the MMS request window (see \ref IedConnection_setMaxOutstandingCalls).
+ *
  * \param self the connection object
  * \param error the error code if an error occurs
  *
@@ -2414,6 +2812,54 @@ ControlObjectClient_setCommandTerminationHandler(ControlObjectClient self, Comma
 LIB61850_API void
 IedConnection_getDeviceModelFromServer(IedConnection self, IedClientError* error);
 
+/**
+ * \brief Save the buffered device model to a local model cache file
+ *
+ * The cache file contains the logical devices, the MMS variable names and the configuration
+ * revision (LLN0.NamPlt.configRev) of each logical device. The configuration revisions are read
+ * from the server when this function is called.
+ *
+ * NOTE: This function will call \ref IedConnection_getDeviceModelFromServer if no buffered data model
+ * information is available.
+ *
+ * \param self the connection object
+ * \param error the error code if an error occurs
+ * \param filename the name of the model cache file
+ */
+LIB61850_API void
+IedConnection_saveDeviceModel(IedConnection self, IedClientError* error, const char* filename);
+
+/**
+ * \brief Load the device model from a model cache file when it matches the server model
+ *
+ * The cached model is only used when the logical devices of the server and the configuration
+ * revisions (LLN0.NamPlt.configRev) of all logical devices match the cache file. Checking the model
+ * requires only two requests independent of the size of the model. Logical devices without
+ * configuration revision cannot be checked and always require a new model discovery.
+ *
+ * \param self the connection object
+ * \param error the error code if an error occurs
+ * \param filename the name of the model cache file
+ *
+ * \return true when the cached model is used, false when the cache file doesn't exist, is invalid,
+ *         or doesn't match the server model
+ */
+LIB61850_API bool
+IedConnection_loadDeviceModel(IedConnection self, IedClientError* error, const char* filename);
+
+/**
+ * \brief Retrieve the device model from the model cache file or from the server
+ *
+ * Uses the cached model when it matches the server model (see \ref IedConnection_loadDeviceModel).
+ * Otherwise the model is retrieved from the server and the cache file is updated.
+ *
+ * \param self the connection object
+ * \param error the error code if an error occurs
+ * \param filename the name of the model cache file
+ */
+LIB61850_API void
+IedConnection_getDeviceModelFromServerCached(IedConnection self, IedClientError* error, const char* filename);
+
 /**
  * \brief Get the list of logical devices available at the server (DEPRECATED)
  *
@@ -2598,6 +3044,52 @@ LIB61850_API MmsVariableSpecification*
 IedConnection_getVariableSpecification(IedConnection self, IedClientError* error, const char* dataAttributeReference,
         FunctionalConstraint fc);
 
+/**
+ * \brief Enable or disable the variable specification cache of the connection
+ *
+ * When enabled the variable specifications (MMS type specifications) are stored per MMS domain and item ID.
+ * The cache is filled lazily by \ref IedConnection_getVariableSpecification (the first call for a variable
+ * requests the specification from the server, later calls return a copy of the cached specification) or in bulk
+ * by \ref IedConnection_cacheVariableSpecifications.
+ *
+ * Reads of variables with a cached type (\ref IedConnection_readObject and the typed read functions like
+ * \ref IedConnection_readFloatValue) decode the response directly into a value of the cached type
+ * instead of using the generic decoder. The typed read functions reuse these values for later reads. Access
+ * errors are returned like by the generic read. When the response doesn't match the cached type the variable
+ * is removed from the cache and read again with the generic decoder.
+ *
+ * The cache is cleared whenever a new association is established. Disabling the cache also clears it.
+ * The cache is disabled by default.
+ *
+ * \param self the connection object
+ * \param enable true to enable the cache, false to disable and clear the cache
+ */
+LIB61850_API void
+IedConnection_enableVariableSpecificationCache(IedConnection self, bool enable);
+
+/**
+ * \brief Request the variable specifications of all logical nodes of a logical device and store them in the cache
+ *
+ * Sends one GetVariableAccessAttributes request per logical node. Enables the cache when it is not
+ * enabled (see \ref IedConnection_enableVariableSpecificationCache).
+ *
+ * \param self the connection object
+ * \param error the error code if an error occurs
+ * \param ldName the logical device name
+ *
+ * \return the number of logical nodes added to the cache
+ */
+LIB61850_API int
+IedConnection_cacheVariableSpecifications(IedConnection self, IedClientError* error, const char* ldName);
+
+/**
+ * \brief Remove all entries from the variable specification cache
+ *
+ * \param self the connection object
+ */
+LIB61850_API void
+IedConnection_clearVariableSpecificationCache(IedConnection self);
+
 /**
  * \brief Get all variables of the logical device
  *
@@ -2964,6 +3456,31 @@ LIB61850_API uint32_t
 IedConnection_getFile(IedConnection self, IedClientError* error, const char* fileName, IedClientGetFileHandler handler,
         void* handlerParameter);
 
+/**
+ * \brief Implementation of the GetFile ACSI service with multiple outstanding FileRead requests
+ *
+ * Download a file from the server. Other than \ref IedConnection_getFile this function doesn't wait
+ * for the response of a FileRead request before sending the next one. Up to \p window FileRead requests
+ * are outstanding at the same time, so the throughput is not limited to one data block per round trip.
+ * The handler is called with the data blocks in the order of the file content.
+ *
+ * NOTE: The window is limited by the MMS request window (see \ref IedConnection_setMaxOutstandingCalls).
+ * The server has to answer the FileRead requests in the order they are received.
+ *
+ * \param self the connection object
+ * \param error the error code if an error occurs
+ * \param fileName the name of the file to be read from the server
+ * \param window maximum number of outstanding FileRead requests (1 - same as \ref IedConnection_getFile)
+ * \param handler callback handler that is called for each received data block
+ * \param handlerParameter user provided callback parameter
+ * \param bytesPerSecond returns the average transfer rate of the download in bytes/s (can be NULL)
+ *
+ * \return number of bytes received
+ */
+LIB61850_API uint32_t
+IedConnection_getFileWindowed(IedConnection self, IedClientError* error, const char* fileName, int window,
+        IedClientGetFileHandler handler, void* handlerParameter, uint32_t* bytesPerSecond);
+
 
 /**
  * \brief User provided handler to receive the data of the asynchronous GetFile request
@@ -53,6 +53,76 @@ ConfigFileParser_createModelFromConfigFileEx(const char* filename);
 LIB61850_API IedModel*
 ConfigFileParser_createModelFromConfigFile(FileHandle fileHandle);
 
+/**
+ * \brief Create a data model directly from an SCL file (ICD, CID, SCD, ...)
+ *
+ * The created data model is the same as the model created by \ref ConfigFileParser_createModelFromConfigFileEx
+ * from the configuration file generated by the genconfig tool for the same IED. The SCL file is parsed
+ * without building a document tree. Only the selected IED section, the DataTypeTemplates section, and
+ * the Communication section are evaluated. All other IED sections (e.g. of an SCD file) are skipped.
+ *
+ * \param filename name or path of the SCL file
+ * \param iedName name of the IED or NULL to select the first IED in the file
+ * \param accessPointName name of the access point or NULL to select the first access point with a server
+ *
+ * \return the data model to be used by \ref IedServer or NULL if the file cannot be parsed
+ */
+LIB61850_API IedModel*
+SclFileParser_createModelFromSclFile(const char* filename, const char* iedName, const char* accessPointName);
+
+/**
+ * \brief Binary image of a data model that can be loaded without parsing
+ *
+ * A model image contains the data model structures in the memory layout of the library. Loading
+ * an image only maps the file into memory and adjusts the pointers between the model structures.
+ * An image can only be loaded by the same library version on the same platform (byte order,
+ * pointer size) that created it.
+ */
+typedef struct sIedModelImage* IedModelImage;
+
+/**
+ * \brief Write a data model to a binary model image file
+ *
+ * The model image has to be created before the data model is used by an \ref IedServer instance.
+ *
+ * \param model the data model (e.g. created by \ref ConfigFileParser_createModelFromConfigFileEx)
+ * \param filename name or path of the image file
+ *
+ * \return true if the image file has been written, false otherwise
+ */
+LIB61850_API bool
+IedModelImage_writeFile(IedModel* model, const char* filename);
+
+/**
+ * \brief Load a binary model image file
+ *
+ * \param filename name or path of the image file
+ *
+ * \return the model image instance or NULL if the file cannot be loaded (file not found, invalid
+ *         image, or image created for another platform or library version)
+ */
+LIB61850_API IedModelImage
+IedModelImage_load(const char* filename);
+
+/**
+ * \brief Get the data model of a model image
+ *
+ * The data model is valid until \ref IedModelImage_destroy is called. It must not be released
+ * with \ref IedModel_destroy.
+ *
+ * \return the data model to be used by \ref IedServer
+ */
+LIB61850_API IedModel*
+IedModelImage_getModel(IedModelImage self);
+
+/**
+ * \brief Release the model image and the data model
+ *
+ * \param self the model image instance
+ */
+LIB61850_API void
+IedModelImage_destroy(IedModelImage self);
+
 /**@}*/
 
 /**@}*/
@@ -81,6 +81,24 @@ IedModel_setIedNameForDynamicModel(IedModel* self, const char* name);
 LIB61850_API void
 IedModel_destroy(IedModel* model);
 
+/**
+ * \brief Get the memory used by a dynamically created data model
+ *
+ * Model nodes, control blocks, and names of a dynamic model are allocated in larger memory
+ * blocks owned by the model. Each distinct name (e.g. "stVal") is only stored once. The
+ * returned value contains the size of these memory blocks, the data set entries, and the
+ * communication parameters of GoCBs and SVCBs. The values of the data attributes and the
+ * overhead of the heap allocator are not included.
+ *
+ * NOTE: Do not use this function when using a static data model.
+ *
+ * \param self the model instance
+ *
+ * \return the number of bytes allocated for the data model
+ */
+LIB61850_API int
+IedModel_getMemoryUsage(IedModel* self);
+
 /**
  * \brief Create a new logical device model and add it to the IED model
  *
@@ -49,6 +49,15 @@ extern "C" {
 #define IEC61850_REPORTSETTINGS_OPT_FIELDS 16
 #define IEC61850_REPORTSETTINGS_INTG_PD 32
 
+/** the MMS value cache of all logical devices is populated by IedServer_create (default) */
+#define IEC61850_VALUE_CACHE_EAGER 0
+
+/** the MMS value cache of a logical device is populated when it is accessed the first time */
+#define IEC61850_VALUE_CACHE_ON_ACCESS 1
+
+/** like IEC61850_VALUE_CACHE_ON_ACCESS - additionally the remaining logical devices are populated by a background thread started by IedServer_start */
+#define IEC61850_VALUE_CACHE_BACKGROUND 2
+
 /**
  * \brief Configuration object to configure IEC 61850 stack features
  */
@@ -109,6 +118,9 @@ struct sIedServerConfig
 
     /** for each configurable ReportSetting there is a separate flag (default: Dyn = enable write for all) */
     uint8_t reportSettingsWritable;
+
+    /** when the MMS value cache is populated (default: IEC61850_VALUE_CACHE_EAGER) */
+    uint8_t valueCacheMode;
 };
 
 /**
@@ -419,6 +431,38 @@ IedServerConfig_setReportSetting(IedServerConfig self, uint8_t setting, bool isD
 LIB61850_API bool
 IedServerConfig_getReportSetting(IedServerConfig self, uint8_t setting);
 
+/**
+ * \brief Set when the MMS value cache of the logical devices is populated
+ *
+ * With IEC61850_VALUE_CACHE_EAGER (default) IedServer_create creates the value cache of all logical devices,
+ * installs the default values, creates the control objects, and resolves the members of all data sets.
+ * The startup time is proportional to the size of the data model.
+ *
+ * With IEC61850_VALUE_CACHE_ON_ACCESS this is done separately for each logical device when the logical
+ * device is accessed the first time (by a client, by the IedServer_update... and IedServer_get... functions,
+ * or when a data set with members in the logical device is used by a control block). With
+ * IEC61850_VALUE_CACHE_BACKGROUND the logical devices that have not been accessed are additionally
+ * populated by a background thread after IedServer_start. Buffered report control blocks and log control
+ * blocks start to monitor their data sets when the server is created. The logical devices with members of
+ * these data sets are populated by IedServer_create also in the lazy modes.
+ *
+ * NOTE: In the lazy modes DataAttribute.mmsValue is not connected to the value cache before the logical device
+ * is populated. Values have to be accessed by the IedServer functions or IedServer_populateValueCache has to be
+ * called before DataAttribute.mmsValue is accessed directly.
+ *
+ * \param mode one of IEC61850_VALUE_CACHE_EAGER, IEC61850_VALUE_CACHE_ON_ACCESS, IEC61850_VALUE_CACHE_BACKGROUND
+ */
+LIB61850_API void
+IedServerConfig_setValueCacheMode(IedServerConfig self, uint8_t mode);
+
+/**
+ * \brief Get the configured value cache mode
+ *
+ * \return one of IEC61850_VALUE_CACHE_EAGER, IEC61850_VALUE_CACHE_ON_ACCESS, IEC61850_VALUE_CACHE_BACKGROUND
+ */
+LIB61850_API uint8_t
+IedServerConfig_getValueCacheMode(IedServerConfig self);
+
 /**
  * An opaque handle for an IED server instance
  */
@@ -475,6 +519,43 @@ IedServer_createWithConfig(IedModel* dataModel, TLSConfiguration tlsConfiguratio
 LIB61850_API void
 IedServer_destroy(IedServer self);
 
+/**
+ * \brief Time spent in the phases of the server startup
+ */
+typedef struct
+{
+    uint32_t mmsMappingTimeInUs; /**< creation of the MMS data model and the control block instances */
+    uint32_t mmsServerTimeInUs; /**< creation of the MMS server */
+    uint32_t valueCacheTimeInUs; /**< value caches, default values and control objects populated by IedServer_create */
+    uint32_t dataSetTimeInUs; /**< resolving the data set members by IedServer_create */
+    uint32_t controlBlockTimeInUs; /**< activation of buffered reports and setting groups */
+    uint32_t totalTimeInUs; /**< total time of IedServer_create */
+
+    int numberOfDomains; /**< number of logical devices */
+    int numberOfPopulatedDomains; /**< number of logical devices with populated value cache */
+    uint32_t lazyPopulationTimeInUs; /**< time spent populating logical devices after IedServer_create */
+} IedServerStartupProfile;
+
+/**
+ * \brief Get the startup profile of the server
+ *
+ * \param self the instance of IedServer to operate on.
+ * \param profile user provided variable to store the profile
+ */
+LIB61850_API void
+IedServer_getStartupProfile(IedServer self, IedServerStartupProfile* profile);
+
+/**
+ * \brief Populate the MMS value cache of all logical devices that have not been populated yet
+ *
+ * Only required when the value cache mode is IEC61850_VALUE_CACHE_ON_ACCESS or IEC61850_VALUE_CACHE_BACKGROUND
+ * (see \ref IedServerConfig_setValueCacheMode) and the application accesses DataAttribute.mmsValue directly.
+ *
+ * \param self the instance of IedServer to operate on.
+ */
+LIB61850_API void
+IedServer_populateValueCache(IedServer self);
+
 /**
  * \brief Add a new local access point (server will listen to provided IP/port combination)
  *
@@ -34,6 +34,21 @@
 
 typedef struct sIedConnectionOutstandingCall* IedConnectionOutstandingCall;
 
+typedef struct sICVariableSpecCache* ICVariableSpecCache;
+
+/* identifies the cached type of a value from ICVariableSpecCache_getValue */
+typedef struct
+{
+    MmsVariableSpecification* typeSpec;
+    uint32_t generation;
+} ICCachedValueKey;
+
+typedef struct sICLogicalDevice
+{
+    char* name;
+    LinkedList variables;
+} ICLogicalDevice;
+
 struct sIedConnectionOutstandingCall {
     bool used;
     uint32_t invokeId;
@@ -57,8 +72,17 @@ struct sIedConnection
     MmsConnection connection;
     IedConnectionState state;
     LinkedList enabledReports;
+
+    /* hash index of the enabled reports by RptID (size is a power of two) */
+    ClientReport* reportIndex;
+    int reportIndexSize;
+    int numberOfIndexedReports;
     LinkedList logicalDevices;
 
+    /* variable specifications by domain/item ID (NULL when the cache is disabled) */
+    Semaphore varSpecCacheLock;
+    ICVariableSpecCache varSpecCache;
+
     Semaphore clientControlsLock;
     LinkedList clientControls;
 
@@ -69,6 +93,7 @@ struct sIedConnection
 
     Semaphore outstandingCallsLock;
     IedConnectionOutstandingCall outstandingCalls;
+    int numberOfOutstandingCalls;
 
     IedConnectionClosedHandler connectionCloseHandler;
     void* connectionClosedParameter;
@@ -118,6 +143,10 @@ clientReportControlBlock_updateValues(ClientReportControlBlock self, MmsValue* v
 LIB61850_INTERNAL void
 iedConnection_handleReport(IedConnection self, MmsValue* value);
 
+/* handle the encoded information report - returns false when the message has to be handled by the generic decoder */
+LIB61850_INTERNAL bool
+iedConnection_handleReportMessage(IedConnection self, uint8_t* buffer, int maxBufPos);
+
 LIB61850_INTERNAL IedClientError
 iedConnection_mapMmsErrorToIedError(MmsError mmsError);
 
@@ -133,6 +162,46 @@ iedConnection_releaseOutstandingCall(IedConnection self, IedConnectionOutstandin
 LIB61850_INTERNAL IedConnectionOutstandingCall
 iedConnection_lookupOutstandingCall(IedConnection self, uint32_t invokeId);
 
+LIB61850_INTERNAL ICLogicalDevice*
+ICLogicalDevice_create(const char* name);
+
+LIB61850_INTERNAL void
+ICLogicalDevice_setVariableList(ICLogicalDevice* self, LinkedList variables);
+
+LIB61850_INTERNAL void
+ICLogicalDevice_destroy(ICLogicalDevice* self);
+
+LIB61850_INTERNAL ICVariableSpecCache
+ICVariableSpecCache_create(void);
+
+LIB61850_INTERNAL void
+ICVariableSpecCache_destroy(ICVariableSpecCache self);
+
+LIB61850_INTERNAL void
+ICVariableSpecCache_clear(ICVariableSpecCache self);
+
+/* the cache takes the ownership of the specification */
+LIB61850_INTERNAL bool
+ICVariableSpecCache_add(ICVariableSpecCache self, const char* domainId, const char* itemId, MmsVariableSpecification* typeSpec);
+
+/* remove the entry that contains the specification of the variable */
+LIB61850_INTERNAL void
+ICVariableSpecCache_remove(ICVariableSpecCache self, const char* domainId, const char* itemId);
+
+/* get the cached specification of the variable or of a component of a cached variable (the specification
+ * is owned by the cache and only valid until the cache is changed) */
+LIB61850_INTERNAL MmsVariableSpecification*
+ICVariableSpecCache_lookup(ICVariableSpecCache self, const char* domainId, const char* itemId);
+
+/* get a value of the cached type of the variable to decode a read response into (taken from the value pool
+ * or created) - returns NULL when the type is not cached */
+LIB61850_INTERNAL MmsValue*
+ICVariableSpecCache_getValue(ICVariableSpecCache self, const char* domainId, const char* itemId, ICCachedValueKey* key);
+
+/* give a value from ICVariableSpecCache_getValue back to the value pool (deleted when the type was removed) */
+LIB61850_INTERNAL void
+ICVariableSpecCache_releaseValue(ICVariableSpecCache self, ICCachedValueKey* key, MmsValue* value);
+
 LIB61850_INTERNAL ClientReport
 ClientReport_create(void);
 
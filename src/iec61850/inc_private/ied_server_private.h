@@ -82,6 +82,21 @@ struct sIedServer
     uint8_t timeQuality; /* user settable time quality for internally updated times */
 
     bool running;
+
+    /* value cache population (see IedServerConfig_setValueCacheMode) */
+    uint8_t valueCacheMode;
+    /* flags are set with release semantics and read without the value cache lock (see platform_atomic.h) */
+    volatile int32_t* populatedDomains; /* one flag for each MMS domain (logical device) */
+    volatile int32_t valueCachePopulated; /* all domains are populated */
+    volatile int32_t dataSetsResolved; /* all data set members are resolved */
+
+#if (CONFIG_MMS_THREADLESS_STACK != 1)
+    Semaphore valueCacheLock;
+    Thread valueCacheThread;
+    bool valueCacheThreadRunning;
+#endif
+
+    IedServerStartupProfile startupProfile;
 };
 
 
@@ -115,4 +130,16 @@ private_IedServer_addNewClientConnection(IedServer self, ClientConnection newCli
 LIB61850_INTERNAL void
 private_IedServer_removeClientConnection(IedServer self, ClientConnection clientConnection);
 
+/**
+ * \brief Populate the value cache of the domain (when not already populated)
+ */
+LIB61850_INTERNAL void
+private_IedServer_populateValueCache(IedServer self, MmsDomain* domain);
+
+/**
+ * \brief Connect the data set entries to the cached values (populates the value caches of the member domains)
+ */
+LIB61850_INTERNAL void
+private_IedServer_resolveDataSet(IedServer self, DataSet* dataSet);
+
 #endif /* IED_SERVER_PRIVATE_H_ */
@@ -49,9 +49,6 @@ MmsMapping_create(IedModel* model, IedServer iedServer);
 LIB61850_INTERNAL MmsDevice*
 MmsMapping_getMmsDeviceModel(MmsMapping* mapping);
 
-LIB61850_INTERNAL void
-MmsMapping_initializeControlObjects(MmsMapping* self);
-
 LIB61850_INTERNAL void
 MmsMapping_configureSettingGroups(MmsMapping* self);
 
@@ -118,6 +115,9 @@ MmsMapping_setGooseInterfaceId(MmsMapping* self,  LogicalNode* ln, const char* g
 LIB61850_INTERNAL void
 MmsMapping_addControlObject(MmsMapping* self, ControlObject* controlObject);
 
+LIB61850_INTERNAL LinkedList
+MmsMapping_getNextControlObjectElement(LinkedList element);
+
 LIB61850_INTERNAL char*
 MmsMapping_getNextNameElement(char* name);
 
@@ -261,6 +261,10 @@ struct sLocbTrkInstance
 struct sMmsMapping {
     IedModel* model;
     MmsDevice* mmsDevice;
+
+    /* owner of the type specifications shared by logical nodes and data objects */
+    struct sTypeSpecCache* typeSpecCache;
+
     MmsServer mmsServer;
     LinkedList reportControls;
 
@@ -285,6 +289,7 @@ struct sMmsMapping {
 #endif
 
     LinkedList controlObjects;
+    LinkedList lastControlObject; /* last element of controlObjects */
     uint64_t nextControlTimeout; /* next timeout in one of the control state machines */
 
     LinkedList attributeAccessHandlers;
@@ -30,11 +30,14 @@
 #include "stack_config.h"
 #include "ied_server_private.h"
 #include "hal_thread.h"
+#include "hal_time.h"
 #include "reporting.h"
+#include "logging.h"
 
 #include "libiec61850_platform_includes.h"
 #include "mms_sv.h"
 #include "mms_goose.h"
+#include "platform_atomic.h"
 
 #ifndef DEBUG_IED_SERVER
 #define DEBUG_IED_SERVER 0
@@ -42,10 +45,9 @@
 
 #if (CONFIG_IEC61850_CONTROL_SERVICE == 1)
 static bool
-createControlObjects(IedServer self, MmsDomain* domain, char* lnName, MmsVariableSpecification* typeSpec, char* namePrefix)
+createControlObjects(IedServer self, MmsDomain* domain, char* lnName, MmsVariableSpecification* typeSpec, char* namePrefix,
+        LinkedList controlObjects)
 {
-    MmsMapping* mapping = self->mmsMapping;
-
     bool success = false;
 
     if (typeSpec->type == MMS_STRUCTURE) {
@@ -138,10 +140,10 @@ createControlObjects(IedServer self, MmsDomain* domain, char* lnName, MmsVariabl
                     if (hasSBO)
                         controlObject->sbo = MmsValue_getElement(structure, sBOIndex);
 
-                    MmsMapping_addControlObject(mapping, controlObject);
+                    LinkedList_add(controlObjects, controlObject);
                 }
                 else {
-                    if (createControlObjects(self, domain, lnName, coSpec, objectName) == false)
+                    if (createControlObjects(self, domain, lnName, coSpec, objectName, controlObjects) == false)
                         goto exit_function;
                 }
             }
@@ -156,72 +158,65 @@ exit_function:
 #endif /* (CONFIG_IEC61850_CONTROL_SERVICE == 1) */
 
 static bool
-createMmsServerCache(IedServer self)
+createMmsServerCache(IedServer self, MmsDomain* logicalDevice, LinkedList controlObjects)
 {
     assert(self != NULL);
 
     bool success = false;
 
-    int domain = 0;
-
-    for (domain = 0; domain < self->mmsDevice->domainCount; domain++) {
-
-        /* Install all top level MMS named variables (=Logical nodes) in the MMS server cache */
-        MmsDomain* logicalDevice = self->mmsDevice->domains[domain];
-
-        int i;
+    /* Install all top level MMS named variables (=Logical nodes) in the MMS server cache */
+    int i;
 
-        for (i = 0; i < logicalDevice->namedVariablesCount; i++) {
-            char* lnName = logicalDevice->namedVariables[i]->name;
+    for (i = 0; i < logicalDevice->namedVariablesCount; i++) {
+        char* lnName = logicalDevice->namedVariables[i]->name;
 
-            if (DEBUG_IED_SERVER)
-                printf("IED_SERVER: Insert into cache %s - %s\n", logicalDevice->domainName, lnName);
+        if (DEBUG_IED_SERVER)
+            printf("IED_SERVER: Insert into cache %s - %s\n", logicalDevice->domainName, lnName);
 
-            int fcCount = logicalDevice->namedVariables[i]->typeSpec.structure.elementCount;
-            int j;
+        int fcCount = logicalDevice->namedVariables[i]->typeSpec.structure.elementCount;
+        int j;
 
-            for (j = 0; j < fcCount; j++) {
-                MmsVariableSpecification* fcSpec = logicalDevice->namedVariables[i]->typeSpec.structure.elements[j];
+        for (j = 0; j < fcCount; j++) {
+            MmsVariableSpecification* fcSpec = logicalDevice->namedVariables[i]->typeSpec.structure.elements[j];
 
-                char* fcName = fcSpec->name;
+            char* fcName = fcSpec->name;
 
 #if (CONFIG_IEC61850_CONTROL_SERVICE == 1)
-                if (strcmp(fcName, "CO") == 0) {
-                    createControlObjects(self, logicalDevice, lnName, fcSpec, NULL);
-                }
-                else
+            if (strcmp(fcName, "CO") == 0) {
+                createControlObjects(self, logicalDevice, lnName, fcSpec, NULL, controlObjects);
+            }
+            else
 #endif /* (CONFIG_IEC61850_CONTROL_SERVICE == 1) */
 
-                if ((strcmp(fcName, "BR") != 0) && (strcmp(fcName, "RP") != 0)
+            if ((strcmp(fcName, "BR") != 0) && (strcmp(fcName, "RP") != 0)
 
 #if (CONFIG_INCLUDE_GOOSE_SUPPORT == 1)
-                        && (strcmp(fcName, "GO") != 0)
+                    && (strcmp(fcName, "GO") != 0)
 #endif
 
 #if (CONFIG_IEC61850_SAMPLED_VALUES_SUPPORT == 1)
-                        && (strcmp(fcName, "MS") != 0) && (strcmp(fcName, "US") != 0)
+                    && (strcmp(fcName, "MS") != 0) && (strcmp(fcName, "US") != 0)
 #endif
 
 #if (CONFIG_IEC61850_LOG_SERVICE == 1)
-                        && (strcmp(fcName, "LG") != 0)
+                    && (strcmp(fcName, "LG") != 0)
 #endif
 
-                   )
-                {
-                    char variableName[65];
+               )
+            {
+                char variableName[65];
 
-                    StringUtils_createStringInBuffer(variableName, 65, 3, lnName, "$", fcName);
+                StringUtils_createStringInBuffer(variableName, 65, 3, lnName, "$", fcName);
 
-                    MmsValue* defaultValue = MmsValue_newDefaultValue(fcSpec);
+                MmsValue* defaultValue = MmsValue_newDefaultValue(fcSpec);
 
-                    if (defaultValue == NULL)
-                        goto exit_function;
+                if (defaultValue == NULL)
+                    goto exit_function;
 
-                    if (DEBUG_IED_SERVER)
-                        printf("ied_server.c: Insert into cache %s - %s\n", logicalDevice->domainName, variableName);
+                if (DEBUG_IED_SERVER)
+                    printf("ied_server.c: Insert into cache %s - %s\n", logicalDevice->domainName, variableName);
 
-                    MmsServer_insertIntoCache(self->mmsServer, logicalDevice, variableName, defaultValue);
-                }
+                MmsServer_insertIntoCache(self->mmsServer, logicalDevice, variableName, defaultValue);
             }
         }
     }
@@ -233,7 +228,7 @@ exit_function:
 }
 
 static void
-installDefaultValuesForDataAttribute(IedServer self, DataAttribute* dataAttribute,
+installDefaultValuesForDataAttribute(IedServer self, MmsDomain* domain, DataAttribute* dataAttribute,
         char* objectReference, int position)
 {
     sprintf(objectReference + position, ".%s", dataAttribute->name);
@@ -244,23 +239,6 @@ installDefaultValuesForDataAttribute(IedServer self, DataAttribute* dataAttribut
 
     MmsMapping_createMmsVariableNameFromObjectReference(objectReference, dataAttribute->fc, mmsVariableName);
 
-    char domainName[65];
-    char ldName[65];
-
-    StringUtils_copyStringMax(domainName, 65, self->model->name);
-
-    MmsMapping_getMmsDomainFromObjectReference(objectReference, ldName);
-
-    StringUtils_appendString(domainName, 65, ldName);
-
-    MmsDomain* domain = MmsDevice_getDomain(self->mmsDevice, domainName);
-
-    if (domain == NULL) {
-        if (DEBUG_IED_SERVER)
-            printf("Error domain (%s) not found for %s!\n", domainName, objectReference);
-        return;
-    }
-
     MmsValue* cacheValue = MmsServer_getValueFromCache(self->mmsServer, domain, mmsVariableName);
 
     dataAttribute->mmsValue = cacheValue;
@@ -284,14 +262,14 @@ installDefaultValuesForDataAttribute(IedServer self, DataAttribute* dataAttribut
     DataAttribute* subDataAttribute = (DataAttribute*) dataAttribute->firstChild;
 
     while (subDataAttribute != NULL) {
-        installDefaultValuesForDataAttribute(self, subDataAttribute, objectReference, childPosition);
+        installDefaultValuesForDataAttribute(self, domain, subDataAttribute, objectReference, childPosition);
 
         subDataAttribute = (DataAttribute*) subDataAttribute->sibling;
     }
 }
 
 static void
-installDefaultValuesForDataObject(IedServer self, DataObject* dataObject,
+installDefaultValuesForDataObject(IedServer self, MmsDomain* domain, DataObject* dataObject,
         char* objectReference, int position)
 {
     if (dataObject->elementCount > 0) {
@@ -309,140 +287,457 @@ installDefaultValuesForDataObject(IedServer self, DataObject* dataObject,
 
     while (childNode != NULL) {
         if (childNode->modelType == DataObjectModelType) {
-            installDefaultValuesForDataObject(self, (DataObject*) childNode, objectReference, childPosition);
+            installDefaultValuesForDataObject(self, domain, (DataObject*) childNode, objectReference, childPosition);
         }
         else if (childNode->modelType == DataAttributeModelType) {
-            installDefaultValuesForDataAttribute(self, (DataAttribute*) childNode, objectReference, childPosition);
+            installDefaultValuesForDataAttribute(self, domain, (DataAttribute*) childNode, objectReference, childPosition);
         }
 
         childNode = childNode->sibling;
     }
 }
 
+/* This will also connect cached MmsValues to DataAttributes */
 static void
-installDefaultValuesInCache(IedServer self)
+installDefaultValuesInCache(IedServer self, LogicalDevice* logicalDevice, MmsDomain* domain)
 {
-    IedModel* model = self->model;
-
     char objectReference[130];
 
-    LogicalDevice* logicalDevice = model->firstChild;
+    sprintf(objectReference, "%s", logicalDevice->name);
 
-    while (logicalDevice != NULL) {
-        sprintf(objectReference, "%s", logicalDevice->name);
+    LogicalNode* logicalNode = (LogicalNode*) logicalDevice->firstChild;
 
-        LogicalNode* logicalNode = (LogicalNode*) logicalDevice->firstChild;
+    char* nodeReference = objectReference + strlen(objectReference);
 
-        char* nodeReference = objectReference + strlen(objectReference);
+    while (logicalNode != NULL) {
+        sprintf(nodeReference, "/%s", logicalNode->name);
 
-        while (logicalNode != NULL) {
-            sprintf(nodeReference, "/%s", logicalNode->name);
+        DataObject* dataObject = (DataObject*) logicalNode->firstChild;
 
-            DataObject* dataObject = (DataObject*) logicalNode->firstChild;
+        int refPosition = strlen(objectReference);
 
-            int refPosition = strlen(objectReference);
+        while (dataObject != NULL) {
+            installDefaultValuesForDataObject(self, domain, dataObject, objectReference, refPosition);
 
-            while (dataObject != NULL) {
-                installDefaultValuesForDataObject(self, dataObject, objectReference, refPosition);
+            dataObject = (DataObject*) dataObject->sibling;
+        }
 
-                dataObject = (DataObject*) dataObject->sibling;
-            }
+        logicalNode = (LogicalNode*) logicalNode->sibling;
+    }
+}
 
-            logicalNode = (LogicalNode*) logicalNode->sibling;
-        }
+static uint32_t
+getElapsedTimeInUs(uint64_t startTimeInNs)
+{
+    return (uint32_t) ((Hal_getTimeInNs() - startTimeInNs) / 1000);
+}
+
+static void
+lockValueCache(IedServer self)
+{
+#if (CONFIG_MMS_THREADLESS_STACK != 1)
+    Semaphore_wait(self->valueCacheLock);
+#else
+    (void)self;
+#endif
+}
 
+static void
+unlockValueCache(IedServer self)
+{
+#if (CONFIG_MMS_THREADLESS_STACK != 1)
+    Semaphore_post(self->valueCacheLock);
+#else
+    (void)self;
+#endif
+}
+
+static int
+getDomainIndex(IedServer self, MmsDomain* domain)
+{
+    int i;
+
+    for (i = 0; i < self->mmsDevice->domainCount; i++) {
+        if (self->mmsDevice->domains[i] == domain)
+            return i;
+    }
+
+    return -1;
+}
+
+/* has to be called with the value cache lock */
+static void
+populateDomain(IedServer self, int domainIndex, LogicalDevice* logicalDevice)
+{
+    if (Atomic_load32(&(self->populatedDomains[domainIndex])))
+        return;
+
+    uint64_t startTime = Hal_getTimeInNs();
+
+    MmsDomain* domain = self->mmsDevice->domains[domainIndex];
+
+    LinkedList controlObjects = LinkedList_create();
+
+    createMmsServerCache(self, domain, controlObjects);
+
+    installDefaultValuesInCache(self, logicalDevice, domain);
+
+#if (CONFIG_IEC61850_CONTROL_SERVICE == 1)
+    /* control objects are visible to the server only after they are completely initialized */
+    LinkedList element = LinkedList_getNext(controlObjects);
+
+    while (element) {
+        ControlObject* controlObject = (ControlObject*) LinkedList_getData(element);
+
+        ControlObject_initialize(controlObject);
+
+        MmsMapping_addControlObject(self->mmsMapping, controlObject);
+
+        element = LinkedList_getNext(element);
+    }
+#endif /* (CONFIG_IEC61850_CONTROL_SERVICE == 1) */
+
+    LinkedList_destroyStatic(controlObjects);
+
+    /* publish the flags after the cache values and control objects are visible to other threads */
+    Atomic_store32(&(self->populatedDomains[domainIndex]), 1);
+    self->startupProfile.numberOfPopulatedDomains++;
+
+    if (self->startupProfile.numberOfPopulatedDomains == self->mmsDevice->domainCount)
+        Atomic_store32(&(self->valueCachePopulated), 1);
+
+    self->startupProfile.lazyPopulationTimeInUs += getElapsedTimeInUs(startTime);
+}
+
+static LogicalDevice*
+getLogicalDeviceOfDomain(IedServer self, int domainIndex)
+{
+    /* MMS domains are created in the order of the logical devices */
+    LogicalDevice* logicalDevice = self->model->firstChild;
+
+    while ((domainIndex > 0) && logicalDevice) {
         logicalDevice = (LogicalDevice*) logicalDevice->sibling;
+        domainIndex--;
+    }
+
+    return logicalDevice;
+}
+
+/* has to be called with the value cache lock */
+static void
+populateDomainWithIndex(IedServer self, int domainIndex)
+{
+    if ((domainIndex != -1) && (Atomic_load32(&(self->populatedDomains[domainIndex])) == 0)) {
+        LogicalDevice* logicalDevice = getLogicalDeviceOfDomain(self, domainIndex);
+
+        if (logicalDevice)
+            populateDomain(self, domainIndex, logicalDevice);
     }
 }
 
+void
+private_IedServer_populateValueCache(IedServer self, MmsDomain* domain)
+{
+    if ((self->populatedDomains == NULL) || Atomic_load32(&(self->valueCachePopulated)))
+        return;
+
+    lockValueCache(self);
+
+    populateDomainWithIndex(self, getDomainIndex(self, domain));
+
+    unlockValueCache(self);
+}
+
 static void
-updateDataSetsWithCachedValues(IedServer self)
+populateValueCacheForNode(IedServer self, const ModelNode* node)
 {
-    DataSet* dataSet = self->model->dataSets;
+    if ((self->populatedDomains == NULL) || Atomic_load32(&(self->valueCachePopulated)))
+        return;
 
-    int iedNameLength = strlen(self->model->name);
+    while (node->modelType != LogicalDeviceModelType)
+        node = node->parent;
 
-    if (iedNameLength <= 64) {
+    lockValueCache(self);
 
-        while (dataSet != NULL) {
+    int domainIndex = 0;
 
-            DataSetEntry* dataSetEntry = dataSet->fcdas;
+    LogicalDevice* logicalDevice = self->model->firstChild;
 
-            while (dataSetEntry != NULL) {
+    while (logicalDevice) {
+        if ((const ModelNode*) logicalDevice == node) {
+            populateDomain(self, domainIndex, logicalDevice);
+            break;
+        }
+
+        domainIndex++;
+        logicalDevice = (LogicalDevice*) logicalDevice->sibling;
+    }
+
+    unlockValueCache(self);
+}
+
+static void
+valueCacheAccessHandler(void* parameter, MmsDomain* domain)
+{
+    private_IedServer_populateValueCache((IedServer) parameter, domain);
+}
 
-                char domainName[65];
+/* has to be called with the value cache lock */
+static void
+resolveDataSetEntries(IedServer self, DataSet* dataSet)
+{
+    DataSetEntry* dataSetEntry = dataSet->fcdas;
 
-                StringUtils_concatString(domainName, 65, self->model->name, dataSetEntry->logicalDeviceName);
+    while (dataSetEntry != NULL) {
 
-                MmsDomain* domain = MmsDevice_getDomain(self->mmsDevice, domainName);
+        if (dataSetEntry->value == NULL) {
 
-                char variableName[66];
-                variableName[0] = 0;
+            char domainName[65];
 
-                StringUtils_appendString(variableName, 66, dataSetEntry->variableName);
+            StringUtils_concatString(domainName, 65, self->model->name, dataSetEntry->logicalDeviceName);
 
-                MmsVariableSpecification* typeSpec = NULL;
+            MmsDomain* domain = MmsDevice_getDomain(self->mmsDevice, domainName);
 
-                MmsValue* value = MmsServer_getValueFromCacheEx(self->mmsServer, domain, variableName, &typeSpec);
+            if (Atomic_load32(&(self->valueCachePopulated)) == 0)
+                populateDomainWithIndex(self, getDomainIndex(self, domain));
 
-                if (value == NULL) {
-                    if (DEBUG_IED_SERVER) {
-                        printf("IED_SERVER: LD: %s dataset: %s : error cannot get value from cache for %s -> %s!\n",
-                                dataSet->logicalDeviceName, dataSet->name,
-                                dataSetEntry->logicalDeviceName,
-                                dataSetEntry->variableName);
-                    }
-                }
-                else {
-                    /* check if array element */
+            char variableName[66];
+            variableName[0] = 0;
+
+            StringUtils_appendString(variableName, 66, dataSetEntry->variableName);
+
+            MmsVariableSpecification* typeSpec = NULL;
 
-                    if (dataSetEntry->index != -1) {
-                        if (typeSpec->type == MMS_ARRAY) {
-                            MmsValue* elementValue = MmsValue_getElement(value, dataSetEntry->index);
+            MmsValue* value = MmsServer_getValueFromCacheEx(self->mmsServer, domain, variableName, &typeSpec);
+
+            if (value == NULL) {
+                if (DEBUG_IED_SERVER) {
+                    printf("IED_SERVER: LD: %s dataset: %s : error cannot get value from cache for %s -> %s!\n",
+                            dataSet->logicalDeviceName, dataSet->name,
+                            dataSetEntry->logicalDeviceName,
+                            dataSetEntry->variableName);
+                }
+            }
+            else {
+                /* check if array element */
 
-                            if (elementValue) {
+                if (dataSetEntry->index != -1) {
+                    if (typeSpec->type == MMS_ARRAY) {
+                        MmsValue* elementValue = MmsValue_getElement(value, dataSetEntry->index);
 
-                                if (dataSetEntry->componentName) {
-                                    MmsVariableSpecification* elementType = typeSpec->typeSpec.array.elementTypeSpec;
+                        if (elementValue) {
 
-                                    MmsValue* subElementValue = MmsVariableSpecification_getChildValue(elementType, elementValue, dataSetEntry->componentName);
+                            if (dataSetEntry->componentName) {
+                                MmsVariableSpecification* elementType = typeSpec->typeSpec.array.elementTypeSpec;
 
-                                    if (subElementValue) {
-                                        dataSetEntry->value = subElementValue;
-                                    }
-                                    else {
-                                        if (DEBUG_IED_SERVER)
-                                            printf("IED_SERVER: ERROR - component %s of array element not found\n", dataSetEntry->componentName);
-                                    }
+                                MmsValue* subElementValue = MmsVariableSpecification_getChildValue(elementType, elementValue, dataSetEntry->componentName);
 
+                                if (subElementValue) {
+                                    dataSetEntry->value = subElementValue;
                                 }
                                 else {
-                                    dataSetEntry->value = elementValue;
+                                    if (DEBUG_IED_SERVER)
+                                        printf("IED_SERVER: ERROR - component %s of array element not found\n", dataSetEntry->componentName);
                                 }
+
                             }
                             else {
-                                if (DEBUG_IED_SERVER)
-                                    printf("IED_SERVER: ERROR - array element %i not found\n", dataSetEntry->index);
+                                dataSetEntry->value = elementValue;
                             }
                         }
                         else {
                             if (DEBUG_IED_SERVER)
-                                printf("IED_SERVER: ERROR - variable %s/%s is not an array\n", dataSetEntry->logicalDeviceName, dataSetEntry->variableName);
+                                printf("IED_SERVER: ERROR - array element %i not found\n", dataSetEntry->index);
                         }
                     }
                     else {
-                        dataSetEntry->value = value;
+                        if (DEBUG_IED_SERVER)
+                            printf("IED_SERVER: ERROR - variable %s/%s is not an array\n", dataSetEntry->logicalDeviceName, dataSetEntry->variableName);
                     }
                 }
-
-                dataSetEntry = dataSetEntry->sibling;
+                else {
+                    dataSetEntry->value = value;
+                }
             }
+        }
+
+        dataSetEntry = dataSetEntry->sibling;
+    }
+}
+
+void
+private_IedServer_resolveDataSet(IedServer self, DataSet* dataSet)
+{
+    if ((self->populatedDomains == NULL) || Atomic_load32(&(self->dataSetsResolved)))
+        return;
+
+    if (strlen(self->model->name) > 64)
+        return;
+
+    lockValueCache(self);
+
+    resolveDataSetEntries(self, dataSet);
+
+    unlockValueCache(self);
+}
+
+static void
+updateDataSetsWithCachedValues(IedServer self)
+{
+    DataSet* dataSet = self->model->dataSets;
+
+    int iedNameLength = strlen(self->model->name);
+
+    if (iedNameLength <= 64) {
+
+        lockValueCache(self);
+
+        while (dataSet != NULL) {
+            resolveDataSetEntries(self, dataSet);
 
             dataSet = dataSet->sibling;
         }
+
+        if (Atomic_load32(&(self->valueCachePopulated)))
+            Atomic_store32(&(self->dataSetsResolved), 1);
+
+        unlockValueCache(self);
+    }
+}
+
+void
+IedServer_populateValueCache(IedServer self)
+{
+    if ((self->populatedDomains == NULL) || Atomic_load32(&(self->dataSetsResolved)))
+        return;
+
+    int domainIndex = 0;
+
+    LogicalDevice* logicalDevice = self->model->firstChild;
+
+    while (logicalDevice) {
+        lockValueCache(self);
+
+        populateDomain(self, domainIndex, logicalDevice);
+
+        unlockValueCache(self);
+
+        domainIndex++;
+        logicalDevice = (LogicalDevice*) logicalDevice->sibling;
+    }
+
+    updateDataSetsWithCachedValues(self);
+}
+
+#if (CONFIG_MMS_THREADLESS_STACK != 1)
+static void*
+valueCachePopulationThread(void* parameter)
+{
+    IedServer self = (IedServer) parameter;
+
+    int domainIndex = 0;
+
+    LogicalDevice* logicalDevice = self->model->firstChild;
+
+    while (logicalDevice && self->valueCacheThreadRunning) {
+        lockValueCache(self);
+
+        populateDomain(self, domainIndex, logicalDevice);
+
+        unlockValueCache(self);
+
+        domainIndex++;
+        logicalDevice = (LogicalDevice*) logicalDevice->sibling;
+    }
+
+    if (self->valueCacheThreadRunning) {
+        updateDataSetsWithCachedValues(self);
+
+        if (DEBUG_IED_SERVER)
+            printf("IED_SERVER: value cache populated (%u us after start)\n", self->startupProfile.lazyPopulationTimeInUs);
+    }
+
+    return NULL;
+}
+#endif /* (CONFIG_MMS_THREADLESS_STACK != 1) */
+
+static bool
+initializeValueCache(IedServer self)
+{
+    self->populatedDomains = (volatile int32_t*) GLOBAL_CALLOC(self->mmsDevice->domainCount + 1, sizeof(int32_t));
+
+    if (self->populatedDomains == NULL)
+        return false;
+
+    self->startupProfile.numberOfDomains = self->mmsDevice->domainCount;
+
+    if (self->mmsDevice->domainCount == 0)
+        Atomic_store32(&(self->valueCachePopulated), 1);
+
+    MmsServer_installValueCacheAccessHandler(self->mmsServer, valueCacheAccessHandler, (void*) self);
+
+    return true;
+}
+
+static void
+deleteInitialValues(ModelNode* node)
+{
+    if (node->modelType == DataAttributeModelType) {
+        DataAttribute* dataAttribute = (DataAttribute*) node;
+
+        if (dataAttribute->mmsValue) {
+            MmsValue_delete(dataAttribute->mmsValue);
+            dataAttribute->mmsValue = NULL;
+        }
+    }
+
+    ModelNode* child = node->firstChild;
+
+    while (child) {
+        deleteInitialValues(child);
+
+        child = child->sibling;
+    }
+}
+
+/*
+ * Data attributes of logical devices that are not populated still refer to the initial values
+ * created by the model parser or the static model initializer. These values are not part of the
+ * value cache and have to be deleted before MmsMapping_destroy resets the references.
+ */
+static void
+deleteInitialValuesOfUnpopulatedDomains(IedServer self)
+{
+    int domainIndex = 0;
+
+    LogicalDevice* logicalDevice = self->model->firstChild;
+
+    while (logicalDevice) {
+        if ((self->populatedDomains == NULL) || (Atomic_load32(&(self->populatedDomains[domainIndex])) == 0))
+            deleteInitialValues((ModelNode*) logicalDevice);
+
+        domainIndex++;
+        logicalDevice = (LogicalDevice*) logicalDevice->sibling;
     }
 }
 
+#if (CONFIG_IEC61850_LOG_SERVICE == 1)
+static void
+resolveDataSetsOfLogControls(IedServer self)
+{
+    /* LCBs are bound to their data sets when they are created */
+    LinkedList element = LinkedList_getNext(self->mmsMapping->logControls);
+
+    while (element) {
+        LogControl* logControl = (LogControl*) LinkedList_getData(element);
+
+        if (logControl->dataSet)
+            private_IedServer_resolveDataSet(self, logControl->dataSet);
+
+        element = LinkedList_getNext(element);
+    }
+}
+#endif /* (CONFIG_IEC61850_LOG_SERVICE == 1) */
 
 IedServer
 IedServer_createWithConfig(IedModel* dataModel, TLSConfiguration tlsConfiguration, IedServerConfig serverConfiguration)
@@ -450,6 +745,9 @@ IedServer_createWithConfig(IedModel* dataModel, TLSConfiguration tlsConfiguratio
     IedServer self = (IedServer) GLOBAL_CALLOC(1, sizeof(struct sIedServer));
 
     if (self) {
+        uint64_t startTime = Hal_getTimeInNs();
+        uint64_t phaseStartTime = startTime;
+
         self->model = dataModel;
 
         self->running = false;
@@ -515,12 +813,25 @@ IedServer_createWithConfig(IedModel* dataModel, TLSConfiguration tlsConfiguratio
         }
 #endif
 
+        self->valueCacheMode = IEC61850_VALUE_CACHE_EAGER;
+
+        if (serverConfiguration)
+            self->valueCacheMode = serverConfiguration->valueCacheMode;
+
+#if (CONFIG_MMS_THREADLESS_STACK != 1)
+        self->valueCacheLock = Semaphore_create(1);
+#endif
+
         self->mmsMapping = MmsMapping_create(dataModel, self);
 
+        self->startupProfile.mmsMappingTimeInUs = getElapsedTimeInUs(phaseStartTime);
+
         if (self->mmsMapping) {
 
             self->mmsDevice = MmsMapping_getMmsDeviceModel(self->mmsMapping);
 
+            phaseStartTime = Hal_getTimeInNs();
+
             self->mmsServer = MmsServer_create(self->mmsDevice, tlsConfiguration);
 
 #if (CONFIG_MMS_SERVER_CONFIG_SERVICES_AT_RUNTIME == 1)
@@ -540,20 +851,49 @@ IedServer_createWithConfig(IedModel* dataModel, TLSConfiguration tlsConfiguratio
 
             MmsMapping_installHandlers(self->mmsMapping);
 
-            createMmsServerCache(self);
+            self->startupProfile.mmsServerTimeInUs = getElapsedTimeInUs(phaseStartTime);
+
+            if (initializeValueCache(self) == false) {
+                IedServer_destroy(self);
+                return NULL;
+            }
 
             dataModel->initializer();
 
-            installDefaultValuesInCache(self); /* This will also connect cached MmsValues to DataAttributes */
+            phaseStartTime = Hal_getTimeInNs();
+
+            if (self->valueCacheMode == IEC61850_VALUE_CACHE_EAGER) {
+                int domainIndex = 0;
+
+                LogicalDevice* logicalDevice = dataModel->firstChild;
 
-            updateDataSetsWithCachedValues(self);
+                while (logicalDevice) {
+                    populateDomain(self, domainIndex, logicalDevice);
+
+                    domainIndex++;
+                    logicalDevice = (LogicalDevice*) logicalDevice->sibling;
+                }
+            }
+
+            self->startupProfile.valueCacheTimeInUs = getElapsedTimeInUs(phaseStartTime);
+
+            phaseStartTime = Hal_getTimeInNs();
+
+            if (self->valueCacheMode == IEC61850_VALUE_CACHE_EAGER)
+                updateDataSetsWithCachedValues(self);
+#if (CONFIG_IEC61850_LOG_SERVICE == 1)
+            else
+                resolveDataSetsOfLogControls(self);
+#endif
+
+            self->startupProfile.dataSetTimeInUs = getElapsedTimeInUs(phaseStartTime);
 
             self->clientConnections = LinkedList_create();
 
             /* default write access policy allows access to SP, SE and SV FCDAs but denies access to DC and CF FCDAs */
             self->writeAccessPolicies = ALLOW_WRITE_ACCESS_SP | ALLOW_WRITE_ACCESS_SV | ALLOW_WRITE_ACCESS_SE;
 
-            MmsMapping_initializeControlObjects(self->mmsMapping);
+            phaseStartTime = Hal_getTimeInNs();
 
 #if (CONFIG_IEC61850_REPORT_SERVICE == 1)
             Reporting_activateBufferedReports(self->mmsMapping);
@@ -563,6 +903,8 @@ IedServer_createWithConfig(IedModel* dataModel, TLSConfiguration tlsConfiguratio
             MmsMapping_configureSettingGroups(self->mmsMapping);
 #endif
 
+            self->startupProfile.controlBlockTimeInUs = getElapsedTimeInUs(phaseStartTime);
+
 #if (CONFIG_INCLUDE_GOOSE_SUPPORT)
 		    if (serverConfiguration) {
                 MmsMapping_useIntegratedGoosePublisher(self->mmsMapping, serverConfiguration->useIntegratedGoosePublisher);
@@ -570,6 +912,17 @@ IedServer_createWithConfig(IedModel* dataModel, TLSConfiguration tlsConfiguratio
 #endif
 
             IedServer_setTimeQuality(self, true, false, false, 10);
+
+            self->startupProfile.totalTimeInUs = getElapsedTimeInUs(startTime);
+
+            /* population time during IedServer_create is part of the other phases */
+            self->startupProfile.lazyPopulationTimeInUs = 0;
+
+            if (DEBUG_IED_SERVER)
+                printf("IED_SERVER: startup profile (us): mapping %u server %u cache %u data sets %u control blocks %u total %u\n",
+                        self->startupProfile.mmsMappingTimeInUs, self->startupProfile.mmsServerTimeInUs,
+                        self->startupProfile.valueCacheTimeInUs, self->startupProfile.dataSetTimeInUs,
+                        self->startupProfile.controlBlockTimeInUs, self->startupProfile.totalTimeInUs);
         }
         else {
             IedServer_destroy(self);
@@ -624,16 +977,23 @@ IedServer_destroy(IedServer self)
         if (self->localIpAddress != NULL)
             GLOBAL_FREEMEM(self->localIpAddress);
 
-        if (self->mmsMapping)
+        if (self->mmsMapping) {
+            deleteInitialValuesOfUnpopulatedDomains(self);
+
             MmsMapping_destroy(self->mmsMapping);
+        }
 
         LinkedList_destroyDeep(self->clientConnections, (LinkedListValueDeleteFunction) private_ClientConnection_destroy);
 
 #if (CONFIG_MMS_THREADLESS_STACK != 1)
         Semaphore_destroy(self->dataModelLock);
         Semaphore_destroy(self->clientConnectionsLock);
+        Semaphore_destroy(self->valueCacheLock);
 #endif
 
+        if (self->populatedDomains)
+            GLOBAL_FREEMEM((void*) self->populatedDomains);
+
 #if (CONFIG_IEC61850_SUPPORT_SERVER_IDENTITY == 1)
 
         if (self->vendorName)
@@ -662,6 +1022,16 @@ IedServer_getMmsServer(IedServer self)
     return self->mmsServer;
 }
 
+void
+IedServer_getStartupProfile(IedServer self, IedServerStartupProfile* profile)
+{
+    lockValueCache(self);
+
+    *profile = self->startupProfile;
+
+    unlockValueCache(self);
+}
+
 #if (CONFIG_MMS_THREADLESS_STACK != 1)
 #if (CONFIG_MMS_SINGLE_THREADED == 1)
 static void
@@ -710,6 +1080,15 @@ IedServer_start(IedServer self, int tcpPort)
 #endif
 
         self->running = true;
+
+        if ((self->valueCacheMode == IEC61850_VALUE_CACHE_BACKGROUND) && (Atomic_load32(&(self->dataSetsResolved)) == 0)) {
+            self->valueCacheThreadRunning = true;
+
+            self->valueCacheThread = Thread_create((ThreadExecutionFunction) valueCachePopulationThread, (void*) self, false);
+
+            if (self->valueCacheThread)
+                Thread_start(self->valueCacheThread);
+        }
     }
 }
 #endif
@@ -733,6 +1112,12 @@ IedServer_stop(IedServer self)
     if (self->running) {
         self->running = false;
 
+        if (self->valueCacheThread) {
+            self->valueCacheThreadRunning = false;
+            Thread_destroy(self->valueCacheThread);
+            self->valueCacheThread = NULL;
+        }
+
         MmsMapping_stopEventWorkerThread(self->mmsMapping);
 
         Reporting_deactivateAllReports(self->mmsMapping);
@@ -885,6 +1270,8 @@ lookupControlObject(IedServer self, DataObject* node)
     if (DEBUG_IED_SERVER)
         printf("IED_SERVER: looking for control object: %s\n", objectName);
 
+    private_IedServer_populateValueCache(self, domain);
+
     ControlObject* controlObject = MmsMapping_getControlObject(self->mmsMapping, domain,
             lnName, objectName);
 
@@ -977,17 +1364,19 @@ IedServer_setGoCBHandler(IedServer self, GoCBEventHandler handler, void* paramet
 MmsValue*
 IedServer_getAttributeValue(IedServer self, DataAttribute* dataAttribute)
 {
-    (void)self;
+    populateValueCacheForNode(self, (const ModelNode*) dataAttribute);
+
     return dataAttribute->mmsValue;
 }
 
 bool
 IedServer_getBooleanAttributeValue(IedServer self, const DataAttribute* dataAttribute)
 {
-    (void)self;
-
     assert(self != NULL);
     assert(dataAttribute != NULL);
+
+    populateValueCacheForNode(self, (const ModelNode*) dataAttribute);
+
     assert(dataAttribute->mmsValue != NULL);
     assert(MmsValue_getType(dataAttribute->mmsValue) == MMS_BOOLEAN);
 
@@ -997,10 +1386,11 @@ IedServer_getBooleanAttributeValue(IedServer self, const DataAttribute* dataAttr
 int32_t
 IedServer_getInt32AttributeValue(IedServer self, const DataAttribute* dataAttribute)
 {
-    (void)self;
-
     assert(self != NULL);
     assert(dataAttribute != NULL);
+
+    populateValueCacheForNode(self, (const ModelNode*) dataAttribute);
+
     assert(dataAttribute->mmsValue != NULL);
     assert((MmsValue_getType(dataAttribute->mmsValue) == MMS_INTEGER) ||
             (MmsValue_getType(dataAttribute->mmsValue) == MMS_UNSIGNED));
@@ -1011,10 +1401,11 @@ IedServer_getInt32AttributeValue(IedServer self, const DataAttribute* dataAttrib
 int64_t
 IedServer_getInt64AttributeValue(IedServer self, const DataAttribute* dataAttribute)
 {
-    (void)self;
-
     assert(self != NULL);
     assert(dataAttribute != NULL);
+
+    populateValueCacheForNode(self, (const ModelNode*) dataAttribute);
+
     assert(dataAttribute->mmsValue != NULL);
     assert((MmsValue_getType(dataAttribute->mmsValue) == MMS_INTEGER) ||
             (MmsValue_getType(dataAttribute->mmsValue) == MMS_UNSIGNED));
@@ -1025,10 +1416,11 @@ IedServer_getInt64AttributeValue(IedServer self, const DataAttribute* dataAttrib
 uint32_t
 IedServer_getUInt32AttributeValue(IedServer self, const DataAttribute* dataAttribute)
 {
-    (void)self;
-
     assert(self != NULL);
     assert(dataAttribute != NULL);
+
+    populateValueCacheForNode(self, (const ModelNode*) dataAttribute);
+
     assert(dataAttribute->mmsValue != NULL);
     assert((MmsValue_getType(dataAttribute->mmsValue) == MMS_INTEGER) ||
             (MmsValue_getType(dataAttribute->mmsValue) == MMS_UNSIGNED));
@@ -1039,10 +1431,11 @@ IedServer_getUInt32AttributeValue(IedServer self, const DataAttribute* dataAttri
 float
 IedServer_getFloatAttributeValue(IedServer self, const DataAttribute* dataAttribute)
 {
-    (void)self;
-
     assert(self != NULL);
     assert(dataAttribute != NULL);
+
+    populateValueCacheForNode(self, (const ModelNode*) dataAttribute);
+
     assert(dataAttribute->mmsValue != NULL);
     assert(MmsValue_getType(dataAttribute->mmsValue) == MMS_FLOAT);
 
@@ -1052,10 +1445,11 @@ IedServer_getFloatAttributeValue(IedServer self, const DataAttribute* dataAttrib
 uint64_t
 IedServer_getUTCTimeAttributeValue(IedServer self, const DataAttribute* dataAttribute)
 {
-    (void)self;
-
     assert(self != NULL);
     assert(dataAttribute != NULL);
+
+    populateValueCacheForNode(self, (const ModelNode*) dataAttribute);
+
     assert(dataAttribute->mmsValue != NULL);
     assert(MmsValue_getType(dataAttribute->mmsValue) == MMS_UTC_TIME);
 
@@ -1065,10 +1459,11 @@ IedServer_getUTCTimeAttributeValue(IedServer self, const DataAttribute* dataAttr
 uint32_t
 IedServer_getBitStringAttributeValue(IedServer self, const DataAttribute* dataAttribute)
 {
-    (void)self;
-
     assert(self != NULL);
     assert(dataAttribute != NULL);
+
+    populateValueCacheForNode(self, (const ModelNode*) dataAttribute);
+
     assert(dataAttribute->mmsValue != NULL);
     assert(MmsValue_getType(dataAttribute->mmsValue) == MMS_BIT_STRING);
     assert(MmsValue_getBitStringSize(dataAttribute->mmsValue) < 33);
@@ -1079,10 +1474,11 @@ IedServer_getBitStringAttributeValue(IedServer self, const DataAttribute* dataAt
 const char*
 IedServer_getStringAttributeValue(IedServer self, const DataAttribute* dataAttribute)
 {
-    (void)self;
-
     assert(self != NULL);
     assert(dataAttribute != NULL);
+
+    populateValueCacheForNode(self, (const ModelNode*) dataAttribute);
+
     assert(dataAttribute->mmsValue != NULL);
     assert(MmsValue_getType(dataAttribute->mmsValue) == MMS_VISIBLE_STRING);
 
@@ -1157,6 +1553,9 @@ IedServer_updateAttributeValue(IedServer self, DataAttribute* dataAttribute, Mms
 {
     assert(self != NULL);
     assert(dataAttribute != NULL);
+
+    populateValueCacheForNode(self, (const ModelNode*) dataAttribute);
+
     assert(MmsValue_getType(dataAttribute->mmsValue) == MmsValue_getType(value));
 
     if (MmsValue_equals(dataAttribute->mmsValue, value) == false) {
@@ -1186,6 +1585,8 @@ IedServer_updateAttributeValue(IedServer self, DataAttribute* dataAttribute, Mms
 void
 IedServer_updateFloatAttributeValue(IedServer self, DataAttribute* dataAttribute, float value)
 {
+    populateValueCacheForNode(self, (const ModelNode*) dataAttribute);
+
     assert(dataAttribute != NULL);
     assert(MmsValue_getType(dataAttribute->mmsValue) == MMS_FLOAT);
     assert(self != NULL);
@@ -1210,6 +1611,8 @@ IedServer_updateFloatAttributeValue(IedServer self, DataAttribute* dataAttribute
 void
 IedServer_updateInt32AttributeValue(IedServer self, DataAttribute* dataAttribute, int32_t value)
 {
+    populateValueCacheForNode(self, (const ModelNode*) dataAttribute);
+
     assert(dataAttribute != NULL);
     assert(MmsValue_getType(dataAttribute->mmsValue) == MMS_INTEGER);
     assert(self != NULL);
@@ -1235,6 +1638,8 @@ IedServer_updateInt32AttributeValue(IedServer self, DataAttribute* dataAttribute
 void
 IedServer_updateDbposValue(IedServer self, DataAttribute* dataAttribute, Dbpos value)
 {
+    populateValueCacheForNode(self, (const ModelNode*) dataAttribute);
+
     Dbpos currentValue = Dbpos_fromMmsValue(dataAttribute->mmsValue);
 
     if (currentValue != value) {
@@ -1256,6 +1661,8 @@ IedServer_updateDbposValue(IedServer self, DataAttribute* dataAttribute, Dbpos v
 void
 IedServer_updateInt64AttributeValue(IedServer self, DataAttribute* dataAttribute, int64_t value)
 {
+    populateValueCacheForNode(self, (const ModelNode*) dataAttribute);
+
     assert(dataAttribute != NULL);
     assert(MmsValue_getType(dataAttribute->mmsValue) == MMS_INTEGER);
     assert(self != NULL);
@@ -1281,6 +1688,8 @@ IedServer_updateInt64AttributeValue(IedServer self, DataAttribute* dataAttribute
 void
 IedServer_updateUnsignedAttributeValue(IedServer self, DataAttribute* dataAttribute, uint32_t value)
 {
+    populateValueCacheForNode(self, (const ModelNode*) dataAttribute);
+
     assert(dataAttribute != NULL);
     assert(MmsValue_getType(dataAttribute->mmsValue) == MMS_UNSIGNED);
     assert(self != NULL);
@@ -1306,6 +1715,8 @@ IedServer_updateUnsignedAttributeValue(IedServer self, DataAttribute* dataAttrib
 void
 IedServer_updateBitStringAttributeValue(IedServer self, DataAttribute* dataAttribute, uint32_t value)
 {
+    populateValueCacheForNode(self, (const ModelNode*) dataAttribute);
+
     assert(dataAttribute != NULL);
     assert(MmsValue_getType(dataAttribute->mmsValue) == MMS_BIT_STRING);
     assert(self != NULL);
@@ -1333,6 +1744,9 @@ IedServer_updateBooleanAttributeValue(IedServer self, DataAttribute* dataAttribu
 {
     assert(self != NULL);
     assert(dataAttribute != NULL);
+
+    populateValueCacheForNode(self, (const ModelNode*) dataAttribute);
+
     assert(MmsValue_getType(dataAttribute->mmsValue) == MMS_BOOLEAN);
 
     bool currentValue = MmsValue_getBoolean(dataAttribute->mmsValue);
@@ -1363,6 +1777,8 @@ IedServer_updateBooleanAttributeValue(IedServer self, DataAttribute* dataAttribu
 void
 IedServer_updateVisibleStringAttributeValue(IedServer self, DataAttribute* dataAttribute, char *value)
 {
+    populateValueCacheForNode(self, (const ModelNode*) dataAttribute);
+
     assert(dataAttribute != NULL);
     assert(MmsValue_getType(dataAttribute->mmsValue) == MMS_VISIBLE_STRING);
     assert(self != NULL);
@@ -1387,6 +1803,8 @@ IedServer_updateVisibleStringAttributeValue(IedServer self, DataAttribute* dataA
 void
 IedServer_updateUTCTimeAttributeValue(IedServer self, DataAttribute* dataAttribute, uint64_t value)
 {
+    populateValueCacheForNode(self, (const ModelNode*) dataAttribute);
+
     assert(dataAttribute != NULL);
     assert(MmsValue_getType(dataAttribute->mmsValue) == MMS_UTC_TIME);
     assert(self != NULL);
@@ -1412,6 +1830,8 @@ IedServer_updateUTCTimeAttributeValue(IedServer self, DataAttribute* dataAttribu
 void
 IedServer_updateTimestampAttributeValue(IedServer self, DataAttribute* dataAttribute, Timestamp* timestamp)
 {
+    populateValueCacheForNode(self, (const ModelNode*) dataAttribute);
+
     assert(dataAttribute != NULL);
     assert(MmsValue_getType(dataAttribute->mmsValue) == MMS_UTC_TIME);
     assert(self != NULL);
@@ -1435,6 +1855,8 @@ IedServer_updateTimestampAttributeValue(IedServer self, DataAttribute* dataAttri
 void
 IedServer_updateQuality(IedServer self, DataAttribute* dataAttribute, Quality quality)
 {
+    populateValueCacheForNode(self, (const ModelNode*) dataAttribute);
+
     assert(strcmp(dataAttribute->name, "q") == 0);
     assert(MmsValue_getType(dataAttribute->mmsValue) == MMS_BIT_STRING);
     assert(MmsValue_getBitStringSize(dataAttribute->mmsValue) >= 12);
@@ -1657,6 +2079,8 @@ IedServer_getFunctionalConstrainedData(IedServer self, DataObject* dataObject, F
         goto exit_function;
     }
 
+    private_IedServer_populateValueCache(self, domain);
+
     value = MmsServer_getValueFromCache(self->mmsServer, domain, currentStart);
 
 exit_function:
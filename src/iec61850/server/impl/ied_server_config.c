@@ -65,6 +65,7 @@ IedServerConfig_create()
                                        IEC61850_REPORTSETTINGS_TRG_OPS +
                                        IEC61850_REPORTSETTINGS_OPT_FIELDS +
                                        IEC61850_REPORTSETTINGS_INTG_PD;
+        self->valueCacheMode = IEC61850_VALUE_CACHE_EAGER;
     }
 
     return self;
@@ -301,3 +302,15 @@ IedServerConfig_getReportSetting(IedServerConfig self, uint8_t setting)
 {
     return (self->reportSettingsWritable & setting);
 }
+
+void
+IedServerConfig_setValueCacheMode(IedServerConfig self, uint8_t mode)
+{
+    self->valueCacheMode = mode;
+}
+
+uint8_t
+IedServerConfig_getValueCacheMode(IedServerConfig self)
+{
+    return self->valueCacheMode;
+}
@@ -1420,7 +1420,7 @@ Control_processControlActions(MmsMapping* self, uint64_t currentTimeInMs)
         /* invalidate nextControlTimeout */
         self->nextControlTimeout = (uint64_t) 0xFFFFFFFFFFFFFFFFLLU;
 
-        LinkedList element = LinkedList_getNext(self->controlObjects);
+        LinkedList element = MmsMapping_getNextControlObjectElement(self->controlObjects);
 
         while (element != NULL) {
             ControlObject* controlObject = (ControlObject*) element->data;
@@ -1429,7 +1429,7 @@ Control_processControlActions(MmsMapping* self, uint64_t currentTimeInMs)
 
                 if ((controlObject->ctlModel == 1) || (controlObject->ctlModel == 3)) {
                     if (controlObject->state == STATE_READY) {
-                        element = LinkedList_getNext(element);
+                        element = MmsMapping_getNextControlObjectElement(element);
                         continue;
                     }
                 }
@@ -1502,7 +1502,7 @@ Control_processControlActions(MmsMapping* self, uint64_t currentTimeInMs)
 
             ControlObject_handlePendingEvents(controlObject);
 
-            element = LinkedList_getNext(element);
+            element = MmsMapping_getNextControlObjectElement(element);
         }
     }
 }
@@ -1510,7 +1510,7 @@ Control_processControlActions(MmsMapping* self, uint64_t currentTimeInMs)
 ControlObject*
 Control_lookupControlObject(MmsMapping* self, MmsDomain* domain, char* lnName, char* objectName)
 {
-    LinkedList element = LinkedList_getNext(self->controlObjects);
+    LinkedList element = MmsMapping_getNextControlObjectElement(self->controlObjects);
 
     while (element != NULL) {
         ControlObject* controlObject = (ControlObject*) element->data;
@@ -1523,7 +1523,7 @@ Control_lookupControlObject(MmsMapping* self, MmsDomain* domain, char* lnName, c
             }
         }
 
-        element = LinkedList_getNext(element);
+        element = MmsMapping_getNextControlObjectElement(element);
     }
 
     return NULL;
@@ -97,20 +97,23 @@ LogInstance_logSingleData(LogInstance* self, const char* dataRef, MmsValue* valu
 
         uint64_t entryID = LogStorage_addEntry(logStorage, timestamp);
 
-        int dataSize = MmsValue_encodeMmsData(value, NULL, 0, false);
+        /* entryID 0 -> entry was not stored (e.g. dropped by a full log writer queue) */
+        if (entryID != 0) {
+            int dataSize = MmsValue_encodeMmsData(value, NULL, 0, false);
 
-        uint8_t* data = (uint8_t*) GLOBAL_MALLOC(dataSize);
+            uint8_t* data = (uint8_t*) GLOBAL_MALLOC(dataSize);
 
-        if (data) {
-            MmsValue_encodeMmsData(value, data, 0, true);
+            if (data) {
+                MmsValue_encodeMmsData(value, data, 0, true);
 
-            LogStorage_addEntryData(logStorage, entryID, dataRef, data, dataSize, flag);
+                LogStorage_addEntryData(logStorage, entryID, dataRef, data, dataSize, flag);
 
-            GLOBAL_FREEMEM(data);
-        }
+                GLOBAL_FREEMEM(data);
+            }
 
-        self->newEntryId = entryID;
-        self->newEntryTime = timestamp;
+            self->newEntryId = entryID;
+            self->newEntryTime = timestamp;
+        }
 
 #if (CONFIG_MMS_THREADLESS_STACK != 1)
         Semaphore_post(self->lock);
@@ -152,7 +155,7 @@ LogInstance_logEntryData(LogInstance* self, uint64_t entryID, const char* dataRe
 {
     LogStorage logStorage = self->logStorage;
 
-    if (logStorage) {
+    if (logStorage && (entryID != 0)) {
 
         int dataSize = MmsValue_encodeMmsData(value, NULL, 0, false);
 
@@ -606,6 +609,8 @@ LIBIEC61850_LOG_SVC_writeAccessLogControlBlock(MmsMapping* self, MmsDomain* doma
                 DataSet* dataSet = IedModel_lookupDataSet(logControl->mmsMapping->model, dataSetRef);
 
                 if (dataSet != NULL) {
+                    private_IedServer_resolveDataSet(self->iedServer, dataSet);
+
                     freeDynamicDataSet(logControl);
 
                     logControl->dataSet = dataSet;
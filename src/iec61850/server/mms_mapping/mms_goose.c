@@ -428,6 +428,9 @@ MmsGooseControlBlock_enable(MmsGooseControlBlock self, MmsMapping* mmsMapping)
 
             self->dataSet = IedModel_lookupDataSet(self->mmsMapping->model, self->dataSetRef);
 
+            if (self->dataSet)
+                private_IedServer_resolveDataSet(self->mmsMapping->iedServer, self->dataSet);
+
             self->isDynamicDataSet = false;
 
             if (self->dataSet == NULL) {
@@ -33,6 +33,7 @@
 #include "logging.h"
 #include "control.h"
 #include "ied_server_private.h"
+#include "platform_atomic.h"
 
 #ifndef CONFIG_IEC61850_SG_RESVTMS
 #define CONFIG_IEC61850_SG_RESVTMS 100
@@ -373,10 +374,479 @@ createFCNamedVariableFromDataObject(DataObject* dataObject,
     return completeNamedVariable;
 }
 
+/*
+ * Logical nodes with the same structure (e.g. instances of the same LNodeType) have identical
+ * type specifications for their functional constraints. These type specifications (and the
+ * specifications of identical data objects) are created only once and shared by all logical
+ * nodes. The cache owns all type specifications added to it and keeps them until the MMS mapping
+ * is destroyed. Before the MMS device is destroyed they are detached from the logical nodes.
+ *
+ * The cache is a hash table indexed by a structural hash of the model nodes. The model node a
+ * type specification was created from is stored to compare candidates.
+ */
+
+typedef struct {
+    uint32_t hash;
+    ModelNode* node; /* logical node or data object the type specification was created from */
+    FunctionalConstraint fc;
+    MmsVariableSpecification* typeSpec;
+} SharedTypeSpec;
+
+typedef struct sTypeSpecCache {
+    SharedTypeSpec* entries;
+    int size; /* always a power of two */
+    int count;
+    MmsVariableSpecification** sortedTypeSpecs; /* owned type specifications sorted by address */
+} TypeSpecCache;
+
+#define TYPE_SPEC_CACHE_INITIAL_SIZE 256
+
+static uint32_t
+hashInt(uint32_t hash, int value)
+{
+    hash = (hash ^ (uint32_t) value) * 16777619u;
+
+    return hash;
+}
+
+static uint32_t
+hashString(uint32_t hash, const char* str)
+{
+    while (*str) {
+        hash = (hash ^ (uint8_t) *str) * 16777619u;
+        str++;
+    }
+
+    /* include the terminator to separate consecutive names */
+    return hash * 16777619u;
+}
+
+static uint32_t
+hashDataAttribute(uint32_t hash, DataAttribute* dataAttribute)
+{
+    hash = hashString(hash, dataAttribute->name);
+    hash = hashInt(hash, dataAttribute->type);
+    hash = hashInt(hash, dataAttribute->elementCount);
+
+    DataAttribute* subDataAttribute = (DataAttribute*) dataAttribute->firstChild;
+
+    while (subDataAttribute) {
+        hash = hashDataAttribute(hash, subDataAttribute);
+
+        subDataAttribute = (DataAttribute*) subDataAttribute->sibling;
+    }
+
+    return hashInt(hash, -1);
+}
+
+static uint32_t
+hashDataObject(uint32_t hash, DataObject* dataObject, FunctionalConstraint fc)
+{
+    hash = hashString(hash, dataObject->name);
+    hash = hashInt(hash, dataObject->elementCount);
+
+    ModelNode* child = dataObject->firstChild;
+
+    while (child) {
+        if (child->modelType == DataAttributeModelType) {
+            if (((DataAttribute*) child)->fc == fc)
+                hash = hashDataAttribute(hash, (DataAttribute*) child);
+        }
+        else if (child->modelType == DataObjectModelType) {
+            if (DataObject_hasFCData((DataObject*) child, fc))
+                hash = hashDataObject(hash, (DataObject*) child, fc);
+        }
+
+        child = child->sibling;
+    }
+
+    return hashInt(hash, -1);
+}
+
+static uint32_t
+hashLogicalNode(LogicalNode* logicalNode, FunctionalConstraint fc)
+{
+    uint32_t hash = hashInt(2166136261u, fc);
+
+    DataObject* dataObject = (DataObject*) logicalNode->firstChild;
+
+    while (dataObject) {
+        if (DataObject_hasFCData(dataObject, fc))
+            hash = hashDataObject(hash, dataObject, fc);
+
+        dataObject = (DataObject*) dataObject->sibling;
+    }
+
+    return hash;
+}
+
+static bool
+isEqualDataAttribute(DataAttribute* da1, DataAttribute* da2)
+{
+    if ((da1->type != da2->type) || (da1->elementCount != da2->elementCount))
+        return false;
+
+    if (strcmp(da1->name, da2->name) != 0)
+        return false;
+
+    DataAttribute* sub1 = (DataAttribute*) da1->firstChild;
+    DataAttribute* sub2 = (DataAttribute*) da2->firstChild;
+
+    while (sub1 && sub2) {
+        if (isEqualDataAttribute(sub1, sub2) == false)
+            return false;
+
+        sub1 = (DataAttribute*) sub1->sibling;
+        sub2 = (DataAttribute*) sub2->sibling;
+    }
+
+    return (sub1 == NULL) && (sub2 == NULL);
+}
+
+static ModelNode*
+getNextChildWithFc(ModelNode* child, FunctionalConstraint fc)
+{
+    while (child) {
+        if (child->modelType == DataAttributeModelType) {
+            if (((DataAttribute*) child)->fc == fc)
+                return child;
+        }
+        else if (child->modelType == DataObjectModelType) {
+            if (DataObject_hasFCData((DataObject*) child, fc))
+                return child;
+        }
+
+        child = child->sibling;
+    }
+
+    return NULL;
+}
+
+static bool
+isEqualDataObject(DataObject* do1, DataObject* do2, FunctionalConstraint fc)
+{
+    if (do1->elementCount != do2->elementCount)
+        return false;
+
+    if (strcmp(do1->name, do2->name) != 0)
+        return false;
+
+    ModelNode* child1 = getNextChildWithFc(do1->firstChild, fc);
+    ModelNode* child2 = getNextChildWithFc(do2->firstChild, fc);
+
+    while (child1 && child2) {
+        if (child1->modelType != child2->modelType)
+            return false;
+
+        if (child1->modelType == DataAttributeModelType) {
+            if (isEqualDataAttribute((DataAttribute*) child1, (DataAttribute*) child2) == false)
+                return false;
+        }
+        else {
+            if (isEqualDataObject((DataObject*) child1, (DataObject*) child2, fc) == false)
+                return false;
+        }
+
+        child1 = getNextChildWithFc(child1->sibling, fc);
+        child2 = getNextChildWithFc(child2->sibling, fc);
+    }
+
+    return (child1 == NULL) && (child2 == NULL);
+}
+
+static bool
+isEqualLogicalNode(LogicalNode* ln1, LogicalNode* ln2, FunctionalConstraint fc)
+{
+    ModelNode* child1 = getNextChildWithFc(ln1->firstChild, fc);
+    ModelNode* child2 = getNextChildWithFc(ln2->firstChild, fc);
+
+    while (child1 && child2) {
+        if (isEqualDataObject((DataObject*) child1, (DataObject*) child2, fc) == false)
+            return false;
+
+        child1 = getNextChildWithFc(child1->sibling, fc);
+        child2 = getNextChildWithFc(child2->sibling, fc);
+    }
+
+    return (child1 == NULL) && (child2 == NULL);
+}
+
+static TypeSpecCache*
+TypeSpecCache_create()
+{
+    TypeSpecCache* self = (TypeSpecCache*) GLOBAL_MALLOC(sizeof(TypeSpecCache));
+
+    if (self) {
+        self->entries = (SharedTypeSpec*) GLOBAL_CALLOC(TYPE_SPEC_CACHE_INITIAL_SIZE, sizeof(SharedTypeSpec));
+
+        if (self->entries == NULL) {
+            GLOBAL_FREEMEM(self);
+            return NULL;
+        }
+
+        self->size = TYPE_SPEC_CACHE_INITIAL_SIZE;
+        self->count = 0;
+        self->sortedTypeSpecs = NULL;
+    }
+
+    return self;
+}
+
+static int
+compareTypeSpecAddresses(const void* a, const void* b)
+{
+    uintptr_t typeSpec1 = (uintptr_t) *((MmsVariableSpecification* const*) a);
+    uintptr_t typeSpec2 = (uintptr_t) *((MmsVariableSpecification* const*) b);
+
+    if (typeSpec1 < typeSpec2)
+        return -1;
+    else if (typeSpec1 > typeSpec2)
+        return 1;
+    else
+        return 0;
+}
+
+static void
+TypeSpecCache_sortTypeSpecs(TypeSpecCache* self)
+{
+    if ((self->sortedTypeSpecs) || (self->count == 0))
+        return;
+
+    self->sortedTypeSpecs = (MmsVariableSpecification**) GLOBAL_MALLOC(self->count * sizeof(MmsVariableSpecification*));
+
+    /* without memory TypeSpecCache_isOwner falls back to a linear search */
+    if (self->sortedTypeSpecs == NULL)
+        return;
+
+    int count = 0;
+    int i;
+
+    for (i = 0; i < self->size; i++) {
+        if (self->entries[i].typeSpec)
+            self->sortedTypeSpecs[count++] = self->entries[i].typeSpec;
+    }
+
+    qsort(self->sortedTypeSpecs, count, sizeof(MmsVariableSpecification*), compareTypeSpecAddresses);
+}
+
+static bool
+TypeSpecCache_isOwner(TypeSpecCache* self, MmsVariableSpecification* typeSpec)
+{
+    if (typeSpec == NULL)
+        return false;
+
+    if (self->sortedTypeSpecs)
+        return (bsearch(&typeSpec, self->sortedTypeSpecs, self->count, sizeof(MmsVariableSpecification*),
+                compareTypeSpecAddresses) != NULL);
+
+    int i;
+
+    for (i = 0; i < self->size; i++) {
+        if (self->entries[i].typeSpec == typeSpec)
+            return true;
+    }
+
+    return false;
+}
+
+/* remove the references to type specifications owned by the cache from the elements of a structure */
+static void
+TypeSpecCache_detachElements(TypeSpecCache* self, MmsVariableSpecification* typeSpec)
+{
+    if ((typeSpec == NULL) || (typeSpec->type != MMS_STRUCTURE))
+        return;
+
+    int i;
+
+    for (i = 0; i < typeSpec->typeSpec.structure.elementCount; i++) {
+        if (TypeSpecCache_isOwner(self, typeSpec->typeSpec.structure.elements[i]))
+            typeSpec->typeSpec.structure.elements[i] = NULL;
+    }
+}
+
+/**
+ * \brief remove all references to type specifications owned by the cache from the MMS device
+ *
+ * Owned type specifications are elements of the logical nodes (functional constraint structures)
+ * or elements of the functional constraint structures (data objects). Has to be called before
+ * MmsDevice_destroy.
+ */
+static void
+TypeSpecCache_detachTypeSpecs(TypeSpecCache* self, MmsDevice* mmsDevice)
+{
+    TypeSpecCache_sortTypeSpecs(self);
+
+    int domainIdx;
+
+    for (domainIdx = 0; domainIdx < mmsDevice->domainCount; domainIdx++) {
+        MmsDomain* domain = mmsDevice->domains[domainIdx];
+
+        int i;
+
+        for (i = 0; i < domain->namedVariablesCount; i++) {
+            MmsVariableSpecification* logicalNode = domain->namedVariables[i];
+
+            if ((logicalNode == NULL) || (logicalNode->type != MMS_STRUCTURE))
+                continue;
+
+            int j;
+
+            for (j = 0; j < logicalNode->typeSpec.structure.elementCount; j++)
+                TypeSpecCache_detachElements(self, logicalNode->typeSpec.structure.elements[j]);
+
+            TypeSpecCache_detachElements(self, logicalNode);
+        }
+    }
+}
+
+/* delete the cache and all type specifications owned by the cache */
+static void
+TypeSpecCache_destroy(TypeSpecCache* self)
+{
+    TypeSpecCache_sortTypeSpecs(self);
+
+    int i;
+
+    /* functional constraint structures contain data objects owned by the cache */
+    for (i = 0; i < self->size; i++) {
+        if (self->entries[i].typeSpec)
+            TypeSpecCache_detachElements(self, self->entries[i].typeSpec);
+    }
+
+    for (i = 0; i < self->size; i++) {
+        if (self->entries[i].typeSpec)
+            MmsVariableSpecification_destroy(self->entries[i].typeSpec);
+    }
+
+    if (self->sortedTypeSpecs)
+        GLOBAL_FREEMEM(self->sortedTypeSpecs);
+
+    GLOBAL_FREEMEM(self->entries);
+    GLOBAL_FREEMEM(self);
+}
+
+static bool
+TypeSpecCache_isEqual(SharedTypeSpec* entry, uint32_t hash, ModelNode* node, FunctionalConstraint fc)
+{
+    if ((entry->hash != hash) || (entry->fc != fc) || (entry->node->modelType != node->modelType))
+        return false;
+
+    if (node->modelType == LogicalNodeModelType)
+        return isEqualLogicalNode((LogicalNode*) entry->node, (LogicalNode*) node, fc);
+    else
+        return isEqualDataObject((DataObject*) entry->node, (DataObject*) node, fc);
+}
+
+/**
+ * \brief get a shared type specification for the model node
+ *
+ * \return the shared type specification or NULL when no matching type specification exists
+ */
 static MmsVariableSpecification*
-createFCNamedVariable(LogicalNode* logicalNode, FunctionalConstraint fc)
+TypeSpecCache_get(TypeSpecCache* self, uint32_t hash, ModelNode* node, FunctionalConstraint fc)
 {
-    MmsVariableSpecification* namedVariable = (MmsVariableSpecification*) GLOBAL_CALLOC(1,
+    if (self == NULL)
+        return NULL;
+
+    int mask = self->size - 1;
+    int index = hash & mask;
+
+    while (self->entries[index].typeSpec) {
+        SharedTypeSpec* entry = &(self->entries[index]);
+
+        if (TypeSpecCache_isEqual(entry, hash, node, fc))
+            return entry->typeSpec;
+
+        index = (index + 1) & mask;
+    }
+
+    return NULL;
+}
+
+static void
+TypeSpecCache_insert(SharedTypeSpec* entries, int size, SharedTypeSpec* entry)
+{
+    int mask = size - 1;
+    int index = entry->hash & mask;
+
+    while (entries[index].typeSpec)
+        index = (index + 1) & mask;
+
+    entries[index] = *entry;
+}
+
+static void
+TypeSpecCache_add(TypeSpecCache* self, uint32_t hash, ModelNode* node, FunctionalConstraint fc,
+        MmsVariableSpecification* typeSpec)
+{
+    if (self == NULL)
+        return;
+
+    /* keep the load factor below 50% */
+    if ((self->count + 1) * 2 > self->size) {
+        int newSize = self->size * 2;
+
+        SharedTypeSpec* newEntries = (SharedTypeSpec*) GLOBAL_CALLOC(newSize, sizeof(SharedTypeSpec));
+
+        /* without memory the type specification is simply not shared */
+        if (newEntries == NULL)
+            return;
+
+        int i;
+
+        for (i = 0; i < self->size; i++) {
+            if (self->entries[i].typeSpec)
+                TypeSpecCache_insert(newEntries, newSize, &(self->entries[i]));
+        }
+
+        GLOBAL_FREEMEM(self->entries);
+
+        self->entries = newEntries;
+        self->size = newSize;
+    }
+
+    SharedTypeSpec entry;
+
+    entry.hash = hash;
+    entry.node = node;
+    entry.fc = fc;
+    entry.typeSpec = typeSpec;
+
+    TypeSpecCache_insert(self->entries, self->size, &entry);
+
+    self->count++;
+}
+
+static MmsVariableSpecification*
+createSharedFCNamedVariableFromDataObject(MmsMapping* self, DataObject* dataObject,
+        FunctionalConstraint fc)
+{
+    uint32_t hash = hashDataObject(2166136261u, dataObject, fc);
+
+    MmsVariableSpecification* namedVariable = TypeSpecCache_get(self->typeSpecCache, hash,
+            (ModelNode*) dataObject, fc);
+
+    if (namedVariable == NULL) {
+        namedVariable = createFCNamedVariableFromDataObject(dataObject, fc);
+
+        TypeSpecCache_add(self->typeSpecCache, hash, (ModelNode*) dataObject, fc, namedVariable);
+    }
+
+    return namedVariable;
+}
+
+static MmsVariableSpecification*
+createFCNamedVariable(MmsMapping* self, LogicalNode* logicalNode, FunctionalConstraint fc)
+{
+    uint32_t hash = hashLogicalNode(logicalNode, fc);
+
+    MmsVariableSpecification* namedVariable = TypeSpecCache_get(self->typeSpecCache, hash,
+            (ModelNode*) logicalNode, fc);
+
+    if (namedVariable)
+        return namedVariable;
+
+    namedVariable = (MmsVariableSpecification*) GLOBAL_CALLOC(1,
             sizeof(MmsVariableSpecification));
     namedVariable->name = StringUtils_copyString(FunctionalConstraint_toString(fc));
     namedVariable->type = MMS_STRUCTURE;
@@ -404,7 +874,7 @@ createFCNamedVariable(LogicalNode* logicalNode, FunctionalConstraint fc)
         if (DataObject_hasFCData(dataObject, fc)) {
 
             namedVariable->typeSpec.structure.elements[dataObjectCount] =
-                    createFCNamedVariableFromDataObject(dataObject, fc);
+                    createSharedFCNamedVariableFromDataObject(self, dataObject, fc);
 
             dataObjectCount++;
         }
@@ -412,6 +882,8 @@ createFCNamedVariable(LogicalNode* logicalNode, FunctionalConstraint fc)
         dataObject = (DataObject*) dataObject->sibling;
     }
 
+    TypeSpecCache_add(self->typeSpecCache, hash, (ModelNode*) logicalNode, fc, namedVariable);
+
     return namedVariable;
 }
 
@@ -476,7 +948,7 @@ createSGCB(bool withResvTms)
 }
 
 static MmsVariableSpecification*
-createFCNamedVariableSPWithSGCB(LogicalNode* logicalNode, bool withResvTms)
+createFCNamedVariableSPWithSGCB(MmsMapping* self, LogicalNode* logicalNode, bool withResvTms)
 {
     MmsVariableSpecification* namedVariable = (MmsVariableSpecification*) GLOBAL_CALLOC(1,
             sizeof(MmsVariableSpecification));
@@ -508,7 +980,7 @@ createFCNamedVariableSPWithSGCB(LogicalNode* logicalNode, bool withResvTms)
         if (DataObject_hasFCData(dataObject, IEC61850_FC_SP)) {
 
             namedVariable->typeSpec.structure.elements[dataObjectCount] =
-                    createFCNamedVariableFromDataObject(dataObject, IEC61850_FC_SP);
+                    createSharedFCNamedVariableFromDataObject(self, dataObject, IEC61850_FC_SP);
 
             dataObjectCount++;
         }
@@ -711,20 +1183,6 @@ MmsMapping_checkForSettingGroupReservationTimeouts(MmsMapping* self, uint64_t cu
     }
 }
 
-void
-MmsMapping_initializeControlObjects(MmsMapping* self)
-{
-    LinkedList element = LinkedList_getNext(self->controlObjects);
-
-    while (element) {
-        ControlObject* controlObject = (ControlObject*) LinkedList_getData(element);
-
-        ControlObject_initialize(controlObject);
-
-        element = LinkedList_getNext(element);
-    }
-}
-
 void
 MmsMapping_configureSettingGroups(MmsMapping* self)
 {
@@ -736,6 +1194,8 @@ MmsMapping_configureSettingGroups(MmsMapping* self)
         if (DEBUG_IED_SERVER)
             printf("IED_SERVER: Configure setting group\n");
 
+        private_IedServer_populateValueCache(self->iedServer, settingGroup->mmsDomain);
+
         MmsValue* values =
                 MmsServer_getValueFromCache(self->mmsServer, settingGroup->mmsDomain, "LLN0$SP$SGCB");
 
@@ -1508,7 +1968,7 @@ createNamedVariableFromLogicalNode(MmsMapping* self, MmsDomain* domain,
         LogicalNode* logicalNode)
 {
     MmsVariableSpecification* namedVariable = (MmsVariableSpecification*)
-            GLOBAL_MALLOC(sizeof(MmsVariableSpecification));
+            GLOBAL_CALLOC(1, sizeof(MmsVariableSpecification));
 
     namedVariable->name = StringUtils_copyString(logicalNode->name);
 
@@ -1613,31 +2073,31 @@ createNamedVariableFromLogicalNode(MmsMapping* self, MmsDomain* domain,
 
     if (LogicalNode_hasFCData(logicalNode, IEC61850_FC_MX)) {
         namedVariable->typeSpec.structure.elements[currentComponent] =
-                createFCNamedVariable(logicalNode, IEC61850_FC_MX);
+                createFCNamedVariable(self, logicalNode, IEC61850_FC_MX);
         currentComponent++;
     }
 
     if (LogicalNode_hasFCData(logicalNode, IEC61850_FC_ST)) {
         namedVariable->typeSpec.structure.elements[currentComponent] =
-                createFCNamedVariable(logicalNode, IEC61850_FC_ST);
+                createFCNamedVariable(self, logicalNode, IEC61850_FC_ST);
         currentComponent++;
     }
 
     if (LogicalNode_hasFCData(logicalNode, IEC61850_FC_CO)) {
         namedVariable->typeSpec.structure.elements[currentComponent] =
-                createFCNamedVariable(logicalNode, IEC61850_FC_CO);
+                createFCNamedVariable(self, logicalNode, IEC61850_FC_CO);
         currentComponent++;
     }
 
     if (LogicalNode_hasFCData(logicalNode, IEC61850_FC_CF)) {
         namedVariable->typeSpec.structure.elements[currentComponent] =
-                createFCNamedVariable(logicalNode, IEC61850_FC_CF);
+                createFCNamedVariable(self, logicalNode, IEC61850_FC_CF);
         currentComponent++;
     }
 
     if (LogicalNode_hasFCData(logicalNode, IEC61850_FC_DC)) {
         namedVariable->typeSpec.structure.elements[currentComponent] =
-                createFCNamedVariable(logicalNode, IEC61850_FC_DC);
+                createFCNamedVariable(self, logicalNode, IEC61850_FC_DC);
         currentComponent++;
     }
 
@@ -1651,20 +2111,20 @@ createNamedVariableFromLogicalNode(MmsMapping* self, MmsDomain* domain,
         }
 
         namedVariable->typeSpec.structure.elements[currentComponent] =
-                createFCNamedVariableSPWithSGCB(logicalNode, withResvTms);
+                createFCNamedVariableSPWithSGCB(self, logicalNode, withResvTms);
         currentComponent++;
     }
     else
 #endif /* (CONFIG_IEC61850_SETTING_GROUPS == 1) */
     if (LogicalNode_hasFCData(logicalNode, IEC61850_FC_SP)) {
         namedVariable->typeSpec.structure.elements[currentComponent] =
-                createFCNamedVariable(logicalNode, IEC61850_FC_SP);
+                createFCNamedVariable(self, logicalNode, IEC61850_FC_SP);
         currentComponent++;
     }
 
     if (LogicalNode_hasFCData(logicalNode, IEC61850_FC_SG)) {
         namedVariable->typeSpec.structure.elements[currentComponent] =
-                createFCNamedVariable(logicalNode, IEC61850_FC_SG);
+                createFCNamedVariable(self, logicalNode, IEC61850_FC_SG);
         currentComponent++;
     }
 
@@ -1717,13 +2177,13 @@ createNamedVariableFromLogicalNode(MmsMapping* self, MmsDomain* domain,
 
     if (LogicalNode_hasFCData(logicalNode, IEC61850_FC_SV)) {
         namedVariable->typeSpec.structure.elements[currentComponent] =
-                createFCNamedVariable(logicalNode, IEC61850_FC_SV);
+                createFCNamedVariable(self, logicalNode, IEC61850_FC_SV);
         currentComponent++;
     }
 
     if (LogicalNode_hasFCData(logicalNode, IEC61850_FC_SE)) {
         namedVariable->typeSpec.structure.elements[currentComponent] =
-                createFCNamedVariable(logicalNode, IEC61850_FC_SE);
+                createFCNamedVariable(self, logicalNode, IEC61850_FC_SE);
         currentComponent++;
     }
 
@@ -1747,13 +2207,13 @@ createNamedVariableFromLogicalNode(MmsMapping* self, MmsDomain* domain,
 
     if (LogicalNode_hasFCData(logicalNode, IEC61850_FC_EX)) {
         namedVariable->typeSpec.structure.elements[currentComponent] =
-                createFCNamedVariable(logicalNode, IEC61850_FC_EX);
+                createFCNamedVariable(self, logicalNode, IEC61850_FC_EX);
         currentComponent++;
     }
 
     if (LogicalNode_hasFCData(logicalNode, IEC61850_FC_SR)) {
         namedVariable->typeSpec.structure.elements[currentComponent] =
-                createFCNamedVariable(logicalNode, IEC61850_FC_SR);
+                createFCNamedVariable(self, logicalNode, IEC61850_FC_SR);
 
 #if (CONFIG_IEC61850_SERVICE_TRACKING == 1)
 
@@ -1771,13 +2231,13 @@ createNamedVariableFromLogicalNode(MmsMapping* self, MmsDomain* domain,
 
     if (LogicalNode_hasFCData(logicalNode, IEC61850_FC_OR)) {
         namedVariable->typeSpec.structure.elements[currentComponent] =
-                createFCNamedVariable(logicalNode, IEC61850_FC_OR);
+                createFCNamedVariable(self, logicalNode, IEC61850_FC_OR);
         currentComponent++;
     }
 
     if (LogicalNode_hasFCData(logicalNode, IEC61850_FC_BL)) {
         namedVariable->typeSpec.structure.elements[currentComponent] =
-                createFCNamedVariable(logicalNode, IEC61850_FC_BL);
+                createFCNamedVariable(self, logicalNode, IEC61850_FC_BL);
         currentComponent++;
     }
 
@@ -1972,12 +2432,23 @@ createMmsModelFromIedModel(MmsMapping* self, IedModel* iedModel)
 
         int iedDeviceCount = IedModel_getLogicalDeviceCount(iedModel);
 
+        /* without the cache type specifications are created for each logical node */
+        self->typeSpecCache = TypeSpecCache_create();
+
         if (createMmsDataModel(self, iedDeviceCount, mmsDevice, iedModel)) {
             createDataSets(mmsDevice, iedModel);
         }
         else {
+            if (self->typeSpecCache)
+                TypeSpecCache_detachTypeSpecs(self->typeSpecCache, mmsDevice);
+
         	MmsDevice_destroy(mmsDevice);
         	mmsDevice = NULL;
+
+            if (self->typeSpecCache) {
+                TypeSpecCache_destroy(self->typeSpecCache);
+                self->typeSpecCache = NULL;
+            }
         }
     }
 
@@ -2073,8 +2544,16 @@ MmsMapping_destroy(MmsMapping* self)
     }
 #endif
 
-    if (self->mmsDevice)
+    if (self->mmsDevice) {
+        /* shared type specifications are owned by the type cache */
+        if (self->typeSpecCache)
+            TypeSpecCache_detachTypeSpecs(self->typeSpecCache, self->mmsDevice);
+
         MmsDevice_destroy(self->mmsDevice);
+    }
+
+    if (self->typeSpecCache)
+        TypeSpecCache_destroy(self->typeSpecCache);
 
 #if (CONFIG_IEC61850_REPORT_SERVICE == 1)
     LinkedList_destroyDeep(self->reportControls, (LinkedListValueDeleteFunction) ReportControl_destroy);
@@ -3158,14 +3637,14 @@ MmsMapping_setMmsServer(MmsMapping* self, MmsServer server)
 static void
 unselectControlsForConnection(MmsMapping* self, MmsServerConnection connection)
 {
-    LinkedList controlObjectElement = LinkedList_getNext(self->controlObjects);
+    LinkedList controlObjectElement = MmsMapping_getNextControlObjectElement(self->controlObjects);
 
     while (controlObjectElement != NULL) {
         ControlObject* controlObject = (ControlObject*) controlObjectElement->data;
 
         ControlObject_unselect(controlObject, connection, self);
 
-        controlObjectElement = LinkedList_getNext(controlObjectElement);
+        controlObjectElement = MmsMapping_getNextControlObjectElement(controlObjectElement);
     }
 }
 #endif /* (CONFIG_IEC61850_CONTROL_SERVICE == 1) */
@@ -3818,10 +4297,33 @@ MmsMapping_disableGoosePublishing(MmsMapping* self)
 #endif /* (CONFIG_INCLUDE_GOOSE_SUPPORT == 1) */
 
 #if (CONFIG_IEC61850_CONTROL_SERVICE == 1)
+/*
+ * Control objects are appended while the tick and connection threads iterate the list without a lock
+ * (value cache population on access). The new element is published after it is completely initialized.
+ * The list has to be iterated with MmsMapping_getNextControlObjectElement.
+ */
 void
 MmsMapping_addControlObject(MmsMapping* self, ControlObject* controlObject)
 {
-    LinkedList_add(self->controlObjects, controlObject);
+    if (self->lastControlObject == NULL)
+        self->lastControlObject = self->controlObjects;
+
+    LinkedList newElement = LinkedList_create();
+
+    if (newElement == NULL)
+        return;
+
+    newElement->data = controlObject;
+
+    Atomic_storePointer((void* volatile*) &(self->lastControlObject->next), newElement);
+
+    self->lastControlObject = newElement;
+}
+
+LinkedList
+MmsMapping_getNextControlObjectElement(LinkedList element)
+{
+    return (LinkedList) Atomic_loadPointer((void* volatile*) &(element->next));
 }
 
 ControlObject*
@@ -3971,6 +4473,8 @@ MmsMapping_createDataSetByNamedVariableList(MmsMapping* self, MmsNamedVariableLi
 
         MmsVariableSpecification* dataSetEntryVarSpec = NULL;
 
+        private_IedServer_populateValueCache(self->iedServer, listEntry->domain);
+
         MmsValue* dataSetEntryValue = MmsServer_getValueFromCacheEx(self->mmsServer, listEntry->domain, listEntry->variableName, &dataSetEntryVarSpec);
 
         if (dataSetEntryValue) {
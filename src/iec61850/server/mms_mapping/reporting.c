@@ -751,6 +751,9 @@ updateReportDataset(MmsMapping* mapping, ReportControl* rc, MmsValue* newDatSet,
 
         DataSet* dataSet = IedModel_lookupDataSet(mapping->model, dataSetName);
 
+        if (dataSet)
+            private_IedServer_resolveDataSet(mapping->iedServer, dataSet);
+
 #if (MMS_DYNAMIC_DATA_SETS == 1)
         if (dataSet == NULL) {
             dataSet = MmsMapping_getDomainSpecificDataSet(mapping, dataSetName);
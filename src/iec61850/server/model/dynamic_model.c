@@ -23,32 +23,210 @@
 
 #include "iec61850_server.h"
 #include "libiec61850_platform_includes.h"
+#include "simple_allocator.h"
 #include "stack_config.h"
 
+/*
+ * Model nodes, control blocks, and names of a dynamic model are allocated in larger memory
+ * blocks owned by the model. Names are interned - each distinct name is stored only once.
+ * The memory is released as a whole by IedModel_destroy.
+ */
+
+#define MODEL_MEMORY_ALIGNMENT 8
+#define MODEL_MEMORY_MIN_BLOCK_SIZE 4096
+#define MODEL_MEMORY_MAX_BLOCK_SIZE (256 * 1024)
+
+typedef struct sModelMemoryBlock ModelMemoryBlock;
+
+struct sModelMemoryBlock {
+    ModelMemoryBlock* next;
+    int blockSize;
+    MemoryAllocator allocator;
+};
+
+#define MODEL_MEMORY_BLOCK_HEADER_SIZE \
+    ((sizeof(ModelMemoryBlock) + MODEL_MEMORY_ALIGNMENT - 1) & ~((size_t) MODEL_MEMORY_ALIGNMENT - 1))
+
+typedef struct {
+    IedModel model; /* has to be the first element */
+
+    ModelMemoryBlock* blocks;
+    int nextBlockSize;
+
+    /* interned strings (open addressing hash table) */
+    char** strings;
+    int stringTableSize;
+    int numberOfStrings;
+
+    /* last elements of the model lists (avoid walking the lists when appending) */
+    LogicalDevice* lastLogicalDevice;
+    DataSet* lastDataSet;
+    Log* lastLog;
+    LogControlBlock* lastLcb;
+    ReportControlBlock* lastRcb;
+    SettingGroupControlBlock* lastSgcb;
+    GSEControlBlock* lastGcb;
+    SVControlBlock* lastSvCB;
+} DynamicIedModel;
+
 static void
 iedModel_emptyVariableInitializer(void)
 {
     return;
 }
 
+static void*
+DynamicIedModel_allocate(DynamicIedModel* self, int size)
+{
+    size = (size + MODEL_MEMORY_ALIGNMENT - 1) & ~(MODEL_MEMORY_ALIGNMENT - 1);
+
+    char* memory = NULL;
+
+    if (self->blocks)
+        memory = MemoryAllocator_allocate(&(self->blocks->allocator), size);
+
+    if (memory == NULL) {
+        int blockSize = self->nextBlockSize;
+
+        if (blockSize < size)
+            blockSize = size;
+
+        ModelMemoryBlock* block = (ModelMemoryBlock*) GLOBAL_MALLOC(MODEL_MEMORY_BLOCK_HEADER_SIZE + blockSize);
+
+        if (block == NULL)
+            return NULL;
+
+        block->blockSize = blockSize;
+        MemoryAllocator_init(&(block->allocator), (char*) block + MODEL_MEMORY_BLOCK_HEADER_SIZE, blockSize);
+
+        block->next = self->blocks;
+        self->blocks = block;
+
+        if (self->nextBlockSize < MODEL_MEMORY_MAX_BLOCK_SIZE)
+            self->nextBlockSize *= 2;
+
+        memory = MemoryAllocator_allocate(&(block->allocator), size);
+    }
+
+    memset(memory, 0, size);
+
+    return memory;
+}
+
+static uint32_t
+getStringHash(const char* string)
+{
+    /* FNV-1a */
+    uint32_t hash = 2166136261u;
+
+    while (*string) {
+        hash ^= (uint8_t) *string++;
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+static bool
+DynamicIedModel_resizeStringTable(DynamicIedModel* self, int newSize)
+{
+    char** newTable = (char**) GLOBAL_CALLOC(newSize, sizeof(char*));
+
+    if (newTable == NULL)
+        return false;
+
+    int i;
+
+    for (i = 0; i < self->stringTableSize; i++) {
+        char* string = self->strings[i];
+
+        if (string) {
+            int index = getStringHash(string) & (newSize - 1);
+
+            while (newTable[index] != NULL)
+                index = (index + 1) & (newSize - 1);
+
+            newTable[index] = string;
+        }
+    }
+
+    GLOBAL_FREEMEM(self->strings);
+
+    self->strings = newTable;
+    self->stringTableSize = newSize;
+
+    return true;
+}
+
+/* return the shared copy of the string - NULL if string is NULL */
+static char*
+DynamicIedModel_internString(DynamicIedModel* self, const char* string)
+{
+    if (string == NULL)
+        return NULL;
+
+    if ((self->numberOfStrings + 1) * 2 > self->stringTableSize) {
+        if (DynamicIedModel_resizeStringTable(self, self->stringTableSize * 2) == false)
+            return NULL;
+    }
+
+    int index = getStringHash(string) & (self->stringTableSize - 1);
+
+    while (self->strings[index] != NULL) {
+        if (strcmp(self->strings[index], string) == 0)
+            return self->strings[index];
+
+        index = (index + 1) & (self->stringTableSize - 1);
+    }
+
+    int size = strlen(string) + 1;
+
+    char* internedString = (char*) DynamicIedModel_allocate(self, size);
+
+    if (internedString) {
+        memcpy(internedString, string, size);
+
+        self->strings[index] = internedString;
+        self->numberOfStrings++;
+    }
+
+    return internedString;
+}
+
+static DynamicIedModel*
+getDynamicModel(ModelNode* node)
+{
+    while (node->modelType != LogicalDeviceModelType)
+        node = node->parent;
+
+    return (DynamicIedModel*) node->parent;
+}
+
 void
 IedModel_setIedNameForDynamicModel(IedModel* self, const char* name)
 {
-    if (self->name != NULL)
-        GLOBAL_FREEMEM(self->name);
-
-    self->name = StringUtils_copyString(name);
+    /* the old name is released together with the model */
+    self->name = DynamicIedModel_internString((DynamicIedModel*) self, name);
 }
 
 IedModel*
 IedModel_create(const char* name)
 {
-    IedModel* self = (IedModel*) GLOBAL_CALLOC(1, sizeof(IedModel));
+    DynamicIedModel* dynamicModel = (DynamicIedModel*) GLOBAL_CALLOC(1, sizeof(DynamicIedModel));
 
-    if (self)
+    IedModel* self = (IedModel*) dynamicModel;
+
+    if (dynamicModel)
     {
+        dynamicModel->nextBlockSize = MODEL_MEMORY_MIN_BLOCK_SIZE;
+
+        if (DynamicIedModel_resizeStringTable(dynamicModel, 64) == false) {
+            GLOBAL_FREEMEM(dynamicModel);
+            return NULL;
+        }
+
         if (name)
-            self->name = StringUtils_copyString(name);
+            self->name = DynamicIedModel_internString(dynamicModel, name);
         else
             self->name = NULL;
 
@@ -73,138 +251,119 @@ IedModel_create(const char* name)
 static void
 IedModel_addDataSet(IedModel* self, DataSet* dataSet)
 {
+    DynamicIedModel* model = (DynamicIedModel*) self;
+
     if (self->dataSets == NULL)
         self->dataSets = dataSet;
-    else {
-        DataSet* lastDataSet = self->dataSets;
-
-        while (lastDataSet != NULL) {
-            if (lastDataSet->sibling == NULL) {
-                lastDataSet->sibling = dataSet;
-                break;
-            }
+    else
+        model->lastDataSet->sibling = dataSet;
 
-            lastDataSet = lastDataSet->sibling;
-        }
-    }
+    model->lastDataSet = dataSet;
 }
 
 static void
 IedModel_addLogicalDevice(IedModel* self, LogicalDevice* lDevice)
 {
+    DynamicIedModel* model = (DynamicIedModel*) self;
+
     if (self->firstChild == NULL)
         self->firstChild = lDevice;
-    else {
-        LogicalDevice* sibling = self->firstChild;
+    else
+        model->lastLogicalDevice->sibling = (ModelNode*) lDevice;
 
-        while (sibling->sibling != NULL)
-            sibling = (LogicalDevice*) sibling->sibling;
-
-        sibling->sibling = (ModelNode*) lDevice;
-    }
+    model->lastLogicalDevice = lDevice;
 }
 
 static void
 IedModel_addLog(IedModel* self, Log* log)
 {
+    DynamicIedModel* model = (DynamicIedModel*) self;
+
     if (self->logs == NULL)
         self->logs = log;
-    else {
-        Log* lastLog = self->logs;
-
-        while (lastLog->sibling != NULL)
-            lastLog = lastLog->sibling;
+    else
+        model->lastLog->sibling = log;
 
-        lastLog->sibling = log;
-    }
+    model->lastLog = log;
 }
 
 static void
 IedModel_addLogControlBlock(IedModel* self, LogControlBlock* lcb)
 {
+    DynamicIedModel* model = (DynamicIedModel*) self;
+
     if (self->lcbs == NULL)
         self->lcbs = lcb;
-    else {
-        LogControlBlock* lastLcb = self->lcbs;
-
-        while (lastLcb->sibling != NULL)
-            lastLcb = lastLcb->sibling;
+    else
+        model->lastLcb->sibling = lcb;
 
-        lastLcb->sibling = lcb;
-    }
+    model->lastLcb = lcb;
 }
 
 static void
 IedModel_addReportControlBlock(IedModel* self, ReportControlBlock* rcb)
 {
+    DynamicIedModel* model = (DynamicIedModel*) self;
+
     if (self->rcbs == NULL)
         self->rcbs = rcb;
-    else {
-        ReportControlBlock* lastRcb = self->rcbs;
-
-        while (lastRcb->sibling != NULL)
-            lastRcb = lastRcb->sibling;
+    else
+        model->lastRcb->sibling = rcb;
 
-        lastRcb->sibling = rcb;
-    }
+    model->lastRcb = rcb;
 }
 
 #if (CONFIG_IEC61850_SETTING_GROUPS == 1)
 static void
 IedModel_addSettingGroupControlBlock(IedModel* self, SettingGroupControlBlock* sgcb)
 {
+    DynamicIedModel* model = (DynamicIedModel*) self;
+
     if (self->sgcbs == NULL)
         self->sgcbs = sgcb;
-    else {
-        SettingGroupControlBlock* lastSgcb = self->sgcbs;
+    else
+        model->lastSgcb->sibling = sgcb;
 
-        while (lastSgcb->sibling != NULL)
-            lastSgcb = lastSgcb->sibling;
-
-        lastSgcb->sibling = sgcb;
-    }
+    model->lastSgcb = sgcb;
 }
 #endif /* (CONFIG_IEC61850_SETTING_GROUPS == 1) */
 
 static void
 IedModel_addGSEControlBlock(IedModel* self, GSEControlBlock* gcb)
 {
+    DynamicIedModel* model = (DynamicIedModel*) self;
+
     if (self->gseCBs == NULL)
         self->gseCBs = gcb;
-    else {
-        GSEControlBlock* lastGcb = self->gseCBs;
-
-        while (lastGcb->sibling)
-            lastGcb = lastGcb->sibling;
+    else
+        model->lastGcb->sibling = gcb;
 
-        lastGcb->sibling = gcb;
-    }
+    model->lastGcb = gcb;
 }
 
 static void
 IedModel_addSMVControlBlock(IedModel* self, SVControlBlock* smvcb)
 {
-    if (self->svCBs == NULL) {
-        self->svCBs = smvcb;
-    }
-    else {
-        SVControlBlock* lastSvCB = self->svCBs;
+    DynamicIedModel* model = (DynamicIedModel*) self;
 
-        while (lastSvCB->sibling)
-            lastSvCB = lastSvCB->sibling;
+    if (self->svCBs == NULL)
+        self->svCBs = smvcb;
+    else
+        model->lastSvCB->sibling = smvcb;
 
-        lastSvCB->sibling = smvcb;
-    }
+    model->lastSvCB = smvcb;
 }
 
 LogicalDevice*
 LogicalDevice_create(const char* name, IedModel* parent)
 {
-    LogicalDevice* self = (LogicalDevice*) GLOBAL_CALLOC(1, sizeof(LogicalDevice));
+    DynamicIedModel* model = (DynamicIedModel*) parent;
+
+    LogicalDevice* self = (LogicalDevice*) DynamicIedModel_allocate(model, sizeof(LogicalDevice));
 
     if (self)
     {
-        self->name = StringUtils_copyString(name);
+        self->name = DynamicIedModel_internString(model, name);
         self->modelType = LogicalDeviceModelType;
         self->parent = (ModelNode*) parent;
         self->sibling = NULL;
@@ -245,9 +404,14 @@ LogicalDevice_addLogicalNode(LogicalDevice* self, LogicalNode* lNode)
 LogicalNode*
 LogicalNode_create(const char* name, LogicalDevice* parent)
 {
-    LogicalNode* self = (LogicalNode*) GLOBAL_MALLOC(sizeof(LogicalNode));
+    DynamicIedModel* model = getDynamicModel((ModelNode*) parent);
+
+    LogicalNode* self = (LogicalNode*) DynamicIedModel_allocate(model, sizeof(LogicalNode));
 
-    self->name = StringUtils_copyString(name);
+    if (self == NULL)
+        return NULL;
+
+    self->name = DynamicIedModel_internString(model, name);
     self->parent = (ModelNode*) parent;
     self->modelType = LogicalNodeModelType;
     self->firstChild = NULL;
@@ -296,11 +460,13 @@ LogicalNode_addLog(LogicalNode* self, Log* log)
 Log*
 Log_create(const char* name, LogicalNode* parent)
 {
-    Log* self = (Log*) GLOBAL_MALLOC(sizeof(Log));
+    DynamicIedModel* model = getDynamicModel((ModelNode*) parent);
+
+    Log* self = (Log*) DynamicIedModel_allocate(model, sizeof(Log));
 
     if (self)
     {
-        self->name = StringUtils_copyString(name);
+        self->name = DynamicIedModel_internString(model, name);
         self->parent = parent;
         self->sibling = NULL;
 
@@ -322,23 +488,17 @@ LogControlBlock*
 LogControlBlock_create(const char* name, LogicalNode* parent, const char* dataSetName, const char* logRef, uint8_t trgOps,
         uint32_t intPeriod, bool logEna, bool reasonCode)
 {
-    LogControlBlock* self = (LogControlBlock*) GLOBAL_MALLOC(sizeof(LogControlBlock));
+    DynamicIedModel* model = getDynamicModel((ModelNode*) parent);
+
+    LogControlBlock* self = (LogControlBlock*) DynamicIedModel_allocate(model, sizeof(LogControlBlock));
 
     if (self)
     {
-        self->name = StringUtils_copyString(name);
+        self->name = DynamicIedModel_internString(model, name);
         self->parent = parent;
         self->sibling = NULL;
-
-        if (dataSetName)
-            self->dataSetName = StringUtils_copyString(dataSetName);
-        else
-            self->dataSetName = NULL;
-
-        if (logRef)
-            self->logRef = StringUtils_copyString(logRef);
-        else
-            self->logRef = NULL;
+        self->dataSetName = DynamicIedModel_internString(model, dataSetName);
+        self->logRef = DynamicIedModel_internString(model, logRef);
 
         self->trgOps = trgOps;
         self->intPeriod = intPeriod;
@@ -363,24 +523,17 @@ ReportControlBlock*
 ReportControlBlock_create(const char* name, LogicalNode* parent, const char* rptId, bool isBuffered, const char*
         dataSetName, uint32_t confRef, uint8_t trgOps, uint8_t options, uint32_t bufTm, uint32_t intgPd)
 {
-    ReportControlBlock* self = (ReportControlBlock*) GLOBAL_MALLOC(sizeof(ReportControlBlock));
+    DynamicIedModel* model = getDynamicModel((ModelNode*) parent);
+
+    ReportControlBlock* self = (ReportControlBlock*) DynamicIedModel_allocate(model, sizeof(ReportControlBlock));
 
     if (self)
     {
-        self->name = StringUtils_copyString(name);
+        self->name = DynamicIedModel_internString(model, name);
         self->parent = parent;
-
-        if (rptId)
-            self->rptId = StringUtils_copyString(rptId);
-        else
-            self->rptId = NULL;
-
+        self->rptId = DynamicIedModel_internString(model, rptId);
         self->buffered = isBuffered;
-
-        if (dataSetName)
-            self->dataSetName = StringUtils_copyString(dataSetName);
-        else
-            self->dataSetName = NULL;
+        self->dataSetName = DynamicIedModel_internString(model, dataSetName);
 
         self->confRef = confRef;
         self->trgOps = trgOps;
@@ -445,7 +598,8 @@ SettingGroupControlBlock_create(LogicalNode* parent, uint8_t actSG, uint8_t numO
     assert(actSG <= numOfSGs); /* actSG starting with 1 */
     assert(strcmp(parent->name, "LLN0") == 0);
 
-    SettingGroupControlBlock* self = (SettingGroupControlBlock*) GLOBAL_MALLOC(sizeof(SettingGroupControlBlock));
+    SettingGroupControlBlock* self = (SettingGroupControlBlock*)
+            DynamicIedModel_allocate(getDynamicModel((ModelNode*) parent), sizeof(SettingGroupControlBlock));
 
     if (self)
     {
@@ -474,23 +628,41 @@ GSEControlBlock*
 GSEControlBlock_create(const char* name, LogicalNode* parent, const char* appId, const char* dataSet, uint32_t confRef, bool fixedOffs,
         int minTime, int maxTime)
 {
-    GSEControlBlock* self = (GSEControlBlock*) GLOBAL_MALLOC(sizeof(GSEControlBlock));
+    GSEControlBlock* self;
+
+    if (parent) {
+        DynamicIedModel* model = getDynamicModel((ModelNode*) parent);
+
+        self = (GSEControlBlock*) DynamicIedModel_allocate(model, sizeof(GSEControlBlock));
+
+        if (self) {
+            self->name = DynamicIedModel_internString(model, name);
+            self->appId = DynamicIedModel_internString(model, appId);
+            self->dataSetName = DynamicIedModel_internString(model, dataSet);
+        }
+    }
+    else {
+        self = (GSEControlBlock*) GLOBAL_MALLOC(sizeof(GSEControlBlock));
+
+        if (self) {
+            self->name = StringUtils_copyString(name);
+
+            if (appId)
+                self->appId = StringUtils_copyString(appId);
+            else
+                self->appId = NULL;
+
+            if (dataSet)
+                self->dataSetName = StringUtils_copyString(dataSet);
+            else
+                self->dataSetName = NULL;
+        }
+    }
 
     if (self)
     {
-        self->name = StringUtils_copyString(name);
         self->parent = parent;
 
-        if (appId)
-            self->appId = StringUtils_copyString(appId);
-        else
-            self->appId = NULL;
-
-        if (dataSet)
-            self->dataSetName = StringUtils_copyString(dataSet);
-        else
-            self->dataSetName = NULL;
-
         self->confRev = confRef;
         self->fixedOffs = fixedOffs;
         self->minTime = minTime;
@@ -519,19 +691,36 @@ SVControlBlock*
 SVControlBlock_create(const char* name, LogicalNode* parent, const char* svID, const char* dataSet, uint32_t confRev, uint8_t smpMod,
         uint16_t smpRate, uint8_t optFlds, bool isUnicast)
 {
-    SVControlBlock* self = (SVControlBlock*) GLOBAL_MALLOC(sizeof(SVControlBlock));
+    SVControlBlock* self;
 
-    if (self) 
-    {
-        self->name = StringUtils_copyString(name);
-        self->parent = parent;
+    if (parent) {
+        DynamicIedModel* model = getDynamicModel((ModelNode*) parent);
 
-        self->svId = StringUtils_copyString(svID); /* Is there a default value? */
+        self = (SVControlBlock*) DynamicIedModel_allocate(model, sizeof(SVControlBlock));
 
-        if (dataSet)
-            self->dataSetName = StringUtils_copyString(dataSet);
-        else
-            self->dataSetName = NULL;
+        if (self) {
+            self->name = DynamicIedModel_internString(model, name);
+            self->svId = DynamicIedModel_internString(model, svID); /* Is there a default value? */
+            self->dataSetName = DynamicIedModel_internString(model, dataSet);
+        }
+    }
+    else {
+        self = (SVControlBlock*) GLOBAL_MALLOC(sizeof(SVControlBlock));
+
+        if (self) {
+            self->name = StringUtils_copyString(name);
+            self->svId = StringUtils_copyString(svID); /* Is there a default value? */
+
+            if (dataSet)
+                self->dataSetName = StringUtils_copyString(dataSet);
+            else
+                self->dataSetName = NULL;
+        }
+    }
+
+    if (self)
+    {
+        self->parent = parent;
 
         self->confRev = confRev;
 
@@ -610,11 +799,13 @@ DataObject_addChild(DataObject* self, ModelNode* child)
 DataObject*
 DataObject_create(const char* name, ModelNode* parent, int arrayElements)
 {
-    DataObject* self = (DataObject*) GLOBAL_MALLOC(sizeof(DataObject));
+    DynamicIedModel* model = getDynamicModel(parent);
+
+    DataObject* self = (DataObject*) DynamicIedModel_allocate(model, sizeof(DataObject));
 
     if (self)
     {
-        self->name = StringUtils_copyString(name);
+        self->name = DynamicIedModel_internString(model, name);
         self->modelType = DataObjectModelType;
         self->elementCount = arrayElements;
         self->firstChild = NULL;
@@ -661,11 +852,13 @@ DataAttribute*
 DataAttribute_create(const char* name, ModelNode* parent, DataAttributeType type, FunctionalConstraint fc,
         uint8_t triggerOptions, int arrayElements, uint32_t sAddr)
 {
-    DataAttribute* self = (DataAttribute*) GLOBAL_MALLOC(sizeof(DataAttribute));
+    DynamicIedModel* model = getDynamicModel(parent);
+
+    DataAttribute* self = (DataAttribute*) DynamicIedModel_allocate(model, sizeof(DataAttribute));
 
     if (self)
     {
-        self->name = StringUtils_copyString(name);
+        self->name = DynamicIedModel_internString(model, name);
         self->elementCount = arrayElements;
         self->modelType = DataAttributeModelType;
         self->type = type;
@@ -718,13 +911,18 @@ DataAttribute_setValue(DataAttribute* self, MmsValue* value)
 DataSet*
 DataSet_create(const char* name, LogicalNode* parent)
 {
-    DataSet* self = (DataSet*) GLOBAL_MALLOC(sizeof(DataSet));
+    LogicalDevice* ld = (LogicalDevice*) parent->parent;
+    DynamicIedModel* model = (DynamicIedModel*) ld->parent;
+
+    DataSet* self = (DataSet*) DynamicIedModel_allocate(model, sizeof(DataSet));
 
     if (self)
     {
-        LogicalDevice* ld = (LogicalDevice*) parent->parent;
+        char* dataSetName = StringUtils_createString(3, parent->name, "$", name);
 
-        self->name = StringUtils_createString(3, parent->name, "$", name);
+        self->name = DynamicIedModel_internString(model, dataSetName);
+
+        GLOBAL_FREEMEM(dataSetName);
         self->elementCount = 0;
         self->sibling = NULL;
         self->logicalDeviceName = ld->name;
@@ -828,31 +1026,22 @@ DataSetEntry_create(DataSet* dataSet, const char* variable, int index, const cha
 static void
 ModelNode_destroy(ModelNode* modelNode)
 {
-    if (modelNode) {
-
-        if (modelNode->name)
-            GLOBAL_FREEMEM(modelNode->name);
+    /* the model nodes and names are released with the memory blocks of the model */
+    ModelNode* currentChild = modelNode->firstChild;
 
-        ModelNode* currentChild = modelNode->firstChild;
+    while (currentChild != NULL) {
+        ModelNode_destroy(currentChild);
 
-        while (currentChild != NULL) {
-            ModelNode* nextChild = currentChild->sibling;
-
-            ModelNode_destroy(currentChild);
-
-            currentChild = nextChild;
-        }
+        currentChild = currentChild->sibling;
+    }
 
-        if (modelNode->modelType == DataAttributeModelType) {
-            DataAttribute* dataAttribute = (DataAttribute*) modelNode;
+    if (modelNode->modelType == DataAttributeModelType) {
+        DataAttribute* dataAttribute = (DataAttribute*) modelNode;
 
-            if (dataAttribute->mmsValue != NULL) {
-                MmsValue_delete(dataAttribute->mmsValue);
-                dataAttribute->mmsValue = NULL;
-            }
+        if (dataAttribute->mmsValue != NULL) {
+            MmsValue_delete(dataAttribute->mmsValue);
+            dataAttribute->mmsValue = NULL;
         }
-
-        GLOBAL_FREEMEM(modelNode);
     }
 }
 
@@ -860,54 +1049,23 @@ void
 IedModel_destroy(IedModel* model)
 {
     if (model) {
-        /* delete all model nodes and dynamically created strings */
+        DynamicIedModel* dynamicModel = (DynamicIedModel*) model;
 
-        /* delete all logical devices */
+        /* delete the values of all data attributes */
 
         LogicalDevice* ld = model->firstChild;
 
         while (ld != NULL) {
-            GLOBAL_FREEMEM (ld->name);
-
-            LogicalNode* ln = (LogicalNode*) ld->firstChild;
-
-            while (ln != NULL) {
-                GLOBAL_FREEMEM(ln->name);
-
-                /* delete all data objects */
+            ModelNode_destroy((ModelNode*) ld);
 
-                DataObject* currentDataObject = (DataObject*) ln->firstChild;
-
-                while (currentDataObject != NULL) {
-                    DataObject* nextDataObject = (DataObject*) currentDataObject->sibling;
-
-                    ModelNode_destroy((ModelNode*) currentDataObject);
-
-                    currentDataObject = nextDataObject;
-                }
-
-                LogicalNode* currentLn = ln;
-                ln = (LogicalNode*) ln->sibling;
-
-                GLOBAL_FREEMEM(currentLn);
-            }
-
-
-            LogicalDevice* currentLd = ld;
             ld = (LogicalDevice*) ld->sibling;
-
-            GLOBAL_FREEMEM(currentLd);
         }
 
-        /*  delete all data sets */
+        /*  delete all data set entries */
 
         DataSet* dataSet = model->dataSets;
 
         while (dataSet != NULL) {
-            DataSet* nextDataSet = dataSet->sibling;
-
-            GLOBAL_FREEMEM(dataSet->name);
-
             DataSetEntry* dse = dataSet->fcdas;
 
             while (dse != NULL) {
@@ -926,102 +1084,107 @@ IedModel_destroy(IedModel* model)
                 dse = nextDse;
             }
 
-            GLOBAL_FREEMEM(dataSet);
-
-            dataSet = nextDataSet;
+            dataSet = dataSet->sibling;
         }
 
-        /* delete all RCBs */
-
-        ReportControlBlock* rcb = model->rcbs;
+        /* delete communication parameters of GoCBs and SVCBs */
 
-        while (rcb != NULL) {
-            ReportControlBlock* nextRcb = rcb->sibling;
+        GSEControlBlock* gcb = model->gseCBs;
 
-            GLOBAL_FREEMEM(rcb->name);
+        while (gcb != NULL) {
+            if (gcb->address)
+                GLOBAL_FREEMEM(gcb->address);
 
-            if (rcb->rptId)
-                GLOBAL_FREEMEM(rcb->rptId);
+            gcb = gcb->sibling;
+        }
 
-            if (rcb->dataSetName)
-                GLOBAL_FREEMEM(rcb->dataSetName);
+        SVControlBlock* svcb = model->svCBs;
 
-            GLOBAL_FREEMEM(rcb);
+        while (svcb != NULL) {
+            if (svcb->dstAddress)
+                GLOBAL_FREEMEM(svcb->dstAddress);
 
-            rcb = nextRcb;
+            svcb = svcb->sibling;
         }
 
-        /* delete all GoCBs */
+        /* delete all model nodes, control blocks and strings */
 
-        GSEControlBlock* gcb = model->gseCBs;
+        ModelMemoryBlock* block = dynamicModel->blocks;
 
-        while (gcb != NULL) {
-            GSEControlBlock* nextGcb = gcb->sibling;
+        while (block != NULL) {
+            ModelMemoryBlock* nextBlock = block->next;
 
-            GLOBAL_FREEMEM(gcb->name);
-            GLOBAL_FREEMEM(gcb->appId);
-            GLOBAL_FREEMEM(gcb->dataSetName);
+            GLOBAL_FREEMEM(block);
 
-            if (gcb->address)
-                GLOBAL_FREEMEM(gcb->address);
+            block = nextBlock;
+        }
 
-            GLOBAL_FREEMEM(gcb);
+        GLOBAL_FREEMEM(dynamicModel->strings);
 
-            gcb = nextGcb;
-        }
+        GLOBAL_FREEMEM(dynamicModel);
+    }
+}
 
-        /* delete setting controls */
+static int
+getDataSetEntryMemoryUsage(DataSetEntry* dse)
+{
+    int memoryUsage = sizeof(DataSetEntry) + strlen(dse->variableName) + 1;
 
-        SettingGroupControlBlock* sgcb = model->sgcbs;
+    if (dse->componentName != NULL)
+        memoryUsage += strlen(dse->componentName) + 1;
 
-        while (sgcb != NULL) {
-            SettingGroupControlBlock* nextSgcb = sgcb->sibling;
+    if (dse->isLDNameDynamicallyAllocated)
+        memoryUsage += strlen(dse->logicalDeviceName) + 1;
 
-            GLOBAL_FREEMEM(sgcb);
+    return memoryUsage;
+}
 
-            sgcb = nextSgcb;
-        }
+int
+IedModel_getMemoryUsage(IedModel* self)
+{
+    DynamicIedModel* dynamicModel = (DynamicIedModel*) self;
 
-        /* delete all LCBs */
-        LogControlBlock* lcb = model->lcbs;
+    int memoryUsage = sizeof(DynamicIedModel) + (dynamicModel->stringTableSize * sizeof(char*));
 
-        while (lcb != NULL) {
-            LogControlBlock* nextLcb = lcb->sibling;
+    ModelMemoryBlock* block = dynamicModel->blocks;
 
-            if (lcb->name)
-                GLOBAL_FREEMEM(lcb->name);
+    while (block != NULL) {
+        memoryUsage += MODEL_MEMORY_BLOCK_HEADER_SIZE + block->blockSize;
 
-            if (lcb->dataSetName)
-                GLOBAL_FREEMEM(lcb->dataSetName);
+        block = block->next;
+    }
 
-            if (lcb->logRef)
-                GLOBAL_FREEMEM(lcb->logRef);
+    DataSet* dataSet = self->dataSets;
 
-            GLOBAL_FREEMEM(lcb);
+    while (dataSet != NULL) {
+        DataSetEntry* dse = dataSet->fcdas;
 
-            lcb = nextLcb;
-        }
+        while (dse != NULL) {
+            memoryUsage += getDataSetEntryMemoryUsage(dse);
 
-        /* delete all LOGs */
-        Log* log = model->logs;
+            dse = dse->sibling;
+        }
 
-        while (log != NULL) {
-            Log* nextLog = log->sibling;
+        dataSet = dataSet->sibling;
+    }
 
-            if (log->name)
-                GLOBAL_FREEMEM(log->name);
+    GSEControlBlock* gcb = self->gseCBs;
 
-            GLOBAL_FREEMEM(log);
+    while (gcb != NULL) {
+        if (gcb->address)
+            memoryUsage += sizeof(PhyComAddress);
 
-            log = nextLog;
-        }
+        gcb = gcb->sibling;
+    }
 
-        /* delete generic model parts */
+    SVControlBlock* svcb = self->svCBs;
 
-        if (model->name)
-            GLOBAL_FREEMEM(model->name);
+    while (svcb != NULL) {
+        if (svcb->dstAddress)
+            memoryUsage += sizeof(PhyComAddress);
 
-        GLOBAL_FREEMEM(model);
+        svcb = svcb->sibling;
     }
-}
 
+    return memoryUsage;
+}
@@ -0,0 +1,1232 @@
+/*
+ *  model_image.c
+ *
+ *  Binary data model images that can be loaded without parsing
+ *
+ *  This file is part of libIEC61850.
+ *
+ *  libIEC61850 is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  libIEC61850 is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with libIEC61850.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+#include "iec61850_server.h"
+#include "iec61850_config_file_parser.h"
+
+#include "libiec61850_platform_includes.h"
+#include "stack_config.h"
+
+/*
+ * Image layout:
+ *
+ * The image starts with a header followed by one section per element type. The sections
+ * contain the model structures (IedModel, LogicalDevice, ...) in their native memory layout.
+ * Pointers between the structures are stored as offsets relative to the start of the image
+ * (0 = NULL). Loading an image only requires to add the base address of the image to all
+ * pointers ("relocation"). The initial values of data attributes are stored BER encoded in the
+ * VALUES section. All strings are stored (deduplicated) in the STRINGS section at the end of the
+ * image.
+ *
+ * Because the structures are stored in the native layout an image can only be loaded by
+ * a library build for the same platform (byte order, pointer size and structure sizes are
+ * checked when loading the image).
+ */
+
+#define MODEL_IMAGE_MAGIC "LIBIECMI"
+#define MODEL_IMAGE_VERSION 1
+#define MODEL_IMAGE_BYTE_ORDER_MARK 0x0102
+
+#define MODEL_IMAGE_ALIGNMENT 8
+
+typedef enum {
+    IMAGE_SECTION_MODEL,
+    IMAGE_SECTION_LD,
+    IMAGE_SECTION_LN,
+    IMAGE_SECTION_DO,
+    IMAGE_SECTION_DA,
+    IMAGE_SECTION_DATA_SET,
+    IMAGE_SECTION_DATA_SET_ENTRY,
+    IMAGE_SECTION_RCB,
+    IMAGE_SECTION_GSE,
+    IMAGE_SECTION_SV,
+    IMAGE_SECTION_SGCB,
+    IMAGE_SECTION_LCB,
+    IMAGE_SECTION_LOG,
+    IMAGE_SECTION_PHY_COM_ADDRESS,
+    IMAGE_SECTION_VALUES,
+    IMAGE_SECTION_STRINGS,
+    NUMBER_OF_IMAGE_SECTIONS
+} ImageSectionType;
+
+static const uint32_t imageElementSizes[NUMBER_OF_IMAGE_SECTIONS] = {
+    sizeof(IedModel),
+    sizeof(LogicalDevice),
+    sizeof(LogicalNode),
+    sizeof(DataObject),
+    sizeof(DataAttribute),
+    sizeof(DataSet),
+    sizeof(DataSetEntry),
+    sizeof(ReportControlBlock),
+    sizeof(GSEControlBlock),
+    sizeof(SVControlBlock),
+    sizeof(SettingGroupControlBlock),
+    sizeof(LogControlBlock),
+    sizeof(Log),
+    sizeof(PhyComAddress),
+    1,
+    1
+};
+
+typedef struct {
+    uint32_t offset;
+    uint32_t count;
+    uint32_t elementSize;
+    uint32_t reserved;
+} ImageSection;
+
+typedef struct {
+    char magic[8];
+    uint16_t version;
+    uint16_t byteOrderMark;
+    uint16_t pointerSize;
+    uint16_t numberOfSections;
+    uint32_t imageSize;
+    uint32_t reserved;
+    ImageSection sections[NUMBER_OF_IMAGE_SECTIONS];
+} ImageHeader;
+
+#define IMAGE_OFFSET(type, offset) ((type*) (uintptr_t) (offset))
+
+struct sIedModelImage {
+    uint8_t* buffer;
+    uint32_t size;
+    bool isMapped;
+    IedModel* model;
+};
+
+static void
+modelImage_emptyVariableInitializer(void)
+{
+    return;
+}
+
+/*********************************************************************************
+ * Image writer
+ *********************************************************************************/
+
+typedef struct {
+    LogicalNode* node;
+    uint32_t offset;
+} LogicalNodeOffset;
+
+typedef struct {
+    uint8_t* buffer;
+    ImageHeader* header;
+
+    /* next free position in each section */
+    uint32_t writePos[NUMBER_OF_IMAGE_SECTIONS];
+
+    /* open addressing hash table to deduplicate strings (string offsets, 0 = empty) */
+    uint32_t* stringTable;
+    uint32_t stringTableSize;
+
+    /* sorted list of logical nodes to resolve the parents of control blocks */
+    LogicalNodeOffset* lnOffsets;
+    int lnCount;
+
+    uint32_t counts[NUMBER_OF_IMAGE_SECTIONS];
+    uint32_t numberOfStrings;
+} ImageWriter;
+
+static void
+countString(ImageWriter* self, const char* string)
+{
+    if (string) {
+        self->counts[IMAGE_SECTION_STRINGS] += strlen(string) + 1;
+        self->numberOfStrings++;
+    }
+}
+
+static int
+getEncodedValueSize(MmsValue* value)
+{
+    int size = MmsValue_encodeMmsData(value, NULL, 0, false);
+
+    uint8_t* buffer = (uint8_t*) GLOBAL_MALLOC(size);
+
+    if (buffer == NULL)
+        return 0;
+
+    MmsValue_encodeMmsData(value, buffer, 0, true);
+
+    /* values that cannot be decoded (e.g. empty strings) are the default values of the cache */
+    MmsValue* decodedValue = MmsValue_decodeMmsData(buffer, 0, size, NULL);
+
+    GLOBAL_FREEMEM(buffer);
+
+    if (decodedValue == NULL)
+        return 0;
+
+    MmsValue_delete(decodedValue);
+
+    return size;
+}
+
+static void
+countModelNode(ImageWriter* self, ModelNode* node)
+{
+    switch (node->modelType) {
+    case LogicalDeviceModelType:
+        self->counts[IMAGE_SECTION_LD]++;
+        break;
+    case LogicalNodeModelType:
+        self->counts[IMAGE_SECTION_LN]++;
+        break;
+    case DataObjectModelType:
+        self->counts[IMAGE_SECTION_DO]++;
+        break;
+    case DataAttributeModelType:
+        {
+            DataAttribute* da = (DataAttribute*) node;
+
+            self->counts[IMAGE_SECTION_DA]++;
+
+            if (da->mmsValue)
+                self->counts[IMAGE_SECTION_VALUES] += getEncodedValueSize(da->mmsValue);
+        }
+        break;
+    }
+
+    countString(self, node->name);
+
+    ModelNode* child = node->firstChild;
+
+    while (child) {
+        countModelNode(self, child);
+        child = child->sibling;
+    }
+}
+
+static void
+countModel(ImageWriter* self, IedModel* model)
+{
+    self->counts[IMAGE_SECTION_MODEL] = 1;
+    countString(self, model->name);
+
+    LogicalDevice* ld = model->firstChild;
+
+    while (ld) {
+        countModelNode(self, (ModelNode*) ld);
+        ld = (LogicalDevice*) ld->sibling;
+    }
+
+    DataSet* dataSet = model->dataSets;
+
+    while (dataSet) {
+        self->counts[IMAGE_SECTION_DATA_SET]++;
+        countString(self, dataSet->logicalDeviceName);
+        countString(self, dataSet->name);
+
+        DataSetEntry* entry = dataSet->fcdas;
+
+        while (entry) {
+            self->counts[IMAGE_SECTION_DATA_SET_ENTRY]++;
+            countString(self, entry->logicalDeviceName);
+            countString(self, entry->variableName);
+            countString(self, entry->componentName);
+
+            entry = entry->sibling;
+        }
+
+        dataSet = dataSet->sibling;
+    }
+
+    ReportControlBlock* rcb = model->rcbs;
+
+    while (rcb) {
+        self->counts[IMAGE_SECTION_RCB]++;
+        countString(self, rcb->name);
+        countString(self, rcb->rptId);
+        countString(self, rcb->dataSetName);
+        rcb = rcb->sibling;
+    }
+
+    GSEControlBlock* gcb = model->gseCBs;
+
+    while (gcb) {
+        self->counts[IMAGE_SECTION_GSE]++;
+        countString(self, gcb->name);
+        countString(self, gcb->appId);
+        countString(self, gcb->dataSetName);
+
+        if (gcb->address)
+            self->counts[IMAGE_SECTION_PHY_COM_ADDRESS]++;
+
+        gcb = gcb->sibling;
+    }
+
+    SVControlBlock* svcb = model->svCBs;
+
+    while (svcb) {
+        self->counts[IMAGE_SECTION_SV]++;
+        countString(self, svcb->name);
+        countString(self, svcb->svId);
+        countString(self, svcb->dataSetName);
+
+        if (svcb->dstAddress)
+            self->counts[IMAGE_SECTION_PHY_COM_ADDRESS]++;
+
+        svcb = svcb->sibling;
+    }
+
+    SettingGroupControlBlock* sgcb = model->sgcbs;
+
+    while (sgcb) {
+        self->counts[IMAGE_SECTION_SGCB]++;
+        sgcb = sgcb->sibling;
+    }
+
+    LogControlBlock* lcb = model->lcbs;
+
+    while (lcb) {
+        self->counts[IMAGE_SECTION_LCB]++;
+        countString(self, lcb->name);
+        countString(self, lcb->dataSetName);
+        countString(self, lcb->logRef);
+        lcb = lcb->sibling;
+    }
+
+    Log* log = model->logs;
+
+    while (log) {
+        self->counts[IMAGE_SECTION_LOG]++;
+        countString(self, log->name);
+        log = log->sibling;
+    }
+}
+
+static uint32_t
+alignImageOffset(uint32_t offset)
+{
+    return (offset + (MODEL_IMAGE_ALIGNMENT - 1)) & ~((uint32_t) (MODEL_IMAGE_ALIGNMENT - 1));
+}
+
+/* allocate the next element of a section - returns the image offset of the element */
+static uint32_t
+allocateElement(ImageWriter* self, ImageSectionType sectionType)
+{
+    uint32_t offset = self->writePos[sectionType];
+
+    self->writePos[sectionType] += imageElementSizes[sectionType];
+
+    return offset;
+}
+
+static uint32_t
+getStringHash(const char* string)
+{
+    /* FNV-1a */
+    uint32_t hash = 2166136261u;
+
+    while (*string) {
+        hash ^= (uint8_t) *string++;
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+static uint32_t
+writeString(ImageWriter* self, const char* string)
+{
+    if (string == NULL)
+        return 0;
+
+    uint32_t index = getStringHash(string) & (self->stringTableSize - 1);
+
+    while (self->stringTable[index] != 0) {
+        if (strcmp((char*) self->buffer + self->stringTable[index], string) == 0)
+            return self->stringTable[index];
+
+        index = (index + 1) & (self->stringTableSize - 1);
+    }
+
+    uint32_t offset = self->writePos[IMAGE_SECTION_STRINGS];
+    int length = strlen(string) + 1;
+
+    memcpy(self->buffer + offset, string, length);
+
+    self->writePos[IMAGE_SECTION_STRINGS] += length;
+    self->stringTable[index] = offset;
+
+    return offset;
+}
+
+static uint32_t
+writeValue(ImageWriter* self, MmsValue* value)
+{
+    if ((value == NULL) || (getEncodedValueSize(value) == 0))
+        return 0;
+
+    uint32_t offset = self->writePos[IMAGE_SECTION_VALUES];
+
+    self->writePos[IMAGE_SECTION_VALUES] = MmsValue_encodeMmsData(value, self->buffer, offset, true);
+
+    return offset;
+}
+
+static int
+compareLogicalNodeOffsets(const void* a, const void* b)
+{
+    uintptr_t nodeA = (uintptr_t) ((const LogicalNodeOffset*) a)->node;
+    uintptr_t nodeB = (uintptr_t) ((const LogicalNodeOffset*) b)->node;
+
+    if (nodeA < nodeB)
+        return -1;
+    else if (nodeA > nodeB)
+        return 1;
+    else
+        return 0;
+}
+
+static uint32_t
+getLogicalNodeOffset(ImageWriter* self, LogicalNode* node)
+{
+    if (node == NULL)
+        return 0;
+
+    LogicalNodeOffset key;
+    key.node = node;
+
+    LogicalNodeOffset* entry = (LogicalNodeOffset*) bsearch(&key, self->lnOffsets, self->lnCount,
+            sizeof(LogicalNodeOffset), compareLogicalNodeOffsets);
+
+    if (entry)
+        return entry->offset;
+    else
+        return 0;
+}
+
+static uint32_t
+writeModelNode(ImageWriter* self, ModelNode* node, uint32_t parentOffset)
+{
+    uint32_t offset;
+    ModelNode* imageNode;
+
+    switch (node->modelType) {
+    case LogicalDeviceModelType:
+        offset = allocateElement(self, IMAGE_SECTION_LD);
+        imageNode = (ModelNode*) (self->buffer + offset);
+        memcpy(imageNode, node, sizeof(LogicalDevice));
+        break;
+
+    case LogicalNodeModelType:
+        offset = allocateElement(self, IMAGE_SECTION_LN);
+        imageNode = (ModelNode*) (self->buffer + offset);
+        memcpy(imageNode, node, sizeof(LogicalNode));
+
+        self->lnOffsets[self->lnCount].node = (LogicalNode*) node;
+        self->lnOffsets[self->lnCount].offset = offset;
+        self->lnCount++;
+        break;
+
+    case DataObjectModelType:
+        offset = allocateElement(self, IMAGE_SECTION_DO);
+        imageNode = (ModelNode*) (self->buffer + offset);
+        memcpy(imageNode, node, sizeof(DataObject));
+        break;
+
+    default:
+        {
+            offset = allocateElement(self, IMAGE_SECTION_DA);
+            imageNode = (ModelNode*) (self->buffer + offset);
+            memcpy(imageNode, node, sizeof(DataAttribute));
+
+            DataAttribute* da = (DataAttribute*) imageNode;
+
+            da->mmsValue = IMAGE_OFFSET(MmsValue, writeValue(self, ((DataAttribute*) node)->mmsValue));
+        }
+        break;
+    }
+
+    imageNode->name = IMAGE_OFFSET(char, writeString(self, node->name));
+    imageNode->parent = IMAGE_OFFSET(ModelNode, parentOffset);
+    imageNode->sibling = NULL;
+    imageNode->firstChild = NULL;
+
+    ModelNode* child = node->firstChild;
+    ModelNode* lastImageChild = NULL;
+
+    while (child) {
+        uint32_t childOffset = writeModelNode(self, child, offset);
+
+        if (lastImageChild)
+            lastImageChild->sibling = IMAGE_OFFSET(ModelNode, childOffset);
+        else
+            imageNode->firstChild = IMAGE_OFFSET(ModelNode, childOffset);
+
+        lastImageChild = (ModelNode*) (self->buffer + childOffset);
+
+        child = child->sibling;
+    }
+
+    return offset;
+}
+
+static uint32_t
+writePhyComAddress(ImageWriter* self, PhyComAddress* address)
+{
+    if (address == NULL)
+        return 0;
+
+    uint32_t offset = allocateElement(self, IMAGE_SECTION_PHY_COM_ADDRESS);
+
+    memcpy(self->buffer + offset, address, sizeof(PhyComAddress));
+
+    return offset;
+}
+
+static void
+writeModel(ImageWriter* self, IedModel* model)
+{
+    uint32_t modelOffset = allocateElement(self, IMAGE_SECTION_MODEL);
+    IedModel* imageModel = (IedModel*) (self->buffer + modelOffset);
+
+    imageModel->name = IMAGE_OFFSET(char, writeString(self, model->name));
+
+    /* logical devices and the data model tree */
+    LogicalDevice* ld = model->firstChild;
+    LogicalDevice* lastImageLd = NULL;
+
+    while (ld) {
+        uint32_t ldOffset = writeModelNode(self, (ModelNode*) ld, modelOffset);
+
+        if (lastImageLd)
+            lastImageLd->sibling = IMAGE_OFFSET(ModelNode, ldOffset);
+        else
+            imageModel->firstChild = IMAGE_OFFSET(LogicalDevice, ldOffset);
+
+        lastImageLd = (LogicalDevice*) (self->buffer + ldOffset);
+
+        ld = (LogicalDevice*) ld->sibling;
+    }
+
+    qsort(self->lnOffsets, self->lnCount, sizeof(LogicalNodeOffset), compareLogicalNodeOffsets);
+
+    /* data sets */
+    DataSet* dataSet = model->dataSets;
+    DataSet* lastImageDataSet = NULL;
+
+    while (dataSet) {
+        uint32_t offset = allocateElement(self, IMAGE_SECTION_DATA_SET);
+        DataSet* imageDataSet = (DataSet*) (self->buffer + offset);
+
+        imageDataSet->logicalDeviceName = IMAGE_OFFSET(char, writeString(self, dataSet->logicalDeviceName));
+        imageDataSet->name = IMAGE_OFFSET(char, writeString(self, dataSet->name));
+        imageDataSet->elementCount = dataSet->elementCount;
+
+        DataSetEntry* entry = dataSet->fcdas;
+        DataSetEntry* lastImageEntry = NULL;
+
+        while (entry) {
+            uint32_t entryOffset = allocateElement(self, IMAGE_SECTION_DATA_SET_ENTRY);
+            DataSetEntry* imageEntry = (DataSetEntry*) (self->buffer + entryOffset);
+
+            imageEntry->logicalDeviceName = IMAGE_OFFSET(char, writeString(self, entry->logicalDeviceName));
+            imageEntry->variableName = IMAGE_OFFSET(char, writeString(self, entry->variableName));
+            imageEntry->index = entry->index;
+            imageEntry->componentName = IMAGE_OFFSET(char, writeString(self, entry->componentName));
+
+            if (lastImageEntry)
+                lastImageEntry->sibling = IMAGE_OFFSET(DataSetEntry, entryOffset);
+            else
+                imageDataSet->fcdas = IMAGE_OFFSET(DataSetEntry, entryOffset);
+
+            lastImageEntry = imageEntry;
+
+            entry = entry->sibling;
+        }
+
+        if (lastImageDataSet)
+            lastImageDataSet->sibling = IMAGE_OFFSET(DataSet, offset);
+        else
+            imageModel->dataSets = IMAGE_OFFSET(DataSet, offset);
+
+        lastImageDataSet = imageDataSet;
+
+        dataSet = dataSet->sibling;
+    }
+
+    /* report control blocks */
+    ReportControlBlock* rcb = model->rcbs;
+    ReportControlBlock* lastImageRcb = NULL;
+
+    while (rcb) {
+        uint32_t offset = allocateElement(self, IMAGE_SECTION_RCB);
+        ReportControlBlock* imageRcb = (ReportControlBlock*) (self->buffer + offset);
+
+        memcpy(imageRcb, rcb, sizeof(ReportControlBlock));
+
+        imageRcb->parent = IMAGE_OFFSET(LogicalNode, getLogicalNodeOffset(self, rcb->parent));
+        imageRcb->name = IMAGE_OFFSET(char, writeString(self, rcb->name));
+        imageRcb->rptId = IMAGE_OFFSET(char, writeString(self, rcb->rptId));
+        imageRcb->dataSetName = IMAGE_OFFSET(char, writeString(self, rcb->dataSetName));
+        imageRcb->sibling = NULL;
+
+        if (lastImageRcb)
+            lastImageRcb->sibling = IMAGE_OFFSET(ReportControlBlock, offset);
+        else
+            imageModel->rcbs = IMAGE_OFFSET(ReportControlBlock, offset);
+
+        lastImageRcb = imageRcb;
+
+        rcb = rcb->sibling;
+    }
+
+    /* GoCBs */
+    GSEControlBlock* gcb = model->gseCBs;
+    GSEControlBlock* lastImageGcb = NULL;
+
+    while (gcb) {
+        uint32_t offset = allocateElement(self, IMAGE_SECTION_GSE);
+        GSEControlBlock* imageGcb = (GSEControlBlock*) (self->buffer + offset);
+
+        memcpy(imageGcb, gcb, sizeof(GSEControlBlock));
+
+        imageGcb->parent = IMAGE_OFFSET(LogicalNode, getLogicalNodeOffset(self, gcb->parent));
+        imageGcb->name = IMAGE_OFFSET(char, writeString(self, gcb->name));
+        imageGcb->appId = IMAGE_OFFSET(char, writeString(self, gcb->appId));
+        imageGcb->dataSetName = IMAGE_OFFSET(char, writeString(self, gcb->dataSetName));
+        imageGcb->address = IMAGE_OFFSET(PhyComAddress, writePhyComAddress(self, gcb->address));
+        imageGcb->sibling = NULL;
+
+        if (lastImageGcb)
+            lastImageGcb->sibling = IMAGE_OFFSET(GSEControlBlock, offset);
+        else
+            imageModel->gseCBs = IMAGE_OFFSET(GSEControlBlock, offset);
+
+        lastImageGcb = imageGcb;
+
+        gcb = gcb->sibling;
+    }
+
+    /* SVCBs */
+    SVControlBlock* svcb = model->svCBs;
+    SVControlBlock* lastImageSvcb = NULL;
+
+    while (svcb) {
+        uint32_t offset = allocateElement(self, IMAGE_SECTION_SV);
+        SVControlBlock* imageSvcb = (SVControlBlock*) (self->buffer + offset);
+
+        memcpy(imageSvcb, svcb, sizeof(SVControlBlock));
+
+        imageSvcb->parent = IMAGE_OFFSET(LogicalNode, getLogicalNodeOffset(self, svcb->parent));
+        imageSvcb->name = IMAGE_OFFSET(char, writeString(self, svcb->name));
+        imageSvcb->svId = IMAGE_OFFSET(char, writeString(self, svcb->svId));
+        imageSvcb->dataSetName = IMAGE_OFFSET(char, writeString(self, svcb->dataSetName));
+        imageSvcb->dstAddress = IMAGE_OFFSET(PhyComAddress, writePhyComAddress(self, svcb->dstAddress));
+        imageSvcb->sibling = NULL;
+
+        if (lastImageSvcb)
+            lastImageSvcb->sibling = IMAGE_OFFSET(SVControlBlock, offset);
+        else
+            imageModel->svCBs = IMAGE_OFFSET(SVControlBlock, offset);
+
+        lastImageSvcb = imageSvcb;
+
+        svcb = svcb->sibling;
+    }
+
+    /* SGCBs */
+    SettingGroupControlBlock* sgcb = model->sgcbs;
+    SettingGroupControlBlock* lastImageSgcb = NULL;
+
+    while (sgcb) {
+        uint32_t offset = allocateElement(self, IMAGE_SECTION_SGCB);
+        SettingGroupControlBlock* imageSgcb = (SettingGroupControlBlock*) (self->buffer + offset);
+
+        memcpy(imageSgcb, sgcb, sizeof(SettingGroupControlBlock));
+
+        imageSgcb->parent = IMAGE_OFFSET(LogicalNode, getLogicalNodeOffset(self, sgcb->parent));
+        imageSgcb->sibling = NULL;
+
+        if (lastImageSgcb)
+            lastImageSgcb->sibling = IMAGE_OFFSET(SettingGroupControlBlock, offset);
+        else
+            imageModel->sgcbs = IMAGE_OFFSET(SettingGroupControlBlock, offset);
+
+        lastImageSgcb = imageSgcb;
+
+        sgcb = sgcb->sibling;
+    }
+
+    /* LCBs */
+    LogControlBlock* lcb = model->lcbs;
+    LogControlBlock* lastImageLcb = NULL;
+
+    while (lcb) {
+        uint32_t offset = allocateElement(self, IMAGE_SECTION_LCB);
+        LogControlBlock* imageLcb = (LogControlBlock*) (self->buffer + offset);
+
+        memcpy(imageLcb, lcb, sizeof(LogControlBlock));
+
+        imageLcb->parent = IMAGE_OFFSET(LogicalNode, getLogicalNodeOffset(self, lcb->parent));
+        imageLcb->name = IMAGE_OFFSET(char, writeString(self, lcb->name));
+        imageLcb->dataSetName = IMAGE_OFFSET(char, writeString(self, lcb->dataSetName));
+        imageLcb->logRef = IMAGE_OFFSET(char, writeString(self, lcb->logRef));
+        imageLcb->sibling = NULL;
+
+        if (lastImageLcb)
+            lastImageLcb->sibling = IMAGE_OFFSET(LogControlBlock, offset);
+        else
+            imageModel->lcbs = IMAGE_OFFSET(LogControlBlock, offset);
+
+        lastImageLcb = imageLcb;
+
+        lcb = lcb->sibling;
+    }
+
+    /* logs */
+    Log* log = model->logs;
+    Log* lastImageLog = NULL;
+
+    while (log) {
+        uint32_t offset = allocateElement(self, IMAGE_SECTION_LOG);
+        Log* imageLog = (Log*) (self->buffer + offset);
+
+        imageLog->parent = IMAGE_OFFSET(LogicalNode, getLogicalNodeOffset(self, log->parent));
+        imageLog->name = IMAGE_OFFSET(char, writeString(self, log->name));
+
+        if (lastImageLog)
+            lastImageLog->sibling = IMAGE_OFFSET(Log, offset);
+        else
+            imageModel->logs = IMAGE_OFFSET(Log, offset);
+
+        lastImageLog = imageLog;
+
+        log = log->sibling;
+    }
+}
+
+bool
+IedModelImage_writeFile(IedModel* model, const char* filename)
+{
+    bool success = false;
+
+    ImageWriter writer;
+    memset(&writer, 0, sizeof(ImageWriter));
+
+    countModel(&writer, model);
+
+    /* section layout - the size of the string section is the upper limit without deduplication */
+    uint64_t offset = sizeof(ImageHeader);
+    int i;
+
+    for (i = 0; i < NUMBER_OF_IMAGE_SECTIONS; i++) {
+        offset = alignImageOffset((uint32_t) offset);
+
+        writer.writePos[i] = (uint32_t) offset;
+
+        offset += (uint64_t) writer.counts[i] * imageElementSizes[i];
+
+        if (offset > 0x7fffffff) {
+            if (DEBUG_IED_SERVER)
+                printf("IED_SERVER: data model too large for model image\n");
+
+            return false;
+        }
+    }
+
+    /* trailing 0 byte - guarantees that all strings in the image are terminated */
+    uint32_t bufferSize = (uint32_t) offset + 1;
+
+    writer.buffer = (uint8_t*) GLOBAL_CALLOC(1, bufferSize);
+
+    writer.stringTableSize = 16;
+
+    while (writer.stringTableSize < (writer.numberOfStrings * 2))
+        writer.stringTableSize *= 2;
+
+    writer.stringTable = (uint32_t*) GLOBAL_CALLOC(writer.stringTableSize, sizeof(uint32_t));
+
+    writer.lnOffsets = (LogicalNodeOffset*) GLOBAL_MALLOC((writer.counts[IMAGE_SECTION_LN] + 1) * sizeof(LogicalNodeOffset));
+
+    if ((writer.buffer == NULL) || (writer.stringTable == NULL) || (writer.lnOffsets == NULL))
+        goto exit_function;
+
+    writer.header = (ImageHeader*) writer.buffer;
+
+    for (i = 0; i < NUMBER_OF_IMAGE_SECTIONS; i++) {
+        writer.header->sections[i].offset = writer.writePos[i];
+        writer.header->sections[i].count = writer.counts[i];
+        writer.header->sections[i].elementSize = imageElementSizes[i];
+    }
+
+    writeModel(&writer, model);
+
+    /* strings are deduplicated - shrink the string section */
+    uint32_t stringsSize = writer.writePos[IMAGE_SECTION_STRINGS] - writer.header->sections[IMAGE_SECTION_STRINGS].offset + 1;
+
+    writer.header->sections[IMAGE_SECTION_STRINGS].count = stringsSize;
+
+    uint32_t imageSize = writer.header->sections[IMAGE_SECTION_STRINGS].offset + stringsSize;
+
+    memcpy(writer.header->magic, MODEL_IMAGE_MAGIC, 8);
+    writer.header->version = MODEL_IMAGE_VERSION;
+    writer.header->byteOrderMark = MODEL_IMAGE_BYTE_ORDER_MARK;
+    writer.header->pointerSize = sizeof(void*);
+    writer.header->numberOfSections = NUMBER_OF_IMAGE_SECTIONS;
+    writer.header->imageSize = imageSize;
+
+    FileHandle file = FileSystem_openFile((char*) filename, true);
+
+    if (file == NULL) {
+        if (DEBUG_IED_SERVER)
+            printf("IED_SERVER: failed to create model image file %s\n", filename);
+
+        goto exit_function;
+    }
+
+    if (FileSystem_writeFile(file, writer.buffer, imageSize) == (int) imageSize)
+        success = true;
+
+    FileSystem_closeFile(file);
+
+exit_function:
+    GLOBAL_FREEMEM(writer.lnOffsets);
+    GLOBAL_FREEMEM(writer.stringTable);
+    GLOBAL_FREEMEM(writer.buffer);
+
+    return success;
+}
+
+/*********************************************************************************
+ * Image loader
+ *********************************************************************************/
+
+typedef struct {
+    uint8_t* buffer;
+    ImageHeader* header;
+    bool valid;
+} ImageLoader;
+
+static void*
+getElement(ImageLoader* self, void* storedOffset, ImageSectionType sectionType)
+{
+    uintptr_t offset = (uintptr_t) storedOffset;
+
+    if (offset == 0)
+        return NULL;
+
+    ImageSection* section = &(self->header->sections[sectionType]);
+
+    uintptr_t sectionStart = section->offset;
+    uintptr_t sectionEnd = sectionStart + ((uintptr_t) section->count * section->elementSize);
+
+    if ((offset < sectionStart) || (offset >= sectionEnd) || (((offset - sectionStart) % section->elementSize) != 0)) {
+        self->valid = false;
+        return NULL;
+    }
+
+    return self->buffer + offset;
+}
+
+static char*
+getString(ImageLoader* self, char* storedOffset)
+{
+    return (char*) getElement(self, storedOffset, IMAGE_SECTION_STRINGS);
+}
+
+/* get a model node stored in one of the sections firstSection ... lastSection */
+static ModelNode*
+getModelNode(ImageLoader* self, ModelNode* storedOffset, ImageSectionType firstSection, ImageSectionType lastSection)
+{
+    if (storedOffset == NULL)
+        return NULL;
+
+    int sectionType;
+
+    for (sectionType = firstSection; sectionType <= (int) lastSection; sectionType++) {
+        ImageSection* section = &(self->header->sections[sectionType]);
+
+        uintptr_t offset = (uintptr_t) storedOffset;
+
+        if ((offset >= section->offset) && (offset < section->offset + ((uintptr_t) section->count * section->elementSize)))
+            return (ModelNode*) getElement(self, storedOffset, (ImageSectionType) sectionType);
+    }
+
+    self->valid = false;
+
+    return NULL;
+}
+
+static bool
+isImageHeaderValid(ImageHeader* header, uint32_t imageSize)
+{
+    if (imageSize < sizeof(ImageHeader))
+        return false;
+
+    if (memcmp(header->magic, MODEL_IMAGE_MAGIC, 8) != 0)
+        return false;
+
+    if ((header->version != MODEL_IMAGE_VERSION) || (header->byteOrderMark != MODEL_IMAGE_BYTE_ORDER_MARK) ||
+            (header->pointerSize != sizeof(void*)) || (header->numberOfSections != NUMBER_OF_IMAGE_SECTIONS))
+    {
+        if (DEBUG_IED_SERVER)
+            printf("IED_SERVER: model image was created for another platform or library version\n");
+
+        return false;
+    }
+
+    if (header->imageSize != imageSize)
+        return false;
+
+    int i;
+
+    for (i = 0; i < NUMBER_OF_IMAGE_SECTIONS; i++) {
+        ImageSection* section = &(header->sections[i]);
+
+        if (section->elementSize != imageElementSizes[i]) {
+            if (DEBUG_IED_SERVER)
+                printf("IED_SERVER: model image was created for another platform or library version\n");
+
+            return false;
+        }
+
+        if ((section->offset < sizeof(ImageHeader)) || ((section->offset % MODEL_IMAGE_ALIGNMENT) != 0))
+            return false;
+
+        if ((uint64_t) section->offset + ((uint64_t) section->count * section->elementSize) > imageSize)
+            return false;
+    }
+
+    if (header->sections[IMAGE_SECTION_MODEL].count != 1)
+        return false;
+
+    /* all strings have to be terminated inside of the string section */
+    ImageSection* strings = &(header->sections[IMAGE_SECTION_STRINGS]);
+
+    if ((strings->count == 0) || (((uint8_t*) header)[strings->offset + strings->count - 1] != 0))
+        return false;
+
+    return true;
+}
+
+static void
+relocateModelNodes(ImageLoader* self)
+{
+    ImageSection* sections = self->header->sections;
+    uint32_t i;
+
+    for (i = 0; i < sections[IMAGE_SECTION_LD].count; i++) {
+        LogicalDevice* ld = (LogicalDevice*) (self->buffer + sections[IMAGE_SECTION_LD].offset) + i;
+
+        if (ld->modelType != LogicalDeviceModelType)
+            self->valid = false;
+
+        ld->name = getString(self, ld->name);
+        ld->parent = (ModelNode*) getElement(self, ld->parent, IMAGE_SECTION_MODEL);
+        ld->sibling = getModelNode(self, ld->sibling, IMAGE_SECTION_LD, IMAGE_SECTION_LD);
+        ld->firstChild = getModelNode(self, ld->firstChild, IMAGE_SECTION_LN, IMAGE_SECTION_LN);
+    }
+
+    for (i = 0; i < sections[IMAGE_SECTION_LN].count; i++) {
+        LogicalNode* ln = (LogicalNode*) (self->buffer + sections[IMAGE_SECTION_LN].offset) + i;
+
+        if (ln->modelType != LogicalNodeModelType)
+            self->valid = false;
+
+        ln->name = getString(self, ln->name);
+        ln->parent = getModelNode(self, ln->parent, IMAGE_SECTION_LD, IMAGE_SECTION_LD);
+        ln->sibling = getModelNode(self, ln->sibling, IMAGE_SECTION_LN, IMAGE_SECTION_LN);
+        ln->firstChild = getModelNode(self, ln->firstChild, IMAGE_SECTION_DO, IMAGE_SECTION_DO);
+    }
+
+    for (i = 0; i < sections[IMAGE_SECTION_DO].count; i++) {
+        DataObject* dobj = (DataObject*) (self->buffer + sections[IMAGE_SECTION_DO].offset) + i;
+
+        if (dobj->modelType != DataObjectModelType)
+            self->valid = false;
+
+        dobj->name = getString(self, dobj->name);
+        dobj->parent = getModelNode(self, dobj->parent, IMAGE_SECTION_LN, IMAGE_SECTION_DO);
+        dobj->sibling = getModelNode(self, dobj->sibling, IMAGE_SECTION_DO, IMAGE_SECTION_DA);
+        dobj->firstChild = getModelNode(self, dobj->firstChild, IMAGE_SECTION_DO, IMAGE_SECTION_DA);
+    }
+
+    for (i = 0; i < sections[IMAGE_SECTION_DA].count; i++) {
+        DataAttribute* da = (DataAttribute*) (self->buffer + sections[IMAGE_SECTION_DA].offset) + i;
+
+        if (da->modelType != DataAttributeModelType)
+            self->valid = false;
+
+        da->name = getString(self, da->name);
+        da->parent = getModelNode(self, da->parent, IMAGE_SECTION_DO, IMAGE_SECTION_DA);
+        da->sibling = getModelNode(self, da->sibling, IMAGE_SECTION_DO, IMAGE_SECTION_DA);
+        da->firstChild = getModelNode(self, da->firstChild, IMAGE_SECTION_DA, IMAGE_SECTION_DA);
+    }
+}
+
+static void
+relocateModel(ImageLoader* self)
+{
+    ImageSection* sections = self->header->sections;
+    uint32_t i;
+
+    IedModel* model = (IedModel*) (self->buffer + sections[IMAGE_SECTION_MODEL].offset);
+
+    model->name = getString(self, model->name);
+    model->firstChild = (LogicalDevice*) getElement(self, model->firstChild, IMAGE_SECTION_LD);
+    model->dataSets = (DataSet*) getElement(self, model->dataSets, IMAGE_SECTION_DATA_SET);
+    model->rcbs = (ReportControlBlock*) getElement(self, model->rcbs, IMAGE_SECTION_RCB);
+    model->gseCBs = (GSEControlBlock*) getElement(self, model->gseCBs, IMAGE_SECTION_GSE);
+    model->svCBs = (SVControlBlock*) getElement(self, model->svCBs, IMAGE_SECTION_SV);
+    model->sgcbs = (SettingGroupControlBlock*) getElement(self, model->sgcbs, IMAGE_SECTION_SGCB);
+    model->lcbs = (LogControlBlock*) getElement(self, model->lcbs, IMAGE_SECTION_LCB);
+    model->logs = (Log*) getElement(self, model->logs, IMAGE_SECTION_LOG);
+    model->initializer = modelImage_emptyVariableInitializer;
+
+    relocateModelNodes(self);
+
+    for (i = 0; i < sections[IMAGE_SECTION_DATA_SET].count; i++) {
+        DataSet* dataSet = (DataSet*) (self->buffer + sections[IMAGE_SECTION_DATA_SET].offset) + i;
+
+        dataSet->logicalDeviceName = getString(self, dataSet->logicalDeviceName);
+        dataSet->name = getString(self, dataSet->name);
+        dataSet->fcdas = (DataSetEntry*) getElement(self, dataSet->fcdas, IMAGE_SECTION_DATA_SET_ENTRY);
+        dataSet->sibling = (DataSet*) getElement(self, dataSet->sibling, IMAGE_SECTION_DATA_SET);
+    }
+
+    for (i = 0; i < sections[IMAGE_SECTION_DATA_SET_ENTRY].count; i++) {
+        DataSetEntry* entry = (DataSetEntry*) (self->buffer + sections[IMAGE_SECTION_DATA_SET_ENTRY].offset) + i;
+
+        entry->logicalDeviceName = getString(self, entry->logicalDeviceName);
+        entry->isLDNameDynamicallyAllocated = false;
+        entry->variableName = getString(self, entry->variableName);
+        entry->componentName = getString(self, entry->componentName);
+        entry->value = NULL;
+        entry->sibling = (DataSetEntry*) getElement(self, entry->sibling, IMAGE_SECTION_DATA_SET_ENTRY);
+    }
+
+    for (i = 0; i < sections[IMAGE_SECTION_RCB].count; i++) {
+        ReportControlBlock* rcb = (ReportControlBlock*) (self->buffer + sections[IMAGE_SECTION_RCB].offset) + i;
+
+        rcb->parent = (LogicalNode*) getElement(self, rcb->parent, IMAGE_SECTION_LN);
+        rcb->name = getString(self, rcb->name);
+        rcb->rptId = getString(self, rcb->rptId);
+        rcb->dataSetName = getString(self, rcb->dataSetName);
+        rcb->sibling = (ReportControlBlock*) getElement(self, rcb->sibling, IMAGE_SECTION_RCB);
+    }
+
+    for (i = 0; i < sections[IMAGE_SECTION_GSE].count; i++) {
+        GSEControlBlock* gcb = (GSEControlBlock*) (self->buffer + sections[IMAGE_SECTION_GSE].offset) + i;
+
+        gcb->parent = (LogicalNode*) getElement(self, gcb->parent, IMAGE_SECTION_LN);
+        gcb->name = getString(self, gcb->name);
+        gcb->appId = getString(self, gcb->appId);
+        gcb->dataSetName = getString(self, gcb->dataSetName);
+        gcb->address = (PhyComAddress*) getElement(self, gcb->address, IMAGE_SECTION_PHY_COM_ADDRESS);
+        gcb->sibling = (GSEControlBlock*) getElement(self, gcb->sibling, IMAGE_SECTION_GSE);
+    }
+
+    for (i = 0; i < sections[IMAGE_SECTION_SV].count; i++) {
+        SVControlBlock* svcb = (SVControlBlock*) (self->buffer + sections[IMAGE_SECTION_SV].offset) + i;
+
+        svcb->parent = (LogicalNode*) getElement(self, svcb->parent, IMAGE_SECTION_LN);
+        svcb->name = getString(self, svcb->name);
+        svcb->svId = getString(self, svcb->svId);
+        svcb->dataSetName = getString(self, svcb->dataSetName);
+        svcb->dstAddress = (PhyComAddress*) getElement(self, svcb->dstAddress, IMAGE_SECTION_PHY_COM_ADDRESS);
+        svcb->sibling = (SVControlBlock*) getElement(self, svcb->sibling, IMAGE_SECTION_SV);
+    }
+
+    for (i = 0; i < sections[IMAGE_SECTION_SGCB].count; i++) {
+        SettingGroupControlBlock* sgcb = (SettingGroupControlBlock*) (self->buffer + sections[IMAGE_SECTION_SGCB].offset) + i;
+
+        sgcb->parent = (LogicalNode*) getElement(self, sgcb->parent, IMAGE_SECTION_LN);
+        sgcb->sibling = (SettingGroupControlBlock*) getElement(self, sgcb->sibling, IMAGE_SECTION_SGCB);
+    }
+
+    for (i = 0; i < sections[IMAGE_SECTION_LCB].count; i++) {
+        LogControlBlock* lcb = (LogControlBlock*) (self->buffer + sections[IMAGE_SECTION_LCB].offset) + i;
+
+        lcb->parent = (LogicalNode*) getElement(self, lcb->parent, IMAGE_SECTION_LN);
+        lcb->name = getString(self, lcb->name);
+        lcb->dataSetName = getString(self, lcb->dataSetName);
+        lcb->logRef = getString(self, lcb->logRef);
+        lcb->sibling = (LogControlBlock*) getElement(self, lcb->sibling, IMAGE_SECTION_LCB);
+    }
+
+    for (i = 0; i < sections[IMAGE_SECTION_LOG].count; i++) {
+        Log* log = (Log*) (self->buffer + sections[IMAGE_SECTION_LOG].offset) + i;
+
+        log->parent = (LogicalNode*) getElement(self, log->parent, IMAGE_SECTION_LN);
+        log->name = getString(self, log->name);
+        log->sibling = (Log*) getElement(self, log->sibling, IMAGE_SECTION_LOG);
+    }
+}
+
+static void
+deleteValues(IedModelImage self, uint32_t numberOfDataAttributes)
+{
+    ImageSection* section = &(((ImageHeader*) self->buffer)->sections[IMAGE_SECTION_DA]);
+
+    uint32_t i;
+
+    for (i = 0; i < numberOfDataAttributes; i++) {
+        DataAttribute* da = (DataAttribute*) (self->buffer + section->offset) + i;
+
+        if (da->mmsValue) {
+            MmsValue_delete(da->mmsValue);
+            da->mmsValue = NULL;
+        }
+    }
+}
+
+/* decode the initial values of the data attributes - has to be the last step of loading */
+static bool
+decodeValues(IedModelImage self)
+{
+    ImageHeader* header = (ImageHeader*) self->buffer;
+    ImageSection* section = &(header->sections[IMAGE_SECTION_DA]);
+    ImageSection* values = &(header->sections[IMAGE_SECTION_VALUES]);
+
+    uint32_t i;
+
+    for (i = 0; i < section->count; i++) {
+        DataAttribute* da = (DataAttribute*) (self->buffer + section->offset) + i;
+
+        uintptr_t valueOffset = (uintptr_t) da->mmsValue;
+
+        if (valueOffset != 0) {
+            if ((valueOffset < values->offset) || (valueOffset >= (uintptr_t) values->offset + values->count))
+                da->mmsValue = NULL;
+            else
+                da->mmsValue = MmsValue_decodeMmsData(self->buffer, (int) valueOffset, (int) (values->offset + values->count), NULL);
+
+            if (da->mmsValue == NULL) {
+                deleteValues(self, i);
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+IedModelImage
+IedModelImage_load(const char* filename)
+{
+    uint32_t fileSize;
+
+    if (FileSystem_getFileInfo((char*) filename, &fileSize, NULL) == false) {
+        if (DEBUG_IED_SERVER)
+            printf("IED_SERVER: model image file %s not found\n", filename);
+
+        return NULL;
+    }
+
+    if (fileSize < sizeof(ImageHeader))
+        return NULL;
+
+    FileHandle file = FileSystem_openFile((char*) filename, false);
+
+    if (file == NULL)
+        return NULL;
+
+    IedModelImage self = (IedModelImage) GLOBAL_CALLOC(1, sizeof(struct sIedModelImage));
+
+    if (self == NULL) {
+        FileSystem_closeFile(file);
+        return NULL;
+    }
+
+    self->size = fileSize;
+
+    /* the image is relocated in place - the mapping has to be private */
+    self->buffer = FileSystem_mapFileCopyOnWrite(file, fileSize);
+
+    if (self->buffer)
+        self->isMapped = true;
+    else {
+        self->buffer = (uint8_t*) GLOBAL_MALLOC(fileSize);
+
+        uint32_t bytesRead = 0;
+
+        if (self->buffer) {
+            while (bytesRead < fileSize) {
+                int readBytes = FileSystem_readFile(file, self->buffer + bytesRead, fileSize - bytesRead);
+
+                if (readBytes <= 0)
+                    break;
+
+                bytesRead += readBytes;
+            }
+        }
+
+        if (bytesRead != fileSize) {
+            FileSystem_closeFile(file);
+            IedModelImage_destroy(self);
+            return NULL;
+        }
+    }
+
+    FileSystem_closeFile(file);
+
+    ImageLoader loader;
+
+    loader.buffer = self->buffer;
+    loader.header = (ImageHeader*) self->buffer;
+    loader.valid = isImageHeaderValid(loader.header, fileSize);
+
+    if (loader.valid)
+        relocateModel(&loader);
+
+    if (loader.valid)
+        loader.valid = decodeValues(self);
+
+    if (loader.valid == false) {
+        if (DEBUG_IED_SERVER)
+            printf("IED_SERVER: invalid model image file %s\n", filename);
+
+        IedModelImage_destroy(self);
+        return NULL;
+    }
+
+    self->model = (IedModel*) (self->buffer + loader.header->sections[IMAGE_SECTION_MODEL].offset);
+
+    return self;
+}
+
+IedModel*
+IedModelImage_getModel(IedModelImage self)
+{
+    return self->model;
+}
+
+void
+IedModelImage_destroy(IedModelImage self)
+{
+    if (self) {
+        if (self->model)
+            deleteValues(self, ((ImageHeader*) self->buffer)->sections[IMAGE_SECTION_DA].count);
+
+        if (self->isMapped)
+            FileSystem_unmapFile(self->buffer, self->size);
+        else if (self->buffer)
+            GLOBAL_FREEMEM(self->buffer);
+
+        GLOBAL_FREEMEM(self);
+    }
+}
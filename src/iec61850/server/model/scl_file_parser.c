@@ -0,0 +1,2658 @@
+/*
+ *  scl_file_parser.c
+ *
+ *  Create data models directly from SCL files (ICD, CID, SCD, ...)
+ *
+ *  This file is part of libIEC61850.
+ *
+ *  libIEC61850 is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  libIEC61850 is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with libIEC61850.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+#include "iec61850_server.h"
+#include "iec61850_dynamic_model.h"
+#include "iec61850_config_file_parser.h"
+
+#include "libiec61850_platform_includes.h"
+#include "stack_config.h"
+
+/*
+ * The SCL file is mapped into memory (or read into a single buffer) and parsed by a minimal
+ * non-validating XML parser. The parser reports start tags and end tags to SCL specific
+ * handlers (SAX style). The handlers return the kind of the element. Elements of unknown kind
+ * are skipped including their content without calling the handlers.
+ *
+ * The file is parsed in two passes:
+ *
+ * 1. The DataTypeTemplates and Communication sections are parsed into the type cache. All other
+ *    sections (in particular all IED sections) are skipped. The position of the selected IED
+ *    section is recorded.
+ * 2. Only the selected IED section is parsed. The logical nodes are instantiated from the cached
+ *    LNodeType definitions as soon as the LN start tag is found. DOI/SDI/DAI elements only change
+ *    the values and short addresses of the already created data attributes.
+ *
+ * The data model is created with the dynamic model API and is equivalent to the model created by
+ * ConfigFileParser_createModelFromConfigFileEx from the output of the genconfig tool.
+ */
+
+#define SCL_MEMORY_BLOCK_SIZE (64 * 1024)
+#define SCL_MAX_ATTRIBUTES 32
+#define SCL_MAX_DEPTH 64
+#define SCL_MAX_VALUE_LENGTH 256
+#define SCL_TYPE_TABLE_INITIAL_SIZE 1024
+
+typedef enum {
+    SCL_TYPE_LNODE_TYPE,
+    SCL_TYPE_DO_TYPE,
+    SCL_TYPE_DA_TYPE,
+    SCL_TYPE_ENUM_TYPE
+} SclTypeKind;
+
+typedef enum {
+    SCL_ELEMENT_UNKNOWN = 0,
+    SCL_ELEMENT_NONE,
+    SCL_ELEMENT_OTHER,
+    SCL_ELEMENT_SCL,
+    SCL_ELEMENT_DATA_TYPE_TEMPLATES,
+    SCL_ELEMENT_LNODE_TYPE,
+    SCL_ELEMENT_DO_TYPE,
+    SCL_ELEMENT_DA_TYPE,
+    SCL_ELEMENT_ENUM_TYPE,
+    SCL_ELEMENT_DA,
+    SCL_ELEMENT_DA_VAL,
+    SCL_ELEMENT_ENUM_VAL,
+    SCL_ELEMENT_COMMUNICATION,
+    SCL_ELEMENT_SUB_NETWORK,
+    SCL_ELEMENT_CONNECTED_AP,
+    SCL_ELEMENT_GSE,
+    SCL_ELEMENT_ADDRESS,
+    SCL_ELEMENT_P,
+    SCL_ELEMENT_MIN_TIME,
+    SCL_ELEMENT_MAX_TIME,
+    SCL_ELEMENT_IED,
+    SCL_ELEMENT_SERVICES,
+    SCL_ELEMENT_ACCESS_POINT,
+    SCL_ELEMENT_SERVER,
+    SCL_ELEMENT_LDEVICE,
+    SCL_ELEMENT_LN,
+    SCL_ELEMENT_DOI,
+    SCL_ELEMENT_SDI,
+    SCL_ELEMENT_DAI,
+    SCL_ELEMENT_DAI_VAL,
+    SCL_ELEMENT_DATA_SET,
+    SCL_ELEMENT_REPORT_CONTROL,
+    SCL_ELEMENT_LOG_CONTROL,
+    SCL_ELEMENT_SAMPLED_VALUE_CONTROL
+} SclElementKind;
+
+typedef struct sSclMemoryBlock SclMemoryBlock;
+
+struct sSclMemoryBlock {
+    SclMemoryBlock* next;
+    int size;
+    int used;
+    /* the block data follows the header */
+};
+
+typedef struct sSclType SclType;
+typedef struct sSclDataObjectDefinition SclDataObjectDefinition;
+typedef struct sSclDataAttributeDefinition SclDataAttributeDefinition;
+typedef struct sSclEnumValue SclEnumValue;
+
+/* DO element of LNodeType or SDO element of DOType */
+struct sSclDataObjectDefinition {
+    const char* name;
+    const char* typeId;
+    SclType* type; /* resolved on first use */
+    int count;
+    bool isTransient;
+    SclDataObjectDefinition* next;
+};
+
+/* DA element of DOType or BDA element of DAType */
+struct sSclDataAttributeDefinition {
+    const char* name;
+    const char* typeId;
+    SclType* type; /* resolved on first use (DAType or EnumType) */
+    DataAttributeType attributeType;
+    int fc; /* -1 if not specified (BDA) */
+    int count;
+    uint8_t triggerOptions;
+    const char* value; /* content of the Val element or NULL */
+    SclDataAttributeDefinition* next;
+};
+
+struct sSclEnumValue {
+    int ord;
+    const char* name;
+    SclEnumValue* next;
+};
+
+struct sSclType {
+    SclTypeKind kind;
+    const char* id;
+    uint32_t hash;
+    SclDataObjectDefinition* dataObjects;
+    SclDataAttributeDefinition* dataAttributes;
+    SclEnumValue* enumValues;
+    SclType* nextInBucket;
+};
+
+typedef struct sSclCommAddress SclCommAddress;
+
+/* GSE or SMV element of a ConnectedAP */
+struct sSclCommAddress {
+    bool isSmv;
+    const char* ldInst;
+    const char* cbName;
+    int minTime;
+    int maxTime;
+    uint8_t vlanPriority;
+    uint16_t vlanId;
+    uint16_t appId;
+    uint8_t macAddress[6];
+    SclCommAddress* next;
+};
+
+typedef struct sSclConnectedAP SclConnectedAP;
+
+struct sSclConnectedAP {
+    const char* iedName;
+    const char* apName;
+    SclCommAddress* addresses;
+    SclConnectedAP* next;
+};
+
+typedef struct {
+    const char* name;
+    int nameLength;
+    const char* value;
+    int valueLength;
+} XmlAttribute;
+
+typedef struct {
+    const char* name;
+    int nameLength;
+    XmlAttribute attributes[SCL_MAX_ATTRIBUTES];
+    int attributeCount;
+} XmlElement;
+
+typedef struct sSclParser SclParser;
+
+typedef SclElementKind (*XmlStartElementHandler)(SclParser* self, XmlElement* element, SclElementKind parentKind);
+typedef void (*XmlEndElementHandler)(SclParser* self, SclElementKind kind);
+
+typedef struct {
+    char name[SCL_MAX_VALUE_LENGTH];
+    char rptId[SCL_MAX_VALUE_LENGTH];
+    char dataSet[SCL_MAX_VALUE_LENGTH];
+    bool hasRptId;
+    bool hasDataSet;
+    bool isBuffered;
+    bool isIndexed;
+    uint32_t confRev;
+    uint32_t bufTime;
+    uint32_t intgPd;
+    uint8_t trgOps;
+    uint8_t options;
+    int maxInstances;
+    bool logEna;
+    bool reasonCode;
+    uint8_t smpMod;
+    uint16_t smpRate;
+    int noASDU;
+    bool isUnicast;
+} SclControlBlock;
+
+struct sSclParser {
+    const char* buffer;
+    int size;
+    int tagPosition; /* position of the current tag (for error messages) */
+    bool error;
+
+    SclMemoryBlock* memory;
+
+    /* character data of the current element */
+    bool collectText;
+    char* text;
+    int textLength;
+    int textSize;
+
+    /* type cache */
+    SclType** types;
+    int typeTableSize;
+    int typeCount;
+
+    SclType* currentType;
+    SclDataObjectDefinition* lastDataObject;
+    SclDataAttributeDefinition* lastDataAttribute;
+    SclEnumValue* lastEnumValue;
+
+    /* communication section */
+    SclConnectedAP* connectedAPs;
+    SclConnectedAP* lastConnectedAP;
+    SclCommAddress* currentAddress;
+    char pType[SCL_MAX_VALUE_LENGTH];
+
+    /* IED selection */
+    const char* selectedIedName;
+    const char* selectedAccessPointName;
+    const char* iedName;
+    int iedPosition;
+
+    /* IED section */
+    IedModel* model;
+    bool hasOwner;
+    bool hasServer;
+    bool isServerAccessPoint;
+    const char* accessPointName;
+    SclConnectedAP* connectedAP;
+    LogicalDevice* currentLD;
+    LogicalNode* currentLN;
+    SclType* currentLnType;
+    DataSet* currentDataSet;
+    SclControlBlock controlBlock;
+
+    /* DOI/SDI elements and the corresponding DOType or DAType */
+    ModelNode* instanceNodes[SCL_MAX_DEPTH];
+    SclType* instanceTypes[SCL_MAX_DEPTH];
+    int instanceDepth;
+
+    DataAttribute* currentDataAttribute;
+    SclType* currentEnumType;
+    bool hasDaiValue;
+
+    SclElementKind elementKinds[SCL_MAX_DEPTH];
+};
+
+static void
+SclParser_error(SclParser* self, const char* message, const char* argument)
+{
+    if (DEBUG_IED_SERVER) {
+        int line = 1;
+        int i;
+
+        for (i = 0; i < self->tagPosition; i++) {
+            if (self->buffer[i] == '\n')
+                line++;
+        }
+
+        printf("IED_SERVER: SCL file (line %i): %s%s\n", line, message, argument ? argument : "");
+    }
+
+    self->error = true;
+}
+
+static void*
+SclParser_allocate(SclParser* self, int size)
+{
+    size = (size + 7) & ~7;
+
+    SclMemoryBlock* block = self->memory;
+
+    if ((block == NULL) || (block->used + size > block->size)) {
+        int blockSize = SCL_MEMORY_BLOCK_SIZE;
+
+        if (size > blockSize)
+            blockSize = size;
+
+        block = (SclMemoryBlock*) GLOBAL_MALLOC(sizeof(SclMemoryBlock) + blockSize);
+
+        if (block == NULL) {
+            SclParser_error(self, "out of memory", NULL);
+            return NULL;
+        }
+
+        block->size = blockSize;
+        block->used = 0;
+        block->next = self->memory;
+        self->memory = block;
+    }
+
+    uint8_t* memory = (uint8_t*) (block + 1) + block->used;
+
+    block->used += size;
+
+    memset(memory, 0, size);
+
+    return memory;
+}
+
+/*********************************************************************************************
+ * XML tokenizer
+ *********************************************************************************************/
+
+static inline bool
+isXmlSpace(char c)
+{
+    return ((c == ' ') || (c == '\t') || (c == '\r') || (c == '\n'));
+}
+
+static inline bool
+nameEquals(const char* name, int nameLength, const char* str)
+{
+    return ((strncmp(name, str, nameLength) == 0) && (str[nameLength] == 0));
+}
+
+static int
+encodeUtf8(char* dst, uint32_t codePoint)
+{
+    if (codePoint < 0x80) {
+        dst[0] = (char) codePoint;
+        return 1;
+    }
+    else if (codePoint < 0x800) {
+        dst[0] = (char) (0xc0 | (codePoint >> 6));
+        dst[1] = (char) (0x80 | (codePoint & 0x3f));
+        return 2;
+    }
+    else if (codePoint < 0x10000) {
+        dst[0] = (char) (0xe0 | (codePoint >> 12));
+        dst[1] = (char) (0x80 | ((codePoint >> 6) & 0x3f));
+        dst[2] = (char) (0x80 | (codePoint & 0x3f));
+        return 3;
+    }
+    else {
+        dst[0] = (char) (0xf0 | ((codePoint >> 18) & 0x07));
+        dst[1] = (char) (0x80 | ((codePoint >> 12) & 0x3f));
+        dst[2] = (char) (0x80 | ((codePoint >> 6) & 0x3f));
+        dst[3] = (char) (0x80 | (codePoint & 0x3f));
+        return 4;
+    }
+}
+
+static bool
+equalsIgnoreCase(const char* str1, const char* str2)
+{
+    while (*str1 && *str2) {
+        char c1 = ((*str1 >= 'A') && (*str1 <= 'Z')) ? (char) (*str1 + 32) : *str1;
+        char c2 = ((*str2 >= 'A') && (*str2 <= 'Z')) ? (char) (*str2 + 32) : *str2;
+
+        if (c1 != c2)
+            return false;
+
+        str1++;
+        str2++;
+    }
+
+    return (*str1 == *str2);
+}
+
+/* decode XML entities - the decoded text is never longer than the source text */
+static int
+decodeXmlText(char* dst, const char* src, int length)
+{
+    int dstPos = 0;
+    int i = 0;
+
+    while (i < length) {
+
+        if (src[i] == '&') {
+            const char* end = (const char*) memchr(src + i, ';', length - i);
+
+            if (end) {
+                const char* entity = src + i + 1;
+                int entityLength = (int) (end - entity);
+
+                char c = 0;
+
+                if (nameEquals(entity, entityLength, "lt"))
+                    c = '<';
+                else if (nameEquals(entity, entityLength, "gt"))
+                    c = '>';
+                else if (nameEquals(entity, entityLength, "amp"))
+                    c = '&';
+                else if (nameEquals(entity, entityLength, "quot"))
+                    c = '"';
+                else if (nameEquals(entity, entityLength, "apos"))
+                    c = '\'';
+                else if ((entityLength > 1) && (entity[0] == '#') && (entityLength < 10)) {
+                    char number[10];
+
+                    memcpy(number, entity + 1, entityLength - 1);
+                    number[entityLength - 1] = 0;
+
+                    char* numberEnd;
+                    unsigned long codePoint;
+
+                    if ((number[0] == 'x') || (number[0] == 'X'))
+                        codePoint = strtoul(number + 1, &numberEnd, 16);
+                    else
+                        codePoint = strtoul(number, &numberEnd, 10);
+
+                    if ((*numberEnd == 0) && (codePoint > 0) && (codePoint <= 0x10ffff)) {
+                        dstPos += encodeUtf8(dst + dstPos, (uint32_t) codePoint);
+                        i += entityLength + 2;
+                        continue;
+                    }
+                }
+
+                if (c) {
+                    dst[dstPos++] = c;
+                    i += entityLength + 2;
+                    continue;
+                }
+            }
+        }
+
+        dst[dstPos++] = src[i++];
+    }
+
+    dst[dstPos] = 0;
+
+    return dstPos;
+}
+
+static void
+SclParser_appendText(SclParser* self, const char* text, int length, bool decode)
+{
+    if (self->textLength + length + 1 > self->textSize) {
+        int newSize = self->textSize * 2;
+
+        if (newSize < self->textLength + length + 1)
+            newSize = self->textLength + length + 1;
+
+        char* newText = (char*) GLOBAL_REALLOC(self->text, newSize);
+
+        if (newText == NULL) {
+            SclParser_error(self, "out of memory", NULL);
+            return;
+        }
+
+        self->text = newText;
+        self->textSize = newSize;
+    }
+
+    if (decode)
+        self->textLength += decodeXmlText(self->text + self->textLength, text, length);
+    else {
+        memcpy(self->text + self->textLength, text, length);
+        self->textLength += length;
+        self->text[self->textLength] = 0;
+    }
+}
+
+static void
+SclParser_startText(SclParser* self)
+{
+    self->collectText = true;
+    self->textLength = 0;
+
+    if (self->text)
+        self->text[0] = 0;
+}
+
+static const char*
+SclParser_endText(SclParser* self)
+{
+    self->collectText = false;
+
+    if (self->text == NULL)
+        return "";
+
+    return self->text;
+}
+
+/* returns the position after the given pattern or -1 */
+static int
+skipAfter(SclParser* self, int pos, const char* pattern)
+{
+    int patternLength = (int) strlen(pattern);
+
+    while (pos + patternLength <= self->size) {
+        const char* match = (const char*) memchr(self->buffer + pos, pattern[0], self->size - pos);
+
+        if (match == NULL)
+            break;
+
+        pos = (int) (match - self->buffer);
+
+        if ((pos + patternLength <= self->size) && (memcmp(match, pattern, patternLength) == 0))
+            return pos + patternLength;
+
+        pos++;
+    }
+
+    return -1;
+}
+
+static inline bool
+startsWithAt(SclParser* self, int pos, const char* str)
+{
+    int length = (int) strlen(str);
+
+    return ((pos + length <= self->size) && (memcmp(self->buffer + pos, str, length) == 0));
+}
+
+/* skip comments, processing instructions, CDATA sections, and DOCTYPE declarations */
+static int
+skipMarkup(SclParser* self, int pos)
+{
+    if (startsWithAt(self, pos, "<!--"))
+        return skipAfter(self, pos + 4, "-->");
+    else if (startsWithAt(self, pos, "<![CDATA["))
+        return skipAfter(self, pos + 9, "]]>");
+    else if (startsWithAt(self, pos, "<?"))
+        return skipAfter(self, pos + 2, "?>");
+
+    /* DOCTYPE (may contain an internal subset in brackets) */
+    while (pos < self->size) {
+        char c = self->buffer[pos];
+
+        if (c == '>')
+            return pos + 1;
+
+        if (c == '[') {
+            pos = skipAfter(self, pos, "]");
+
+            if (pos == -1)
+                return -1;
+
+            continue;
+        }
+
+        pos++;
+    }
+
+    return -1;
+}
+
+/* returns the position after the tag end ('>') or -1. Quoted attribute values may contain '>' */
+static int
+findTagEnd(SclParser* self, int pos, bool* isEmpty)
+{
+    const char* buf = self->buffer;
+
+    while (pos < self->size) {
+        char c = buf[pos];
+
+        if (c == '>') {
+            *isEmpty = (buf[pos - 1] == '/');
+            return pos + 1;
+        }
+
+        if ((c == '"') || (c == '\'')) {
+            const char* quoteEnd = (const char*) memchr(buf + pos + 1, c, self->size - pos - 1);
+
+            if (quoteEnd == NULL)
+                return -1;
+
+            pos = (int) (quoteEnd - buf);
+        }
+
+        pos++;
+    }
+
+    return -1;
+}
+
+/* skip the content and the end tag of an element. Returns the position after the end tag or -1 */
+static int
+skipElementContent(SclParser* self, int pos)
+{
+    const char* buf = self->buffer;
+    int depth = 1;
+
+    while (pos < self->size) {
+        const char* tagStart = (const char*) memchr(buf + pos, '<', self->size - pos);
+
+        if (tagStart == NULL)
+            return -1;
+
+        pos = (int) (tagStart - buf);
+
+        if (pos + 1 >= self->size)
+            return -1;
+
+        char c = buf[pos + 1];
+
+        if (c == '/') {
+            const char* tagEnd = (const char*) memchr(buf + pos, '>', self->size - pos);
+
+            if (tagEnd == NULL)
+                return -1;
+
+            pos = (int) (tagEnd - buf) + 1;
+
+            depth--;
+
+            if (depth == 0)
+                return pos;
+        }
+        else if ((c == '!') || (c == '?')) {
+            pos = skipMarkup(self, pos);
+
+            if (pos == -1)
+                return -1;
+        }
+        else {
+            bool isEmpty;
+
+            pos = findTagEnd(self, pos + 1, &isEmpty);
+
+            if (pos == -1)
+                return -1;
+
+            if (isEmpty == false)
+                depth++;
+        }
+    }
+
+    return -1;
+}
+
+/* parse a start tag. Returns the position after the tag end or -1 */
+static int
+parseStartTag(SclParser* self, int pos, XmlElement* element, bool* isEmpty)
+{
+    const char* buf = self->buffer;
+    int size = self->size;
+
+    pos++;
+
+    int nameStart = pos;
+
+    while ((pos < size) && !isXmlSpace(buf[pos]) && (buf[pos] != '>') && (buf[pos] != '/'))
+        pos++;
+
+    element->name = buf + nameStart;
+    element->nameLength = pos - nameStart;
+    element->attributeCount = 0;
+
+    while (pos < size) {
+        char c = buf[pos];
+
+        if (isXmlSpace(c)) {
+            pos++;
+            continue;
+        }
+
+        if (c == '>') {
+            *isEmpty = false;
+            return pos + 1;
+        }
+
+        if (c == '/') {
+            if ((pos + 1 < size) && (buf[pos + 1] == '>')) {
+                *isEmpty = true;
+                return pos + 2;
+            }
+
+            return -1;
+        }
+
+        int attributeNameStart = pos;
+
+        while ((pos < size) && !isXmlSpace(buf[pos]) && (buf[pos] != '=') && (buf[pos] != '>') && (buf[pos] != '/'))
+            pos++;
+
+        int attributeNameLength = pos - attributeNameStart;
+
+        while ((pos < size) && isXmlSpace(buf[pos]))
+            pos++;
+
+        if ((pos >= size) || (buf[pos] != '=') || (attributeNameLength == 0))
+            return -1;
+
+        pos++;
+
+        while ((pos < size) && isXmlSpace(buf[pos]))
+            pos++;
+
+        if ((pos >= size) || ((buf[pos] != '"') && (buf[pos] != '\'')))
+            return -1;
+
+        char quote = buf[pos++];
+
+        const char* valueEnd = (const char*) memchr(buf + pos, quote, size - pos);
+
+        if (valueEnd == NULL)
+            return -1;
+
+        if (element->attributeCount < SCL_MAX_ATTRIBUTES) {
+            XmlAttribute* attribute = &(element->attributes[element->attributeCount++]);
+
+            attribute->name = buf + attributeNameStart;
+            attribute->nameLength = attributeNameLength;
+            attribute->value = buf + pos;
+            attribute->valueLength = (int) (valueEnd - (buf + pos));
+        }
+
+        pos = (int) (valueEnd - buf) + 1;
+    }
+
+    return -1;
+}
+
+/**
+ * Parse the element starting at the given position (including all child elements). Parsing
+ * stops after the end tag of the element.
+ */
+static bool
+SclParser_parse(SclParser* self, int pos, XmlStartElementHandler startHandler, XmlEndElementHandler endHandler)
+{
+    const char* buf = self->buffer;
+    int depth = 0;
+    XmlElement element;
+
+    while ((pos < self->size) && (self->error == false)) {
+
+        if (buf[pos] != '<') {
+            const char* tagStart = (const char*) memchr(buf + pos, '<', self->size - pos);
+
+            int end = tagStart ? (int) (tagStart - buf) : self->size;
+
+            if (self->collectText)
+                SclParser_appendText(self, buf + pos, end - pos, true);
+
+            pos = end;
+
+            continue;
+        }
+
+        self->tagPosition = pos;
+
+        if (pos + 1 >= self->size)
+            break;
+
+        char c = buf[pos + 1];
+
+        if ((c == '!') || (c == '?')) {
+            if (self->collectText && startsWithAt(self, pos, "<![CDATA[")) {
+                int end = skipAfter(self, pos + 9, "]]>");
+
+                if (end != -1)
+                    SclParser_appendText(self, buf + pos + 9, end - pos - 12, false);
+
+                pos = end;
+            }
+            else
+                pos = skipMarkup(self, pos);
+        }
+        else if (c == '/') {
+            const char* tagEnd = (const char*) memchr(buf + pos, '>', self->size - pos);
+
+            if ((tagEnd == NULL) || (depth == 0))
+                break;
+
+            depth--;
+
+            endHandler(self, self->elementKinds[depth]);
+
+            pos = (int) (tagEnd - buf) + 1;
+
+            if (depth == 0)
+                return (self->error == false);
+        }
+        else {
+            bool isEmpty;
+
+            pos = parseStartTag(self, pos, &element, &isEmpty);
+
+            if (pos == -1)
+                break;
+
+            SclElementKind parentKind = (depth > 0) ? self->elementKinds[depth - 1] : SCL_ELEMENT_NONE;
+
+            SclElementKind kind = startHandler(self, &element, parentKind);
+
+            if (self->error)
+                break;
+
+            if (kind == SCL_ELEMENT_UNKNOWN) {
+                if (isEmpty == false)
+                    pos = skipElementContent(self, pos);
+            }
+            else if (isEmpty)
+                endHandler(self, kind);
+            else {
+                if (depth == SCL_MAX_DEPTH) {
+                    SclParser_error(self, "elements nested too deep", NULL);
+                    break;
+                }
+
+                self->elementKinds[depth++] = kind;
+                continue;
+            }
+
+            if ((pos != -1) && (depth == 0))
+                return (self->error == false);
+        }
+
+        if (pos == -1)
+            break;
+    }
+
+    if (self->error == false)
+        SclParser_error(self, "malformed XML", NULL);
+
+    return false;
+}
+
+/*********************************************************************************************
+ * Attribute helpers
+ *********************************************************************************************/
+
+static XmlAttribute*
+XmlElement_getAttribute(XmlElement* self, const char* name)
+{
+    int i;
+
+    for (i = 0; i < self->attributeCount; i++) {
+        if (nameEquals(self->attributes[i].name, self->attributes[i].nameLength, name))
+            return &(self->attributes[i]);
+    }
+
+    return NULL;
+}
+
+/* copy the decoded attribute value to the buffer. Returns NULL if the attribute is not present */
+static char*
+XmlElement_getAttributeValue(XmlElement* self, const char* name, char* buffer)
+{
+    XmlAttribute* attribute = XmlElement_getAttribute(self, name);
+
+    if (attribute == NULL)
+        return NULL;
+
+    int length = attribute->valueLength;
+
+    if (length > SCL_MAX_VALUE_LENGTH - 1)
+        length = SCL_MAX_VALUE_LENGTH - 1;
+
+    decodeXmlText(buffer, attribute->value, length);
+
+    return buffer;
+}
+
+static bool
+XmlElement_getBoolAttribute(XmlElement* self, const char* name, bool defaultValue)
+{
+    char buffer[SCL_MAX_VALUE_LENGTH];
+
+    char* value = XmlElement_getAttributeValue(self, name, buffer);
+
+    if (value) {
+        if ((equalsIgnoreCase(value, "true")) || (strcmp(value, "1") == 0))
+            return true;
+        else if ((equalsIgnoreCase(value, "false")) || (strcmp(value, "0") == 0))
+            return false;
+    }
+
+    return defaultValue;
+}
+
+static long
+XmlElement_getIntAttribute(XmlElement* self, const char* name, long defaultValue)
+{
+    char buffer[SCL_MAX_VALUE_LENGTH];
+
+    char* value = XmlElement_getAttributeValue(self, name, buffer);
+
+    if (value) {
+        char* end;
+
+        long intValue = strtol(value, &end, 0);
+
+        if ((end != value) && (*end == 0))
+            return intValue;
+    }
+
+    return defaultValue;
+}
+
+/* copy the decoded attribute value to the parser memory. Returns NULL if the attribute is not present */
+static const char*
+SclParser_copyAttributeValue(SclParser* self, XmlElement* element, const char* name)
+{
+    XmlAttribute* attribute = XmlElement_getAttribute(element, name);
+
+    if (attribute == NULL)
+        return NULL;
+
+    char* value = (char*) SclParser_allocate(self, attribute->valueLength + 1);
+
+    if (value)
+        decodeXmlText(value, attribute->value, attribute->valueLength);
+
+    return value;
+}
+
+static const char*
+SclParser_copyString(SclParser* self, const char* str)
+{
+    int length = (int) strlen(str);
+
+    char* copy = (char*) SclParser_allocate(self, length + 1);
+
+    if (copy)
+        memcpy(copy, str, length + 1);
+
+    return copy;
+}
+
+static char*
+trimString(char* str)
+{
+    while (isXmlSpace(*str))
+        str++;
+
+    int length = (int) strlen(str);
+
+    while ((length > 0) && isXmlSpace(str[length - 1]))
+        str[--length] = 0;
+
+    return str;
+}
+
+/*********************************************************************************************
+ * Type cache
+ *********************************************************************************************/
+
+static uint32_t
+getTypeHash(SclTypeKind kind, const char* id)
+{
+    uint32_t hash = 2166136261u ^ (uint32_t) kind;
+
+    while (*id) {
+        hash ^= (uint8_t) *id++;
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+static SclType*
+SclParser_lookupType(SclParser* self, SclTypeKind kind, const char* id)
+{
+    if ((id == NULL) || (self->types == NULL))
+        return NULL;
+
+    uint32_t hash = getTypeHash(kind, id);
+
+    SclType* type = self->types[hash & (self->typeTableSize - 1)];
+
+    while (type) {
+        if ((type->hash == hash) && (type->kind == kind) && (strcmp(type->id, id) == 0))
+            return type;
+
+        type = type->nextInBucket;
+    }
+
+    return NULL;
+}
+
+static void
+SclParser_resizeTypeTable(SclParser* self)
+{
+    int newSize = (self->typeTableSize == 0) ? SCL_TYPE_TABLE_INITIAL_SIZE : self->typeTableSize * 2;
+
+    SclType** newTable = (SclType**) GLOBAL_CALLOC(newSize, sizeof(SclType*));
+
+    if (newTable == NULL)
+        return;
+
+    int i;
+
+    for (i = 0; i < self->typeTableSize; i++) {
+        SclType* type = self->types[i];
+
+        while (type) {
+            SclType* next = type->nextInBucket;
+
+            type->nextInBucket = newTable[type->hash & (newSize - 1)];
+            newTable[type->hash & (newSize - 1)] = type;
+
+            type = next;
+        }
+    }
+
+    if (self->types)
+        GLOBAL_FREEMEM(self->types);
+
+    self->types = newTable;
+    self->typeTableSize = newSize;
+}
+
+static SclType*
+SclParser_addType(SclParser* self, SclTypeKind kind, XmlElement* element)
+{
+    const char* id = SclParser_copyAttributeValue(self, element, "id");
+
+    if (id == NULL) {
+        SclParser_error(self, "type definition without id", NULL);
+        return NULL;
+    }
+
+    SclType* type = (SclType*) SclParser_allocate(self, sizeof(SclType));
+
+    if (type == NULL)
+        return NULL;
+
+    type->kind = kind;
+    type->id = id;
+    type->hash = getTypeHash(kind, id);
+
+    /* the first definition of a type id is used */
+    if (SclParser_lookupType(self, kind, id) == NULL) {
+
+        if (self->typeCount >= self->typeTableSize / 2)
+            SclParser_resizeTypeTable(self);
+
+        if (self->types == NULL) {
+            SclParser_error(self, "out of memory", NULL);
+            return NULL;
+        }
+
+        int bucket = type->hash & (self->typeTableSize - 1);
+
+        type->nextInBucket = self->types[bucket];
+        self->types[bucket] = type;
+        self->typeCount++;
+    }
+    else if (DEBUG_IED_SERVER)
+        printf("IED_SERVER: SCL file: duplicate type definition %s ignored\n", id);
+
+    self->lastDataObject = NULL;
+    self->lastDataAttribute = NULL;
+    self->lastEnumValue = NULL;
+
+    return type;
+}
+
+static SclType*
+SclParser_resolveType(SclParser* self, SclType** cachedType, SclTypeKind kind, const char* id)
+{
+    if (*cachedType == NULL) {
+        *cachedType = SclParser_lookupType(self, kind, id);
+
+        if (*cachedType == NULL)
+            SclParser_error(self, "missing type definition ", id ? id : "");
+    }
+
+    return *cachedType;
+}
+
+static DataAttributeType
+getAttributeTypeFromBType(const char* bType)
+{
+    static const struct {
+        const char* name;
+        DataAttributeType type;
+    } bTypes[] = {
+        {"BOOLEAN", IEC61850_BOOLEAN},
+        {"INT8", IEC61850_INT8},
+        {"INT16", IEC61850_INT16},
+        {"INT32", IEC61850_INT32},
+        {"INT64", IEC61850_INT64},
+        {"INT128", IEC61850_INT128},
+        {"INT8U", IEC61850_INT8U},
+        {"INT16U", IEC61850_INT16U},
+        {"INT24U", IEC61850_INT24U},
+        {"INT32U", IEC61850_INT32U},
+        {"FLOAT32", IEC61850_FLOAT32},
+        {"FLOAT64", IEC61850_FLOAT64},
+        {"Enum", IEC61850_ENUMERATED},
+        {"Dbpos", IEC61850_CODEDENUM},
+        {"Check", IEC61850_CHECK},
+        {"Tcmd", IEC61850_CODEDENUM},
+        {"Octet64", IEC61850_OCTET_STRING_64},
+        {"Quality", IEC61850_QUALITY},
+        {"Timestamp", IEC61850_TIMESTAMP},
+        {"Currency", IEC61850_CURRENCY},
+        {"VisString32", IEC61850_VISIBLE_STRING_32},
+        {"VisString64", IEC61850_VISIBLE_STRING_64},
+        {"VisString65", IEC61850_VISIBLE_STRING_65},
+        {"VisString129", IEC61850_VISIBLE_STRING_129},
+        {"ObjRef", IEC61850_VISIBLE_STRING_129},
+        {"VisString255", IEC61850_VISIBLE_STRING_255},
+        {"Unicode255", IEC61850_UNICODE_STRING_255},
+        {"OptFlds", IEC61850_OPTFLDS},
+        {"TrgOps", IEC61850_TRGOPS},
+        {"EntryID", IEC61850_OCTET_STRING_8},
+        {"EntryTime", IEC61850_ENTRY_TIME},
+        {"PhyComAddr", IEC61850_PHYCOMADDR},
+        {"Struct", IEC61850_CONSTRUCTED}
+    };
+
+    unsigned int i;
+
+    for (i = 0; i < sizeof(bTypes) / sizeof(bTypes[0]); i++) {
+        if (strcmp(bTypes[i].name, bType) == 0)
+            return bTypes[i].type;
+    }
+
+    return IEC61850_UNKNOWN_TYPE;
+}
+
+static void
+SclParser_addDataObjectDefinition(SclParser* self, XmlElement* element)
+{
+    SclDataObjectDefinition* definition =
+            (SclDataObjectDefinition*) SclParser_allocate(self, sizeof(SclDataObjectDefinition));
+
+    if (definition == NULL)
+        return;
+
+    definition->name = SclParser_copyAttributeValue(self, element, "name");
+    definition->typeId = SclParser_copyAttributeValue(self, element, "type");
+    definition->count = (int) XmlElement_getIntAttribute(element, "count", 0);
+    definition->isTransient = XmlElement_getBoolAttribute(element, "transient", false);
+
+    if ((definition->name == NULL) || (definition->typeId == NULL)) {
+        SclParser_error(self, "data object definition without name or type", NULL);
+        return;
+    }
+
+    if (self->lastDataObject)
+        self->lastDataObject->next = definition;
+    else
+        self->currentType->dataObjects = definition;
+
+    self->lastDataObject = definition;
+}
+
+static void
+SclParser_addDataAttributeDefinition(SclParser* self, XmlElement* element)
+{
+    SclDataAttributeDefinition* definition =
+            (SclDataAttributeDefinition*) SclParser_allocate(self, sizeof(SclDataAttributeDefinition));
+
+    if (definition == NULL)
+        return;
+
+    char buffer[SCL_MAX_VALUE_LENGTH];
+
+    definition->name = SclParser_copyAttributeValue(self, element, "name");
+    definition->typeId = SclParser_copyAttributeValue(self, element, "type");
+    definition->count = (int) XmlElement_getIntAttribute(element, "count", 0);
+
+    if (definition->name == NULL) {
+        SclParser_error(self, "data attribute definition without name", NULL);
+        return;
+    }
+
+    if (XmlElement_getAttributeValue(element, "bType", buffer) == NULL) {
+        SclParser_error(self, "missing bType for data attribute ", definition->name);
+        return;
+    }
+
+    definition->attributeType = getAttributeTypeFromBType(buffer);
+
+    if (definition->attributeType == IEC61850_UNKNOWN_TYPE) {
+        SclParser_error(self, "unsupported attribute type ", buffer);
+        return;
+    }
+
+    if (XmlElement_getAttributeValue(element, "fc", buffer)) {
+        definition->fc = FunctionalConstraint_fromString(buffer);
+
+        if (definition->fc == IEC61850_FC_NONE) {
+            SclParser_error(self, "unknown functional constraint ", buffer);
+            return;
+        }
+    }
+    else
+        definition->fc = -1;
+
+    if (XmlElement_getBoolAttribute(element, "dchg", false))
+        definition->triggerOptions |= TRG_OPT_DATA_CHANGED;
+
+    if (XmlElement_getBoolAttribute(element, "qchg", false))
+        definition->triggerOptions |= TRG_OPT_QUALITY_CHANGED;
+
+    if (XmlElement_getBoolAttribute(element, "dupd", false))
+        definition->triggerOptions |= TRG_OPT_DATA_UPDATE;
+
+    if (self->lastDataAttribute)
+        self->lastDataAttribute->next = definition;
+    else
+        self->currentType->dataAttributes = definition;
+
+    self->lastDataAttribute = definition;
+}
+
+static void
+SclParser_addEnumValue(SclParser* self, XmlElement* element)
+{
+    SclEnumValue* enumValue = (SclEnumValue*) SclParser_allocate(self, sizeof(SclEnumValue));
+
+    if (enumValue == NULL)
+        return;
+
+    enumValue->ord = (int) XmlElement_getIntAttribute(element, "ord", 0);
+
+    if (self->lastEnumValue)
+        self->lastEnumValue->next = enumValue;
+    else
+        self->currentType->enumValues = enumValue;
+
+    self->lastEnumValue = enumValue;
+}
+
+/*********************************************************************************************
+ * Communication section
+ *********************************************************************************************/
+
+static void
+SclParser_addConnectedAP(SclParser* self, XmlElement* element)
+{
+    SclConnectedAP* connectedAP = (SclConnectedAP*) SclParser_allocate(self, sizeof(SclConnectedAP));
+
+    if (connectedAP == NULL)
+        return;
+
+    connectedAP->iedName = SclParser_copyAttributeValue(self, element, "iedName");
+    connectedAP->apName = SclParser_copyAttributeValue(self, element, "apName");
+
+    if (self->lastConnectedAP)
+        self->lastConnectedAP->next = connectedAP;
+    else
+        self->connectedAPs = connectedAP;
+
+    self->lastConnectedAP = connectedAP;
+}
+
+static void
+SclParser_addCommAddress(SclParser* self, XmlElement* element, bool isSmv)
+{
+    SclCommAddress* address = (SclCommAddress*) SclParser_allocate(self, sizeof(SclCommAddress));
+
+    if (address == NULL)
+        return;
+
+    address->isSmv = isSmv;
+    address->ldInst = SclParser_copyAttributeValue(self, element, "ldInst");
+    address->cbName = SclParser_copyAttributeValue(self, element, "cbName");
+    address->minTime = -1;
+    address->maxTime = -1;
+    address->vlanPriority = 4;
+
+    /* default MAC address: 01-0C-CD-01-00-00 */
+    address->macAddress[0] = 0x01;
+    address->macAddress[1] = 0x0c;
+    address->macAddress[2] = 0xcd;
+    address->macAddress[3] = 0x01;
+
+    if ((address->ldInst == NULL) || (address->cbName == NULL)) {
+        SclParser_error(self, "GSE or SMV is missing required attribute", NULL);
+        return;
+    }
+
+    address->next = self->lastConnectedAP->addresses;
+    self->lastConnectedAP->addresses = address;
+
+    self->currentAddress = address;
+}
+
+static void
+SclParser_setAddressParameter(SclParser* self, const char* type, char* value)
+{
+    SclCommAddress* address = self->currentAddress;
+
+    value = trimString(value);
+
+    if (strcmp(type, "VLAN-ID") == 0)
+        address->vlanId = (uint16_t) strtoul(value, NULL, 16);
+    else if (strcmp(type, "VLAN-PRIORITY") == 0)
+        address->vlanPriority = (uint8_t) strtoul(value, NULL, 10);
+    else if (strcmp(type, "APPID") == 0)
+        address->appId = (uint16_t) strtoul(value, NULL, 16);
+    else if (strcmp(type, "MAC-Address") == 0) {
+        unsigned int mac[6];
+
+        if (sscanf(value, "%x-%x-%x-%x-%x-%x", &mac[0], &mac[1], &mac[2], &mac[3], &mac[4], &mac[5]) == 6) {
+            int i;
+
+            for (i = 0; i < 6; i++)
+                address->macAddress[i] = (uint8_t) mac[i];
+        }
+        else
+            SclParser_error(self, "malformed MAC address ", value);
+    }
+}
+
+static SclCommAddress*
+lookupCommAddress(SclConnectedAP* connectedAP, const char* ldInst, const char* cbName, bool isSmv)
+{
+    SclCommAddress* address = connectedAP->addresses;
+
+    while (address) {
+        if ((address->isSmv == isSmv) && (strcmp(address->ldInst, ldInst) == 0) && (strcmp(address->cbName, cbName) == 0))
+            return address;
+
+        address = address->next;
+    }
+
+    return NULL;
+}
+
+static SclCommAddress*
+SclParser_lookupCommAddress(SclParser* self, const char* cbName, bool isSmv)
+{
+    if (self->connectedAP == NULL)
+        return NULL;
+
+    SclCommAddress* address = lookupCommAddress(self->connectedAP, self->currentLD->name, cbName, isSmv);
+
+    if (address == NULL) {
+        SclConnectedAP* connectedAP = self->connectedAPs;
+
+        while (connectedAP && (address == NULL)) {
+            address = lookupCommAddress(connectedAP, self->currentLD->name, cbName, isSmv);
+
+            connectedAP = connectedAP->next;
+        }
+    }
+
+    return address;
+}
+
+static PhyComAddress*
+createPhyComAddress(SclCommAddress* address)
+{
+    return PhyComAddress_create(address->vlanPriority, address->vlanId, address->appId, address->macAddress);
+}
+
+/*********************************************************************************************
+ * Pass 1: DataTypeTemplates and Communication sections
+ *********************************************************************************************/
+
+static SclElementKind
+handleTypeElementStart(SclParser* self, XmlElement* element, SclElementKind parentKind)
+{
+    const char* name = element->name;
+    int nameLength = element->nameLength;
+
+    switch (parentKind) {
+
+    case SCL_ELEMENT_NONE:
+        if (nameEquals(name, nameLength, "SCL"))
+            return SCL_ELEMENT_SCL;
+        break;
+
+    case SCL_ELEMENT_SCL:
+        if (nameEquals(name, nameLength, "DataTypeTemplates"))
+            return SCL_ELEMENT_DATA_TYPE_TEMPLATES;
+        else if (nameEquals(name, nameLength, "Communication"))
+            return SCL_ELEMENT_COMMUNICATION;
+        else if (nameEquals(name, nameLength, "IED") && (self->iedPosition == -1)) {
+            const char* iedName = SclParser_copyAttributeValue(self, element, "name");
+
+            if (iedName && ((self->selectedIedName == NULL) || (strcmp(iedName, self->selectedIedName) == 0))) {
+                self->iedName = iedName;
+                self->iedPosition = self->tagPosition;
+            }
+        }
+        break;
+
+    case SCL_ELEMENT_DATA_TYPE_TEMPLATES:
+        if (nameEquals(name, nameLength, "LNodeType")) {
+            self->currentType = SclParser_addType(self, SCL_TYPE_LNODE_TYPE, element);
+            return SCL_ELEMENT_LNODE_TYPE;
+        }
+        else if (nameEquals(name, nameLength, "DOType")) {
+            self->currentType = SclParser_addType(self, SCL_TYPE_DO_TYPE, element);
+            return SCL_ELEMENT_DO_TYPE;
+        }
+        else if (nameEquals(name, nameLength, "DAType")) {
+            self->currentType = SclParser_addType(self, SCL_TYPE_DA_TYPE, element);
+            return SCL_ELEMENT_DA_TYPE;
+        }
+        else if (nameEquals(name, nameLength, "EnumType")) {
+            self->currentType = SclParser_addType(self, SCL_TYPE_ENUM_TYPE, element);
+            return SCL_ELEMENT_ENUM_TYPE;
+        }
+        break;
+
+    case SCL_ELEMENT_LNODE_TYPE:
+        if (nameEquals(name, nameLength, "DO")) {
+            SclParser_addDataObjectDefinition(self, element);
+            return SCL_ELEMENT_OTHER;
+        }
+        break;
+
+    case SCL_ELEMENT_DO_TYPE:
+        if (nameEquals(name, nameLength, "SDO")) {
+            SclParser_addDataObjectDefinition(self, element);
+            return SCL_ELEMENT_OTHER;
+        }
+        else if (nameEquals(name, nameLength, "DA")) {
+            SclParser_addDataAttributeDefinition(self, element);
+            return SCL_ELEMENT_DA;
+        }
+        break;
+
+    case SCL_ELEMENT_DA_TYPE:
+        if (nameEquals(name, nameLength, "BDA")) {
+            SclParser_addDataAttributeDefinition(self, element);
+            return SCL_ELEMENT_DA;
+        }
+        break;
+
+    case SCL_ELEMENT_ENUM_TYPE:
+        if (nameEquals(name, nameLength, "EnumVal")) {
+            SclParser_addEnumValue(self, element);
+            SclParser_startText(self);
+            return SCL_ELEMENT_ENUM_VAL;
+        }
+        break;
+
+    case SCL_ELEMENT_DA:
+        if (nameEquals(name, nameLength, "Val")) {
+            SclParser_startText(self);
+            return SCL_ELEMENT_DA_VAL;
+        }
+        break;
+
+    case SCL_ELEMENT_COMMUNICATION:
+        if (nameEquals(name, nameLength, "SubNetwork"))
+            return SCL_ELEMENT_SUB_NETWORK;
+        break;
+
+    case SCL_ELEMENT_SUB_NETWORK:
+        if (nameEquals(name, nameLength, "ConnectedAP")) {
+            SclParser_addConnectedAP(self, element);
+            return SCL_ELEMENT_CONNECTED_AP;
+        }
+        break;
+
+    case SCL_ELEMENT_CONNECTED_AP:
+        if (nameEquals(name, nameLength, "GSE")) {
+            SclParser_addCommAddress(self, element, false);
+            return SCL_ELEMENT_GSE;
+        }
+        else if (nameEquals(name, nameLength, "SMV")) {
+            SclParser_addCommAddress(self, element, true);
+            return SCL_ELEMENT_GSE;
+        }
+        break;
+
+    case SCL_ELEMENT_GSE:
+        if (nameEquals(name, nameLength, "Address"))
+            return SCL_ELEMENT_ADDRESS;
+        else if (nameEquals(name, nameLength, "MinTime")) {
+            SclParser_startText(self);
+            return SCL_ELEMENT_MIN_TIME;
+        }
+        else if (nameEquals(name, nameLength, "MaxTime")) {
+            SclParser_startText(self);
+            return SCL_ELEMENT_MAX_TIME;
+        }
+        break;
+
+    case SCL_ELEMENT_ADDRESS:
+        if (nameEquals(name, nameLength, "P")) {
+            if (XmlElement_getAttributeValue(element, "type", self->pType) == NULL)
+                self->pType[0] = 0;
+
+            SclParser_startText(self);
+            return SCL_ELEMENT_P;
+        }
+        break;
+
+    default:
+        break;
+    }
+
+    return SCL_ELEMENT_UNKNOWN;
+}
+
+static void
+handleTypeElementEnd(SclParser* self, SclElementKind kind)
+{
+    switch (kind) {
+
+    case SCL_ELEMENT_DA_VAL:
+        /* the last Val element is used */
+        self->lastDataAttribute->value = SclParser_copyString(self, SclParser_endText(self));
+        break;
+
+    case SCL_ELEMENT_ENUM_VAL:
+        self->lastEnumValue->name = SclParser_copyString(self, SclParser_endText(self));
+        break;
+
+    case SCL_ELEMENT_MIN_TIME:
+        self->currentAddress->minTime = atoi(SclParser_endText(self));
+        break;
+
+    case SCL_ELEMENT_MAX_TIME:
+        self->currentAddress->maxTime = atoi(SclParser_endText(self));
+        break;
+
+    case SCL_ELEMENT_P:
+        SclParser_setAddressParameter(self, self->pType, (char*) SclParser_endText(self));
+        break;
+
+    default:
+        break;
+    }
+}
+
+/*********************************************************************************************
+ * Pass 2: IED section
+ *********************************************************************************************/
+
+static bool
+lookupEnumOrd(SclType* enumType, const char* value, int* ord)
+{
+    SclEnumValue* enumValue = enumType->enumValues;
+
+    while (enumValue) {
+        if (enumValue->name && (strcmp(enumValue->name, value) == 0)) {
+            *ord = enumValue->ord;
+            return true;
+        }
+
+        enumValue = enumValue->next;
+    }
+
+    /* initialization with the ordinal value */
+    char* end;
+
+    long ordValue = strtol(value, &end, 10);
+
+    if ((end == value) || (*end != 0))
+        return false;
+
+    enumValue = enumType->enumValues;
+
+    while (enumValue) {
+        if (enumValue->ord == ordValue) {
+            *ord = enumValue->ord;
+            return true;
+        }
+
+        enumValue = enumValue->next;
+    }
+
+    return false;
+}
+
+static void
+SclParser_setValue(SclParser* self, DataAttribute* dataAttribute, SclType* enumType, const char* valueString)
+{
+    MmsValue* value = NULL;
+
+    char buffer[SCL_MAX_VALUE_LENGTH];
+
+    StringUtils_copyStringMax(buffer, SCL_MAX_VALUE_LENGTH, valueString);
+
+    char* trimmedValue = trimString(buffer);
+
+    switch (dataAttribute->type) {
+
+    case IEC61850_ENUMERATED:
+        {
+            int ord;
+
+            if (enumType && lookupEnumOrd(enumType, trimmedValue, &ord))
+                value = MmsValue_newIntegerFromInt32(ord);
+            else
+                SclParser_error(self, "illegal value for enumerated data attribute: ", trimmedValue);
+        }
+        break;
+
+    case IEC61850_INT8:
+    case IEC61850_INT16:
+    case IEC61850_INT32:
+    case IEC61850_INT64:
+        value = MmsValue_newIntegerFromInt32((int32_t) strtoll(trimmedValue, NULL, 10));
+        break;
+
+    case IEC61850_INT8U:
+    case IEC61850_INT16U:
+    case IEC61850_INT24U:
+    case IEC61850_INT32U:
+        value = MmsValue_newUnsignedFromUint32((uint32_t) strtoll(trimmedValue, NULL, 10));
+        break;
+
+    case IEC61850_BOOLEAN:
+        if (equalsIgnoreCase(trimmedValue, "true"))
+            value = MmsValue_newBoolean(true);
+        break;
+
+    case IEC61850_FLOAT32:
+    case IEC61850_FLOAT64:
+        {
+            StringUtils_replace(trimmedValue, ',', '.');
+
+            double doubleValue = atof(trimmedValue);
+
+            if (dataAttribute->type == IEC61850_FLOAT32)
+                value = MmsValue_newFloat((float) doubleValue);
+            else
+                value = MmsValue_newDouble(doubleValue);
+        }
+        break;
+
+    case IEC61850_UNICODE_STRING_255:
+        value = MmsValue_newMmsString(valueString);
+        break;
+
+    case IEC61850_VISIBLE_STRING_32:
+    case IEC61850_VISIBLE_STRING_64:
+    case IEC61850_VISIBLE_STRING_65:
+    case IEC61850_VISIBLE_STRING_129:
+    case IEC61850_VISIBLE_STRING_255:
+    case IEC61850_CURRENCY:
+        value = MmsValue_newVisibleString(valueString);
+        break;
+
+    default:
+        break;
+    }
+
+    if (value) {
+        if (dataAttribute->mmsValue)
+            MmsValue_delete(dataAttribute->mmsValue);
+
+        dataAttribute->mmsValue = value;
+    }
+}
+
+static void
+SclParser_createDataAttribute(SclParser* self, ModelNode* parent, SclDataAttributeDefinition* definition,
+        int fc, uint8_t triggerOptions)
+{
+    DataAttribute* dataAttribute = DataAttribute_create(definition->name, parent, definition->attributeType,
+            (FunctionalConstraint) fc, triggerOptions, definition->count, 0);
+
+    if (dataAttribute == NULL) {
+        SclParser_error(self, "out of memory", NULL);
+        return;
+    }
+
+    if (definition->attributeType == IEC61850_CONSTRUCTED) {
+        SclType* type = SclParser_resolveType(self, &(definition->type), SCL_TYPE_DA_TYPE, definition->typeId);
+
+        if (type == NULL)
+            return;
+
+        /* sub attributes inherit the FC and the trigger options of the parent */
+        SclDataAttributeDefinition* subDefinition = type->dataAttributes;
+
+        while (subDefinition && (self->error == false)) {
+            SclParser_createDataAttribute(self, (ModelNode*) dataAttribute, subDefinition, fc, triggerOptions);
+
+            subDefinition = subDefinition->next;
+        }
+    }
+    else {
+        SclType* enumType = NULL;
+
+        if (definition->attributeType == IEC61850_ENUMERATED) {
+            enumType = SclParser_resolveType(self, &(definition->type), SCL_TYPE_ENUM_TYPE, definition->typeId);
+
+            if (enumType == NULL)
+                return;
+        }
+
+        if (definition->value)
+            SclParser_setValue(self, dataAttribute, enumType, definition->value);
+    }
+}
+
+static void
+SclParser_createDataObject(SclParser* self, ModelNode* parent, SclDataObjectDefinition* definition, bool isTransient)
+{
+    SclType* type = SclParser_resolveType(self, &(definition->type), SCL_TYPE_DO_TYPE, definition->typeId);
+
+    if (type == NULL)
+        return;
+
+    DataObject* dataObject = DataObject_create(definition->name, parent, definition->count);
+
+    if (dataObject == NULL) {
+        SclParser_error(self, "out of memory", NULL);
+        return;
+    }
+
+    if (definition->isTransient)
+        isTransient = true;
+
+    SclDataObjectDefinition* subDataObject = type->dataObjects;
+
+    while (subDataObject && (self->error == false)) {
+        SclParser_createDataObject(self, (ModelNode*) dataObject, subDataObject, isTransient);
+
+        subDataObject = subDataObject->next;
+    }
+
+    SclDataAttributeDefinition* dataAttribute = type->dataAttributes;
+
+    while (dataAttribute && (self->error == false)) {
+        uint8_t triggerOptions = dataAttribute->triggerOptions;
+
+        if (isTransient)
+            triggerOptions |= TRG_OPT_TRANSIENT;
+
+        /* editable setting group values (SE) require the corresponding SG values */
+        if (dataAttribute->fc == IEC61850_FC_SE)
+            SclParser_createDataAttribute(self, (ModelNode*) dataObject, dataAttribute, IEC61850_FC_SG, triggerOptions);
+
+        SclParser_createDataAttribute(self, (ModelNode*) dataObject, dataAttribute, dataAttribute->fc, triggerOptions);
+
+        dataAttribute = dataAttribute->next;
+    }
+}
+
+static void
+SclParser_createLogicalNode(SclParser* self, XmlElement* element)
+{
+    char prefix[SCL_MAX_VALUE_LENGTH];
+    char lnClass[SCL_MAX_VALUE_LENGTH];
+    char inst[SCL_MAX_VALUE_LENGTH];
+    char lnType[SCL_MAX_VALUE_LENGTH];
+
+    if (XmlElement_getAttributeValue(element, "lnClass", lnClass) == NULL) {
+        SclParser_error(self, "required attribute \"lnClass\" is missing in logical node", NULL);
+        return;
+    }
+
+    if (XmlElement_getAttributeValue(element, "lnType", lnType) == NULL) {
+        SclParser_error(self, "required attribute \"lnType\" is missing in logical node", NULL);
+        return;
+    }
+
+    if (XmlElement_getAttributeValue(element, "inst", inst) == NULL) {
+        SclParser_error(self, "required attribute \"inst\" is missing in logical node", NULL);
+        return;
+    }
+
+    if (XmlElement_getAttributeValue(element, "prefix", prefix) == NULL)
+        prefix[0] = 0;
+
+    self->currentLnType = SclParser_lookupType(self, SCL_TYPE_LNODE_TYPE, lnType);
+
+    if (self->currentLnType == NULL) {
+        SclParser_error(self, "missing type declaration ", lnType);
+        return;
+    }
+
+    char lnName[SCL_MAX_VALUE_LENGTH * 3];
+
+    StringUtils_concatString(lnName, sizeof(lnName), prefix, lnClass);
+    StringUtils_appendString(lnName, sizeof(lnName), inst);
+
+    self->currentLN = LogicalNode_create(lnName, self->currentLD);
+
+    if (self->currentLN == NULL) {
+        SclParser_error(self, "out of memory", NULL);
+        return;
+    }
+
+    SclDataObjectDefinition* dataObject = self->currentLnType->dataObjects;
+
+    while (dataObject && (self->error == false)) {
+        SclParser_createDataObject(self, (ModelNode*) self->currentLN, dataObject, false);
+
+        dataObject = dataObject->next;
+    }
+}
+
+/* data attributes are preferred over data objects with the same name */
+static ModelNode*
+findChild(ModelNode* parent, const char* name)
+{
+    ModelNode* dataObject = NULL;
+    ModelNode* child = parent->firstChild;
+
+    while (child) {
+        if (strcmp(child->name, name) == 0) {
+            if (child->modelType == DataAttributeModelType)
+                return child;
+
+            if (dataObject == NULL)
+                dataObject = child;
+        }
+
+        child = child->sibling;
+    }
+
+    return dataObject;
+}
+
+static SclDataAttributeDefinition*
+findDataAttributeDefinition(SclType* type, const char* name)
+{
+    SclDataAttributeDefinition* definition = type->dataAttributes;
+
+    while (definition) {
+        if (strcmp(definition->name, name) == 0)
+            return definition;
+
+        definition = definition->next;
+    }
+
+    return NULL;
+}
+
+static SclDataObjectDefinition*
+findDataObjectDefinition(SclType* type, const char* name)
+{
+    SclDataObjectDefinition* definition = type->dataObjects;
+
+    while (definition) {
+        if (strcmp(definition->name, name) == 0)
+            return definition;
+
+        definition = definition->next;
+    }
+
+    return NULL;
+}
+
+/* push a DOI/SDI model node and its type (DOType or DAType) to the instance stack */
+static SclElementKind
+SclParser_enterInstance(SclParser* self, XmlElement* element, SclElementKind kind)
+{
+    char name[SCL_MAX_VALUE_LENGTH];
+
+    if (XmlElement_getAttributeValue(element, "name", name) == NULL) {
+        SclParser_error(self, "instance element without name", NULL);
+        return SCL_ELEMENT_UNKNOWN;
+    }
+
+    ModelNode* parent;
+    SclType* parentType;
+
+    if (kind == SCL_ELEMENT_DOI) {
+        parent = (ModelNode*) self->currentLN;
+        parentType = self->currentLnType;
+        self->instanceDepth = 0;
+    }
+    else {
+        parent = self->instanceNodes[self->instanceDepth - 1];
+        parentType = self->instanceTypes[self->instanceDepth - 1];
+    }
+
+    ModelNode* node = findChild(parent, name);
+
+    if (node == NULL) {
+        if (kind == SCL_ELEMENT_DOI) {
+            SclParser_error(self, "missing data object with name ", name);
+            return SCL_ELEMENT_UNKNOWN;
+        }
+
+        if (DEBUG_IED_SERVER)
+            printf("IED_SERVER: SCL file: sub element with name %s not found\n", name);
+
+        return SCL_ELEMENT_UNKNOWN;
+    }
+
+    SclType* type = NULL;
+
+    if (node->modelType == DataObjectModelType) {
+        SclDataObjectDefinition* definition = findDataObjectDefinition(parentType, name);
+
+        if (definition)
+            type = definition->type;
+    }
+    else if (((DataAttribute*) node)->type == IEC61850_CONSTRUCTED) {
+        SclDataAttributeDefinition* definition = findDataAttributeDefinition(parentType, name);
+
+        if (definition)
+            type = definition->type;
+    }
+
+    /* SDI for a basic data attribute (e.g. array elements) */
+    if (type == NULL)
+        return SCL_ELEMENT_UNKNOWN;
+
+    if (self->instanceDepth == SCL_MAX_DEPTH) {
+        SclParser_error(self, "elements nested too deep", NULL);
+        return SCL_ELEMENT_UNKNOWN;
+    }
+
+    self->instanceNodes[self->instanceDepth] = node;
+    self->instanceTypes[self->instanceDepth] = type;
+    self->instanceDepth++;
+
+    return kind;
+}
+
+static SclElementKind
+SclParser_enterDataAttributeInstance(SclParser* self, XmlElement* element)
+{
+    char name[SCL_MAX_VALUE_LENGTH];
+
+    if (XmlElement_getAttributeValue(element, "name", name) == NULL) {
+        SclParser_error(self, "DAI element without name", NULL);
+        return SCL_ELEMENT_UNKNOWN;
+    }
+
+    ModelNode* node = findChild(self->instanceNodes[self->instanceDepth - 1], name);
+
+    if ((node == NULL) || (node->modelType != DataAttributeModelType)) {
+        SclParser_error(self, "missing data attribute with name ", name);
+        return SCL_ELEMENT_UNKNOWN;
+    }
+
+    DataAttribute* dataAttribute = (DataAttribute*) node;
+
+    char sAddr[SCL_MAX_VALUE_LENGTH];
+
+    if (XmlElement_getAttributeValue(element, "sAddr", sAddr) && (sAddr[0] != 0)) {
+        char* end;
+
+        unsigned long shortAddress = strtoul(sAddr, &end, 10);
+
+        if (*end == 0)
+            dataAttribute->sAddr = (uint32_t) shortAddress;
+        else if (DEBUG_IED_SERVER)
+            printf("IED_SERVER: SCL file: short address \"%s\" is not valid\n", sAddr);
+    }
+
+    self->currentDataAttribute = dataAttribute;
+    self->currentEnumType = NULL;
+    self->hasDaiValue = false;
+
+    if (dataAttribute->type == IEC61850_ENUMERATED) {
+        SclDataAttributeDefinition* definition =
+                findDataAttributeDefinition(self->instanceTypes[self->instanceDepth - 1], name);
+
+        if (definition)
+            self->currentEnumType = definition->type;
+    }
+
+    return SCL_ELEMENT_DAI;
+}
+
+static void
+SclParser_createDataSetEntry(SclParser* self, XmlElement* element)
+{
+    char ldInst[SCL_MAX_VALUE_LENGTH];
+    char prefix[SCL_MAX_VALUE_LENGTH];
+    char lnClass[SCL_MAX_VALUE_LENGTH];
+    char lnInst[SCL_MAX_VALUE_LENGTH];
+    char doName[SCL_MAX_VALUE_LENGTH];
+    char daName[SCL_MAX_VALUE_LENGTH];
+    char fc[SCL_MAX_VALUE_LENGTH];
+
+    if ((XmlElement_getAttributeValue(element, "lnClass", lnClass) == NULL) ||
+            (XmlElement_getAttributeValue(element, "fc", fc) == NULL) ||
+            (XmlElement_getAttributeValue(element, "doName", doName) == NULL)) {
+        SclParser_error(self, "FCDA is missing required attribute", NULL);
+        return;
+    }
+
+    char variable[SCL_MAX_VALUE_LENGTH * 4];
+
+    variable[0] = 0;
+
+    if (XmlElement_getAttributeValue(element, "prefix", prefix))
+        StringUtils_appendString(variable, sizeof(variable), prefix);
+
+    StringUtils_appendString(variable, sizeof(variable), lnClass);
+
+    if (XmlElement_getAttributeValue(element, "lnInst", lnInst))
+        StringUtils_appendString(variable, sizeof(variable), lnInst);
+
+    StringUtils_appendString(variable, sizeof(variable), "$");
+    StringUtils_appendString(variable, sizeof(variable), fc);
+    StringUtils_appendString(variable, sizeof(variable), "$");
+    StringUtils_appendString(variable, sizeof(variable), doName);
+
+    if (XmlElement_getAttributeValue(element, "daName", daName)) {
+        StringUtils_appendString(variable, sizeof(variable), "$");
+        StringUtils_appendString(variable, sizeof(variable), daName);
+    }
+
+    StringUtils_replace(variable, '.', '$');
+
+    /* check for array index and component */
+    int arrayIndex = -1;
+    char* component = NULL;
+
+    char* arrayStart = strchr(variable, '(');
+
+    if (arrayStart) {
+        *arrayStart = 0;
+
+        arrayIndex = atoi(arrayStart + 1);
+
+        if (arrayIndex < 0) {
+            SclParser_error(self, "array index out of range in data set entry definition", NULL);
+            return;
+        }
+
+        char* arrayEnd = strchr(arrayStart + 1, ')');
+
+        if (arrayEnd) {
+            component = arrayEnd + 1;
+
+            if (*component == '$')
+                component++;
+
+            if (*component == 0)
+                component = NULL;
+        }
+    }
+
+    char reference[SCL_MAX_VALUE_LENGTH * 5];
+
+    if (XmlElement_getAttributeValue(element, "ldInst", ldInst) && (strcmp(ldInst, self->currentLD->name) != 0))
+        StringUtils_createStringInBuffer(reference, sizeof(reference), 3, ldInst, "/", variable);
+    else
+        StringUtils_copyStringMax(reference, sizeof(reference), variable);
+
+    DataSetEntry_create(self->currentDataSet, reference, arrayIndex, component);
+}
+
+static uint8_t
+getTriggerOptions(XmlElement* element)
+{
+    uint8_t trgOps = 0;
+
+    if (XmlElement_getBoolAttribute(element, "dchg", false))
+        trgOps |= TRG_OPT_DATA_CHANGED;
+
+    if (XmlElement_getBoolAttribute(element, "qchg", false))
+        trgOps |= TRG_OPT_QUALITY_CHANGED;
+
+    if (XmlElement_getBoolAttribute(element, "dupd", false))
+        trgOps |= TRG_OPT_DATA_UPDATE;
+
+    if (XmlElement_getBoolAttribute(element, "period", false))
+        trgOps |= TRG_OPT_INTEGRITY;
+
+    if (XmlElement_getBoolAttribute(element, "gi", true))
+        trgOps |= TRG_OPT_GI;
+
+    return trgOps;
+}
+
+static uint8_t
+getOptionFields(XmlElement* element)
+{
+    uint8_t options = 0;
+
+    if (XmlElement_getBoolAttribute(element, "seqNum", false))
+        options |= RPT_OPT_SEQ_NUM;
+
+    if (XmlElement_getBoolAttribute(element, "timeStamp", false))
+        options |= RPT_OPT_TIME_STAMP;
+
+    if (XmlElement_getBoolAttribute(element, "reasonCode", false))
+        options |= RPT_OPT_REASON_FOR_INCLUSION;
+
+    if (XmlElement_getBoolAttribute(element, "dataSet", false))
+        options |= RPT_OPT_DATA_SET;
+
+    if (XmlElement_getBoolAttribute(element, "dataRef", false))
+        options |= RPT_OPT_DATA_REFERENCE;
+
+    if (XmlElement_getBoolAttribute(element, "bufOvfl", true))
+        options |= RPT_OPT_BUFFER_OVERFLOW;
+
+    if (XmlElement_getBoolAttribute(element, "entryID", false))
+        options |= RPT_OPT_ENTRY_ID;
+
+    if (XmlElement_getBoolAttribute(element, "configRef", false))
+        options |= RPT_OPT_CONF_REV;
+
+    return options;
+}
+
+/* same bit values as IEC61850_SV_OPT_* */
+static uint8_t
+getSmvOptions(XmlElement* element)
+{
+    uint8_t options = 0;
+
+    if (XmlElement_getBoolAttribute(element, "refreshTime", false))
+        options |= 1;
+
+    if (XmlElement_getBoolAttribute(element, "sampleSynchronized", false))
+        options |= 2;
+
+    if (XmlElement_getBoolAttribute(element, "sampleRate", false))
+        options |= 4;
+
+    if (XmlElement_getBoolAttribute(element, "dataSet", false))
+        options |= 8;
+
+    if (XmlElement_getBoolAttribute(element, "security", false))
+        options |= 16;
+
+    return options;
+}
+
+static void
+SclParser_startControlBlock(SclParser* self, XmlElement* element)
+{
+    SclControlBlock* controlBlock = &(self->controlBlock);
+
+    memset(controlBlock, 0, sizeof(SclControlBlock));
+
+    if (XmlElement_getAttributeValue(element, "name", controlBlock->name) == NULL)
+        SclParser_error(self, "control block without name", NULL);
+
+    controlBlock->hasDataSet = (XmlElement_getAttributeValue(element, "datSet", controlBlock->dataSet) != NULL);
+    controlBlock->trgOps = TRG_OPT_GI;
+}
+
+static void
+SclParser_createGSEControlBlock(SclParser* self, XmlElement* element)
+{
+    char name[SCL_MAX_VALUE_LENGTH];
+    char appId[SCL_MAX_VALUE_LENGTH];
+    char dataSet[SCL_MAX_VALUE_LENGTH];
+
+    if (XmlElement_getAttributeValue(element, "name", name) == NULL) {
+        SclParser_error(self, "GSEControl without name", NULL);
+        return;
+    }
+
+    uint32_t confRev = (uint32_t) XmlElement_getIntAttribute(element, "confRev", 1);
+    bool fixedOffs = XmlElement_getBoolAttribute(element, "fixedOffs", false);
+
+    SclCommAddress* address = SclParser_lookupCommAddress(self, name, false);
+
+    GSEControlBlock* gcb = GSEControlBlock_create(name, self->currentLN,
+            XmlElement_getAttributeValue(element, "appID", appId),
+            XmlElement_getAttributeValue(element, "datSet", dataSet), confRev, fixedOffs,
+            address ? address->minTime : -1, address ? address->maxTime : -1);
+
+    if (gcb && address)
+        GSEControlBlock_addPhyComAddress(gcb, createPhyComAddress(address));
+}
+
+static void
+SclParser_createReportControlBlocks(SclParser* self)
+{
+    SclControlBlock* rcb = &(self->controlBlock);
+
+    uint8_t trgOps = rcb->trgOps;
+
+    if (self->hasOwner)
+        trgOps += 64;
+
+    const char* rptId = (rcb->hasRptId && (rcb->rptId[0] != 0)) ? rcb->rptId : NULL;
+    const char* dataSet = rcb->hasDataSet ? rcb->dataSet : NULL;
+
+    if (rcb->isIndexed) {
+        int i;
+
+        for (i = 1; i <= rcb->maxInstances; i++) {
+            char name[SCL_MAX_VALUE_LENGTH + 16];
+
+            snprintf(name, sizeof(name), "%s%02d", rcb->name, i);
+
+            ReportControlBlock_create(name, self->currentLN, rptId, rcb->isBuffered, dataSet, rcb->confRev,
+                    trgOps, rcb->options, rcb->bufTime, rcb->intgPd);
+        }
+    }
+    else
+        ReportControlBlock_create(rcb->name, self->currentLN, rptId, rcb->isBuffered, dataSet, rcb->confRev,
+                trgOps, rcb->options, rcb->bufTime, rcb->intgPd);
+}
+
+static void
+SclParser_createLogControlBlock(SclParser* self)
+{
+    SclControlBlock* lcb = &(self->controlBlock);
+
+    char* logRef = NULL;
+
+    /* the log name is stored in the rptId field */
+    if (lcb->rptId[0] != 0)
+        logRef = StringUtils_createString(5, self->currentLD->name, "/", self->currentLN->name, "$", lcb->rptId);
+
+    const char* dataSet = (lcb->hasDataSet && (lcb->dataSet[0] != 0)) ? lcb->dataSet : NULL;
+
+    LogControlBlock_create(lcb->name, self->currentLN, dataSet, logRef, lcb->trgOps, lcb->intgPd,
+            lcb->logEna, lcb->reasonCode);
+
+    if (logRef)
+        GLOBAL_FREEMEM(logRef);
+}
+
+static void
+SclParser_createSVControlBlock(SclParser* self)
+{
+    SclControlBlock* svcb = &(self->controlBlock);
+
+    SVControlBlock* svControlBlock = SVControlBlock_create(svcb->name, self->currentLN,
+            svcb->hasRptId ? svcb->rptId : NULL, svcb->hasDataSet ? svcb->dataSet : NULL, svcb->confRev,
+            svcb->smpMod, svcb->smpRate, svcb->options, svcb->isUnicast);
+
+    if (svControlBlock)
+        svControlBlock->noASDU = svcb->noASDU;
+
+    SclCommAddress* address = SclParser_lookupCommAddress(self, svcb->name, true);
+
+    if (svControlBlock && address)
+        SVControlBlock_addPhyComAddress(svControlBlock, createPhyComAddress(address));
+}
+
+static SclConnectedAP*
+SclParser_lookupConnectedAP(SclParser* self, const char* apName)
+{
+    SclConnectedAP* connectedAP = self->connectedAPs;
+
+    while (connectedAP) {
+        if (connectedAP->iedName && connectedAP->apName && (strcmp(connectedAP->iedName, self->iedName) == 0) &&
+                (strcmp(connectedAP->apName, apName) == 0))
+            return connectedAP;
+
+        connectedAP = connectedAP->next;
+    }
+
+    return NULL;
+}
+
+static SclElementKind
+handleLogicalNodeChildStart(SclParser* self, XmlElement* element)
+{
+    const char* name = element->name;
+    int nameLength = element->nameLength;
+
+    if (nameEquals(name, nameLength, "DOI"))
+        return SclParser_enterInstance(self, element, SCL_ELEMENT_DOI);
+    else if (nameEquals(name, nameLength, "DataSet")) {
+        char dataSetName[SCL_MAX_VALUE_LENGTH];
+
+        if (XmlElement_getAttributeValue(element, "name", dataSetName) == NULL) {
+            SclParser_error(self, "DataSet without name", NULL);
+            return SCL_ELEMENT_UNKNOWN;
+        }
+
+        self->currentDataSet = DataSet_create(dataSetName, self->currentLN);
+
+        return SCL_ELEMENT_DATA_SET;
+    }
+    else if (nameEquals(name, nameLength, "ReportControl")) {
+        SclControlBlock* rcb = &(self->controlBlock);
+
+        SclParser_startControlBlock(self, element);
+
+        rcb->hasRptId = (XmlElement_getAttributeValue(element, "rptID", rcb->rptId) != NULL);
+        rcb->isBuffered = XmlElement_getBoolAttribute(element, "buffered", false);
+        rcb->isIndexed = XmlElement_getBoolAttribute(element, "indexed", true);
+        rcb->bufTime = (uint32_t) XmlElement_getIntAttribute(element, "bufTime", 0);
+        rcb->intgPd = (uint32_t) XmlElement_getIntAttribute(element, "intgPd", 0);
+        rcb->options = RPT_OPT_BUFFER_OVERFLOW;
+        rcb->maxInstances = 1;
+
+        if (XmlElement_getAttribute(element, "confRev") == NULL) {
+            SclParser_error(self, "missing required attribute \"confRev\"", NULL);
+            return SCL_ELEMENT_UNKNOWN;
+        }
+
+        rcb->confRev = (uint32_t) XmlElement_getIntAttribute(element, "confRev", 0);
+
+        return SCL_ELEMENT_REPORT_CONTROL;
+    }
+    else if (nameEquals(name, nameLength, "LogControl")) {
+        SclControlBlock* lcb = &(self->controlBlock);
+
+        SclParser_startControlBlock(self, element);
+
+        lcb->intgPd = (uint32_t) XmlElement_getIntAttribute(element, "intgPd", 0);
+        lcb->logEna = XmlElement_getBoolAttribute(element, "logEna", true);
+        lcb->reasonCode = XmlElement_getBoolAttribute(element, "reasonCode", true);
+
+        if (XmlElement_getAttributeValue(element, "logName", lcb->rptId) == NULL) {
+            SclParser_error(self, "LogControl is missing required attribute \"logName\"", NULL);
+            return SCL_ELEMENT_UNKNOWN;
+        }
+
+        return SCL_ELEMENT_LOG_CONTROL;
+    }
+    else if (nameEquals(name, nameLength, "Log")) {
+        char logName[SCL_MAX_VALUE_LENGTH];
+
+        if (XmlElement_getAttributeValue(element, "name", logName) == NULL)
+            StringUtils_copyStringMax(logName, sizeof(logName), "GeneralLog");
+
+        Log_create(logName, self->currentLN);
+    }
+    else if (nameEquals(name, nameLength, "GSEControl"))
+        SclParser_createGSEControlBlock(self, element);
+    else if (nameEquals(name, nameLength, "SampledValueControl")) {
+        SclControlBlock* svcb = &(self->controlBlock);
+
+        SclParser_startControlBlock(self, element);
+
+        char smpMod[SCL_MAX_VALUE_LENGTH];
+
+        svcb->hasRptId = (XmlElement_getAttributeValue(element, "smvID", svcb->rptId) != NULL);
+        svcb->confRev = (uint32_t) XmlElement_getIntAttribute(element, "confRev", 1);
+        svcb->smpRate = (uint16_t) XmlElement_getIntAttribute(element, "smpRate", 0);
+        svcb->noASDU = XmlElement_getIntAttribute(element, "nofASDU", 0);
+        svcb->isUnicast = !XmlElement_getBoolAttribute(element, "multicast", false);
+
+        if (XmlElement_getAttributeValue(element, "smpMod", smpMod)) {
+            if (strcmp(smpMod, "SmpPerPeriod") == 0)
+                svcb->smpMod = 0;
+            else if (strcmp(smpMod, "SmpPerSec") == 0)
+                svcb->smpMod = 1;
+            else if (strcmp(smpMod, "SecPerSmp") == 0)
+                svcb->smpMod = 2;
+            else {
+                SclParser_error(self, "invalid smpMod value ", smpMod);
+                return SCL_ELEMENT_UNKNOWN;
+            }
+        }
+
+        return SCL_ELEMENT_SAMPLED_VALUE_CONTROL;
+    }
+    else if (nameEquals(name, nameLength, "SettingControl")) {
+#if (CONFIG_IEC61850_SETTING_GROUPS == 1)
+        if (strcmp(self->currentLN->name, "LLN0") != 0) {
+            SclParser_error(self, "LN other than LN0 is not allowed to contain SettingControl", NULL);
+            return SCL_ELEMENT_UNKNOWN;
+        }
+
+        long numOfSGs = XmlElement_getIntAttribute(element, "numOfSGs", 1);
+        long actSG = XmlElement_getIntAttribute(element, "actSG", 1);
+
+        if ((numOfSGs < 1) || (numOfSGs > 255) || (actSG < 1) || (actSG > numOfSGs)) {
+            SclParser_error(self, "invalid SettingControl", NULL);
+            return SCL_ELEMENT_UNKNOWN;
+        }
+
+        SettingGroupControlBlock_create(self->currentLN, (uint8_t) actSG, (uint8_t) numOfSGs);
+#endif /* (CONFIG_IEC61850_SETTING_GROUPS == 1) */
+    }
+
+    return SCL_ELEMENT_UNKNOWN;
+}
+
+static SclElementKind
+handleIedElementStart(SclParser* self, XmlElement* element, SclElementKind parentKind)
+{
+    const char* name = element->name;
+    int nameLength = element->nameLength;
+
+    switch (parentKind) {
+
+    case SCL_ELEMENT_NONE:
+        if (nameEquals(name, nameLength, "IED"))
+            return SCL_ELEMENT_IED;
+        break;
+
+    case SCL_ELEMENT_IED:
+        if (nameEquals(name, nameLength, "Services"))
+            return SCL_ELEMENT_SERVICES;
+        else if (nameEquals(name, nameLength, "AccessPoint") && (self->hasServer == false)) {
+            const char* apName = SclParser_copyAttributeValue(self, element, "name");
+
+            if (apName == NULL)
+                break;
+
+            if ((self->selectedAccessPointName == NULL) || (strcmp(apName, self->selectedAccessPointName) == 0)) {
+                self->accessPointName = apName;
+                return SCL_ELEMENT_ACCESS_POINT;
+            }
+        }
+        break;
+
+    case SCL_ELEMENT_SERVICES:
+        if (nameEquals(name, nameLength, "ReportSettings")) {
+            if (XmlElement_getBoolAttribute(element, "owner", false))
+                self->hasOwner = true;
+        }
+        break;
+
+    case SCL_ELEMENT_ACCESS_POINT:
+        if (nameEquals(name, nameLength, "Server")) {
+            self->hasServer = true;
+            self->connectedAP = SclParser_lookupConnectedAP(self, self->accessPointName);
+
+            if ((self->connectedAP == NULL) && DEBUG_IED_SERVER)
+                printf("IED_SERVER: SCL file: IED %s has no connected access point\n", self->iedName);
+
+            return SCL_ELEMENT_SERVER;
+        }
+        break;
+
+    case SCL_ELEMENT_SERVER:
+        if (nameEquals(name, nameLength, "LDevice")) {
+            char inst[SCL_MAX_VALUE_LENGTH];
+
+            if (XmlElement_getAttributeValue(element, "inst", inst) == NULL) {
+                SclParser_error(self, "LDevice without inst", NULL);
+                break;
+            }
+
+            self->currentLD = LogicalDevice_create(inst, self->model);
+
+            return SCL_ELEMENT_LDEVICE;
+        }
+        break;
+
+    case SCL_ELEMENT_LDEVICE:
+        if (nameEquals(name, nameLength, "LN0") || nameEquals(name, nameLength, "LN")) {
+            SclParser_createLogicalNode(self, element);
+
+            return SCL_ELEMENT_LN;
+        }
+        break;
+
+    case SCL_ELEMENT_LN:
+        return handleLogicalNodeChildStart(self, element);
+
+    case SCL_ELEMENT_DOI:
+    case SCL_ELEMENT_SDI:
+        if (nameEquals(name, nameLength, "SDI"))
+            return SclParser_enterInstance(self, element, SCL_ELEMENT_SDI);
+        else if (nameEquals(name, nameLength, "DAI"))
+            return SclParser_enterDataAttributeInstance(self, element);
+        break;
+
+    case SCL_ELEMENT_DAI:
+        /* the first Val element is used */
+        if (nameEquals(name, nameLength, "Val") && (self->hasDaiValue == false)) {
+            SclParser_startText(self);
+            return SCL_ELEMENT_DAI_VAL;
+        }
+        break;
+
+    case SCL_ELEMENT_DATA_SET:
+        if (nameEquals(name, nameLength, "FCDA"))
+            SclParser_createDataSetEntry(self, element);
+        break;
+
+    case SCL_ELEMENT_REPORT_CONTROL:
+        if (nameEquals(name, nameLength, "TrgOps"))
+            self->controlBlock.trgOps = getTriggerOptions(element);
+        else if (nameEquals(name, nameLength, "OptFields"))
+            self->controlBlock.options = getOptionFields(element);
+        else if (nameEquals(name, nameLength, "RptEnabled")) {
+            self->controlBlock.maxInstances = (int) XmlElement_getIntAttribute(element, "max", 1);
+
+            if ((self->controlBlock.isIndexed == false) && (self->controlBlock.maxInstances != 1))
+                SclParser_error(self, "RptEnabled.max != 1 is not allowed when indexed=\"false\"", NULL);
+        }
+        break;
+
+    case SCL_ELEMENT_LOG_CONTROL:
+        if (nameEquals(name, nameLength, "TrgOps"))
+            self->controlBlock.trgOps = getTriggerOptions(element);
+        break;
+
+    case SCL_ELEMENT_SAMPLED_VALUE_CONTROL:
+        if (nameEquals(name, nameLength, "SmvOpts"))
+            self->controlBlock.options = getSmvOptions(element);
+        break;
+
+    default:
+        break;
+    }
+
+    return SCL_ELEMENT_UNKNOWN;
+}
+
+static void
+handleIedElementEnd(SclParser* self, SclElementKind kind)
+{
+    switch (kind) {
+
+    case SCL_ELEMENT_DOI:
+    case SCL_ELEMENT_SDI:
+        self->instanceDepth--;
+        break;
+
+    case SCL_ELEMENT_DAI_VAL:
+        self->hasDaiValue = true;
+        SclParser_setValue(self, self->currentDataAttribute, self->currentEnumType, SclParser_endText(self));
+        break;
+
+    case SCL_ELEMENT_DATA_SET:
+        self->currentDataSet = NULL;
+        break;
+
+    case SCL_ELEMENT_REPORT_CONTROL:
+        SclParser_createReportControlBlocks(self);
+        break;
+
+    case SCL_ELEMENT_LOG_CONTROL:
+        SclParser_createLogControlBlock(self);
+        break;
+
+    case SCL_ELEMENT_SAMPLED_VALUE_CONTROL:
+        SclParser_createSVControlBlock(self);
+        break;
+
+    case SCL_ELEMENT_LN:
+        self->currentLN = NULL;
+        self->currentLnType = NULL;
+        break;
+
+    default:
+        break;
+    }
+}
+
+static void
+SclParser_destroy(SclParser* self)
+{
+    while (self->memory) {
+        SclMemoryBlock* next = self->memory->next;
+
+        GLOBAL_FREEMEM(self->memory);
+
+        self->memory = next;
+    }
+
+    if (self->types)
+        GLOBAL_FREEMEM(self->types);
+
+    if (self->text)
+        GLOBAL_FREEMEM(self->text);
+}
+
+IedModel*
+SclFileParser_createModelFromSclFile(const char* filename, const char* iedName, const char* accessPointName)
+{
+    uint32_t fileSize;
+
+    if (FileSystem_getFileInfo((char*) filename, &fileSize, NULL) == false) {
+        if (DEBUG_IED_SERVER)
+            printf("IED_SERVER: SCL file %s not found\n", filename);
+
+        return NULL;
+    }
+
+    FileHandle file = FileSystem_openFile((char*) filename, false);
+
+    if (file == NULL)
+        return NULL;
+
+    bool isMapped = true;
+
+    uint8_t* buffer = FileSystem_mapFile(file, fileSize);
+
+    if (buffer == NULL) {
+        isMapped = false;
+
+        buffer = (uint8_t*) GLOBAL_MALLOC(fileSize + 1);
+
+        uint32_t bytesRead = 0;
+
+        if (buffer) {
+            while (bytesRead < fileSize) {
+                int readBytes = FileSystem_readFile(file, buffer + bytesRead, fileSize - bytesRead);
+
+                if (readBytes <= 0)
+                    break;
+
+                bytesRead += readBytes;
+            }
+        }
+
+        if (bytesRead != fileSize) {
+            FileSystem_closeFile(file);
+
+            if (buffer)
+                GLOBAL_FREEMEM(buffer);
+
+            return NULL;
+        }
+    }
+
+    FileSystem_closeFile(file);
+
+    SclParser parser;
+
+    memset(&parser, 0, sizeof(SclParser));
+
+    parser.buffer = (const char*) buffer;
+    parser.size = (int) fileSize;
+    parser.iedPosition = -1;
+    parser.selectedIedName = iedName;
+    parser.selectedAccessPointName = accessPointName;
+
+    IedModel* model = NULL;
+
+    if (SclParser_parse(&parser, 0, handleTypeElementStart, handleTypeElementEnd)) {
+
+        if (parser.iedPosition == -1) {
+            if (DEBUG_IED_SERVER)
+                printf("IED_SERVER: SCL file: IED %s not found\n", iedName ? iedName : "");
+        }
+        else {
+            model = IedModel_create(parser.iedName);
+
+            parser.model = model;
+
+            if (model) {
+                SclParser_parse(&parser, parser.iedPosition, handleIedElementStart, handleIedElementEnd);
+
+                if ((parser.error == false) && (parser.hasServer == false)) {
+                    parser.tagPosition = parser.iedPosition;
+                    SclParser_error(&parser, "no access point with server found in IED ", parser.iedName);
+                }
+
+                if (parser.error) {
+                    IedModel_destroy(model);
+                    model = NULL;
+                }
+            }
+        }
+    }
+
+    SclParser_destroy(&parser);
+
+    if (isMapped)
+        FileSystem_unmapFile(buffer, fileSize);
+    else
+        GLOBAL_FREEMEM(buffer);
+
+    return model;
+}
@@ -0,0 +1,1179 @@
+/*
+ *  log_storage_mmap.c
+ *
+ *  Log storage driver that stores the log in a ring of records in a memory-mapped file
+ *
+ *  This file is part of libIEC61850.
+ *
+ *  libIEC61850 is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  libIEC61850 is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with libIEC61850.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+#include "log_storage_mmap.h"
+
+#include "hal_thread.h"
+#include "platform_atomic.h"
+
+#include <stdio.h>
+#include <stddef.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#ifndef DEBUG_LOG_STORAGE_DRIVER
+#define DEBUG_LOG_STORAGE_DRIVER 0
+#endif
+
+/*
+ * File layout:
+ *
+ * | file header (FILE_HEADER_SIZE) | ring of records (ringSize) |
+ *
+ * Each record starts at a multiple of RECORD_ALIGNMENT. A log entry is stored as an entry
+ * record followed by one data record for each entry data. When a record doesn't fit at the
+ * end of the ring a wrap record fills the remaining space and the next record is stored at
+ * the start of the ring. When less than a record header remains the wrap is implicit.
+ *
+ * Records have consecutive sequence numbers. A record is only valid when the commit marker
+ * is set and the checksum is correct. When the file is opened the valid records are searched
+ * and the newest run of records with consecutive sequence numbers is used as the log.
+ * Records with a sequence number lower than tailSequence of the file header have been
+ * deleted (by LogStorage_setMaxLogEntries or because the ring was full).
+ */
+
+#define FILE_MAGIC "LIBIECLR"
+#define FILE_VERSION 1
+#define FILE_BYTE_ORDER 0x01020304
+#define FILE_HEADER_SIZE 4096
+
+#define RECORD_ALIGNMENT 16
+#define RECORD_COMMITTED 0x52434d54 /* "RCMT" */
+
+#define RECORD_TYPE_ENTRY 1
+#define RECORD_TYPE_DATA 2
+#define RECORD_TYPE_WRAP 3
+
+/* every INDEX_INTERVAL entries a point is added to the time index */
+#define INDEX_INTERVAL 32
+
+#define MIN_RING_SIZE (64 * 1024)
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint64_t ringSize;
+    uint64_t tailSequence; /* records with a lower sequence number are deleted */
+} FileHeader;
+
+typedef struct {
+    uint32_t marker; /* RECORD_COMMITTED when the record is complete */
+    uint32_t length; /* record length including header (multiple of RECORD_ALIGNMENT) */
+    uint64_t sequence;
+    uint64_t entryID;
+    uint64_t timestamp;
+    uint32_t dataSize;
+    uint16_t dataRefLength;
+    uint8_t type;
+    uint8_t reasonCode;
+    uint32_t checksum; /* over the header fields from length to reasonCode and the record content */
+    uint32_t reserved;
+} RecordHeader;
+
+#define RECORD_HEADER_SIZE ((uint32_t) sizeof(RecordHeader))
+
+typedef struct {
+    uint64_t sequence;
+    uint64_t entryID;
+    uint64_t maxTimestamp; /* maximum timestamp of all entries up to this point */
+    uint32_t offset;
+} IndexPoint;
+
+typedef struct {
+    uint64_t sequence;
+    uint32_t offset;
+} RecoveredRecord;
+
+typedef struct sMmapLogStorage {
+    char* filename;
+    int fd;
+    uint8_t* mapping;
+    size_t mappingSize;
+
+    FileHeader* header;
+    uint8_t* ring;
+    uint32_t ringSize;
+
+    Semaphore lock;
+
+    bool syncOnCommit;
+    bool inTransaction;
+    bool wrappedInTransaction;
+    uint32_t dirtyStart;
+    uint32_t dirtyEnd;
+
+    /* ring state */
+    bool empty;
+    uint32_t tailOffset; /* oldest record (always an entry record) */
+    uint64_t tailSequence;
+    uint32_t headOffset; /* position of the next record */
+    uint64_t nextSequence;
+    uint64_t nextEntryID;
+
+    int numberOfEntries;
+    uint64_t newEntryID;
+    uint64_t newEntryTime;
+    uint64_t maxTimestamp;
+    bool timeOrdered; /* timestamps of all entries are not decreasing */
+
+    /* sparse index (entries from indexFirst to indexCount - 1 are valid) */
+    IndexPoint* index;
+    int indexFirst;
+    int indexCount;
+    int indexSize;
+    int entriesSinceIndexPoint;
+} MmapLogStorage;
+
+static uint64_t
+MmapLogStorage_addEntry(LogStorage self, uint64_t timestamp);
+
+static bool
+MmapLogStorage_addEntryWithID(LogStorage self, uint64_t entryID, uint64_t timestamp);
+
+static bool
+MmapLogStorage_addEntryData(LogStorage self, uint64_t entryID, const char* dataRef, uint8_t* data, int dataSize, uint8_t reasonCode);
+
+static bool
+MmapLogStorage_getEntries(LogStorage self, uint64_t startingTime, uint64_t endingTime,
+        LogEntryCallback entryCallback, LogEntryDataCallback entryDataCallback, void* parameter);
+
+static bool
+MmapLogStorage_getEntriesAfter(LogStorage self, uint64_t startingTime, uint64_t entryID,
+        LogEntryCallback entryCallback, LogEntryDataCallback entryDataCallback, void* parameter);
+
+static bool
+MmapLogStorage_getOldestAndNewestEntries(LogStorage self, uint64_t* newEntry, uint64_t* newEntryTime,
+        uint64_t* oldEntry, uint64_t* oldEntryTime);
+
+static void*
+MmapLogStorage_openCursor(LogStorage self, uint64_t startingTime, uint64_t endingTime, uint64_t entryID);
+
+static bool
+MmapLogStorage_readCursor(LogStorage self, void* cursor,
+        LogEntryCallback entryCallback, LogEntryDataCallback entryDataCallback, void* parameter);
+
+static void
+MmapLogStorage_closeCursor(LogStorage self, void* cursor);
+
+static bool
+MmapLogStorage_beginTransaction(LogStorage self);
+
+static bool
+MmapLogStorage_commitTransaction(LogStorage self);
+
+static void
+MmapLogStorage_destroy(LogStorage self);
+
+static RecordHeader*
+getRecord(MmapLogStorage* self, uint32_t offset)
+{
+    return (RecordHeader*) (self->ring + offset);
+}
+
+static uint32_t
+alignRecordLength(uint32_t length)
+{
+    return (length + (RECORD_ALIGNMENT - 1)) & ~((uint32_t) (RECORD_ALIGNMENT - 1));
+}
+
+static uint32_t
+calculateChecksum(RecordHeader* record)
+{
+    uint32_t hash = 2166136261u;
+
+    uint8_t* start = (uint8_t*) record + offsetof(RecordHeader, length);
+    uint8_t* end = (uint8_t*) record + offsetof(RecordHeader, checksum);
+
+    while (start < end) {
+        hash ^= *start++;
+        hash *= 16777619u;
+    }
+
+    start = (uint8_t*) record + RECORD_HEADER_SIZE;
+    end = start + record->dataRefLength + record->dataSize;
+
+    while (start < end) {
+        hash ^= *start++;
+        hash *= 16777619u;
+    }
+
+    return hash;
+}
+
+/* position of the record following the record at offset */
+static uint32_t
+getNextOffset(MmapLogStorage* self, uint32_t offset)
+{
+    uint32_t nextOffset = offset + getRecord(self, offset)->length;
+
+    if (self->ringSize - nextOffset < RECORD_HEADER_SIZE)
+        nextOffset = 0;
+
+    return nextOffset;
+}
+
+static bool
+isValidRecord(MmapLogStorage* self, uint32_t offset)
+{
+    RecordHeader* record = getRecord(self, offset);
+
+    if (record->marker != RECORD_COMMITTED)
+        return false;
+
+    if ((record->length < RECORD_HEADER_SIZE) || (record->length % RECORD_ALIGNMENT) ||
+            (record->length > self->ringSize - offset))
+        return false;
+
+    if ((record->type < RECORD_TYPE_ENTRY) || (record->type > RECORD_TYPE_WRAP))
+        return false;
+
+    if ((uint64_t) RECORD_HEADER_SIZE + record->dataRefLength + record->dataSize > record->length)
+        return false;
+
+    return (calculateChecksum(record) == record->checksum);
+}
+
+static void
+markDirty(MmapLogStorage* self, uint32_t start, uint32_t end)
+{
+    if (self->dirtyEnd == 0) {
+        self->dirtyStart = start;
+        self->dirtyEnd = end;
+    }
+    else {
+        if (start < self->dirtyStart)
+            self->dirtyStart = start;
+
+        if (end > self->dirtyEnd)
+            self->dirtyEnd = end;
+    }
+}
+
+static void
+syncDirtyRange(MmapLogStorage* self)
+{
+    long pageSize = sysconf(_SC_PAGESIZE);
+
+    if (self->wrappedInTransaction) {
+        msync(self->mapping, self->mappingSize, MS_SYNC);
+    }
+    else {
+        msync(self->mapping, FILE_HEADER_SIZE, MS_SYNC);
+
+        if (self->dirtyEnd > 0) {
+            size_t start = (FILE_HEADER_SIZE + self->dirtyStart) & ~((size_t) pageSize - 1);
+            size_t end = FILE_HEADER_SIZE + self->dirtyEnd;
+
+            msync(self->mapping + start, end - start, MS_SYNC);
+        }
+    }
+
+    self->dirtyStart = 0;
+    self->dirtyEnd = 0;
+    self->wrappedInTransaction = false;
+}
+
+static void
+setTailSequence(MmapLogStorage* self, uint64_t tailSequence)
+{
+    self->tailSequence = tailSequence;
+    self->header->tailSequence = tailSequence;
+}
+
+static void
+addIndexPoint(MmapLogStorage* self, uint32_t offset, RecordHeader* record)
+{
+    if (self->indexCount == self->indexSize) {
+        if (self->indexFirst > 0) {
+            /* reuse the space of deleted points */
+            memmove(self->index, self->index + self->indexFirst, (self->indexCount - self->indexFirst) * sizeof(IndexPoint));
+            self->indexCount -= self->indexFirst;
+            self->indexFirst = 0;
+        }
+        else {
+            int newSize = (self->indexSize == 0) ? 64 : (self->indexSize * 2);
+
+            IndexPoint* newIndex = (IndexPoint*) realloc(self->index, newSize * sizeof(IndexPoint));
+
+            if (newIndex == NULL)
+                return;
+
+            self->index = newIndex;
+            self->indexSize = newSize;
+        }
+    }
+
+    IndexPoint* point = &(self->index[self->indexCount++]);
+
+    point->sequence = record->sequence;
+    point->entryID = record->entryID;
+    point->maxTimestamp = self->maxTimestamp;
+    point->offset = offset;
+}
+
+/* update the in-memory state for a new entry record (maxTimestamp has to be updated before) */
+static void
+entryAdded(MmapLogStorage* self, uint32_t offset, RecordHeader* record)
+{
+    if (self->empty) {
+        self->empty = false;
+        self->tailOffset = offset;
+        setTailSequence(self, record->sequence);
+    }
+
+    if (self->entriesSinceIndexPoint == 0)
+        addIndexPoint(self, offset, record);
+
+    self->entriesSinceIndexPoint++;
+
+    if (self->entriesSinceIndexPoint == INDEX_INTERVAL)
+        self->entriesSinceIndexPoint = 0;
+
+    self->numberOfEntries++;
+    self->newEntryID = record->entryID;
+    self->newEntryTime = record->timestamp;
+}
+
+/* remove the oldest entry with its data records (and following wrap records) */
+static void
+dropOldestEntry(MmapLogStorage* self)
+{
+    if (self->empty)
+        return;
+
+    uint32_t offset = self->tailOffset;
+    uint64_t sequence = self->tailSequence;
+
+    self->numberOfEntries--;
+
+    while (true) {
+        offset = getNextOffset(self, offset);
+        sequence++;
+
+        if (sequence == self->nextSequence) {
+            /* no more records */
+            self->empty = true;
+            break;
+        }
+
+        if (getRecord(self, offset)->type == RECORD_TYPE_ENTRY)
+            break;
+    }
+
+    setTailSequence(self, sequence);
+
+    if (self->empty) {
+        self->numberOfEntries = 0;
+        self->indexFirst = 0;
+        self->indexCount = 0;
+        self->entriesSinceIndexPoint = 0;
+        self->timeOrdered = true;
+        self->maxTimestamp = 0;
+    }
+    else {
+        self->tailOffset = offset;
+
+        while ((self->indexFirst < self->indexCount) && (self->index[self->indexFirst].sequence < sequence))
+            self->indexFirst++;
+    }
+}
+
+/* remove the oldest entries until the area [offset, offset + length) is free */
+static void
+freeSpace(MmapLogStorage* self, uint32_t offset, uint32_t length)
+{
+    while ((self->empty == false) && (self->tailOffset >= offset) && (self->tailOffset < offset + length))
+        dropOldestEntry(self);
+}
+
+static void
+commitRecord(MmapLogStorage* self, uint32_t offset, RecordHeader* record)
+{
+    record->checksum = calculateChecksum(record);
+
+    /* the marker has to be written after the content of the record */
+    Atomic_store32((volatile int32_t*) &(record->marker), (int32_t) RECORD_COMMITTED);
+
+    markDirty(self, offset, offset + record->length);
+
+    if (self->syncOnCommit && (self->inTransaction == false))
+        syncDirtyRange(self);
+}
+
+/* reserve space for a new record at the head of the ring. Returns NULL when the record is too large */
+static RecordHeader*
+allocateRecord(MmapLogStorage* self, uint32_t contentLength, uint32_t* recordOffset)
+{
+    uint32_t length = alignRecordLength(RECORD_HEADER_SIZE + contentLength);
+
+    if (length > self->ringSize / 2)
+        return NULL;
+
+    if (self->ringSize - self->headOffset < length) {
+        /* not enough space at the end of the ring -> wrap */
+        uint32_t remaining = self->ringSize - self->headOffset;
+
+        freeSpace(self, self->headOffset, remaining);
+
+        if (remaining >= RECORD_HEADER_SIZE) {
+            RecordHeader* wrap = getRecord(self, self->headOffset);
+
+            wrap->marker = 0;
+            wrap->length = remaining;
+            wrap->sequence = self->nextSequence++;
+            wrap->entryID = 0;
+            wrap->timestamp = 0;
+            wrap->dataSize = 0;
+            wrap->dataRefLength = 0;
+            wrap->type = RECORD_TYPE_WRAP;
+            wrap->reasonCode = 0;
+            wrap->reserved = 0;
+
+            commitRecord(self, self->headOffset, wrap);
+        }
+
+        if (self->inTransaction)
+            self->wrappedInTransaction = true;
+
+        self->headOffset = 0;
+    }
+
+    freeSpace(self, self->headOffset, length);
+
+    RecordHeader* record = getRecord(self, self->headOffset);
+
+    /* invalidate the old content before the record is written */
+    record->marker = 0;
+    record->length = length;
+    record->sequence = self->nextSequence++;
+    record->reserved = 0;
+
+    *recordOffset = self->headOffset;
+
+    self->headOffset += length;
+
+    if (self->ringSize - self->headOffset < RECORD_HEADER_SIZE)
+        self->headOffset = 0;
+
+    return record;
+}
+
+static bool
+addEntryRecord(LogStorage self, uint64_t entryID, uint64_t timestamp)
+{
+    MmapLogStorage* instanceData = (MmapLogStorage*) (self->instanceData);
+
+    uint32_t offset;
+
+    RecordHeader* record = allocateRecord(instanceData, 0, &offset);
+
+    if (record == NULL)
+        return false;
+
+    record->entryID = entryID;
+    record->timestamp = timestamp;
+    record->dataSize = 0;
+    record->dataRefLength = 0;
+    record->type = RECORD_TYPE_ENTRY;
+    record->reasonCode = 0;
+
+    commitRecord(instanceData, offset, record);
+
+    if (timestamp < instanceData->maxTimestamp)
+        instanceData->timeOrdered = false;
+    else
+        instanceData->maxTimestamp = timestamp;
+
+    entryAdded(instanceData, offset, record);
+
+    if (entryID >= instanceData->nextEntryID)
+        instanceData->nextEntryID = entryID + 1;
+
+    if (self->maxLogEntries > 0) {
+        while (instanceData->numberOfEntries > self->maxLogEntries)
+            dropOldestEntry(instanceData);
+    }
+
+    return true;
+}
+
+static uint64_t
+MmapLogStorage_addEntry(LogStorage self, uint64_t timestamp)
+{
+    MmapLogStorage* instanceData = (MmapLogStorage*) (self->instanceData);
+
+    Semaphore_wait(instanceData->lock);
+
+    uint64_t entryID = instanceData->nextEntryID;
+
+    if (addEntryRecord(self, entryID, timestamp) == false)
+        entryID = 0;
+
+    Semaphore_post(instanceData->lock);
+
+    if (DEBUG_LOG_STORAGE_DRIVER)
+        printf("LOG_STORAGE_DRIVER: mmap - new entry with ID = %llu\n", (unsigned long long) entryID);
+
+    return entryID;
+}
+
+static bool
+MmapLogStorage_addEntryWithID(LogStorage self, uint64_t entryID, uint64_t timestamp)
+{
+    MmapLogStorage* instanceData = (MmapLogStorage*) (self->instanceData);
+
+    bool success = false;
+
+    Semaphore_wait(instanceData->lock);
+
+    /* entryIDs have to be increasing */
+    if (entryID >= instanceData->nextEntryID)
+        success = addEntryRecord(self, entryID, timestamp);
+
+    Semaphore_post(instanceData->lock);
+
+    return success;
+}
+
+static bool
+MmapLogStorage_addEntryData(LogStorage self, uint64_t entryID, const char* dataRef, uint8_t* data, int dataSize, uint8_t reasonCode)
+{
+    MmapLogStorage* instanceData = (MmapLogStorage*) (self->instanceData);
+
+    int dataRefLength = strlen(dataRef);
+
+    if ((dataRefLength > 0xffff) || (dataSize < 0))
+        return false;
+
+    bool success = false;
+
+    Semaphore_wait(instanceData->lock);
+
+    /* the entry has to be stored in the ring */
+    if ((instanceData->empty == false) && (entryID >= getRecord(instanceData, instanceData->tailOffset)->entryID)) {
+
+        uint32_t offset;
+
+        RecordHeader* record = allocateRecord(instanceData, dataRefLength + dataSize, &offset);
+
+        if (record) {
+            record->entryID = entryID;
+            record->timestamp = 0;
+            record->dataSize = dataSize;
+            record->dataRefLength = (uint16_t) dataRefLength;
+            record->type = RECORD_TYPE_DATA;
+            record->reasonCode = reasonCode;
+
+            uint8_t* content = (uint8_t*) record + RECORD_HEADER_SIZE;
+
+            memcpy(content, dataRef, dataRefLength);
+            memcpy(content + dataRefLength, data, dataSize);
+
+            commitRecord(instanceData, offset, record);
+
+            /* the entry itself can be overwritten when the ring is too small */
+            success = (instanceData->empty == false);
+        }
+    }
+
+    Semaphore_post(instanceData->lock);
+
+    if (success == false) {
+        if (DEBUG_LOG_STORAGE_DRIVER)
+            printf("LOG_STORAGE_DRIVER: mmap - failed to add entry data!\n");
+    }
+
+    return success;
+}
+
+/* find the index point to start a query - returns the offset of an entry record */
+static uint32_t
+findStartOffset(MmapLogStorage* self, uint64_t startingTime, uint64_t entryID, bool byTime)
+{
+    uint32_t offset = self->tailOffset;
+
+    int low = self->indexFirst;
+    int high = self->indexCount - 1;
+
+    /* find the last point that is before the requested entries */
+    while (low <= high) {
+        int middle = low + (high - low) / 2;
+
+        IndexPoint* point = &(self->index[middle]);
+
+        bool before = byTime ? (point->maxTimestamp < startingTime) : (point->entryID <= entryID);
+
+        if (before) {
+            offset = point->offset;
+            low = middle + 1;
+        }
+        else {
+            high = middle - 1;
+        }
+    }
+
+    return offset;
+}
+
+/* selection and read position of a query (also used as cursor) */
+typedef struct {
+    uint64_t startingTime;
+    uint64_t endingTime;
+    uint64_t afterEntryID; /* only entries with a larger entryID are selected */
+
+    bool hasPosition;
+    uint32_t offset; /* entry record where the next read starts */
+    uint64_t sequence;
+} MmapLogCursor;
+
+static uint32_t
+getCursorStartOffset(MmapLogStorage* self, MmapLogCursor* cursor)
+{
+    if (cursor->hasPosition && (cursor->sequence >= self->tailSequence) && (cursor->sequence < self->nextSequence)) {
+        RecordHeader* record = getRecord(self, cursor->offset);
+
+        /* the position is still valid when the record has not been overwritten */
+        if ((record->sequence == cursor->sequence) && (record->type == RECORD_TYPE_ENTRY))
+            return cursor->offset;
+    }
+
+    if (cursor->afterEntryID != 0)
+        return findStartOffset(self, 0, cursor->afterEntryID, false);
+    else
+        return findStartOffset(self, cursor->startingTime, 0, true);
+}
+
+/*
+ * Iterate the entries from the cursor position to the head of the ring. The cursor is updated
+ * after each complete entry. When a callback aborts the read the next read starts with the
+ * incomplete entry.
+ */
+static void
+readEntries(MmapLogStorage* self, MmapLogCursor* cursor,
+        LogEntryCallback entryCallback, LogEntryDataCallback entryDataCallback, void* parameter)
+{
+    bool sendFinalEvent = true;
+
+    if (self->empty == false) {
+        uint32_t offset = getCursorStartOffset(self, cursor);
+        uint64_t currentEntryID = 0;
+        bool entrySelected = false;
+
+        while (true) {
+            RecordHeader* record = getRecord(self, offset);
+
+            if (record->type == RECORD_TYPE_ENTRY) {
+
+                if (entrySelected) {
+                    if (entryDataCallback)
+                        entryDataCallback(parameter, NULL, NULL, 0, 0, false);
+
+                    cursor->afterEntryID = currentEntryID;
+                    entrySelected = false;
+                }
+
+                if ((record->timestamp > cursor->endingTime) && self->timeOrdered)
+                    break;
+
+                cursor->hasPosition = true;
+                cursor->offset = offset;
+                cursor->sequence = record->sequence;
+
+                entrySelected = ((record->entryID > cursor->afterEntryID) &&
+                        (record->timestamp >= cursor->startingTime) && (record->timestamp <= cursor->endingTime));
+
+                currentEntryID = record->entryID;
+
+                if (entrySelected && entryCallback) {
+                    if (entryCallback(parameter, record->timestamp, record->entryID, true) == false) {
+                        entrySelected = false;
+                        sendFinalEvent = false;
+                        break;
+                    }
+                }
+            }
+            else if ((record->type == RECORD_TYPE_DATA) && entrySelected && (record->entryID == currentEntryID)) {
+
+                if (entryDataCallback) {
+                    char dataRef[130];
+
+                    uint8_t* content = (uint8_t*) record + RECORD_HEADER_SIZE;
+
+                    int dataRefLength = record->dataRefLength;
+
+                    if (dataRefLength > (int) sizeof(dataRef) - 1)
+                        dataRefLength = sizeof(dataRef) - 1;
+
+                    memcpy(dataRef, content, dataRefLength);
+                    dataRef[dataRefLength] = 0;
+
+                    /* stop reading as soon as the receiver is full (e.g. the MMS PDU of the journal service) */
+                    if (entryDataCallback(parameter, dataRef, content + record->dataRefLength, record->dataSize,
+                            record->reasonCode, true) == false) {
+                        entrySelected = false;
+                        sendFinalEvent = false;
+                        break;
+                    }
+                }
+            }
+
+            if (record->sequence + 1 == self->nextSequence)
+                break;
+
+            offset = getNextOffset(self, offset);
+        }
+
+        if (entrySelected) {
+            if (entryDataCallback)
+                entryDataCallback(parameter, NULL, NULL, 0, 0, false);
+
+            cursor->afterEntryID = currentEntryID;
+        }
+    }
+
+    if (sendFinalEvent && entryCallback)
+        entryCallback(parameter, 0, 0, false);
+}
+
+static bool
+MmapLogStorage_getEntries(LogStorage self, uint64_t startingTime, uint64_t endingTime,
+        LogEntryCallback entryCallback, LogEntryDataCallback entryDataCallback, void* parameter)
+{
+    MmapLogStorage* instanceData = (MmapLogStorage*) (self->instanceData);
+
+    MmapLogCursor cursor;
+    memset(&cursor, 0, sizeof(MmapLogCursor));
+
+    cursor.startingTime = startingTime;
+    cursor.endingTime = endingTime;
+
+    Semaphore_wait(instanceData->lock);
+
+    readEntries(instanceData, &cursor, entryCallback, entryDataCallback, parameter);
+
+    Semaphore_post(instanceData->lock);
+
+    return true;
+}
+
+static bool
+MmapLogStorage_getEntriesAfter(LogStorage self, uint64_t startingTime, uint64_t entryID,
+        LogEntryCallback entryCallback, LogEntryDataCallback entryDataCallback, void* parameter)
+{
+    MmapLogStorage* instanceData = (MmapLogStorage*) (self->instanceData);
+
+    (void)startingTime;
+
+    MmapLogCursor cursor;
+    memset(&cursor, 0, sizeof(MmapLogCursor));
+
+    cursor.endingTime = UINT64_MAX;
+    cursor.afterEntryID = entryID;
+
+    Semaphore_wait(instanceData->lock);
+
+    readEntries(instanceData, &cursor, entryCallback, entryDataCallback, parameter);
+
+    Semaphore_post(instanceData->lock);
+
+    return true;
+}
+
+static void*
+MmapLogStorage_openCursor(LogStorage self, uint64_t startingTime, uint64_t endingTime, uint64_t entryID)
+{
+    (void)self;
+
+    MmapLogCursor* cursor = (MmapLogCursor*) calloc(1, sizeof(MmapLogCursor));
+
+    if (cursor) {
+        /* for entries after entryID the starting time is the time of that entry and not a selection criteria */
+        if (entryID == 0)
+            cursor->startingTime = startingTime;
+
+        cursor->endingTime = endingTime;
+        cursor->afterEntryID = entryID;
+    }
+
+    return cursor;
+}
+
+static bool
+MmapLogStorage_readCursor(LogStorage self, void* cursor,
+        LogEntryCallback entryCallback, LogEntryDataCallback entryDataCallback, void* parameter)
+{
+    MmapLogStorage* instanceData = (MmapLogStorage*) (self->instanceData);
+
+    Semaphore_wait(instanceData->lock);
+
+    readEntries(instanceData, (MmapLogCursor*) cursor, entryCallback, entryDataCallback, parameter);
+
+    Semaphore_post(instanceData->lock);
+
+    return true;
+}
+
+static void
+MmapLogStorage_closeCursor(LogStorage self, void* cursor)
+{
+    (void)self;
+
+    free(cursor);
+}
+
+static bool
+MmapLogStorage_getOldestAndNewestEntries(LogStorage self, uint64_t* newEntry, uint64_t* newEntryTime,
+        uint64_t* oldEntry, uint64_t* oldEntryTime)
+{
+    MmapLogStorage* instanceData = (MmapLogStorage*) (self->instanceData);
+
+    bool retVal = false;
+
+    Semaphore_wait(instanceData->lock);
+
+    if (instanceData->empty) {
+        *newEntry = 0;
+        *newEntryTime = 0;
+        *oldEntry = 0;
+        *oldEntryTime = 0;
+    }
+    else {
+        RecordHeader* oldest = getRecord(instanceData, instanceData->tailOffset);
+
+        *oldEntry = oldest->entryID;
+        *oldEntryTime = oldest->timestamp;
+        *newEntry = instanceData->newEntryID;
+        *newEntryTime = instanceData->newEntryTime;
+
+        retVal = true;
+    }
+
+    Semaphore_post(instanceData->lock);
+
+    return retVal;
+}
+
+static bool
+MmapLogStorage_beginTransaction(LogStorage self)
+{
+    MmapLogStorage* instanceData = (MmapLogStorage*) (self->instanceData);
+
+    Semaphore_wait(instanceData->lock);
+    instanceData->inTransaction = true;
+    Semaphore_post(instanceData->lock);
+
+    return true;
+}
+
+static bool
+MmapLogStorage_commitTransaction(LogStorage self)
+{
+    MmapLogStorage* instanceData = (MmapLogStorage*) (self->instanceData);
+
+    Semaphore_wait(instanceData->lock);
+
+    instanceData->inTransaction = false;
+
+    if (instanceData->syncOnCommit)
+        syncDirtyRange(instanceData);
+
+    Semaphore_post(instanceData->lock);
+
+    return true;
+}
+
+static int
+compareRecoveredRecords(const void* a, const void* b)
+{
+    uint64_t sequenceA = ((const RecoveredRecord*) a)->sequence;
+    uint64_t sequenceB = ((const RecoveredRecord*) b)->sequence;
+
+    if (sequenceA < sequenceB)
+        return -1;
+    else if (sequenceA > sequenceB)
+        return 1;
+    else
+        return 0;
+}
+
+/* restore the ring state from the valid records in the file */
+static bool
+recoverRing(MmapLogStorage* self)
+{
+    int maxRecords = self->ringSize / RECORD_HEADER_SIZE;
+    int numberOfRecords = 0;
+
+    RecoveredRecord* records = (RecoveredRecord*) malloc(maxRecords * sizeof(RecoveredRecord));
+
+    if (records == NULL)
+        return false;
+
+    uint64_t maxEntryID = 0;
+
+    uint32_t offset = 0;
+
+    while (self->ringSize - offset >= RECORD_HEADER_SIZE) {
+        if (isValidRecord(self, offset)) {
+            RecordHeader* record = getRecord(self, offset);
+
+            if (record->entryID > maxEntryID)
+                maxEntryID = record->entryID;
+
+            if (record->sequence >= self->header->tailSequence) {
+                records[numberOfRecords].sequence = record->sequence;
+                records[numberOfRecords].offset = offset;
+                numberOfRecords++;
+            }
+
+            offset += record->length;
+        }
+        else
+            offset += RECORD_ALIGNMENT;
+    }
+
+    self->empty = true;
+    self->headOffset = 0;
+    self->nextSequence = self->header->tailSequence + 1;
+    self->nextEntryID = maxEntryID + 1;
+    self->timeOrdered = true;
+
+    if (numberOfRecords > 0) {
+        qsort(records, numberOfRecords, sizeof(RecoveredRecord), compareRecoveredRecords);
+
+        /* find the newest run of consecutive records */
+        int first = numberOfRecords - 1;
+
+        while (first > 0) {
+            RecoveredRecord* previous = &(records[first - 1]);
+
+            if (previous->sequence + 1 != records[first].sequence)
+                break;
+
+            if (getNextOffset(self, previous->offset) != records[first].offset)
+                break;
+
+            first--;
+        }
+
+        RecoveredRecord* newest = &(records[numberOfRecords - 1]);
+
+        self->headOffset = getNextOffset(self, newest->offset);
+        self->nextSequence = newest->sequence + 1;
+
+        /* the log starts with the first entry record of the run */
+        while ((first < numberOfRecords) && (getRecord(self, records[first].offset)->type != RECORD_TYPE_ENTRY))
+            first++;
+
+        int i;
+
+        for (i = first; i < numberOfRecords; i++) {
+            RecordHeader* record = getRecord(self, records[i].offset);
+
+            if (record->type == RECORD_TYPE_ENTRY) {
+                if (record->timestamp < self->maxTimestamp)
+                    self->timeOrdered = false;
+                else
+                    self->maxTimestamp = record->timestamp;
+
+                entryAdded(self, records[i].offset, record);
+            }
+        }
+    }
+
+    if (self->empty)
+        setTailSequence(self, self->nextSequence);
+
+    if (DEBUG_LOG_STORAGE_DRIVER)
+        printf("LOG_STORAGE_DRIVER: mmap - recovered %i entries (%i valid records)\n", self->numberOfEntries, numberOfRecords);
+
+    free(records);
+
+    return true;
+}
+
+static bool
+openFile(MmapLogStorage* self, int sizeInBytes)
+{
+    self->fd = open(self->filename, O_RDWR | O_CREAT, 0644);
+
+    if (self->fd == -1)
+        return false;
+
+    struct stat fileStat;
+
+    if (fstat(self->fd, &fileStat) == -1)
+        return false;
+
+    bool newFile = (fileStat.st_size == 0);
+
+    if (newFile) {
+        if (sizeInBytes < MIN_RING_SIZE)
+            sizeInBytes = MIN_RING_SIZE;
+
+        sizeInBytes = sizeInBytes & ~(RECORD_ALIGNMENT - 1);
+
+        self->mappingSize = FILE_HEADER_SIZE + (size_t) sizeInBytes;
+
+        if (ftruncate(self->fd, (off_t) self->mappingSize) == -1)
+            return false;
+    }
+    else {
+        if (fileStat.st_size <= FILE_HEADER_SIZE + MIN_RING_SIZE - 1)
+            return false;
+
+        if ((uint64_t) fileStat.st_size > (uint64_t) FILE_HEADER_SIZE + 0x7fffffff)
+            return false;
+
+        self->mappingSize = (size_t) fileStat.st_size;
+    }
+
+    self->mapping = (uint8_t*) mmap(NULL, self->mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, self->fd, 0);
+
+    if (self->mapping == MAP_FAILED) {
+        self->mapping = NULL;
+        return false;
+    }
+
+    self->header = (FileHeader*) self->mapping;
+    self->ring = self->mapping + FILE_HEADER_SIZE;
+
+    if (newFile) {
+        memcpy(self->header->magic, FILE_MAGIC, 8);
+        self->header->version = FILE_VERSION;
+        self->header->byteOrder = FILE_BYTE_ORDER;
+        self->header->ringSize = self->mappingSize - FILE_HEADER_SIZE;
+        self->header->tailSequence = 1;
+    }
+    else {
+        if ((memcmp(self->header->magic, FILE_MAGIC, 8) != 0) || (self->header->version != FILE_VERSION) ||
+                (self->header->byteOrder != FILE_BYTE_ORDER) ||
+                (self->header->ringSize != self->mappingSize - FILE_HEADER_SIZE)) {
+
+            if (DEBUG_LOG_STORAGE_DRIVER)
+                printf("LOG_STORAGE_DRIVER: mmap - invalid or incompatible log file %s\n", self->filename);
+
+            return false;
+        }
+    }
+
+    self->ringSize = (uint32_t) self->header->ringSize;
+
+    return true;
+}
+
+static void
+releaseInstanceData(MmapLogStorage* self)
+{
+    if (self->mapping)
+        munmap(self->mapping, self->mappingSize);
+
+    if (self->fd != -1)
+        close(self->fd);
+
+    if (self->lock)
+        Semaphore_destroy(self->lock);
+
+    free(self->index);
+    free(self->filename);
+    free(self);
+}
+
+LogStorage
+MmapLogStorage_createInstance(const char* filename, int sizeInBytes)
+{
+    MmapLogStorage* instanceData = (MmapLogStorage*) calloc(1, sizeof(struct sMmapLogStorage));
+
+    if (instanceData == NULL)
+        return NULL;
+
+    instanceData->fd = -1;
+    instanceData->filename = (char*) malloc(strlen(filename) + 1);
+
+    if (instanceData->filename == NULL)
+        goto exit_with_error;
+
+    strcpy(instanceData->filename, filename);
+
+    if (openFile(instanceData, sizeInBytes) == false)
+        goto exit_with_error;
+
+    if (recoverRing(instanceData) == false)
+        goto exit_with_error;
+
+    instanceData->lock = Semaphore_create(1);
+
+    LogStorage self = (LogStorage) calloc(1, sizeof(struct sLogStorage));
+
+    if (self == NULL)
+        goto exit_with_error;
+
+    self->instanceData = (void*) instanceData;
+
+    self->addEntry = MmapLogStorage_addEntry;
+    self->addEntryData = MmapLogStorage_addEntryData;
+    self->getEntries = MmapLogStorage_getEntries;
+    self->getEntriesAfter = MmapLogStorage_getEntriesAfter;
+    self->getOldestAndNewestEntries = MmapLogStorage_getOldestAndNewestEntries;
+    self->destroy = MmapLogStorage_destroy;
+    self->addEntryWithID = MmapLogStorage_addEntryWithID;
+    self->beginTransaction = MmapLogStorage_beginTransaction;
+    self->commitTransaction = MmapLogStorage_commitTransaction;
+    self->openCursor = MmapLogStorage_openCursor;
+    self->readCursor = MmapLogStorage_readCursor;
+    self->closeCursor = MmapLogStorage_closeCursor;
+    self->maxLogEntries = -1;
+
+    return self;
+
+exit_with_error:
+    if (DEBUG_LOG_STORAGE_DRIVER)
+        printf("LOG_STORAGE_DRIVER: mmap - failed to create LogStorage instance!\n");
+
+    releaseInstanceData(instanceData);
+
+    return NULL;
+}
+
+void
+MmapLogStorage_setSyncOnCommit(LogStorage self, bool syncOnCommit)
+{
+    MmapLogStorage* instanceData = (MmapLogStorage*) (self->instanceData);
+
+    instanceData->syncOnCommit = syncOnCommit;
+}
+
+static void
+MmapLogStorage_destroy(LogStorage self)
+{
+    MmapLogStorage* instanceData = (MmapLogStorage*) (self->instanceData);
+
+    if (instanceData->syncOnCommit)
+        msync(instanceData->mapping, instanceData->mappingSize, MS_SYNC);
+
+    releaseInstanceData(instanceData);
+
+    free(self);
+}
@@ -0,0 +1,66 @@
+/*
+ *  log_storage_mmap.h
+ *
+ *  This file is part of libIEC61850.
+ *
+ *  libIEC61850 is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  libIEC61850 is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with libIEC61850.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+#ifndef LIBIEC61850_SRC_LOGGING_DRIVERS_MMAP_LOG_STORAGE_MMAP_H_
+#define LIBIEC61850_SRC_LOGGING_DRIVERS_MMAP_LOG_STORAGE_MMAP_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "logging_api.h"
+
+/**
+ * \brief Create a log storage in a memory-mapped file of fixed size (POSIX systems only)
+ *
+ * The log is stored as a ring of records. When the ring is full the oldest log entries are
+ * overwritten. LogStorage_setMaxLogEntries limits the number of entries in the ring.
+ *
+ * Each record is protected by a checksum and a commit marker that is written after the record.
+ * Incomplete records (e.g. after a crash) are ignored when the file is opened again.
+ *
+ * The file is not portable between platforms with different byte order.
+ *
+ * \param filename name of the log file. The file is created when it doesn't exist.
+ * \param sizeInBytes size of the ring for a new file (is ignored when the file already exists)
+ *
+ * \return the new LogStorage instance or NULL on error
+ */
+LogStorage
+MmapLogStorage_createInstance(const char* filename, int sizeInBytes);
+
+/**
+ * \brief Write the records to the storage device when they are committed
+ *
+ * When disabled (default) the records survive a crash of the process but not a power loss.
+ * When enabled each record (or each transaction) is synchronized with msync.
+ *
+ * \param self the LogStorage instance
+ * \param syncOnCommit true to synchronize each commit with the storage device
+ */
+void
+MmapLogStorage_setSyncOnCommit(LogStorage self, bool syncOnCommit);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LIBIEC61850_SRC_LOGGING_DRIVERS_MMAP_LOG_STORAGE_MMAP_H_ */
@@ -52,38 +52,101 @@ SqliteLogStorage_getOldestAndNewestEntries(LogStorage self, uint64_t* newEntry,
 static void
 SqliteLogStorage_destroy(LogStorage self);
 
+static bool
+SqliteLogStorage_addEntryWithID(LogStorage self, uint64_t entryID, uint64_t timestamp);
+
+static bool
+SqliteLogStorage_beginTransaction(LogStorage self);
+
+static bool
+SqliteLogStorage_commitTransaction(LogStorage self);
+
+static void*
+SqliteLogStorage_openCursor(LogStorage self, uint64_t startingTime, uint64_t endingTime, uint64_t entryID);
+
+static bool
+SqliteLogStorage_readCursor(LogStorage self, void* cursor,
+        LogEntryCallback entryCallback, LogEntryDataCallback entryDataCallback, void* parameter);
+
+static void
+SqliteLogStorage_closeCursor(LogStorage self, void* cursor);
+
 
 typedef struct sSqliteLogStorage {
     char* filename;
     sqlite3* db;
     sqlite3_stmt* insertEntryStmt;
+    sqlite3_stmt* insertEntryWithIdStmt;
     sqlite3_stmt* insertEntryDataStmt;
     sqlite3_stmt* getEntriesWithRange;
     sqlite3_stmt* getEntriesAfter;
+    sqlite3_stmt* getCursorEntriesByTime;
+    sqlite3_stmt* getCursorEntriesAfter;
     sqlite3_stmt* getEntryData;
     sqlite3_stmt* getOldEntry;
     sqlite3_stmt* getNewEntry;
     sqlite3_stmt* getEntriesCount;
     sqlite3_stmt* deleteEntryData;
     sqlite3_stmt* deleteEntry;
+
+    /* in-memory copy of the log status to avoid queries for each new entry */
+    int entryCount; /* -1 when unknown */
+    bool validOldEntry;
+    uint64_t oldEntryID;
+    uint64_t oldEntryTime;
+    bool validNewEntry;
+    uint64_t newEntryID;
+    uint64_t newEntryTime;
 } SqliteLogStorage;
 
+/*
+ * A cursor doesn't keep a statement open between the reads because an active read statement
+ * would block the writers. Instead the read continues after the last complete entry
+ * (ordered by timeOfEntry and entryID or by entryID) using the indexes.
+ */
+typedef struct {
+    bool byTime;
+    uint64_t endingTime;
+    uint64_t lastTime; /* entry time of the last complete entry */
+    int64_t lastEntryID; /* last complete entry (-1 before the first entry) */
+} SqliteLogCursor;
+
+/*
+ * Schema version (stored as user_version in the database file)
+ *
+ * 0 - tables without indexes (created by older versions of the driver)
+ * 1 - indexes for timeOfEntry and EntryData.entryID
+ */
+#define SQLITE_LOG_STORAGE_SCHEMA_VERSION 1
+
 static const char* CREATE_TABLE_ENTRYS = "create table if not exists Entries (entryID integer primary key, timeOfEntry integer)";
 static const char* CREATE_TABLE_ENTRY_DATA = "create table if not exists EntryData (entryID integer, dataRef text, value blob, reasonCode integer)";
+static const char* CREATE_INDEX_ENTRIES_TIME = "create index if not exists EntriesTimeOfEntry on Entries (timeOfEntry)";
+static const char* CREATE_INDEX_ENTRY_DATA_ID = "create index if not exists EntryDataEntryID on EntryData (entryID)";
+static const char* GET_SCHEMA_VERSION = "pragma user_version";
+static const char* SET_SCHEMA_VERSION = "pragma user_version = 1";
 static const char* INSERT_ENTRY = "insert into Entries (timeOfEntry) values (?)";
+static const char* INSERT_ENTRY_WITH_ID = "insert into Entries (entryID, timeOfEntry) values (?,?)";
 static const char* INSERT_ENTRY_DATA = "insert into EntryData (entryID, dataRef, value, reasonCode) values (?,?,?,?)";
-static const char* GET_ENTRIES_WITH_RANGE = "select entryID, timeOfEntry from Entries where timeOfEntry >= ? and timeOfEntry <= ?";
+static const char* GET_ENTRIES_WITH_RANGE = "select entryID, timeOfEntry from Entries where timeOfEntry >= ? and timeOfEntry <= ? order by timeOfEntry, entryID";
 static const char* GET_ENTRIES_AFTER = "select entryID, timeOfEntry from Entries where entryID > ?";
+static const char* GET_CURSOR_ENTRIES_BY_TIME = "select entryID, timeOfEntry from Entries where timeOfEntry >= ?1 and timeOfEntry <= ?3 "
+        "and (timeOfEntry > ?1 or entryID > ?2) order by timeOfEntry, entryID";
+static const char* GET_CURSOR_ENTRIES_AFTER = "select entryID, timeOfEntry from Entries where entryID > ? and timeOfEntry <= ? order by entryID";
 static const char* GET_ENTRY_DATA = "select dataRef, value, reasonCode from EntryData where entryID = ?";
 
-static const char* GET_OLD_ENTRY = "select * from Entries where entryID = (select min(entryID) from Entries where timeOfEntry = (select min(timeOfEntry) from Entries))";
-static const char* GET_NEW_ENTRY = "select * from Entries where entryID = (select max(entryID) from Entries where timeOfEntry = (select max(timeOfEntry) from Entries))";
+static const char* GET_OLD_ENTRY = "select entryID, timeOfEntry from Entries order by timeOfEntry asc, entryID asc limit 1";
+static const char* GET_NEW_ENTRY = "select entryID, timeOfEntry from Entries order by timeOfEntry desc, entryID desc limit 1";
 
 static const char* GET_ENTRIES_COUNT = "select Count(*) from Entries";
 
 static const char* DELETE_ENTRY_DATA = "delete from EntryData where entryID=?";
 static const char* DELETE_ENTRY = "delete from Entries where entryID=?";
 
+static const char* BEGIN_TRANSACTION = "begin transaction";
+static const char* COMMIT_TRANSACTION = "commit transaction";
+static const char* ROLLBACK_TRANSACTION = "rollback transaction";
+
 static char*
 copyStringInternal(const char* string)
 {
@@ -96,15 +159,76 @@ copyStringInternal(const char* string)
     return newString;
 }
 
+static int
+getSchemaVersion(sqlite3* db)
+{
+    sqlite3_stmt* stmt = NULL;
+
+    int version = -1;
+
+    if (sqlite3_prepare_v2(db, GET_SCHEMA_VERSION, -1, &stmt, NULL) == SQLITE_OK) {
+        if (sqlite3_step(stmt) == SQLITE_ROW)
+            version = sqlite3_column_int(stmt, 0);
+    }
+
+    sqlite3_finalize(stmt);
+
+    return version;
+}
+
+/* create the tables and indexes of a new database or add the indexes to a database of an older version */
+static bool
+createOrUpgradeSchema(sqlite3* db)
+{
+    int version = getSchemaVersion(db);
+
+    if (version == SQLITE_LOG_STORAGE_SCHEMA_VERSION)
+        return true;
+
+    if ((version < 0) || (version > SQLITE_LOG_STORAGE_SCHEMA_VERSION)) {
+        if (DEBUG_LOG_STORAGE_DRIVER)
+            printf("LOG_STORAGE_DRIVER: sqlite - unsupported schema version %i!\n", version);
+
+        return false;
+    }
+
+    if (DEBUG_LOG_STORAGE_DRIVER)
+        printf("LOG_STORAGE_DRIVER: sqlite - upgrade schema from version %i to %i\n", version, SQLITE_LOG_STORAGE_SCHEMA_VERSION);
+
+    const char* statements[] = {
+        BEGIN_TRANSACTION,
+        CREATE_TABLE_ENTRYS,
+        CREATE_TABLE_ENTRY_DATA,
+        CREATE_INDEX_ENTRIES_TIME,
+        CREATE_INDEX_ENTRY_DATA_ID,
+        SET_SCHEMA_VERSION,
+        COMMIT_TRANSACTION
+    };
+
+    int i;
+
+    for (i = 0; i < (int) (sizeof(statements) / sizeof(statements[0])); i++) {
+        if (sqlite3_exec(db, statements[i], NULL, NULL, NULL) != SQLITE_OK) {
+            sqlite3_exec(db, ROLLBACK_TRANSACTION, NULL, NULL, NULL);
+            return false;
+        }
+    }
+
+    return true;
+}
+
 LogStorage
 SqliteLogStorage_createInstance(const char* filename)
 {
 
     sqlite3* db = NULL;
     sqlite3_stmt* insertEntryStmt = NULL;
+    sqlite3_stmt* insertEntryWithIdStmt = NULL;
     sqlite3_stmt* insertEntryDataStmt = NULL;
     sqlite3_stmt* getEntriesWithRange = NULL;
     sqlite3_stmt* getEntriesAfter = NULL;
+    sqlite3_stmt* getCursorEntriesByTime = NULL;
+    sqlite3_stmt* getCursorEntriesAfter = NULL;
     sqlite3_stmt* getEntryData = NULL;
     sqlite3_stmt* getOldEntry = NULL;
     sqlite3_stmt* getNewEntry = NULL;
@@ -112,22 +236,19 @@ SqliteLogStorage_createInstance(const char* filename)
     sqlite3_stmt* deleteEntryData = NULL;
     sqlite3_stmt* deleteEntry = NULL;
 
-    char *zErrMsg = 0;
-
     int rc = sqlite3_open(filename, &db);
 
     if (rc != SQLITE_OK)
        goto exit_with_error;
 
-    rc = sqlite3_exec(db, CREATE_TABLE_ENTRYS, NULL, 0, &zErrMsg);
-    if (rc != SQLITE_OK)
+    if (createOrUpgradeSchema(db) == false)
         goto exit_with_error;
 
-    rc = sqlite3_exec(db, CREATE_TABLE_ENTRY_DATA, NULL, 0, &zErrMsg);
+    rc = sqlite3_prepare(db, INSERT_ENTRY, -1, &insertEntryStmt, NULL);
     if (rc != SQLITE_OK)
         goto exit_with_error;
 
-    rc = sqlite3_prepare(db, INSERT_ENTRY, -1, &insertEntryStmt, NULL);
+    rc = sqlite3_prepare_v2(db, INSERT_ENTRY_WITH_ID, -1, &insertEntryWithIdStmt, NULL);
     if (rc != SQLITE_OK)
         goto exit_with_error;
 
@@ -143,6 +264,14 @@ SqliteLogStorage_createInstance(const char* filename)
     if (rc != SQLITE_OK)
         goto exit_with_error;
 
+    rc = sqlite3_prepare_v2(db, GET_CURSOR_ENTRIES_BY_TIME, -1, &getCursorEntriesByTime, NULL);
+    if (rc != SQLITE_OK)
+        goto exit_with_error;
+
+    rc = sqlite3_prepare_v2(db, GET_CURSOR_ENTRIES_AFTER, -1, &getCursorEntriesAfter, NULL);
+    if (rc != SQLITE_OK)
+        goto exit_with_error;
+
     rc = sqlite3_prepare_v2(db, GET_ENTRY_DATA, -1, &getEntryData, NULL);
     if (rc != SQLITE_OK)
         goto exit_with_error;
@@ -174,15 +303,19 @@ SqliteLogStorage_createInstance(const char* filename)
     instanceData->filename = copyStringInternal(filename);
     instanceData->db = db;
     instanceData->insertEntryStmt = insertEntryStmt;
+    instanceData->insertEntryWithIdStmt = insertEntryWithIdStmt;
     instanceData->insertEntryDataStmt = insertEntryDataStmt;
     instanceData->getEntriesWithRange = getEntriesWithRange;
     instanceData->getEntriesAfter = getEntriesAfter;
+    instanceData->getCursorEntriesByTime = getCursorEntriesByTime;
+    instanceData->getCursorEntriesAfter = getCursorEntriesAfter;
     instanceData->getEntryData = getEntryData;
     instanceData->getOldEntry = getOldEntry;
     instanceData->getNewEntry = getNewEntry;
     instanceData->getEntriesCount = getEntriesCount;
     instanceData->deleteEntryData = deleteEntryData;
     instanceData->deleteEntry = deleteEntry;
+    instanceData->entryCount = -1;
 
     self->instanceData = (void*) instanceData;
 
@@ -192,6 +325,12 @@ SqliteLogStorage_createInstance(const char* filename)
     self->getEntriesAfter = SqliteLogStorage_getEntriesAfter;
     self->getOldestAndNewestEntries = SqliteLogStorage_getOldestAndNewestEntries;
     self->destroy = SqliteLogStorage_destroy;
+    self->addEntryWithID = SqliteLogStorage_addEntryWithID;
+    self->beginTransaction = SqliteLogStorage_beginTransaction;
+    self->commitTransaction = SqliteLogStorage_commitTransaction;
+    self->openCursor = SqliteLogStorage_openCursor;
+    self->readCursor = SqliteLogStorage_readCursor;
+    self->closeCursor = SqliteLogStorage_closeCursor;
     self->maxLogEntries = -1;
 
     return self;
@@ -239,6 +378,13 @@ deleteOldestEntry(SqliteLogStorage* self)
         if (rc != SQLITE_DONE)
             goto exit_with_error;
 
+        if (self->entryCount > 0)
+            self->entryCount--;
+
+        self->validOldEntry = false;
+
+        if (self->entryCount == 0)
+            self->validNewEntry = false;
     }
     else
         goto exit_with_error;
@@ -255,6 +401,9 @@ exit_with_error:
 static int
 getEntriesCount(SqliteLogStorage* self)
 {
+    if (self->entryCount >= 0)
+        return self->entryCount;
+
     int rc;
 
     rc = sqlite3_reset(self->getEntriesCount);
@@ -264,9 +413,12 @@ getEntriesCount(SqliteLogStorage* self)
 
     rc = sqlite3_step(self->getEntriesCount);
 
-    int entryCount = sqlite3_column_int(self->getEntriesCount, 0);
+    if (rc != SQLITE_ROW)
+        goto exit_with_error;
+
+    self->entryCount = sqlite3_column_int(self->getEntriesCount, 0);
 
-    return entryCount;
+    return self->entryCount;
 
 exit_with_error:
     if (DEBUG_LOG_STORAGE_DRIVER)
@@ -275,6 +427,42 @@ exit_with_error:
     return -1;
 }
 
+static void
+invalidateStatus(SqliteLogStorage* self)
+{
+    self->entryCount = -1;
+    self->validOldEntry = false;
+    self->validNewEntry = false;
+}
+
+static void
+updateStatusForNewEntry(SqliteLogStorage* self, uint64_t entryID, uint64_t timestamp)
+{
+    if (self->entryCount >= 0)
+        self->entryCount++;
+
+    if (self->entryCount == 1) {
+        self->oldEntryID = entryID;
+        self->oldEntryTime = timestamp;
+        self->validOldEntry = true;
+        self->newEntryID = entryID;
+        self->newEntryTime = timestamp;
+        self->validNewEntry = true;
+        return;
+    }
+
+    /* the new entry has the highest entryID */
+    if (self->validNewEntry && (timestamp >= self->newEntryTime)) {
+        self->newEntryID = entryID;
+        self->newEntryTime = timestamp;
+    }
+
+    if (self->validOldEntry && (timestamp < self->oldEntryTime)) {
+        self->oldEntryID = entryID;
+        self->oldEntryTime = timestamp;
+    }
+}
+
 static void
 trimToMaxEntries(SqliteLogStorage* self, int maxEntries)
 {
@@ -316,6 +504,8 @@ SqliteLogStorage_addEntry(LogStorage self, uint64_t timestamp)
     if (rc != SQLITE_OK)
         goto exit_with_error;
 
+    updateStatusForNewEntry(instanceData, id, timestamp);
+
     if (self->maxLogEntries > 0) {
         if (getEntriesCount(instanceData) > self->maxLogEntries)
             trimToMaxEntries(instanceData, self->maxLogEntries);
@@ -330,6 +520,88 @@ exit_with_error:
     return 0;
 }
 
+static bool
+SqliteLogStorage_addEntryWithID(LogStorage self, uint64_t entryID, uint64_t timestamp)
+{
+    if (DEBUG_LOG_STORAGE_DRIVER)
+        printf("LOG_STORAGE_DRIVER: sqlite - add entry with ID = %lu\n", entryID);
+
+    SqliteLogStorage* instanceData = (SqliteLogStorage*) (self->instanceData);
+
+    int rc;
+
+    rc = sqlite3_bind_int64(instanceData->insertEntryWithIdStmt, 1, (sqlite_int64) entryID);
+
+    if (rc != SQLITE_OK)
+        goto exit_with_error;
+
+    rc = sqlite3_bind_int64(instanceData->insertEntryWithIdStmt, 2, (sqlite_int64) timestamp);
+
+    if (rc != SQLITE_OK)
+        goto exit_with_error;
+
+    rc = sqlite3_step(instanceData->insertEntryWithIdStmt);
+
+    sqlite3_reset(instanceData->insertEntryWithIdStmt);
+
+    if (rc != SQLITE_DONE)
+        goto exit_with_error;
+
+    updateStatusForNewEntry(instanceData, entryID, timestamp);
+
+    if (self->maxLogEntries > 0) {
+        if (getEntriesCount(instanceData) > self->maxLogEntries)
+            trimToMaxEntries(instanceData, self->maxLogEntries);
+    }
+
+    return true;
+
+exit_with_error:
+    if (DEBUG_LOG_STORAGE_DRIVER)
+        printf("LOG_STORAGE_DRIVER: sqlite - failed to add entry to log (rc=%i)!\n", rc);
+
+    return false;
+}
+
+static bool
+SqliteLogStorage_beginTransaction(LogStorage self)
+{
+    SqliteLogStorage* instanceData = (SqliteLogStorage*) (self->instanceData);
+
+    int rc = sqlite3_exec(instanceData->db, BEGIN_TRANSACTION, NULL, NULL, NULL);
+
+    if (rc != SQLITE_OK) {
+        if (DEBUG_LOG_STORAGE_DRIVER)
+            printf("LOG_STORAGE_DRIVER: sqlite - failed to begin transaction (rc=%i)!\n", rc);
+
+        return false;
+    }
+
+    return true;
+}
+
+static bool
+SqliteLogStorage_commitTransaction(LogStorage self)
+{
+    SqliteLogStorage* instanceData = (SqliteLogStorage*) (self->instanceData);
+
+    int rc = sqlite3_exec(instanceData->db, COMMIT_TRANSACTION, NULL, NULL, NULL);
+
+    if (rc != SQLITE_OK) {
+        if (DEBUG_LOG_STORAGE_DRIVER)
+            printf("LOG_STORAGE_DRIVER: sqlite - failed to commit transaction (rc=%i)!\n", rc);
+
+        sqlite3_exec(instanceData->db, ROLLBACK_TRANSACTION, NULL, NULL, NULL);
+
+        /* the in-memory status may contain entries of the failed transaction */
+        invalidateStatus(instanceData);
+
+        return false;
+    }
+
+    return true;
+}
+
 static bool
 SqliteLogStorage_addEntryData(LogStorage self, uint64_t entryID, const char* dataRef, uint8_t* data, int dataSize, uint8_t reasonCode)
 {
@@ -376,7 +648,8 @@ exit_with_error:
     return false;
 }
 
-static void
+/* returns false when the callback aborted the operation */
+static bool
 getEntryData(LogStorage self, uint64_t entryID, LogEntryDataCallback entryDataCallback, void* parameter)
 {
     SqliteLogStorage* instanceData = (SqliteLogStorage*) (self->instanceData);
@@ -418,6 +691,8 @@ getEntryData(LogStorage self, uint64_t entryID, LogEntryDataCallback entryDataCa
     if (rc != SQLITE_OK)
         if (DEBUG_LOG_STORAGE_DRIVER)
             printf("LOG_STORAGE_DRIVER: sqlite - getEntryData reset rc:%i\n", rc);
+
+    return sendFinalEvent;
 }
 
 static bool
@@ -455,7 +730,11 @@ SqliteLogStorage_getEntries(LogStorage self, uint64_t startingTime, uint64_t end
 
         }
 
-        getEntryData(self, entryID, entryDataCallback, parameter);
+        /* stop reading as soon as the receiver is full (e.g. the MMS PDU of the journal service) */
+        if (getEntryData(self, entryID, entryDataCallback, parameter) == false) {
+            sendFinalEvent = false;
+            break;
+        }
     }
 
     if (sendFinalEvent)
@@ -476,45 +755,59 @@ static bool
 SqliteLogStorage_getOldestAndNewestEntries(LogStorage self, uint64_t* newEntry, uint64_t* newEntryTime,
         uint64_t* oldEntry, uint64_t* oldEntryTime)
 {
-    bool validOldEntry = false;
-    bool validNewEntry = false;
-
     SqliteLogStorage* instanceData = (SqliteLogStorage*) (self->instanceData);
 
     int rc;
 
     /* Get oldest entry */
-    sqlite3_reset(instanceData->getOldEntry);
+    if (instanceData->validOldEntry == false) {
+        sqlite3_reset(instanceData->getOldEntry);
 
-    rc = sqlite3_step(instanceData->getOldEntry);
+        rc = sqlite3_step(instanceData->getOldEntry);
 
-    if (rc == SQLITE_ROW) {
-        *oldEntry = sqlite3_column_int64(instanceData->getOldEntry, 0);
-        *oldEntryTime = sqlite3_column_int64(instanceData->getOldEntry, 1);
-        validNewEntry = true;
+        if (rc == SQLITE_ROW) {
+            instanceData->oldEntryID = sqlite3_column_int64(instanceData->getOldEntry, 0);
+            instanceData->oldEntryTime = sqlite3_column_int64(instanceData->getOldEntry, 1);
+            instanceData->validOldEntry = true;
+        }
+
+        sqlite3_reset(instanceData->getOldEntry);
+    }
+
+    /* Get newest entry */
+    if (instanceData->validNewEntry == false) {
+        sqlite3_reset(instanceData->getNewEntry);
+
+        rc = sqlite3_step(instanceData->getNewEntry);
+
+        if (rc == SQLITE_ROW) {
+            instanceData->newEntryID = sqlite3_column_int64(instanceData->getNewEntry, 0);
+            instanceData->newEntryTime = sqlite3_column_int64(instanceData->getNewEntry, 1);
+            instanceData->validNewEntry = true;
+        }
+
+        sqlite3_reset(instanceData->getNewEntry);
+    }
+
+    if (instanceData->validOldEntry) {
+        *oldEntry = instanceData->oldEntryID;
+        *oldEntryTime = instanceData->oldEntryTime;
     }
     else {
         *oldEntry = 0;
         *oldEntryTime = 0;
     }
 
-
-    /* Get newest entry */
-    sqlite3_reset(instanceData->getNewEntry);
-
-    rc = sqlite3_step(instanceData->getNewEntry);
-
-    if (rc == SQLITE_ROW) {
-        *newEntry = sqlite3_column_int64(instanceData->getNewEntry, 0);
-        *newEntryTime = sqlite3_column_int64(instanceData->getNewEntry, 1);
-        validOldEntry = true;
+    if (instanceData->validNewEntry) {
+        *newEntry = instanceData->newEntryID;
+        *newEntryTime = instanceData->newEntryTime;
     }
     else {
         *newEntry = 0;
         *newEntryTime = 0;
     }
 
-    return (validOldEntry && validNewEntry);
+    return (instanceData->validOldEntry && instanceData->validNewEntry);
 }
 
 static bool
@@ -545,7 +838,11 @@ SqliteLogStorage_getEntriesAfter(LogStorage self, uint64_t startingTime, uint64_
             }
         }
 
-        getEntryData(self, entryID, entryDataCallback, parameter);
+        /* stop reading as soon as the receiver is full (e.g. the MMS PDU of the journal service) */
+        if (getEntryData(self, entryID, entryDataCallback, parameter) == false) {
+            sendFinalEvent = false;
+            break;
+        }
     }
 
     if (sendFinalEvent)
@@ -561,15 +858,126 @@ SqliteLogStorage_getEntriesAfter(LogStorage self, uint64_t startingTime, uint64_
     return true;
 }
 
+static void*
+SqliteLogStorage_openCursor(LogStorage self, uint64_t startingTime, uint64_t endingTime, uint64_t entryID)
+{
+    (void)self;
+
+    SqliteLogCursor* cursor = (SqliteLogCursor*) calloc(1, sizeof(SqliteLogCursor));
+
+    if (cursor) {
+        /* sqlite integers are signed */
+        if (endingTime > INT64_MAX)
+            endingTime = INT64_MAX;
+
+        cursor->endingTime = endingTime;
+
+        if (entryID == 0) {
+            cursor->byTime = true;
+            cursor->lastTime = startingTime;
+            cursor->lastEntryID = -1;
+        }
+        else {
+            cursor->byTime = false;
+            cursor->lastEntryID = (int64_t) entryID;
+        }
+    }
+
+    return cursor;
+}
+
+static bool
+SqliteLogStorage_readCursor(LogStorage self, void* cursor,
+        LogEntryCallback entryCallback, LogEntryDataCallback entryDataCallback, void* parameter)
+{
+    SqliteLogStorage* instanceData = (SqliteLogStorage*) (self->instanceData);
+    SqliteLogCursor* logCursor = (SqliteLogCursor*) cursor;
+
+    sqlite3_stmt* stmt;
+
+    int rc;
+
+    if (logCursor->byTime) {
+        stmt = instanceData->getCursorEntriesByTime;
+
+        rc = sqlite3_bind_int64(stmt, 1, logCursor->lastTime);
+
+        if (rc == SQLITE_OK)
+            rc = sqlite3_bind_int64(stmt, 2, logCursor->lastEntryID);
+
+        if (rc == SQLITE_OK)
+            rc = sqlite3_bind_int64(stmt, 3, logCursor->endingTime);
+    }
+    else {
+        stmt = instanceData->getCursorEntriesAfter;
+
+        rc = sqlite3_bind_int64(stmt, 1, logCursor->lastEntryID);
+
+        if (rc == SQLITE_OK)
+            rc = sqlite3_bind_int64(stmt, 2, logCursor->endingTime);
+    }
+
+    if (rc != SQLITE_OK)
+        if (DEBUG_LOG_STORAGE_DRIVER)
+            printf("LOG_STORAGE_DRIVER: sqlite - SqliteLogStorage_readCursor bind rc:%i\n", rc);
+
+    bool sendFinalEvent = true;
+
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+
+        uint64_t entryID = sqlite3_column_int64(stmt, 0);
+        uint64_t timestamp = sqlite3_column_int64(stmt, 1);
+
+        if (entryCallback != NULL) {
+            if (entryCallback(parameter, timestamp, entryID, true) == false) {
+                sendFinalEvent = false;
+                break;
+            }
+        }
+
+        if (getEntryData(self, entryID, entryDataCallback, parameter) == false) {
+            sendFinalEvent = false;
+            break;
+        }
+
+        /* entry is complete -> the next read starts after this entry */
+        logCursor->lastTime = timestamp;
+        logCursor->lastEntryID = (int64_t) entryID;
+    }
+
+    if (sendFinalEvent)
+        if (entryCallback != NULL)
+            entryCallback(parameter, 0, 0, false);
+
+    rc = sqlite3_reset(stmt);
+
+    if (rc != SQLITE_OK)
+        if (DEBUG_LOG_STORAGE_DRIVER)
+            printf("LOG_STORAGE_DRIVER: sqlite - SqliteLogStorage_readCursor reset rc:%i\n", rc);
+
+    return true;
+}
+
+static void
+SqliteLogStorage_closeCursor(LogStorage self, void* cursor)
+{
+    (void)self;
+
+    free(cursor);
+}
+
 static void
 SqliteLogStorage_destroy(LogStorage self)
 {
     SqliteLogStorage* instanceData = (SqliteLogStorage*) self->instanceData;
 
     sqlite3_finalize(instanceData->insertEntryStmt);
+    sqlite3_finalize(instanceData->insertEntryWithIdStmt);
     sqlite3_finalize(instanceData->insertEntryDataStmt);
     sqlite3_finalize(instanceData->getEntriesWithRange);
     sqlite3_finalize(instanceData->getEntriesAfter);
+    sqlite3_finalize(instanceData->getCursorEntriesByTime);
+    sqlite3_finalize(instanceData->getCursorEntriesAfter);
     sqlite3_finalize(instanceData->getEntryData);
     sqlite3_finalize(instanceData->getOldEntry);
     sqlite3_finalize(instanceData->getNewEntry);
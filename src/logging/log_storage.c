@@ -21,6 +21,7 @@
  *  See COPYING file for the complete license text.
  */
 
+#include "libiec61850_platform_includes.h"
 #include "logging_api.h"
 
 
@@ -76,3 +77,152 @@ LogStorage_getOldestAndNewestEntries(LogStorage self, uint64_t* newEntry, uint64
     return self->getOldestAndNewestEntries(self, newEntry, newEntryTime, oldEntry, oldEntryTime);
 }
 
+struct sLogStorageCursor {
+    LogStorage storage;
+
+    void* driverCursor; /* cursor of the storage implementation (NULL for the generic cursor) */
+
+    /* generic cursor */
+    uint64_t startingTime;
+    uint64_t endingTime;
+    uint64_t entryID; /* last entry that has been read completely */
+    bool afterEntry;
+    int readEntries;
+
+    /* state of the current read operation */
+    LogEntryCallback entryCallback;
+    LogEntryDataCallback entryDataCallback;
+    void* parameter;
+    int entriesToSkip;
+    bool entrySelected;
+    uint64_t currentEntryID;
+};
+
+static void
+cursorEntryCompleted(LogStorageCursor self)
+{
+    if (self->entrySelected) {
+        self->entryID = self->currentEntryID;
+        self->readEntries++;
+        self->entrySelected = false;
+    }
+}
+
+static bool
+cursorEntryCallback(void* parameter, uint64_t timestamp, uint64_t entryID, bool moreFollow)
+{
+    LogStorageCursor self = (LogStorageCursor) parameter;
+
+    cursorEntryCompleted(self);
+
+    if (moreFollow == false) {
+        if (self->entryCallback)
+            return self->entryCallback(self->parameter, timestamp, entryID, false);
+
+        return true;
+    }
+
+    /* skip the entries that have been read by previous calls */
+    if (self->entriesToSkip > 0) {
+        self->entriesToSkip--;
+        return true;
+    }
+
+    if (self->afterEntry && (timestamp > self->endingTime))
+        return true;
+
+    if (self->entryCallback) {
+        if (self->entryCallback(self->parameter, timestamp, entryID, true) == false)
+            return false;
+    }
+
+    self->entrySelected = true;
+    self->currentEntryID = entryID;
+
+    return true;
+}
+
+static bool
+cursorEntryDataCallback(void* parameter, const char* dataRef, uint8_t* data, int dataSize, uint8_t reasonCode, bool moreFollow)
+{
+    LogStorageCursor self = (LogStorageCursor) parameter;
+
+    if (self->entrySelected == false)
+        return true;
+
+    if (self->entryDataCallback) {
+        if (self->entryDataCallback(self->parameter, dataRef, data, dataSize, reasonCode, moreFollow) == false) {
+            self->entrySelected = false;
+            return false;
+        }
+    }
+
+    if (moreFollow == false)
+        cursorEntryCompleted(self);
+
+    return true;
+}
+
+LogStorageCursor
+LogStorage_openCursor(LogStorage self, uint64_t startingTime, uint64_t endingTime, uint64_t entryID)
+{
+    LogStorageCursor cursor = (LogStorageCursor) GLOBAL_CALLOC(1, sizeof(struct sLogStorageCursor));
+
+    if (cursor) {
+        cursor->storage = self;
+
+        if (self->openCursor) {
+            cursor->driverCursor = self->openCursor(self, startingTime, endingTime, entryID);
+
+            if (cursor->driverCursor == NULL) {
+                GLOBAL_FREEMEM(cursor);
+                cursor = NULL;
+            }
+        }
+        else {
+            cursor->startingTime = startingTime;
+            cursor->endingTime = endingTime;
+            cursor->entryID = entryID;
+            cursor->afterEntry = (entryID != 0);
+        }
+    }
+
+    return cursor;
+}
+
+bool
+LogStorageCursor_read(LogStorageCursor self, LogEntryCallback entryCallback, LogEntryDataCallback entryDataCallback,
+        void* parameter)
+{
+    LogStorage storage = self->storage;
+
+    if (self->driverCursor)
+        return storage->readCursor(storage, self->driverCursor, entryCallback, entryDataCallback, parameter);
+
+    self->entryCallback = entryCallback;
+    self->entryDataCallback = entryDataCallback;
+    self->parameter = parameter;
+    self->entrySelected = false;
+
+    if (self->afterEntry) {
+        self->entriesToSkip = 0;
+
+        return storage->getEntriesAfter(storage, self->startingTime, self->entryID,
+                cursorEntryCallback, cursorEntryDataCallback, self);
+    }
+    else {
+        self->entriesToSkip = self->readEntries;
+
+        return storage->getEntries(storage, self->startingTime, self->endingTime,
+                cursorEntryCallback, cursorEntryDataCallback, self);
+    }
+}
+
+void
+LogStorageCursor_close(LogStorageCursor self)
+{
+    if (self->driverCursor)
+        self->storage->closeCursor(self->storage, self->driverCursor);
+
+    GLOBAL_FREEMEM(self);
+}
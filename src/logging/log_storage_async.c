@@ -0,0 +1,818 @@
+/*
+ *  log_storage_async.c
+ *
+ *  Asynchronous log writer - queues log entries and writes them in a background thread
+ *
+ *  This file is part of libIEC61850.
+ *
+ *  libIEC61850 is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  libIEC61850 is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with libIEC61850.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+#include "libiec61850_platform_includes.h"
+#include "stack_config.h"
+#include "logging_api.h"
+
+#include "hal_thread.h"
+#include "hal_time.h"
+
+#ifndef DEBUG_LOG_STORAGE_DRIVER
+#define DEBUG_LOG_STORAGE_DRIVER 0
+#endif
+
+#if (CONFIG_MMS_THREADLESS_STACK == 0)
+
+#define DEFAULT_MAX_ENTRIES_PER_TRANSACTION 256
+
+typedef enum {
+    QUEUED_ENTRY,
+    QUEUED_ENTRY_DATA
+} QueuedRecordType;
+
+typedef struct sQueuedRecord* QueuedRecord;
+
+struct sQueuedRecord
+{
+    QueuedRecord next;
+    QueuedRecordType type;
+    uint64_t entryID;
+    uint64_t timestamp;
+
+    /* only used by entry data records - dataRef and data are stored after the record */
+    char* dataRef;
+    uint8_t* data;
+    int dataSize;
+    uint8_t reasonCode;
+};
+
+typedef struct sAsyncLogStorage
+{
+    LogStorage storage;
+
+    AsyncLogStorageOverflowPolicy overflowPolicy;
+    int maxQueuedEntries;
+    int maxEntriesPerTransaction;
+    int batchDelayInMs;
+    bool flushOnDestroy;
+
+    Semaphore queueLock; /* protects the queue, the writer state, and the statistics */
+    QueuedRecord head;
+    QueuedRecord tail;
+    int queuedEntries; /* number of entry records in the queue */
+    uint64_t nextEntryID;
+    uint64_t lastDroppedEntryID;
+
+    Semaphore storageLock; /* serializes all access to the wrapped storage */
+
+    Thread thread;
+    bool running;
+    bool sleeping; /* writer thread waits for the wakeup semaphore */
+    Semaphore wakeup;
+
+    int blockedProducers; /* threads waiting for free queue space (ASYNC_LOG_STORAGE_BLOCK) */
+    Semaphore spaceAvailable;
+
+    AsyncLogStorageStatistics statistics;
+    uint64_t totalTransactionTime; /* in ns */
+} AsyncLogStorage;
+
+static void
+AsyncLogStorage_destroyInstance(LogStorage self);
+
+static AsyncLogStorage*
+getInstanceData(LogStorage self)
+{
+    if (self && (self->destroy == AsyncLogStorage_destroyInstance))
+        return (AsyncLogStorage*) self->instanceData;
+
+    if (DEBUG_LOG_STORAGE_DRIVER)
+        printf("LOG_STORAGE_DRIVER: async - not an asynchronous log writer instance!\n");
+
+    return NULL;
+}
+
+/* has to be called with queueLock */
+static void
+wakeupWriter(AsyncLogStorage* self)
+{
+    /* only one thread releases the semaphore for each wait of the writer thread */
+    if (self->sleeping) {
+        self->sleeping = false;
+        Semaphore_post(self->wakeup);
+    }
+}
+
+/* has to be called with queueLock */
+static void
+wakeupBlockedProducers(AsyncLogStorage* self)
+{
+    /* every blocked producer waits for exactly one post and checks the queue again */
+    while (self->blockedProducers > 0) {
+        self->blockedProducers--;
+        Semaphore_post(self->spaceAvailable);
+    }
+}
+
+/* has to be called with queueLock */
+static void
+appendRecord(AsyncLogStorage* self, QueuedRecord record)
+{
+    record->next = NULL;
+
+    if (self->tail)
+        self->tail->next = record;
+    else
+        self->head = record;
+
+    self->tail = record;
+}
+
+/*
+ * Remove the oldest entry and the following data records of this entry from the queue.
+ * Data records of entries that are already written stay in the queue.
+ *
+ * Has to be called with queueLock
+ */
+static void
+dropOldestEntry(AsyncLogStorage* self)
+{
+    QueuedRecord* position = &(self->head);
+    QueuedRecord last = NULL;
+
+    uint64_t droppedEntryID = 0;
+
+    while (*position) {
+        QueuedRecord record = *position;
+
+        bool drop = false;
+
+        if (record->type == QUEUED_ENTRY) {
+            if (droppedEntryID != 0)
+                break;
+
+            droppedEntryID = record->entryID;
+            drop = true;
+        }
+        else if ((droppedEntryID != 0) && (record->entryID == droppedEntryID)) {
+            drop = true;
+        }
+
+        if (drop) {
+            *position = record->next;
+            GLOBAL_FREEMEM(record);
+        }
+        else {
+            last = record;
+            position = &(record->next);
+        }
+    }
+
+    if (*position == NULL)
+        self->tail = last;
+
+    if (droppedEntryID != 0) {
+        self->queuedEntries--;
+        self->lastDroppedEntryID = droppedEntryID;
+        self->statistics.droppedEntries++;
+    }
+}
+
+/* has to be called with queueLock */
+static QueuedRecord
+takeRecords(AsyncLogStorage* self, int maxEntries, int* numberOfEntries)
+{
+    QueuedRecord first = self->head;
+    QueuedRecord last = NULL;
+    QueuedRecord record = first;
+
+    int entries = 0;
+
+    while (record) {
+        if (record->type == QUEUED_ENTRY) {
+            if (entries == maxEntries)
+                break;
+
+            entries++;
+        }
+
+        last = record;
+        record = record->next;
+    }
+
+    if (last == NULL)
+        return NULL;
+
+    self->head = last->next;
+
+    if (self->head == NULL)
+        self->tail = NULL;
+
+    last->next = NULL;
+
+    self->queuedEntries -= entries;
+
+    if (entries > 0)
+        wakeupBlockedProducers(self);
+
+    *numberOfEntries = entries;
+
+    return first;
+}
+
+/*
+ * Write the oldest records of the queue in a single transaction. Has to be called with storageLock.
+ *
+ * Returns the number of records taken from the queue
+ */
+static int
+writeQueuedRecords(LogStorage wrapper, bool* success)
+{
+    AsyncLogStorage* self = (AsyncLogStorage*) wrapper->instanceData;
+    LogStorage storage = self->storage;
+
+    int numberOfEntries = 0;
+
+    Semaphore_wait(self->queueLock);
+    QueuedRecord records = takeRecords(self, self->maxEntriesPerTransaction, &numberOfEntries);
+    Semaphore_post(self->queueLock);
+
+    if (records == NULL)
+        return 0;
+
+    storage->maxLogEntries = wrapper->maxLogEntries;
+
+    uint64_t startTime = Hal_getTimeInNs();
+
+    bool transaction = false;
+
+    if (storage->beginTransaction && storage->commitTransaction)
+        transaction = storage->beginTransaction(storage);
+
+    int numberOfRecords = 0;
+    int failedEntries = 0;
+    uint64_t failedEntryID = 0;
+
+    while (records) {
+        QueuedRecord record = records;
+        records = record->next;
+
+        if (record->type == QUEUED_ENTRY) {
+            if (storage->addEntryWithID(storage, record->entryID, record->timestamp) == false) {
+                failedEntryID = record->entryID;
+                failedEntries++;
+            }
+        }
+        else {
+            /* data of an entry that could not be written is ignored */
+            if (record->entryID != failedEntryID)
+                storage->addEntryData(storage, record->entryID, record->dataRef, record->data, record->dataSize, record->reasonCode);
+        }
+
+        GLOBAL_FREEMEM(record);
+
+        numberOfRecords++;
+    }
+
+    if (transaction) {
+        if (storage->commitTransaction(storage) == false)
+            failedEntries = numberOfEntries;
+    }
+
+    uint64_t transactionTime = Hal_getTimeInNs() - startTime;
+
+    if (failedEntries > 0) {
+        *success = false;
+
+        if (DEBUG_LOG_STORAGE_DRIVER)
+            printf("LOG_STORAGE_DRIVER: async - failed to write %i of %i entries!\n", failedEntries, numberOfEntries);
+    }
+
+    Semaphore_wait(self->queueLock);
+
+    self->statistics.writtenEntries += (numberOfEntries - failedEntries);
+    self->statistics.failedEntries += failedEntries;
+    self->statistics.transactions++;
+
+    if ((uint32_t) numberOfEntries > self->statistics.maxEntriesPerTransaction)
+        self->statistics.maxEntriesPerTransaction = (uint32_t) numberOfEntries;
+
+    if (transactionTime / 1000 > self->statistics.maxTransactionTimeInUs)
+        self->statistics.maxTransactionTimeInUs = transactionTime / 1000;
+
+    self->totalTransactionTime += transactionTime;
+
+    Semaphore_post(self->queueLock);
+
+    return numberOfRecords;
+}
+
+/* has to be called with storageLock */
+static bool
+writeAllQueuedRecords(LogStorage self)
+{
+    bool success = true;
+
+    while (writeQueuedRecords(self, &success) > 0);
+
+    return success;
+}
+
+static bool
+flushQueue(LogStorage self)
+{
+    AsyncLogStorage* instanceData = (AsyncLogStorage*) self->instanceData;
+
+    Semaphore_wait(instanceData->storageLock);
+
+    bool success = writeAllQueuedRecords(self);
+
+    Semaphore_post(instanceData->storageLock);
+
+    return success;
+}
+
+static void*
+writerThread(void* parameter)
+{
+    LogStorage self = (LogStorage) parameter;
+    AsyncLogStorage* instanceData = (AsyncLogStorage*) self->instanceData;
+
+    while (true) {
+        Semaphore_wait(instanceData->queueLock);
+
+        if (instanceData->running == false) {
+            Semaphore_post(instanceData->queueLock);
+            break;
+        }
+
+        if (instanceData->head == NULL) {
+            instanceData->sleeping = true;
+            Semaphore_post(instanceData->queueLock);
+
+            Semaphore_wait(instanceData->wakeup);
+
+            continue;
+        }
+
+        int queuedEntries = instanceData->queuedEntries;
+
+        Semaphore_post(instanceData->queueLock);
+
+        /* wait for more entries to get larger transactions */
+        if ((instanceData->batchDelayInMs > 0) && (queuedEntries < instanceData->maxEntriesPerTransaction))
+            Thread_sleep(instanceData->batchDelayInMs);
+
+        bool success = true;
+
+        Semaphore_wait(instanceData->storageLock);
+
+        writeQueuedRecords(self, &success);
+
+        Semaphore_post(instanceData->storageLock);
+    }
+
+    return NULL;
+}
+
+static uint64_t
+AsyncLogStorage_addEntry(LogStorage self, uint64_t timestamp)
+{
+    AsyncLogStorage* instanceData = (AsyncLogStorage*) self->instanceData;
+
+    QueuedRecord record = (QueuedRecord) GLOBAL_CALLOC(1, sizeof(struct sQueuedRecord));
+
+    if (record == NULL)
+        return 0;
+
+    record->type = QUEUED_ENTRY;
+    record->timestamp = timestamp;
+
+    uint64_t blockedSince = 0;
+
+    Semaphore_wait(instanceData->queueLock);
+
+    while (instanceData->queuedEntries >= instanceData->maxQueuedEntries) {
+
+        if (instanceData->overflowPolicy == ASYNC_LOG_STORAGE_DROP_OLDEST) {
+            dropOldestEntry(instanceData);
+        }
+        else if ((instanceData->overflowPolicy == ASYNC_LOG_STORAGE_BLOCK) && instanceData->running) {
+            if (blockedSince == 0)
+                blockedSince = Hal_getTimeInNs();
+
+            wakeupWriter(instanceData);
+
+            instanceData->blockedProducers++;
+
+            Semaphore_post(instanceData->queueLock);
+
+            Semaphore_wait(instanceData->spaceAvailable);
+
+            Semaphore_wait(instanceData->queueLock);
+        }
+        else {
+            instanceData->statistics.droppedEntries++;
+
+            Semaphore_post(instanceData->queueLock);
+
+            GLOBAL_FREEMEM(record);
+
+            if (DEBUG_LOG_STORAGE_DRIVER)
+                printf("LOG_STORAGE_DRIVER: async - queue full -> drop new entry\n");
+
+            return 0;
+        }
+    }
+
+    if (blockedSince != 0) {
+        uint64_t blockedTime = (Hal_getTimeInNs() - blockedSince) / 1000;
+
+        if (blockedTime > instanceData->statistics.maxBlockedTimeInUs)
+            instanceData->statistics.maxBlockedTimeInUs = blockedTime;
+    }
+
+    uint64_t entryID = instanceData->nextEntryID++;
+
+    record->entryID = entryID;
+
+    appendRecord(instanceData, record);
+
+    instanceData->queuedEntries++;
+    instanceData->statistics.queuedEntries++;
+
+    if ((uint32_t) instanceData->queuedEntries > instanceData->statistics.maxQueueDepth)
+        instanceData->statistics.maxQueueDepth = (uint32_t) instanceData->queuedEntries;
+
+    wakeupWriter(instanceData);
+
+    /* the record can be written and released by the writer thread as soon as the lock is released */
+    Semaphore_post(instanceData->queueLock);
+
+    return entryID;
+}
+
+static bool
+AsyncLogStorage_addEntryData(LogStorage self, uint64_t entryID, const char* dataRef, uint8_t* data, int dataSize, uint8_t reasonCode)
+{
+    AsyncLogStorage* instanceData = (AsyncLogStorage*) self->instanceData;
+
+    if (entryID == 0)
+        return false;
+
+    int dataRefSize = strlen(dataRef) + 1;
+
+    QueuedRecord record = (QueuedRecord) GLOBAL_MALLOC(sizeof(struct sQueuedRecord) + dataRefSize + dataSize);
+
+    if (record == NULL)
+        return false;
+
+    record->type = QUEUED_ENTRY_DATA;
+    record->entryID = entryID;
+    record->timestamp = 0;
+    record->dataRef = (char*) (record + 1);
+    record->data = (uint8_t*) (record->dataRef + dataRefSize);
+    record->dataSize = dataSize;
+    record->reasonCode = reasonCode;
+
+    memcpy(record->dataRef, dataRef, dataRefSize);
+    memcpy(record->data, data, dataSize);
+
+    Semaphore_wait(instanceData->queueLock);
+
+    /* the entry has been removed from the queue by the DROP_OLDEST policy */
+    if (entryID == instanceData->lastDroppedEntryID) {
+        Semaphore_post(instanceData->queueLock);
+
+        GLOBAL_FREEMEM(record);
+
+        return false;
+    }
+
+    appendRecord(instanceData, record);
+
+    wakeupWriter(instanceData);
+
+    Semaphore_post(instanceData->queueLock);
+
+    return true;
+}
+
+static bool
+AsyncLogStorage_getEntries(LogStorage self, uint64_t startingTime, uint64_t endingTime,
+        LogEntryCallback entryCallback, LogEntryDataCallback entryDataCallback, void* parameter)
+{
+    AsyncLogStorage* instanceData = (AsyncLogStorage*) self->instanceData;
+
+    Semaphore_wait(instanceData->storageLock);
+
+    writeAllQueuedRecords(self);
+
+    bool retVal = LogStorage_getEntries(instanceData->storage, startingTime, endingTime, entryCallback, entryDataCallback, parameter);
+
+    Semaphore_post(instanceData->storageLock);
+
+    return retVal;
+}
+
+static bool
+AsyncLogStorage_getEntriesAfter(LogStorage self, uint64_t startingTime, uint64_t entryID,
+        LogEntryCallback entryCallback, LogEntryDataCallback entryDataCallback, void* parameter)
+{
+    AsyncLogStorage* instanceData = (AsyncLogStorage*) self->instanceData;
+
+    Semaphore_wait(instanceData->storageLock);
+
+    writeAllQueuedRecords(self);
+
+    bool retVal = LogStorage_getEntriesAfter(instanceData->storage, startingTime, entryID, entryCallback, entryDataCallback, parameter);
+
+    Semaphore_post(instanceData->storageLock);
+
+    return retVal;
+}
+
+static void*
+AsyncLogStorage_openCursor(LogStorage self, uint64_t startingTime, uint64_t endingTime, uint64_t entryID)
+{
+    AsyncLogStorage* instanceData = (AsyncLogStorage*) self->instanceData;
+
+    Semaphore_wait(instanceData->storageLock);
+
+    LogStorageCursor cursor = LogStorage_openCursor(instanceData->storage, startingTime, endingTime, entryID);
+
+    Semaphore_post(instanceData->storageLock);
+
+    return (void*) cursor;
+}
+
+static bool
+AsyncLogStorage_readCursor(LogStorage self, void* cursor,
+        LogEntryCallback entryCallback, LogEntryDataCallback entryDataCallback, void* parameter)
+{
+    AsyncLogStorage* instanceData = (AsyncLogStorage*) self->instanceData;
+
+    Semaphore_wait(instanceData->storageLock);
+
+    writeAllQueuedRecords(self);
+
+    bool retVal = LogStorageCursor_read((LogStorageCursor) cursor, entryCallback, entryDataCallback, parameter);
+
+    Semaphore_post(instanceData->storageLock);
+
+    return retVal;
+}
+
+static void
+AsyncLogStorage_closeCursor(LogStorage self, void* cursor)
+{
+    AsyncLogStorage* instanceData = (AsyncLogStorage*) self->instanceData;
+
+    Semaphore_wait(instanceData->storageLock);
+
+    LogStorageCursor_close((LogStorageCursor) cursor);
+
+    Semaphore_post(instanceData->storageLock);
+}
+
+static bool
+AsyncLogStorage_getOldestAndNewestEntries(LogStorage self, uint64_t* newEntry, uint64_t* newEntryTime,
+        uint64_t* oldEntry, uint64_t* oldEntryTime)
+{
+    AsyncLogStorage* instanceData = (AsyncLogStorage*) self->instanceData;
+
+    Semaphore_wait(instanceData->storageLock);
+
+    writeAllQueuedRecords(self);
+
+    bool retVal = LogStorage_getOldestAndNewestEntries(instanceData->storage, newEntry, newEntryTime, oldEntry, oldEntryTime);
+
+    Semaphore_post(instanceData->storageLock);
+
+    return retVal;
+}
+
+static void
+AsyncLogStorage_destroyInstance(LogStorage self)
+{
+    AsyncLogStorage* instanceData = (AsyncLogStorage*) self->instanceData;
+
+    Semaphore_wait(instanceData->queueLock);
+    instanceData->running = false;
+    wakeupWriter(instanceData);
+    wakeupBlockedProducers(instanceData);
+    Semaphore_post(instanceData->queueLock);
+
+    if (instanceData->thread)
+        Thread_destroy(instanceData->thread);
+
+    if (instanceData->flushOnDestroy) {
+        flushQueue(self);
+    }
+    else {
+        while (instanceData->head) {
+            QueuedRecord record = instanceData->head;
+
+            instanceData->head = record->next;
+
+            if (record->type == QUEUED_ENTRY)
+                instanceData->statistics.droppedEntries++;
+
+            GLOBAL_FREEMEM(record);
+        }
+    }
+
+    LogStorage_destroy(instanceData->storage);
+
+    Semaphore_destroy(instanceData->spaceAvailable);
+    Semaphore_destroy(instanceData->wakeup);
+    Semaphore_destroy(instanceData->storageLock);
+    Semaphore_destroy(instanceData->queueLock);
+
+    GLOBAL_FREEMEM(instanceData);
+    GLOBAL_FREEMEM(self);
+}
+
+LogStorage
+AsyncLogStorage_create(LogStorage storage, int maxQueuedEntries, AsyncLogStorageOverflowPolicy overflowPolicy)
+{
+    if ((storage == NULL) || (storage->addEntryWithID == NULL)) {
+        if (DEBUG_LOG_STORAGE_DRIVER)
+            printf("LOG_STORAGE_DRIVER: async - storage doesn't support addEntryWithID!\n");
+
+        return NULL;
+    }
+
+    if (maxQueuedEntries < 1)
+        return NULL;
+
+    LogStorage self = (LogStorage) GLOBAL_CALLOC(1, sizeof(struct sLogStorage));
+
+    if (self == NULL)
+        return NULL;
+
+    AsyncLogStorage* instanceData = (AsyncLogStorage*) GLOBAL_CALLOC(1, sizeof(struct sAsyncLogStorage));
+
+    if (instanceData == NULL) {
+        GLOBAL_FREEMEM(self);
+        return NULL;
+    }
+
+    uint64_t newEntry = 0;
+    uint64_t newEntryTime = 0;
+    uint64_t oldEntry = 0;
+    uint64_t oldEntryTime = 0;
+
+    LogStorage_getOldestAndNewestEntries(storage, &newEntry, &newEntryTime, &oldEntry, &oldEntryTime);
+
+    instanceData->storage = storage;
+    instanceData->overflowPolicy = overflowPolicy;
+    instanceData->maxQueuedEntries = maxQueuedEntries;
+    instanceData->maxEntriesPerTransaction = DEFAULT_MAX_ENTRIES_PER_TRANSACTION;
+    instanceData->batchDelayInMs = 0;
+    instanceData->flushOnDestroy = true;
+    instanceData->nextEntryID = newEntry + 1;
+
+    instanceData->queueLock = Semaphore_create(1);
+    instanceData->storageLock = Semaphore_create(1);
+
+    instanceData->wakeup = Semaphore_create(1);
+    Semaphore_wait(instanceData->wakeup);
+
+    instanceData->spaceAvailable = Semaphore_create(1);
+    Semaphore_wait(instanceData->spaceAvailable);
+
+    self->instanceData = (void*) instanceData;
+
+    self->addEntry = AsyncLogStorage_addEntry;
+    self->addEntryData = AsyncLogStorage_addEntryData;
+    self->getEntries = AsyncLogStorage_getEntries;
+    self->getEntriesAfter = AsyncLogStorage_getEntriesAfter;
+    self->getOldestAndNewestEntries = AsyncLogStorage_getOldestAndNewestEntries;
+    self->destroy = AsyncLogStorage_destroyInstance;
+    self->openCursor = AsyncLogStorage_openCursor;
+    self->readCursor = AsyncLogStorage_readCursor;
+    self->closeCursor = AsyncLogStorage_closeCursor;
+    self->maxLogEntries = storage->maxLogEntries;
+
+    instanceData->running = true;
+
+    instanceData->thread = Thread_create(writerThread, self, false);
+
+    if (instanceData->thread)
+        Thread_start(instanceData->thread);
+
+    return self;
+}
+
+void
+AsyncLogStorage_setBatchParameters(LogStorage self, int maxEntriesPerTransaction, int batchDelayInMs)
+{
+    AsyncLogStorage* instanceData = getInstanceData(self);
+
+    if (instanceData) {
+        if (maxEntriesPerTransaction > 0)
+            instanceData->maxEntriesPerTransaction = maxEntriesPerTransaction;
+
+        if (batchDelayInMs >= 0)
+            instanceData->batchDelayInMs = batchDelayInMs;
+    }
+}
+
+void
+AsyncLogStorage_setFlushOnDestroy(LogStorage self, bool flushOnDestroy)
+{
+    AsyncLogStorage* instanceData = getInstanceData(self);
+
+    if (instanceData)
+        instanceData->flushOnDestroy = flushOnDestroy;
+}
+
+bool
+AsyncLogStorage_flush(LogStorage self)
+{
+    if (getInstanceData(self) == NULL)
+        return false;
+
+    return flushQueue(self);
+}
+
+void
+AsyncLogStorage_getStatistics(LogStorage self, AsyncLogStorageStatistics* statistics)
+{
+    AsyncLogStorage* instanceData = getInstanceData(self);
+
+    if (instanceData) {
+        Semaphore_wait(instanceData->queueLock);
+
+        *statistics = instanceData->statistics;
+
+        statistics->queueDepth = (uint32_t) instanceData->queuedEntries;
+
+        if (statistics->transactions > 0)
+            statistics->averageTransactionTimeInUs = (instanceData->totalTransactionTime / statistics->transactions) / 1000;
+        else
+            statistics->averageTransactionTimeInUs = 0;
+
+        Semaphore_post(instanceData->queueLock);
+    }
+    else {
+        memset(statistics, 0, sizeof(AsyncLogStorageStatistics));
+    }
+}
+
+#else /* (CONFIG_MMS_THREADLESS_STACK == 0) */
+
+LogStorage
+AsyncLogStorage_create(LogStorage storage, int maxQueuedEntries, AsyncLogStorageOverflowPolicy overflowPolicy)
+{
+    (void)storage;
+    (void)maxQueuedEntries;
+    (void)overflowPolicy;
+
+    return NULL;
+}
+
+void
+AsyncLogStorage_setBatchParameters(LogStorage self, int maxEntriesPerTransaction, int batchDelayInMs)
+{
+    (void)self;
+    (void)maxEntriesPerTransaction;
+    (void)batchDelayInMs;
+}
+
+void
+AsyncLogStorage_setFlushOnDestroy(LogStorage self, bool flushOnDestroy)
+{
+    (void)self;
+    (void)flushOnDestroy;
+}
+
+bool
+AsyncLogStorage_flush(LogStorage self)
+{
+    (void)self;
+
+    return false;
+}
+
+void
+AsyncLogStorage_getStatistics(LogStorage self, AsyncLogStorageStatistics* statistics)
+{
+    (void)self;
+
+    memset(statistics, 0, sizeof(AsyncLogStorageStatistics));
+}
+
+#endif /* (CONFIG_MMS_THREADLESS_STACK == 0) */
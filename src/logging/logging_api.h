@@ -95,6 +95,24 @@ struct sLogStorage {
             uint64_t* oldEntry, uint64_t* oldEntryTime);
 
     void (*destroy) (LogStorage self);
+
+    /* The following functions are optional and can be NULL when not supported by the implementation */
+
+    /* add an entry with an entryID provided by the caller (IDs have to be strictly increasing) */
+    bool (*addEntryWithID) (LogStorage self, uint64_t entryID, uint64_t timestamp);
+
+    /* group the following add operations into a single transaction */
+    bool (*beginTransaction) (LogStorage self);
+
+    bool (*commitTransaction) (LogStorage self);
+
+    /* resumable reads - the cursor keeps the read position between calls of readCursor (see LogStorage_openCursor) */
+    void* (*openCursor) (LogStorage self, uint64_t startingTime, uint64_t endingTime, uint64_t entryID);
+
+    bool (*readCursor) (LogStorage self, void* cursor,
+            LogEntryCallback entryCallback, LogEntryDataCallback entryDataCallback, void* parameter);
+
+    void (*closeCursor) (LogStorage self, void* cursor);
 };
 
 
@@ -194,6 +212,56 @@ LIB61850_API bool
 LogStorage_getOldestAndNewestEntries(LogStorage self, uint64_t* newEntry, uint64_t* newEntryTime,
         uint64_t* oldEntry, uint64_t* oldEntryTime);
 
+/** The LogStorageCursor object handle */
+typedef struct sLogStorageCursor* LogStorageCursor;
+
+/**
+ * \brief Open a cursor to read log entries with multiple calls of LogStorageCursor_read
+ *
+ * When entryID is 0 the cursor selects the log entries of the time range like LogStorage_getEntries.
+ * Otherwise it selects the log entries that follow the entry with entryID like LogStorage_getEntriesAfter
+ * (startingTime is the entry time of this entry) but only up to endingTime.
+ *
+ * Storage implementations that don't provide the optional cursor functions are read by a generic
+ * cursor that repeats the getEntries/getEntriesAfter query and skips the entries that have already been read.
+ *
+ * \param self the pointer of the LogStorage instance
+ * \param startingTime start time of the time range or entry time of the entry with entryID
+ * \param endingTime end time of the time range
+ * \param entryID entryID of the last entry before the selected entries or 0
+ *
+ * \return the new cursor or NULL on error
+ */
+LIB61850_API LogStorageCursor
+LogStorage_openCursor(LogStorage self, uint64_t startingTime, uint64_t endingTime, uint64_t entryID);
+
+/**
+ * \brief Read the next log entries of the cursor
+ *
+ * The callbacks are called like for LogStorage_getEntries. When a callback returns false the read
+ * stops and the entry is incomplete. The next call of LogStorageCursor_read starts again with this entry.
+ *
+ * \param self the cursor instance
+ * \param entryCallback callback function to be called for each new log entry
+ * \param entryDataCallback callback function to be called for each new log entry data
+ * \param parameter - a user provided parameter that is passed to the callback handler
+ *
+ * \return true if the request has been successful, false otherwise
+ */
+LIB61850_API bool
+LogStorageCursor_read(LogStorageCursor self, LogEntryCallback entryCallback, LogEntryDataCallback entryDataCallback,
+        void* parameter);
+
+/**
+ * \brief Close the cursor and release all related resources
+ *
+ * NOTE: the cursor has to be closed before the LogStorage instance is destroyed
+ *
+ * \param self the cursor instance
+ */
+LIB61850_API void
+LogStorageCursor_close(LogStorageCursor self);
+
 /**
  * \brief Destroy the LogStorage instance and free all related resources
  *
@@ -202,6 +270,110 @@ LogStorage_getOldestAndNewestEntries(LogStorage self, uint64_t* newEntry, uint64
 LIB61850_API void
 LogStorage_destroy(LogStorage self);
 
+/**
+ * @defgroup ASYNC_LOG_STORAGE Asynchronous log writer
+ *
+ * The asynchronous log writer is a LogStorage that wraps another LogStorage implementation.
+ * New log entries are copied into a bounded in-memory queue by the thread that updates the
+ * data model. A background thread writes the queued entries to the wrapped storage and groups
+ * them into transactions when the storage supports this (e.g. the sqlite driver).
+ *
+ * The entryIDs are assigned by the writer. Therefore the wrapped storage has to implement the
+ * optional addEntryWithID function.
+ *
+ * Read access (getEntries, getEntriesAfter, getOldestAndNewestEntries, cursors) first writes all queued
+ * entries so that the log service always sees a consistent log. All access to the wrapped storage
+ * is serialized, so the wrapped storage doesn't need to be thread-safe.
+ *
+ * NOTE: Not available when the library is compiled with CONFIG_MMS_THREADLESS_STACK
+ *
+ * @{
+ */
+
+/**
+ * \brief Behavior of the asynchronous log writer when the queue is full
+ */
+typedef enum {
+    /** the new entry is dropped (LogStorage_addEntry returns 0) */
+    ASYNC_LOG_STORAGE_DROP_NEWEST = 0,
+    /** the oldest entry in the queue is dropped */
+    ASYNC_LOG_STORAGE_DROP_OLDEST = 1,
+    /** the caller waits until the writer thread has written entries of the queue */
+    ASYNC_LOG_STORAGE_BLOCK = 2
+} AsyncLogStorageOverflowPolicy;
+
+/**
+ * \brief Statistics of the asynchronous log writer
+ */
+typedef struct {
+    uint32_t queueDepth; /**< current number of entries in the queue */
+    uint32_t maxQueueDepth; /**< maximum number of entries in the queue */
+    uint64_t queuedEntries; /**< number of entries put into the queue */
+    uint64_t writtenEntries; /**< number of entries written to the storage */
+    uint64_t droppedEntries; /**< number of entries dropped due to queue overflow or shutdown without flush */
+    uint64_t failedEntries; /**< number of entries the storage failed to write */
+    uint64_t transactions; /**< number of transactions (batches) written to the storage */
+    uint32_t maxEntriesPerTransaction; /**< maximum number of entries written in a single transaction */
+    uint64_t averageTransactionTimeInUs; /**< average time required to write a transaction */
+    uint64_t maxTransactionTimeInUs; /**< maximum time required to write a transaction */
+    uint64_t maxBlockedTimeInUs; /**< maximum time a caller was blocked by a full queue (ASYNC_LOG_STORAGE_BLOCK) */
+} AsyncLogStorageStatistics;
+
+/**
+ * \brief Create a new asynchronous log writer and start the writer thread
+ *
+ * The new instance takes the ownership of the wrapped storage. LogStorage_destroy
+ * will also destroy the wrapped storage.
+ *
+ * \param storage the LogStorage instance where the entries are written to
+ * \param maxQueuedEntries maximum number of log entries waiting in the queue
+ * \param overflowPolicy behavior when the queue is full
+ *
+ * \return the new LogStorage instance or NULL on error (e.g. when storage doesn't support addEntryWithID)
+ */
+LIB61850_API LogStorage
+AsyncLogStorage_create(LogStorage storage, int maxQueuedEntries, AsyncLogStorageOverflowPolicy overflowPolicy);
+
+/**
+ * \brief Configure how queued entries are grouped into transactions
+ *
+ * \param self the asynchronous log writer instance
+ * \param maxEntriesPerTransaction maximum number of log entries written in a single transaction (default is 256)
+ * \param batchDelayInMs time the writer waits for more entries before it starts a transaction (default is 0)
+ */
+LIB61850_API void
+AsyncLogStorage_setBatchParameters(LogStorage self, int maxEntriesPerTransaction, int batchDelayInMs);
+
+/**
+ * \brief Define if the queued entries are written when the instance is destroyed
+ *
+ * \param self the asynchronous log writer instance
+ * \param flushOnDestroy true (default) to write the queued entries, false to drop them
+ */
+LIB61850_API void
+AsyncLogStorage_setFlushOnDestroy(LogStorage self, bool flushOnDestroy);
+
+/**
+ * \brief Write all queued entries to the storage and wait until they are written
+ *
+ * \param self the asynchronous log writer instance
+ *
+ * \return true when all entries have been written successfully, false otherwise
+ */
+LIB61850_API bool
+AsyncLogStorage_flush(LogStorage self);
+
+/**
+ * \brief Get the statistics of the asynchronous log writer
+ *
+ * \param self the asynchronous log writer instance
+ * \param statistics structure where the statistics are stored
+ */
+LIB61850_API void
+AsyncLogStorage_getStatistics(LogStorage self, AsyncLogStorageStatistics* statistics);
+
+/**@}*/
+
 /**@}*/
 
 /**@}*/
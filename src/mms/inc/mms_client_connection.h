@@ -170,6 +170,39 @@ MmsConnection_setRequestTimeout(MmsConnection self, uint32_t timeoutInMs);
 LIB61850_API uint32_t
 MmsConnection_getRequestTimeout(MmsConnection self);
 
+/**
+ * \brief Set the maximum number of outstanding requests (request window) for this connection
+ *
+ * Asynchronous requests can be pipelined up to this limit. Further requests fail with
+ * MMS_ERROR_OUTSTANDING_CALL_LIMIT until responses have been received. The value is also
+ * proposed to the server (proposedMaxServOutstandingCalling) when the connection is established.
+ * After calling this function the effective limit is the lower of this value and the value
+ * negotiated with the server (maxServOutstandingCalling).
+ *
+ * Without calling this function 5 outstanding requests are proposed to the server and the
+ * limit is 10 outstanding requests independent of the negotiated value (as in previous versions).
+ *
+ * NOTE: This function can only be called when there are no outstanding requests (e.g. before the
+ * connection is established).
+ *
+ * \param self MmsConnection instance to operate on
+ * \param maxOutstandingCalls the maximum number of outstanding requests
+ *
+ * \return true when the value has been set, false otherwise
+ */
+LIB61850_API bool
+MmsConnection_setMaxOutstandingCalls(MmsConnection self, int maxOutstandingCalls);
+
+/**
+ * \brief Get the maximum number of outstanding requests for this connection
+ *
+ * \param self MmsConnection instance to operate on
+ *
+ * \return the configured limit, or the negotiated value when it is lower than a limit set by the application
+ */
+LIB61850_API int
+MmsConnection_getMaxOutstandingCalls(MmsConnection self);
+
 /**
  * \brief Set the connect timeout in ms for this connection instance
  *
@@ -194,6 +227,91 @@ LIB61850_API void
 MmsConnection_setInformationReportHandler(MmsConnection self, MmsInformationReportHandler handler,
         void* parameter);
 
+/**
+ * \brief Executes the information report handlers of one or more connections in a dedicated thread
+ *
+ * Without an executor the information report handlers (and the report callbacks of the IedConnection)
+ * are called by the thread that receives the messages of the connection. A slow handler then delays
+ * the handling of responses and can cause request timeouts.
+ *
+ * With an executor the receive thread only puts a copy of the received information report into
+ * a bounded lock-free queue. The report is decoded and passed to the handlers by the executor thread.
+ * Only information reports with a variable list name (IEC 61850 reports) are queued. Information reports
+ * with a list of variables (LastApplError and CommandTermination of the control service) are still
+ * handled by the receive thread so that they are processed in order with the responses.
+ */
+typedef struct sMmsClientCallbackExecutor* MmsClientCallbackExecutor;
+
+/**
+ * \brief Behavior of the callback executor when the queue is full
+ */
+typedef enum {
+    /** the received report is dropped */
+    MMS_CALLBACK_EXECUTOR_DROP_NEWEST = 0,
+    /** the oldest report in the queue is dropped */
+    MMS_CALLBACK_EXECUTOR_DROP_OLDEST = 1,
+    /** the receive thread waits until the queue has space (blocks the connection when the handlers are too slow) */
+    MMS_CALLBACK_EXECUTOR_BLOCK = 2
+} MmsCallbackExecutorOverflowPolicy;
+
+/**
+ * \brief Statistics of the callback executor
+ */
+typedef struct {
+    uint32_t queueDepth; /**< current number of reports in the queue */
+    uint32_t maxQueueDepth; /**< maximum number of reports in the queue */
+    uint64_t enqueued; /**< number of reports put into the queue */
+    uint64_t processed; /**< number of reports passed to the handlers */
+    uint64_t dropped; /**< number of reports dropped due to queue overflow */
+    uint64_t averageLatencyInUs; /**< average time between receiving a report and calling the handler */
+    uint64_t maxLatencyInUs; /**< maximum time between receiving a report and calling the handler */
+} MmsClientCallbackExecutorStatistics;
+
+/**
+ * \brief Create a new callback executor and start the executor thread
+ *
+ * NOTE: Not available when the library is compiled with CONFIG_MMS_THREADLESS_STACK (returns NULL)
+ *
+ * \param queueSize maximum number of reports in the queue (rounded up to a power of two)
+ * \param overflowPolicy behavior when the queue is full
+ *
+ * \return the new instance or NULL on error
+ */
+LIB61850_API MmsClientCallbackExecutor
+MmsClientCallbackExecutor_create(int queueSize, MmsCallbackExecutorOverflowPolicy overflowPolicy);
+
+/**
+ * \brief Get the statistics of the callback executor
+ *
+ * \param self the callback executor instance
+ * \param statistics structure to store the statistics
+ */
+LIB61850_API void
+MmsClientCallbackExecutor_getStatistics(MmsClientCallbackExecutor self, MmsClientCallbackExecutorStatistics* statistics);
+
+/**
+ * \brief Stop the executor thread and release all resources
+ *
+ * NOTE: All connections using the executor have to be detached (\ref MmsConnection_setCallbackExecutor with
+ * NULL) or destroyed before. Reports still in the queue are discarded.
+ *
+ * \param self the callback executor instance
+ */
+LIB61850_API void
+MmsClientCallbackExecutor_destroy(MmsClientCallbackExecutor self);
+
+/**
+ * \brief Let the information reports of the connection be handled by the callback executor
+ *
+ * The same executor can be used by multiple connections. After the function returns no handler of the
+ * connection is called by the previous executor. The function must not be called by a report handler.
+ *
+ * \param self MmsConnection instance to operate on
+ * \param executor the callback executor or NULL to call the handlers by the receiving thread
+ */
+LIB61850_API void
+MmsConnection_setCallbackExecutor(MmsConnection self, MmsClientCallbackExecutor executor);
+
 /**
  * \brief Get the ISO connection parameters for an MmsConnection instance
  *
@@ -507,6 +625,45 @@ LIB61850_API void
 MmsConnection_readVariableAsync(MmsConnection self, uint32_t* usedInvokeId, MmsError* mmsError, const char* domainId, const char* itemId,
         MmsConnection_ReadVariableHandler handler, void* parameter);
 
+/**
+ * \brief Read a single variable from the server into an existing MmsValue instance
+ *
+ * The response is decoded directly into the provided value without allocating a new MmsValue. The value
+ * has to match the type of the variable (e.g. same bit string size, same float width, enough space for
+ * integers and octet strings). It can be the result of a previous \ref MmsConnection_readVariable call.
+ *
+ * When the response doesn't match the value the error is MMS_ERROR_DEFINITION_TYPE_INCONSISTENT. When the
+ * server returns an access error the error is the corresponding MMS error code. In both cases the value
+ * is not changed.
+ *
+ * \param self MmsConnection instance to operate on
+ * \param mmsError user provided variable to store error code
+ * \param domainId the domain name of the variable to be read or NULL to read a VMD specific named variable
+ * \param itemId name of the variable to be read
+ * \param value the value to store the result
+ */
+LIB61850_API void
+MmsConnection_readVariableInto(MmsConnection self, MmsError* mmsError, const char* domainId, const char* itemId,
+        MmsValue* value);
+
+/**
+ * \brief Read a single variable from the server into an existing MmsValue instance (asynchronous version)
+ *
+ * See \ref MmsConnection_readVariableInto. The value must not be accessed until the handler is called.
+ * The handler is called with success = true when the value has been updated.
+ *
+ * \param[in] self MmsConnection instance to operate on
+ * \param[out] usedInvokeId the invoke ID of the request
+ * \param[out] mmsError user provided variable to store error code
+ * \param[in] domainId the domain name of the variable to be read or NULL to read a VMD specific named variable
+ * \param[in] itemId name of the variable to be read
+ * \param[in] value the value to store the result
+ */
+LIB61850_API void
+MmsConnection_readVariableIntoAsync(MmsConnection self, uint32_t* usedInvokeId, MmsError* mmsError,
+        const char* domainId, const char* itemId, MmsValue* value,
+        MmsConnection_GenericServiceHandler handler, void* parameter);
+
 /**
  * \brief Read a component of a single variable from the server.
  *
@@ -622,6 +779,30 @@ MmsConnection_readMultipleVariablesAsync(MmsConnection self, uint32_t* usedInvok
         const char* domainId, LinkedList /*<char*>*/items,
         MmsConnection_ReadVariableHandler handler, void* parameter);
 
+/**
+ * \brief Read multiple variables of a domain from the server into an existing MmsValue instance
+ *
+ * The values are decoded directly into the elements of the provided MMS_ARRAY (one element per item in
+ * the order of the item ID list). The array can be the result of a previous \ref MmsConnection_readMultipleVariables
+ * call. The array is only updated when all results can be stored. Otherwise the error is
+ * MMS_ERROR_DEFINITION_TYPE_INCONSISTENT (type mismatch) or the MMS error code of the first access error
+ * returned by the server.
+ *
+ * \param self MmsConnection instance to operate on
+ * \param mmsError user provided variable to store error code
+ * \param domainId the domain name of the requested variables.
+ * \param items: LinkedList<char*> is the list of item IDs of the requested variables.
+ * \param values MMS_ARRAY with one element for each item to store the results
+ */
+LIB61850_API void
+MmsConnection_readMultipleVariablesInto(MmsConnection self, MmsError* mmsError, const char* domainId,
+        LinkedList /*<char*>*/ items, MmsValue* values);
+
+LIB61850_API void
+MmsConnection_readMultipleVariablesIntoAsync(MmsConnection self, uint32_t* usedInvokeId, MmsError* mmsError,
+        const char* domainId, LinkedList /*<char*>*/items, MmsValue* values,
+        MmsConnection_GenericServiceHandler handler, void* parameter);
+
 /**
  * \brief Write a single variable to the server.
  *
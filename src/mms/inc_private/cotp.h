@@ -44,6 +44,7 @@ typedef struct {
     int protocolClass;
 
     HandleSet handleSet;
+    int readWaitTime; /* maximum time in ms to wait for incoming data */
     Socket socket;
 #if (CONFIG_MMS_SUPPORT_TLS == 1)
     TLSSocket tlsSocket;
@@ -30,6 +30,7 @@
 
 #include "byte_buffer.h"
 #include "iso_connection_parameters.h"
+#include "hal_socket.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -69,6 +70,18 @@ IsoClientConnection_associateAsync(IsoClientConnection self, uint32_t connectTim
 LIB61850_INTERNAL bool
 IsoClientConnection_handleConnection(IsoClientConnection self);
 
+/**
+ * \brief Check the timers of the connection without accessing the socket
+ *
+ * Can be called instead of IsoClientConnection_handleConnection for a connection that has no
+ * pending socket events. Performs the house-keeping tasks of the API client (e.g. request timeouts).
+ *
+ * \return true when the connection has to be handled by IsoClientConnection_handleConnection
+ *         (TCP connect in progress, read timeout expired, or close requested)
+ */
+LIB61850_INTERNAL bool
+IsoClientConnection_checkTimeouts(IsoClientConnection self);
+
 LIB61850_INTERNAL void
 IsoClientConnection_associate(IsoClientConnection self, uint32_t connectTimeoutInMs);
 
@@ -92,6 +105,24 @@ IsoClientConnection_abortAsync(IsoClientConnection self);
 LIB61850_INTERNAL void
 IsoClientConnection_close(IsoClientConnection self);
 
+/**
+ * \brief Indicate that the connection is handled by another thread that waits for the socket
+ *
+ * When set IsoClientConnection_close only requests the close that is executed by the next call of
+ * IsoClientConnection_handleConnection, and IsoClientConnection_handleConnection doesn't wait for
+ * incoming data.
+ */
+LIB61850_INTERNAL void
+IsoClientConnection_setExternallyHandled(IsoClientConnection self, bool externallyHandled);
+
+/**
+ * \brief Get the socket of the connection to wait for incoming data
+ *
+ * \return the socket or NULL when the connection is not waiting for data (e.g. TCP connect in progress)
+ */
+LIB61850_INTERNAL Socket
+IsoClientConnection_getSocket(IsoClientConnection self);
+
 /**
  * This function should be called by the API client (usually the MmsConnection) to reserve(allocate)
  * the payload buffer. This is used to prevent concurrent access to the send buffer of the IsoClientConnection
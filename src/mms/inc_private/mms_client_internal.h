@@ -51,6 +51,9 @@ typedef enum {
     MMS_CALL_TYPE_NONE,
     MMS_CALL_TYPE_READ_VARIABLE,
     MMS_CALL_TYPE_READ_MULTIPLE_VARIABLES,
+    MMS_CALL_TYPE_READ_VARIABLE_INTO,
+    MMS_CALL_TYPE_READ_MULTIPLE_VARIABLES_INTO,
+    MMS_CALL_TYPE_READ_VARIABLE_INTO_TARGET,
     MMS_CALL_TYPE_WRITE_VARIABLE,
     MMS_CALL_TYPE_WRITE_MULTIPLE_VARIABLES,
     MMS_CALL_TYPE_READ_NVL_DIRECTORY,
@@ -88,13 +91,30 @@ struct sMmsOutstandingCall
     uint64_t timeout;
 };
 
+/* registration of a connection at a callback executor */
+typedef struct sMmsCallbackExecutorClient* MmsCallbackExecutorClient;
+
+/*
+ * Handler for the encoded unconfirmed PDU (information report). Called before the PDU is decoded.
+ * When the handler returns false the PDU is decoded and passed to the information report handler.
+ */
+typedef bool (*MmsRawInformationReportHandler) (void* parameter, uint8_t* buffer, int size);
+
 /* private instance variables */
 struct sMmsConnection {
     Semaphore nextInvokeIdLock;
     uint32_t nextInvokeId;
 
     Semaphore outstandingCallsLock;
-    MmsOutstandingCall outstandingCalls;
+    MmsOutstandingCall outstandingCalls; /* table indexed by invokeId (size is a power of two) */
+    int outstandingCallsTableSize;
+    int numberOfOutstandingCalls;
+    int numberOfDisplacedCalls; /* calls not stored at the slot of their invokeId */
+    uint64_t nextOutstandingCallTimeout; /* no outstanding call expires before this time */
+
+    int maxOutstandingCalls; /* maximum number of outstanding calls (request window) */
+    bool maxOutstandingCallsSet; /* request window has been set by the application */
+    int proposedMaxServOutstandingCalling;
 
     uint32_t requestTimeout;
     uint32_t connectTimeout;
@@ -119,6 +139,14 @@ struct sMmsConnection {
     MmsInformationReportHandler reportHandler;
     void* reportHandlerParameter;
 
+    MmsRawInformationReportHandler rawReportHandler;
+    void* rawReportHandlerParameter;
+
+#if (CONFIG_MMS_THREADLESS_STACK == 0)
+    Semaphore callbackExecutorLock; /* protects callbackExecutorClient */
+    MmsCallbackExecutorClient callbackExecutorClient;
+#endif
+
     MmsConnectionLostHandler connectionLostHandler;
     void* connectionLostHandlerParameter;
 
@@ -156,6 +184,35 @@ typedef enum {
 LIB61850_INTERNAL char*
 MmsConnection_getFilestoreBasepath(MmsConnection self);
 
+LIB61850_INTERNAL void
+mmsClient_setRawInformationReportHandler(MmsConnection self, MmsRawInformationReportHandler handler, void* parameter);
+
+/* decode the unconfirmed PDU (information report) and call the report handlers */
+LIB61850_INTERNAL void
+mmsClient_handleUnconfirmedPdu(MmsConnection self, ByteBuffer* message);
+
+/*
+ * pass the unconfirmed PDU to the callback executor - returns false when the connection has no executor or
+ * when the PDU is not a report (information reports of the control service are not queued)
+ */
+LIB61850_INTERNAL bool
+mmsClient_enqueueUnconfirmedPdu(MmsConnection self, ByteBuffer* message);
+
+typedef struct
+{
+    MmsValue* value;
+    int dataAccessError; /* DataAccessError code of a failed access result or -1 */
+} MmsClientReadIntoTarget;
+
+/*
+ * read a single variable into target->value (like MmsConnection_readVariableInto). When the server returns
+ * an access error the code is stored in target->dataAccessError so it can be distinguished from a response
+ * that doesn't match the value.
+ */
+LIB61850_INTERNAL void
+mmsClient_readVariableIntoTarget(MmsConnection self, MmsError* mmsError,
+        const char* domainId, const char* itemId, MmsClientReadIntoTarget* target);
+
 LIB61850_INTERNAL MmsValue*
 mmsClient_parseListOfAccessResults(AccessResult_t** accessResultList, int listSize, bool createArray);
 
@@ -199,6 +256,18 @@ mmsClient_createGetNameListRequestDomainOrVMDSpecific(long invokeId, const char*
 LIB61850_INTERNAL MmsValue*
 mmsClient_parseReadResponse(ByteBuffer* message, uint32_t* invokeId, bool createArray);
 
+/*
+ * decode the read response into an existing value (MMS_ARRAY with one element per result when isList is true)
+ *
+ * When dataAccessError is not NULL it is set to the received DataAccessError code if the read failed because
+ * of an access error.
+ */
+LIB61850_INTERNAL MmsError
+mmsClient_parseReadResponseInto(ByteBuffer* message, int bufPos, MmsValue* value, bool isList, int* dataAccessError);
+
+LIB61850_INTERNAL MmsError
+mmsClient_mapDataAccessErrorToMmsError(uint32_t dataAccessError);
+
 LIB61850_INTERNAL int
 mmsClient_createReadRequest(uint32_t invokeId, const char* domainId, const char* itemId, ByteBuffer* writeBuffer);
 
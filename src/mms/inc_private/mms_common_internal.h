@@ -40,6 +40,10 @@
 #define CONFIG_MMS_MAX_NUMBER_OF_OPEN_FILES_PER_CONNECTION 5
 #endif
 
+#ifndef CONFIG_MMS_SERVER_FILE_READ_MMAP
+#define CONFIG_MMS_SERVER_FILE_READ_MMAP 0
+#endif
+
 #include "hal_filesystem.h"
 
 typedef struct sMmsOutstandingCall* MmsOutstandingCall;
@@ -50,6 +54,10 @@ typedef struct {
         uint32_t fileSize;
         FileHandle fileHandle;
 
+#if (CONFIG_MMS_SERVER_FILE_READ_MMAP == 1)
+        uint8_t* mapping; /* file content when the server could map the file */
+#endif
+
 #if (MMS_OBTAIN_FILE_SERVICE == 1)
         MmsOutstandingCall obtainRequest;
 #endif
@@ -68,6 +68,22 @@
 #define CONFIG_MMS_SERVER_MAX_GET_FILE_TASKS 5
 #endif
 
+#ifndef CONFIG_MMS_SERVER_FILE_DIRECTORY_CACHE_SIZE
+#define CONFIG_MMS_SERVER_FILE_DIRECTORY_CACHE_SIZE 4
+#endif
+
+#ifndef CONFIG_MMS_SERVER_FILE_DIRECTORY_CACHE_MAX_AGE
+#define CONFIG_MMS_SERVER_FILE_DIRECTORY_CACHE_MAX_AGE 10000
+#endif
+
+#if (MMS_FILE_SERVICE == 1)
+typedef struct sMmsFileDirectoryListing* MmsFileDirectoryListing;
+#endif
+
+#ifndef CONFIG_MMS_SERVER_MAX_SERV_OUTSTANDING_CALLING
+#define CONFIG_MMS_SERVER_MAX_SERV_OUTSTANDING_CALLING DEFAULT_MAX_SERV_OUTSTANDING_CALLING
+#endif
+
 
 #if (MMS_OBTAIN_FILE_SERVICE == 1)
 
@@ -120,6 +136,9 @@ struct sMmsServer {
     MmsWriteVariableHandler writeHandler;
     void* writeHandlerParameter;
 
+    MmsValueCacheAccessHandler valueCacheAccessHandler;
+    void* valueCacheAccessHandlerParameter;
+
     MmsConnectionHandler connectionHandler;
     void* connectionHandlerParameter;
 
@@ -172,7 +191,14 @@ struct sMmsServer {
 #if (MMS_FILE_SERVICE == 1)
     MmsFileAccessHandler fileAccessHandler;
     void* fileAccessHandlerParameter;
+
+#if (CONFIG_MMS_SERVER_FILE_DIRECTORY_CACHE_SIZE > 0)
+    MmsFileDirectoryListing fileDirectoryCache[CONFIG_MMS_SERVER_FILE_DIRECTORY_CACHE_SIZE];
+#if (CONFIG_MMS_THREADLESS_STACK != 1)
+    Semaphore fileDirectoryCacheLock;
 #endif
+#endif /* (CONFIG_MMS_SERVER_FILE_DIRECTORY_CACHE_SIZE > 0) */
+#endif /* (MMS_FILE_SERVICE == 1) */
 
 #if (CONFIG_SET_FILESTORE_BASEPATH_AT_RUNTIME == 1)
     char* filestoreBasepath;
@@ -190,6 +216,29 @@ struct sMmsServer {
 
 };
 
+#if (MMS_JOURNAL_SERVICE == 1)
+
+#ifndef CONFIG_MMS_MAX_NUMBER_OF_JOURNAL_CURSORS_PER_CONNECTION
+#define CONFIG_MMS_MAX_NUMBER_OF_JOURNAL_CURSORS_PER_CONNECTION 2
+#endif
+
+#ifndef CONFIG_MMS_JOURNAL_CURSOR_TIMEOUT
+#define CONFIG_MMS_JOURNAL_CURSOR_TIMEOUT 30000
+#endif
+
+/* keeps the read position of a ReadJournal request that returned moreFollows */
+typedef struct {
+    LogStorageCursor storageCursor; /* NULL when unused */
+    LogStorage logStorage;
+    MmsJournal journal;
+    bool hasRangeStop;
+    uint64_t endingTime;
+    uint64_t lastEntryID; /* last entry sent to the client */
+    uint64_t lastAccessTime;
+} MmsJournalCursor;
+
+#endif /* (MMS_JOURNAL_SERVICE == 1) */
+
 struct sMmsServerConnection {
     int maxServOutstandingCalling;
     int maxServOutstandingCalled;
@@ -212,6 +261,10 @@ struct sMmsServerConnection {
     int32_t nextFrsmId;
     MmsFileReadStateMachine frsms[CONFIG_MMS_MAX_NUMBER_OF_OPEN_FILES_PER_CONNECTION];
 #endif
+
+#if (MMS_JOURNAL_SERVICE == 1)
+    MmsJournalCursor journalCursors[CONFIG_MMS_MAX_NUMBER_OF_JOURNAL_CURSORS_PER_CONNECTION];
+#endif
 };
 
 #if (MMS_OBTAIN_FILE_SERVICE == 1)
@@ -326,6 +379,12 @@ mmsServer_handleReadJournalRequest(
         uint32_t invokeId,
         ByteBuffer* response);
 
+LIB61850_INTERNAL void
+mmsServer_expireJournalCursors(MmsServerConnection connection, uint64_t currentTime);
+
+LIB61850_INTERNAL void
+mmsServer_closeJournalCursors(MmsServerConnection connection);
+
 LIB61850_INTERNAL void
 mmsServer_handleFileDirectoryRequest(
         MmsServerConnection connection,
@@ -378,6 +437,15 @@ mmsServer_handleObtainFileRequest(
 LIB61850_INTERNAL void
 mmsServerConnection_stopFileUploadTasks(MmsServerConnection self);
 
+LIB61850_INTERNAL void
+mmsServerConnection_closeFiles(MmsServerConnection self);
+
+LIB61850_INTERNAL void
+mmsServer_invalidateFileDirectoryCache(MmsServer self);
+
+LIB61850_INTERNAL void
+mmsServer_destroyFileDirectoryCache(MmsServer self);
+
 LIB61850_INTERNAL bool
 mmsServer_isIndexAccess(AlternateAccess_t* alternateAccess);
 
@@ -396,6 +464,12 @@ mmsServer_getNamedVariableListWithName(LinkedList namedVariableLists, const char
 LIB61850_INTERNAL void
 mmsServer_deleteVariableList(LinkedList namedVariableLists, char* variableListName);
 
+/**
+ * \brief Inform the value cache access handler that the value cache of the domain will be accessed
+ */
+LIB61850_INTERNAL void
+mmsServer_prepareValueCacheAccess(MmsServer self, MmsDomain* domain);
+
 LIB61850_INTERNAL MmsDataAccessError
 mmsServer_setValue(MmsServer self, MmsDomain* domain, char* itemId, MmsValue* value,
         MmsServerConnection connection);
@@ -40,6 +40,11 @@ typedef MmsDataAccessError (*MmsWriteVariableHandler)(void* parameter,
 typedef void (*MmsConnectionHandler)(void* parameter,
         MmsServerConnection connection, MmsServerEvent event);
 
+/**
+ * Called before a service accesses the value cache of a domain (domain is the MmsDevice for VMD specific variables)
+ */
+typedef void (*MmsValueCacheAccessHandler)(void* parameter, MmsDomain* domain);
+
 LIB61850_INTERNAL MmsServer
 MmsServer_create(MmsDevice* device, TLSConfiguration tlsConfiguration);
 
@@ -63,6 +68,12 @@ LIB61850_INTERNAL void
 MmsServer_installWriteHandler(MmsServer self, MmsWriteVariableHandler,
         void* parameter);
 
+/**
+ * The value cache access handler can be used to populate the value cache of a domain on first access
+ */
+LIB61850_INTERNAL void
+MmsServer_installValueCacheAccessHandler(MmsServer self, MmsValueCacheAccessHandler handler, void* parameter);
+
 /**
  * A connection handler will be invoked whenever a new client connection is opened or closed
  */
@@ -71,4 +71,41 @@ MmsValue_newIntegerFromBerInteger(Asn1PrimitiveValue* berInteger);
 LIB61850_INTERNAL MmsValue*
 MmsValue_newUnsignedFromBerInteger(Asn1PrimitiveValue* berInteger);
 
+/**
+ * \brief update an existing MmsValue instance from a BER encoded MMS Data element without memory allocation
+ *
+ * The update fails when the type or the size of the encoded element doesn't match the MmsValue instance
+ * (e.g. a bit string of different size or an integer that doesn't fit into the value). In this case the value
+ * can be partially updated and has to be replaced (see \ref MmsValue_decodeMmsData).
+ *
+ * \param self the MmsValue instance to update
+ * \param buffer the buffer to read from
+ * \param bufPos the start position of the mms value data in the buffer
+ * \param bufferLength the length of the buffer
+ * \param endBufPos the position in the buffer after the read MMS data element (NULL if not required)
+ *
+ * \return true when the value has been updated, false otherwise
+ */
+LIB61850_INTERNAL bool
+MmsValue_updateFromMmsData(MmsValue* self, uint8_t* buffer, int bufPos, int bufferLength, int* endBufPos);
+
+/**
+ * \brief check if a BER encoded MMS Data element can be stored in an existing MmsValue instance
+ *
+ * Same checks as \ref MmsValue_updateFromMmsData but the value is not changed. Can be used to
+ * avoid partial updates of complex values.
+ *
+ * \return true when \ref MmsValue_updateFromMmsData will succeed, false otherwise
+ */
+LIB61850_INTERNAL bool
+MmsValue_isMatchingMmsData(MmsValue* self, uint8_t* buffer, int bufPos, int bufferLength, int* endBufPos);
+
+/**
+ * \brief create a deep copy of a variable specification
+ *
+ * \return the new instance (has to be released with \ref MmsVariableSpecification_destroy) or NULL
+ */
+LIB61850_INTERNAL MmsVariableSpecification*
+MmsVariableSpecification_clone(const MmsVariableSpecification* typeSpec);
+
 #endif /* MMS_VALUE_INTERNAL_H_ */
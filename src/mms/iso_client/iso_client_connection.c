@@ -101,6 +101,7 @@ struct sIsoClientConnection
     ByteBuffer* receivePayloadBuffer;
 
     Semaphore tickMutex;
+    bool externallyHandled; /* connection is handled by another thread (e.g. IedClientReactor) */
 
     uint8_t* cotpReadBuf;
     uint8_t* cotpWriteBuf;
@@ -215,6 +216,10 @@ sendConnectionRequestMessage(IsoClientConnection self)
         CotpConnection_init(self->cotpConnection, self->socket, self->receiveBuffer, self->cotpReadBuffer, self->cotpWriteBuffer,
                 socketExtensionBuffer, socketExtensionBufferSize);
 
+        /* the socket has already been checked by the external handler -> don't wait */
+        if (self->externallyHandled)
+            self->cotpConnection->readWaitTime = 0;
+
 #if (CONFIG_MMS_SUPPORT_TLS == 1)
         if (self->parameters->tlsConfiguration) {
 
@@ -659,6 +664,42 @@ IsoClientConnection_handleConnection(IsoClientConnection self)
     return waits;
 }
 
+bool
+IsoClientConnection_checkTimeouts(IsoClientConnection self)
+{
+    Semaphore_wait(self->tickMutex);
+
+    bool handle = false;
+
+    switch (getIntState(self)) {
+
+    case INT_STATE_IDLE:
+    case INT_STATE_ERROR:
+    case INT_STATE_WAIT_FOR_DATA_MSG:
+        break;
+
+    case INT_STATE_TCP_CONNECTING:
+        handle = true;
+        break;
+
+    case INT_STATE_WAIT_FOR_COTP_CONNECT_RESP:
+    case INT_STATE_WAIT_FOR_ACSE_RESP:
+        if (Hal_getTimeInMs() > self->nextReadTimeout)
+            handle = true;
+        break;
+
+    default:
+        handle = true;
+        break;
+    }
+
+    if (handle == false)
+        self->callback(ISO_IND_TICK, self->callbackParameter, NULL);
+
+    Semaphore_post(self->tickMutex);
+
+    return handle;
+}
 
 bool
 IsoClientConnection_associateAsync(IsoClientConnection self, uint32_t connectTimeoutInMs, uint32_t readTimeoutInMs)
@@ -765,6 +806,11 @@ IsoClientConnection_close(IsoClientConnection self)
     if ((intState != INT_STATE_IDLE) && (intState != INT_STATE_ERROR) && (intState != INT_STATE_CLOSE_ON_ERROR)) {
         setIntState(self, INT_STATE_CLOSING_CONNECTION);
 
+        if (self->externallyHandled) {
+            Semaphore_post(self->tickMutex);
+            return;
+        }
+
         Semaphore_post(self->tickMutex);
 
         IsoClientConnection_handleConnection(self);
@@ -775,6 +821,37 @@ IsoClientConnection_close(IsoClientConnection self)
     }
 }
 
+void
+IsoClientConnection_setExternallyHandled(IsoClientConnection self, bool externallyHandled)
+{
+    Semaphore_wait(self->tickMutex);
+
+    self->externallyHandled = externallyHandled;
+
+    if (self->cotpConnection)
+        self->cotpConnection->readWaitTime = externallyHandled ? 0 : 10;
+
+    Semaphore_post(self->tickMutex);
+}
+
+Socket
+IsoClientConnection_getSocket(IsoClientConnection self)
+{
+    Socket socket = NULL;
+
+    Semaphore_wait(self->tickMutex);
+
+    eIsoClientInternalState intState = getIntState(self);
+
+    if ((intState == INT_STATE_WAIT_FOR_COTP_CONNECT_RESP) || (intState == INT_STATE_WAIT_FOR_ACSE_RESP) ||
+            (intState == INT_STATE_WAIT_FOR_DATA_MSG))
+        socket = self->socket;
+
+    Semaphore_post(self->tickMutex);
+
+    return socket;
+}
+
 void
 IsoClientConnection_destroy(IsoClientConnection self)
 {
@@ -523,6 +523,7 @@ CotpConnection_init(CotpConnection* self, Socket socket,
     self->socket = socket;
     self->handleSet = Handleset_new();
     Handleset_addSocket( self->handleSet, self->socket );
+    self->readWaitTime = 10;
 
 #if (CONFIG_MMS_SUPPORT_TLS == 1)
     self->tlsSocket = NULL;
@@ -744,7 +745,7 @@ readFromSocket(CotpConnection* self, uint8_t* buf, int size)
     if (self->tlsSocket)
         return TLSSocket_read(self->tlsSocket, buf, size);
     else {
-        switch (Handleset_waitReady(self->handleSet, 10))
+        switch (Handleset_waitReady(self->handleSet, self->readWaitTime))
         {
             case -1:
                 return -1;
@@ -757,7 +758,7 @@ readFromSocket(CotpConnection* self, uint8_t* buf, int size)
         return Socket_read(self->socket, buf, size);
     }
 #else
-    switch (Handleset_waitReady(self->handleSet, 10))
+    switch (Handleset_waitReady(self->handleSet, self->readWaitTime))
     {
         case -1:
             return -1;
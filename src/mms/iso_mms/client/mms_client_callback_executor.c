@@ -0,0 +1,577 @@
+/*
+ *  mms_client_callback_executor.c
+ *
+ *  Executes the information report handlers of client connections in a dedicated thread
+ *
+ *  This file is part of libIEC61850.
+ *
+ *  libIEC61850 is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  libIEC61850 is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with libIEC61850.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+#include "libiec61850_platform_includes.h"
+#include "stack_config.h"
+#include "mms_common.h"
+#include "mms_client_connection.h"
+#include "byte_buffer.h"
+
+#include "mms_client_internal.h"
+
+#include "hal_thread.h"
+#include "hal_time.h"
+#include "platform_atomic.h"
+
+#if (CONFIG_MMS_THREADLESS_STACK == 0)
+
+#define DEFAULT_QUEUE_SIZE 256
+#define MAX_QUEUE_SIZE (1 << 20)
+
+struct sMmsCallbackExecutorClient
+{
+    MmsClientCallbackExecutor executor;
+    MmsConnection connection;
+    volatile int32_t active; /* set to 0 when the connection is detached */
+    volatile int32_t referenceCount; /* connection + queued reports */
+};
+
+/*
+ * Cell of the bounded lock-free queue. The sequence number of the cell indicates if the
+ * cell can be written (sequence == position) or read (sequence == position + 1).
+ */
+typedef struct
+{
+    volatile int32_t sequence;
+    MmsCallbackExecutorClient client;
+    uint8_t* buffer;
+    int size;
+    uint64_t timestamp; /* receive time in ns */
+} QueueCell;
+
+struct sMmsClientCallbackExecutor
+{
+    QueueCell* cells;
+    int32_t mask;
+    volatile int32_t enqueuePos;
+    volatile int32_t dequeuePos;
+
+    MmsCallbackExecutorOverflowPolicy overflowPolicy;
+
+    Thread thread;
+    volatile int32_t running;
+    volatile int32_t sleeping; /* executor thread waits for the wakeup semaphore */
+    Semaphore wakeup;
+    Semaphore processingLock; /* held while a report is handled */
+
+    /* overflow policy MMS_CALLBACK_EXECUTOR_BLOCK */
+    volatile int32_t producerWaits; /* a producer waits for the cellReleased semaphore */
+    Semaphore cellReleased;
+    Semaphore producerLock; /* only one producer waits for a free cell at a time */
+
+    volatile int32_t maxQueueDepth;
+    volatile uint64_t enqueued;
+    volatile uint64_t processed;
+    volatile uint64_t dropped;
+    volatile uint64_t totalLatency; /* in ns */
+    volatile uint64_t maxLatency; /* in ns */
+};
+
+typedef struct
+{
+    MmsCallbackExecutorClient client;
+    uint8_t* buffer;
+    int size;
+    uint64_t timestamp;
+} QueueEntry;
+
+static void
+releaseClient(MmsCallbackExecutorClient client)
+{
+    if (Atomic_fetchAdd32(&(client->referenceCount), -1) == 1)
+        GLOBAL_FREEMEM(client);
+}
+
+static bool
+queue_push(MmsClientCallbackExecutor self, QueueEntry* entry)
+{
+    int32_t pos = Atomic_load32(&(self->enqueuePos));
+
+    while (true) {
+        QueueCell* cell = &(self->cells[pos & self->mask]);
+
+        int32_t difference = (int32_t) ((uint32_t) Atomic_load32(&(cell->sequence)) - (uint32_t) pos);
+
+        if (difference == 0) {
+            if (Atomic_compareExchange32(&(self->enqueuePos), pos, (int32_t) ((uint32_t) pos + 1))) {
+                cell->client = entry->client;
+                cell->buffer = entry->buffer;
+                cell->size = entry->size;
+                cell->timestamp = entry->timestamp;
+
+                Atomic_store32(&(cell->sequence), (int32_t) ((uint32_t) pos + 1));
+
+                return true;
+            }
+        }
+        else if (difference < 0) {
+            return false; /* queue is full */
+        }
+
+        pos = Atomic_load32(&(self->enqueuePos));
+    }
+}
+
+static bool
+queue_pop(MmsClientCallbackExecutor self, QueueEntry* entry)
+{
+    int32_t pos = Atomic_load32(&(self->dequeuePos));
+
+    while (true) {
+        QueueCell* cell = &(self->cells[pos & self->mask]);
+
+        int32_t difference = (int32_t) ((uint32_t) Atomic_load32(&(cell->sequence)) - ((uint32_t) pos + 1));
+
+        if (difference == 0) {
+            if (Atomic_compareExchange32(&(self->dequeuePos), pos, (int32_t) ((uint32_t) pos + 1))) {
+                entry->client = cell->client;
+                entry->buffer = cell->buffer;
+                entry->size = cell->size;
+                entry->timestamp = cell->timestamp;
+
+                Atomic_store32(&(cell->sequence), (int32_t) ((uint32_t) pos + (uint32_t) self->mask + 1));
+
+                return true;
+            }
+        }
+        else if (difference < 0) {
+            return false; /* queue is empty */
+        }
+
+        pos = Atomic_load32(&(self->dequeuePos));
+    }
+}
+
+static bool
+queue_isEmpty(MmsClientCallbackExecutor self)
+{
+    int32_t pos = Atomic_load32(&(self->dequeuePos));
+
+    QueueCell* cell = &(self->cells[pos & self->mask]);
+
+    return (Atomic_load32(&(cell->sequence)) != (int32_t) ((uint32_t) pos + 1));
+}
+
+static bool
+queue_isFull(MmsClientCallbackExecutor self)
+{
+    int32_t pos = Atomic_load32(&(self->enqueuePos));
+
+    QueueCell* cell = &(self->cells[pos & self->mask]);
+
+    return ((int32_t) ((uint32_t) Atomic_load32(&(cell->sequence)) - (uint32_t) pos) < 0);
+}
+
+static int32_t
+queue_getDepth(MmsClientCallbackExecutor self)
+{
+    int32_t depth = (int32_t) ((uint32_t) Atomic_load32(&(self->enqueuePos)) - (uint32_t) Atomic_load32(&(self->dequeuePos)));
+
+    return (depth > 0) ? depth : 0;
+}
+
+static void
+wakeupExecutor(MmsClientCallbackExecutor self)
+{
+    Atomic_fence();
+
+    /* only one thread releases the semaphore for each wait of the executor thread */
+    if (Atomic_compareExchange32(&(self->sleeping), 1, 0))
+        Semaphore_post(self->wakeup);
+}
+
+static void
+releaseProducer(MmsClientCallbackExecutor self)
+{
+    Atomic_fence();
+
+    if (Atomic_compareExchange32(&(self->producerWaits), 1, 0))
+        Semaphore_post(self->cellReleased);
+}
+
+/* blocks the producer until the executor thread has removed an entry from the full queue */
+static void
+waitForFreeCell(MmsClientCallbackExecutor self)
+{
+    Semaphore_wait(self->producerLock);
+
+    Atomic_store32(&(self->producerWaits), 1);
+    Atomic_fence();
+
+    if (queue_isFull(self) && Atomic_load32(&(self->running))) {
+        wakeupExecutor(self);
+        Semaphore_wait(self->cellReleased);
+    }
+    else {
+        /* when the executor thread already reset the flag it also releases the semaphore */
+        if (Atomic_compareExchange32(&(self->producerWaits), 1, 0) == false)
+            Semaphore_wait(self->cellReleased);
+    }
+
+    Semaphore_post(self->producerLock);
+}
+
+static void
+releaseEntry(QueueEntry* entry)
+{
+    GLOBAL_FREEMEM(entry->buffer);
+    releaseClient(entry->client);
+}
+
+static void
+handleEntry(MmsClientCallbackExecutor self, QueueEntry* entry)
+{
+    uint64_t latency = Hal_getTimeInNs() - entry->timestamp;
+
+    Atomic_fetchAdd64(&(self->totalLatency), latency);
+
+    if (latency > Atomic_load64(&(self->maxLatency)))
+        Atomic_store64(&(self->maxLatency), latency);
+
+    Semaphore_wait(self->processingLock);
+
+    if (Atomic_load32(&(entry->client->active))) {
+        ByteBuffer message;
+
+        ByteBuffer_wrap(&message, entry->buffer, entry->size, entry->size);
+
+        mmsClient_handleUnconfirmedPdu(entry->client->connection, &message);
+    }
+
+    Semaphore_post(self->processingLock);
+
+    releaseEntry(entry);
+
+    Atomic_fetchAdd64(&(self->processed), 1);
+}
+
+static void*
+executorThread(void* parameter)
+{
+    MmsClientCallbackExecutor self = (MmsClientCallbackExecutor) parameter;
+
+    QueueEntry entry;
+
+    while (Atomic_load32(&(self->running))) {
+
+        if (queue_pop(self, &entry)) {
+            releaseProducer(self);
+            handleEntry(self, &entry);
+            continue;
+        }
+
+        Atomic_store32(&(self->sleeping), 1);
+        Atomic_fence();
+
+        if ((queue_isEmpty(self) == false) || (Atomic_load32(&(self->running)) == 0)) {
+
+            /* when a producer already reset the flag it also releases the semaphore */
+            if (Atomic_compareExchange32(&(self->sleeping), 1, 0) == false)
+                Semaphore_wait(self->wakeup);
+
+            continue;
+        }
+
+        Semaphore_wait(self->wakeup);
+    }
+
+    return NULL;
+}
+
+static bool
+enqueueReport(MmsClientCallbackExecutor self, QueueEntry* entry)
+{
+    while (true) {
+        if (queue_push(self, entry)) {
+            Atomic_fetchAdd64(&(self->enqueued), 1);
+
+            int32_t depth = queue_getDepth(self);
+            int32_t maxDepth = Atomic_load32(&(self->maxQueueDepth));
+
+            while ((depth > maxDepth) && (Atomic_compareExchange32(&(self->maxQueueDepth), maxDepth, depth) == false))
+                maxDepth = Atomic_load32(&(self->maxQueueDepth));
+
+            wakeupExecutor(self);
+
+            return true;
+        }
+
+        if (self->overflowPolicy == MMS_CALLBACK_EXECUTOR_DROP_OLDEST) {
+            QueueEntry oldest;
+
+            if (queue_pop(self, &oldest)) {
+                releaseEntry(&oldest);
+                Atomic_fetchAdd64(&(self->dropped), 1);
+            }
+        }
+        else if (self->overflowPolicy == MMS_CALLBACK_EXECUTOR_BLOCK) {
+            if (Atomic_load32(&(self->running)) == 0)
+                return false;
+
+            waitForFreeCell(self);
+        }
+        else {
+            return false;
+        }
+    }
+}
+
+/*
+ * Check if the unconfirmed PDU is an information report with a variable list name (IEC 61850 report).
+ * Information reports with a list of variables (LastApplError, CommandTermination) belong to a control
+ * service and are handled by the receiving thread together with the responses of the control service.
+ */
+static bool
+isVariableListReport(ByteBuffer* message)
+{
+    uint8_t* buffer = ByteBuffer_getBuffer(message);
+    int maxBufPos = ByteBuffer_getSize(message);
+    int bufPos = 1;
+    int length;
+
+    /* unconfirmed PDU -> informationReport [0] -> variableListName [1] */
+    bufPos = BerDecoder_decodeLength(buffer, &length, bufPos, maxBufPos);
+
+    if ((bufPos < 0) || (bufPos >= maxBufPos) || (buffer[bufPos++] != 0xa0))
+        return false;
+
+    bufPos = BerDecoder_decodeLength(buffer, &length, bufPos, maxBufPos);
+
+    if ((bufPos < 0) || (bufPos >= maxBufPos))
+        return false;
+
+    return (buffer[bufPos] == 0xa1);
+}
+
+bool
+mmsClient_enqueueUnconfirmedPdu(MmsConnection self, ByteBuffer* message)
+{
+    if (isVariableListReport(message) == false)
+        return false;
+
+    Semaphore_wait(self->callbackExecutorLock);
+
+    MmsCallbackExecutorClient client = self->callbackExecutorClient;
+
+    if (client == NULL) {
+        Semaphore_post(self->callbackExecutorLock);
+        return false;
+    }
+
+    MmsClientCallbackExecutor executor = client->executor;
+
+    QueueEntry entry;
+
+    entry.client = client;
+    entry.size = ByteBuffer_getSize(message);
+    entry.buffer = (uint8_t*) GLOBAL_MALLOC(entry.size > 0 ? entry.size : 1);
+    entry.timestamp = Hal_getTimeInNs();
+
+    if (entry.buffer) {
+        memcpy(entry.buffer, ByteBuffer_getBuffer(message), entry.size);
+
+        Atomic_fetchAdd32(&(client->referenceCount), 1);
+
+        if (enqueueReport(executor, &entry) == false) {
+            if (DEBUG_MMS_CLIENT)
+                printf("MMS_CLIENT: callback executor queue overflow -> drop report\n");
+
+            releaseEntry(&entry);
+            Atomic_fetchAdd64(&(executor->dropped), 1);
+        }
+    }
+    else {
+        Atomic_fetchAdd64(&(executor->dropped), 1);
+    }
+
+    Semaphore_post(self->callbackExecutorLock);
+
+    return true;
+}
+
+MmsClientCallbackExecutor
+MmsClientCallbackExecutor_create(int queueSize, MmsCallbackExecutorOverflowPolicy overflowPolicy)
+{
+    if (queueSize < 1)
+        queueSize = DEFAULT_QUEUE_SIZE;
+
+    if (queueSize > MAX_QUEUE_SIZE)
+        queueSize = MAX_QUEUE_SIZE;
+
+    int32_t size = 1;
+
+    while (size < queueSize)
+        size = size * 2;
+
+    MmsClientCallbackExecutor self = (MmsClientCallbackExecutor) GLOBAL_CALLOC(1, sizeof(struct sMmsClientCallbackExecutor));
+
+    if (self == NULL)
+        return NULL;
+
+    self->cells = (QueueCell*) GLOBAL_CALLOC(size, sizeof(QueueCell));
+
+    if (self->cells == NULL) {
+        GLOBAL_FREEMEM(self);
+        return NULL;
+    }
+
+    int32_t i;
+
+    for (i = 0; i < size; i++)
+        self->cells[i].sequence = i;
+
+    self->mask = size - 1;
+    self->overflowPolicy = overflowPolicy;
+
+    self->wakeup = Semaphore_create(1);
+    Semaphore_wait(self->wakeup);
+
+    self->processingLock = Semaphore_create(1);
+
+    self->cellReleased = Semaphore_create(1);
+    Semaphore_wait(self->cellReleased);
+
+    self->producerLock = Semaphore_create(1);
+
+    self->running = 1;
+
+    self->thread = Thread_create(executorThread, self, false);
+
+    if (self->thread)
+        Thread_start(self->thread);
+
+    return self;
+}
+
+void
+MmsClientCallbackExecutor_getStatistics(MmsClientCallbackExecutor self, MmsClientCallbackExecutorStatistics* statistics)
+{
+    statistics->queueDepth = (uint32_t) queue_getDepth(self);
+    statistics->maxQueueDepth = (uint32_t) Atomic_load32(&(self->maxQueueDepth));
+    statistics->enqueued = Atomic_load64(&(self->enqueued));
+    statistics->processed = Atomic_load64(&(self->processed));
+    statistics->dropped = Atomic_load64(&(self->dropped));
+    statistics->maxLatencyInUs = Atomic_load64(&(self->maxLatency)) / 1000;
+
+    if (statistics->processed > 0)
+        statistics->averageLatencyInUs = (Atomic_load64(&(self->totalLatency)) / statistics->processed) / 1000;
+    else
+        statistics->averageLatencyInUs = 0;
+}
+
+void
+MmsClientCallbackExecutor_destroy(MmsClientCallbackExecutor self)
+{
+    if (self) {
+        Atomic_store32(&(self->running), 0);
+
+        wakeupExecutor(self);
+        releaseProducer(self);
+
+        if (self->thread)
+            Thread_destroy(self->thread);
+
+        QueueEntry entry;
+
+        while (queue_pop(self, &entry))
+            releaseEntry(&entry);
+
+        Semaphore_destroy(self->producerLock);
+        Semaphore_destroy(self->cellReleased);
+        Semaphore_destroy(self->processingLock);
+        Semaphore_destroy(self->wakeup);
+
+        GLOBAL_FREEMEM(self->cells);
+        GLOBAL_FREEMEM(self);
+    }
+}
+
+void
+MmsConnection_setCallbackExecutor(MmsConnection self, MmsClientCallbackExecutor executor)
+{
+    MmsCallbackExecutorClient newClient = NULL;
+
+    if (executor) {
+        newClient = (MmsCallbackExecutorClient) GLOBAL_MALLOC(sizeof(struct sMmsCallbackExecutorClient));
+
+        if (newClient == NULL)
+            return;
+
+        newClient->executor = executor;
+        newClient->connection = self;
+        newClient->active = 1;
+        newClient->referenceCount = 1;
+    }
+
+    Semaphore_wait(self->callbackExecutorLock);
+
+    MmsCallbackExecutorClient oldClient = self->callbackExecutorClient;
+
+    self->callbackExecutorClient = newClient;
+
+    Semaphore_post(self->callbackExecutorLock);
+
+    if (oldClient) {
+        Atomic_store32(&(oldClient->active), 0);
+
+        /* wait until a running handler of the connection has finished */
+        Semaphore_wait(oldClient->executor->processingLock);
+        Semaphore_post(oldClient->executor->processingLock);
+
+        releaseClient(oldClient);
+    }
+}
+
+#else /* (CONFIG_MMS_THREADLESS_STACK == 0) */
+
+MmsClientCallbackExecutor
+MmsClientCallbackExecutor_create(int queueSize, MmsCallbackExecutorOverflowPolicy overflowPolicy)
+{
+    (void)queueSize;
+    (void)overflowPolicy;
+
+    return NULL;
+}
+
+void
+MmsClientCallbackExecutor_getStatistics(MmsClientCallbackExecutor self, MmsClientCallbackExecutorStatistics* statistics)
+{
+    (void)self;
+
+    memset(statistics, 0, sizeof(MmsClientCallbackExecutorStatistics));
+}
+
+void
+MmsClientCallbackExecutor_destroy(MmsClientCallbackExecutor self)
+{
+    (void)self;
+}
+
+void
+MmsConnection_setCallbackExecutor(MmsConnection self, MmsClientCallbackExecutor executor)
+{
+    (void)self;
+    (void)executor;
+}
+
+#endif /* (CONFIG_MMS_THREADLESS_STACK == 0) */
@@ -37,7 +37,7 @@
 
 #define CONFIG_MMS_CONNECTION_DEFAULT_TIMEOUT 5000
 #define CONFIG_MMS_CONNECTION_DEFAULT_CONNECT_TIMEOUT 10000
-#define OUTSTANDING_CALLS 10
+#define CONFIG_MMS_CONNECTION_DEFAULT_OUTSTANDING_CALLS 10
 
 static void
 setConnectionState(MmsConnection self, MmsConnectionState newState)
@@ -62,9 +62,14 @@ getConnectionState(MmsConnection self)
     return state;
 }
 
-static void
-handleUnconfirmedMmsPdu(MmsConnection self, ByteBuffer* message)
+void
+mmsClient_handleUnconfirmedPdu(MmsConnection self, ByteBuffer* message)
 {
+    if (self->rawReportHandler != NULL) {
+        if (self->rawReportHandler(self->rawReportHandlerParameter, ByteBuffer_getBuffer(message), ByteBuffer_getSize(message)))
+            return;
+    }
+
     if (self->reportHandler != NULL) {
         MmsPdu_t* mmsPdu = NULL; /* allow asn1c to allocate structure */
 
@@ -228,7 +233,7 @@ handleUnconfirmedMmsPdu(MmsConnection self, ByteBuffer* message)
         }
         else {
             if (DEBUG_MMS_CLIENT)
-                printf("handleUnconfirmedMmsPdu: error parsing PDU at %u\n", (uint32_t) rval.consumed);
+                printf("mmsClient_handleUnconfirmedPdu: error parsing PDU at %u\n", (uint32_t) rval.consumed);
         }
 
         asn_DEF_MmsPdu.free_struct(&asn_DEF_MmsPdu, mmsPdu, 0);
@@ -248,70 +253,134 @@ getNextInvokeId(MmsConnection self)
     return nextInvokeId;
 }
 
-static MmsOutstandingCall
-checkForOutstandingCall(MmsConnection self, uint32_t invokeId)
+static int
+getOutstandingCallsTableSize(int maxOutstandingCalls)
 {
-    int i = 0;
+    int tableSize = 16;
 
-    Semaphore_wait(self->outstandingCallsLock);
+    /* invokeIds are allocated sequentially -> twice the window keeps collisions rare */
+    while (tableSize < (maxOutstandingCalls * 2))
+        tableSize = tableSize * 2;
 
-    for (i = 0; i < OUTSTANDING_CALLS; i++) {
-        if (self->outstandingCalls[i].isUsed) {
-            if (self->outstandingCalls[i].invokeId == invokeId) {
-                Semaphore_post(self->outstandingCallsLock);
-                return &(self->outstandingCalls[i]);
-            }
-        }
-    }
+    return tableSize;
+}
 
-    Semaphore_post(self->outstandingCallsLock);
+static int
+getOutstandingCallsLimit(MmsConnection self)
+{
+    int maxServOutstandingCalling = self->parameters.maxServOutstandingCalling;
 
-    return NULL;
+    /* keep the default window unless the application has set a limit */
+    if (self->maxOutstandingCallsSet == false)
+        return self->maxOutstandingCalls;
+
+    /* never send more parallel requests than negotiated with the server */
+    if ((maxServOutstandingCalling > 0) && (maxServOutstandingCalling < self->maxOutstandingCalls))
+        return maxServOutstandingCalling;
+
+    return self->maxOutstandingCalls;
 }
 
+/* has to be called with outstandingCallsLock */
+static void
+releaseOutstandingCall(MmsConnection self, MmsOutstandingCall call)
+{
+    if (call->isUsed) {
+        call->isUsed = false;
+
+        self->numberOfOutstandingCalls--;
+
+        if (call != &(self->outstandingCalls[call->invokeId & (self->outstandingCallsTableSize - 1)]))
+            self->numberOfDisplacedCalls--;
+    }
+}
+
+/*
+ * Copy the call with the given invokeId to the provided buffer and release the slot. The slot is released
+ * before the response handler is called so that the handler (or a thread woken up by the handler) can
+ * immediately send the next request.
+ */
 static bool
-addToOutstandingCalls(MmsConnection self, uint32_t invokeId, eMmsOutstandingCallType type, void* userCallback, void* userParameter, MmsClientInternalParameter internalParameter)
+takeOutstandingCall(MmsConnection self, uint32_t invokeId, MmsOutstandingCall callBuffer)
 {
-    int i = 0;
+    MmsOutstandingCall call = NULL;
 
     Semaphore_wait(self->outstandingCallsLock);
 
-    for (i = 0; i < OUTSTANDING_CALLS; i++) {
-        if (self->outstandingCalls[i].isUsed == false) {
-            self->outstandingCalls[i].isUsed = true;
-            self->outstandingCalls[i].invokeId = invokeId;
-            self->outstandingCalls[i].timeout = Hal_getTimeInMs() + self->requestTimeout;
-            self->outstandingCalls[i].type = type;
-            self->outstandingCalls[i].userCallback = userCallback;
-            self->outstandingCalls[i].userParameter = userParameter;
-            self->outstandingCalls[i].internalParameter = internalParameter;
-            Semaphore_post(self->outstandingCallsLock);
-            return true;
+    MmsOutstandingCall slot = &(self->outstandingCalls[invokeId & (self->outstandingCallsTableSize - 1)]);
+
+    if (slot->isUsed && (slot->invokeId == invokeId)) {
+        call = slot;
+    }
+    else if (self->numberOfDisplacedCalls > 0) {
+        int i;
+
+        for (i = 0; i < self->outstandingCallsTableSize; i++) {
+            if (self->outstandingCalls[i].isUsed) {
+                if (self->outstandingCalls[i].invokeId == invokeId) {
+                    call = &(self->outstandingCalls[i]);
+                    break;
+                }
+            }
         }
     }
 
+    if (call) {
+        *callBuffer = *call;
+
+        releaseOutstandingCall(self, call);
+    }
+
     Semaphore_post(self->outstandingCallsLock);
 
-    return false;
+    return (call != NULL);
 }
 
-static void
-removeFromOutstandingCalls(MmsConnection self, uint32_t invokeId)
+static bool
+addToOutstandingCalls(MmsConnection self, uint32_t invokeId, eMmsOutstandingCallType type, void* userCallback, void* userParameter, MmsClientInternalParameter internalParameter)
 {
-    int i = 0;
+    MmsOutstandingCall call = NULL;
 
     Semaphore_wait(self->outstandingCallsLock);
 
-    for (i = 0; i < OUTSTANDING_CALLS; i++) {
-        if (self->outstandingCalls[i].isUsed) {
-            if (self->outstandingCalls[i].invokeId == invokeId) {
-                self->outstandingCalls[i].isUsed = false;
-                break;
+    if (self->numberOfOutstandingCalls < getOutstandingCallsLimit(self)) {
+
+        call = &(self->outstandingCalls[invokeId & (self->outstandingCallsTableSize - 1)]);
+
+        if (call->isUsed) {
+            /* slot is occupied by an old call -> use any free slot */
+            int i;
+
+            call = NULL;
+
+            for (i = 0; i < self->outstandingCallsTableSize; i++) {
+                if (self->outstandingCalls[i].isUsed == false) {
+                    call = &(self->outstandingCalls[i]);
+                    self->numberOfDisplacedCalls++;
+                    break;
+                }
             }
         }
     }
 
+    if (call) {
+        call->isUsed = true;
+        call->invokeId = invokeId;
+        call->timeout = Hal_getTimeInMs() + self->requestTimeout;
+        call->type = type;
+        call->userCallback = userCallback;
+        call->userParameter = userParameter;
+        call->internalParameter = internalParameter;
+
+        if (call->timeout < self->nextOutstandingCallTimeout)
+            self->nextOutstandingCallTimeout = call->timeout;
+
+        self->numberOfOutstandingCalls++;
+    }
+
     Semaphore_post(self->outstandingCallsLock);
+
+    return (call != NULL);
 }
 
 MmsOutstandingCall
@@ -321,7 +390,7 @@ mmsClient_getMatchingObtainFileRequest(MmsConnection self, const char* filename)
 
     Semaphore_wait(self->outstandingCallsLock);
 
-    for (i = 0; i < OUTSTANDING_CALLS; i++) {
+    for (i = 0; i < self->outstandingCallsTableSize; i++) {
         if (self->outstandingCalls[i].isUsed) {
 
             if (self->outstandingCalls[i].type == MMS_CALL_TYPE_OBTAIN_FILE) {
@@ -719,6 +788,31 @@ handleAsyncResponse(MmsConnection self, ByteBuffer* response, uint32_t bufPos, M
 
         }
     }
+    else if ((outstandingCall->type == MMS_CALL_TYPE_READ_VARIABLE_INTO) ||
+            (outstandingCall->type == MMS_CALL_TYPE_READ_MULTIPLE_VARIABLES_INTO) ||
+            (outstandingCall->type == MMS_CALL_TYPE_READ_VARIABLE_INTO_TARGET)) {
+
+        MmsConnection_GenericServiceHandler handler =
+                (MmsConnection_GenericServiceHandler) outstandingCall->userCallback;
+
+        if (err != MMS_ERROR_NONE)
+            handler(outstandingCall->invokeId, outstandingCall->userParameter, err, false);
+        else {
+            if (response) {
+                if (outstandingCall->type == MMS_CALL_TYPE_READ_VARIABLE_INTO_TARGET) {
+                    MmsClientReadIntoTarget* target = (MmsClientReadIntoTarget*) outstandingCall->internalParameter.ptr;
+
+                    err = mmsClient_parseReadResponseInto(response, bufPos, target->value, false, &(target->dataAccessError));
+                }
+                else {
+                    err = mmsClient_parseReadResponseInto(response, bufPos, (MmsValue*) outstandingCall->internalParameter.ptr,
+                            (outstandingCall->type == MMS_CALL_TYPE_READ_MULTIPLE_VARIABLES_INTO), NULL);
+                }
+
+                handler(outstandingCall->invokeId, outstandingCall->userParameter, err, (err == MMS_ERROR_NONE));
+            }
+        }
+    }
     else if (outstandingCall->type == MMS_CALL_TYPE_WRITE_VARIABLE) {
 
         MmsConnection_WriteVariableHandler handler =
@@ -986,9 +1080,6 @@ handleAsyncResponse(MmsConnection self, ByteBuffer* response, uint32_t bufPos, M
                 handler(outstandingCall->invokeId, outstandingCall->userParameter, MMS_ERROR_PARSING_RESPONSE, NULL, 0, 0, false);
         }
     }
-
-    if (err != MMS_ERROR_SERVICE_TIMEOUT)
-        removeFromOutstandingCalls(self, outstandingCall->invokeId);
 }
 
 static bool
@@ -1006,31 +1097,50 @@ mmsIsoCallback(IsoIndication indication, void* parameter, ByteBuffer* payload)
 
         uint64_t currentTime = Hal_getTimeInMs();
 
-        int i = 0;
+        if (currentTime > self->nextOutstandingCallTimeout) {
 
-        for (i = 0; i < OUTSTANDING_CALLS; i++) {
+            uint64_t nextTimeout = UINT64_MAX;
 
+            int i = 0;
+
+            /* calls added while scanning will lower the value again */
             Semaphore_wait(self->outstandingCallsLock);
+            self->nextOutstandingCallTimeout = UINT64_MAX;
+            Semaphore_post(self->outstandingCallsLock);
 
-            if (self->outstandingCalls[i].isUsed) {
+            for (i = 0; i < self->outstandingCallsTableSize; i++) {
 
-                Semaphore_post(self->outstandingCallsLock);
+                struct sMmsOutstandingCall expiredCall;
+                bool isExpired = false;
 
-                if (currentTime > self->outstandingCalls[i].timeout) {
+                Semaphore_wait(self->outstandingCallsLock);
 
-                    if (self->outstandingCalls[i].type != MMS_CALL_TYPE_NONE)
-                        handleAsyncResponse(self, NULL, 0, &(self->outstandingCalls[i]), MMS_ERROR_SERVICE_TIMEOUT);
+                if (self->outstandingCalls[i].isUsed) {
 
-                    Semaphore_wait(self->outstandingCallsLock);
+                    if (currentTime > self->outstandingCalls[i].timeout) {
+                        expiredCall = self->outstandingCalls[i];
 
-                    self->outstandingCalls[i].isUsed = false;
+                        releaseOutstandingCall(self, &(self->outstandingCalls[i]));
 
-                    Semaphore_post(self->outstandingCallsLock);
+                        isExpired = true;
+                    }
+                    else if (self->outstandingCalls[i].timeout < nextTimeout) {
+                        nextTimeout = self->outstandingCalls[i].timeout;
+                    }
                 }
-            }
-            else {
+
                 Semaphore_post(self->outstandingCallsLock);
+
+                if (isExpired && (expiredCall.type != MMS_CALL_TYPE_NONE))
+                    handleAsyncResponse(self, NULL, 0, &expiredCall, MMS_ERROR_SERVICE_TIMEOUT);
             }
+
+            Semaphore_wait(self->outstandingCallsLock);
+
+            if (nextTimeout < self->nextOutstandingCallTimeout)
+                self->nextOutstandingCallTimeout = nextTimeout;
+
+            Semaphore_post(self->outstandingCallsLock);
         }
 
         if (self->concludeHandler) {
@@ -1057,23 +1167,25 @@ mmsIsoCallback(IsoIndication indication, void* parameter, ByteBuffer* payload)
         {
             int i;
 
-            for (i = 0; i < OUTSTANDING_CALLS; i++) {
+            for (i = 0; i < self->outstandingCallsTableSize; i++) {
+
+                struct sMmsOutstandingCall pendingCall;
+                bool isPending = false;
 
                 Semaphore_wait(self->outstandingCallsLock);
 
                 if (self->outstandingCalls[i].isUsed) {
+                    pendingCall = self->outstandingCalls[i];
 
-                    Semaphore_post(self->outstandingCallsLock);
-
-                    if (self->outstandingCalls[i].type != MMS_CALL_TYPE_NONE)
-                        handleAsyncResponse(self, NULL, 0, &(self->outstandingCalls[i]), MMS_ERROR_SERVICE_TIMEOUT);
+                    releaseOutstandingCall(self, &(self->outstandingCalls[i]));
 
-                    Semaphore_wait(self->outstandingCallsLock);
-
-                    self->outstandingCalls[i].isUsed = false;
+                    isPending = true;
                 }
 
                 Semaphore_post(self->outstandingCallsLock);
+
+                if (isPending && (pendingCall.type != MMS_CALL_TYPE_NONE))
+                    handleAsyncResponse(self, NULL, 0, &pendingCall, MMS_ERROR_SERVICE_TIMEOUT);
             }
         }
 
@@ -1140,7 +1252,10 @@ mmsIsoCallback(IsoIndication indication, void* parameter, ByteBuffer* payload)
         return false;
     }
     else if (tag == 0xa3) { /* unconfirmed PDU */
-        handleUnconfirmedMmsPdu(self, payload);
+#if (CONFIG_MMS_THREADLESS_STACK == 0)
+        if (mmsClient_enqueueUnconfirmedPdu(self, payload) == false)
+#endif
+            mmsClient_handleUnconfirmedPdu(self, payload);
     }
     else if (tag == 0x8b) { /* conclude request PDU */
         if (DEBUG_MMS_CLIENT)
@@ -1187,14 +1302,14 @@ mmsIsoCallback(IsoIndication indication, void* parameter, ByteBuffer* payload)
         else {
 
             if (hasInvokeId) {
-                MmsOutstandingCall call = checkForOutstandingCall(self, invokeId);
+                struct sMmsOutstandingCall call;
 
-                if (call) {
+                if (takeOutstandingCall(self, invokeId, &call)) {
 
                     MmsError err = convertServiceErrorToMmsError(serviceError);
 
-                    if (call->type != MMS_CALL_TYPE_NONE) {
-                        handleAsyncResponse(self, NULL, 0, call, err);
+                    if (call.type != MMS_CALL_TYPE_NONE) {
+                        handleAsyncResponse(self, NULL, 0, &call, err);
                     }
                     else {
                         if (DEBUG_MMS_CLIENT)
@@ -1233,14 +1348,14 @@ mmsIsoCallback(IsoIndication indication, void* parameter, ByteBuffer* payload)
                 printf("MMS_CLIENT: reject PDU invokeID: %u type: %i reason: %i\n", invokeId, rejectType, rejectReason);
 
             if (hasInvokeId) {
-                MmsOutstandingCall call = checkForOutstandingCall(self, invokeId);
+                struct sMmsOutstandingCall call;
 
-                if (call) {
+                if (takeOutstandingCall(self, invokeId, &call)) {
 
                     MmsError err = convertRejectCodesToMmsError(rejectType, rejectReason);
 
-                    if (call->type != MMS_CALL_TYPE_NONE) {
-                        handleAsyncResponse(self, NULL, 0, call, err);
+                    if (call.type != MMS_CALL_TYPE_NONE) {
+                        handleAsyncResponse(self, NULL, 0, &call, err);
                     }
                     else {
 
@@ -1285,12 +1400,12 @@ mmsIsoCallback(IsoIndication indication, void* parameter, ByteBuffer* payload)
 
             bufPos += invokeIdLength;
 
-            MmsOutstandingCall call = checkForOutstandingCall(self, invokeId);
+            struct sMmsOutstandingCall call;
 
-            if (call) {
+            if (takeOutstandingCall(self, invokeId, &call)) {
 
-                if (call->type != MMS_CALL_TYPE_NONE) {
-                    handleAsyncResponse(self, payload, bufPos, call, MMS_ERROR_NONE);
+                if (call.type != MMS_CALL_TYPE_NONE) {
+                    handleAsyncResponse(self, payload, bufPos, &call, MMS_ERROR_NONE);
                 }
                 else {
                     if (DEBUG_MMS_CLIENT)
@@ -1493,7 +1608,12 @@ MmsConnection_createInternal(TLSConfiguration tlsConfig, bool createThread)
         self->concludeHandlerParameter = NULL;
         self->concludeTimeout = 0;
 
-        self->outstandingCalls = (MmsOutstandingCall) GLOBAL_CALLOC(OUTSTANDING_CALLS, sizeof(struct sMmsOutstandingCall));
+        self->maxOutstandingCalls = CONFIG_MMS_CONNECTION_DEFAULT_OUTSTANDING_CALLS;
+        self->proposedMaxServOutstandingCalling = DEFAULT_MAX_SERV_OUTSTANDING_CALLING;
+        self->outstandingCallsTableSize = getOutstandingCallsTableSize(self->maxOutstandingCalls);
+        self->nextOutstandingCallTimeout = UINT64_MAX;
+
+        self->outstandingCalls = (MmsOutstandingCall) GLOBAL_CALLOC(self->outstandingCallsTableSize, sizeof(struct sMmsOutstandingCall));
 
         self->isoParameters = IsoConnectionParameters_create();
 
@@ -1523,6 +1643,9 @@ MmsConnection_createInternal(TLSConfiguration tlsConfig, bool createThread)
         self->createThread = createThread;
         self->connectionHandlingThread = NULL;
         self->connectionThreadRunning = false;
+
+        self->callbackExecutorLock = Semaphore_create(1);
+        self->callbackExecutorClient = NULL;
 #endif
     }
 
@@ -1562,6 +1685,11 @@ MmsConnection_destroy(MmsConnection self)
     }
 #endif
 
+#if (CONFIG_MMS_THREADLESS_STACK == 0)
+    MmsConnection_setCallbackExecutor(self, NULL);
+    Semaphore_destroy(self->callbackExecutorLock);
+#endif
+
     if (self->isoClient != NULL)
         IsoClientConnection_destroy(self->isoClient);
 
@@ -1658,6 +1786,52 @@ MmsConnection_getRequestTimeout(MmsConnection self)
     return self->requestTimeout;
 }
 
+bool
+MmsConnection_setMaxOutstandingCalls(MmsConnection self, int maxOutstandingCalls)
+{
+    bool success = false;
+
+    if (maxOutstandingCalls < 1)
+        return false;
+
+    Semaphore_wait(self->outstandingCallsLock);
+
+    if (self->numberOfOutstandingCalls == 0) {
+        int tableSize = getOutstandingCallsTableSize(maxOutstandingCalls);
+
+        MmsOutstandingCall outstandingCalls = self->outstandingCalls;
+
+        if (tableSize != self->outstandingCallsTableSize)
+            outstandingCalls = (MmsOutstandingCall) GLOBAL_CALLOC(tableSize, sizeof(struct sMmsOutstandingCall));
+
+        if (outstandingCalls) {
+            if (outstandingCalls != self->outstandingCalls) {
+                GLOBAL_FREEMEM(self->outstandingCalls);
+
+                self->outstandingCalls = outstandingCalls;
+                self->outstandingCallsTableSize = tableSize;
+            }
+
+            self->numberOfDisplacedCalls = 0;
+            self->maxOutstandingCalls = maxOutstandingCalls;
+            self->maxOutstandingCallsSet = true;
+            self->proposedMaxServOutstandingCalling = maxOutstandingCalls;
+
+            success = true;
+        }
+    }
+
+    Semaphore_post(self->outstandingCallsLock);
+
+    return success;
+}
+
+int
+MmsConnection_getMaxOutstandingCalls(MmsConnection self)
+{
+    return getOutstandingCallsLimit(self);
+}
+
 void
 MmsConnection_setConnectTimeout(MmsConnection self, uint32_t timeoutInMs)
 {
@@ -1803,11 +1977,14 @@ MmsConnection_connectAsync(MmsConnection self, MmsError* mmsError, const char* s
     }
 #endif /* (CONFIG_MMS_RAW_MESSAGE_LOGGING == 1) */
 
+    /* set the state before the connection can be handled by another thread (e.g. IedClientReactor) */
+    setConnectionState(self, MMS_CONNECTION_STATE_CONNECTING);
+
     if (IsoClientConnection_associateAsync(self->isoClient, self->connectTimeout, self->requestTimeout)) {
-        setConnectionState(self, MMS_CONNECTION_STATE_CONNECTING);
         *mmsError = MMS_ERROR_NONE;
     }
     else {
+        setConnectionState(self, MMS_CONNECTION_STATE_CLOSED);
         *mmsError = MMS_ERROR_OTHER;
     }
 }
@@ -1953,6 +2130,13 @@ MmsConnection_setInformationReportHandler(MmsConnection self, MmsInformationRepo
     self->reportHandlerParameter = parameter;
 }
 
+void
+mmsClient_setRawInformationReportHandler(MmsConnection self, MmsRawInformationReportHandler handler, void* parameter)
+{
+    self->rawReportHandler = handler;
+    self->rawReportHandlerParameter = parameter;
+}
+
 static void
 mmsClient_getNameListSingleRequestAsync(
         MmsConnection self,
@@ -2265,6 +2449,125 @@ MmsConnection_readVariable(MmsConnection self, MmsError* mmsError,
     return value;
 }
 
+struct readIntoParameters
+{
+    Semaphore sem;
+    MmsError err;
+};
+
+static void
+readIntoHandler(uint32_t invokeId, void* parameter, MmsError mmsError, bool success)
+{
+    (void)invokeId;
+    (void)success;
+
+    struct readIntoParameters* parameters = (struct readIntoParameters*) parameter;
+
+    parameters->err = mmsError;
+
+    /* unblock user thread */
+    Semaphore_post(parameters->sem);
+}
+
+static void
+readVariableIntoAsync(MmsConnection self, uint32_t* usedInvokeId, MmsError* mmsError,
+        const char* domainId, const char* itemId, eMmsOutstandingCallType callType, void* target,
+        MmsConnection_GenericServiceHandler handler, void* parameter)
+{
+    if (getConnectionState(self) != MMS_CONNECTION_STATE_CONNECTED) {
+        if (mmsError)
+            *mmsError = MMS_ERROR_CONNECTION_LOST;
+
+        goto exit_function;
+    }
+
+    ByteBuffer* payload = IsoClientConnection_allocateTransmitBuffer(self->isoClient);
+
+    uint32_t invokeId = getNextInvokeId(self);
+
+    if (usedInvokeId)
+        *usedInvokeId = invokeId;
+
+    mmsClient_createReadRequest(invokeId, domainId, itemId, payload);
+
+    MmsClientInternalParameter intParam;
+    intParam.ptr = target;
+
+    MmsError err = sendAsyncRequest(self, invokeId, payload, callType, handler, parameter, intParam);
+
+    if (mmsError)
+        *mmsError = err;
+
+exit_function:
+    return;
+}
+
+static void
+readVariableInto(MmsConnection self, MmsError* mmsError, const char* domainId, const char* itemId,
+        eMmsOutstandingCallType callType, void* target)
+{
+    MmsError err = MMS_ERROR_NONE;
+
+    struct readIntoParameters parameter;
+
+    parameter.sem = Semaphore_create(1);
+    parameter.err = MMS_ERROR_NONE;
+
+    Semaphore_wait(parameter.sem);
+
+    readVariableIntoAsync(self, NULL, &err, domainId, itemId, callType, target, readIntoHandler, &parameter);
+
+    if (err == MMS_ERROR_NONE) {
+        Semaphore_wait(parameter.sem);
+
+        err = parameter.err;
+    }
+
+    Semaphore_destroy(parameter.sem);
+
+    if (mmsError)
+        *mmsError = err;
+}
+
+void
+MmsConnection_readVariableIntoAsync(MmsConnection self, uint32_t* usedInvokeId, MmsError* mmsError,
+        const char* domainId, const char* itemId, MmsValue* value,
+        MmsConnection_GenericServiceHandler handler, void* parameter)
+{
+    if (value == NULL) {
+        if (mmsError)
+            *mmsError = MMS_ERROR_INVALID_ARGUMENTS;
+
+        return;
+    }
+
+    readVariableIntoAsync(self, usedInvokeId, mmsError, domainId, itemId, MMS_CALL_TYPE_READ_VARIABLE_INTO, value,
+            handler, parameter);
+}
+
+void
+MmsConnection_readVariableInto(MmsConnection self, MmsError* mmsError,
+        const char* domainId, const char* itemId, MmsValue* value)
+{
+    if (value == NULL) {
+        if (mmsError)
+            *mmsError = MMS_ERROR_INVALID_ARGUMENTS;
+
+        return;
+    }
+
+    readVariableInto(self, mmsError, domainId, itemId, MMS_CALL_TYPE_READ_VARIABLE_INTO, value);
+}
+
+void
+mmsClient_readVariableIntoTarget(MmsConnection self, MmsError* mmsError,
+        const char* domainId, const char* itemId, MmsClientReadIntoTarget* target)
+{
+    target->dataAccessError = -1;
+
+    readVariableInto(self, mmsError, domainId, itemId, MMS_CALL_TYPE_READ_VARIABLE_INTO_TARGET, target);
+}
+
 void
 MmsConnection_readVariableComponentAsync(MmsConnection self, uint32_t* usedInvokeId, MmsError* mmsError,
         const char* domainId, const char* itemId, const char* componentId,
@@ -2534,6 +2837,80 @@ exit_function:
     return;
 }
 
+void
+MmsConnection_readMultipleVariablesIntoAsync(MmsConnection self, uint32_t* usedInvokeId, MmsError* mmsError,
+        const char* domainId, LinkedList /*<char*>*/items, MmsValue* values,
+        MmsConnection_GenericServiceHandler handler, void* parameter)
+{
+    if (getConnectionState(self) != MMS_CONNECTION_STATE_CONNECTED) {
+        if (mmsError)
+            *mmsError = MMS_ERROR_CONNECTION_LOST;
+        goto exit_function;
+    }
+
+    if ((values == NULL) || (MmsValue_getType(values) != MMS_ARRAY) ||
+            (MmsValue_getArraySize(values) != LinkedList_size(items)))
+    {
+        if (mmsError)
+            *mmsError = MMS_ERROR_INVALID_ARGUMENTS;
+        goto exit_function;
+    }
+
+    ByteBuffer* payload = IsoClientConnection_allocateTransmitBuffer(self->isoClient);
+
+    uint32_t invokeId = getNextInvokeId(self);
+
+    if (usedInvokeId)
+        *usedInvokeId = invokeId;
+
+    if (mmsClient_createReadRequestMultipleValues(invokeId, domainId, items, payload) > 0) {
+        MmsClientInternalParameter intParam;
+        intParam.ptr = values;
+
+        MmsError err = sendAsyncRequest(self, invokeId, payload, MMS_CALL_TYPE_READ_MULTIPLE_VARIABLES_INTO, handler, parameter, intParam);
+
+        if (mmsError)
+            *mmsError = err;
+    }
+    else {
+        IsoClientConnection_releaseTransmitBuffer(self->isoClient);
+
+        if (mmsError)
+            *mmsError = MMS_ERROR_RESOURCE_CAPABILITY_UNAVAILABLE;
+    }
+
+exit_function:
+    return;
+}
+
+void
+MmsConnection_readMultipleVariablesInto(MmsConnection self, MmsError* mmsError,
+        const char* domainId, LinkedList /*<char*>*/items, MmsValue* values)
+{
+    MmsError err = MMS_ERROR_NONE;
+
+    struct readIntoParameters parameter;
+
+    parameter.sem = Semaphore_create(1);
+    parameter.err = MMS_ERROR_NONE;
+
+    Semaphore_wait(parameter.sem);
+
+    MmsConnection_readMultipleVariablesIntoAsync(self, NULL, &err, domainId, items, values,
+            readIntoHandler, &parameter);
+
+    if (err == MMS_ERROR_NONE) {
+        Semaphore_wait(parameter.sem);
+
+        err = parameter.err;
+    }
+
+    Semaphore_destroy(parameter.sem);
+
+    if (mmsError)
+        *mmsError = err;
+}
+
 MmsValue*
 MmsConnection_readNamedVariableListValues(MmsConnection self, MmsError* mmsError,
         const char* domainId, const char* listName,
@@ -39,7 +39,7 @@ static uint8_t servicesSupported[] = { 0xee, 0x1c, 0x00, 0x00, 0x04, 0x08, 0x00,
 void
 mmsClient_createInitiateRequest(MmsConnection self, ByteBuffer* message)
 {
-    int maxServerOutstandingCalling = DEFAULT_MAX_SERV_OUTSTANDING_CALLING;
+    int maxServerOutstandingCalling = self->proposedMaxServOutstandingCalling;
     int maxServerOutstandingCalled = DEFAULT_MAX_SERV_OUTSTANDING_CALLED;
     int dataStructureNestingLevel = DEFAULT_DATA_STRUCTURE_NESTING_LEVEL;
 
@@ -170,7 +170,7 @@ mmsClient_parseInitiateResponse(MmsConnection self, ByteBuffer* response)
     self->parameters.maxPduSize = CONFIG_MMS_MAXIMUM_PDU_SIZE;
     self->parameters.dataStructureNestingLevel = DEFAULT_DATA_STRUCTURE_NESTING_LEVEL;
     self->parameters.maxServOutstandingCalled = DEFAULT_MAX_SERV_OUTSTANDING_CALLED;
-    self->parameters.maxServOutstandingCalling = DEFAULT_MAX_SERV_OUTSTANDING_CALLING;
+    self->parameters.maxServOutstandingCalling = self->proposedMaxServOutstandingCalling;
 
     int bufPos = 1; /* ignore tag - already checked */
 
@@ -203,8 +203,8 @@ mmsClient_parseInitiateResponse(MmsConnection self, ByteBuffer* response)
         case 0x81:  /* proposed-max-serv-outstanding-calling */
             self->parameters.maxServOutstandingCalling = BerDecoder_decodeUint32(buffer, length, bufPos);
 
-            if (self->parameters.maxServOutstandingCalling > DEFAULT_MAX_SERV_OUTSTANDING_CALLING)
-                self->parameters.maxServOutstandingCalling = DEFAULT_MAX_SERV_OUTSTANDING_CALLING;
+            if (self->parameters.maxServOutstandingCalling > self->proposedMaxServOutstandingCalling)
+                self->parameters.maxServOutstandingCalling = self->proposedMaxServOutstandingCalling;
 
             break;
 
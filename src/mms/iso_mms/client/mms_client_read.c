@@ -392,6 +392,122 @@ mmsClient_parseReadResponse(ByteBuffer* message, uint32_t* invokeId, bool create
     return valueList;
 }
 
+/* returns the number of access results or -1 when the results cannot be stored in the value */
+static int
+checkListOfAccessResults(uint8_t* buffer, int bufPos, int endPos, MmsValue* value, bool isList, MmsError* mmsError,
+        int* dataAccessError)
+{
+    int numberOfResults = 0;
+
+    while (bufPos < endPos) {
+        MmsValue* element = value;
+
+        if (isList) {
+            if (numberOfResults >= MmsValue_getArraySize(value)) {
+                *mmsError = MMS_ERROR_DEFINITION_TYPE_INCONSISTENT;
+                return -1;
+            }
+
+            element = MmsValue_getElement(value, numberOfResults);
+        }
+        else if (numberOfResults > 0) {
+            *mmsError = MMS_ERROR_PARSING_RESPONSE;
+            return -1;
+        }
+
+        if (buffer[bufPos] == 0x80) { /* failure */
+            int length;
+            int elementPos = BerDecoder_decodeLength(buffer, &length, bufPos + 1, endPos);
+
+            if ((elementPos < 0) || (length < 1)) {
+                *mmsError = MMS_ERROR_PARSING_RESPONSE;
+                return -1;
+            }
+
+            uint32_t dataAccessErrorCode = BerDecoder_decodeUint32(buffer, length, elementPos);
+
+            *mmsError = mmsClient_mapDataAccessErrorToMmsError(dataAccessErrorCode);
+
+            if (dataAccessError)
+                *dataAccessError = (int) dataAccessErrorCode;
+
+            return -1;
+        }
+
+        if ((element == NULL) || (MmsValue_isMatchingMmsData(element, buffer, bufPos, endPos, &bufPos) == false)) {
+            *mmsError = MMS_ERROR_DEFINITION_TYPE_INCONSISTENT;
+            return -1;
+        }
+
+        numberOfResults++;
+    }
+
+    if ((numberOfResults == 0) || (isList && (numberOfResults != MmsValue_getArraySize(value)))) {
+        *mmsError = MMS_ERROR_DEFINITION_TYPE_INCONSISTENT;
+        return -1;
+    }
+
+    return numberOfResults;
+}
+
+MmsError
+mmsClient_parseReadResponseInto(ByteBuffer* message, int bufPos, MmsValue* value, bool isList, int* dataAccessError)
+{
+    MmsError mmsError = MMS_ERROR_NONE;
+
+    uint8_t* buffer = ByteBuffer_getBuffer(message);
+    int maxBufPos = ByteBuffer_getSize(message);
+    int length;
+
+    if (isList && (MmsValue_getType(value) != MMS_ARRAY))
+        return MMS_ERROR_INVALID_ARGUMENTS;
+
+    if ((bufPos >= maxBufPos) || (buffer[bufPos++] != 0xa4))
+        return MMS_ERROR_PARSING_RESPONSE;
+
+    bufPos = BerDecoder_decodeLength(buffer, &length, bufPos, maxBufPos);
+
+    if (bufPos < 0)
+        return MMS_ERROR_PARSING_RESPONSE;
+
+    /* skip optional variableAccessSpecification */
+    if ((bufPos < maxBufPos) && (buffer[bufPos] == 0xa0)) {
+        bufPos = BerDecoder_decodeLength(buffer, &length, bufPos + 1, maxBufPos);
+
+        if (bufPos < 0)
+            return MMS_ERROR_PARSING_RESPONSE;
+
+        bufPos += length;
+    }
+
+    if ((bufPos >= maxBufPos) || (buffer[bufPos++] != 0xa1))
+        return MMS_ERROR_PARSING_RESPONSE;
+
+    bufPos = BerDecoder_decodeLength(buffer, &length, bufPos, maxBufPos);
+
+    if (bufPos < 0)
+        return MMS_ERROR_PARSING_RESPONSE;
+
+    int endPos = bufPos + length;
+
+    /* check all results first to not change the value when the response doesn't match */
+    int numberOfResults = checkListOfAccessResults(buffer, bufPos, endPos, value, isList, &mmsError, dataAccessError);
+
+    if (numberOfResults < 0)
+        return mmsError;
+
+    int i;
+
+    for (i = 0; i < numberOfResults; i++) {
+        MmsValue* element = isList ? MmsValue_getElement(value, i) : value;
+
+        if (MmsValue_updateFromMmsData(element, buffer, bufPos, endPos, &bufPos) == false)
+            return MMS_ERROR_PARSING_RESPONSE;
+    }
+
+    return MMS_ERROR_NONE;
+}
+
 static ReadRequest_t*
 createReadRequest(MmsPdu_t* mmsPdu)
 {
@@ -32,8 +32,8 @@
 
 #include "stack_config.h"
 
-static MmsError
-mapDataAccessErrorToMmsError(uint32_t dataAccessError)
+MmsError
+mmsClient_mapDataAccessErrorToMmsError(uint32_t dataAccessError)
 {
     switch (dataAccessError) {
     case 0:
@@ -185,7 +185,7 @@ mmsClient_parseWriteResponse(ByteBuffer* message, int32_t bufPos, MmsError* mmsE
                     BerDecoder_decodeUint32(buf, length, bufPos);
 
             if (dataAccessErrorCode < 13) {
-                *mmsError = mapDataAccessErrorToMmsError(dataAccessErrorCode);
+                *mmsError = mmsClient_mapDataAccessErrorToMmsError(dataAccessErrorCode);
                 retVal = (MmsDataAccessError) dataAccessErrorCode;
             }
             else {
@@ -29,6 +29,10 @@
 void
 MmsVariableSpecification_destroy(MmsVariableSpecification* typeSpec)
 {
+    /* elements of a structure can be detached (NULL) when they are owned elsewhere */
+    if (typeSpec == NULL)
+        return;
+
     if (typeSpec->name != NULL)
         GLOBAL_FREEMEM(typeSpec->name);
 
@@ -48,6 +52,75 @@ MmsVariableSpecification_destroy(MmsVariableSpecification* typeSpec)
     GLOBAL_FREEMEM(typeSpec);
 }
 
+MmsVariableSpecification*
+MmsVariableSpecification_clone(const MmsVariableSpecification* typeSpec)
+{
+    MmsVariableSpecification* self = (MmsVariableSpecification*) GLOBAL_MALLOC(sizeof(MmsVariableSpecification));
+
+    if (self == NULL)
+        return NULL;
+
+    memcpy(self, typeSpec, sizeof(MmsVariableSpecification));
+
+    self->name = NULL;
+
+    if (typeSpec->type == MMS_STRUCTURE) {
+        self->typeSpec.structure.elementCount = 0;
+        self->typeSpec.structure.elements = NULL;
+    }
+    else if (typeSpec->type == MMS_ARRAY) {
+        self->typeSpec.array.elementTypeSpec = NULL;
+    }
+
+    if (typeSpec->name) {
+        self->name = StringUtils_copyString(typeSpec->name);
+
+        if (self->name == NULL)
+            goto exit_error;
+    }
+
+    if (typeSpec->type == MMS_STRUCTURE) {
+        int elementCount = typeSpec->typeSpec.structure.elementCount;
+
+        self->typeSpec.structure.elements = (MmsVariableSpecification**)
+                GLOBAL_CALLOC(elementCount > 0 ? elementCount : 1, sizeof(MmsVariableSpecification*));
+
+        if (self->typeSpec.structure.elements == NULL)
+            goto exit_error;
+
+        int i;
+
+        for (i = 0; i < elementCount; i++) {
+            self->typeSpec.structure.elements[i] = MmsVariableSpecification_clone(typeSpec->typeSpec.structure.elements[i]);
+
+            if (self->typeSpec.structure.elements[i] == NULL)
+                goto exit_error;
+
+            self->typeSpec.structure.elementCount++;
+        }
+    }
+    else if (typeSpec->type == MMS_ARRAY) {
+        self->typeSpec.array.elementTypeSpec = MmsVariableSpecification_clone(typeSpec->typeSpec.array.elementTypeSpec);
+
+        if (self->typeSpec.array.elementTypeSpec == NULL)
+            goto exit_error;
+    }
+
+    return self;
+
+exit_error:
+    if ((self->type == MMS_ARRAY) && (self->typeSpec.array.elementTypeSpec == NULL)) {
+        if (self->name)
+            GLOBAL_FREEMEM(self->name);
+
+        GLOBAL_FREEMEM(self);
+    }
+    else
+        MmsVariableSpecification_destroy(self);
+
+    return NULL;
+}
+
 static size_t
 directChildStrLen(const char* childId)
 {
@@ -334,6 +334,212 @@ exit_with_error:
     return NULL;
 }
 
+static bool
+updateVisibleString(MmsValue* self, uint8_t* buffer, int length)
+{
+    if ((self->value.visibleString.buf == NULL) || (self->value.visibleString.size < length)) {
+        char* newBuf = (char*) GLOBAL_MALLOC(length + 1);
+
+        if (newBuf == NULL)
+            return false;
+
+        if (self->value.visibleString.buf)
+            GLOBAL_FREEMEM(self->value.visibleString.buf);
+
+        self->value.visibleString.buf = newBuf;
+        self->value.visibleString.size = length;
+    }
+
+    memcpy(self->value.visibleString.buf, buffer, length);
+    self->value.visibleString.buf[length] = 0;
+
+    return true;
+}
+
+/* when update is false the element is only checked */
+static bool
+updateFromMmsData(MmsValue* self, uint8_t* buffer, int bufPos, int bufferLength, int* endBufPos, bool update)
+{
+    if (bufPos >= bufferLength)
+        return false;
+
+    uint8_t tag = buffer[bufPos++];
+
+    int dataLength;
+
+    bufPos = BerDecoder_decodeLength(buffer, &dataLength, bufPos, bufferLength);
+
+    if (bufPos < 0)
+        return false;
+
+    /* only strings can be empty */
+    if ((dataLength == 0) && (tag != 0x89) && (tag != 0x8a) && (tag != 0x90))
+        return false;
+
+    switch (tag) {
+
+    case 0xa1: /* MMS_ARRAY */
+    case 0xa2: /* MMS_STRUCTURE */
+    {
+        if (MmsValue_getType(self) != ((tag == 0xa1) ? MMS_ARRAY : MMS_STRUCTURE))
+            return false;
+
+        int dataEndBufPos = bufPos + dataLength;
+        int i;
+
+        for (i = 0; i < self->value.structure.size; i++) {
+            MmsValue* element = self->value.structure.components[i];
+
+            if ((element == NULL) || (bufPos >= dataEndBufPos))
+                return false;
+
+            if (updateFromMmsData(element, buffer, bufPos, dataEndBufPos, &bufPos, update) == false)
+                return false;
+        }
+
+        /* number of elements has changed */
+        if (bufPos != dataEndBufPos)
+            return false;
+    }
+        break;
+
+    case 0x80: /* MMS_DATA_ACCESS_ERROR */
+        if (MmsValue_getType(self) != MMS_DATA_ACCESS_ERROR)
+            return false;
+
+        if (update)
+            self->value.dataAccessError = (MmsDataAccessError) BerDecoder_decodeUint32(buffer, dataLength, bufPos);
+
+        bufPos += dataLength;
+        break;
+
+    case 0x83: /* MMS_BOOLEAN */
+        if (MmsValue_getType(self) != MMS_BOOLEAN)
+            return false;
+
+        if (update)
+            self->value.boolean = BerDecoder_decodeBoolean(buffer, bufPos);
+
+        bufPos += dataLength;
+        break;
+
+    case 0x84: /* MMS_BIT_STRING */
+        if (MmsValue_getType(self) != MMS_BIT_STRING)
+            return false;
+
+        if ((buffer[bufPos] > 7) || (((8 * (dataLength - 1)) - buffer[bufPos]) != self->value.bitString.size))
+            return false;
+
+        if (update)
+            memcpy(self->value.bitString.buf, buffer + bufPos + 1, dataLength - 1);
+
+        bufPos += dataLength;
+        break;
+
+    case 0x85: /* MMS_INTEGER */
+    case 0x86: /* MMS_UNSIGNED */
+        if (MmsValue_getType(self) != ((tag == 0x85) ? MMS_INTEGER : MMS_UNSIGNED))
+            return false;
+
+        if (dataLength > self->value.integer->maxSize)
+            return false;
+
+        if (update) {
+            memcpy(self->value.integer->octets, buffer + bufPos, dataLength);
+            self->value.integer->size = dataLength;
+        }
+
+        bufPos += dataLength;
+        break;
+
+    case 0x87: /* MMS_FLOAT */
+        if (MmsValue_getType(self) != MMS_FLOAT)
+            return false;
+
+        if ((dataLength == 9) && (self->value.floatingPoint.formatWidth == 64)) {
+            if (update)
+                MmsValue_setDouble(self, BerDecoder_decodeDouble(buffer, bufPos));
+        }
+        else if ((dataLength == 5) && (self->value.floatingPoint.formatWidth == 32)) {
+            if (update)
+                MmsValue_setFloat(self, BerDecoder_decodeFloat(buffer, bufPos));
+        }
+        else
+            return false;
+
+        bufPos += dataLength;
+        break;
+
+    case 0x89: /* MMS_OCTET_STRING */
+        if (MmsValue_getType(self) != MMS_OCTET_STRING)
+            return false;
+
+        if (dataLength > abs(self->value.octetString.maxSize))
+            return false;
+
+        if (update) {
+            memcpy(self->value.octetString.buf, buffer + bufPos, dataLength);
+            self->value.octetString.size = dataLength;
+        }
+
+        bufPos += dataLength;
+        break;
+
+    case 0x8a: /* MMS_VISIBLE_STRING */
+    case 0x90: /* MMS_STRING */
+        if (MmsValue_getType(self) != ((tag == 0x8a) ? MMS_VISIBLE_STRING : MMS_STRING))
+            return false;
+
+        if (update) {
+            if (updateVisibleString(self, buffer + bufPos, dataLength) == false)
+                return false;
+        }
+
+        bufPos += dataLength;
+        break;
+
+    case 0x8c: /* MMS_BINARY_TIME */
+        if ((MmsValue_getType(self) != MMS_BINARY_TIME) || (dataLength != self->value.binaryTime.size))
+            return false;
+
+        if (update)
+            memcpy(self->value.binaryTime.buf, buffer + bufPos, dataLength);
+
+        bufPos += dataLength;
+        break;
+
+    case 0x91: /* MMS_UTC_TIME */
+        if ((MmsValue_getType(self) != MMS_UTC_TIME) || (dataLength != 8))
+            return false;
+
+        if (update)
+            MmsValue_setUtcTimeByBuffer(self, buffer + bufPos);
+
+        bufPos += dataLength;
+        break;
+
+    default:
+        return false;
+    }
+
+    if (endBufPos != NULL)
+        *endBufPos = bufPos;
+
+    return true;
+}
+
+bool
+MmsValue_updateFromMmsData(MmsValue* self, uint8_t* buffer, int bufPos, int bufferLength, int* endBufPos)
+{
+    return updateFromMmsData(self, buffer, bufPos, bufferLength, endBufPos, true);
+}
+
+bool
+MmsValue_isMatchingMmsData(MmsValue* self, uint8_t* buffer, int bufPos, int bufferLength, int* endBufPos)
+{
+    return updateFromMmsData(self, buffer, bufPos, bufferLength, endBufPos, false);
+}
+
 static int
 MmsValue_getMaxStructSize(MmsValue* self)
 {
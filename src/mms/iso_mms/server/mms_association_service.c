@@ -367,8 +367,8 @@ parseInitiateRequestPdu(MmsServerConnection self, uint8_t* buffer, int bufPos, i
         case 0x81:  /* proposed-max-serv-outstanding-calling */
             self->maxServOutstandingCalling = BerDecoder_decodeUint32(buffer, length, bufPos);
 
-            if (self->maxServOutstandingCalling > DEFAULT_MAX_SERV_OUTSTANDING_CALLING)
-                self->maxServOutstandingCalling = DEFAULT_MAX_SERV_OUTSTANDING_CALLING;
+            if (self->maxServOutstandingCalling > CONFIG_MMS_SERVER_MAX_SERV_OUTSTANDING_CALLING)
+                self->maxServOutstandingCalling = CONFIG_MMS_SERVER_MAX_SERV_OUTSTANDING_CALLING;
 
             break;
 
@@ -28,6 +28,7 @@
 #if (MMS_FILE_SERVICE == 1)
 
 #include "hal_filesystem.h"
+#include "hal_time.h"
 #include "conversions.h"
 
 #define CONFIG_MMS_FILE_SERVICE_MAX_FILENAME_LENGTH 256
@@ -99,6 +100,32 @@ getNextFrsmId(MmsServerConnection connection)
     return nextFrsmId;
 }
 
+static void
+closeFrsm(MmsFileReadStateMachine* frsm)
+{
+#if (CONFIG_MMS_SERVER_FILE_READ_MMAP == 1)
+    if (frsm->mapping != NULL) {
+        FileSystem_unmapFile(frsm->mapping, frsm->fileSize);
+        frsm->mapping = NULL;
+    }
+#endif
+
+    FileSystem_closeFile(frsm->fileHandle);
+    frsm->fileHandle = NULL;
+    frsm->frsmId = 0;
+}
+
+void
+mmsServerConnection_closeFiles(MmsServerConnection self)
+{
+    int i;
+
+    for (i = 0; i < CONFIG_MMS_MAX_NUMBER_OF_OPEN_FILES_PER_CONNECTION; i++) {
+        if (self->frsms[i].fileHandle != NULL)
+            closeFrsm(&(self->frsms[i]));
+    }
+}
+
 static int
 encodeFileAttributes(uint8_t tag, uint32_t fileSize, char* gtString, uint8_t* buffer, int bufPos)
 {
@@ -300,6 +327,8 @@ mmsServer_handleFileDeleteRequest(
         return;
     }
 
+    mmsServer_invalidateFileDirectoryCache(connection->server);
+
     createNullResponseExtendedTag(invokeId, response, 0x4c);
     return;
 
@@ -385,6 +414,11 @@ mmsServer_handleFileOpenRequest(
 
                 mmsMsg_createFileOpenResponse(MmsServerConnection_getFilesystemBasepath(connection),
                         invokeId, response, filename, frsm);
+
+#if (CONFIG_MMS_SERVER_FILE_READ_MMAP == 1)
+                /* FileRead falls back to FileSystem_readFile when the file cannot be mapped */
+                frsm->mapping = FileSystem_mapFile(fileHandle, frsm->fileSize);
+#endif
             }
             else
                 mmsMsg_createServiceErrorPdu(invokeId, response, MMS_ERROR_FILE_FILE_NON_EXISTENT);
@@ -592,6 +626,9 @@ mmsServer_fileUploadTask(MmsServer self, MmsObtainFileTask task, int taskState)
 
                     IsoConnection_sendMessage(task->connection->isoConnection, message);
 
+                    /* the file size of the new file is not covered by the directory timestamps */
+                    mmsServer_invalidateFileDirectoryCache(self);
+
                     if (self->getFileCompleteHandler)
                         self->getFileCompleteHandler(self->getFileCompleteHandlerParameter, task->connection, task->destinationFilename);
                 }
@@ -825,19 +862,56 @@ exit_reject_invalid_pdu:
 
 #endif /* (MMS_OBTAIN_FILE_SERVICE == 1) */
 
+static int
+encodeFileReadResponseHeader(uint32_t invokeId, uint32_t fileChunkSize, bool moreFollows, uint8_t* buffer)
+{
+     uint32_t fileReadResponseSize = 1; /* for tag */
+
+     if (!moreFollows)
+         fileReadResponseSize += 3; /* for moreFollows */
+
+     fileReadResponseSize += fileChunkSize;
+     fileReadResponseSize += BerEncoder_determineLengthSize(fileChunkSize);
+
+     uint32_t invokeIdSize = BerEncoder_UInt32determineEncodedSize(invokeId) + 2;
+
+     uint32_t confirmedResponsePDUSize = invokeIdSize + 2 + BerEncoder_determineLengthSize(fileReadResponseSize)
+                + fileReadResponseSize;
+
+     int bufPos = 0;
+
+     bufPos = BerEncoder_encodeTL(0xa1, confirmedResponsePDUSize, buffer, bufPos);
+
+     bufPos = BerEncoder_encodeTL(0x02, invokeIdSize - 2, buffer, bufPos);
+     bufPos = BerEncoder_encodeUInt32(invokeId, buffer, bufPos);
+
+     buffer[bufPos++] = 0xbf;
+     bufPos = BerEncoder_encodeTL(0x49, fileReadResponseSize, buffer, bufPos);
+
+     bufPos = BerEncoder_encodeTL(0x80, fileChunkSize, buffer, bufPos);
+
+     return bufPos;
+}
+
+/*
+ * Each FileRead request returns the next block of the file. The requests of a connection are
+ * handled in the order they are received, so a client can have multiple FileRead requests for
+ * the same FRSM outstanding. Requests after the end of the file return an empty last block.
+ */
 void
 mmsMsg_createFileReadResponse(int maxPduSize, uint32_t invokeId,
         ByteBuffer* response,  MmsFileReadStateMachine* frsm)
 {
      /* determine remaining bytes in file */
-     uint32_t bytesLeft = frsm->fileSize - frsm->readPosition;
+     uint32_t bytesLeft = 0;
+
+     if (frsm->readPosition < frsm->fileSize)
+         bytesLeft = frsm->fileSize - frsm->readPosition;
 
      uint32_t fileChunkSize = 0;
 
      uint32_t maxFileChunkSize = maxPduSize - 20;
 
-     uint32_t fileReadResponseSize = 1; /* for tag */
-
      bool moreFollows = true;
 
      if (bytesLeft > maxFileChunkSize) {
@@ -846,33 +920,53 @@ mmsMsg_createFileReadResponse(int maxPduSize, uint32_t invokeId,
      else {
          fileChunkSize = bytesLeft;
          moreFollows = false;
-         fileReadResponseSize += 3; /* for moreFollows */
      }
 
-     fileReadResponseSize += fileChunkSize;
-     fileReadResponseSize += BerEncoder_determineLengthSize(fileChunkSize);
+     uint8_t* buffer = response->buffer;
 
-     frsm->readPosition += fileChunkSize;
+     int bufPos = encodeFileReadResponseHeader(invokeId, fileChunkSize, moreFollows, buffer);
 
-     uint32_t invokeIdSize = BerEncoder_UInt32determineEncodedSize(invokeId) + 2;
+     int readBytes = 0;
 
-     uint32_t confirmedResponsePDUSize = invokeIdSize + 2 + BerEncoder_determineLengthSize(fileReadResponseSize)
-                + fileReadResponseSize;
+     if (fileChunkSize > 0) {
+#if (CONFIG_MMS_SERVER_FILE_READ_MMAP == 1)
+         if (frsm->mapping != NULL) {
+             memcpy(buffer + bufPos, frsm->mapping + frsm->readPosition, fileChunkSize);
+             readBytes = fileChunkSize;
+         }
+         else
+#endif
+             readBytes = FileSystem_readFile(frsm->fileHandle, buffer + bufPos, fileChunkSize);
+     }
 
-     uint8_t* buffer = response->buffer;
+     if (readBytes < 0)
+         readBytes = 0;
 
-     int bufPos = 0;
+     if ((uint32_t) readBytes < fileChunkSize) {
 
-     bufPos = BerEncoder_encodeTL(0xa1, confirmedResponsePDUSize, buffer, bufPos);
+         /* file is shorter than indicated by FileOpen -> send the remaining data as last block */
 
-     bufPos = BerEncoder_encodeTL(0x02, invokeIdSize - 2, buffer, bufPos);
-     bufPos = BerEncoder_encodeUInt32(invokeId, buffer, bufPos);
+         if (DEBUG_MMS_SERVER)
+             printf("MMS_SERVER: unexpected end of file (frsmId: %i)\n", frsm->frsmId);
 
-     buffer[bufPos++] = 0xbf;
-     bufPos = BerEncoder_encodeTL(0x49, fileReadResponseSize, buffer, bufPos);
+         uint8_t header[32];
+
+         fileChunkSize = (uint32_t) readBytes;
+         moreFollows = false;
+
+         int headerSize = encodeFileReadResponseHeader(invokeId, fileChunkSize, moreFollows, header);
+
+         memmove(buffer + headerSize, buffer + bufPos, fileChunkSize);
+         memcpy(buffer, header, headerSize);
+
+         bufPos = headerSize;
+
+         frsm->readPosition = frsm->fileSize;
+     }
+     else {
+         frsm->readPosition += fileChunkSize;
+     }
 
-     bufPos = BerEncoder_encodeTL(0x80, fileChunkSize, buffer, bufPos);
-     FileSystem_readFile(frsm->fileHandle, buffer + bufPos, fileChunkSize);
      bufPos += fileChunkSize;
 
      if (!moreFollows)
@@ -919,9 +1013,7 @@ mmsServer_handleFileCloseRequest(
     MmsFileReadStateMachine* frsm = getFrsm(connection, frsmId);
 
     if (frsm) {
-        FileSystem_closeFile(frsm->fileHandle);
-        frsm->fileHandle = NULL;
-        frsm->frsmId = 0;
+        closeFrsm(frsm);
 
         mmsMsg_createFileCloseResponse(invokeId, response);
     }
@@ -953,32 +1045,170 @@ encodeFileSpecification(uint8_t tag, char* fileSpecification, uint8_t* buffer, i
     }
 }
 
-static int
-addFileEntriesToResponse(const char* basepath, uint8_t* buffer, int bufPos, int maxBufSize, char* directoryName, char** continueAfterFileName, bool* moreFollows)
+/* file of a directory listing */
+typedef struct {
+    char* name; /* path relative to the virtual file store */
+    uint32_t size;
+    uint64_t lastModified;
+} MmsFileDirectoryEntry;
+
+/* directory that is part of a listing - the modification time is used to detect changes */
+typedef struct {
+    char* name;
+    uint64_t lastModified;
+} MmsFileDirectoryState;
+
+/*
+ * All files below a directory of the virtual file store, sorted by name. A FileDirectory request
+ * with continue-after finds the first entry by binary search instead of scanning the file store
+ * again. The listings are cached by the server and are valid as long as none of the scanned
+ * directories is modified and the listing is not older than CONFIG_MMS_SERVER_FILE_DIRECTORY_CACHE_MAX_AGE.
+ */
+struct sMmsFileDirectoryListing {
+    char* basepath;
+    char* directoryName;
+
+    MmsFileDirectoryEntry* files;
+    int numberOfFiles;
+    int maxNumberOfFiles;
+
+    MmsFileDirectoryState* directories;
+    int numberOfDirectories;
+    int maxNumberOfDirectories;
+
+    uint64_t creationTime;
+    uint64_t lastAccessTime;
+    bool isComplete; /* false when a memory allocation failed during the scan */
+    bool isStable; /* no directory was modified within the timestamp resolution before the scan */
+};
+
+static void
+destroyDirectoryListing(MmsFileDirectoryListing self)
+{
+    int i;
+
+    for (i = 0; i < self->numberOfFiles; i++)
+        GLOBAL_FREEMEM(self->files[i].name);
+
+    for (i = 0; i < self->numberOfDirectories; i++)
+        GLOBAL_FREEMEM(self->directories[i].name);
+
+    if (self->files)
+        GLOBAL_FREEMEM(self->files);
+
+    if (self->directories)
+        GLOBAL_FREEMEM(self->directories);
+
+    if (self->basepath)
+        GLOBAL_FREEMEM(self->basepath);
+
+    if (self->directoryName)
+        GLOBAL_FREEMEM(self->directoryName);
+
+    GLOBAL_FREEMEM(self);
+}
+
+static void
+addFileToListing(MmsFileDirectoryListing self, const char* name, uint32_t size, uint64_t lastModified)
+{
+    if (self->numberOfFiles == self->maxNumberOfFiles) {
+        int newSize = (self->maxNumberOfFiles == 0) ? 16 : (self->maxNumberOfFiles * 2);
+
+        MmsFileDirectoryEntry* newFiles = (MmsFileDirectoryEntry*)
+                GLOBAL_REALLOC(self->files, newSize * sizeof(MmsFileDirectoryEntry));
+
+        if (newFiles == NULL) {
+            self->isComplete = false;
+            return;
+        }
+
+        self->files = newFiles;
+        self->maxNumberOfFiles = newSize;
+    }
+
+    MmsFileDirectoryEntry* entry = &(self->files[self->numberOfFiles]);
+
+    entry->name = StringUtils_copyString(name);
+
+    if (entry->name == NULL) {
+        self->isComplete = false;
+        return;
+    }
+
+    entry->size = size;
+    entry->lastModified = lastModified;
+
+    self->numberOfFiles++;
+}
+
+static void
+addDirectoryToListing(MmsFileDirectoryListing self, const char* name, uint64_t lastModified)
+{
+    if (self->numberOfDirectories == self->maxNumberOfDirectories) {
+        int newSize = (self->maxNumberOfDirectories == 0) ? 4 : (self->maxNumberOfDirectories * 2);
+
+        MmsFileDirectoryState* newDirectories = (MmsFileDirectoryState*)
+                GLOBAL_REALLOC(self->directories, newSize * sizeof(MmsFileDirectoryState));
+
+        if (newDirectories == NULL) {
+            self->isComplete = false;
+            return;
+        }
+
+        self->directories = newDirectories;
+        self->maxNumberOfDirectories = newSize;
+    }
+
+    MmsFileDirectoryState* directory = &(self->directories[self->numberOfDirectories]);
+
+    directory->name = StringUtils_copyString(name);
+
+    if (directory->name == NULL) {
+        self->isComplete = false;
+        return;
+    }
+
+    directory->lastModified = lastModified;
+
+    self->numberOfDirectories++;
+}
+
+/*
+ * Add all files below the given path to the listing. A path that is not a directory is added as
+ * a single file. Returns false when the path doesn't exist.
+ */
+static bool
+scanDirectory(MmsFileDirectoryListing self, const char* basepath, char* directoryName)
 {
-	int directoryNameLength = strlen(directoryName);
+    bool exists = true;
+
+    int directoryNameLength = strlen(directoryName);
 
     DirectoryHandle directory = openDirectory(basepath, directoryName);
 
     if (directory != NULL) {
 
+        uint64_t lastModified = 0;
+
+        getFileInfo(basepath, directoryName, NULL, &lastModified);
+
+        addDirectoryToListing(self, directoryName, lastModified);
+
         bool isDirectory;
         char* fileName = FileSystem_readDirectory(directory, &isDirectory);
 
-        while (fileName != NULL) {
-        	directoryName[directoryNameLength] = 0;
+        while ((fileName != NULL) && self->isComplete) {
+            directoryName[directoryNameLength] = 0;
 
-        	if (directoryNameLength > 0) {
-        		if (directoryName[directoryNameLength - 1] != '/')
-        		    StringUtils_appendString(directoryName, 256, "/");
-        	}
+            if (directoryNameLength > 0) {
+                if (directoryName[directoryNameLength - 1] != '/')
+                    StringUtils_appendString(directoryName, 256, "/");
+            }
 
-        	StringUtils_appendString(directoryName, 256, fileName);
+            StringUtils_appendString(directoryName, 256, fileName);
 
-            bufPos = addFileEntriesToResponse(basepath, buffer, bufPos, maxBufSize, directoryName, continueAfterFileName, moreFollows);
-
-            if (*moreFollows == true)
-                break;
+            /* ignore entries that are removed during the scan */
+            scanDirectory(self, basepath, directoryName);
 
             fileName = FileSystem_readDirectory(directory, &isDirectory);
         }
@@ -986,56 +1216,251 @@ addFileEntriesToResponse(const char* basepath, uint8_t* buffer, int bufPos, int
         FileSystem_closeDirectory(directory);
     }
     else {
+        uint64_t msTime;
+
+        uint32_t fileSize;
+
+        if (getFileInfo(basepath, directoryName, &fileSize, &msTime))
+            addFileToListing(self, directoryName, fileSize, msTime);
+        else
+            exists = false;
+    }
+
+    directoryName[directoryNameLength] = 0;
+
+    return exists;
+}
+
+static int
+compareDirectoryEntries(const void* a, const void* b)
+{
+    return strcmp(((MmsFileDirectoryEntry*) a)->name, ((MmsFileDirectoryEntry*) b)->name);
+}
+
+static MmsFileDirectoryListing
+createDirectoryListing(const char* basepath, char* directoryName)
+{
+    MmsFileDirectoryListing self = (MmsFileDirectoryListing) GLOBAL_CALLOC(1, sizeof(struct sMmsFileDirectoryListing));
+
+    if (self) {
+        self->isComplete = true;
+        self->creationTime = Hal_getTimeInMs();
+        self->lastAccessTime = self->creationTime;
+
+        self->basepath = StringUtils_copyString(basepath);
+        self->directoryName = StringUtils_copyString(directoryName);
 
-        if (*continueAfterFileName != NULL) {
-            if (strcmp(*continueAfterFileName, directoryName) == 0) {
-                *continueAfterFileName = NULL;
+        if ((self->basepath == NULL) || (self->directoryName == NULL))
+            goto exit_error;
+
+        if (scanDirectory(self, basepath, directoryName) == false)
+            goto exit_error;
+
+        if (self->isComplete == false)
+            goto exit_error;
+
+        qsort(self->files, self->numberOfFiles, sizeof(MmsFileDirectoryEntry), compareDirectoryEntries);
+
+        /* a directory modified in the same second as the scan can change without a new timestamp */
+        self->isStable = (self->numberOfDirectories > 0);
+
+        int i;
+
+        for (i = 0; i < self->numberOfDirectories; i++) {
+            if (self->directories[i].lastModified + 1000 > self->creationTime) {
+                self->isStable = false;
+                break;
             }
         }
-        else {
-            uint64_t msTime;
+    }
 
-            uint32_t fileSize;
+    return self;
 
-            if (getFileInfo(basepath, directoryName, &fileSize, &msTime)) {
-                char gtString[30];
+exit_error:
+    destroyDirectoryListing(self);
 
-                Conversions_msTimeToGeneralizedTime(msTime, (uint8_t*) gtString);
+    return NULL;
+}
 
-                int fileAttributesSize = encodeFileAttributes(0xa1, fileSize, gtString, NULL, 0);
+#if (CONFIG_MMS_SERVER_FILE_DIRECTORY_CACHE_SIZE > 0)
 
-                int filenameSize = encodeFileSpecification(0xa0, directoryName, NULL, 0);
+static bool
+isDirectoryListingValid(MmsFileDirectoryListing self, uint64_t currentTime)
+{
+    if (self->isStable == false)
+        return false;
 
-                int dirEntrySize = 2 + fileAttributesSize + filenameSize;
+    if ((currentTime < self->creationTime) ||
+            (currentTime - self->creationTime > CONFIG_MMS_SERVER_FILE_DIRECTORY_CACHE_MAX_AGE))
+        return false;
 
-                int overallEntrySize = 1 + BerEncoder_determineLengthSize(dirEntrySize) + dirEntrySize;
+    int i;
 
-                int bufferSpaceLeft = maxBufSize - bufPos;
+    for (i = 0; i < self->numberOfDirectories; i++) {
+        uint64_t lastModified;
 
-                if (overallEntrySize > bufferSpaceLeft) {
-                    *moreFollows = true;
-                }
-                else {
+        if (getFileInfo(self->basepath, self->directories[i].name, NULL, &lastModified) == false)
+            return false;
 
-                    bufPos = BerEncoder_encodeTL(0x30, dirEntrySize, buffer, bufPos); /* SEQUENCE (DirectoryEntry) */
-                    bufPos = encodeFileSpecification(0xa0, directoryName, buffer, bufPos); /* fileName */
-                    bufPos = encodeFileAttributes(0xa1, fileSize, gtString, buffer, bufPos); /* file attributes */
-                }
+        if (lastModified != self->directories[i].lastModified)
+            return false;
+    }
+
+    return true;
+}
+
+/* has to be called with fileDirectoryCacheLock */
+static MmsFileDirectoryListing
+getCachedDirectoryListing(MmsServer self, const char* basepath, const char* directoryName, uint64_t currentTime)
+{
+    int i;
+
+    for (i = 0; i < CONFIG_MMS_SERVER_FILE_DIRECTORY_CACHE_SIZE; i++) {
+        MmsFileDirectoryListing listing = self->fileDirectoryCache[i];
+
+        if (listing == NULL)
+            continue;
+
+        if ((strcmp(listing->directoryName, directoryName) == 0) && (strcmp(listing->basepath, basepath) == 0)) {
+
+            if (isDirectoryListingValid(listing, currentTime)) {
+                listing->lastAccessTime = currentTime;
+                return listing;
             }
-            else
-                bufPos = -1;
 
+            if (DEBUG_MMS_SERVER)
+                printf("MMS_SERVER: directory listing of (%s) changed\n", directoryName);
+
+            destroyDirectoryListing(listing);
+            self->fileDirectoryCache[i] = NULL;
+
+            break;
+        }
+    }
+
+    return NULL;
+}
+
+/* has to be called with fileDirectoryCacheLock */
+static void
+addDirectoryListingToCache(MmsServer self, MmsFileDirectoryListing listing)
+{
+    int index = 0;
+    int i;
+
+    /* replace the least recently used listing when the cache is full */
+    for (i = 0; i < CONFIG_MMS_SERVER_FILE_DIRECTORY_CACHE_SIZE; i++) {
+        if (self->fileDirectoryCache[i] == NULL) {
+            index = i;
+            break;
         }
 
+        if (self->fileDirectoryCache[i]->lastAccessTime < self->fileDirectoryCache[index]->lastAccessTime)
+            index = i;
     }
 
-    directoryName[directoryNameLength] = 0;
+    if (self->fileDirectoryCache[index] != NULL)
+        destroyDirectoryListing(self->fileDirectoryCache[index]);
+
+    self->fileDirectoryCache[index] = listing;
+}
+
+#endif /* (CONFIG_MMS_SERVER_FILE_DIRECTORY_CACHE_SIZE > 0) */
+
+void
+mmsServer_invalidateFileDirectoryCache(MmsServer self)
+{
+#if (CONFIG_MMS_SERVER_FILE_DIRECTORY_CACHE_SIZE > 0)
+#if (CONFIG_MMS_THREADLESS_STACK != 1)
+    Semaphore_wait(self->fileDirectoryCacheLock);
+#endif
+
+    mmsServer_destroyFileDirectoryCache(self);
+
+#if (CONFIG_MMS_THREADLESS_STACK != 1)
+    Semaphore_post(self->fileDirectoryCacheLock);
+#endif
+#else
+    (void)self;
+#endif /* (CONFIG_MMS_SERVER_FILE_DIRECTORY_CACHE_SIZE > 0) */
+}
+
+void
+mmsServer_destroyFileDirectoryCache(MmsServer self)
+{
+#if (CONFIG_MMS_SERVER_FILE_DIRECTORY_CACHE_SIZE > 0)
+    int i;
+
+    for (i = 0; i < CONFIG_MMS_SERVER_FILE_DIRECTORY_CACHE_SIZE; i++) {
+        if (self->fileDirectoryCache[i] != NULL) {
+            destroyDirectoryListing(self->fileDirectoryCache[i]);
+            self->fileDirectoryCache[i] = NULL;
+        }
+    }
+#else
+    (void)self;
+#endif /* (CONFIG_MMS_SERVER_FILE_DIRECTORY_CACHE_SIZE > 0) */
+}
+
+/* index of the first entry with a name greater than continueAfterFileName */
+static int
+getDirectoryListingStartIndex(MmsFileDirectoryListing listing, const char* continueAfterFileName)
+{
+    int low = 0;
+    int high = listing->numberOfFiles;
+
+    while (low < high) {
+        int middle = low + ((high - low) / 2);
+
+        if (strcmp(listing->files[middle].name, continueAfterFileName) <= 0)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+
+    return low;
+}
+
+static int
+addFileEntriesToResponse(MmsFileDirectoryListing listing, uint8_t* buffer, int bufPos, int maxBufSize, char* continueAfterFileName, bool* moreFollows)
+{
+    int i = 0;
+
+    if (continueAfterFileName != NULL)
+        i = getDirectoryListingStartIndex(listing, continueAfterFileName);
+
+    for (; i < listing->numberOfFiles; i++) {
+        MmsFileDirectoryEntry* entry = &(listing->files[i]);
+
+        char gtString[30];
+
+        Conversions_msTimeToGeneralizedTime(entry->lastModified, (uint8_t*) gtString);
+
+        int fileAttributesSize = encodeFileAttributes(0xa1, entry->size, gtString, NULL, 0);
+
+        int filenameSize = encodeFileSpecification(0xa0, entry->name, NULL, 0);
+
+        int dirEntrySize = 2 + fileAttributesSize + filenameSize;
+
+        int overallEntrySize = 1 + BerEncoder_determineLengthSize(dirEntrySize) + dirEntrySize;
+
+        int bufferSpaceLeft = maxBufSize - bufPos;
+
+        if (overallEntrySize > bufferSpaceLeft) {
+            *moreFollows = true;
+            break;
+        }
+
+        bufPos = BerEncoder_encodeTL(0x30, dirEntrySize, buffer, bufPos); /* SEQUENCE (DirectoryEntry) */
+        bufPos = encodeFileSpecification(0xa0, entry->name, buffer, bufPos); /* fileName */
+        bufPos = encodeFileAttributes(0xa1, entry->size, gtString, buffer, bufPos); /* file attributes */
+    }
 
     return bufPos;
 }
 
 static void
-createFileDirectoryResponse(const char* basepath, uint32_t invokeId, ByteBuffer* response, int maxPduSize, char* directoryName, char* continueAfterFileName)
+createFileDirectoryResponse(MmsServer server, const char* basepath, uint32_t invokeId, ByteBuffer* response, int maxPduSize, char* directoryName, char* continueAfterFileName)
 {
     int maxSize = maxPduSize - 3; /* reserve space for moreFollows */
     uint8_t* buffer = response->buffer;
@@ -1062,7 +1487,46 @@ createFileDirectoryResponse(const char* basepath, uint32_t invokeId, ByteBuffer*
        return;
     }
 
-    tempCurPos = addFileEntriesToResponse(basepath, buffer, tempCurPos, maxSize, directoryName, &continueAfterFileName, &moreFollows);
+    MmsFileDirectoryListing listing;
+    bool isCached = false;
+
+#if (CONFIG_MMS_SERVER_FILE_DIRECTORY_CACHE_SIZE > 0)
+#if (CONFIG_MMS_THREADLESS_STACK != 1)
+    Semaphore_wait(server->fileDirectoryCacheLock);
+#endif
+
+    listing = getCachedDirectoryListing(server, basepath, directoryName, Hal_getTimeInMs());
+
+    if (listing != NULL) {
+        isCached = true;
+    }
+    else {
+        listing = createDirectoryListing(basepath, directoryName);
+
+        /* listings of a single file or of recently changed directories are not cached */
+        if ((listing != NULL) && listing->isStable) {
+            addDirectoryListingToCache(server, listing);
+            isCached = true;
+        }
+    }
+#else
+    (void)server;
+
+    listing = createDirectoryListing(basepath, directoryName);
+#endif /* (CONFIG_MMS_SERVER_FILE_DIRECTORY_CACHE_SIZE > 0) */
+
+    if (listing != NULL) {
+        tempCurPos = addFileEntriesToResponse(listing, buffer, tempCurPos, maxSize, continueAfterFileName, &moreFollows);
+
+        if (isCached == false)
+            destroyDirectoryListing(listing);
+    }
+    else
+        tempCurPos = -1;
+
+#if (CONFIG_MMS_SERVER_FILE_DIRECTORY_CACHE_SIZE > 0) && (CONFIG_MMS_THREADLESS_STACK != 1)
+    Semaphore_post(server->fileDirectoryCacheLock);
+#endif
 
 	if (tempCurPos < 0) {
 
@@ -1189,6 +1653,8 @@ mmsServer_handleFileRenameRequest(
         }
 
         if (renameFile(MmsServerConnection_getFilesystemBasepath(connection), currentFileName, newFileName)){
+            mmsServer_invalidateFileDirectoryCache(connection->server);
+
             /* send positive response */
             createNullResponseExtendedTag(invokeId, response, 0x4b);
         }
@@ -1277,7 +1743,7 @@ mmsServer_handleFileDirectoryRequest(
         }
     }
 
-    createFileDirectoryResponse(MmsServerConnection_getFilesystemBasepath(connection),
+    createFileDirectoryResponse(connection->server, MmsServerConnection_getFilesystemBasepath(connection),
             invokeId, response, maxPduSize, filename, continueAfter);
 }
 
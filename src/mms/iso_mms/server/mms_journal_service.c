@@ -24,6 +24,7 @@
 #include "libiec61850_platform_includes.h"
 #include "mms_server_internal.h"
 #include "mms_value_internal.h"
+#include "hal_time.h"
 
 #if (MMS_JOURNAL_SERVICE == 1)
 
@@ -50,6 +51,8 @@ struct sJournalEncoder {
     uint64_t currentEntryId; /* For generic MMS case a byte array would be required! */
     uint64_t currentTimestamp;
     bool moreFollows;
+    bool hasLastEntry;
+    uint64_t lastEntryId; /* last entry that has been encoded completely */
 };
 
 static bool
@@ -62,6 +65,12 @@ entryCallback(void* parameter, uint64_t timestamp, uint64_t entryID, bool moreFo
         if (encoder->moreFollows)
             return false;
 
+        /* no space left for another entry -> stop reading from the log storage */
+        if (encoder->bufPos + 48 > encoder->maxSize) {
+            encoder->moreFollows = true;
+            return false;
+        }
+
         encoder->currentEntryBufPos = encoder->bufPos;
 
         encoder->bufPos += 48; /* reserve space for common entry parts */
@@ -180,6 +189,9 @@ entryDataCallback (void* parameter, const char* dataRef, uint8_t* data, int data
 
         /* prepare buffer for next entry. */
         encoder->bufPos = encoder->currentEntryBufPos + entryHeaderLength + dataContentLen;
+
+        encoder->hasLastEntry = true;
+        encoder->lastEntryId = encoder->currentEntryId;
     }
 
     return true;
@@ -215,6 +227,94 @@ parseStringWithMaxLength(char* filename, int maxLength, uint8_t* buffer, int* bu
     return true;
 }
 
+static void
+closeJournalCursor(MmsJournalCursor* cursor)
+{
+    LogStorageCursor_close(cursor->storageCursor);
+
+    cursor->storageCursor = NULL;
+    cursor->logStorage = NULL;
+    cursor->journal = NULL;
+}
+
+/* find the cursor of a previous request that is continued by the entry specification */
+static MmsJournalCursor*
+getJournalCursor(MmsServerConnection connection, MmsJournal journal, uint64_t entryID, bool hasRangeStop, uint64_t endingTime)
+{
+    int i;
+
+    for (i = 0; i < CONFIG_MMS_MAX_NUMBER_OF_JOURNAL_CURSORS_PER_CONNECTION; i++) {
+        MmsJournalCursor* cursor = &(connection->journalCursors[i]);
+
+        if (cursor->storageCursor == NULL)
+            continue;
+
+        if ((cursor->journal == journal) && (cursor->logStorage == journal->logStorage) &&
+                (cursor->lastEntryID == entryID) && (cursor->hasRangeStop == hasRangeStop)) {
+            if ((hasRangeStop == false) || (cursor->endingTime == endingTime))
+                return cursor;
+        }
+    }
+
+    return NULL;
+}
+
+/* get an unused cursor or close the least recently used one */
+static MmsJournalCursor*
+getFreeJournalCursor(MmsServerConnection connection)
+{
+    MmsJournalCursor* freeCursor = NULL;
+
+    int i;
+
+    for (i = 0; i < CONFIG_MMS_MAX_NUMBER_OF_JOURNAL_CURSORS_PER_CONNECTION; i++) {
+        MmsJournalCursor* cursor = &(connection->journalCursors[i]);
+
+        if (cursor->storageCursor == NULL)
+            return cursor;
+
+        if ((freeCursor == NULL) || (cursor->lastAccessTime < freeCursor->lastAccessTime))
+            freeCursor = cursor;
+    }
+
+    if (freeCursor)
+        closeJournalCursor(freeCursor);
+
+    return freeCursor;
+}
+
+void
+mmsServer_expireJournalCursors(MmsServerConnection connection, uint64_t currentTime)
+{
+    int i;
+
+    for (i = 0; i < CONFIG_MMS_MAX_NUMBER_OF_JOURNAL_CURSORS_PER_CONNECTION; i++) {
+        MmsJournalCursor* cursor = &(connection->journalCursors[i]);
+
+        if (cursor->storageCursor) {
+            if (currentTime > cursor->lastAccessTime + CONFIG_MMS_JOURNAL_CURSOR_TIMEOUT) {
+                if (DEBUG_MMS_SERVER)
+                    printf("MMS_SERVER: readJournal - close unused cursor for journal %s\n", cursor->journal->name);
+
+                closeJournalCursor(cursor);
+            }
+        }
+    }
+}
+
+void
+mmsServer_closeJournalCursors(MmsServerConnection connection)
+{
+    int i;
+
+    for (i = 0; i < CONFIG_MMS_MAX_NUMBER_OF_JOURNAL_CURSORS_PER_CONNECTION; i++) {
+        MmsJournalCursor* cursor = &(connection->journalCursors[i]);
+
+        if (cursor->storageCursor)
+            closeJournalCursor(cursor);
+    }
+}
+
 #define RESERVED_SPACE_FOR_HEADER 22
 
 void
@@ -236,6 +336,7 @@ mmsServer_handleReadJournalRequest(
 
     MmsValue rangeStart;
     MmsValue rangeStop;
+    MmsValue entryTime;
 
     bool hasNames = false;
     bool hasRangeStartSpec = false;
@@ -377,10 +478,10 @@ mmsServer_handleReadJournalRequest(
                     case 0x80: /* timeSpecification */
 
                         if ((length == 4) || (length == 6)) {
-                            rangeStart.type = MMS_BINARY_TIME;
-                            rangeStart.value.binaryTime.size = length;
+                            entryTime.type = MMS_BINARY_TIME;
+                            entryTime.value.binaryTime.size = length;
 
-                            memcpy(rangeStart.value.binaryTime.buf, requestBuffer + bufPos, length);
+                            memcpy(entryTime.value.binaryTime.buf, requestBuffer + bufPos, length);
 
                             hasTimeSpec = true;
                         }
@@ -462,10 +563,33 @@ mmsServer_handleReadJournalRequest(
     if (DEBUG_MMS_SERVER)
         printf("MMS_SERVER: readJournal - read journal %s ...\n", mmsJournal->name);
 
+    bool hasRange = (hasRangeStartSpec && hasRangeStopSpec);
+
+    if ((hasRange == false) && ((hasEntrySpec && hasTimeSpec) == false)) {
+        if (DEBUG_MMS_SERVER)
+            printf("MMS_SERVER: readJournal missing valid argument combination\n");
+
+        mmsMsg_createMmsRejectPdu(&invokeId, MMS_ERROR_REJECT_REQUEST_INVALID_ARGUMENT, response);
+
+        return;
+    }
+
+    uint64_t entryID = 0;
+
+    if (hasEntrySpec) {
+        if (entrySpec.value.octetString.size != 8) {
+            mmsMsg_createMmsRejectPdu(&invokeId, MMS_ERROR_REJECT_REQUEST_INVALID_ARGUMENT, response);
+            return;
+        }
+
+        memcpy(&entryID, entryIdBuf, 8);
+    }
+
     struct sJournalEncoder encoder;
 
     encoder.buffer = response->buffer;
     encoder.moreFollows = false;
+    encoder.hasLastEntry = false;
     encoder.maxSize = connection->maxPduSize - 3; /* reserve three bytes for moreFollows */
     encoder.bufPos = RESERVED_SPACE_FOR_HEADER; /* reserve space for header */
 
@@ -473,25 +597,67 @@ mmsServer_handleReadJournalRequest(
 
     if (logStorage != NULL) {
 
-        if (hasRangeStartSpec && hasRangeStopSpec) {
-            LogStorage_getEntries(logStorage, MmsValue_getBinaryTimeAsUtcMs(&rangeStart), MmsValue_getBinaryTimeAsUtcMs(&rangeStop),
-                    entryCallback, entryDataCallback, &encoder);
+        uint64_t endingTime = UINT64_MAX;
+
+        if (hasRange)
+            endingTime = MmsValue_getBinaryTimeAsUtcMs(&rangeStop);
+
+        MmsJournalCursor* cursor = NULL;
+        LogStorageCursor storageCursor = NULL;
+
+        /* continue the read of a previous request that returned moreFollows */
+        if (hasEntrySpec)
+            cursor = getJournalCursor(connection, mmsJournal, entryID, hasRange, endingTime);
+
+        if (cursor) {
+            if (DEBUG_MMS_SERVER)
+                printf("MMS_SERVER: readJournal - continue read with cursor\n");
+
+            storageCursor = cursor->storageCursor;
         }
-        else if (hasEntrySpec && hasTimeSpec) {
-            LogStorage_getEntriesAfter(logStorage, MmsValue_getBinaryTimeAsUtcMs(&rangeStart), *((uint64_t*) entryIdBuf),
-                    entryCallback, entryDataCallback, &encoder);
+        else if (hasEntrySpec) {
+            uint64_t startingTime = 0;
+
+            if (hasTimeSpec)
+                startingTime = MmsValue_getBinaryTimeAsUtcMs(&entryTime);
+
+            storageCursor = LogStorage_openCursor(logStorage, startingTime, endingTime, entryID);
         }
         else {
-            if (DEBUG_MMS_SERVER)
-                printf("MMS_SERVER: readJournal missing valid argument combination\n");
-
-            mmsMsg_createMmsRejectPdu(&invokeId, MMS_ERROR_REJECT_REQUEST_INVALID_ARGUMENT, response);
+            storageCursor = LogStorage_openCursor(logStorage, MmsValue_getBinaryTimeAsUtcMs(&rangeStart), endingTime, 0);
+        }
 
+        if (storageCursor == NULL) {
+            mmsMsg_createServiceErrorPdu(invokeId, response, MMS_ERROR_RESOURCE_OTHER);
             return;
         }
 
+        LogStorageCursor_read(storageCursor, entryCallback, entryDataCallback, &encoder);
+
+        /* keep the cursor for the next request when not all entries fit into the response */
+        if (encoder.moreFollows && encoder.hasLastEntry) {
+
+            if (cursor == NULL) {
+                cursor = getFreeJournalCursor(connection);
+
+                cursor->storageCursor = storageCursor;
+                cursor->logStorage = logStorage;
+                cursor->journal = mmsJournal;
+                cursor->hasRangeStop = hasRange;
+                cursor->endingTime = endingTime;
+            }
+
+            cursor->lastEntryID = encoder.lastEntryId;
+            cursor->lastAccessTime = Hal_getTimeInMs();
+        }
+        else {
+            if (cursor)
+                closeJournalCursor(cursor);
+            else
+                LogStorageCursor_close(storageCursor);
+        }
     }
-    /* actual encoding will happen in callback handler. When getEntries returns the data is
+    /* actual encoding will happen in callback handler. When the cursor read returns the data is
      * already encoded in the buffer.
      */
 
@@ -68,6 +68,13 @@ MmsServer_create(MmsDevice* device, TLSConfiguration tlsConfiguration)
 
         if (self->transmitBufferMutex == NULL)
             goto exit_error;
+
+#if (MMS_FILE_SERVICE == 1) && (CONFIG_MMS_SERVER_FILE_DIRECTORY_CACHE_SIZE > 0)
+        self->fileDirectoryCacheLock = Semaphore_create(1);
+
+        if (self->fileDirectoryCacheLock == NULL)
+            goto exit_error;
+#endif
 #endif
 
         self->isoServerList = LinkedList_create();
@@ -351,6 +358,13 @@ MmsServer_installWriteHandler(MmsServer self, MmsWriteVariableHandler writeHandl
     self->writeHandlerParameter = parameter;
 }
 
+void
+MmsServer_installValueCacheAccessHandler(MmsServer self, MmsValueCacheAccessHandler handler, void* parameter)
+{
+    self->valueCacheAccessHandler = handler;
+    self->valueCacheAccessHandlerParameter = parameter;
+}
+
 void
 MmsServer_installConnectionHandler(MmsServer self, MmsConnectionHandler connectionHandler, void* parameter)
 {
@@ -442,6 +456,11 @@ MmsServer_destroy(MmsServer self)
 
         if (self->transmitBufferMutex)
             Semaphore_destroy(self->transmitBufferMutex);
+
+#if (MMS_FILE_SERVICE == 1) && (CONFIG_MMS_SERVER_FILE_DIRECTORY_CACHE_SIZE > 0)
+        if (self->fileDirectoryCacheLock)
+            Semaphore_destroy(self->fileDirectoryCacheLock);
+#endif
 #endif
 
         if (self->transmitBuffer)
@@ -452,6 +471,10 @@ MmsServer_destroy(MmsServer self)
             GLOBAL_FREEMEM(self->filestoreBasepath);
 #endif
 
+#if (MMS_FILE_SERVICE == 1)
+        mmsServer_destroyFileDirectoryCache(self);
+#endif
+
 #if (MMS_OBTAIN_FILE_SERVICE == 1)
 #if (CONFIG_MMS_THREADLESS_STACK != 1)
         int i;
@@ -498,12 +521,21 @@ MmsServer_insertIntoCache(MmsServer self, MmsDomain* domain, char* itemId, MmsVa
     }
 }
 
+void
+mmsServer_prepareValueCacheAccess(MmsServer self, MmsDomain* domain)
+{
+    if (self->valueCacheAccessHandler != NULL)
+        self->valueCacheAccessHandler(self->valueCacheAccessHandlerParameter, domain);
+}
+
 MmsDataAccessError
 mmsServer_setValue(MmsServer self, MmsDomain* domain, char* itemId, MmsValue* value,
         MmsServerConnection connection)
 {
     MmsDataAccessError indication;
 
+    mmsServer_prepareValueCacheAccess(self, domain);
+
     if (self->writeHandler != NULL) {
         indication = self->writeHandler(self->writeHandlerParameter, domain,
                 itemId, value, connection);
@@ -531,6 +563,8 @@ mmsServer_getValue(MmsServer self, MmsDomain* domain, char* itemId, MmsServerCon
 {
     MmsValue* value = NULL;
 
+    mmsServer_prepareValueCacheAccess(self, domain);
+
     if (self->readAccessHandler != NULL) {
         MmsDataAccessError accessError =
                 self->readAccessHandler(self->readAccessHandlerParameter, (domain == (MmsDomain*) self->device) ? NULL : domain,
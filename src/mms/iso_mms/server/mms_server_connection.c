@@ -31,6 +31,7 @@
 #include "iso_server.h"
 #include "ber_encoder.h"
 #include "ber_decode.h"
+#include "hal_time.h"
 
 /**********************************************************************************************
  * MMS Common support functions
@@ -743,6 +744,10 @@ connectionTickHandler(void* parameter)
     MmsServerConnection self = (MmsServerConnection) parameter;
 
     MmsServer_callConnectionHandler(self->server, self);
+
+#if (MMS_JOURNAL_SERVICE == 1)
+    mmsServer_expireJournalCursors(self, Hal_getTimeInMs());
+#endif
 }
 
 /**********************************************************************************************
@@ -786,15 +791,15 @@ MmsServerConnection_destroy(MmsServerConnection self)
 {
 
 #if (MMS_FILE_SERVICE == 1)
-    int frsmIndex = 0;
-
-    for (frsmIndex = 0; frsmIndex < CONFIG_MMS_MAX_NUMBER_OF_OPEN_FILES_PER_CONNECTION; frsmIndex++)
-        if (self->frsms[frsmIndex].fileHandle != NULL)
-            FileSystem_closeFile(self->frsms[frsmIndex].fileHandle);
+    mmsServerConnection_closeFiles(self);
 
     mmsServerConnection_stopFileUploadTasks(self);
 #endif
 
+#if (MMS_JOURNAL_SERVICE == 1)
+    mmsServer_closeJournalCursors(self);
+#endif
+
 #if (MMS_DYNAMIC_DATA_SETS == 1)
     LinkedList_destroyDeep(self->namedVariableLists, (LinkedListValueDeleteFunction) MmsNamedVariableList_destroy);
 #endif
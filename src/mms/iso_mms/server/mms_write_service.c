@@ -687,6 +687,8 @@ mmsServer_handleWriteRequest(
                     domain = (MmsDomain*) device;
 
                 if (mmsServer_isIndexAccess(alternateAccess)) {
+                    mmsServer_prepareValueCacheAccess(connection->server, domain);
+
                     MmsValue* cachedArray = MmsServer_getValueFromCache(connection->server, domain, nameIdStr);
 
                     if (cachedArray == NULL) {
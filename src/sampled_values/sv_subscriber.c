@@ -29,11 +29,30 @@
 
 #include "hal_ethernet.h"
 #include "hal_thread.h"
+#include "hal_time.h"
+#include "platform_atomic.h"
 #include "ber_decode.h"
 #include "ber_encoder.h"
 
 #include "sv_subscriber.h"
 
+#if (ORDER_LITTLE_ENDIAN == 1)
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+/* the vectorized kernels are compiled for SSSE3 and AVX2 and selected by the CPU features at runtime */
+#include <immintrin.h>
+#define SV_BULK_DECODE_SIMD 1
+#define SV_BULK_DECODE_RUNTIME_DISPATCH 1
+#define SV_TARGET_SSSE3 __attribute__((target("ssse3")))
+#define SV_TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(__AVX2__)
+/* other compilers only use the kernels when AVX2 is enabled for the build (e.g. MSVC /arch:AVX2) */
+#include <immintrin.h>
+#define SV_BULK_DECODE_SIMD 1
+#define SV_TARGET_SSSE3
+#define SV_TARGET_AVX2
+#endif
+#endif
+
 #ifndef DEBUG_SV_SUBSCRIBER
 #define DEBUG_SV_SUBSCRIBER 1
 #endif
@@ -42,6 +61,27 @@
 
 #define ETH_P_SV 0x88ba
 
+/*
+ * Immutable APPID indexed lookup table (open addressing). A new table is created
+ * for every change of the subscriber list and published to the receiving thread(s).
+ */
+typedef struct {
+    uint16_t appId;
+    SVSubscriber subscriber; /* NULL for free slots */
+} SVSubscriberTableEntry;
+
+typedef struct {
+    int size; /* number of slots - power of two */
+    SVSubscriberTableEntry entries[1];
+} SVSubscriberTable;
+
+typedef struct {
+    SVReceiver receiver;
+    EthernetSocket ethSocket;
+    uint8_t* buffer;
+    volatile bool stopped;
+} SVReceiverFanoutShard;
+
 struct sSVReceiver {
     bool running;
     bool stopped;
@@ -55,18 +95,52 @@ struct sSVReceiver {
 
     LinkedList subscriberList;
 
+    /* read-mostly lookup table used by the receiving side */
+    SVSubscriberTable* volatile subscriberTable;
+
 #if (CONFIG_MMS_THREADLESS_STACK == 0)
-    Semaphore subscriberListLock;
+    Semaphore subscriberListLock; /* protects subscriberList and serializes table updates */
+
+    /* epoch based reclamation of replaced subscriber tables */
+    volatile int32_t readerEpoch;
+    volatile int32_t activeReaders[2];
 #endif
 
+    /* option: number of sockets/threads used to receive messages */
+    int fanoutSize;
+
+    /* additional sockets of the fanout group (the first socket is ethSocket) */
+    int numberOfFanoutShards;
+    SVReceiverFanoutShard* fanoutShards;
 };
 
+typedef struct {
+    /* sequence counter for consistent snapshots (odd while the receiver updates the counters) */
+    volatile int32_t sequence;
+    volatile int32_t resetRequested;
+
+    SVSubscriberStatistics counters;
+
+    /* configuration */
+    uint32_t smpCntRange;
+    uint32_t nominalIntervalNs;
+
+    /* receiver side state */
+    bool hasLastSmpCnt;
+    uint16_t lastSmpCnt;
+    uint16_t maxSmpCnt;
+    nsSinceEpoch lastArrivalTime;
+    uint64_t averageIntervalNs;
+} SVSubscriberStatisticsState;
+
 struct sSVSubscriber {
     uint8_t ethAddr[6];
     uint16_t appId;
 
     SVUpdateListener listener;
     void* listenerParameter;
+
+    SVSubscriberStatisticsState* volatile statistics; /* NULL when statistics are not enabled */
 };
 
 struct sSVSubscriber_ASDU {
@@ -93,10 +167,13 @@ SVReceiver_create(void)
 
     if (self != NULL) {
         self->subscriberList = LinkedList_create();
+        self->subscriberTable = NULL;
         self->buffer = (uint8_t*) GLOBAL_MALLOC(ETH_BUFFER_LENGTH);
 
         self->checkDestAddr = false;
 
+        self->fanoutSize = 1;
+
 #if (CONFIG_MMS_THREADLESS_STACK == 0)
         self->subscriberListLock = Semaphore_create(1);
 #endif
@@ -126,6 +203,104 @@ SVReceiver_enableDestAddrCheck(SVReceiver self)
     self->checkDestAddr = true;
 }
 
+void
+SVReceiver_enableFanout(SVReceiver self, int numberOfSockets)
+{
+    if (numberOfSockets < 1)
+        numberOfSockets = 1;
+
+    self->fanoutSize = numberOfSockets;
+}
+
+int
+SVReceiver_getFanoutSize(SVReceiver self)
+{
+    return self->numberOfFanoutShards + 1;
+}
+
+static inline int
+getTableSlot(SVSubscriberTable* table, uint16_t appId)
+{
+    return (appId ^ (appId >> 8)) & (table->size - 1);
+}
+
+static SVSubscriberTable*
+createSubscriberTable(LinkedList subscriberList)
+{
+    int numberOfSubscribers = LinkedList_size(subscriberList);
+
+    if (numberOfSubscribers == 0)
+        return NULL;
+
+    int size = 8;
+
+    while (size < (numberOfSubscribers * 2))
+        size = size * 2;
+
+    SVSubscriberTable* table = (SVSubscriberTable*) GLOBAL_CALLOC(1,
+            sizeof(SVSubscriberTable) + ((size - 1) * sizeof(SVSubscriberTableEntry)));
+
+    if (table) {
+        table->size = size;
+
+        /* insert in list order - subscribers with the same APPID keep their order in the probe sequence */
+        LinkedList element = LinkedList_getNext(subscriberList);
+
+        while (element) {
+            SVSubscriber subscriber = (SVSubscriber) LinkedList_getData(element);
+
+            int slot = getTableSlot(table, subscriber->appId);
+
+            while (table->entries[slot].subscriber != NULL)
+                slot = (slot + 1) & (size - 1);
+
+            table->entries[slot].appId = subscriber->appId;
+            table->entries[slot].subscriber = subscriber;
+
+            element = LinkedList_getNext(element);
+        }
+    }
+
+    return table;
+}
+
+#if (CONFIG_MMS_THREADLESS_STACK == 0)
+/* wait until all readers that may still see a replaced table have left */
+static void
+waitForReaders(SVReceiver self)
+{
+    int i;
+
+    for (i = 0; i < 2; i++) {
+        int32_t epoch = Atomic_load32(&(self->readerEpoch));
+
+        Atomic_store32(&(self->readerEpoch), epoch + 1);
+        Atomic_fence();
+
+        while (Atomic_load32(&(self->activeReaders[epoch & 1])) != 0)
+            Thread_sleep(1);
+    }
+}
+#endif
+
+/* has to be called with subscriberListLock held */
+static void
+updateSubscriberTable(SVReceiver self)
+{
+    SVSubscriberTable* newTable = createSubscriberTable(self->subscriberList);
+    SVSubscriberTable* oldTable = self->subscriberTable;
+
+    Atomic_storePointer((void* volatile*) &(self->subscriberTable), newTable);
+
+#if (CONFIG_MMS_THREADLESS_STACK == 0)
+    if (oldTable)
+        waitForReaders(self);
+#endif
+
+    if (oldTable)
+        GLOBAL_FREEMEM(oldTable);
+}
+
 void
 SVReceiver_addSubscriber(SVReceiver self, SVSubscriber subscriber)
 {
@@ -135,6 +310,8 @@ SVReceiver_addSubscriber(SVReceiver self, SVSubscriber subscriber)
 
     LinkedList_add(self->subscriberList, (void*) subscriber);
 
+    updateSubscriberTable(self);
+
 #if (CONFIG_MMS_THREADLESS_STACK == 0)
     Semaphore_post(self->subscriberListLock);
 #endif
@@ -149,19 +326,21 @@ SVReceiver_removeSubscriber(SVReceiver self, SVSubscriber subscriber)
 
     LinkedList_remove(self->subscriberList, (void*) subscriber);
 
+    updateSubscriberTable(self);
+
 #if (CONFIG_MMS_THREADLESS_STACK == 0)
     Semaphore_post(self->subscriberListLock);
 #endif
 }
 
-static void*
-svReceiverLoop(void* threadParameter)
+static void
+parseSVMessage(SVReceiver self, uint8_t* buffer, int numbytes);
+
+static void
+receiveMessages(SVReceiver self, EthernetSocket ethSocket, uint8_t* buffer)
 {
-    SVReceiver self = (SVReceiver) threadParameter;
     EthernetHandleSet handleSet = EthernetHandleSet_new();
-    EthernetHandleSet_addSocket(handleSet, self->ethSocket);
-
-    self->stopped = false;
+    EthernetHandleSet_addSocket(handleSet, ethSocket);
 
     while (self->running) {
             switch (EthernetHandleSet_waitReady(handleSet, 100))
@@ -173,18 +352,141 @@ svReceiverLoop(void* threadParameter)
             case 0:
                 break;
             default:
-                SVReceiver_tick(self);
+                /* drain all pending frames before waiting again */
+                while (self->running) {
+                    int packetSize = Ethernet_receivePacket(ethSocket, buffer, ETH_BUFFER_LENGTH);
+
+                    if (packetSize > 0)
+                        parseSVMessage(self, buffer, packetSize);
+                    else
+                        break;
+                }
             }
 
     }
 
+    EthernetHandleSet_destroy(handleSet);
+}
+
+static void*
+svReceiverLoop(void* threadParameter)
+{
+    SVReceiver self = (SVReceiver) threadParameter;
+
+    receiveMessages(self, self->ethSocket, self->buffer);
+
     self->stopped = true;
 
-    EthernetHandleSet_destroy(handleSet);
+    return NULL;
+}
+
+static void*
+svReceiverFanoutLoop(void* threadParameter)
+{
+    SVReceiverFanoutShard* shard = (SVReceiverFanoutShard*) threadParameter;
+
+    receiveMessages(shard->receiver, shard->ethSocket, shard->buffer);
+
+    shard->stopped = true;
 
     return NULL;
 }
 
+static bool
+startFanoutShard(SVReceiver self, SVReceiverFanoutShard* shard, int groupId)
+{
+    shard->receiver = self;
+
+    if (self->interfaceId == NULL)
+        shard->ethSocket = Ethernet_createSocket(CONFIG_ETHERNET_INTERFACE_ID, NULL);
+    else
+        shard->ethSocket = Ethernet_createSocket(self->interfaceId, NULL);
+
+    if (shard->ethSocket == NULL)
+        return false;
+
+    Ethernet_setProtocolFilter(shard->ethSocket, ETH_P_SV);
+
+    if (Ethernet_joinFanoutGroup(shard->ethSocket, groupId) == -1)
+        goto exit_with_error;
+
+    shard->buffer = (uint8_t*) GLOBAL_MALLOC(ETH_BUFFER_LENGTH);
+
+    if (shard->buffer == NULL)
+        goto exit_with_error;
+
+    Thread thread = Thread_create((ThreadExecutionFunction) svReceiverFanoutLoop, (void*) shard, true);
+
+    if (thread == NULL) {
+        GLOBAL_FREEMEM(shard->buffer);
+        goto exit_with_error;
+    }
+
+    shard->stopped = false;
+
+    Thread_start(thread);
+
+    return true;
+
+exit_with_error:
+    Ethernet_destroySocket(shard->ethSocket);
+    shard->ethSocket = NULL;
+
+    return false;
+}
+
+static void
+startFanoutShards(SVReceiver self)
+{
+    int groupId = Ethernet_joinFanoutGroup(self->ethSocket, -1);
+
+    if (groupId == -1) {
+        if (DEBUG_SV_SUBSCRIBER)
+            printf("SV_SUBSCRIBER: Socket fanout not supported -> use single socket\n");
+
+        return;
+    }
+
+    self->fanoutShards = (SVReceiverFanoutShard*) GLOBAL_CALLOC(self->fanoutSize - 1, sizeof(SVReceiverFanoutShard));
+
+    if (self->fanoutShards == NULL)
+        return;
+
+    while (self->numberOfFanoutShards < self->fanoutSize - 1) {
+        if (startFanoutShard(self, &(self->fanoutShards[self->numberOfFanoutShards]), groupId) == false) {
+            if (DEBUG_SV_SUBSCRIBER)
+                printf("SV_SUBSCRIBER: Failed to create fanout socket -> use %i sockets\n", self->numberOfFanoutShards + 1);
+
+            break;
+        }
+
+        self->numberOfFanoutShards++;
+    }
+}
+
+static void
+stopFanoutShards(SVReceiver self)
+{
+    int i;
+
+    for (i = 0; i < self->numberOfFanoutShards; i++) {
+        SVReceiverFanoutShard* shard = &(self->fanoutShards[i]);
+
+        while (shard->stopped == false)
+            Thread_sleep(1);
+
+        Ethernet_destroySocket(shard->ethSocket);
+        GLOBAL_FREEMEM(shard->buffer);
+    }
+
+    if (self->fanoutShards) {
+        GLOBAL_FREEMEM(self->fanoutShards);
+        self->fanoutShards = NULL;
+    }
+
+    self->numberOfFanoutShards = 0;
+}
+
 void
 SVReceiver_start(SVReceiver self)
 {
@@ -193,12 +495,19 @@ SVReceiver_start(SVReceiver self)
         if (DEBUG_SV_SUBSCRIBER)
             printf("SV_SUBSCRIBER: SV receiver started for interface %s\n", self->interfaceId);
 
+        self->stopped = false;
+
         Thread thread = Thread_create((ThreadExecutionFunction) svReceiverLoop, (void*) self, true);
 
         if (thread) {
+            if (self->fanoutSize > 1)
+                startFanoutShards(self);
+
             Thread_start(thread);
         }
         else {
+            self->stopped = true;
+
             if (DEBUG_SV_SUBSCRIBER)
                 printf("SV_SUBSCRIBER: Failed to start thread\n");
         }
@@ -224,6 +533,8 @@ SVReceiver_stop(SVReceiver self)
 
         while (self->stopped == false)
             Thread_sleep(1);
+
+        stopFanoutShards(self);
     }
 }
 
@@ -233,6 +544,9 @@ SVReceiver_destroy(SVReceiver self)
     LinkedList_destroyDeep(self->subscriberList,
             (LinkedListValueDeleteFunction) SVSubscriber_destroy);
 
+    if (self->subscriberTable)
+        GLOBAL_FREEMEM(self->subscriberTable);
+
     if (self->interfaceId != NULL)
         GLOBAL_FREEMEM(self->interfaceId);
 
@@ -271,8 +585,151 @@ SVReceiver_stopThreadless(SVReceiver self)
     self->running = false;
 }
 
+static inline void
+beginStatisticsUpdate(SVSubscriberStatisticsState* stats)
+{
+    Atomic_fetchAdd32(&(stats->sequence), 1);
+
+    if (Atomic_load32(&(stats->resetRequested))) {
+        memset(&(stats->counters), 0, sizeof(SVSubscriberStatistics));
+        stats->hasLastSmpCnt = false;
+        stats->maxSmpCnt = 0;
+        stats->lastArrivalTime = 0;
+        stats->averageIntervalNs = 0;
+
+        Atomic_store32(&(stats->resetRequested), 0);
+    }
+}
+
+static inline void
+endStatisticsUpdate(SVSubscriberStatisticsState* stats)
+{
+    Atomic_fetchAdd32(&(stats->sequence), 1);
+}
+
+static int
+getJitterHistogramBin(uint64_t deviationNs)
+{
+    uint64_t deviationUs = deviationNs / 1000;
+
+    int bin = 0;
+
+    while ((deviationUs > 0) && (bin < SV_SUBSCRIBER_JITTER_HISTOGRAM_SIZE - 1)) {
+        deviationUs = deviationUs >> 1;
+        bin++;
+    }
+
+    return bin;
+}
+
+static void
+updateFrameStatistics(SVSubscriberStatisticsState* stats, nsSinceEpoch arrivalTime)
+{
+    beginStatisticsUpdate(stats);
+
+    stats->counters.frames++;
+
+    if (stats->lastArrivalTime != 0 && arrivalTime > stats->lastArrivalTime) {
+        uint64_t interval = arrivalTime - stats->lastArrivalTime;
+        uint64_t expected;
+
+        if (stats->nominalIntervalNs > 0) {
+            expected = stats->nominalIntervalNs;
+        }
+        else {
+            /* no nominal interval configured -> use moving average of the inter-arrival time */
+            if (stats->averageIntervalNs == 0)
+                stats->averageIntervalNs = interval;
+            else
+                stats->averageIntervalNs = stats->averageIntervalNs - (stats->averageIntervalNs / 16) + (interval / 16);
+
+            expected = stats->averageIntervalNs;
+        }
+
+        uint64_t deviation = (interval > expected) ? (interval - expected) : (expected - interval);
+
+        stats->counters.jitterHistogram[getJitterHistogramBin(deviation)]++;
+
+        if (deviation > stats->counters.maxJitterNs)
+            stats->counters.maxJitterNs = deviation;
+    }
+
+    stats->lastArrivalTime = arrivalTime;
+
+    endStatisticsUpdate(stats);
+}
+
 static void
-parseASDU(SVReceiver self, SVSubscriber subscriber, uint8_t* buffer, int length)
+updateASDUStatistics(SVSubscriberStatisticsState* stats, SVSubscriber_ASDU asdu, nsSinceEpoch arrivalTime)
+{
+    beginStatisticsUpdate(stats);
+
+    stats->counters.asdus++;
+
+    if (asdu->smpCnt != NULL) {
+        uint16_t smpCnt = SVSubscriber_ASDU_getSmpCnt(asdu);
+
+        if (smpCnt > stats->maxSmpCnt)
+            stats->maxSmpCnt = smpCnt;
+
+        if (stats->hasLastSmpCnt) {
+            /* when the wrap around value is unknown use the highest smpCnt seen so far */
+            uint32_t range = stats->smpCntRange;
+
+            if (range == 0)
+                range = (uint32_t) stats->maxSmpCnt + 1;
+
+            uint32_t last = stats->lastSmpCnt;
+            uint32_t current = smpCnt;
+
+            if (current == last) {
+                stats->counters.duplicateSamples++;
+            }
+            else {
+                uint32_t distance;
+
+                if (current > last)
+                    distance = current - last;
+                else
+                    distance = (range > last) ? (range - last + current) : (current + 1);
+
+                if (distance <= (range / 2)) {
+                    stats->counters.lostSamples += (distance - 1);
+                    stats->lastSmpCnt = smpCnt;
+                }
+                else {
+                    /* older sample - it has been counted as lost before */
+                    stats->counters.outOfOrderSamples++;
+
+                    if (stats->counters.lostSamples > 0)
+                        stats->counters.lostSamples--;
+                }
+            }
+        }
+        else {
+            stats->hasLastSmpCnt = true;
+            stats->lastSmpCnt = smpCnt;
+        }
+    }
+
+    if (asdu->refrTm != NULL) {
+        int64_t latency = (int64_t) (arrivalTime - SVSubscriber_ASDU_getRefrTmAsNs(asdu));
+
+        if ((stats->counters.latencySamples == 0) || (latency < stats->counters.minLatencyNs))
+            stats->counters.minLatencyNs = latency;
+
+        if ((stats->counters.latencySamples == 0) || (latency > stats->counters.maxLatencyNs))
+            stats->counters.maxLatencyNs = latency;
+
+        stats->counters.sumLatencyNs += latency;
+        stats->counters.latencySamples++;
+    }
+
+    endStatisticsUpdate(stats);
+}
+
+static void
+parseASDU(SVReceiver self, SVSubscriber subscriber, uint8_t* buffer, int length, nsSinceEpoch arrivalTime)
 {
     (void)self;
 
@@ -370,6 +827,13 @@ parseASDU(SVReceiver self, SVSubscriber subscriber, uint8_t* buffer, int length)
             printf("SV_SUBSCRIBER:     SmpRate: %d\n", SVSubscriber_ASDU_getSmpRate(&asdu));
     }
 
+    if (subscriber) {
+        SVSubscriberStatisticsState* stats = (SVSubscriberStatisticsState*) Atomic_loadPointer((void* volatile*) &(subscriber->statistics));
+
+        if (stats)
+            updateASDUStatistics(stats, &asdu, arrivalTime);
+    }
+
     /* Call callback handler */
     if (subscriber) {
         if (subscriber->listener != NULL)
@@ -378,7 +842,7 @@ parseASDU(SVReceiver self, SVSubscriber subscriber, uint8_t* buffer, int length)
 }
 
 static void
-parseSequenceOfASDU(SVReceiver self, SVSubscriber subscriber, uint8_t* buffer, int length)
+parseSequenceOfASDU(SVReceiver self, SVSubscriber subscriber, uint8_t* buffer, int length, nsSinceEpoch arrivalTime)
 {
     int bufPos = 0;
 
@@ -395,7 +859,7 @@ parseSequenceOfASDU(SVReceiver self, SVSubscriber subscriber, uint8_t* buffer, i
 
         switch (tag) {
         case 0x30:
-            parseASDU(self, subscriber, buffer + bufPos, elementLength);
+            parseASDU(self, subscriber, buffer + bufPos, elementLength, arrivalTime);
             break;
 
         default: /* ignore unknown tag */
@@ -408,7 +872,7 @@ parseSequenceOfASDU(SVReceiver self, SVSubscriber subscriber, uint8_t* buffer, i
 }
 
 static void
-parseSVPayload(SVReceiver self, SVSubscriber subscriber, uint8_t* buffer, int apduLength)
+parseSVPayload(SVReceiver self, SVSubscriber subscriber, uint8_t* buffer, int apduLength, nsSinceEpoch arrivalTime)
 {
     int bufPos = 0;
 
@@ -436,7 +900,7 @@ parseSVPayload(SVReceiver self, SVSubscriber subscriber, uint8_t* buffer, int ap
                 break;
 
             case 0xa2: /* asdu (SEQUENCE) */
-                parseSequenceOfASDU(self, subscriber, buffer + bufPos, elementLength);
+                parseSequenceOfASDU(self, subscriber, buffer + bufPos, elementLength, arrivalTime);
                 break;
 
             default: /* ignore unknown tag */
@@ -459,10 +923,9 @@ exit_error:
 }
 
 static void
-parseSVMessage(SVReceiver self, int numbytes)
+parseSVMessage(SVReceiver self, uint8_t* buffer, int numbytes)
 {
     int bufPos;
-    uint8_t* buffer = self->buffer;
 
     if (numbytes < 22) return;
 
@@ -516,43 +979,58 @@ parseSVMessage(SVReceiver self, int numbytes)
     /* check if there is a matching subscriber */
 
 #if (CONFIG_MMS_THREADLESS_STACK == 0)
-    Semaphore_wait(self->subscriberListLock);
+    int32_t readerSlot = Atomic_load32(&(self->readerEpoch)) & 1;
+
+    Atomic_fetchAdd32(&(self->activeReaders[readerSlot]), 1);
 #endif
 
     SVSubscriber subscriber = NULL;
 
-    LinkedList element = LinkedList_getNext(self->subscriberList);
+    SVSubscriberTable* table = (SVSubscriberTable*) Atomic_loadPointer((void* volatile*) &(self->subscriberTable));
+
+    if (table) {
+        int slot = getTableSlot(table, appId);
 
-    while (element != NULL) {
-        SVSubscriber subscriberElem = (SVSubscriber) LinkedList_getData(element);
+        while (table->entries[slot].subscriber != NULL) {
+            SVSubscriberTableEntry* entry = &(table->entries[slot]);
 
-        if (subscriberElem->appId == appId) {
+            if (entry->appId == appId) {
 
-            if (self->checkDestAddr) {
-                if (memcmp(dstAddr, subscriberElem->ethAddr, 6) == 0) {
-                    subscriber = subscriberElem;
+                if (self->checkDestAddr) {
+                    if (memcmp(dstAddr, entry->subscriber->ethAddr, 6) == 0) {
+                        subscriber = entry->subscriber;
+                        break;
+                    }
+                    else
+                        if (DEBUG_SV_SUBSCRIBER)
+                            printf("SV_SUBSCRIBER: Checking ethernet dest address failed!\n");
+                }
+                else {
+                    subscriber = entry->subscriber;
                     break;
                 }
-                else
-                    if (DEBUG_SV_SUBSCRIBER)
-                        printf("SV_SUBSCRIBER: Checking ethernet dest address failed!\n");
-            }
-            else {
-                subscriber = subscriberElem;
-                break;
             }
 
+            slot = (slot + 1) & (table->size - 1);
         }
-
-        element = LinkedList_getNext(element);
     }
 
 #if (CONFIG_MMS_THREADLESS_STACK == 0)
-    Semaphore_post(self->subscriberListLock);
+    Atomic_fetchAdd32(&(self->activeReaders[readerSlot]), -1);
 #endif
 
-    if (subscriber)
-        parseSVPayload(self, subscriber, buffer + bufPos, apduLength);
+    if (subscriber) {
+        nsSinceEpoch arrivalTime = 0;
+
+        SVSubscriberStatisticsState* stats = (SVSubscriberStatisticsState*) Atomic_loadPointer((void* volatile*) &(subscriber->statistics));
+
+        if (stats) {
+            arrivalTime = Hal_getTimeInNs();
+            updateFrameStatistics(stats, arrivalTime);
+        }
+
+        parseSVPayload(self, subscriber, buffer + bufPos, apduLength, arrivalTime);
+    }
     else {
         if (DEBUG_SV_SUBSCRIBER)
             printf("SV_SUBSCRIBER: SV message ignored due to unknown APPID value or dest address mismatch\n");
@@ -565,13 +1043,19 @@ SVReceiver_tick(SVReceiver self)
     int packetSize = Ethernet_receivePacket(self->ethSocket, self->buffer, ETH_BUFFER_LENGTH);
 
     if (packetSize > 0) {
-        parseSVMessage(self, packetSize);
+        parseSVMessage(self, self->buffer, packetSize);
         return true;
     }
     else
         return false;
 }
 
+void
+SVReceiver_handleMessage(SVReceiver self, uint8_t* buffer, int size)
+{
+    parseSVMessage(self, buffer, size);
+}
+
 SVSubscriber
 SVSubscriber_create(const uint8_t* ethAddr, uint16_t appID)
 {
@@ -590,8 +1074,67 @@ SVSubscriber_create(const uint8_t* ethAddr, uint16_t appID)
 void
 SVSubscriber_destroy(SVSubscriber self)
 {
-    if (self != NULL)
+    if (self != NULL) {
+        if (self->statistics)
+            GLOBAL_FREEMEM(self->statistics);
+
         GLOBAL_FREEMEM(self);
+    }
+}
+
+bool
+SVSubscriber_enableStatistics(SVSubscriber self, uint32_t smpCntRange, uint32_t nominalIntervalNs)
+{
+    if (self->statistics != NULL)
+        return true;
+
+    SVSubscriberStatisticsState* stats = (SVSubscriberStatisticsState*) GLOBAL_CALLOC(1, sizeof(SVSubscriberStatisticsState));
+
+    if (stats == NULL)
+        return false;
+
+    stats->smpCntRange = smpCntRange;
+    stats->nominalIntervalNs = nominalIntervalNs;
+
+    Atomic_storePointer((void* volatile*) &(self->statistics), stats);
+
+    return true;
+}
+
+void
+SVSubscriber_resetStatistics(SVSubscriber self)
+{
+    SVSubscriberStatisticsState* stats = (SVSubscriberStatisticsState*) Atomic_loadPointer((void* volatile*) &(self->statistics));
+
+    /* the counters are reset by the receiver before the next update */
+    if (stats)
+        Atomic_store32(&(stats->resetRequested), 1);
+}
+
+bool
+SVSubscriber_getStatistics(SVSubscriber self, SVSubscriberStatistics* statistics)
+{
+    SVSubscriberStatisticsState* stats = (SVSubscriberStatisticsState*) Atomic_loadPointer((void* volatile*) &(self->statistics));
+
+    if (stats == NULL)
+        return false;
+
+    int32_t sequence;
+
+    do {
+        while ((sequence = Atomic_load32(&(stats->sequence))) & 1)
+            Thread_sleep(0);
+
+        memcpy(statistics, (const void*) &(stats->counters), sizeof(SVSubscriberStatistics));
+
+        Atomic_fence();
+
+    } while (Atomic_load32(&(stats->sequence)) != sequence);
+
+    if (Atomic_load32(&(stats->resetRequested)))
+        memset(statistics, 0, sizeof(SVSubscriberStatistics));
+
+    return true;
 }
 
 
@@ -915,6 +1458,245 @@ SVSubscriber_ASDU_getDataSize(SVSubscriber_ASDU self)
     return self->dataBufferLength;
 }
 
+static int
+getBulkElementCount(SVSubscriber_ASDU self, int index, int elementSize, int maxCount)
+{
+    if ((index < 0) || (maxCount <= 0) || (index >= self->dataBufferLength))
+        return 0;
+
+    int count = (self->dataBufferLength - index) / elementSize;
+
+    if (count > maxCount)
+        count = maxCount;
+
+    return count;
+}
+
+#if (SV_BULK_DECODE_SIMD == 1)
+
+#define SV_SIMD_LEVEL_NONE 0
+#define SV_SIMD_LEVEL_SSSE3 1
+#define SV_SIMD_LEVEL_AVX2 2
+
+static int
+getSimdLevel(void)
+{
+#if (SV_BULK_DECODE_RUNTIME_DISPATCH == 1)
+    static volatile int32_t simdLevel = -1;
+
+    int32_t level = Atomic_load32(&simdLevel);
+
+    if (level == -1) {
+        __builtin_cpu_init();
+
+        if (__builtin_cpu_supports("avx2"))
+            level = SV_SIMD_LEVEL_AVX2;
+        else if (__builtin_cpu_supports("ssse3"))
+            level = SV_SIMD_LEVEL_SSSE3;
+        else
+            level = SV_SIMD_LEVEL_NONE;
+
+        Atomic_store32(&simdLevel, level);
+    }
+
+    return level;
+#else
+    return SV_SIMD_LEVEL_AVX2;
+#endif
+}
+
+/* the kernels return the number of decoded values - the remaining values are decoded by the scalar code */
+
+SV_TARGET_SSSE3 static int
+decodeBigEndian32Ssse3(const uint8_t* src, uint8_t* dst, int count)
+{
+    int i = 0;
+
+    const __m128i swap128 = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+
+    for (; i + 4 <= count; i += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i*) (src + (i * 4)));
+        _mm_storeu_si128((__m128i*) (dst + (i * 4)), _mm_shuffle_epi8(v, swap128));
+    }
+
+    return i;
+}
+
+SV_TARGET_AVX2 static int
+decodeBigEndian32Avx2(const uint8_t* src, uint8_t* dst, int count)
+{
+    int i = 0;
+
+    const __m256i swap256 = _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12,
+                                             3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+
+    for (; i + 8 <= count; i += 8) {
+        __m256i v = _mm256_loadu_si256((const __m256i*) (src + (i * 4)));
+        _mm256_storeu_si256((__m256i*) (dst + (i * 4)), _mm256_shuffle_epi8(v, swap256));
+    }
+
+    const __m128i swap128 = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+
+    for (; i + 4 <= count; i += 4) {
+        __m128i v = _mm_loadu_si128((const __m128i*) (src + (i * 4)));
+        _mm_storeu_si128((__m128i*) (dst + (i * 4)), _mm_shuffle_epi8(v, swap128));
+    }
+
+    return i;
+}
+
+SV_TARGET_SSSE3 static int
+decodeBigEndian32WithQualitySsse3(const uint8_t* src, uint8_t* dst, Quality* qualities, int count)
+{
+    int i = 0;
+
+    /* 2 pairs per 16 byte block: swapped values in dwords 0,1 - qualities in words 4,5 */
+    const __m128i pairShuffle128 = _mm_setr_epi8(3, 2, 1, 0, 11, 10, 9, 8, 7, 6, 15, 14,
+                                                 -1, -1, -1, -1);
+
+    for (; i + 2 <= count; i += 2) {
+        __m128i v = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (src + (i * 8))), pairShuffle128);
+
+        _mm_storel_epi64((__m128i*) (dst + (i * 4)), v);
+
+        uint32_t q = (uint32_t) _mm_cvtsi128_si32(_mm_srli_si128(v, 8));
+        memcpy(qualities + i, &q, sizeof(uint32_t));
+    }
+
+    return i;
+}
+
+SV_TARGET_AVX2 static int
+decodeBigEndian32WithQualityAvx2(const uint8_t* src, uint8_t* dst, Quality* qualities, int count)
+{
+    int i = 0;
+
+    const __m256i pairShuffle256 = _mm256_setr_epi8(3, 2, 1, 0, 11, 10, 9, 8, 7, 6, 15, 14, -1, -1, -1, -1,
+                                                    3, 2, 1, 0, 11, 10, 9, 8, 7, 6, 15, 14, -1, -1, -1, -1);
+
+    /* gather the values of both lanes in the lower half and the qualities in the upper half */
+    const __m256i pairPermute = _mm256_setr_epi32(0, 1, 4, 5, 2, 6, 3, 7);
+
+    for (; i + 4 <= count; i += 4) {
+        __m256i v = _mm256_loadu_si256((const __m256i*) (src + (i * 8)));
+
+        v = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(v, pairShuffle256), pairPermute);
+
+        _mm_storeu_si128((__m128i*) (dst + (i * 4)), _mm256_castsi256_si128(v));
+        _mm_storel_epi64((__m128i*) (qualities + i), _mm256_extracti128_si256(v, 1));
+    }
+
+    const __m128i pairShuffle128 = _mm_setr_epi8(3, 2, 1, 0, 11, 10, 9, 8, 7, 6, 15, 14,
+                                                 -1, -1, -1, -1);
+
+    for (; i + 2 <= count; i += 2) {
+        __m128i v = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) (src + (i * 8))), pairShuffle128);
+
+        _mm_storel_epi64((__m128i*) (dst + (i * 4)), v);
+
+        uint32_t q = (uint32_t) _mm_cvtsi128_si32(_mm_srli_si128(v, 8));
+        memcpy(qualities + i, &q, sizeof(uint32_t));
+    }
+
+    return i;
+}
+
+#endif /* (SV_BULK_DECODE_SIMD == 1) */
+
+/*
+ * Decode count big-endian 32 bit values from src into dst (host byte order)
+ */
+static void
+decodeBigEndian32(const uint8_t* src, uint8_t* dst, int count)
+{
+    int i = 0;
+
+#if (SV_BULK_DECODE_SIMD == 1)
+    int simdLevel = getSimdLevel();
+
+    if (simdLevel == SV_SIMD_LEVEL_AVX2)
+        i = decodeBigEndian32Avx2(src, dst, count);
+    else if (simdLevel == SV_SIMD_LEVEL_SSSE3)
+        i = decodeBigEndian32Ssse3(src, dst, count);
+#endif
+
+    for (; i < count; i++) {
+        const uint8_t* s = src + (i * 4);
+
+        uint32_t val = ((uint32_t) s[0] << 24) | ((uint32_t) s[1] << 16) | ((uint32_t) s[2] << 8) | (uint32_t) s[3];
+
+        memcpy(dst + (i * 4), &val, sizeof(uint32_t));
+    }
+}
+
+/*
+ * Decode count (32 bit value, quality) pairs as used by IEC 61850-9-2 LE data sets
+ */
+static void
+decodeBigEndian32WithQuality(const uint8_t* src, uint8_t* dst, Quality* qualities, int count)
+{
+    int i = 0;
+
+#if (SV_BULK_DECODE_SIMD == 1)
+    int simdLevel = getSimdLevel();
+
+    if (simdLevel == SV_SIMD_LEVEL_AVX2)
+        i = decodeBigEndian32WithQualityAvx2(src, dst, qualities, count);
+    else if (simdLevel == SV_SIMD_LEVEL_SSSE3)
+        i = decodeBigEndian32WithQualitySsse3(src, dst, qualities, count);
+#endif
+
+    for (; i < count; i++) {
+        const uint8_t* s = src + (i * 8);
+
+        uint32_t val = ((uint32_t) s[0] << 24) | ((uint32_t) s[1] << 16) | ((uint32_t) s[2] << 8) | (uint32_t) s[3];
+
+        memcpy(dst + (i * 4), &val, sizeof(uint32_t));
+
+        qualities[i] = (Quality) ((s[6] * 0x100) + s[7]);
+    }
+}
+
+int
+SVSubscriber_ASDU_getINT32Values(SVSubscriber_ASDU self, int index, int32_t* values, int maxCount)
+{
+    int count = getBulkElementCount(self, index, 4, maxCount);
+
+    decodeBigEndian32(self->dataBuffer + index, (uint8_t*) values, count);
+
+    return count;
+}
+
+int
+SVSubscriber_ASDU_getFLOAT32Values(SVSubscriber_ASDU self, int index, float* values, int maxCount)
+{
+    int count = getBulkElementCount(self, index, 4, maxCount);
+
+    decodeBigEndian32(self->dataBuffer + index, (uint8_t*) values, count);
+
+    return count;
+}
+
+int
+SVSubscriber_ASDU_getINT32WithQualityValues(SVSubscriber_ASDU self, int index, int32_t* values, Quality* qualities, int maxCount)
+{
+    int count = getBulkElementCount(self, index, 8, maxCount);
+
+    decodeBigEndian32WithQuality(self->dataBuffer + index, (uint8_t*) values, qualities, count);
+
+    return count;
+}
+
+int
+SVSubscriber_ASDU_getFLOAT32WithQualityValues(SVSubscriber_ASDU self, int index, float* values, Quality* qualities, int maxCount)
+{
+    int count = getBulkElementCount(self, index, 8, maxCount);
+
+    decodeBigEndian32WithQuality(self->dataBuffer + index, (uint8_t*) values, qualities, count);
+
+    return count;
+}
+
 uint16_t
 SVClientASDU_getSmpCnt(SVSubscriber_ASDU self)
 {
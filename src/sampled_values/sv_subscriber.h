@@ -166,6 +166,36 @@ SVReceiver_enableDestAddrCheck(SVReceiver self);
 LIB61850_API void
 SVReceiver_setInterfaceId(SVReceiver self, const char* interfaceId);
 
+/**
+ * \brief Distribute the reception of SV messages over multiple sockets and threads
+ *
+ * When enabled \ref SVReceiver_start opens the given number of sockets on the interface and
+ * joins them to a fanout group. Each socket is served by its own background thread. Messages
+ * are distributed by APPID so all messages of a subscriber are handled by the same thread and
+ * the listener of a subscriber is never called concurrently. Listeners of different subscribers
+ * can be called in parallel.
+ *
+ * When the platform doesn't support socket fanout the receiver falls back to a single socket.
+ * Fanout is not used in threadless mode.
+ *
+ * NOTE: This function has to be called before calling SVReceiver_start.
+ *
+ * \param self the receiver instance reference
+ * \param numberOfSockets the number of sockets/receive threads (1 disables fanout)
+ */
+LIB61850_API void
+SVReceiver_enableFanout(SVReceiver self, int numberOfSockets);
+
+/**
+ * \brief Get the number of sockets/threads actually used by a running receiver
+ *
+ * \param self the receiver instance reference
+ *
+ * \return the number of receive sockets (1 when fanout is disabled or not supported)
+ */
+LIB61850_API int
+SVReceiver_getFanoutSize(SVReceiver self);
+
 /**
  * \brief Add a subscriber instance to the receiver
  *
@@ -246,6 +276,19 @@ SVReceiver_stopThreadless(SVReceiver self);
 LIB61850_API bool
 SVReceiver_tick(SVReceiver self);
 
+/**
+ * \brief Parse a SV message
+ *
+ * Call after reception of an Ethernet frame (can be used as an alternative to \ref SVReceiver_tick
+ * to avoid implementing the Ethernet HAL)
+ *
+ * \param self the receiver object
+ * \param buffer a buffer containing the complete Ethernet message
+ * \param size size of the Ethernet message
+ */
+LIB61850_API void
+SVReceiver_handleMessage(SVReceiver self, uint8_t* buffer, int size);
+
 /*
  * \brief Create a new SV subscriber instance
  *
@@ -275,6 +318,74 @@ SVSubscriber_setListener(SVSubscriber self,  SVUpdateListener listener, void* pa
 LIB61850_API void
 SVSubscriber_destroy(SVSubscriber self);
 
+/**
+ * \brief Number of bins of the inter-arrival jitter histogram
+ */
+#define SV_SUBSCRIBER_JITTER_HISTOGRAM_SIZE 16
+
+/**
+ * \brief Stream health statistics of a subscriber (see \ref SVSubscriber_getStatistics)
+ */
+typedef struct {
+    uint64_t frames; /**< number of received SV messages */
+    uint64_t asdus; /**< number of received ASDUs */
+    uint64_t lostSamples; /**< number of missing samples (gaps in smpCnt) */
+    uint64_t duplicateSamples; /**< number of ASDUs with the same smpCnt as the previous ASDU */
+    uint64_t outOfOrderSamples; /**< number of ASDUs with a smpCnt older than the last received one */
+
+    /**
+     * Histogram of the deviation of the message inter-arrival time from the expected interval.
+     * Bin 0 counts deviations below 1 us, bin n counts deviations in [2^(n-1), 2^n) us. The last
+     * bin also contains all larger deviations.
+     */
+    uint64_t jitterHistogram[SV_SUBSCRIBER_JITTER_HISTOGRAM_SIZE];
+    uint64_t maxJitterNs; /**< maximum deviation of the inter-arrival time in ns */
+
+    uint64_t latencySamples; /**< number of ASDUs with RefrTm used for the latency values */
+    int64_t minLatencyNs; /**< minimum time between RefrTm and message arrival in ns */
+    int64_t maxLatencyNs; /**< maximum time between RefrTm and message arrival in ns */
+    int64_t sumLatencyNs; /**< sum of all latency values (to calculate the average latency) */
+} SVSubscriberStatistics;
+
+/**
+ * \brief Enable the stream statistics for the subscriber
+ *
+ * The statistics are updated by the receiver for each received message without heap allocation
+ * and without locking. The latency is calculated with the local clock (Hal_getTimeInNs) and requires
+ * the local clock to be synchronized with the clock of the publisher.
+ *
+ * \param self The subscriber object
+ * \param smpCntRange the wrap around value of smpCnt (e.g. 4000 for 80 samples per period at 50 Hz), or 0
+ *        to use the highest smpCnt received so far
+ * \param nominalIntervalNs expected message interval in ns for the jitter calculation, or 0 to use
+ *        the moving average of the measured intervals
+ *
+ * \return true when statistics are enabled, false otherwise (out of memory)
+ */
+LIB61850_API bool
+SVSubscriber_enableStatistics(SVSubscriber self, uint32_t smpCntRange, uint32_t nominalIntervalNs);
+
+/**
+ * \brief Reset all statistic counters of the subscriber
+ *
+ * \param self The subscriber object
+ */
+LIB61850_API void
+SVSubscriber_resetStatistics(SVSubscriber self);
+
+/**
+ * \brief Get a consistent snapshot of the statistic counters of the subscriber
+ *
+ * Can be called from any thread while the receiver is running.
+ *
+ * \param self The subscriber object
+ * \param statistics caller provided structure to store the counters
+ *
+ * \return true when the counters have been copied, false when statistics are not enabled
+ */
+LIB61850_API bool
+SVSubscriber_getStatistics(SVSubscriber self, SVSubscriberStatistics* statistics);
+
 /*************************************************************************
  * SVSubscriber_ASDU object methods
  **************************************************************************/
@@ -539,6 +650,71 @@ SVSubscriber_ASDU_getQuality(SVSubscriber_ASDU self, int index);
 LIB61850_API int
 SVSubscriber_ASDU_getDataSize(SVSubscriber_ASDU self);
 
+/**
+ * \brief Get multiple consecutive INT32 data values in the data part of the ASDU
+ *
+ * Decodes up to maxCount values starting at the given byte position in a single pass.
+ * This is faster than repeated calls to \ref SVSubscriber_ASDU_getINT32. On x86 CPUs with
+ * SSSE3 or AVX2 vectorized byte swapping is used (selected at runtime when built with GCC or clang).
+ *
+ * \param self ASDU object instance
+ * \param index the index (byte position of the start) of the first value in the data part
+ * \param values caller provided array to store the values
+ * \param maxCount the maximum number of values to decode (size of the values array)
+ *
+ * \return the number of decoded values (limited by the size of the data part)
+ */
+LIB61850_API int
+SVSubscriber_ASDU_getINT32Values(SVSubscriber_ASDU self, int index, int32_t* values, int maxCount);
+
+/**
+ * \brief Get multiple consecutive FLOAT32 data values in the data part of the ASDU
+ *
+ * \see SVSubscriber_ASDU_getINT32Values
+ *
+ * \param self ASDU object instance
+ * \param index the index (byte position of the start) of the first value in the data part
+ * \param values caller provided array to store the values
+ * \param maxCount the maximum number of values to decode (size of the values array)
+ *
+ * \return the number of decoded values (limited by the size of the data part)
+ */
+LIB61850_API int
+SVSubscriber_ASDU_getFLOAT32Values(SVSubscriber_ASDU self, int index, float* values, int maxCount);
+
+/**
+ * \brief Get multiple consecutive pairs of INT32 data value and quality in the data part of the ASDU
+ *
+ * This matches the data set layout of IEC 61850-9-2 LE (e.g. 8 pairs of INT32 value and quality
+ * for the PhsMeas1 data set). Each pair occupies 8 bytes.
+ *
+ * \param self ASDU object instance
+ * \param index the index (byte position of the start) of the first pair in the data part
+ * \param values caller provided array to store the values
+ * \param qualities caller provided array to store the quality values
+ * \param maxCount the maximum number of pairs to decode (size of the values and qualities arrays)
+ *
+ * \return the number of decoded pairs (limited by the size of the data part)
+ */
+LIB61850_API int
+SVSubscriber_ASDU_getINT32WithQualityValues(SVSubscriber_ASDU self, int index, int32_t* values, Quality* qualities, int maxCount);
+
+/**
+ * \brief Get multiple consecutive pairs of FLOAT32 data value and quality in the data part of the ASDU
+ *
+ * \see SVSubscriber_ASDU_getINT32WithQualityValues
+ *
+ * \param self ASDU object instance
+ * \param index the index (byte position of the start) of the first pair in the data part
+ * \param values caller provided array to store the values
+ * \param qualities caller provided array to store the quality values
+ * \param maxCount the maximum number of pairs to decode (size of the values and qualities arrays)
+ *
+ * \return the number of decoded pairs (limited by the size of the data part)
+ */
+LIB61850_API int
+SVSubscriber_ASDU_getFLOAT32WithQualityValues(SVSubscriber_ASDU self, int index, float* values, Quality* qualities, int maxCount);
+
 /**
  * \brief return the SmpSynch value included in the SV ASDU
  *